@@ -81,6 +81,25 @@ public:
 		InArchive.SerializeCompressed( data.data(), sizeof( TType ) * sizeData, compressionFlags );
 	}
 
+	/**
+	 * Skip bulk data in archive without loading it
+	 * 
+	 * @param[in] InArchive Archive
+	 */
+	void Skip( CArchive& InArchive )
+	{
+		Assert( InArchive.IsLoading() );
+		data.clear();
+		if ( InArchive.Ver() < VER_CompressedZlib )
+		{
+			return;
+		}
+
+		uint32			sizeData = 0;
+		InArchive << sizeData;
+		InArchive.SkipCompressed( sizeof( TType ) * sizeData, compressionFlags );
+	}
+
 	/**
 	 * Resize array of bulk data
 	 * 
@@ -14,18 +14,38 @@
 
 /**
  * @ingroup Core
- * A ring buffer for use with two threads: a reading thread and a writing thread
+ * Statistics of ring buffer
+ */
+struct RingBufferStats
+{
+	uint32		capacity;			/**< Total size of all segments (in bytes) */
+	uint32		numSegments;		/**< Number of segments */
+	uint32		numUsedBytes;		/**< Number of written and not yet read bytes */
+	uint32		highWaterMark;		/**< Max number of used bytes since creation */
+	uint32		numGrows;			/**< How many times was added new segment */
+	uint32		numDedicatedSegments;	/**< How many times was added dedicated segment for allocation larger than segment */
+	uint32		numStalls;			/**< How many times writing thread was waiting free space */
+	double		stallTime;			/**< Total time of writing thread stalls (in seconds) */
+};
+
+/**
+ * @ingroup Core
+ * A ring buffer for use with two threads: a reading thread and a writing thread.
+ * When the buffer is full, the writing thread chains a new larger segment (up to max buffer size) instead of waiting for the reader.
+ * Allocation larger than the segment gets a dedicated segment of its size, next segments keep the regular size.
+ * Both threads are blocked on events when they have nothing to do, so wake-ups happen as soon as data is written or space is freed
  */
 class CRingBuffer
 {
 public:
 	/**
 	 * Constructor
-	 * 
+	 *
 	 * @param[in] InBufferSize The size of the data buffer to allocate
 	 * @param[in] InAlignment Alignment of each allocation unit (in bytes)
+	 * @param[in] InMaxBufferSize Max total size of all segments. If less than InBufferSize the buffer will never grow
 	 */
-	CRingBuffer( uint32 InBufferSize, uint32 InAlignment = 1 );
+	CRingBuffer( uint32 InBufferSize, uint32 InAlignment = 1, uint32 InMaxBufferSize = 0 );
 
 	/**
 	 * Destructor
@@ -41,7 +61,7 @@ public:
 	public:
 		/**
 		 * Upon construction, AllocationContext allocates a chunk from the ring buffer
-		 * 
+		 *
 		 * @param[in] InRingBuffer The ring buffer to allocate from.
 		 * @param[in] InAllocationSize The size of the allocation to make.
 		 */
@@ -59,20 +79,20 @@ public:
 
 		/**
 		 * Get allocation
-		 * 
+		 *
 		 * @return Return pointer to start allocation
 		 */
-		FORCEINLINE void* GetAllocation() const 
+		FORCEINLINE void* GetAllocation() const
 		{
 			return allocationStart;
 		}
 
 		/**
 		 * Get allocated size
-		 * 
+		 *
 		 * @return Return allocated size
 		 */
-		FORCEINLINE uint32 GetAllocatedSize() const 
+		FORCEINLINE uint32 GetAllocatedSize() const
 		{
 			return ( uint32 )( allocationEnd - allocationStart );
 		}
@@ -85,7 +105,7 @@ public:
 
 	/**
 	 * Checks if there is data to be read from the ring buffer, and if so accesses the pointer to the data to be read.
-	 * 
+	 *
 	 * @param[in] OutReadPointer When returning TRUE, this will hold the pointer to the data to read.
 	 * @param[in] OutReadSize When returning TRUE, this will hold the number of bytes available to read.
 	 * @return true if there is data to be read.
@@ -100,27 +120,94 @@ public:
 
 	/**
 	 * Waits for data to be available for reading.
+	 * At first spins for a short time (spin count adapts to how often spinning was successful), after that blocks on event
+	 *
 	 * @param[in] InWaitTime Time in milliseconds to wait before returning.
 	 */
 	void WaitForRead( uint32 InWaitTime = ( uint32 )-1 );
 
+	/**
+	 * Wake up reading thread if it waiting in WaitForRead
+	 */
+	void WakeReader();
+
 	/**
 	 * Checks if some data has been written to or not
 	 * @return true if buffer not empty, else false
 	 */
 	FORCEINLINE bool IsReadBufferEmpty() const
 	{
-		return readPointer == writePointer;
+		return readSegment->readPointer == readSegment->writePointer && !readSegment->next;
 	}
 
+	/**
+	 * Get statistics of ring buffer
+	 * @return Return statistics of ring buffer
+	 */
+	RingBufferStats GetStats() const;
+
 private:
-	byte*				data;					/**< Data buffer */
-	byte*				dataEnd;				/**< The first byte after end the of the data buffer */
-	byte* volatile		writePointer;			/**< The next byte to be written to */
-	bool				isWriting;				/**< TRUE if there is an AllocationContext outstanding for this ring buffer */
-	byte* volatile		readPointer;			/**< The next byte to be read from */
-	uint32				alignment;				/**< Alignment of each allocation unit (in bytes) */
-	class CEvent*		dataWrittenEvent;		/**< The event used to signal the reader thread when the ring buffer has data to read */
+	/**
+	 * Segment of ring buffer
+	 */
+	struct Segment
+	{
+		/**
+		 * Constructor
+		 * @param InSize	Size of segment
+		 */
+		Segment( uint32 InSize );
+
+		/**
+		 * Destructor
+		 */
+		~Segment();
+
+		byte*					data;				/**< Data buffer */
+		byte*					dataEnd;			/**< The first byte after end the of the data buffer */
+		byte* volatile			writePointer;		/**< The next byte to be written to */
+		byte* volatile			readPointer;		/**< The next byte to be read from */
+		Segment* volatile		next;				/**< Next segment. Writing thread set it when moves to the next segment and never writes to this one anymore */
+	};
+
+	/**
+	 * Chain new segment for writing thread if it allowed by max buffer size
+	 *
+	 * @param InMinSize			Min size of new segment
+	 * @param InIsDedicated		Is segment dedicated for one allocation, its size is exactly InMinSize and it doesn't change size of next segments
+	 * @return Return TRUE if new segment was added, otherwise returning FALSE
+	 */
+	bool Grow( uint32 InMinSize, bool InIsDedicated = false );
+
+	/**
+	 * Wake up writing thread if it waiting free space
+	 */
+	void WakeWriter();
+
+	/**
+	 * Create events if they isn't created yet
+	 */
+	void CreateEvents();
+
+	Segment* volatile		writeSegment;			/**< Segment in which writing thread writes */
+	Segment* volatile		readSegment;			/**< Segment from which reading thread reads */
+	bool					isWriting;				/**< TRUE if there is an AllocationContext outstanding for this ring buffer */
+	uint32					alignment;				/**< Alignment of each allocation unit (in bytes) */
+	uint32					maxBufferSize;			/**< Max total size of all segments */
+	volatile int32			bufferSize;				/**< Total size of all segments */
+	uint32					segmentSize;			/**< Size of the last regular segment, dedicated segments don't change it */
+	volatile int32			numSegments;			/**< Number of segments */
+	volatile int32			numUsedBytes;			/**< Number of written and not yet read bytes */
+	volatile int32			isReaderWaiting;		/**< Is reading thread is blocked in WaitForRead */
+	volatile int32			isWriterWaiting;		/**< Is writing thread is blocked while waiting free space */
+	uint32					highWaterMark;			/**< Max number of used bytes */
+	uint32					numGrows;				/**< How many times was added new segment */
+	uint32					numDedicatedSegments;	/**< How many times was added dedicated segment */
+	uint32					numStalls;				/**< How many times writing thread was waiting free space */
+	double					stallTime;				/**< Total time of writing thread stalls (in seconds) */
+	uint32					numSpins;				/**< Current number of spins in WaitForRead before block on event */
+	class CEvent*			dataWrittenEvent;		/**< The event used to signal the reader thread when the ring buffer has data to read */
+	class CEvent*			spaceFreedEvent;		/**< The event used to signal the writer thread when the reader has freed space */
 };
 
 #endif // !RINGBUFFER_H
@@ -58,6 +58,9 @@ enum ELifeEnginePackageVersion
 	VER_UpdateTrasformSceneComponent		= 26,					/**< To CSceneComponent added Location, Scale, Rotation (CRotator) and updated method of transformations */
 	VER_AddTranslucencyFlag					= 27,					/**< Added to CMaterial bTranslucency flag */
 	VER_EnumAsByte							= 28,					/**< Added TEnumAsByte */
+	VER_CompactStaticMeshVertex				= 29,					/**< Static mesh verteces stored in compact GPU vertex format */
+	VER_StaticMeshLODs						= 30,					/**< Added LODs to CStaticMesh */
+	VER_SpriteColor							= 31,					/**< Added color to CSpriteComponent */
 
 	//
 	// New versions can be added here
@@ -744,6 +744,32 @@ struct Math
 		return glm::lerp( InX, InY, InA );
 	}
 
+	/**
+	 * @brief Lerp vectors
+	 *
+	 * @param InX	Vector X
+	 * @param InY	Vector Y
+	 * @param InA	Alpha
+	 * @return Return the linear blend of InX and InY using the floating-point value InA
+	 */
+	static FORCEINLINE Vector Lerp( const Vector& InX, const Vector& InY, float InA )
+	{
+		return glm::mix( InX, InY, InA );
+	}
+
+	/**
+	 * @brief Spherical lerp of quaternions
+	 *
+	 * @param InX	Quaternion X
+	 * @param InY	Quaternion Y
+	 * @param InA	Alpha
+	 * @return Return the spherical blend of InX and InY by the shortest path using the floating-point value InA
+	 */
+	static FORCEINLINE Quaternion SlerpQuaternion( const Quaternion& InX, const Quaternion& InY, float InA )
+	{
+		return glm::slerp( InX, InY, InA );
+	}
+
 	/**
 	 * @brief Snaps a value to the nearest grid multiple
 	 * 
@@ -0,0 +1,180 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright BSOD-Games, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef MIPGENERATOR_H
+#define MIPGENERATOR_H
+
+#include <vector>
+
+#include "Core.h"
+#include "Misc/Types.h"
+
+/**
+ * @ingroup Core
+ * @brief Radius of Kaiser filter (in texels of destination mip)
+ */
+#define MIPGENERATOR_KAISER_RADIUS		3.f
+
+/**
+ * @ingroup Core
+ * @brief Alpha parameter of Kaiser window
+ */
+#define MIPGENERATOR_KAISER_ALPHA		4.f
+
+/**
+ * @ingroup Core
+ * @brief Number of iterations of binary search for scale of alpha which preserves coverage
+ */
+#define MIPGENERATOR_COVERAGE_STEPS		10
+
+/**
+ * @ingroup Core
+ * @brief Enumeration of filters for mip generation
+ */
+enum EMipFilter
+{
+	MF_Box,			/**< 2x2 box filter, fast */
+	MF_Kaiser,		/**< Kaiser windowed sinc filter, sharper mips */
+	MF_Max			/**< Num of filters */
+};
+
+/**
+ * @ingroup Core
+ * @brief Settings of mip generation
+ */
+struct MipGenerationSettings
+{
+	/**
+	 * @brief Constructor
+	 */
+	MipGenerationSettings()
+		: filter( MF_Box )
+		, bSRGB( true )
+		, bPremultipliedAlpha( false )
+		, bPreserveAlphaCoverage( false )
+		, alphaCoverageThreshold( 0.5f )
+		, maxNumMips( 0 )
+	{}
+
+	EMipFilter		filter;						/**< Filter */
+	bool			bSRGB;						/**< Is color encoded in sRGB, it is linearized before filter and encoded back after */
+	bool			bPremultipliedAlpha;		/**< Is filter color premultiplied by alpha, avoids bleeding of color from transparent texels */
+	bool			bPreserveAlphaCoverage;		/**< Is scale alpha of mips for keep coverage of alpha test, used for cutout sprites */
+	float			alphaCoverageThreshold;		/**< Threshold of alpha test for coverage preservation */
+	uint32			maxNumMips;					/**< Max number of mips (include source). If 0 full chain down to 1x1 is generated */
+};
+
+/**
+ * @ingroup Core
+ * @brief Generated mip level
+ */
+struct MipLevel
+{
+	uint32				sizeX;		/**< Width of mip */
+	uint32				sizeY;		/**< Height of mip */
+	std::vector<byte>	data;		/**< Texels in RGBA8 format */
+};
+
+/**
+ * @ingroup Core
+ * @brief Generator of mip chain for RGBA8 images
+ *
+ * Filtering is done in linear float space with SSE, every mip is filtered from the previous float mip
+ * so quantization error isn't accumulated. Rows of mips are processed in parallel on thread pool
+ */
+class CMipGenerator
+{
+public:
+	/**
+	 * @brief Generate mip chain
+	 *
+	 * @param InTexels		Texels of source image in RGBA8 format
+	 * @param InSizeX		Width of source image
+	 * @param InSizeY		Height of source image
+	 * @param InSettings	Settings of generation
+	 * @param OutMips		Output mips, first mip is copy of source image
+	 */
+	static void Generate( const byte* InTexels, uint32 InSizeX, uint32 InSizeY, const MipGenerationSettings& InSettings, std::vector<MipLevel>& OutMips );
+
+	/**
+	 * @brief Get number of mips in full chain
+	 *
+	 * @param InSizeX	Width of image
+	 * @param InSizeY	Height of image
+	 * @return Return number of mips down to 1x1 (include source)
+	 */
+	static uint32 GetNumMips( uint32 InSizeX, uint32 InSizeY );
+
+private:
+	/**
+	 * @brief Image in linear float RGBA format
+	 */
+	struct FloatImage
+	{
+		uint32				sizeX;		/**< Width */
+		uint32				sizeY;		/**< Height */
+		std::vector<float>	texels;		/**< Texels, four floats per texel */
+	};
+
+	/**
+	 * @brief Convert RGBA8 image to linear float
+	 *
+	 * @param InTexels		Texels in RGBA8 format
+	 * @param InSettings	Settings of generation
+	 * @param OutImage		Output float image, size must be set
+	 */
+	static void Decode( const byte* InTexels, const MipGenerationSettings& InSettings, FloatImage& OutImage );
+
+	/**
+	 * @brief Convert linear float image to RGBA8
+	 *
+	 * @param InImage		Float image
+	 * @param InSettings	Settings of generation
+	 * @param InAlphaScale	Scale of alpha
+	 * @param OutMip		Output mip
+	 */
+	static void Encode( const FloatImage& InImage, const MipGenerationSettings& InSettings, float InAlphaScale, MipLevel& OutMip );
+
+	/**
+	 * @brief Downsample image by box filter
+	 *
+	 * @param InSrc		Source image
+	 * @param OutDst	Output image, size must be set
+	 */
+	static void DownsampleBox( const FloatImage& InSrc, FloatImage& OutDst );
+
+	/**
+	 * @brief Downsample image by Kaiser filter
+	 *
+	 * @param InSrc		Source image
+	 * @param OutDst	Output image, size must be set
+	 */
+	static void DownsampleKaiser( const FloatImage& InSrc, FloatImage& OutDst );
+
+	/**
+	 * @brief Calculate coverage of alpha test
+	 *
+	 * @param InImage		Float image
+	 * @param InSettings	Settings of generation
+	 * @param InAlphaScale	Scale of alpha
+	 * @return Return part of texels which pass alpha test
+	 */
+	static float CalcAlphaCoverage( const FloatImage& InImage, const MipGenerationSettings& InSettings, float InAlphaScale );
+
+	/**
+	 * @brief Find scale of alpha which gives wanted coverage
+	 *
+	 * @param InImage			Float image
+	 * @param InSettings		Settings of generation
+	 * @param InTargetCoverage	Wanted coverage
+	 * @return Return scale of alpha
+	 */
+	static float FindAlphaScale( const FloatImage& InImage, const MipGenerationSettings& InSettings, float InTargetCoverage );
+};
+
+#endif // !MIPGENERATOR_H
\ No newline at end of file
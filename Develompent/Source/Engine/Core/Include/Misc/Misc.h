@@ -128,6 +128,22 @@ std::wstring Sys_ComputerName();
  */
 std::wstring Sys_UserName();
 
+/**
+ * @ingroup Core
+ * @brief Get memory usage of current process
+ *
+ * @param OutUsedPhysical		Output used physical memory in bytes
+ * @param OutPeakUsedPhysical	Output peak used physical memory in bytes
+ */
+void Sys_GetProcessMemoryStats( uint64& OutUsedPhysical, uint64& OutPeakUsedPhysical );
+
+/**
+ * @ingroup Core
+ * @brief Get number of logical processor cores
+ * @return Return number of logical processor cores, at least one
+ */
+uint32 Sys_GetNumberOfCores();
+
 /**
  * @ingroup Core
  * Calculate hash from name
@@ -67,6 +67,15 @@ public:
 	 */
 	void SerializeCompressed( void* InBuffer, uint32 InSize, ECompressionFlags InFlags );
 
+	/**
+	 * @brief Skip compression data without decompress it
+	 * @note Work only with loading archives
+	 * 
+	 * @param[in] InSize Size of uncompressed buffer
+	 * @param[in] InFlags Compression flags (see ECompressionFlags)
+	 */
+	void SkipCompressed( uint32 InSize, ECompressionFlags InFlags );
+
 	/**
 	 * @brief Serialize archive header
 	 */
@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright BSOD-Games, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <functional>
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "System/ThreadingBase.h"
+
+/**
+ * @ingroup Core
+ * @brief Max number of worker threads in pool
+ */
+#define THREADPOOL_MAX_WORKERS		64
+
+/**
+ * @ingroup Core
+ * @brief Pool of worker threads for data parallel work
+ *
+ * Work is submitted by ParallelFor, the calling thread takes part in the work and returns only when all
+ * indeces are processed. Only one task is executed at a time, nested or concurrent calls of ParallelFor
+ * are executed on the calling thread
+ */
+class CThreadPool
+{
+public:
+	/**
+	 * @brief Typedef of function for process one index of task
+	 */
+	typedef std::function<void( uint32 )>		TaskFunction_t;
+
+	/**
+	 * @brief Constructor
+	 */
+	CThreadPool();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CThreadPool();
+
+	/**
+	 * @brief Initialize pool and start worker threads
+	 * @param InNumWorkers	Number of worker threads. If 0 will be used number of cores minus one (the calling thread is worker too)
+	 */
+	void Init( uint32 InNumWorkers = 0 );
+
+	/**
+	 * @brief Stop worker threads
+	 */
+	void Shutdown();
+
+	/**
+	 * @brief Execute function for each index in range [0, InNum) in parallel
+	 * @note Function must be thread safe, order of indeces isn't defined
+	 *
+	 * @param InNum			Number of indeces
+	 * @param InFunction	Function for process one index
+	 * @param InBatchSize	Number of indeces which is taken by worker at once
+	 */
+	void ParallelFor( uint32 InNum, const TaskFunction_t& InFunction, uint32 InBatchSize = 1 );
+
+	/**
+	 * @brief Get number of worker threads
+	 * @return Return number of worker threads (without calling thread)
+	 */
+	FORCEINLINE uint32 GetNumWorkers() const
+	{
+		return threads.size();
+	}
+
+	/**
+	 * @brief Is pool initialized
+	 * @return Return TRUE if worker threads are started, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsInitialized() const
+	{
+		return !threads.empty();
+	}
+
+private:
+	/**
+	 * @brief Task of ParallelFor
+	 */
+	struct Task
+	{
+		const TaskFunction_t*	function;			/**< Function for process one index */
+		uint32					num;				/**< Number of indeces */
+		uint32					batchSize;			/**< Number of indeces which is taken by worker at once */
+		volatile int32			nextIndex;			/**< Next index to process */
+		volatile int32			numActiveWorkers;	/**< Number of threads which execute the task (include calling thread) */
+	};
+
+	/**
+	 * @brief Runnable of worker thread
+	 */
+	class CWorkerRunnable : public CRunnable
+	{
+	public:
+		/**
+		 * @brief Constructor
+		 * @param InPool	Owner pool
+		 */
+		CWorkerRunnable( CThreadPool* InPool );
+
+		/**
+		 * @brief Initialize
+		 * @return True if initialization was successful, false otherwise
+		 */
+		virtual bool Init() override;
+
+		/**
+		 * @brief Run
+		 * @return The exit code of the runnable object
+		 */
+		virtual uint32 Run() override;
+
+		/**
+		 * @brief Stop
+		 */
+		virtual void Stop() override;
+
+		/**
+		 * @brief Exit
+		 */
+		virtual void Exit() override;
+
+	private:
+		CThreadPool*		pool;		/**< Owner pool */
+	};
+
+	/**
+	 * @brief Process indeces of task while they are
+	 * @param InTask	Task
+	 */
+	static void ExecuteTask( Task* InTask );
+
+	std::vector<CRunnableThread*>		threads;			/**< Worker threads */
+	std::vector<CWorkerRunnable*>		runnables;			/**< Runnables of worker threads */
+	CSemaphore*							workSemaphore;		/**< Semaphore for wake up workers */
+	CEvent*								taskDoneEvent;		/**< Event triggered when last worker left the task */
+	CCriticalSection					csTask;				/**< Critical section for current task */
+	Task*								currentTask;		/**< Current task, nullptr if no task */
+	volatile int32						bBusy;				/**< Is pool executing task */
+	volatile bool						bStopping;			/**< Is pool stopping */
+};
+
+/**
+ * @ingroup Core
+ * @brief Global pool of worker threads
+ */
+extern CThreadPool			g_ThreadPool;
+
+#endif // !THREADPOOL_H
\ No newline at end of file
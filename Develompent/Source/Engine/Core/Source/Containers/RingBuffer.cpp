@@ -1,22 +1,65 @@
 #include "Containers/RingBuffer.h"
+#include "Misc/Misc.h"
 #include "System/ThreadingBase.h"
 #include "Misc/Template.h"
 
+/* Min number of spins in CRingBuffer::WaitForRead before block on event */
+#define RINGBUFFER_MIN_SPINS			16
+
+/* Max number of spins in CRingBuffer::WaitForRead before block on event */
+#define RINGBUFFER_MAX_SPINS			1024
+
 /* Critical section of ring buffer */
 static CCriticalSection			s_CriticalSection;
 
+/*
+==================
+CRingBuffer::Segment::Segment
+==================
+*/
+CRingBuffer::Segment::Segment( uint32 InSize ) :
+	next( nullptr )
+{
+	data = new byte[ InSize ];
+	dataEnd = data + InSize;
+	readPointer = writePointer = data;
+}
+
+/*
+==================
+CRingBuffer::Segment::~Segment
+==================
+*/
+CRingBuffer::Segment::~Segment()
+{
+	delete[] data;
+}
+
 /*
 ==================
 CRingBuffer::CRingBuffer
 ==================
 */
-CRingBuffer::CRingBuffer( uint32 InBufferSize, uint32 InAlignment /*= 1*/ ) :
+CRingBuffer::CRingBuffer( uint32 InBufferSize, uint32 InAlignment /*= 1*/, uint32 InMaxBufferSize /*= 0*/ ) :
+	isWriting( false ),
+	alignment( InAlignment ),
+	maxBufferSize( Max( InBufferSize, InMaxBufferSize ) ),
+	bufferSize( InBufferSize ),
+	segmentSize( InBufferSize ),
+	numSegments( 1 ),
+	numUsedBytes( 0 ),
+	isReaderWaiting( 0 ),
+	isWriterWaiting( 0 ),
+	highWaterMark( 0 ),
+	numGrows( 0 ),
+	numDedicatedSegments( 0 ),
+	numStalls( 0 ),
+	stallTime( 0.0 ),
+	numSpins( RINGBUFFER_MIN_SPINS ),
 	dataWrittenEvent( nullptr ),
-	alignment( InAlignment )
+	spaceFreedEvent( nullptr )
 {
-	data = new byte[ InBufferSize ];
-	dataEnd = data + InBufferSize;
-	readPointer = writePointer = data;
+	readSegment = writeSegment = new Segment( InBufferSize );
 }
 
 /*
@@ -26,8 +69,22 @@ CRingBuffer::~CRingBuffer
 */
 CRingBuffer::~CRingBuffer()
 {
-	g_SynchronizeFactory->Destroy( dataWrittenEvent );
-	delete[] data;	
+	if ( dataWrittenEvent )
+	{
+		g_SynchronizeFactory->Destroy( dataWrittenEvent );
+	}
+
+	if ( spaceFreedEvent )
+	{
+		g_SynchronizeFactory->Destroy( spaceFreedEvent );
+	}
+
+	for ( Segment* segment = readSegment; segment; )
+	{
+		Segment*	nextSegment = segment->next;
+		delete segment;
+		segment = nextSegment;
+	}
 }
 
 /*
@@ -44,42 +101,72 @@ CRingBuffer::CAllocationContext::CAllocationContext( CRingBuffer& InRingBuffer,
 	Assert( !ringBuffer.isWriting );
 	ringBuffer.isWriting = true;
 
-	// Check that the allocation will fit in the buffer.
 	const uint32		alignedAllocationSize = Align( InAllocationSize, ringBuffer.alignment );
-	const uint32		bufferSize = ( uint32 )( ringBuffer.dataEnd - ringBuffer.data );
-	Assert( alignedAllocationSize < bufferSize );
-
-	// Use the memory referenced by WritePointer for the allocation, wrapped around to the beginning of the buffer
-	// if it was at the end.
-	allocationStart = ringBuffer.writePointer != ringBuffer.dataEnd ? ringBuffer.writePointer : ringBuffer.data;
-
-	// If there isn't enough space left in the buffer to allocate the full size, allocate all the remaining bytes in the buffer.
-	allocationEnd = Min( ringBuffer.dataEnd, allocationStart + alignedAllocationSize );
-
-	// Wait until the reading thread has finished reading the area of the buffer we want to allocate
+	double				stallStartTime = 0.0;
 	while ( true )
 	{
-		// Make a snapshot of a recent value of ReadPointer.
-		byte*		currentReadPointer = ringBuffer.readPointer;
-
-		// If the ReadPointer and WritePointer are the same, the buffer is empty and there's no risk of overwriting unread data.
-		if ( currentReadPointer == ringBuffer.writePointer )
-		{
-			break;
-		}
-		else
+		// Check that the allocation will fit in the segment. Whole segment can be allocated only if nothing was written to it yet
+		Segment*			segment = ringBuffer.writeSegment;
+		const uint32		segmentSize = ( uint32 )( segment->dataEnd - segment->data );
+		const bool			bUnusedSegment = segment->writePointer == segment->data && segment->readPointer == segment->data;
+		if ( alignedAllocationSize < segmentSize || ( alignedAllocationSize == segmentSize && bUnusedSegment ) )
 		{
+			// Use the memory referenced by WritePointer for the allocation, wrapped around to the beginning of the buffer
+			// if it was at the end.
+			allocationStart = segment->writePointer != segment->dataEnd ? segment->writePointer : segment->data;
+
+			// If there isn't enough space left in the buffer to allocate the full size, allocate all the remaining bytes in the buffer.
+			allocationEnd = Min( segment->dataEnd, allocationStart + alignedAllocationSize );
+
+			// Make a snapshot of a recent value of ReadPointer.
+			byte*		currentReadPointer = segment->readPointer;
+
+			// If the ReadPointer and WritePointer are the same, the buffer is empty and there's no risk of overwriting unread data.
 			// If the allocation doesn't contain the read pointer, the allocation won't overwrite unread data.
 			// Note that it needs to also prevent advancing WritePointer to match the current ReadPointer, since that would signal that the
 			// buffer is empty instead of the expected full.
-			const bool		allocationContainsReadPointer = allocationStart <= currentReadPointer && currentReadPointer <= allocationEnd;
-			if ( !allocationContainsReadPointer )
+			if ( currentReadPointer == segment->writePointer || !( allocationStart <= currentReadPointer && currentReadPointer <= allocationEnd ) )
 			{
 				break;
 			}
+
+			// The segment is full, so instead of waiting for the reading thread we try to chain a new segment
+			if ( ringBuffer.Grow( alignedAllocationSize ) )
+			{
+				continue;
+			}
+		}
+		else
+		{
+			// Allocation is larger than the segment, so it gets a dedicated segment of its size.
+			// Only the writing segment is never released, so if the allocation doesn't fit with it into max buffer size, we would wait forever
+			AssertMsg( segmentSize + alignedAllocationSize <= ringBuffer.maxBufferSize, TEXT( "Allocation of %i bytes doesn't fit in max size of ring buffer %i bytes" ), alignedAllocationSize, ringBuffer.maxBufferSize );
+			if ( ringBuffer.Grow( alignedAllocationSize, true ) )
+			{
+				continue;
+			}
+		}
+
+		// We reached max buffer size, so we have to wait until the reading thread frees space
+		if ( stallStartTime == 0.0 )
+		{
+			stallStartTime = Sys_Seconds();
+			++ringBuffer.numStalls;
+			ringBuffer.CreateEvents();
 		}
 
-		Sys_Sleep( 0.1f );
+		// Raise waiting flag and check the buffer again before blocking, otherwise we can miss the wake-up from the reading thread
+		if ( Sys_InterlockedExchange( &ringBuffer.isWriterWaiting, 1 ) == 0 )
+		{
+			continue;
+		}
+		ringBuffer.spaceFreedEvent->Wait();
+	}
+
+	if ( stallStartTime != 0.0 )
+	{
+		Sys_InterlockedExchange( &ringBuffer.isWriterWaiting, 0 );
+		ringBuffer.stallTime += Sys_Seconds() - stallStartTime;
 	}
 }
 
@@ -103,7 +190,12 @@ void CRingBuffer::CAllocationContext::Commit()
 	if ( allocationStart )
 	{
 		// Advance the write pointer to the next unallocated byte.
-		ringBuffer.writePointer = allocationEnd;
+		const uint32		allocatedSize = GetAllocatedSize();
+		ringBuffer.writeSegment->writePointer = allocationEnd;
+
+		// Update high-water mark of the buffer
+		const uint32		numUsedBytes = ( uint32 )( Sys_InterlockedAdd( &ringBuffer.numUsedBytes, allocatedSize ) + allocatedSize );
+		ringBuffer.highWaterMark = Max( ringBuffer.highWaterMark, numUsedBytes );
 
 		// Reset the IsWriting flag to allow other AllocationContexts to be created for the ring buffer.
 		ringBuffer.isWriting = false;
@@ -112,16 +204,15 @@ void CRingBuffer::CAllocationContext::Commit()
 		// Clear the allocation pointer, to signal that it has been committed.
 		allocationStart = nullptr;
 
-		// Lazily create the data-written event. It can't be done in the CRingBuffer constructor because g_SynchronizeFactory may not
+		// Lazily create the events. It can't be done in the CRingBuffer constructor because g_SynchronizeFactory may not
 		// be initialized at that point.
-		if ( !ringBuffer.dataWrittenEvent )
+		ringBuffer.CreateEvents();
+
+		// Trigger the data-written event to wake the reader thread only if it is blocked, otherwise we will pay for a kernel call on each command.
+		if ( Sys_InterlockedCompareExchange( &ringBuffer.isReaderWaiting, 0, 1 ) == 1 )
 		{
-			ringBuffer.dataWrittenEvent = g_SynchronizeFactory->CreateSynchEvent();
-			AssertMsg( ringBuffer.dataWrittenEvent, TEXT( "Failed to create data-write event for CRingBuffer" ) );
+			ringBuffer.dataWrittenEvent->Trigger();
 		}
-
-		// Trigger the data-written event to wake the reader thread.
-		ringBuffer.dataWrittenEvent->Trigger();
 	}
 }
 
@@ -132,39 +223,61 @@ CRingBuffer::BeginRead
 */
 bool CRingBuffer::BeginRead( void*& OutReadPointer, uint32& OutReadSize )
 {
-	// Make a snapshot of a recent value of WritePointer, and use a memory barrier to ensure that reads from the data buffer
-	// will see writes no older than this snapshot of the WritePointer.
-	byte*			currentWritePointer = writePointer;
-
-	// Determine whether the write pointer or the buffer end should delimit this contiguous read.
-	byte*			readEndPointer = nullptr;
-	if ( currentWritePointer >= readPointer )
-	{
-		readEndPointer = currentWritePointer;
-	}
-	else
+	while ( true )
 	{
-		// If the read pointer has reached the end of readable data in the buffer, reset it to the beginning of the buffer.
-		if ( readPointer == dataEnd )
+		// Make a snapshot of a recent value of WritePointer, and use a memory barrier to ensure that reads from the data buffer
+		// will see writes no older than this snapshot of the WritePointer.
+		Segment*		segment = readSegment;
+		byte*			currentWritePointer = segment->writePointer;
+
+		// Determine whether the write pointer or the buffer end should delimit this contiguous read.
+		byte*			readEndPointer = nullptr;
+		if ( currentWritePointer >= segment->readPointer )
 		{
-			readPointer = data;
 			readEndPointer = currentWritePointer;
 		}
 		else
 		{
-			readEndPointer = dataEnd;
+			// If the read pointer has reached the end of readable data in the buffer, reset it to the beginning of the buffer.
+			if ( segment->readPointer == segment->dataEnd )
+			{
+				segment->readPointer = segment->data;
+				readEndPointer = currentWritePointer;
+			}
+			else
+			{
+				readEndPointer = segment->dataEnd;
+			}
 		}
-	}
 
-	// Determine whether there's data to read, and how much.
-	if ( readPointer < readEndPointer )
-	{
-		OutReadPointer = readPointer;
-		OutReadSize = ( uint32 )( readEndPointer - readPointer );
-		return true;
-	}
+		// Determine whether there's data to read, and how much.
+		if ( segment->readPointer < readEndPointer )
+		{
+			OutReadPointer = segment->readPointer;
+			OutReadSize = ( uint32 )( readEndPointer - segment->readPointer );
+			return true;
+		}
+
+		// The segment is drained. If the writing thread didn't move to the next segment, there is nothing to read
+		Segment*		nextSegment = segment->next;
+		if ( !nextSegment )
+		{
+			return false;
+		}
+
+		// The writing thread links the next segment only after last commit to this one, so check it again
+		if ( segment->writePointer != segment->readPointer )
+		{
+			continue;
+		}
 
-	return false;
+		// Release drained segment and continue reading from the next one
+		readSegment = nextSegment;
+		Sys_InterlockedAdd( &bufferSize, -( int32 )( segment->dataEnd - segment->data ) );
+		Sys_InterlockedDecrement( &numSegments );
+		delete segment;
+		WakeWriter();
+	}
 }
 
 /*
@@ -174,7 +287,10 @@ CRingBuffer::FinishRead
 */
 void CRingBuffer::FinishRead( uint32 InReadSize )
 {
-	readPointer += Align( InReadSize, alignment );
+	const uint32		alignedReadSize = Align( InReadSize, alignment );
+	readSegment->readPointer += alignedReadSize;
+	Sys_InterlockedAdd( &numUsedBytes, -( int32 )alignedReadSize );
+	WakeWriter();
 }
 
 /*
@@ -184,16 +300,138 @@ CRingBuffer::WaitForRead
 */
 void CRingBuffer::WaitForRead( uint32 InWaitTime /*= (uint32)-1*/ )
 {
-	// If the buffer is empty, wait for the data-written event to be triggered.
-	if ( readPointer == writePointer )
+	// Spin for a short time, new data often arrives soon after the reader drained the buffer.
+	// If spinning was successful spin longer next time, otherwise decrease number of spins
+	for ( uint32 index = 0; index < numSpins; ++index )
 	{
-		if ( dataWrittenEvent )
+		if ( !IsReadBufferEmpty() )
 		{
-			dataWrittenEvent->Wait( InWaitTime );
+			numSpins = Min<uint32>( numSpins * 2, RINGBUFFER_MAX_SPINS );
+			return;
 		}
-		else
+		Sys_Sleep( 0.f );
+	}
+	numSpins = Max<uint32>( numSpins / 2, RINGBUFFER_MIN_SPINS );
+
+	// If the buffer is still empty, wait for the data-written event to be triggered.
+	if ( dataWrittenEvent )
+	{
+		// Raise waiting flag and check the buffer again before blocking, otherwise we can miss the wake-up from the writing thread
+		Sys_InterlockedExchange( &isReaderWaiting, 1 );
+		if ( IsReadBufferEmpty() )
 		{
-			Sys_Sleep( 0.001f );			// Changed from 0 to 1ms (the shortest delay supported)
+			dataWrittenEvent->Wait( InWaitTime );
 		}
+		Sys_InterlockedExchange( &isReaderWaiting, 0 );
+	}
+	else
+	{
+		Sys_Sleep( 0.001f );			// Changed from 0 to 1ms (the shortest delay supported)
+	}
+}
+
+/*
+==================
+CRingBuffer::WakeReader
+==================
+*/
+void CRingBuffer::WakeReader()
+{
+	if ( dataWrittenEvent )
+	{
+		dataWrittenEvent->Trigger();
+	}
+}
+
+/*
+==================
+CRingBuffer::WakeWriter
+==================
+*/
+void CRingBuffer::WakeWriter()
+{
+	if ( Sys_InterlockedCompareExchange( &isWriterWaiting, 0, 1 ) == 1 )
+	{
+		spaceFreedEvent->Trigger();
 	}
+}
+
+/*
+==================
+CRingBuffer::Grow
+==================
+*/
+bool CRingBuffer::Grow( uint32 InMinSize, bool InIsDedicated /* = false */ )
+{
+	// New segment is twice larger, so after the reader drained old segments the buffer fits the peak load.
+	// Dedicated segment has exactly size of allocation and doesn't change size of next segments, after it we return to the last regular size
+	Segment*		oldSegment = writeSegment;
+	const uint32	oldSegmentSize = ( uint32 )( oldSegment->dataEnd - oldSegment->data );
+	uint32			newSegmentSize = Align( InMinSize, alignment );
+	if ( !InIsDedicated )
+	{
+		newSegmentSize = Max<uint32>( oldSegmentSize == segmentSize ? segmentSize * 2 : segmentSize, Align( InMinSize * 2, alignment ) );
+	}
+
+	if ( ( uint32 )bufferSize + newSegmentSize > maxBufferSize )
+	{
+		return false;
+	}
+
+	Segment*		newSegment = new Segment( newSegmentSize );
+	Sys_InterlockedAdd( &bufferSize, newSegmentSize );
+	Sys_InterlockedIncrement( &numSegments );
+	if ( InIsDedicated )
+	{
+		++numDedicatedSegments;
+	}
+	else
+	{
+		segmentSize = newSegmentSize;
+		++numGrows;
+	}
+
+	// After linking the writing thread never writes to the old segment, the reading thread releases it when drained
+	writeSegment = newSegment;
+	oldSegment->next = newSegment;
+	return true;
+}
+
+/*
+==================
+CRingBuffer::CreateEvents
+==================
+*/
+void CRingBuffer::CreateEvents()
+{
+	if ( !dataWrittenEvent )
+	{
+		dataWrittenEvent = g_SynchronizeFactory->CreateSynchEvent();
+		AssertMsg( dataWrittenEvent, TEXT( "Failed to create data-write event for CRingBuffer" ) );
+	}
+
+	if ( !spaceFreedEvent )
+	{
+		spaceFreedEvent = g_SynchronizeFactory->CreateSynchEvent();
+		AssertMsg( spaceFreedEvent, TEXT( "Failed to create space-freed event for CRingBuffer" ) );
+	}
+}
+
+/*
+==================
+CRingBuffer::GetStats
+==================
+*/
+RingBufferStats CRingBuffer::GetStats() const
+{
+	RingBufferStats		stats;
+	stats.capacity		= ( uint32 )bufferSize;
+	stats.numSegments	= ( uint32 )numSegments;
+	stats.numUsedBytes	= ( uint32 )numUsedBytes;
+	stats.highWaterMark = highWaterMark;
+	stats.numGrows		= numGrows;
+	stats.numDedicatedSegments = numDedicatedSegments;
+	stats.numStalls		= numStalls;
+	stats.stallTime		= stallTime;
+	return stats;
 }
\ No newline at end of file
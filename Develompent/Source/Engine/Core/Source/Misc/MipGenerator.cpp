@@ -0,0 +1,647 @@
+#include <cmath>
+
+#include "Math/Math.h"
+#include "Misc/Template.h"
+#include "Misc/MipGenerator.h"
+#include "System/ThreadPool.h"
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __SSE2__ )
+	#include <emmintrin.h>
+	#define MIPGENERATOR_SSE		1
+#else
+	#define MIPGENERATOR_SSE		0
+#endif // _M_X64 || _M_IX86 || __SSE2__
+
+/* Min number of texels in one job of row-parallel passes */
+#define MIPGENERATOR_MIN_TEXELS_PER_JOB		4096
+
+/* Size of table for encode linear values to sRGB */
+#define MIPGENERATOR_SRGB_TABLE_SIZE		16384
+
+/* Max scale of alpha for coverage preservation */
+#define MIPGENERATOR_COVERAGE_MAX_SCALE		4.f
+
+//
+// Operations with one texel of float image (RGBA)
+//
+
+#if MIPGENERATOR_SSE
+typedef __m128		MipTexel_t;
+
+/*
+==================
+MipTexelZero
+==================
+*/
+FORCEINLINE MipTexel_t MipTexelZero()
+{
+	return _mm_setzero_ps();
+}
+
+/*
+==================
+MipTexelLoad
+==================
+*/
+FORCEINLINE MipTexel_t MipTexelLoad( const float* InTexel )
+{
+	return _mm_loadu_ps( InTexel );
+}
+
+/*
+==================
+MipTexelStore
+==================
+*/
+FORCEINLINE void MipTexelStore( float* OutTexel, MipTexel_t InValue )
+{
+	_mm_storeu_ps( OutTexel, InValue );
+}
+
+/*
+==================
+MipTexelAdd
+==================
+*/
+FORCEINLINE MipTexel_t MipTexelAdd( MipTexel_t InA, MipTexel_t InB )
+{
+	return _mm_add_ps( InA, InB );
+}
+
+/*
+==================
+MipTexelScale
+==================
+*/
+FORCEINLINE MipTexel_t MipTexelScale( MipTexel_t InA, float InScale )
+{
+	return _mm_mul_ps( InA, _mm_set1_ps( InScale ) );
+}
+
+/*
+==================
+MipTexelMadd
+==================
+*/
+FORCEINLINE MipTexel_t MipTexelMadd( MipTexel_t InAcc, MipTexel_t InA, float InScale )
+{
+	return _mm_add_ps( InAcc, _mm_mul_ps( InA, _mm_set1_ps( InScale ) ) );
+}
+#else
+struct MipTexel_t
+{
+	float	v[4];	/**< RGBA */
+};
+
+/*
+==================
+MipTexelZero
+==================
+*/
+FORCEINLINE MipTexel_t MipTexelZero()
+{
+	MipTexel_t	result = { 0.f, 0.f, 0.f, 0.f };
+	return result;
+}
+
+/*
+==================
+MipTexelLoad
+==================
+*/
+FORCEINLINE MipTexel_t MipTexelLoad( const float* InTexel )
+{
+	MipTexel_t	result = { InTexel[0], InTexel[1], InTexel[2], InTexel[3] };
+	return result;
+}
+
+/*
+==================
+MipTexelStore
+==================
+*/
+FORCEINLINE void MipTexelStore( float* OutTexel, MipTexel_t InValue )
+{
+	OutTexel[0] = InValue.v[0];
+	OutTexel[1] = InValue.v[1];
+	OutTexel[2] = InValue.v[2];
+	OutTexel[3] = InValue.v[3];
+}
+
+/*
+==================
+MipTexelAdd
+==================
+*/
+FORCEINLINE MipTexel_t MipTexelAdd( MipTexel_t InA, MipTexel_t InB )
+{
+	MipTexel_t	result = { InA.v[0] + InB.v[0], InA.v[1] + InB.v[1], InA.v[2] + InB.v[2], InA.v[3] + InB.v[3] };
+	return result;
+}
+
+/*
+==================
+MipTexelScale
+==================
+*/
+FORCEINLINE MipTexel_t MipTexelScale( MipTexel_t InA, float InScale )
+{
+	MipTexel_t	result = { InA.v[0] * InScale, InA.v[1] * InScale, InA.v[2] * InScale, InA.v[3] * InScale };
+	return result;
+}
+
+/*
+==================
+MipTexelMadd
+==================
+*/
+FORCEINLINE MipTexel_t MipTexelMadd( MipTexel_t InAcc, MipTexel_t InA, float InScale )
+{
+	return MipTexelAdd( InAcc, MipTexelScale( InA, InScale ) );
+}
+#endif // MIPGENERATOR_SSE
+
+/**
+ * Tables for convert between sRGB and linear values
+ */
+struct SRGBTables
+{
+	/**
+	 * Constructor
+	 */
+	SRGBTables()
+	{
+		for ( uint32 index = 0; index < 256; ++index )
+		{
+			float	value = index / 255.f;
+			toLinear[index] = value <= 0.04045f ? value / 12.92f : powf( ( value + 0.055f ) / 1.055f, 2.4f );
+		}
+
+		for ( uint32 index = 0; index < MIPGENERATOR_SRGB_TABLE_SIZE; ++index )
+		{
+			float	value	= index / ( float )( MIPGENERATOR_SRGB_TABLE_SIZE - 1 );
+			float	sRGB	= value <= 0.0031308f ? value * 12.92f : 1.055f * powf( value, 1.f / 2.4f ) - 0.055f;
+			toSRGB[index] = ( byte )Clamp( sRGB * 255.f + 0.5f, 0.f, 255.f );
+		}
+	}
+
+	float		toLinear[256];								/**< Table for convert sRGB byte to linear value */
+	byte		toSRGB[MIPGENERATOR_SRGB_TABLE_SIZE];		/**< Table for convert linear value to sRGB byte */
+};
+
+/*
+==================
+GetSRGBTables
+==================
+*/
+static const SRGBTables& GetSRGBTables()
+{
+	static SRGBTables		s_SRGBTables;
+	return s_SRGBTables;
+}
+
+/*
+==================
+GetNumRowsPerJob
+==================
+*/
+FORCEINLINE uint32 GetNumRowsPerJob( uint32 InSizeX )
+{
+	return Max<uint32>( MIPGENERATOR_MIN_TEXELS_PER_JOB / Max<uint32>( InSizeX, 1 ), 1 );
+}
+
+/*
+==================
+BesselI0
+==================
+*/
+static float BesselI0( float InX )
+{
+	// Power series of modified Bessel function of the first kind
+	float	sum		= 1.f;
+	float	term	= 1.f;
+	float	halfX	= InX * 0.5f;
+	for ( uint32 index = 1; index < 32; ++index )
+	{
+		term	*= ( halfX / index ) * ( halfX / index );
+		sum		+= term;
+		if ( term < sum * 1e-7f )
+		{
+			break;
+		}
+	}
+	return sum;
+}
+
+/*
+==================
+KaiserWeight
+==================
+*/
+static float KaiserWeight( float InX )
+{
+	const float		absX = fabsf( InX );
+	if ( absX >= MIPGENERATOR_KAISER_RADIUS )
+	{
+		return 0.f;
+	}
+
+	// Windowed sinc
+	const float		sinc	= absX < 1e-5f ? 1.f : sinf( ( float )PI * absX ) / ( ( float )PI * absX );
+	const float		ratio	= absX / MIPGENERATOR_KAISER_RADIUS;
+	return sinc * BesselI0( MIPGENERATOR_KAISER_ALPHA * sqrtf( 1.f - ratio * ratio ) ) / BesselI0( MIPGENERATOR_KAISER_ALPHA );
+}
+
+/**
+ * Taps of filter for one destination texel along axis
+ */
+struct MipFilterTaps
+{
+	std::vector<uint32>		indeces;	/**< Indeces of source texels */
+	std::vector<float>		weights;	/**< Normalized weights */
+};
+
+/*
+==================
+CalcKaiserTaps
+==================
+*/
+static void CalcKaiserTaps( uint32 InSrcSize, uint32 InDstSize, std::vector<MipFilterTaps>& OutTaps )
+{
+	const float		scale	= ( float )InSrcSize / InDstSize;
+	const float		radius	= MIPGENERATOR_KAISER_RADIUS * scale;
+	OutTaps.resize( InDstSize );
+	for ( uint32 dstIndex = 0; dstIndex < InDstSize; ++dstIndex )
+	{
+		// Center of destination texel in source space, out of range taps are clamped to edge
+		MipFilterTaps&	taps		= OutTaps[dstIndex];
+		const float		center		= ( dstIndex + 0.5f ) * scale;
+		const int32		firstIndex	= ( int32 )floorf( center - radius );
+		const int32		lastIndex	= ( int32 )ceilf( center + radius );
+		float			sumWeights	= 0.f;
+
+		for ( int32 srcIndex = firstIndex; srcIndex <= lastIndex; ++srcIndex )
+		{
+			const float		weight = KaiserWeight( ( srcIndex + 0.5f - center ) / scale );
+			if ( weight != 0.f )
+			{
+				taps.indeces.push_back( ( uint32 )Clamp<int32>( srcIndex, 0, InSrcSize - 1 ) );
+				taps.weights.push_back( weight );
+				sumWeights += weight;
+			}
+		}
+
+		for ( uint32 index = 0, count = taps.weights.size(); index < count; ++index )
+		{
+			taps.weights[index] /= sumWeights;
+		}
+	}
+}
+
+/*
+==================
+CalcBoxTaps
+==================
+*/
+static void CalcBoxTaps( uint32 InSrcSize, uint32 InDstSize, std::vector<MipFilterTaps>& OutTaps )
+{
+	OutTaps.resize( InDstSize );
+	for ( uint32 dstIndex = 0; dstIndex < InDstSize; ++dstIndex )
+	{
+		MipFilterTaps&	taps = OutTaps[dstIndex];
+		if ( InSrcSize == 1 )
+		{
+			taps.indeces.push_back( 0 );
+			taps.weights.push_back( 1.f );
+		}
+		else if ( ( InSrcSize & 1 ) == 0 )
+		{
+			taps.indeces.push_back( dstIndex * 2 );
+			taps.indeces.push_back( dstIndex * 2 + 1 );
+			taps.weights.push_back( 0.5f );
+			taps.weights.push_back( 0.5f );
+		}
+		else
+		{
+			// Odd size 2n+1 to n, destination texel covers 2+1/n source texels, so three texels are weighted by covered area
+			const float		invSrcSize = 1.f / InSrcSize;
+			taps.indeces.push_back( dstIndex * 2 );
+			taps.indeces.push_back( dstIndex * 2 + 1 );
+			taps.indeces.push_back( dstIndex * 2 + 2 );
+			taps.weights.push_back( ( InDstSize - dstIndex ) * invSrcSize );
+			taps.weights.push_back( InDstSize * invSrcSize );
+			taps.weights.push_back( ( dstIndex + 1 ) * invSrcSize );
+		}
+	}
+}
+
+/*
+==================
+CMipGenerator::GetNumMips
+==================
+*/
+uint32 CMipGenerator::GetNumMips( uint32 InSizeX, uint32 InSizeY )
+{
+	uint32		numMips = 1;
+	uint32		size	= Max( InSizeX, InSizeY );
+	while ( size > 1 )
+	{
+		size >>= 1;
+		++numMips;
+	}
+	return numMips;
+}
+
+/*
+==================
+CMipGenerator::Generate
+==================
+*/
+void CMipGenerator::Generate( const byte* InTexels, uint32 InSizeX, uint32 InSizeY, const MipGenerationSettings& InSettings, std::vector<MipLevel>& OutMips )
+{
+	Assert( InTexels && InSizeX > 0 && InSizeY > 0 );
+	OutMips.clear();
+
+	uint32		numMips = GetNumMips( InSizeX, InSizeY );
+	if ( InSettings.maxNumMips > 0 )
+	{
+		numMips = Min( numMips, InSettings.maxNumMips );
+	}
+
+	// First mip is source image
+	OutMips.resize( numMips );
+	OutMips[0].sizeX	= InSizeX;
+	OutMips[0].sizeY	= InSizeY;
+	OutMips[0].data.assign( InTexels, InTexels + InSizeX * InSizeY * 4 );
+	if ( numMips <= 1 )
+	{
+		return;
+	}
+
+	FloatImage		currentImage;
+	currentImage.sizeX	= InSizeX;
+	currentImage.sizeY	= InSizeY;
+	Decode( InTexels, InSettings, currentImage );
+
+	// Every mip is filtered from previous float mip, alpha scale of coverage preservation isn't accumulated
+	const float		targetCoverage = InSettings.bPreserveAlphaCoverage ? CalcAlphaCoverage( currentImage, InSettings, 1.f ) : 0.f;
+	for ( uint32 mipIndex = 1; mipIndex < numMips; ++mipIndex )
+	{
+		FloatImage		nextImage;
+		nextImage.sizeX = Max<uint32>( currentImage.sizeX >> 1, 1 );
+		nextImage.sizeY = Max<uint32>( currentImage.sizeY >> 1, 1 );
+		if ( InSettings.filter == MF_Kaiser )
+		{
+			DownsampleKaiser( currentImage, nextImage );
+		}
+		else
+		{
+			DownsampleBox( currentImage, nextImage );
+		}
+
+		const float		alphaScale = InSettings.bPreserveAlphaCoverage ? FindAlphaScale( nextImage, InSettings, targetCoverage ) : 1.f;
+		Encode( nextImage, InSettings, alphaScale, OutMips[mipIndex] );
+		currentImage = std::move( nextImage );
+	}
+}
+
+/*
+==================
+CMipGenerator::Decode
+==================
+*/
+void CMipGenerator::Decode( const byte* InTexels, const MipGenerationSettings& InSettings, FloatImage& OutImage )
+{
+	const SRGBTables&	tables		= GetSRGBTables();
+	const uint32		sizeX		= OutImage.sizeX;
+	const uint32		rowsPerJob	= GetNumRowsPerJob( sizeX );
+	OutImage.texels.resize( OutImage.sizeX * OutImage.sizeY * 4 );
+
+	g_ThreadPool.ParallelFor( OutImage.sizeY, [&]( uint32 InY )
+	{
+		const byte*		srcRow = InTexels + InY * sizeX * 4;
+		float*			dstRow = OutImage.texels.data() + InY * sizeX * 4;
+		for ( uint32 x = 0; x < sizeX; ++x )
+		{
+			const byte*		src		= srcRow + x * 4;
+			float*			dst		= dstRow + x * 4;
+			const float		alpha	= src[3] / 255.f;
+			for ( uint32 channel = 0; channel < 3; ++channel )
+			{
+				dst[channel] = InSettings.bSRGB ? tables.toLinear[src[channel]] : src[channel] / 255.f;
+				if ( InSettings.bPremultipliedAlpha )
+				{
+					dst[channel] *= alpha;
+				}
+			}
+			dst[3] = alpha;
+		}
+	}, rowsPerJob );
+}
+
+/*
+==================
+CMipGenerator::Encode
+==================
+*/
+void CMipGenerator::Encode( const FloatImage& InImage, const MipGenerationSettings& InSettings, float InAlphaScale, MipLevel& OutMip )
+{
+	const SRGBTables&	tables		= GetSRGBTables();
+	const uint32		sizeX		= InImage.sizeX;
+	const uint32		rowsPerJob	= GetNumRowsPerJob( sizeX );
+	OutMip.sizeX = InImage.sizeX;
+	OutMip.sizeY = InImage.sizeY;
+	OutMip.data.resize( InImage.sizeX * InImage.sizeY * 4 );
+
+	g_ThreadPool.ParallelFor( InImage.sizeY, [&]( uint32 InY )
+	{
+		const float*	srcRow = InImage.texels.data() + InY * sizeX * 4;
+		byte*			dstRow = OutMip.data.data() + InY * sizeX * 4;
+		for ( uint32 x = 0; x < sizeX; ++x )
+		{
+			const float*	src		= srcRow + x * 4;
+			byte*			dst		= dstRow + x * 4;
+			const float		alpha	= Clamp( src[3], 0.f, 1.f );
+			for ( uint32 channel = 0; channel < 3; ++channel )
+			{
+				// Color is stored with straight alpha
+				float	value = src[channel];
+				if ( InSettings.bPremultipliedAlpha )
+				{
+					value = alpha > 0.f ? value / alpha : 0.f;
+				}
+
+				value = Clamp( value, 0.f, 1.f );
+				dst[channel] = InSettings.bSRGB ? tables.toSRGB[( uint32 )( value * ( MIPGENERATOR_SRGB_TABLE_SIZE - 1 ) + 0.5f )] : ( byte )( value * 255.f + 0.5f );
+			}
+			dst[3] = ( byte )( Clamp( alpha * InAlphaScale, 0.f, 1.f ) * 255.f + 0.5f );
+		}
+	}, rowsPerJob );
+}
+
+/*
+==================
+CMipGenerator::DownsampleBox
+==================
+*/
+void CMipGenerator::DownsampleBox( const FloatImage& InSrc, FloatImage& OutDst )
+{
+	const uint32	rowsPerJob = GetNumRowsPerJob( OutDst.sizeX );
+	OutDst.texels.resize( OutDst.sizeX * OutDst.sizeY * 4 );
+
+	// Even sizes is 2x2 box, no need taps for it
+	if ( ( InSrc.sizeX & 1 ) == 0 && ( InSrc.sizeY & 1 ) == 0 )
+	{
+		g_ThreadPool.ParallelFor( OutDst.sizeY, [&]( uint32 InY )
+		{
+			const float*	srcRow0 = InSrc.texels.data() + InY * 2 * InSrc.sizeX * 4;
+			const float*	srcRow1 = srcRow0 + InSrc.sizeX * 4;
+			float*			dstRow	= OutDst.texels.data() + InY * OutDst.sizeX * 4;
+			for ( uint32 x = 0; x < OutDst.sizeX; ++x )
+			{
+				const uint32	srcX0	= x * 8;
+				const uint32	srcX1	= srcX0 + 4;
+				MipTexel_t		sum		= MipTexelAdd( MipTexelAdd( MipTexelLoad( srcRow0 + srcX0 ), MipTexelLoad( srcRow0 + srcX1 ) ),
+													   MipTexelAdd( MipTexelLoad( srcRow1 + srcX0 ), MipTexelLoad( srcRow1 + srcX1 ) ) );
+				MipTexelStore( dstRow + x * 4, MipTexelScale( sum, 0.25f ) );
+			}
+		}, rowsPerJob );
+		return;
+	}
+
+	// Odd sizes are filtered by three texels weighted by covered area, so the last row and column aren't dropped
+	std::vector<MipFilterTaps>		tapsX;
+	std::vector<MipFilterTaps>		tapsY;
+	CalcBoxTaps( InSrc.sizeX, OutDst.sizeX, tapsX );
+	CalcBoxTaps( InSrc.sizeY, OutDst.sizeY, tapsY );
+
+	g_ThreadPool.ParallelFor( OutDst.sizeY, [&]( uint32 InY )
+	{
+		const MipFilterTaps&	rowTaps = tapsY[InY];
+		float*					dstRow	= OutDst.texels.data() + InY * OutDst.sizeX * 4;
+		for ( uint32 x = 0; x < OutDst.sizeX; ++x )
+		{
+			const MipFilterTaps&	columnTaps	= tapsX[x];
+			MipTexel_t				sum			= MipTexelZero();
+			for ( uint32 indexRow = 0, countRows = rowTaps.indeces.size(); indexRow < countRows; ++indexRow )
+			{
+				const float*	srcRow = InSrc.texels.data() + rowTaps.indeces[indexRow] * InSrc.sizeX * 4;
+				for ( uint32 indexColumn = 0, countColumns = columnTaps.indeces.size(); indexColumn < countColumns; ++indexColumn )
+				{
+					sum = MipTexelMadd( sum, MipTexelLoad( srcRow + columnTaps.indeces[indexColumn] * 4 ), rowTaps.weights[indexRow] * columnTaps.weights[indexColumn] );
+				}
+			}
+			MipTexelStore( dstRow + x * 4, sum );
+		}
+	}, rowsPerJob );
+}
+
+/*
+==================
+CMipGenerator::DownsampleKaiser
+==================
+*/
+void CMipGenerator::DownsampleKaiser( const FloatImage& InSrc, FloatImage& OutDst )
+{
+	std::vector<MipFilterTaps>		tapsX;
+	std::vector<MipFilterTaps>		tapsY;
+	CalcKaiserTaps( InSrc.sizeX, OutDst.sizeX, tapsX );
+	CalcKaiserTaps( InSrc.sizeY, OutDst.sizeY, tapsY );
+
+	// Horizontal pass to temporary image with width of destination and height of source
+	FloatImage		tempImage;
+	tempImage.sizeX = OutDst.sizeX;
+	tempImage.sizeY = InSrc.sizeY;
+	tempImage.texels.resize( tempImage.sizeX * tempImage.sizeY * 4 );
+
+	g_ThreadPool.ParallelFor( tempImage.sizeY, [&]( uint32 InY )
+	{
+		const float*	srcRow = InSrc.texels.data() + InY * InSrc.sizeX * 4;
+		float*			dstRow = tempImage.texels.data() + InY * tempImage.sizeX * 4;
+		for ( uint32 x = 0; x < tempImage.sizeX; ++x )
+		{
+			const MipFilterTaps&	taps	= tapsX[x];
+			MipTexel_t				sum		= MipTexelZero();
+			for ( uint32 index = 0, count = taps.indeces.size(); index < count; ++index )
+			{
+				sum = MipTexelMadd( sum, MipTexelLoad( srcRow + taps.indeces[index] * 4 ), taps.weights[index] );
+			}
+			MipTexelStore( dstRow + x * 4, sum );
+		}
+	}, GetNumRowsPerJob( InSrc.sizeX ) );
+
+	// Vertical pass, whole rows of temporary image are accumulated
+	OutDst.texels.resize( OutDst.sizeX * OutDst.sizeY * 4 );
+	g_ThreadPool.ParallelFor( OutDst.sizeY, [&]( uint32 InY )
+	{
+		const MipFilterTaps&	taps	= tapsY[InY];
+		float*					dstRow	= OutDst.texels.data() + InY * OutDst.sizeX * 4;
+		for ( uint32 x = 0; x < OutDst.sizeX; ++x )
+		{
+			MipTexel_t		sum = MipTexelZero();
+			for ( uint32 index = 0, count = taps.indeces.size(); index < count; ++index )
+			{
+				sum = MipTexelMadd( sum, MipTexelLoad( tempImage.texels.data() + ( taps.indeces[index] * tempImage.sizeX + x ) * 4 ), taps.weights[index] );
+			}
+			MipTexelStore( dstRow + x * 4, sum );
+		}
+	}, GetNumRowsPerJob( OutDst.sizeX ) );
+}
+
+/*
+==================
+CMipGenerator::CalcAlphaCoverage
+==================
+*/
+float CMipGenerator::CalcAlphaCoverage( const FloatImage& InImage, const MipGenerationSettings& InSettings, float InAlphaScale )
+{
+	const uint32	numTexels	= InImage.sizeX * InImage.sizeY;
+	uint32			numCovered	= 0;
+	for ( uint32 index = 0; index < numTexels; ++index )
+	{
+		if ( InImage.texels[index * 4 + 3] * InAlphaScale > InSettings.alphaCoverageThreshold )
+		{
+			++numCovered;
+		}
+	}
+	return ( float )numCovered / numTexels;
+}
+
+/*
+==================
+CMipGenerator::FindAlphaScale
+==================
+*/
+float CMipGenerator::FindAlphaScale( const FloatImage& InImage, const MipGenerationSettings& InSettings, float InTargetCoverage )
+{
+	// Coverage grows with scale of alpha, so we can use binary search
+	float	minScale	= 0.f;
+	float	maxScale	= MIPGENERATOR_COVERAGE_MAX_SCALE;
+	float	bestScale	= 1.f;
+	float	bestError	= fabsf( CalcAlphaCoverage( InImage, InSettings, 1.f ) - InTargetCoverage );
+	for ( uint32 step = 0; step < MIPGENERATOR_COVERAGE_STEPS; ++step )
+	{
+		const float		scale		= ( minScale + maxScale ) * 0.5f;
+		const float		coverage	= CalcAlphaCoverage( InImage, InSettings, scale );
+		const float		error		= fabsf( coverage - InTargetCoverage );
+		if ( error < bestError )
+		{
+			bestError = error;
+			bestScale = scale;
+		}
+
+		if ( coverage < InTargetCoverage )
+		{
+			minScale = scale;
+		}
+		else if ( coverage > InTargetCoverage )
+		{
+			maxScale = scale;
+		}
+		else
+		{
+			break;
+		}
+	}
+	return bestScale;
+}
\ No newline at end of file
@@ -31,6 +31,32 @@ void CArchive::SerializeHeader()
 	*this << arType;
 }
 
+/*
+==================
+CArchive::SkipCompressed
+==================
+*/
+void CArchive::SkipCompressed( uint32 InSize, ECompressionFlags InFlags )
+{
+	Assert( IsLoading() );
+	if ( InFlags == CF_None )
+	{
+		Seek( Tell() + InSize );
+		return;
+	}
+
+	if ( arVer >= VER_CompressedZlib )
+	{
+		// Read in base summary, it contains total size of compressed chunks
+		CompressedChunkInfo		summary;
+		*this << summary;
+
+		// Skip compression chunk infos and compressed data
+		uint32		totalChunkCount = ( summary.uncompressedSize + LOADING_COMPRESSION_CHUNK_SIZE - 1 ) / LOADING_COMPRESSION_CHUNK_SIZE;
+		Seek( Tell() + totalChunkCount * sizeof( CompressedChunkInfo ) + summary.compressedSize );
+	}
+}
+
 /*
 ==================
 CArchive::SerializeCompressed
@@ -0,0 +1,260 @@
+#include "Misc/Misc.h"
+#include "Misc/Template.h"
+#include "Containers/String.h"
+#include "Logger/LoggerMacros.h"
+#include "System/ThreadPool.h"
+
+/* Max count of work semaphore */
+#define THREADPOOL_SEMAPHORE_MAX_COUNT		0x7FFFFFFF
+
+// -------------
+// GLOBALS
+// -------------
+CThreadPool			g_ThreadPool;
+
+/*
+==================
+CThreadPool::CWorkerRunnable::CWorkerRunnable
+==================
+*/
+CThreadPool::CWorkerRunnable::CWorkerRunnable( CThreadPool* InPool )
+	: pool( InPool )
+{}
+
+/*
+==================
+CThreadPool::CWorkerRunnable::Init
+==================
+*/
+bool CThreadPool::CWorkerRunnable::Init()
+{
+	return true;
+}
+
+/*
+==================
+CThreadPool::CWorkerRunnable::Run
+==================
+*/
+uint32 CThreadPool::CWorkerRunnable::Run()
+{
+	while ( true )
+	{
+		pool->workSemaphore->Wait();
+		if ( pool->bStopping )
+		{
+			return 0;
+		}
+
+		// Join to current task. Semaphore may be posted for already finished task, in this case we wait again
+		Task*		task = nullptr;
+		{
+			CScopeLock		scopeLock( &pool->csTask );
+			task = pool->currentTask;
+			if ( task )
+			{
+				Sys_InterlockedIncrement( &task->numActiveWorkers );
+			}
+		}
+
+		if ( !task )
+		{
+			continue;
+		}
+
+		ExecuteTask( task );
+		if ( Sys_InterlockedDecrement( &task->numActiveWorkers ) == 0 )
+		{
+			pool->taskDoneEvent->Trigger();
+		}
+	}
+
+	return 0;
+}
+
+/*
+==================
+CThreadPool::CWorkerRunnable::Stop
+==================
+*/
+void CThreadPool::CWorkerRunnable::Stop()
+{}
+
+/*
+==================
+CThreadPool::CWorkerRunnable::Exit
+==================
+*/
+void CThreadPool::CWorkerRunnable::Exit()
+{}
+
+/*
+==================
+CThreadPool::CThreadPool
+==================
+*/
+CThreadPool::CThreadPool()
+	: workSemaphore( nullptr )
+	, taskDoneEvent( nullptr )
+	, currentTask( nullptr )
+	, bBusy( 0 )
+	, bStopping( false )
+{}
+
+/*
+==================
+CThreadPool::~CThreadPool
+==================
+*/
+CThreadPool::~CThreadPool()
+{
+	Shutdown();
+}
+
+/*
+==================
+CThreadPool::Init
+==================
+*/
+void CThreadPool::Init( uint32 InNumWorkers /* = 0 */ )
+{
+	Assert( !IsInitialized() );
+
+	// Calling thread is worker too, so by default we create one thread less then cores
+	uint32		numWorkers = InNumWorkers;
+	if ( numWorkers == 0 )
+	{
+		numWorkers = Sys_GetNumberOfCores() - 1;
+	}
+	numWorkers = Min<uint32>( numWorkers, THREADPOOL_MAX_WORKERS );
+
+	if ( numWorkers == 0 )
+	{
+		Logf( TEXT( "Thread pool is disabled, all parallel work will be executed on calling thread\n" ) );
+		return;
+	}
+
+	bStopping		= false;
+	workSemaphore	= g_SynchronizeFactory->CreateSemaphore( THREADPOOL_SEMAPHORE_MAX_COUNT, 0 );
+	taskDoneEvent	= g_SynchronizeFactory->CreateSynchEvent( false );
+	Assert( workSemaphore && taskDoneEvent );
+
+	for ( uint32 index = 0; index < numWorkers; ++index )
+	{
+		CWorkerRunnable*	runnable	= new CWorkerRunnable( this );
+		CRunnableThread*	thread		= g_ThreadFactory->CreateThread( runnable, CString::Format( TEXT( "PoolWorker%i" ), index ).c_str(), false, false, 0, TP_Normal );
+		Assert( thread );
+
+		runnables.push_back( runnable );
+		threads.push_back( thread );
+	}
+
+	Logf( TEXT( "Thread pool started with %i workers\n" ), numWorkers );
+}
+
+/*
+==================
+CThreadPool::Shutdown
+==================
+*/
+void CThreadPool::Shutdown()
+{
+	if ( !IsInitialized() )
+	{
+		return;
+	}
+
+	// Wake up all workers, they will see stop flag and exit
+	bStopping = true;
+	workSemaphore->Post( threads.size() );
+	for ( uint32 index = 0, count = threads.size(); index < count; ++index )
+	{
+		CRunnableThread*	thread = threads[index];
+		thread->WaitForCompletion();
+		thread->Kill();
+		g_ThreadFactory->Destroy( thread );
+		delete runnables[index];
+	}
+
+	threads.clear();
+	runnables.clear();
+
+	g_SynchronizeFactory->Destroy( workSemaphore );
+	g_SynchronizeFactory->Destroy( taskDoneEvent );
+	workSemaphore	= nullptr;
+	taskDoneEvent	= nullptr;
+}
+
+/*
+==================
+CThreadPool::ExecuteTask
+==================
+*/
+void CThreadPool::ExecuteTask( Task* InTask )
+{
+	while ( true )
+	{
+		uint32		startIndex = ( uint32 )Sys_InterlockedAdd( &InTask->nextIndex, InTask->batchSize );
+		if ( startIndex >= InTask->num )
+		{
+			break;
+		}
+
+		for ( uint32 index = startIndex, endIndex = Min( startIndex + InTask->batchSize, InTask->num ); index < endIndex; ++index )
+		{
+			( *InTask->function )( index );
+		}
+	}
+}
+
+/*
+==================
+CThreadPool::ParallelFor
+==================
+*/
+void CThreadPool::ParallelFor( uint32 InNum, const TaskFunction_t& InFunction, uint32 InBatchSize /* = 1 */ )
+{
+	if ( InNum == 0 )
+	{
+		return;
+	}
+
+	// Small tasks, nested calls and calls while pool is busy by other thread are executed on calling thread
+	InBatchSize = Max<uint32>( InBatchSize, 1 );
+	const uint32	numBatches = ( InNum + InBatchSize - 1 ) / InBatchSize;
+	if ( !IsInitialized() || numBatches <= 1 || Sys_InterlockedCompareExchange( &bBusy, 1, 0 ) != 0 )
+	{
+		for ( uint32 index = 0; index < InNum; ++index )
+		{
+			InFunction( index );
+		}
+		return;
+	}
+
+	Task		task;
+	task.function			= &InFunction;
+	task.num				= InNum;
+	task.batchSize			= InBatchSize;
+	task.nextIndex			= 0;
+	task.numActiveWorkers	= 1;
+	{
+		CScopeLock		scopeLock( &csTask );
+		currentTask = &task;
+	}
+
+	// Wake up workers and take part in the task
+	workSemaphore->Post( Min<uint32>( numBatches - 1, threads.size() ) );
+	ExecuteTask( &task );
+
+	// New workers can't join to the task after this point, wait when the last one left it
+	{
+		CScopeLock		scopeLock( &csTask );
+		currentTask = nullptr;
+	}
+
+	if ( Sys_InterlockedDecrement( &task.numActiveWorkers ) != 0 )
+	{
+		taskDoneEvent->Wait();
+	}
+	Sys_InterlockedExchange( &bBusy, 0 );
+}
\ No newline at end of file
@@ -610,11 +610,6 @@ public:
 	 */
 	void TermPhysics();
 
-	/**
-	 * @brief Sync actor to physics body
-	 */
-	void SyncPhysics();
-
 #if WITH_EDITOR
 	/**
 	 * @brief Initialize actor properties
@@ -697,6 +692,18 @@ public:
 		rootComponent->SetRelativeLocation( InNewLocation );
 	}
 
+	/**
+	 * @brief Set actor location and rotation in world space at once
+	 *
+	 * @param InNewLocation		New actor location
+	 * @param InNewRotation		New actor rotation
+	 */
+	FORCEINLINE void SetActorLocationAndRotation( const Vector& InNewLocation, const Quaternion& InNewRotation )
+	{
+		if ( !rootComponent )	return;
+		rootComponent->SetRelativeLocationAndRotation( InNewLocation, InNewRotation );
+	}
+
 	/**
 	 * @brief Set actor rotation in world space
 	 * 
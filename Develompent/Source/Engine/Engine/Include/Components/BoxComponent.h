@@ -50,6 +50,12 @@ public:
 	FORCEINLINE void SetSize( const Vector& InSize )
 	{
 		size = InSize;
+
+		// If body setup already exist - update it, shapes of body will be swapped at next tick
+		if ( bodySetup )
+		{
+			UpdateBodySetup();
+		}
 	}
 
 	/**
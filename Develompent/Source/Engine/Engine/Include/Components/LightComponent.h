@@ -114,6 +114,16 @@ public:
 	 */
 	virtual ELightType GetLightType() const;
 
+	/**
+	 * @brief Get bounding sphere of the light influence
+	 * Need override the method by child for lights with limited influence (point, spot)
+	 *
+	 * @param OutCenter		Output center of bounding sphere in world space
+	 * @param OutRadius		Output radius of bounding sphere
+	 * @return Return TRUE if the light has limited influence, otherwise return FALSE (e.g. directional light affects whole scene)
+	 */
+	virtual bool GetBoundingSphere( Vector& OutCenter, float& OutRadius ) const;
+
 	/**
 	 * @brief Is enabled
 	 * @return Return TRUE if the light component is enabled
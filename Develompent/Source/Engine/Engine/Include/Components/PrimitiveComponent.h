@@ -12,6 +12,8 @@
 #include "Math/Box.h"
 #include "System/PhysicsBodySetup.h"
 #include "System/PhysicsBodyInstance.h"
+#include "System/Delegate.h"
+#include "Scripts/Script.h"
 #include "Components/SceneComponent.h"
 
 /**
@@ -20,6 +22,12 @@
  */
 typedef TRefCountPtr< class CPrimitiveComponent >		PrimitiveComponentRef_t;
 
+/**
+ * @ingroup Engine
+ * @brief Delegate for called event when primitive component collides with other component
+ */
+DECLARE_MULTICAST_DELEGATE( COnComponentContact, class CPrimitiveComponent* /*InComponent*/, class CPrimitiveComponent* /*InOtherComponent*/, const PhysicsContactEvent& /*InEvent*/ );
+
 /**
  * @ingroup Engine
  * PrimitiveComponents are SceneComponents that contain or generate some sort of geometry, generally to be rendered or used as collision data.
@@ -86,6 +94,44 @@ public:
 	 */
 	void TermPrimitivePhysics();
 
+	/**
+	 * @brief Notify component about collision event
+	 * @note Called by world after the sync point with physics for both bodies of event. Event is ignored if body hasn't notify flag of it, other component is NULL when other body was removed
+	 *
+	 * @param InEvent	Collision event
+	 */
+	void NotifyContactEvent( const PhysicsContactEvent& InEvent );
+
+	/**
+	 * @brief Set script for receive collision events
+	 * @note Script may define functions OnBeginContact, OnEndContact, OnBeginOverlap, OnEndOverlap and OnHit
+	 * with arguments (otherActorName, normalX, normalY, normalZ, impulse). Normal points from this component to other
+	 *
+	 * @param InContactScript	Script
+	 */
+	FORCEINLINE void SetContactScript( const TAssetHandle<CScript>& InContactScript )
+	{
+		contactScript = InContactScript;
+	}
+
+	/**
+	 * @brief Get script for receive collision events
+	 * @return Return script for receive collision events
+	 */
+	FORCEINLINE TAssetHandle<CScript> GetContactScript() const
+	{
+		return contactScript;
+	}
+
+	/**
+	 * @brief Get event when component collides with other component
+	 * @return Return event when component collides with other component
+	 */
+	FORCEINLINE COnComponentContact& OnComponentContact() const
+	{
+		return onComponentContact;
+	}
+
 	/**
 	 * @brief Set visibility
 	 * 
@@ -173,6 +219,8 @@ protected:
 	PhysicsBodySetupRef_t		bodySetup;						/**< Physics body setup */
 	CPhysicsBodyInstance		bodyInstance;					/**< Physics body instance */	
 	class CScene*				scene;							/**< The current scene where the primitive is located  */
+	TAssetHandle<CScript>		contactScript;					/**< Script for receive collision events */
+	mutable COnComponentContact	onComponentContact;				/**< Called event when component collides with other component */
 };
 
 #endif // !PRIMITIVECOMPONENT_H
@@ -158,6 +158,18 @@ public:
 		}
 	}
 
+	/**
+	 * @brief Set relative location and rotation component at once
+	 *
+	 * @param InLocation	New relative location
+	 * @param InRotation	New relative rotation of component
+	 */
+	FORCEINLINE void SetRelativeLocationAndRotation( const Vector& InLocation, const Quaternion& InRotation )
+	{
+		SetRelativeLocation( InLocation );
+		SetRelativeRotation( InRotation );
+	}
+
 	/**
 	 * @brief Set relative scale component
 	 * 
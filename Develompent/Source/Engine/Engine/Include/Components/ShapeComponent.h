@@ -61,6 +61,10 @@ public:
 		if ( newCollisionProfile )
 		{
 			collisionProfile = newCollisionProfile;
+			if ( bodySetup )
+			{
+				UpdateBodySetup();
+			}
 		}
 	}
 
@@ -71,6 +75,10 @@ public:
 	FORCEINLINE void SetPhysMaterial( const TAssetHandle<CPhysicsMaterial>& InPhysMaterial )
 	{
 		physicsMaterial = InPhysMaterial.IsAssetValid() ? InPhysMaterial : g_PhysicsEngine.GetDefaultPhysMaterial();
+		if ( bodySetup )
+		{
+			UpdateBodySetup();
+		}
 	}
 
 	/**
@@ -72,6 +72,15 @@ public:
 	 */
 	virtual ELightType GetLightType() const override;
 
+	/**
+	 * @brief Get bounding sphere of the light influence
+	 *
+	 * @param OutCenter		Output center of bounding sphere in world space
+	 * @param OutRadius		Output radius of bounding sphere
+	 * @return Return TRUE if the light has limited influence, otherwise return FALSE
+	 */
+	virtual bool GetBoundingSphere( Vector& OutCenter, float& OutRadius ) const override;
+
 	/**
 	 * @brief Get radius
 	 * @return Return radius
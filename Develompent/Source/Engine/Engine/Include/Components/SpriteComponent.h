@@ -96,7 +96,7 @@ public:
 	FORCEINLINE void SetTextureRect( const RectFloat_t& InTextureRect )
 	{
 		sprite->SetTextureRect( InTextureRect );
-		bIsDirtyDrawingPolicyLink = true;
+		MarkDirtySpriteParameters();
 	}
 
 	/**
@@ -115,7 +115,7 @@ public:
 	FORCEINLINE void SetSpriteSize( const Vector2D& InSpriteSize )
 	{
 		sprite->SetSpriteSize( InSpriteSize );
-		bIsDirtyDrawingPolicyLink = true;
+		MarkDirtySpriteParameters();
 	}
 
 	/**
@@ -127,6 +127,26 @@ public:
 		return sprite->GetSpriteSize();
 	}
 
+	/**
+	 * @brief Set sprite color
+	 * @param InSpriteColor Sprite color
+	 */
+	FORCEINLINE void SetSpriteColor( const CColor& InSpriteColor )
+	{
+		sprite->SetSpriteColor( InSpriteColor );
+		spriteColor = InSpriteColor;
+		MarkDirtySpriteParameters();
+	}
+
+	/**
+	 * @brief Get sprite color
+	 * @return Return sprite color
+	 */
+	FORCEINLINE const CColor& GetSpriteColor() const
+	{
+		return spriteColor;
+	}
+
 	/**
 	 * @brief Set material
 	 * @param InMaterial Material
@@ -250,6 +270,35 @@ private:
 	 */
 	typedef CMeshDrawList<CDepthDrawingPolicy>::DrawingPolicyLinkRef_t					DepthDrawingPolicyLinkRef_t;
 
+	/**
+	 * @brief Mark drawing policy links dirty after change of sprite parameters in vertex factory
+	 * @note Batched sprite bakes texture rect, size and color to verteces every frame, so it needs relink only for hit proxy
+	 */
+	FORCEINLINE void MarkDirtySpriteParameters()
+	{
+#if !ENABLE_HITPROXY
+		if ( bBatched )
+		{
+			return;
+		}
+#endif // !ENABLE_HITPROXY
+
+		bIsDirtyDrawingPolicyLink = true;
+	}
+
+	/**
+	 * @brief Is sprite must be drawn by sprite batcher
+	 * @return Return TRUE if sprite must be drawn by sprite batcher of SDG
+	 */
+	FORCEINLINE bool IsBatchable() const
+	{
+		return CSpriteBatcher::IsEnabled()
+#if WITH_EDITOR
+			&& !bGizmo
+#endif // WITH_EDITOR
+			;
+	}
+
 	/**
 	 * @brief Calculate transformation matrix
 	 *
@@ -275,6 +324,8 @@ private:
 
 	bool								bFlipVertical;					/**< Is need flip sprite by vertical */
 	bool								bFlipHorizontal;				/**< Is need flip sprite by horizontal */
+	bool								bBatched;						/**< Is sprite drawn by sprite batcher */
+	CColor								spriteColor;					/**< Sprite color */
     TEnumAsByte<ESpriteType>			type;							/**< Sprite type */
 	SpriteRef_t							sprite;							/**< Sprite mesh */
 	TAssetHandle<CMaterial>				material;						/**< Sprite material */
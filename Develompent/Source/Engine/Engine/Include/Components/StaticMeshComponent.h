@@ -140,6 +140,7 @@ private:
 	TAssetHandle<CStaticMesh>								drawStaticMesh;					/**< Static mesh which drawing now */
 	std::vector< TAssetHandle<CMaterial> >					overrideMaterials;				/**< Override materials */
 	TSharedPtr<CStaticMesh::ElementDrawingPolicyLink>		elementDrawingPolicyLink;		/**< Element drawing policy link of current static mesh */
+	uint32													currentLOD;						/**< Current LOD of static mesh (without LOD bias) */
 };
 
 #endif // !STATICMESHCOMPONENT_H
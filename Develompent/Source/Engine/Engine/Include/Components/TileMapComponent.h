@@ -0,0 +1,452 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TILEMAPCOMPONENT_H
+#define TILEMAPCOMPONENT_H
+
+#include <vector>
+
+#include "Math/Rect.h"
+#include "Misc/SharedPointer.h"
+#include "Misc/PhysicsGlobals.h"
+#include "System/PhysicsEngine.h"
+#include "Components/PrimitiveComponent.h"
+#include "Render/Scene.h"
+#include "Render/TileMapMesh.h"
+
+#if ENABLE_HITPROXY
+#include "Render/SceneHitProxyRendering.h"
+#endif // ENABLE_HITPROXY
+
+/**
+ * @ingroup Engine
+ * @brief Size of tile map chunk in tiles by each axis
+ */
+#define TILEMAP_CHUNK_SIZE		32
+
+/**
+ * @ingroup Engine
+ * @brief Index of empty tile in layer of tile map
+ */
+#define TILEMAP_EMPTY_TILE		0
+
+/**
+ * @ingroup Engine
+ * @brief Tile in palette of tile map
+ */
+struct TileMapTile
+{
+	/**
+	 * @brief Constructor
+	 */
+	TileMapTile()
+		: textureRect( 0.f, 0.f, 1.f, 1.f )
+		, size( 1.f, 1.f )
+	{}
+
+	/**
+	 * @brief Overload operator ==
+	 */
+	FORCEINLINE bool operator==( const TileMapTile& InOther ) const
+	{
+		return material == InOther.material &&
+			textureRect.left == InOther.textureRect.left && textureRect.top == InOther.textureRect.top &&
+			textureRect.width == InOther.textureRect.width && textureRect.height == InOther.textureRect.height &&
+			size == InOther.size;
+	}
+
+	/**
+	 * @brief Overload operator << for serialize
+	 */
+	FORCEINLINE friend CArchive& operator<<( CArchive& InArchive, TileMapTile& InValue )
+	{
+		InArchive << InValue.material;
+		InArchive << InValue.textureRect;
+		InArchive << InValue.size;
+		return InArchive;
+	}
+
+	/**
+	 * @brief Overload operator << for serialize
+	 */
+	FORCEINLINE friend CArchive& operator<<( CArchive& InArchive, const TileMapTile& InValue )
+	{
+		Assert( InArchive.IsSaving() );
+		return InArchive << ( TileMapTile& )InValue;
+	}
+
+	TAssetHandle<CMaterial>		material;		/**< Material */
+	RectFloat_t					textureRect;	/**< Texture rect */
+	Vector2D					size;			/**< Size of tile, tile is anchored by bottom left corner of cell */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Layer of tile map
+ */
+struct TileMapLayer
+{
+	/**
+	 * @brief Constructor
+	 */
+	TileMapLayer()
+		: bCollision( false )
+		, depth( 0.f )
+	{}
+
+	bool					bCollision;		/**< Is tiles of layer have collision */
+	float					depth;			/**< Z coord of tiles in layer */
+	std::vector<uint16>		tiles;			/**< Grid of tiles from bottom left cell, every value is index in palette plus one (TILEMAP_EMPTY_TILE for empty cell) */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Component of tile map
+ *
+ * Tile map stores layers as grids of indeces in palette of tiles and it is split to chunks of TILEMAP_CHUNK_SIZE x TILEMAP_CHUNK_SIZE cells.
+ * Every chunk has static mesh with all own tiles which is culled by frustum separately and merged collision of tiles.
+ * On changing tile only its chunk is rebuilt
+ */
+class CTileMapComponent : public CPrimitiveComponent
+{
+	DECLARE_CLASS( CTileMapComponent, CPrimitiveComponent, 0, 0 )
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTileMapComponent();
+
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~CTileMapComponent();
+
+	/**
+	 * @brief Begins Play for the component
+	 */
+	virtual void BeginPlay() override;
+
+	/**
+	 * @brief Ends gameplay for this component
+	 */
+	virtual void EndPlay() override;
+
+	/**
+	 * @brief Function called every frame on this ActorComponent. Override this function to implement custom logic to be executed every frame.
+	 *
+	 * @param[in] InDeltaTime The time since the last tick.
+	 */
+	virtual void TickComponent( float InDeltaTime ) override;
+
+	/**
+	 * @brief Adds mesh batches for draw in scene
+	 *
+	 * @param InSceneView Current view of scene
+	 */
+	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
+
+	/**
+	 * @brief Serialize component
+	 * @param[in] InArchive Archive for serialize
+	 */
+	virtual void Serialize( class CArchive& InArchive ) override;
+
+	/**
+	 * @brief Set size of map
+	 * @note All layers and tiles will be removed
+	 *
+	 * @param InSizeX		Number of cells by X
+	 * @param InSizeY		Number of cells by Y
+	 * @param InCellSize	Size of cell
+	 */
+	void SetMapSize( uint32 InSizeX, uint32 InSizeY, const Vector2D& InCellSize );
+
+	/**
+	 * @brief Add layer
+	 * @note Layers are drawn in order of adding
+	 *
+	 * @param InDepth			Z coord of tiles in layer
+	 * @param InIsCollision		Is tiles of layer have collision
+	 * @return Return index of layer
+	 */
+	uint32 AddLayer( float InDepth, bool InIsCollision = false );
+
+	/**
+	 * @brief Add tile to palette
+	 *
+	 * @param InTile	Tile
+	 * @return Return tile index for SetTile. If the same tile already exist in palette will be returned his index
+	 */
+	uint16 AddTile( const TileMapTile& InTile );
+
+	/**
+	 * @brief Set tile in cell
+	 *
+	 * @param InLayer	Index of layer
+	 * @param InX		Cell by X (from left)
+	 * @param InY		Cell by Y (from bottom)
+	 * @param InTile	Tile index returned by AddTile or TILEMAP_EMPTY_TILE
+	 */
+	void SetTile( uint32 InLayer, uint32 InX, uint32 InY, uint16 InTile );
+
+	/**
+	 * @brief Get tile in cell
+	 *
+	 * @param InLayer	Index of layer
+	 * @param InX		Cell by X (from left)
+	 * @param InY		Cell by Y (from bottom)
+	 * @return Return tile index, if cell is empty returns TILEMAP_EMPTY_TILE
+	 */
+	FORCEINLINE uint16 GetTile( uint32 InLayer, uint32 InX, uint32 InY ) const
+	{
+		Assert( InLayer < layers.size() && InX < sizeX && InY < sizeY );
+		return layers[InLayer].tiles[InY * sizeX + InX];
+	}
+
+	/**
+	 * @brief Get tile from palette
+	 *
+	 * @param InTile	Tile index
+	 * @return Return tile from palette
+	 */
+	FORCEINLINE const TileMapTile& GetPaletteTile( uint16 InTile ) const
+	{
+		Assert( InTile != TILEMAP_EMPTY_TILE && InTile <= palette.size() );
+		return palette[InTile - 1];
+	}
+
+	/**
+	 * @brief Set physics material of collision
+	 * @param InPhysMaterial	Physics material
+	 */
+	FORCEINLINE void SetPhysMaterial( const TAssetHandle<CPhysicsMaterial>& InPhysMaterial )
+	{
+		physicsMaterial = InPhysMaterial;
+		MarkDirtyAllChunks( false, true );
+	}
+
+	/**
+	 * @brief Get number of cells by X
+	 * @return Return number of cells by X
+	 */
+	FORCEINLINE uint32 GetSizeX() const
+	{
+		return sizeX;
+	}
+
+	/**
+	 * @brief Get number of cells by Y
+	 * @return Return number of cells by Y
+	 */
+	FORCEINLINE uint32 GetSizeY() const
+	{
+		return sizeY;
+	}
+
+	/**
+	 * @brief Get size of cell
+	 * @return Return size of cell
+	 */
+	FORCEINLINE const Vector2D& GetCellSize() const
+	{
+		return cellSize;
+	}
+
+	/**
+	 * @brief Get number of layers
+	 * @return Return number of layers
+	 */
+	FORCEINLINE uint32 GetNumLayers() const
+	{
+		return layers.size();
+	}
+
+	/**
+	 * @brief Get number of tiles in palette
+	 * @return Return number of tiles in palette
+	 */
+	FORCEINLINE uint32 GetNumPaletteTiles() const
+	{
+		return palette.size();
+	}
+
+	/**
+	 * @brief Get number of chunks
+	 * @return Return number of chunks
+	 */
+	FORCEINLINE uint32 GetNumChunks() const
+	{
+		return chunks.size();
+	}
+
+	/**
+	 * @brief Get physics material of collision
+	 * @return Return physics material of collision
+	 */
+	FORCEINLINE TAssetHandle<CPhysicsMaterial> GetPhysMaterial() const
+	{
+		return physicsMaterial;
+	}
+
+private:
+	/**
+	 * @brief Typedef of drawing policy link
+	 */
+	typedef CMeshDrawList<CMeshDrawingPolicy>::DrawingPolicyLink					DrawingPolicyLink_t;
+
+	/**
+	 * @brief Typedef of reference on drawing policy link in scene
+	 */
+	typedef CMeshDrawList<CMeshDrawingPolicy>::DrawingPolicyLinkRef_t				DrawingPolicyLinkRef_t;
+
+#if ENABLE_HITPROXY
+	/**
+	 * @brief Typedef of hit proxy drawing policy link
+	 */
+	typedef CMeshDrawList<CHitProxyDrawingPolicy, false>::DrawingPolicyLink			HitProxyDrawingPolicyLink_t;
+
+	/**
+	 * @brief Typedef of reference on hit proxy drawing policy link in scene
+	 */
+	typedef CMeshDrawList<CHitProxyDrawingPolicy, false>::DrawingPolicyLinkRef_t		HitProxyDrawingPolicyLinkRef_t;
+#endif // ENABLE_HITPROXY
+
+	/**
+	 * @brief Typedef of depth drawing policy link
+	 */
+	typedef CMeshDrawList<CDepthDrawingPolicy>::DrawingPolicyLink						DepthDrawingPolicyLink_t;
+
+	/**
+	 * @brief Typedef of reference on depth drawing policy link in scene
+	 */
+	typedef CMeshDrawList<CDepthDrawingPolicy>::DrawingPolicyLinkRef_t					DepthDrawingPolicyLinkRef_t;
+
+	/**
+	 * @brief Chunk of tile map
+	 */
+	struct TileMapChunk
+	{
+		/**
+		 * @brief Constructor
+		 */
+		TileMapChunk()
+			: bDirtyMesh( true )
+			, bDirtyCollision( true )
+			, bNeedLink( false )
+			, mesh( new CTileMapChunkMesh() )
+		{}
+
+		bool											bDirtyMesh;					/**< Is need rebuild mesh */
+		bool											bDirtyCollision;			/**< Is need rebuild collision */
+		bool											bNeedLink;					/**< Is need add draw policy links when mesh will be ready */
+		CBox											boundbox;					/**< Bound box in local space of tile map */
+		TileMapChunkMeshRef_t							mesh;						/**< Mesh */
+		std::vector<DrawingPolicyLinkRef_t>				drawingPolicyLinks;			/**< References to drawing policy links in scene */
+		std::vector<DepthDrawingPolicyLinkRef_t>		depthDrawingPolicyLinks;	/**< References to depth drawing policy links in scene */
+		std::vector<const MeshBatch*>					meshBatchLinks;				/**< References to mesh batches in drawing policy links */
+		PhysicsBodySetupRef_t							bodySetup;					/**< Merged collision of chunk */
+		TSharedPtr<CPhysicsBodyInstance>				bodyInstance;				/**< Body instance of chunk */
+
+#if ENABLE_HITPROXY
+		std::vector<HitProxyDrawingPolicyLinkRef_t>		hitProxyDrawingPolicyLinks;	/**< References to hit proxy drawing policy links in scene */
+#endif // ENABLE_HITPROXY
+	};
+
+	/**
+	 * @brief Adds a draw policy link in SDGs
+	 */
+	virtual void LinkDrawList() override;
+
+	/**
+	 * @brief Removes a draw policy link from SDGs
+	 */
+	virtual void UnlinkDrawList() override;
+
+	/**
+	 * @brief Adds draw policy links of chunk in SDGs
+	 * @param InOutChunk	Chunk
+	 */
+	void LinkChunk( TileMapChunk& InOutChunk );
+
+	/**
+	 * @brief Removes draw policy links of chunk from SDGs
+	 * @param InOutChunk	Chunk
+	 */
+	void UnlinkChunk( TileMapChunk& InOutChunk );
+
+	/**
+	 * @brief Rebuild mesh of chunk
+	 * @param InChunkIndex	Index of chunk
+	 */
+	void RebuildChunkMesh( uint32 InChunkIndex );
+
+	/**
+	 * @brief Rebuild collision of chunk
+	 * Collision cells of chunk are merged greedy to minimal number of boxes
+	 *
+	 * @param InChunkIndex	Index of chunk
+	 */
+	void RebuildChunkCollision( uint32 InChunkIndex );
+
+	/**
+	 * @brief Terminate collision of all chunks
+	 */
+	void TermChunksCollision();
+
+	/**
+	 * @brief Rebuild local bound box of tile map by bound boxes of chunks
+	 */
+	void UpdateLocalBoundBox();
+
+	/**
+	 * @brief Create chunks by size of map
+	 */
+	void InitChunks();
+
+	/**
+	 * @brief Mark dirty all chunks
+	 *
+	 * @param InIsMesh			Is need rebuild meshes
+	 * @param InIsCollision		Is need rebuild collisions
+	 */
+	void MarkDirtyAllChunks( bool InIsMesh, bool InIsCollision );
+
+	/**
+	 * @brief Get number of chunks by X
+	 * @return Return number of chunks by X
+	 */
+	FORCEINLINE uint32 GetNumChunksX() const
+	{
+		return ( sizeX + TILEMAP_CHUNK_SIZE - 1 ) / TILEMAP_CHUNK_SIZE;
+	}
+
+	/**
+	 * @brief Get number of chunks by Y
+	 * @return Return number of chunks by Y
+	 */
+	FORCEINLINE uint32 GetNumChunksY() const
+	{
+		return ( sizeY + TILEMAP_CHUNK_SIZE - 1 ) / TILEMAP_CHUNK_SIZE;
+	}
+
+	bool								bPlaying;				/**< Is gameplay started, collision of chunks exist only in play */
+	bool								bDirtyMeshes;			/**< Is any chunk need rebuild mesh */
+	bool								bDirtyCollisions;		/**< Is any chunk need rebuild collision */
+	uint32								sizeX;					/**< Number of cells by X */
+	uint32								sizeY;					/**< Number of cells by Y */
+	Vector2D							cellSize;				/**< Size of cell */
+	CBox								localBoundBox;			/**< Bound box in local space */
+	std::vector<TileMapTile>			palette;				/**< Palette of tiles */
+	std::vector<TileMapLayer>			layers;					/**< Layers */
+	std::vector<TileMapChunk>			chunks;					/**< Chunks */
+	CollisionProfile*					collisionProfile;		/**< Collision profile */
+	TAssetHandle<CPhysicsMaterial>		physicsMaterial;		/**< Physics material */
+};
+
+#endif // !TILEMAPCOMPONENT_H
\ No newline at end of file
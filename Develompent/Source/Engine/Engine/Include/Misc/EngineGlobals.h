@@ -100,4 +100,10 @@ extern class CFullScreenMovieSupport*		g_FullScreenMovie;
  */
 extern class CConsoleSystem					g_ConsoleSystem;
 
+/**
+ * @ingroup Engine
+ * @brief Stat manager
+ */
+extern class CStatManager					g_StatManager;
+
 #endif // !ENGINEGLOBALS_H
@@ -0,0 +1,441 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <string>
+#include <vector>
+
+#include "Core.h"
+#include "System/ThreadingBase.h"
+
+/**
+ * @ingroup Engine
+ * @brief Enumeration of stat groups
+ */
+enum EStatGroup
+{
+	SG_FPS,			/**< Frame rate and frame time */
+	SG_Scene,		/**< Scene visibility and draw lists */
+	SG_RHI,			/**< Draw calls, primitives and uploads */
+	SG_Memory,		/**< Memory usage */
+	SG_Streaming,	/**< Texture streaming */
+	SG_Physics,		/**< Physics simulation */
+	SG_Num			/**< Number of stat groups */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Enumeration of stat counter types
+ */
+enum EStatCounterType
+{
+	SCT_Frame,			/**< Counter is reset to zero each frame */
+	SCT_Accumulator		/**< Counter keep value between frames (e.g. memory usage) */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Stat counter. Accumulation is thread safe, history is updated on game thread in CStatManager::AdvanceFrame
+ */
+class CStatCounter
+{
+public:
+	/**
+	 * @brief Number of frames in history
+	 */
+	static const uint32		numHistoryFrames = 64;
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InName	Name of counter
+	 * @param InGroup	Stat group
+	 * @param InType	Counter type
+	 */
+	CStatCounter( const tchar* InName, EStatGroup InGroup, EStatCounterType InType = SCT_Frame );
+
+	/**
+	 * @brief Destructor
+	 */
+	~CStatCounter();
+
+	/**
+	 * @brief Add value to counter
+	 * @param InAmount	Amount
+	 */
+	FORCEINLINE void Add( int64 InAmount )
+	{
+		int64		oldValue;
+		do
+		{
+			oldValue = value;
+		}
+		while ( Sys_InterlockedCompareExchange64( &value, oldValue + InAmount, oldValue ) != oldValue );
+	}
+
+	/**
+	 * @brief Increment counter
+	 */
+	FORCEINLINE void Increment()
+	{
+		Add( 1 );
+	}
+
+	/**
+	 * @brief Set value of counter
+	 * @param InValue	New value
+	 */
+	FORCEINLINE void Set( int64 InValue )
+	{
+		Sys_InterlockedExchange64( &value, InValue );
+	}
+
+	/**
+	 * @brief Close current frame and push value to history
+	 * @note Must be called only from CStatManager::AdvanceFrame
+	 */
+	void AdvanceFrame();
+
+	/**
+	 * @brief Get name of counter
+	 * @return Return name of counter
+	 */
+	FORCEINLINE const tchar* GetName() const
+	{
+		return name;
+	}
+
+	/**
+	 * @brief Get stat group
+	 * @return Return stat group
+	 */
+	FORCEINLINE EStatGroup GetGroup() const
+	{
+		return group;
+	}
+
+	/**
+	 * @brief Get counter type
+	 * @return Return counter type
+	 */
+	FORCEINLINE EStatCounterType GetType() const
+	{
+		return type;
+	}
+
+	/**
+	 * @brief Get value of last closed frame
+	 * @return Return value of last closed frame
+	 */
+	FORCEINLINE int64 GetLastValue() const
+	{
+		return lastValue;
+	}
+
+	/**
+	 * @brief Get rolling average of value
+	 * @return Return average value over history
+	 */
+	FORCEINLINE double GetAverage() const
+	{
+		return average;
+	}
+
+	/**
+	 * @brief Get max value in history
+	 * @return Return max value over history
+	 */
+	FORCEINLINE int64 GetMax() const
+	{
+		return maxValue;
+	}
+
+private:
+	const tchar*			name;								/**< Name of counter */
+	EStatGroup				group;								/**< Stat group */
+	EStatCounterType		type;								/**< Counter type */
+	volatile int64			value;								/**< Value of current frame */
+	int64					lastValue;							/**< Value of last closed frame */
+	int64					history[numHistoryFrames];			/**< History of values */
+	uint32					historyIndex;						/**< Next index in history */
+	uint32					numHistory;							/**< Number of valid values in history */
+	double					average;							/**< Average value over history */
+	int64					maxValue;							/**< Max value over history */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Get stat counters
+ * @return Return array of stat counters
+ */
+FORCEINLINE std::vector<CStatCounter*>& GetGlobalStatCounters()
+{
+	static std::vector<CStatCounter*>	counters;
+	return counters;
+}
+
+/**
+ * @ingroup Engine
+ * @brief Stat manager. Close frames of stat counters, show them on screen and dump them to CSV
+ */
+class CStatManager
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CStatManager();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CStatManager();
+
+	/**
+	 * @brief Close current frame of all stat counters
+	 * @note Must be called from game thread once per frame
+	 *
+	 * @param InDeltaSeconds	Delta time of frame
+	 */
+	void AdvanceFrame( double InDeltaSeconds );
+
+	/**
+	 * @brief Toggle visibility of stat group
+	 * @param InGroup	Stat group
+	 */
+	FORCEINLINE void ToggleGroup( EStatGroup InGroup )
+	{
+		SetGroupVisible( InGroup, !IsGroupVisible( InGroup ) );
+	}
+
+	/**
+	 * @brief Set visibility of stat group
+	 *
+	 * @param InGroup		Stat group
+	 * @param InIsVisible	Is visible
+	 */
+	FORCEINLINE void SetGroupVisible( EStatGroup InGroup, bool InIsVisible )
+	{
+		Assert( InGroup < SG_Num );
+		bGroupVisible[InGroup] = InIsVisible;
+	}
+
+	/**
+	 * @brief Hide all stat groups
+	 */
+	FORCEINLINE void HideAll()
+	{
+		for ( uint32 index = 0; index < SG_Num; ++index )
+		{
+			bGroupVisible[index] = false;
+		}
+	}
+
+	/**
+	 * @brief Is visible stat group
+	 *
+	 * @param InGroup	Stat group
+	 * @return Return TRUE if stat group is visible, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsGroupVisible( EStatGroup InGroup ) const
+	{
+		Assert( InGroup < SG_Num );
+		return bGroupVisible[InGroup];
+	}
+
+	/**
+	 * @brief Is visible any stat group
+	 * @return Return TRUE if at least one stat group is visible, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsAnyGroupVisible() const
+	{
+		for ( uint32 index = 0; index < SG_Num; ++index )
+		{
+			if ( bGroupVisible[index] )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Start dump stat counters to CSV file
+	 * @param InPath	Path to CSV file. If empty will be used default path in <GameDir>/Profiling
+	 * @return Return TRUE if file opened, otherwise returning FALSE
+	 */
+	bool StartCSV( const std::wstring& InPath = TEXT( "" ) );
+
+	/**
+	 * @brief Stop dump stat counters to CSV file
+	 */
+	void StopCSV();
+
+	/**
+	 * @brief Is dumping stat counters to CSV
+	 * @return Return TRUE if now stat counters is dumping to CSV, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsCSVActive() const
+	{
+		return csvArchive;
+	}
+
+	/**
+	 * @brief Print stat counters to log
+	 * @param InGroup	Stat group. If SG_Num will be printed all groups
+	 */
+	void DumpToLog( EStatGroup InGroup = SG_Num ) const;
+
+	/**
+	 * @brief Get average frame time
+	 * @return Return average frame time in seconds
+	 */
+	FORCEINLINE double GetAverageFrameTime() const
+	{
+		return averageFrameTime;
+	}
+
+	/**
+	 * @brief Get min frame time
+	 * @return Return min frame time over history in seconds
+	 */
+	FORCEINLINE double GetMinFrameTime() const
+	{
+		return minFrameTime;
+	}
+
+	/**
+	 * @brief Get max frame time
+	 * @return Return max frame time over history in seconds
+	 */
+	FORCEINLINE double GetMaxFrameTime() const
+	{
+		return maxFrameTime;
+	}
+
+	/**
+	 * @brief Get name of stat group
+	 *
+	 * @param InGroup	Stat group
+	 * @return Return name of stat group
+	 */
+	static const tchar* GetGroupName( EStatGroup InGroup );
+
+	/**
+	 * @brief Command of show stat groups and dump stats
+	 * @param InArguments	Arguments
+	 */
+	static void CmdStat( const std::vector<std::wstring>& InArguments );
+
+private:
+	/**
+	 * @brief Write row of stat counters to CSV
+	 * @param InDeltaSeconds	Delta time of frame
+	 */
+	void WriteCSVRow( double InDeltaSeconds );
+
+	bool					bGroupVisible[SG_Num];							/**< Visibility of stat groups */
+	double					frameTimes[CStatCounter::numHistoryFrames];		/**< History of frame times */
+	uint32					frameTimeIndex;									/**< Next index in history of frame times */
+	uint32					numFrameTimes;									/**< Number of valid frame times in history */
+	double					averageFrameTime;								/**< Average frame time */
+	double					minFrameTime;									/**< Min frame time */
+	double					maxFrameTime;									/**< Max frame time */
+	double					timeToLog;										/**< Time to next print visible stats to log (used when on screen display isn't available) */
+	uint64					frameNumber;									/**< Frame number */
+	class CArchive*			csvArchive;										/**< CSV archive */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Scene stat counters
+ */
+extern CStatCounter		g_StatScenePrimitives;
+extern CStatCounter		g_StatSceneVisiblePrimitives;
+extern CStatCounter		g_StatSceneCulledPrimitives;
+extern CStatCounter		g_StatSceneVisibleLights;
+extern CStatCounter		g_StatSceneCulledLights;
+extern CStatCounter		g_StatSceneDrawingPolicies;
+extern CStatCounter		g_StatSceneMeshBatches;
+extern CStatCounter		g_StatSceneBatchedInstances;
+extern CStatCounter		g_StatSceneStateChanges;
+extern CStatCounter		g_StatSceneSkippedStateChanges;
+extern CStatCounter		g_StatSceneTrianglesBeforeLOD;
+extern CStatCounter		g_StatSceneTrianglesAfterLOD;
+extern CStatCounter		g_StatSceneTileMapVisibleChunks;
+extern CStatCounter		g_StatSceneTileMapCulledChunks;
+extern CStatCounter		g_StatSceneTileMapRebuiltChunks;
+extern CStatCounter		g_StatSceneBatchedSprites;
+extern CStatCounter		g_StatSceneSpriteBatches;
+
+/**
+ * @ingroup Engine
+ * @brief RHI stat counters
+ */
+extern CStatCounter		g_StatRHIDrawCalls;
+extern CStatCounter		g_StatRHIPrimitives;
+extern CStatCounter		g_StatRHIUploadedBytes;
+extern CStatCounter		g_StatRHIRenderCommands;
+extern CStatCounter		g_StatRHIRenderCommandBytes;
+extern CStatCounter		g_StatRHIRenderCommandBufferSize;
+extern CStatCounter		g_StatRHIRenderCommandBufferHighWater;
+extern CStatCounter		g_StatRHIRenderCommandBufferStalls;
+extern CStatCounter		g_StatRHIRenderCommandBufferStallTime;
+extern CStatCounter		g_StatRHIUploadRingBytes;
+extern CStatCounter		g_StatRHIUploadRingWraps;
+extern CStatCounter		g_StatRHIUploadRingDiscards;
+
+/**
+ * @ingroup Engine
+ * @brief Memory stat counters
+ */
+extern CStatCounter		g_StatMemoryPhysical;
+extern CStatCounter		g_StatMemoryPeakPhysical;
+extern CStatCounter		g_StatMemoryVertexBuffers;
+extern CStatCounter		g_StatMemoryIndexBuffers;
+extern CStatCounter		g_StatMemoryTextures;
+
+/**
+ * @ingroup Engine
+ * @brief Streaming stat counters
+ */
+extern CStatCounter		g_StatStreamingTextures;
+extern CStatCounter		g_StatStreamingPoolBytes;
+extern CStatCounter		g_StatStreamingPoolBudget;
+extern CStatCounter		g_StatStreamingPendingRequests;
+extern CStatCounter		g_StatStreamingWantedMips;
+extern CStatCounter		g_StatStreamingResidentMips;
+extern CStatCounter		g_StatStreamingStreamedMips;
+extern CStatCounter		g_StatStreamingEvictedMips;
+
+/**
+ * @ingroup Engine
+ * @brief Physics stat counters
+ */
+extern CStatCounter		g_StatPhysicsSteps;
+extern CStatCounter		g_StatPhysicsDroppedSteps;
+extern CStatCounter		g_StatPhysicsSimulateTime;
+extern CStatCounter		g_StatPhysicsWaitTime;
+extern CStatCounter		g_StatPhysicsSyncTime;
+extern CStatCounter		g_StatPhysicsQueries;
+extern CStatCounter		g_StatPhysicsBodies;
+extern CStatCounter		g_StatPhysicsActiveBodies;
+extern CStatCounter		g_StatPhysicsBodySetups;
+extern CStatCounter		g_StatPhysicsAwakeBodies;
+extern CStatCounter		g_StatPhysicsContacts;
+extern CStatCounter		g_StatPhysicsCollideTime;
+extern CStatCounter		g_StatPhysicsSolveTime;
+extern CStatCounter		g_StatPhysicsCCDTime;
+extern CStatCounter		g_StatPhysicsBroadphaseTime;
+extern CStatCounter		g_StatPhysicsContactEvents;
+extern CStatCounter		g_StatPhysicsCoalescedContactEvents;
+extern CStatCounter		g_StatPhysicsDroppedContactEvents;
+
+#endif // !STATS_H
\ No newline at end of file
@@ -11,6 +11,7 @@
 
 #include "Core.h"
 #include "Misc/RefCounted.h"
+#include "Misc/Stats.h"
 #include "TypesRHI.h"
 
 /**
@@ -78,12 +79,17 @@ public:
 	CBaseVertexBufferRHI( uint32 InUsage, uint32 InSize ) :
 		usage( InUsage ),
 		size( InSize )
-	{}
+	{
+		g_StatMemoryVertexBuffers.Add( size );
+	}
 
 	/**
 	 * @brief Destructor
 	 */
-	virtual ~CBaseVertexBufferRHI() {}
+	virtual ~CBaseVertexBufferRHI()
+	{
+		g_StatMemoryVertexBuffers.Add( -( int64 )size );
+	}
 
 	/**
 	 * @brief Get usage flags
@@ -115,13 +121,21 @@ public:
 	 * @param[in] InStride Stride of struct
 	 * @param[in] InSize Size of buffer
 	 */
-	CBaseIndexBufferRHI( uint32 InUsage, uint32 InStride, uint32 InSize )
-	{}
+	CBaseIndexBufferRHI( uint32 InUsage, uint32 InStride, uint32 InSize ) :
+		usage( InUsage ),
+		stride( InStride ),
+		size( InSize )
+	{
+		g_StatMemoryIndexBuffers.Add( size );
+	}
 
 	/**
 	 * @brief Destructor
 	 */
-	virtual ~CBaseIndexBufferRHI() {}
+	virtual ~CBaseIndexBufferRHI()
+	{
+		g_StatMemoryIndexBuffers.Add( -( int64 )size );
+	}
 
 	/**
 	 * @brief Get usage flags
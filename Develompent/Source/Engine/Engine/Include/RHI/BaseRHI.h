@@ -615,6 +615,16 @@ public:
 	 */
 	virtual void CopyToResolveTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InSourceSurface, const ResolveParams& InResolveParams ) {}
 
+	/**
+	 * @brief Copy mips which both textures have in common
+	 * @note Textures must have same format. Mip chains are aligned by the smallest mip, so the last mip of source is copied to the last mip of destination
+	 *
+	 * @param InDeviceContext		Device context
+	 * @param InDestTexture			Destination texture
+	 * @param InSourceTexture		Source texture
+	 */
+	virtual void CopySharedMips( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InDestTexture, Texture2DRHIParamRef_t InSourceTexture ) {}
+
 	/**
 	 * @brief Draw primitive
 	 * 
@@ -48,6 +48,9 @@ enum EVertexElementType
 	VET_UByte4,			/**< Vector of 4 unsigned bytes */
 	VET_UByte4N,		/**< Vector of 4 unsigned bytes normalized */
 	VET_Color,			/**< Color type */
+	VET_Half2,			/**< Vector of 2 half floats */
+	VET_UShort4N,		/**< Vector of 4 unsigned shorts normalized */
+	VET_UInt1010102N,	/**< Vector of 3 10-bit and one 2-bit unsigned values normalized */
 	VET_Max
 };
 
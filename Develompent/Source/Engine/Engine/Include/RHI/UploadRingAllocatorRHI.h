@@ -0,0 +1,188 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef UPLOADRINGALLOCATORRHI_H
+#define UPLOADRINGALLOCATORRHI_H
+
+#include <deque>
+
+#include "Core.h"
+
+/**
+ * @ingroup Engine
+ * @brief Default size of upload ring for instance data and UP vertices (in MB)
+ */
+#define UPLOAD_RING_DEFAULT_SIZE_MB			4
+
+/**
+ * @ingroup Engine
+ * @brief Ratio of upload vertex ring size to upload index ring size
+ */
+#define UPLOAD_RING_INDEX_SIZE_RATIO		4
+
+/**
+ * @ingroup Engine
+ * @brief Alignment of instance data in upload ring
+ */
+#define UPLOAD_RING_INSTANCE_ALIGNMENT		16
+
+/**
+ * @ingroup Engine
+ * @brief Result of allocation from upload ring
+ */
+struct UploadRingAllocation
+{
+	uint32		offset;				/**< Offset of allocation from start of ring (in bytes) */
+	bool		bWrapped;			/**< Is allocation wrapped to start of ring */
+	bool		bNeedDiscard;		/**< Is need discard whole buffer (map with WRITE_DISCARD), otherwise buffer can be mapped without overwrite */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Linear ring allocator for per frame uploads (instance data, UP vertices and indices)
+ *
+ * Allocator doesn't own any memory, it only gives out offsets in a buffer of RHI, so it can be tested on CPU without any RHI.
+ * Memory of frame is recycled only after RHI retires it, when GPU has finished the frame (e.g. by signaled fence).
+ * If ring is too small for all frames in flight the allocation requests discard of buffer
+ */
+class CUploadRingAllocator
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InSize	Size of ring (in bytes)
+	 */
+	CUploadRingAllocator( uint32 InSize = 0 );
+
+	/**
+	 * @brief Initialize ring with new size
+	 * @note All previous allocations is forgotten, next allocation will request discard
+	 *
+	 * @param InSize	Size of ring (in bytes)
+	 */
+	void Init( uint32 InSize );
+
+	/**
+	 * @brief Allocate memory from ring
+	 *
+	 * @param InSize		Size of allocation (in bytes)
+	 * @param InAlignment	Alignment of allocation (in bytes). Can be not a power of two (e.g. vertex stride)
+	 * @param OutAllocation	Output allocation
+	 * @return Return TRUE if memory allocated, otherwise returning FALSE (allocation is larger then ring)
+	 */
+	bool Allocate( uint32 InSize, uint32 InAlignment, UploadRingAllocation& OutAllocation );
+
+	/**
+	 * @brief Is allocation of size possible
+	 * @note Used for reserve several rings before writing to any of them
+	 *
+	 * @param InSize	Size of allocation (in bytes)
+	 * @return Return TRUE if Allocate with this size will succeed, otherwise returning FALSE
+	 */
+	FORCEINLINE bool CanAllocate( uint32 InSize ) const
+	{
+		return InSize > 0 && InSize <= size;
+	}
+
+	/**
+	 * @brief End frame
+	 * Memory of frame stays in flight until it will be retired by RetireFrames
+	 *
+	 * @return Return index of ended frame, starting from 1
+	 */
+	uint64 EndFrame();
+
+	/**
+	 * @brief Retire ended frames
+	 * @note Call it when GPU has finished reading of frame, memory of it and all previous frames will be recycled
+	 *
+	 * @param InFrame	Index of the last frame finished by GPU (returned by EndFrame)
+	 */
+	void RetireFrames( uint64 InFrame );
+
+	/**
+	 * @brief Get size of upload ring for vertices from config (Engine.SystemSettings:UploadRingSizeMB)
+	 * @return Return size of upload ring for vertices (in bytes)
+	 */
+	static uint32 GetConfigVertexRingSize();
+
+	/**
+	 * @brief Get size of ring
+	 * @return Return size of ring (in bytes)
+	 */
+	FORCEINLINE uint32 GetSize() const
+	{
+		return size;
+	}
+
+	/**
+	 * @brief Get number of bytes which GPU may still read
+	 * @return Return number of bytes in flight, include current frame
+	 */
+	FORCEINLINE uint32 GetNumBytesInFlight() const
+	{
+		return numBytesInFlight;
+	}
+
+	/**
+	 * @brief Get number of frames in flight
+	 * @return Return number of ended frames which aren't retired yet
+	 */
+	FORCEINLINE uint32 GetNumFramesInFlight() const
+	{
+		return frameSizes.size();
+	}
+
+	/**
+	 * @brief Get number of allocated bytes in current frame
+	 * @return Return number of allocated bytes in current frame (without alignment padding)
+	 */
+	FORCEINLINE uint32 GetNumFrameAllocatedBytes() const
+	{
+		return numFrameAllocatedBytes;
+	}
+
+	/**
+	 * @brief Get number of wraps in current frame
+	 * @return Return number of wraps in current frame
+	 */
+	FORCEINLINE uint32 GetNumFrameWraps() const
+	{
+		return numFrameWraps;
+	}
+
+	/**
+	 * @brief Get number of discards in current frame
+	 * @return Return number of discards in current frame
+	 */
+	FORCEINLINE uint32 GetNumFrameDiscards() const
+	{
+		return numFrameDiscards;
+	}
+
+private:
+	/**
+	 * @brief Forget all frames in flight
+	 */
+	void ResetFrames();
+
+	uint32					size;						/**< Size of ring */
+	uint32					head;						/**< Offset of next free byte */
+	uint32					numBytesInFlight;			/**< Number of bytes which GPU may still read */
+	uint64					numEndedFrames;				/**< Number of ended frames, it is index of the last ended frame */
+	uint64					numRetiredFrames;			/**< Number of retired frames, it is index of the last retired frame */
+	std::deque< uint32 >	frameSizes;					/**< Sizes of ended frames in flight, from the oldest one */
+	uint32					currentFrameSize;			/**< Size of current frame, include alignment padding */
+	uint32					numFrameAllocatedBytes;		/**< Number of allocated bytes in current frame */
+	uint32					numFrameWraps;				/**< Number of wraps in current frame */
+	uint32					numFrameDiscards;			/**< Number of discards in current frame */
+	bool					bNeedDiscard;				/**< Is need discard on next allocation */
+};
+
+#endif // !UPLOADRINGALLOCATORRHI_H
\ No newline at end of file
@@ -35,6 +35,15 @@ public:
 		vertexShader	= g_ShaderManager->FindInstance<TDepthOnlyVertexShader<>>( vertexFactoryHash );
 		pixelShader		= g_ShaderManager->FindInstance<CDepthOnlyPixelShader>( vertexFactoryHash );
 	}
+
+	/**
+	 * @brief Is draw list with this drawing policy sorted front to back
+	 * @return Return TRUE, depth only pass gets more from early Z than from less state changes
+	 */
+	static FORCEINLINE bool IsFrontToBackSorted()
+	{
+		return true;
+	}
 };
 
 #endif // !DEPTHRENDERING_H
\ No newline at end of file
@@ -59,6 +59,17 @@ public:
 	 */
 	virtual void SetShaderParameters( class CBaseDeviceContextRHI* InDeviceContextRHI );
 
+	/**
+	 * Set render state and shader parameters, skipping the states that already set by previous drawing policy.
+	 * Child classes with custom SetRenderState or SetShaderParameters must override this method too
+	 *
+	 * @param[in] InDeviceContextRHI RHI device context
+	 * @param InPrevDrawingPolicy Drawing policy of the same type that was set before (NULL if nothing is set)
+	 * @param OutNumStateChanges Output number of applied state changes
+	 * @param OutNumSkippedStateChanges Output number of skipped state changes
+	 */
+	virtual void SetDrawingState( class CBaseDeviceContextRHI* InDeviceContextRHI, const CMeshDrawingPolicy* InPrevDrawingPolicy, uint32& OutNumStateChanges, uint32& OutNumSkippedStateChanges );
+
 	/**
 	 * @brief Get bound shader state
 	 * @return Return bound shader state of current drawing policy
@@ -86,6 +97,24 @@ public:
 	 */
 	virtual uint64 GetTypeHash() const;
 
+	/**
+	 * @brief Get sort key
+	 * Key groups drawing policies by state: shaders in high bits, then material and vertex factory.
+	 * Drawing policies with equal type hash always have equal sort key
+	 *
+	 * @return Return sort key of drawing policy
+	 */
+	uint64 GetSortKey() const;
+
+	/**
+	 * @brief Is draw list with this drawing policy sorted front to back
+	 * @return Return TRUE if draw list must sort drawing policies by depth before state
+	 */
+	static FORCEINLINE bool IsFrontToBackSorted()
+	{
+		return false;
+	}
+
 	/**
 	 * @brief Compare drawing policy
 	 * 
@@ -147,9 +147,15 @@ private:
 	 */
 	FORCEINLINE void NormalizePlanes()
 	{
+		// Divide by length of the plane normal (not of the whole 4D vector),
+		// otherwise distance from the plane is wrong and sphere tests will be incorrect
 		for ( uint32 side = 0; side < 6; ++side )
 		{
-			planes[ side ] = Math::NormalizeVector( planes[ side ] );
+			const float		normalLength = Math::LengthVector( Vector( planes[ side ].x, planes[ side ].y, planes[ side ].z ) );
+			if ( normalLength > SMALL_NUMBER )
+			{
+				planes[ side ] /= normalLength;
+			}
 		}
 	}
 
@@ -0,0 +1,178 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef LIGHTGRID_H
+#define LIGHTGRID_H
+
+#include <vector>
+#include <list>
+
+#include "Math/Math.h"
+#include "Components/LightComponent.h"
+
+/**
+ * @ingroup Engine
+ * @brief Cell of the light grid
+ */
+struct LightGridCell
+{
+	uint32		offset;		/**< Offset to first light index in CLightGrid::lightIndices */
+	uint32		numLights;	/**< Number lights in the cell */
+};
+
+/**
+ * @ingroup Engine
+ * @brief CPU clustered light grid
+ *
+ * View frustum is splitted on froxels (NumTilesX * NumTilesY screen tiles and NumSlicesZ depth slices with exponential distribution).
+ * For every froxel is built a list of lights that affects him. All lists are packed in one array of light indices,
+ * that is ready for upload in a buffer and consume by lighting path
+ */
+class CLightGrid
+{
+public:
+	/**
+	 * @brief Grid dimensions
+	 */
+	enum
+	{
+		NumTilesX	= 16,							/**< Number of tiles by X */
+		NumTilesY	= 9,							/**< Number of tiles by Y */
+		NumSlicesZ	= 24,							/**< Number of depth slices */
+		NumCells	= NumTilesX * NumTilesY * NumSlicesZ	/**< Total number of cells */
+	};
+
+	/**
+	 * @brief Constructor
+	 */
+	CLightGrid();
+
+	/**
+	 * @brief Build light grid for view
+	 *
+	 * @param InSceneView	Scene view
+	 * @param InLights		List of visible lights. Index of light in the list is used as light index in the grid
+	 */
+	void Build( const class CSceneView& InSceneView, const std::list<LightComponentRef_t>& InLights );
+
+	/**
+	 * @brief Clear light grid
+	 */
+	void Clear();
+
+	/**
+	 * @brief Get cell index
+	 *
+	 * @param InX	Tile index by X
+	 * @param InY	Tile index by Y
+	 * @param InZ	Depth slice index
+	 * @return Return index of cell in the grid
+	 */
+	static FORCEINLINE uint32 GetCellIndex( uint32 InX, uint32 InY, uint32 InZ )
+	{
+		return ( InZ * NumTilesY + InY ) * NumTilesX + InX;
+	}
+
+	/**
+	 * @brief Get depth slice by view space depth
+	 *
+	 * @param InViewDepth	View space depth (positive)
+	 * @return Return index of depth slice
+	 */
+	FORCEINLINE uint32 GetSliceByDepth( float InViewDepth ) const
+	{
+		if ( InViewDepth <= nearDepth )
+		{
+			return 0;
+		}
+
+		const int32		slice = ( int32 )Math::Floor( Math::Loge( InViewDepth ) * sliceScale + sliceBias );
+		return Clamp<int32>( slice, 0, NumSlicesZ - 1 );
+	}
+
+	/**
+	 * @brief Get cells of the grid
+	 * @return Return array of cells (size is NumCells or zero if grid is empty)
+	 */
+	FORCEINLINE const std::vector<LightGridCell>& GetCells() const
+	{
+		return cells;
+	}
+
+	/**
+	 * @brief Get packed light indices
+	 * @return Return array of light indices referenced by cells
+	 */
+	FORCEINLINE const std::vector<uint32>& GetLightIndices() const
+	{
+		return lightIndices;
+	}
+
+	/**
+	 * @brief Get near depth of the grid
+	 * @return Return view space depth of the first slice
+	 */
+	FORCEINLINE float GetNearDepth() const
+	{
+		return nearDepth;
+	}
+
+	/**
+	 * @brief Get far depth of the grid
+	 * @return Return view space depth of the last slice
+	 */
+	FORCEINLINE float GetFarDepth() const
+	{
+		return farDepth;
+	}
+
+	/**
+	 * @brief Get slice scale and bias for computing depth slice in shaders
+	 * slice = log( viewDepth ) * scale + bias
+	 *
+	 * @return Return slice scale (x) and bias (y)
+	 */
+	FORCEINLINE Vector2D GetSliceScaleBias() const
+	{
+		return Vector2D( sliceScale, sliceBias );
+	}
+
+	/**
+	 * @brief Is empty grid
+	 * @return Return TRUE if grid not contains lights
+	 */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return lightIndices.empty();
+	}
+
+private:
+	/**
+	 * @brief Range of cells covered by light
+	 */
+	struct LightCellRange
+	{
+		uint32		minX;		/**< Min tile by X */
+		uint32		maxX;		/**< Max tile by X */
+		uint32		minY;		/**< Min tile by Y */
+		uint32		maxY;		/**< Max tile by Y */
+		uint32		minZ;		/**< Min depth slice */
+		uint32		maxZ;		/**< Max depth slice */
+		uint32		lightIndex;	/**< Light index */
+	};
+
+	float							nearDepth;		/**< View space depth of the first slice */
+	float							farDepth;		/**< View space depth of the last slice */
+	float							sliceScale;		/**< Scale for compute depth slice */
+	float							sliceBias;		/**< Bias for compute depth slice */
+	std::vector<LightGridCell>		cells;			/**< Cells of the grid */
+	std::vector<uint32>				lightIndices;	/**< Packed light indices */
+	std::vector<LightCellRange>		lightRanges;	/**< Temporary array of light ranges, kept between frames for avoid reallocation */
+};
+
+#endif // !LIGHTGRID_H
\ No newline at end of file
@@ -293,6 +293,33 @@ public:
 	 */
 	bool GetVectorParameterValue( const CName& InParameterName, Vector4D& OutValue ) const;
 
+	/**
+	 * @brief Get scalar parameters
+	 * @return Return map of scalar parameters
+	 */
+	FORCEINLINE const std::unordered_map<CName, float, CName::HashFunction>& GetScalarParameters() const
+	{
+		return scalarParameters;
+	}
+
+	/**
+	 * @brief Get vector parameters
+	 * @return Return map of vector parameters
+	 */
+	FORCEINLINE const std::unordered_map<CName, Vector4D, CName::HashFunction>& GetVectorParameters() const
+	{
+		return vectorParameters;
+	}
+
+	/**
+	 * @brief Get texture parameters
+	 * @return Return map of texture parameters
+	 */
+	FORCEINLINE const std::unordered_map<CName, TAssetHandle<CTexture2D>, CName::HashFunction>& GetTextureParameters() const
+	{
+		return textureParameters;
+	}
+
 	/**
 	 * @brief Get dependent assets
 	 * 
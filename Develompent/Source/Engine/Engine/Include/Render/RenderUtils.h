@@ -49,6 +49,18 @@ extern PixelFormatInfo			g_PixelFormats[ PF_Max ];
  */
 extern float					g_PixelCenterOffset;
 
+/**
+ * @ingroup Engine
+ * @brief Calculate size of texture in bytes
+ *
+ * @param InSizeX		Width of texture
+ * @param InSizeY		Height of texture
+ * @param InFormat		Pixel format
+ * @param InNumMips		Number of mips
+ * @return Return size of texture with all mips in bytes
+ */
+uint64 CalcTextureSize( uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, uint32 InNumMips );
+
 /**
  * @ingroup Engine
  * Handles initialization/release for a global resource
@@ -12,19 +12,24 @@
 #include <vector>
 #include <set>
 #include <list>
+#include <algorithm>
+#include <float.h>
 
 #include "Math/Math.h"
 #include "Math/Color.h"
+#include "Math/Rect.h"
 #include "Render/CameraTypes.h"
 #include "Render/Material.h"
 #include "Render/SceneRendering.h"
 #include "Render/SceneHitProxyRendering.h"
 #include "Render/DepthRendering.h"
 #include "Render/Frustum.h"
+#include "Render/LightGrid.h"
 #include "Render/HitProxies.h"
 #include "Render/BatchedSimpleElements.h"
 #include "Render/RenderingThread.h"
 #include "Render/DynamicMeshBuilder.h"
+#include "Render/SpriteBatchMesh.h"
 #include "Components/CameraComponent.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/LightComponent.h"
@@ -190,6 +195,15 @@ public:
 		return position;
 	}
 
+	/**
+	 * @brief Get screen size of sphere
+	 * 
+	 * @param InOrigin		Origin of sphere in world space
+	 * @param InRadius		Radius of sphere
+	 * @return Return diameter of projected sphere relative to screen height (1.0 is full screen)
+	 */
+	float GetScreenSize( const Vector& InOrigin, float InRadius ) const;
+
 private:
 	Matrix			viewMatrix;							/**< View matrix */
 	Matrix			projectionMatrix;					/**< Projection matrix */
@@ -310,9 +324,48 @@ struct MeshBatch
  */
 typedef std::unordered_set< MeshBatch, MeshBatch::MeshBatchKeyFunc >		MeshBatchList_t;
 
+/**
+ * @ingroup Engine
+ * @brief Statistics of mesh draw lists in the view
+ */
+struct MeshDrawListStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	MeshDrawListStats()
+		: numDrawingPolicies( 0 )
+		, numMeshBatches( 0 )
+		, numStateChanges( 0 )
+		, numSkippedStateChanges( 0 )
+	{}
+
+	/**
+	 * @brief Reset stats
+	 */
+	FORCEINLINE void Reset()
+	{
+		numDrawingPolicies		= 0;
+		numMeshBatches			= 0;
+		numStateChanges			= 0;
+		numSkippedStateChanges	= 0;
+	}
+
+	uint32		numDrawingPolicies;			/**< Number of drawing policies with visible instances */
+	uint32		numMeshBatches;				/**< Number of drawn mesh batches */
+	uint32		numStateChanges;			/**< Number of applied state changes (vertex streams, rasterizer, shaders, shader parameters) */
+	uint32		numSkippedStateChanges;		/**< Number of state changes skipped because previous drawing policy already set them */
+};
+
 /**
  * @ingroup Engine
  * @brief Draw list of scene for mesh type
+ * 
+ * Drawing policy links are stored in array sorted by 64 bit sort key (see CMeshDrawingPolicy::GetSortKey),
+ * so neighbouring links share shaders and materials and Draw can skip redundant state changes. Every SDG has
+ * own draw list for each pass, thereby a pass is not part of the key.
+ * Links are inserted and removed incrementally with binary search, without resort of whole list.
+ * If TDrawingPolicyType::IsFrontToBackSorted() returns TRUE, visible links additionally sorted every frame by depth bucket
  */
 template< typename TDrawingPolicyType, bool InAllowWireframe = true >
 class CMeshDrawList
@@ -329,8 +382,9 @@ public:
 		 * @param InWireframeColor		Wireframe color
 		 */
 		DrawingPolicyLink( const CColor& InWireframeColor = CColor::red )
+			: sortKey( 0 )
 #if WITH_EDITOR
-			: wireframeColor( InWireframeColor )
+			, wireframeColor( InWireframeColor )
 #endif // WITH_EDITOR
 		{}
 
@@ -342,6 +396,7 @@ public:
 		 */
 		DrawingPolicyLink( const TDrawingPolicyType& InDrawingPolicy, const CColor& InWireframeColor = CColor::red )
 			: drawingPolicy( InDrawingPolicy )
+			, sortKey( 0 )
 #if WITH_EDITOR
 			, wireframeColor( InWireframeColor )
 #endif // WITH_EDITOR
@@ -374,6 +429,7 @@ public:
 
 		mutable MeshBatchList_t					meshBatchList;			/**< Mesh batch list */
 		mutable TDrawingPolicyType				drawingPolicy;			/**< Drawing policy */
+		uint64									sortKey;				/**< Sort key of drawing policy, calculated when link added to draw list */
 
 #if WITH_EDITOR
 		CColor									wireframeColor;			/**< Wireframe color */
@@ -386,56 +442,27 @@ public:
 	typedef TRefCountPtr< DrawingPolicyLink >		DrawingPolicyLinkRef_t;
 
 	/**
-	 * @brief Functions to extract the drawing policy from DrawingPolicyLink_t as a key for std::set
+	 * @brief Functions for compare drawing policy links in sorted array
 	 */
-	struct DrawingPolicyKeyFunc
+	struct DrawingPolicyLessFunc
 	{
 		/**
-		 * @brief Compare DrawingPolicyLink_t
+		 * @brief Compare DrawingPolicyLinkRef_t
 		 * 
 		 * @param InA First drawing policy
 		 * @param InB Second drawing policy
-		 * @return Return true if InA and InB equal, else returning false
+		 * @return Return true if InA less InB, else returning false
 		 */
 		FORCEINLINE bool operator()( const DrawingPolicyLinkRef_t& InA, const DrawingPolicyLinkRef_t& InB ) const
 		{
-			return InA->GetTypeHash() < InB->GetTypeHash();
-		}
-
-		/**
-		 * @brief Calculate hash of the DrawingPolicyLink_t
-		 *
-		 * @param InDrawingPolicyLink Drawing policy link
-		 * @return Return hash of this DrawingPolicyLink_t
-		 */
-		FORCEINLINE std::size_t operator()( const DrawingPolicyLinkRef_t& InDrawingPolicyLink ) const
-		{
-			return InDrawingPolicyLink->GetTypeHash();
+			return InA->sortKey < InB->sortKey || ( InA->sortKey == InB->sortKey && InA->GetTypeHash() < InB->GetTypeHash() );
 		}
 	};
 
 	/**
-	 * @brief Functions for custom equal the drawing policy in std::set 
+	 * @brief Typedef array of draw data
 	 */
-	struct DrawingPolicyEqualFunc
-	{
-		/**
-		  * @brief Compare DrawingPolicyLinkRef_t
-		  *
-		  * @param InA First drawing policy
-		  * @param InB Second drawing policy
-		  * @return Return true if InA and InB equal, else returning false
-		  */
-		FORCEINLINE bool operator()( const DrawingPolicyLinkRef_t& InA, const DrawingPolicyLinkRef_t& InB ) const
-		{
-			return ( *InA ) == ( *InB );
-		}
-	};
-
-	/**
-	 * @brief Typedef map of draw data
-	 */
-	typedef std::unordered_set< DrawingPolicyLinkRef_t, DrawingPolicyKeyFunc, DrawingPolicyEqualFunc >		MapDrawData_t;
+	typedef std::vector< DrawingPolicyLinkRef_t >		MapDrawData_t;
 
 	/**
 	 * @brief Add item
@@ -446,14 +473,15 @@ public:
 	DrawingPolicyLinkRef_t AddItem( const DrawingPolicyLinkRef_t& InDrawingPolicyLink )
 	{
 		Assert( InDrawingPolicyLink );
+		InDrawingPolicyLink->sortKey = InDrawingPolicyLink->drawingPolicy.GetSortKey();
 
-		// Get drawing policy link in std::set
-		MapDrawData_t::iterator		it = meshes.find( InDrawingPolicyLink );
+		// Find drawing policy link in sorted array
+		typename MapDrawData_t::iterator		it = std::lower_bound( meshes.begin(), meshes.end(), InDrawingPolicyLink, DrawingPolicyLessFunc() );
 
 		// If drawing policy link is not exist - we insert
-		if ( it == meshes.end() )
+		if ( it == meshes.end() || **it != *InDrawingPolicyLink )
 		{
-			it = meshes.insert( InDrawingPolicyLink ).first;
+			it = meshes.insert( it, InDrawingPolicyLink );
 		}
 
 		// Return drawing policy link in SDG
@@ -470,7 +498,11 @@ public:
 		Assert( InDrawingPolicyLink );
 		if ( InDrawingPolicyLink->GetRefCount() <= 2 )
 		{
-			meshes.erase( InDrawingPolicyLink );
+			typename MapDrawData_t::iterator		it = std::lower_bound( meshes.begin(), meshes.end(), InDrawingPolicyLink, DrawingPolicyLessFunc() );
+			if ( it != meshes.end() && *it == InDrawingPolicyLink )
+			{
+				meshes.erase( it );
+			}
 		}
 
 		InDrawingPolicyLink = nullptr;
@@ -483,7 +515,7 @@ public:
 	{
 		for ( MapDrawData_t::const_iterator it = meshes.begin(), itEnd = meshes.end(); it != itEnd; ++it )
 		{
-			DrawingPolicyLinkRef_t		drawingPolicyLink = *it;
+			const DrawingPolicyLinkRef_t&		drawingPolicyLink = *it;
 			for ( MeshBatchList_t::const_iterator itMeshBatch = drawingPolicyLink->meshBatchList.begin(), itMeshBatchEnd = drawingPolicyLink->meshBatchList.end(); itMeshBatch != itMeshBatchEnd; ++itMeshBatch )
 			{
 				itMeshBatch->numInstances = 0;
@@ -506,8 +538,9 @@ public:
 	 * 
 	 * @param[in] InDeviceContext Device context
 	 * @param InSceneView Current view of scene
+	 * @param OutStats Output stats of draw list (may be NULL)
 	 */
-	FORCEINLINE void Draw( class CBaseDeviceContextRHI* InDeviceContext, const CSceneView& InSceneView )
+	void Draw( class CBaseDeviceContextRHI* InDeviceContext, const CSceneView& InSceneView, MeshDrawListStats* OutStats = nullptr )
 	{
 		Assert( IsInRenderingThread() );
 
@@ -517,19 +550,49 @@ public:
 		bool													bWireframe = InAllowWireframe && ( InSceneView.GetShowFlags() & SHOW_Wireframe );
 #endif // WITH_EDITOR
 
-		for ( MapDrawData_t::const_iterator it = meshes.begin(), itEnd = meshes.end(); it != itEnd; ++it )
+		// Collect links in draw order. Persistent array already sorted by state, for front to back lists we resort visible links by depth bucket
+		bool		bFrontToBack = TDrawingPolicyType::IsFrontToBackSorted();
+		drawOrder.clear();
+		for ( typename MapDrawData_t::const_iterator it = meshes.begin(), itEnd = meshes.end(); it != itEnd; ++it )
+		{
+			DrawingPolicyLink*		drawingPolicyLink = it->GetPtr();
+			float					minDistance = 0.f;
+			if ( !GetLinkMinDistance( drawingPolicyLink, InSceneView.GetPosition(), minDistance ) )
+			{
+				continue;
+			}
+
+			uint64		drawKey = drawingPolicyLink->sortKey;
+			if ( bFrontToBack )
+			{
+				drawKey = ( ( uint64 )GetDepthBucket( minDistance ) << 56 ) | ( drawKey >> 8 );
+			}
+			drawOrder.push_back( DrawOrderItem{ drawKey, drawingPolicyLink } );
+		}
+
+		if ( bFrontToBack )
+		{
+			std::stable_sort( drawOrder.begin(), drawOrder.end(), []( const DrawOrderItem& InA, const DrawOrderItem& InB ) { return InA.drawKey < InB.drawKey; } );
+		}
+
+		const CMeshDrawingPolicy*		prevDrawingPolicy			= nullptr;
+		uint32							numStateChanges				= 0;
+		uint32							numSkippedStateChanges		= 0;
+		uint32							numMeshBatches				= 0;
+		for ( uint32 index = 0, count = drawOrder.size(); index < count; ++index )
 		{
-			bool						bIsInitedRenderState	= false;
-			DrawingPolicyLinkRef_t		drawingPolicyLink		= *it;
+			DrawingPolicyLink*			drawingPolicyLink		= drawOrder[index].drawingPolicyLink;
 			CMeshDrawingPolicy*			drawingPolicy			= nullptr;
 
 #if WITH_EDITOR
 			drawingPolicy				= !bWireframe ? &drawingPolicyLink->drawingPolicy : &wireframeDrawingPolicy;
 
-			// If we use wireframe drawing policy - init him
+			// If we use wireframe drawing policy - init him. Wireframe policy is shared between links and changes
+			// material parameters in Init, so we can't skip state changes for him
 			if ( bWireframe )
 			{
 				wireframeDrawingPolicy.Init( drawingPolicyLink->drawingPolicy.GetVertexFactory(), drawingPolicyLink->wireframeColor, drawingPolicyLink->drawingPolicy.GetDepthBias() );
+				prevDrawingPolicy = nullptr;
 			}
 #else
 			drawingPolicy				= &drawingPolicyLink->drawingPolicy;
@@ -541,6 +604,10 @@ public:
 				continue;
 			}
 
+			// Set render state, only changed states are applied
+			drawingPolicy->SetDrawingState( InDeviceContext, prevDrawingPolicy, numStateChanges, numSkippedStateChanges );
+			prevDrawingPolicy = drawingPolicy;
+
 			// Draw all mesh batches
 			for ( MeshBatchList_t::const_iterator itMeshBatch = drawingPolicyLink->meshBatchList.begin(), itMeshBatchEnd = drawingPolicyLink->meshBatchList.end(); itMeshBatch != itMeshBatchEnd; ++itMeshBatch )
 			{
@@ -550,22 +617,81 @@ public:
 					continue;
 				}
 
-				// If we not initialized render state - do it!
-				if ( !bIsInitedRenderState )
-				{					
-					drawingPolicy->SetRenderState( InDeviceContext );
-					drawingPolicy->SetShaderParameters( InDeviceContext );
-					bIsInitedRenderState = true;
-				}
-
 				// Draw mesh batch
 				drawingPolicy->Draw( InDeviceContext, *itMeshBatch, InSceneView );
+				++numMeshBatches;
 			}
 		}
+
+		// Update stats
+		if ( OutStats )
+		{
+			OutStats->numDrawingPolicies		+= drawOrder.size();
+			OutStats->numMeshBatches			+= numMeshBatches;
+			OutStats->numStateChanges			+= numStateChanges;
+			OutStats->numSkippedStateChanges	+= numSkippedStateChanges;
+		}
 	}
 
 private:
-	MapDrawData_t		meshes;						/**< Map of meshes sorted by materials for draw */
+	/**
+	 * @brief Item of draw order
+	 */
+	struct DrawOrderItem
+	{
+		uint64					drawKey;				/**< Key of draw order */
+		DrawingPolicyLink*		drawingPolicyLink;		/**< Drawing policy link */
+	};
+
+	/**
+	 * @brief Get min distance from view to instances of drawing policy link
+	 * 
+	 * @param InDrawingPolicyLink	Drawing policy link
+	 * @param InViewPosition		View position
+	 * @param OutMinDistance		Output min distance (calculates only for front to back lists)
+	 * @return Return FALSE if link hasn't instances for draw, otherwise return TRUE
+	 */
+	static FORCEINLINE bool GetLinkMinDistance( const DrawingPolicyLink* InDrawingPolicyLink, const Vector& InViewPosition, float& OutMinDistance )
+	{
+		bool		bHasInstances		= false;
+		float		minDistanceSquared	= FLT_MAX;
+		for ( MeshBatchList_t::const_iterator itMeshBatch = InDrawingPolicyLink->meshBatchList.begin(), itMeshBatchEnd = InDrawingPolicyLink->meshBatchList.end(); itMeshBatch != itMeshBatchEnd; ++itMeshBatch )
+		{
+			if ( itMeshBatch->numInstances <= 0 )
+			{
+				continue;
+			}
+
+			bHasInstances = true;
+			if ( !TDrawingPolicyType::IsFrontToBackSorted() )
+			{
+				break;
+			}
+
+			for ( uint32 index = 0, count = itMeshBatch->instances.size(); index < count; ++index )
+			{
+				const Vector		delta = Vector( itMeshBatch->instances[index].transformMatrix[3] ) - InViewPosition;
+				minDistanceSquared	= Min( minDistanceSquared, Math::DotProduct( delta, delta ) );
+			}
+		}
+
+		OutMinDistance = bHasInstances && minDistanceSquared != FLT_MAX ? Math::Sqrt( minDistanceSquared ) : 0.f;
+		return bHasInstances;
+	}
+
+	/**
+	 * @brief Get depth bucket by distance
+	 * 
+	 * @param InDistance	Distance from view
+	 * @return Return depth bucket with logarithmic distribution (8 buckets on every doubling of distance)
+	 */
+	static FORCEINLINE uint32 GetDepthBucket( float InDistance )
+	{
+		return ( uint32 )Clamp<float>( Math::Log2( 1.f + InDistance ) * 8.f, 0.f, 255.f );
+	}
+
+	MapDrawData_t					meshes;			/**< Array of meshes sorted by sort key of drawing policy */
+	std::vector<DrawOrderItem>		drawOrder;		/**< Temporary array of draw order, kept between frames for avoid reallocation */
 };
 
 /**
@@ -661,6 +787,113 @@ struct HitProxyLayer
 };
 #endif // ENABLE_HITPROXY
 
+/**
+ * @ingroup Engine
+ * @brief Sprite submitted to sprite batcher
+ */
+struct SpriteBatchElement
+{
+	TAssetHandle<CMaterial>		material;			/**< Material */
+	Matrix						transformMatrix;	/**< Transform matrix of sprite */
+	RectFloat_t					textureRect;		/**< Texture rect */
+	Vector2D					spriteSize;			/**< Sprite size */
+	CColor						color;				/**< Sprite color */
+	bool						bFlipVertical;		/**< Is need flip sprite by vertical */
+	bool						bFlipHorizontal;	/**< Is need flip sprite by horizontal */
+
+#if WITH_EDITOR
+	bool						bSelected;			/**< Is selected sprite */
+#endif // WITH_EDITOR
+};
+
+/**
+ * @ingroup Engine
+ * @brief Batcher of 2D sprites
+ *
+ * Visible sprites are collected while view is building, then they are sorted by material and layer (Z of sprite location)
+ * and baked to transient vertex buffer in world space. Each run of sprites with one material is drawn by one mesh batch,
+ * so changing of texture rect (e.g. flipbook animation) or transform of sprite is only updating its verteces
+ */
+class CSpriteBatcher
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CSpriteBatcher();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CSpriteBatcher();
+
+	/**
+	 * @brief Is sprite batching enabled
+	 * @return Return TRUE if sprites must be drawn through sprite batcher
+	 */
+	static bool IsEnabled();
+
+	/**
+	 * @brief Add sprite to batch
+	 * @note Must be called only from rendering thread while view is building
+	 *
+	 * @param InElement		Sprite
+	 */
+	FORCEINLINE void AddSprite( const SpriteBatchElement& InElement )
+	{
+		elements.push_back( InElement );
+	}
+
+	/**
+	 * @brief Build verteces of collected sprites and add mesh batches to draw lists of SDG
+	 * @param InSDG		Scene depth group
+	 */
+	void Build( struct SceneDepthGroup& InSDG );
+
+	/**
+	 * @brief Remove mesh batches from draw lists of SDG and clear collected sprites
+	 * @param InSDG		Scene depth group
+	 */
+	void Clear( struct SceneDepthGroup& InSDG );
+
+private:
+	/**
+	 * @brief Typedef of reference on drawing policy link in scene
+	 */
+	typedef CMeshDrawList<CMeshDrawingPolicy>::DrawingPolicyLinkRef_t			DrawingPolicyLinkRef_t;
+
+	/**
+	 * @brief Typedef of reference on depth drawing policy link in scene
+	 */
+	typedef CMeshDrawList<CDepthDrawingPolicy>::DrawingPolicyLinkRef_t			DepthDrawingPolicyLinkRef_t;
+
+	/**
+	 * @brief Is sprites in one run
+	 *
+	 * @param InA	Sprite A
+	 * @param InB	Sprite B
+	 * @return Return TRUE if sprites can be drawn by one mesh batch
+	 */
+	static bool IsSameRun( const SpriteBatchElement& InA, const SpriteBatchElement& InB );
+
+	/**
+	 * @brief Add run of sprites to draw lists of SDG
+	 *
+	 * @param InSDG				Scene depth group
+	 * @param InElement			First sprite in run
+	 * @param InFirstSprite		Index of first sprite in vertex buffer
+	 * @param InNumSprites		Number of sprites in run
+	 */
+	void AddRun( struct SceneDepthGroup& InSDG, const SpriteBatchElement& InElement, uint32 InFirstSprite, uint32 InNumSprites );
+
+	std::vector<SpriteBatchElement>				elements;					/**< Collected sprites */
+	std::vector<uint32>							sortedElements;				/**< Indeces of collected sprites in draw order */
+	std::vector<SpriteBatchVertexType>			verteces;					/**< Verteces of sprites in draw order */
+	SpriteBatchMeshRef_t						mesh;						/**< Mesh with verteces of sprites */
+	std::vector<DrawingPolicyLinkRef_t>			drawingPolicyLinks;			/**< References to drawing policy links of runs */
+	std::vector<DepthDrawingPolicyLinkRef_t>	depthDrawingPolicyLinks;	/**< References to depth drawing policy links of runs */
+};
+
 /**
  * @ingroup Engine
  * @brief Enumeration of scene depth group
@@ -711,6 +944,8 @@ struct SceneDepthGroup
 	 */
 	FORCEINLINE void Clear()
 	{
+		spriteBatcher.Clear( *this );
+
 #if WITH_EDITOR
 		simpleElements.Clear();
 		dynamicMeshBuilders.clear();
@@ -766,12 +1001,43 @@ struct SceneDepthGroup
 	CMeshDrawList<CMeshDrawingPolicy>						staticMeshDrawList;			/**< Draw list of static meshes */
 	CMeshDrawList<CMeshDrawingPolicy>						spriteDrawList;				/**< Draw list of sprites */
 	CMeshDrawList<CDepthDrawingPolicy>						depthDrawList;				/**< Draw list all of geometry for PrePass */
+	CSpriteBatcher											spriteBatcher;				/**< Batcher of sprites, it adds own mesh batches to spriteDrawList and depthDrawList */
 
 #if ENABLE_HITPROXY
 	HitProxyLayer											hitProxyLayers[ HPL_Num ];	/**< Hit proxy layers */
 #endif // ENABLE_HITPROXY
 };
 
+/**
+ * @ingroup Engine
+ * @brief Statistics of lights in the view
+ */
+struct SceneLightStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	SceneLightStats()
+		: numConsidered( 0 )
+		, numCulled( 0 )
+		, numDrawn( 0 )
+	{}
+
+	/**
+	 * @brief Reset stats
+	 */
+	FORCEINLINE void Reset()
+	{
+		numConsidered	= 0;
+		numCulled		= 0;
+		numDrawn		= 0;
+	}
+
+	uint32		numConsidered;		/**< Number of enabled lights considered for the view */
+	uint32		numCulled;			/**< Number of lights culled by view frustum */
+	uint32		numDrawn;			/**< Number of lights drawn in light pass */
+};
+
 /**
  * @ingroup Engine
  * @brief Base implementation of the scene manager
@@ -937,6 +1203,51 @@ public:
 		return frame.visibleLights;
 	}
 
+	/**
+	 * @brief Get clustered light grid of the current frame
+	 * @note Grid is built on the first call after BuildView, so it costs nothing while no pass uses it. If r.light_grid is disabled grid is empty
+	 *
+	 * @param InSceneView	Scene view, must be the same as in BuildView
+	 * @return Return light grid built for visible lights
+	 */
+	const CLightGrid& GetLightGrid( const CSceneView& InSceneView );
+
+	/**
+	 * @brief Get statistics of lights in the last built view
+	 * @return Return light stats
+	 */
+	FORCEINLINE SceneLightStats& GetLightStats()
+	{
+		return lightStats;
+	}
+
+	/**
+	 * @brief Get statistics of lights in the last built view
+	 * @return Return light stats
+	 */
+	FORCEINLINE const SceneLightStats& GetLightStats() const
+	{
+		return lightStats;
+	}
+
+	/**
+	 * @brief Get statistics of mesh draw lists in the last drawn view
+	 * @return Return draw list stats
+	 */
+	FORCEINLINE MeshDrawListStats& GetDrawListStats()
+	{
+		return drawListStats;
+	}
+
+	/**
+	 * @brief Get statistics of mesh draw lists in the last drawn view
+	 * @return Return draw list stats
+	 */
+	FORCEINLINE const MeshDrawListStats& GetDrawListStats() const
+	{
+		return drawListStats;
+	}
+
 	/**
 	 * @brief Set current exposure of the scene
 	 * @paran InExposure		New exposure
@@ -955,11 +1266,22 @@ private:
 	 */
 	struct SceneFrame
 	{
+		/**
+		 * @brief Constructor
+		 */
+		SceneFrame()
+			: bNeedBuildLightGrid( false )
+		{}
+
 		SceneDepthGroup						SDGs[SDG_Max];		/**< Scene depth groups */
 		std::list<LightComponentRef_t>		visibleLights;		/**< List of visible lights */
+		CLightGrid							lightGrid;			/**< Clustered light grid of visible lights */
+		bool								bNeedBuildLightGrid;	/**< Is need build light grid on first request, set in BuildView */
 	};
 	
 	float									exposure;			/**< Current exposure of the scene */
+	SceneLightStats							lightStats;			/**< Light stats of the last built view */
+	MeshDrawListStats						drawListStats;		/**< Draw list stats of the last drawn view */
 	SceneFrame								frame;				/**< Scene frame */
 	std::list<PrimitiveComponentRef_t>		primitives;			/**< List of primitives on scene */
 	std::list<LightComponentRef_t>			lights;				/**< List of lights on scene */
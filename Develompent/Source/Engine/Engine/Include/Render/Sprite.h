@@ -183,6 +183,15 @@ public:
 		vertexFactory->SetSpriteSize( InSpriteSize );
 	}
 
+	/**
+	 * @brief Set sprite color
+	 * @param InSpriteColor Sprite color
+	 */
+	FORCEINLINE void SetSpriteColor( const CColor& InSpriteColor )
+	{
+		vertexFactory->SetSpriteColor( InSpriteColor );
+	}
+
 	/**
 	 * @brief Set flip by vertical
 	 * @param InFlipVertical Is need flip sprite by vertical
@@ -210,6 +219,15 @@ public:
 		return vertexFactory->GetSpriteSize();
 	}
 
+	/**
+	 * @brief Get sprite color
+	 * @return Return sprite color
+	 */
+	FORCEINLINE const CColor& GetSpriteColor() const
+	{
+		return vertexFactory->GetSpriteColor();
+	}
+
 	/**
 	 * @brief Is fliped by vertical
 	 * @return Return TRUE if sprite fliped by vertical
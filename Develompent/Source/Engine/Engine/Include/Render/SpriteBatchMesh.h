@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef SPRITEBATCHMESH_H
+#define SPRITEBATCHMESH_H
+
+#include <vector>
+
+#include "RenderResource.h"
+#include "Misc/RefCounted.h"
+#include "Render/VertexFactory/SpriteBatchVertexFactory.h"
+#include "RHI/BaseBufferRHI.h"
+#include "RHI/TypesRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Minimal number of sprites in sprite batch mesh
+ */
+#define SPRITEBATCH_MIN_SPRITES		256
+
+/**
+ * @ingroup Engine
+ * @brief Reference to CSpriteBatchMesh
+ */
+typedef TRefCountPtr< class CSpriteBatchMesh >			SpriteBatchMeshRef_t;
+
+/**
+ * @ingroup Engine
+ * @brief Transient mesh of batched sprites
+ *
+ * Every sprite is a quad of 4 verteces, so index buffer is static and only vertex buffer
+ * is rewritten each frame. Buffers grow by power of two and never shrink
+ */
+class CSpriteBatchMesh : public CRenderResource, public CRefCounted
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CSpriteBatchMesh();
+
+	/**
+	 * @brief Upload verteces of sprites to GPU
+	 * @note Must be called only from rendering thread
+	 *
+	 * @param InVerteces	Verteces, 4 per sprite
+	 */
+	void Update( const std::vector<SpriteBatchVertexType>& InVerteces );
+
+	/**
+	 * @brief Release RHI resources of mesh on rendering thread
+	 * @note Mesh is kept alive until rendering thread releases it
+	 */
+	void BeginRelease();
+
+	/**
+	 * @brief Get vertex factory
+	 * @return Return vertex factory
+	 */
+	FORCEINLINE TRefCountPtr<CSpriteBatchVertexFactory> GetVertexFactory() const
+	{
+		return vertexFactory;
+	}
+
+	/**
+	 * @brief Get RHI index buffer
+	 * @return Return RHI index buffer, if not created return nullptr
+	 */
+	FORCEINLINE IndexBufferRHIRef_t GetIndexBufferRHI() const
+	{
+		return indexBufferRHI;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	uint32									maxSprites;			/**< Max number of sprites in buffers */
+	TRefCountPtr<CSpriteBatchVertexFactory>	vertexFactory;		/**< Vertex factory */
+	VertexBufferRHIRef_t					vertexBufferRHI;	/**< Vertex buffer RHI */
+	IndexBufferRHIRef_t						indexBufferRHI;		/**< Index buffer RHI */
+};
+
+#endif // !SPRITEBATCHMESH_H
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "RenderResource.h"
 #include "Containers/BulkData.h"
 #include "Misc/SharedPointer.h"
+#include "Misc/EnumAsByte.h"
 #include "System/Package.h"
 #include "Render/Material.h"
 #include "Render/VertexFactory/StaticMeshVertexFactory.h"
@@ -23,6 +24,12 @@
 #include "RHI/BaseBufferRHI.h"
 #include "RHI/TypesRHI.h"
 
+/**
+ * @ingroup Engine
+ * @brief Max number of verteces in static mesh for which 16-bit index buffer is used
+ */
+#define STATICMESH_MAX_VERTECES_16BIT		0xFFFF
+
 /**
  * @ingroup Engine
  * Surface in static mesh
@@ -35,6 +42,67 @@ struct StaticMeshSurface
 	uint32			numPrimitives;			/**< Number primitives in the surface */
 };
 
+/**
+ * @ingroup Engine
+ * @brief Max number of LODs in static mesh
+ */
+#define STATICMESH_MAX_LODS					8
+
+/**
+ * @ingroup Engine
+ * @brief Default number of LODs generated at import of static mesh
+ */
+#define STATICMESH_DEFAULT_NUM_LODS			4
+
+/**
+ * @ingroup Engine
+ * @brief Hysteresis of switching LODs. LOD is switched when screen size is crossed threshold more then this fraction of it
+ */
+#define STATICMESH_LOD_HYSTERESIS			0.1f
+
+/**
+ * @ingroup Engine
+ * Level of detail in static mesh
+ */
+struct StaticMeshLOD
+{
+	/**
+	 * @brief Constructor
+	 */
+	StaticMeshLOD()
+		: screenSize( 1.f )
+	{}
+
+	/**
+	 * @brief Get number of primitives in LOD
+	 * @return Return number of primitives in all surfaces of LOD
+	 */
+	FORCEINLINE uint32 GetNumPrimitives() const
+	{
+		uint32		numPrimitives = 0;
+		for ( uint32 index = 0, count = surfaces.size(); index < count; ++index )
+		{
+			numPrimitives += surfaces[index].numPrimitives;
+		}
+		return numPrimitives;
+	}
+
+	float								screenSize;		/**< Max screen size of mesh (diameter of bounding sphere relative to screen height) for using this LOD */
+	std::vector<StaticMeshSurface>		surfaces;		/**< Array surfaces in LOD, all LODs share one vertex and index buffer */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Get stride of index buffer for static mesh
+ * 
+ * @param InNumVerteces		Number of verteces in static mesh
+ * @return Return sizeof( uint16 ) if all verteces can be addressed by 16-bit indeces, otherwise return sizeof( uint32 )
+ */
+FORCEINLINE uint32 GetStaticMeshIndexStride( uint32 InNumVerteces )
+{
+	return InNumVerteces <= STATICMESH_MAX_VERTECES_16BIT ? sizeof( uint16 ) : sizeof( uint32 );
+}
+
 /**
  * @ingroup Engine
  * @brief Implementation for static mesh
@@ -90,7 +158,7 @@ public:
 		bool											bDirty;						/**< Is dirty this element */
 		std::vector<DrawingPolicyLinkRef_t>				drawingPolicyLinks;			/**< Array of reference to drawing policy link in scene */
 		std::vector<DepthDrawingPolicyLinkRef_t>		depthDrawingPolicyLinks;	/**< Array of reference to depth drawing policy link in scene */
-		std::vector<const MeshBatch*>					meshBatchLinks;				/**< Array of references to mesh batch in drawing policy link */
+		std::vector<const MeshBatch*>					meshBatchLinks[STATICMESH_MAX_LODS];	/**< Array of references to mesh batch in drawing policy link for each LOD */
 		uint64											overrideHash;				/**< Hash of overrided segments (custom materials) */
 
 #if ENABLE_HITPROXY
@@ -122,8 +190,20 @@ public:
 	 * @param[in] InIndeces Array mesh indeces
 	 * @param[in] InSurfaces Array surfaces in mesh
 	 * @param[in] InMaterials Array materials in mesh
+	 * @param[in] InVertexFormat Vertex format in GPU memory
+	 */
+	void SetData( const std::vector< StaticMeshVertexType >& InVerteces, const std::vector< uint32 >& InIndeces, const std::vector< StaticMeshSurface >& InSurfaces, const std::vector< TAssetHandle<CMaterial> >& InMaterials, EStaticMeshVertexFormat InVertexFormat = SMVF_Default );
+
+	/**
+	 * Set data mesh with LODs
+	 * 
+	 * @param[in] InVerteces Array mesh verteces
+	 * @param[in] InIndeces Array mesh indeces of all LODs
+	 * @param[in] InLODs Array of LODs, first is full resolution mesh
+	 * @param[in] InMaterials Array materials in mesh
+	 * @param[in] InVertexFormat Vertex format in GPU memory
 	 */
-	void SetData( const std::vector< StaticMeshVertexType >& InVerteces, const std::vector< uint32 >& InIndeces, const std::vector< StaticMeshSurface >& InSurfaces, const std::vector< TAssetHandle<CMaterial> >& InMaterials );
+	void SetData( const std::vector< StaticMeshVertexType >& InVerteces, const std::vector< uint32 >& InIndeces, const std::vector< StaticMeshLOD >& InLODs, const std::vector< TAssetHandle<CMaterial> >& InMaterials, EStaticMeshVertexFormat InVertexFormat = SMVF_Default );
 
 	/**
 	 * Set material
@@ -148,18 +228,48 @@ public:
 	 */
 	FORCEINLINE uint32 GetNumSurfaces() const
 	{
-		return surfaces.size();
+		return lods[0].surfaces.size();
 	}
 
 	/**
-	 * Get surfaces
+	 * Get surfaces of full resolution LOD
 	 * @return Return array surfaces
 	 */
 	FORCEINLINE const std::vector< StaticMeshSurface > GetSurfaces() const
 	{
-		return surfaces;
+		return lods[0].surfaces;
 	}
 
+	/**
+	 * @brief Get number of LODs
+	 * @return Return number of LODs
+	 */
+	FORCEINLINE uint32 GetNumLODs() const
+	{
+		return lods.size();
+	}
+
+	/**
+	 * @brief Get LOD
+	 * 
+	 * @param InLODIndex	LOD index
+	 * @return Return LOD
+	 */
+	FORCEINLINE const StaticMeshLOD& GetLOD( uint32 InLODIndex ) const
+	{
+		Assert( InLODIndex < lods.size() );
+		return lods[InLODIndex];
+	}
+
+	/**
+	 * @brief Select LOD by screen size
+	 * 
+	 * @param InScreenSize		Screen size of mesh (diameter of bounding sphere relative to screen height)
+	 * @param InCurrentLOD		Current LOD, used for hysteresis
+	 * @return Return LOD index
+	 */
+	uint32 SelectLOD( float InScreenSize, uint32 InCurrentLOD ) const;
+
 	/**
 	 * Get materials
 	 * @return Return array materials
@@ -213,14 +323,41 @@ public:
 	}
 
 	/**
-	 * @brief Get array of verteces
-	 * @return Return array of verteces
+	 * @brief Get verteces unpacked from vertex format
+	 * @param OutVerteces	Output array of verteces
 	 */
-	FORCEINLINE const CBulkData<StaticMeshVertexType>& GetVerteces() const
+	FORCEINLINE void GetVerteces( std::vector<StaticMeshVertexType>& OutVerteces ) const
+	{
+		UnpackStaticMeshVerteces( verteces.GetData(), GetNumVerteces(), vertexFormat, bbox, OutVerteces );
+	}
+
+	/**
+	 * @brief Get packed verteces
+	 * @return Return array of verteces in vertex format
+	 */
+	FORCEINLINE const CBulkData<byte>& GetVertexData() const
 	{
 		return verteces;
 	}
 
+	/**
+	 * @brief Get number of verteces
+	 * @return Return number of verteces
+	 */
+	FORCEINLINE uint32 GetNumVerteces() const
+	{
+		return verteces.Num() / GetStaticMeshVertexStride( vertexFormat );
+	}
+
+	/**
+	 * @brief Get vertex format
+	 * @return Return vertex format in GPU memory
+	 */
+	FORCEINLINE EStaticMeshVertexFormat GetVertexFormat() const
+	{
+		return vertexFormat;
+	}
+
 	/**
 	 * @brief Get array of indeces
 	 * @return Return array of indeces
@@ -360,13 +497,15 @@ private:
 
 	/**
 	 * @brief Calculate bounding box
+	 * @param InVerteces	Array of verteces
 	 */
-	void CalcBoundingBox();
+	void CalcBoundingBox( const std::vector<StaticMeshVertexType>& InVerteces );
 
 	TRefCountPtr< CStaticMeshVertexFactory >	vertexFactory;				/**< Vertex factory */
 	std::vector< TAssetHandle<CMaterial> >		materials;					/**< Array materials in mesh */
-	std::vector< StaticMeshSurface >			surfaces;					/**< Array surfaces in mesh */
-	CBulkData< StaticMeshVertexType >			verteces;					/**< Array verteces to create RHI vertex buffer */
+	std::vector< StaticMeshLOD >				lods;						/**< Array of LODs in mesh, first is full resolution */
+	CBulkData< byte >							verteces;					/**< Array verteces in vertex format to create RHI vertex buffer */
+	TEnumAsByte<EStaticMeshVertexFormat>		vertexFormat;				/**< Vertex format in GPU memory */
 	CBulkData< uint32 >							indeces;					/**< Array indeces to create RHI index buffer */
 	VertexBufferRHIRef_t						vertexBufferRHI;			/**< RHI vertex buffer */
 	IndexBufferRHIRef_t							indexBufferRHI;				/**< RHI index buffer */
@@ -390,6 +529,20 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const StaticMeshSurface&
 	return InArchive;
 }
 
+FORCEINLINE CArchive& operator<<( CArchive& InArchive, StaticMeshLOD& InValue )
+{
+	InArchive << InValue.screenSize;
+	InArchive << InValue.surfaces;
+	return InArchive;
+}
+
+FORCEINLINE CArchive& operator<<( CArchive& InArchive, const StaticMeshLOD& InValue )
+{
+	InArchive << InValue.screenSize;
+	InArchive << InValue.surfaces;
+	return InArchive;
+}
+
 FORCEINLINE CArchive& operator<<( CArchive& InArchive, TAssetHandle<CStaticMesh>& InValue )
 {
 	TAssetHandle<CAsset>	asset = InValue;
@@ -0,0 +1,204 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef STATICMESHOPTIMIZER_H
+#define STATICMESHOPTIMIZER_H
+
+#include <string>
+#include <vector>
+
+#include "Render/StaticMesh.h"
+
+/**
+ * @ingroup Engine
+ * @brief Size of FIFO cache used for measure ACMR
+ */
+#define MESHOPTIMIZER_FIFO_CACHE_SIZE		16
+
+/**
+ * @ingroup Engine
+ * @brief Size of LRU cache used for vertex cache optimization
+ */
+#define MESHOPTIMIZER_LRU_CACHE_SIZE		32
+
+/**
+ * @ingroup Engine
+ * @brief Default threshold of ACMR loss for overdraw optimization
+ */
+#define MESHOPTIMIZER_OVERDRAW_THRESHOLD	1.05f
+
+/**
+ * @ingroup Engine
+ * @brief Ratio of triangles in LOD to triangles in previous LOD
+ */
+#define MESHOPTIMIZER_LOD_TRIANGLE_RATIO	0.5f
+
+/**
+ * @ingroup Engine
+ * @brief Ratio of screen size of LOD to screen size of previous LOD
+ */
+#define MESHOPTIMIZER_LOD_SCREEN_SIZE_RATIO	0.5f
+
+/**
+ * @ingroup Engine
+ * @brief LOD is dropped if it has more then this ratio of triangles in previous LOD
+ */
+#define MESHOPTIMIZER_LOD_MIN_REDUCTION		0.85f
+
+/**
+ * @ingroup Engine
+ * @brief Max error of simplification for first LOD (relative to diagonal of bounding box). Every next LOD doubles it
+ */
+#define MESHOPTIMIZER_SIMPLIFY_MAX_ERROR	0.01f
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of static mesh optimization
+ */
+struct StaticMeshOptimizationStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	StaticMeshOptimizationStats()
+		: numVertecesBefore( 0 )
+		, numVertecesAfter( 0 )
+		, numIndeces( 0 )
+		, acmrBefore( 0.f )
+		, acmrAfter( 0.f )
+		, numBytesBefore( 0 )
+		, numBytesAfter( 0 )
+	{}
+
+	/**
+	 * @brief Get number of saved bytes
+	 * @return Return number of saved bytes in GPU memory (may be negative)
+	 */
+	FORCEINLINE int64 GetNumSavedBytes() const
+	{
+		return ( int64 )numBytesBefore - ( int64 )numBytesAfter;
+	}
+
+	uint32		numVertecesBefore;		/**< Number of verteces before optimization */
+	uint32		numVertecesAfter;		/**< Number of verteces after optimization */
+	uint32		numIndeces;				/**< Number of indeces */
+	float		acmrBefore;				/**< Average cache miss ratio before optimization */
+	float		acmrAfter;				/**< Average cache miss ratio after optimization */
+	uint64		numBytesBefore;			/**< Size of vertex and index buffers before optimization */
+	uint64		numBytesAfter;			/**< Size of vertex and index buffers after optimization */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Optimizer of static meshes at import time
+ *
+ * Passes are run in order: exact vertex dedup, vertex cache reorder (Forsyth), overdraw cluster ordering
+ * and vertex fetch remap. Triangles are reordered only inside of own surface.
+ * Also optimizer generates LOD chain by quadric error metric simplification, all LODs share verteces of full resolution mesh
+ */
+class CStaticMeshOptimizer
+{
+public:
+	/**
+	 * @brief Optimize static mesh
+	 *
+	 * @param InOutVerteces		Array of verteces
+	 * @param InOutIndeces		Array of indeces
+	 * @param InSurfaces		Array of surfaces
+	 * @param InVertexFormat	Vertex format in GPU memory, used for calculate saved bytes
+	 * @param OutStats			Output statistics of optimization
+	 */
+	static void Optimize( std::vector<StaticMeshVertexType>& InOutVerteces, std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshSurface>& InSurfaces, EStaticMeshVertexFormat InVertexFormat, StaticMeshOptimizationStats& OutStats );
+
+	/**
+	 * @brief Remove exact duplicates of verteces
+	 *
+	 * @param InOutVerteces		Array of verteces
+	 * @param InOutIndeces		Array of indeces
+	 */
+	static void DeduplicateVerteces( std::vector<StaticMeshVertexType>& InOutVerteces, std::vector<uint32>& InOutIndeces );
+
+	/**
+	 * @brief Reorder triangles for post-transform vertex cache (Forsyth algorithm)
+	 *
+	 * @param InOutIndeces		Array of indeces to reorder
+	 * @param InNumVerteces		Number of verteces
+	 */
+	static void OptimizeVertexCache( std::vector<uint32>& InOutIndeces, uint32 InNumVerteces );
+
+	/**
+	 * @brief Reorder clusters of triangles for reduce overdraw
+	 * @note Indeces must be optimized for vertex cache before
+	 *
+	 * @param InOutIndeces		Array of indeces to reorder
+	 * @param InVerteces		Array of verteces
+	 * @param InThreshold		Max allowed ratio of ACMR after and before reorder
+	 */
+	static void OptimizeOverdraw( std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshVertexType>& InVerteces, float InThreshold = MESHOPTIMIZER_OVERDRAW_THRESHOLD );
+
+	/**
+	 * @brief Reorder verteces in order of first use by indeces. Unused verteces are removed
+	 *
+	 * @param InOutVerteces		Array of verteces
+	 * @param InOutIndeces		Array of indeces
+	 */
+	static void OptimizeVertexFetch( std::vector<StaticMeshVertexType>& InOutVerteces, std::vector<uint32>& InOutIndeces );
+
+	/**
+	 * @brief Calculate average cache miss ratio (number of transformed verteces per triangle)
+	 *
+	 * @param InIndeces			Array of indeces
+	 * @param InNumVerteces		Number of verteces
+	 * @param InCacheSize		Size of FIFO cache
+	 * @return Return average cache miss ratio
+	 */
+	static float CalcACMR( const std::vector<uint32>& InIndeces, uint32 InNumVerteces, uint32 InCacheSize = MESHOPTIMIZER_FIFO_CACHE_SIZE );
+
+	/**
+	 * @brief Generate LODs of static mesh
+	 * @note Indeces of LODs are appended to InOutIndeces, LOD may be dropped if simplification can't reduce enough triangles
+	 *
+	 * @param InVerteces		Array of verteces
+	 * @param InOutIndeces		Array of indeces
+	 * @param InSurfaces		Array of surfaces of full resolution mesh
+	 * @param InNumLODs			Number of LODs (include full resolution mesh)
+	 * @param OutLODs			Output array of LODs
+	 */
+	static void GenerateLODs( const std::vector<StaticMeshVertexType>& InVerteces, std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshSurface>& InSurfaces, uint32 InNumLODs, std::vector<StaticMeshLOD>& OutLODs );
+
+	/**
+	 * @brief Simplify triangles by quadric error metric
+	 * 
+	 * Edges are collapsed on existing verteces, so vertex buffer isn't changed.
+	 * Verteces on borders and attribute seams (same position with different attributes) are locked
+	 *
+	 * @param InOutIndeces			Array of indeces to simplify
+	 * @param InVerteces			Array of verteces
+	 * @param InTargetNumIndeces	Target number of indeces
+	 * @param InMaxError			Max error of collapse (relative to diagonal of bounding box)
+	 */
+	static void Simplify( std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshVertexType>& InVerteces, uint32 InTargetNumIndeces, float InMaxError = MESHOPTIMIZER_SIMPLIFY_MAX_ERROR );
+
+	/**
+	 * @brief Print statistics of optimization to log
+	 *
+	 * @param InMeshName	Name of mesh
+	 * @param InStats		Statistics of optimization
+	 */
+	static void LogStats( const std::wstring& InMeshName, const StaticMeshOptimizationStats& InStats );
+
+	/**
+	 * @brief Print LODs to log
+	 *
+	 * @param InMeshName	Name of mesh
+	 * @param InLODs		Array of LODs
+	 */
+	static void LogLODs( const std::wstring& InMeshName, const std::vector<StaticMeshLOD>& InLODs );
+};
+
+#endif // !STATICMESHOPTIMIZER_H
\ No newline at end of file
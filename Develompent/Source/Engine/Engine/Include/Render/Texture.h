@@ -19,6 +19,10 @@
 #include "RHI/BaseStateRHI.h"
 #include "RHI/TypesRHI.h"
 
+#if WITH_EDITOR
+#include "Misc/MipGenerator.h"
+#endif // WITH_EDITOR
+
 /**
  * @ingroup Engine
  * @brief 2D texture mipmap
@@ -57,9 +61,11 @@ public:
 #if WITH_EDITOR
 	/**
 	 * Generate mipmaps
-	 * @note Work only with editor
+	 * @note Work only with editor. Texture must be in PF_A8R8G8B8 format
+	 *
+	 * @param InSettings	Settings of mipmaps generation
 	 */
-	void GenerateMipmaps();
+	void GenerateMipmaps( const MipGenerationSettings& InSettings = MipGenerationSettings() );
 
 	/**
 	 * Get used memory size by the texture
@@ -68,6 +74,15 @@ public:
 	 * @return Return used memory size in bytes
 	 */
 	uint64 GetMemorySize() const;
+
+	/**
+	 * @brief Set mipmaps of texture
+	 * @note Work only with editor. Used by cooker for set compressed mipmaps
+	 *
+	 * @param InPixelFormat		Pixel format of mipmaps
+	 * @param InMipmaps			Array of mipmaps
+	 */
+	void SetMipmaps( EPixelFormat InPixelFormat, const std::vector<Texture2DMipMap>& InMipmaps );
 #endif // WITH_EDITOR
 
 	/**
@@ -234,6 +249,40 @@ public:
 		return mipmaps[InMipLevel];
 	}
 
+	/**
+	 * @brief Is texture streamable
+	 * @return Return TRUE if mips of texture can be streamed from package, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsStreamable() const
+	{
+		return !mipOffsets.empty();
+	}
+
+	/**
+	 * @brief Get offset of mip data in package
+	 * @note Valid only for streamable textures
+	 * 
+	 * @param InMipLevel		Mip level
+	 * @return Return offset of mip data in package file
+	 */
+	FORCEINLINE uint32 GetMipOffset( uint32 InMipLevel ) const
+	{
+		Assert( InMipLevel < mipOffsets.size() );
+		return mipOffsets[InMipLevel];
+	}
+
+	/**
+	 * @brief Update resident mips of RHI texture
+	 * 
+	 * Creates new RHI texture with mips from InFirstMip, copies mips which both textures have in common
+	 * and uploads new mips. Called by texture streaming manager
+	 * @warning This is only called by the rendering thread.
+	 * 
+	 * @param InFirstMip		New first resident mip
+	 * @param InNewMips			Loaded mips from InFirstMip to current first resident mip. May be nullptr when mips are evicted
+	 */
+	void UpdateResidentMips( uint32 InFirstMip, const std::vector<Texture2DMipMap>* InNewMips );
+
 protected:
 	/**
 	 * @brief Initializes the RHI resources used by this resource.
@@ -250,12 +299,20 @@ protected:
 	virtual void ReleaseRHI() override;
 
 private:
+	/**
+	 * @brief Serialize mipmaps with skip of high mips which will be streamed later
+	 * @param InArchive		Archive
+	 */
+	void SerializeStreamableMips( class CArchive& InArchive );
+
 	EPixelFormat						pixelFormat;		/**< Pixel format of texture */
 	Texture2DRHIRef_t					texture;			/**< Reference to RHI texture */
 	ESamplerAddressMode					addressU;			/**< Address mode for U coord */
 	ESamplerAddressMode					addressV;			/**< Address mode for V coord */
 	ESamplerFilter						samplerFilter;		/**< Sampler filter */
 	std::vector<Texture2DMipMap>		mipmaps;			/**< Array of mipmaps */
+	std::vector<uint32>					mipOffsets;			/**< Offsets of mip data in package. Empty if texture isn't streamable */
+	uint32								firstResidentMip;	/**< First mip which is in RHI texture */
 };
 
 //
@@ -0,0 +1,317 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TEXTURESTREAMING_H
+#define TEXTURESTREAMING_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+
+#include "System/ThreadingBase.h"
+#include "System/Package.h"
+#include "Render/Texture.h"
+
+/**
+ * @ingroup Engine
+ * @brief Default size of texture pool (in MB)
+ */
+#define TEXTURESTREAMING_DEFAULT_POOL_SIZE_MB		128
+
+/**
+ * @ingroup Engine
+ * @brief Default max size of mips which is loaded with texture. Larger mips are streamed
+ */
+#define TEXTURESTREAMING_DEFAULT_INITIAL_MIP_SIZE	64
+
+/**
+ * @ingroup Engine
+ * @brief Max number of requests to load mips in flight
+ */
+#define TEXTURESTREAMING_MAX_PENDING_REQUESTS		16
+
+/**
+ * @ingroup Engine
+ * @brief Time in seconds after which not seen texture may drop streamed mips even if pool has free space
+ */
+#define TEXTURESTREAMING_DROP_MIPS_TIME				5.f
+
+/**
+ * @ingroup Engine
+ * @brief Request to load mips of texture from package
+ */
+struct TextureStreamingRequest
+{
+	CTexture2D*						texture;		/**< Texture */
+	uint32							requestId;		/**< ID of request */
+	std::wstring					filename;		/**< Path to package with texture */
+	uint32							firstMip;		/**< First mip to load */
+	std::vector<uint32>				mipOffsets;		/**< Offsets of mips in package */
+	std::vector<Texture2DMipMap>	mips;			/**< Loaded mips */
+	bool							bSuccess;		/**< Is mips loaded successfully */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Runnable thread for load mips of textures from packages
+ */
+class CTextureStreamingRunnable : public CRunnable
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTextureStreamingRunnable();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CTextureStreamingRunnable();
+
+	/**
+	 * @brief Initialize
+	 *
+	 * Allows per runnable object initialization. NOTE: This is called in the
+	 * context of the thread object that aggregates this, not the thread that
+	 * passes this runnable to a new thread.
+	 *
+	 * @return True if initialization was successful, false otherwise
+	 */
+	virtual bool Init() override;
+
+	/**
+	 * @brief Run
+	 *
+	 * This is where all per object thread work is done. This is only called
+	 * if the initialization was successful.
+	 *
+	 * @return The exit code of the runnable object
+	 */
+	virtual uint32 Run() override;
+
+	/**
+	 * @brief Stop
+	 *
+	 * This is called if a thread is requested to terminate early
+	 */
+	virtual void Stop() override;
+
+	/**
+	 * @brief Exit
+	 *
+	 * Called in the context of the aggregating thread to perform any cleanup.
+	 */
+	virtual void Exit() override;
+
+	/**
+	 * @brief Add request to queue
+	 * @param InRequest		Request. Runnable takes ownership until the request is returned by GetCompletedRequests
+	 */
+	void AddRequest( TextureStreamingRequest* InRequest );
+
+	/**
+	 * @brief Get completed requests
+	 * @param OutRequests	Output array of completed requests. Caller takes ownership of them
+	 */
+	void GetCompletedRequests( std::vector<TextureStreamingRequest*>& OutRequests );
+
+private:
+	/**
+	 * @brief Load mips of request from package
+	 * @param InOutRequest	Request
+	 */
+	void LoadMips( TextureStreamingRequest* InOutRequest );
+
+	CEvent*									requestEvent;			/**< Event triggered when new request is added or thread is stopped */
+	CCriticalSection						csRequests;				/**< Critical section for queues of requests */
+	std::list<TextureStreamingRequest*>		pendingRequests;		/**< Queue of pending requests */
+	std::vector<TextureStreamingRequest*>	completedRequests;		/**< Array of completed requests */
+	bool									bStopping;				/**< Is thread is stopping */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Texture streaming manager
+ *
+ * Streamable textures are loaded only with low mips. During view building primitives report screen size of
+ * own materials, from it manager computes wanted mip of each texture. Every tick wanted mips are fitted to pool budget
+ * (least recently needed textures are lowered first), higher mips are loaded from package in separate thread and
+ * not needed mips are evicted from least recently needed textures
+ */
+class CTextureStreamingManager
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTextureStreamingManager();
+
+	/**
+	 * @brief Initialize manager
+	 * Reads settings from config (Engine.SystemSettings:TextureStreaming, TexturePoolSizeMB, TextureStreamingInitialMipSize)
+	 * and starts streaming thread. Streaming is enabled only in game
+	 */
+	void Init();
+
+	/**
+	 * @brief Shutdown manager
+	 */
+	void Shutdown();
+
+	/**
+	 * @brief Update streaming
+	 * @note Must be called from game thread
+	 *
+	 * @param InDeltaSeconds	Delta seconds
+	 */
+	void Tick( float InDeltaSeconds );
+
+	/**
+	 * @brief Add streamable texture
+	 *
+	 * @param InTexture				Texture
+	 * @param InFirstResidentMip	First mip which is loaded with texture
+	 */
+	void AddTexture( CTexture2D* InTexture, uint32 InFirstResidentMip );
+
+	/**
+	 * @brief Remove streamable texture
+	 * @note If rendering thread has not executed updates of resident mips of texture yet, waits them, so texture may be freed right after it
+	 *
+	 * @param InTexture		Texture
+	 */
+	void RemoveTexture( CTexture2D* InTexture );
+
+	/**
+	 * @brief Complete update of resident mips
+	 * @note Called by rendering thread after update of resident mips of texture
+	 *
+	 * @param InTexture		Texture
+	 */
+	void CompleteResidentMipsUpdate( CTexture2D* InTexture );
+
+	/**
+	 * @brief Add textures of material which is visible in view
+	 * @note Can be called from rendering thread
+	 *
+	 * @param InMaterial			Material
+	 * @param InScreenPixelSize		Size of primitive on screen (in pixels)
+	 */
+	void AddViewMaterial( const TAssetHandle<class CMaterial>& InMaterial, float InScreenPixelSize );
+
+	/**
+	 * @brief Add texture which is visible in view
+	 * @note Can be called from rendering thread
+	 *
+	 * @param InTexture				Texture
+	 * @param InScreenPixelSize		Size of primitive on screen (in pixels)
+	 */
+	void AddViewTexture( CTexture2D* InTexture, float InScreenPixelSize );
+
+	/**
+	 * @brief Is texture streaming enabled
+	 * @return Return TRUE if texture streaming is enabled, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	/**
+	 * @brief Get max size of mips which is loaded with texture
+	 * @return Return max size of mips which is loaded with texture
+	 */
+	FORCEINLINE uint32 GetInitialMipSize() const
+	{
+		return initialMipSize;
+	}
+
+	/**
+	 * @brief Get size of texture pool
+	 * @return Return size of texture pool (in bytes)
+	 */
+	FORCEINLINE uint64 GetPoolSize() const
+	{
+		return poolSize;
+	}
+
+private:
+	/**
+	 * @brief Streaming state of texture
+	 */
+	struct StreamingTexture
+	{
+		uint32		baseMip;			/**< First mip which is loaded with texture, it never evicted */
+		uint32		residentMip;		/**< First resident mip (after all sent render commands) */
+		uint32		wantedMip;			/**< First mip which is wanted by views */
+		uint32		visibleMip;			/**< First mip which is wanted by views since last tick. INDEX_NONE if texture isn't seen */
+		uint32		pendingMip;			/**< First mip of pending request. INDEX_NONE if no requests */
+		uint32		pendingRequestId;	/**< ID of pending request */
+		uint32		numRenderUpdates;	/**< Number of resident mips updates sent to rendering thread and not executed yet */
+		double		lastSeenTime;		/**< Last time when texture is seen in view */
+	};
+
+	/**
+	 * @brief Update of resident mips which must be sent to rendering thread
+	 */
+	struct ResidentMipsUpdate
+	{
+		CTexture2D*						texture;		/**< Texture */
+		uint32							firstMip;		/**< New first resident mip */
+		std::vector<Texture2DMipMap>*	newMips;		/**< Loaded mips. May be nullptr when mips are evicted */
+	};
+
+	/**
+	 * @brief Update streaming state of textures
+	 * @note Must be called under lock of textures
+	 *
+	 * @param OutUpdates	Output array of resident mips updates
+	 */
+	void TickTextures( std::vector<ResidentMipsUpdate>& OutUpdates );
+
+	/**
+	 * @brief Complete loaded requests
+	 * @param OutUpdates	Output array of resident mips updates
+	 */
+	void ProcessCompletedRequests( std::vector<ResidentMipsUpdate>& OutUpdates );
+
+	/**
+	 * @brief Update wanted mips from views and fit them to pool budget
+	 * @param OutSortedTextures		Output array of textures sorted from least recently needed
+	 */
+	void UpdateWantedMips( std::vector<std::pair<CTexture2D*, StreamingTexture*>>& OutSortedTextures );
+
+	/**
+	 * @brief Calculate size of texture mips
+	 *
+	 * @param InTexture		Texture
+	 * @param InFirstMip	First mip
+	 * @return Return size of mips from InFirstMip to last mip (in bytes)
+	 */
+	static uint64 CalcMipsSize( const CTexture2D* InTexture, uint32 InFirstMip );
+
+	bool													bEnabled;				/**< Is texture streaming enabled */
+	uint32													initialMipSize;			/**< Max size of mips which is loaded with texture */
+	uint64													poolSize;				/**< Size of texture pool */
+	double													currentTime;			/**< Current time of streaming */
+	uint32													nextRequestId;			/**< ID of next request */
+	uint32													numPendingRequests;		/**< Number of requests in flight */
+	CCriticalSection										csTextures;				/**< Critical section for textures, views are build in rendering thread */
+	std::unordered_map<CTexture2D*, StreamingTexture>		textures;				/**< Streamable textures */
+	CTextureStreamingRunnable*								streamingRunnable;		/**< Streaming runnable */
+	CRunnableThread*										streamingThread;		/**< Streaming thread */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Texture streaming manager
+ */
+extern CTextureStreamingManager			g_TextureStreamingManager;
+
+#endif // !TEXTURESTREAMING_H
\ No newline at end of file
@@ -0,0 +1,140 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TILEMAPMESH_H
+#define TILEMAPMESH_H
+
+#include <vector>
+
+#include "RenderResource.h"
+#include "Misc/RefCounted.h"
+#include "Render/VertexFactory/SpriteVertexFactory.h"
+#include "RHI/BaseBufferRHI.h"
+#include "RHI/TypesRHI.h"
+#include "Render/Material.h"
+
+/**
+ * @ingroup Engine
+ * @brief Reference to CTileMapChunkMesh
+ */
+typedef TRefCountPtr< class CTileMapChunkMesh >			TileMapChunkMeshRef_t;
+
+/**
+ * @ingroup Engine
+ * @brief Surface in mesh of tile map chunk, all tiles of one layer with the same material
+ */
+struct TileMapChunkSurface
+{
+	TAssetHandle<CMaterial>		material;			/**< Material */
+	uint32						firstIndex;			/**< First index */
+	uint32						numPrimitives;		/**< Number primitives in the surface */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Static mesh of tile map chunk
+ *
+ * Tiles are baked to vertex buffer in local space of tile map with final texture coords, so mesh is drawn
+ * by sprite vertex factory with identity sprite size and texture rect. It allows use materials of sprites
+ */
+class CTileMapChunkMesh : public CRenderResource, public CRefCounted
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTileMapChunkMesh();
+
+	/**
+	 * @brief Set data of mesh
+	 * @note After call mesh will be updated on rendering thread, new data can be set only when mesh is ready (see IsReady)
+	 *
+	 * @param InVerteces	Verteces
+	 * @param InIndeces		Indeces
+	 * @param InSurfaces	Surfaces
+	 */
+	void SetData( const std::vector<SpriteVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<TileMapChunkSurface>& InSurfaces );
+
+	/**
+	 * @brief Release RHI resources of mesh on rendering thread
+	 * @note Mesh is kept alive until rendering thread releases it
+	 */
+	void BeginRelease();
+
+	/**
+	 * @brief Is mesh ready for draw
+	 * @return Return FALSE if rendering thread not finished uploading of the last data to GPU, otherwise returning TRUE
+	 */
+	FORCEINLINE bool IsReady() const
+	{
+		return numPendingUpdates == 0;
+	}
+
+	/**
+	 * @brief Get surfaces
+	 * @return Return array of surfaces
+	 */
+	FORCEINLINE const std::vector<TileMapChunkSurface>& GetSurfaces() const
+	{
+		return surfaces;
+	}
+
+	/**
+	 * @brief Get vertex factory
+	 * @return Return vertex factory
+	 */
+	FORCEINLINE TRefCountPtr<CSpriteVertexFactory> GetVertexFactory() const
+	{
+		return vertexFactory;
+	}
+
+	/**
+	 * @brief Get RHI index buffer
+	 * @return Return RHI index buffer, if not created return nullptr
+	 */
+	FORCEINLINE IndexBufferRHIRef_t GetIndexBufferRHI() const
+	{
+		return indexBufferRHI;
+	}
+
+	/**
+	 * @brief Get number of verteces
+	 * @return Return number of verteces
+	 */
+	FORCEINLINE uint32 GetNumVerteces() const
+	{
+		return numVerteces;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	volatile int32						numPendingUpdates;	/**< Number of data updates which not finished on rendering thread */
+	uint32								numVerteces;		/**< Number of verteces */
+	std::vector<SpriteVertexType>		verteces;			/**< Verteces (cleared after upload to GPU) */
+	std::vector<uint32>					indeces;			/**< Indeces (cleared after upload to GPU) */
+	std::vector<TileMapChunkSurface>	surfaces;			/**< Surfaces */
+	TRefCountPtr<CSpriteVertexFactory>	vertexFactory;		/**< Vertex factory */
+	VertexBufferRHIRef_t				vertexBufferRHI;	/**< Vertex buffer RHI */
+	IndexBufferRHIRef_t					indexBufferRHI;		/**< Index buffer RHI */
+};
+
+#endif // !TILEMAPMESH_H
\ No newline at end of file
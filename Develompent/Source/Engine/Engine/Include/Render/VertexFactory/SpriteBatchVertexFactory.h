@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef SPRITEBATCHVERTEXFACTORY_H
+#define SPRITEBATCHVERTEXFACTORY_H
+
+#include "Math/Math.h"
+#include "Render/VertexFactory/VertexFactory.h"
+#include "Render/RenderUtils.h"
+
+/**
+ * @ingroup Engine
+ * Vertex type for batched sprites
+ */
+struct SpriteBatchVertexType
+{
+	Vector4D		position;		/**< Position vertex in world space */
+	Vector2D		texCoord;		/**< Final texture coords */
+	Vector4D		normal;			/**< Normal in world space */
+	Vector4D		color;			/**< Color */
+};
+
+/**
+ * @ingroup Engine
+ * The sprite batch vertex declaration resource type
+ */
+class CSpriteBatchVertexDeclaration : public CRenderResource
+{
+public:
+	/**
+	 * @brief Get vertex declaration RHI
+	 * @return Return vertex declaration RHI
+	 */
+	FORCEINLINE VertexDeclarationRHIRef_t GetVertexDeclarationRHI()
+	{
+		if ( !vertexDeclarationRHI )
+		{
+			InitRHI();
+		}
+		return vertexDeclarationRHI;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	VertexDeclarationRHIRef_t		vertexDeclarationRHI;		/**< Vertex declaration RHI */
+};
+
+/**
+ * @ingroup Engine
+ * Global resource of sprite batch vertex declaration
+ */
+extern TGlobalResource< CSpriteBatchVertexDeclaration >			g_SpriteBatchVertexDeclaration;
+
+/**
+ * @ingroup Engine
+ * Vertex factory for render batched sprites
+ *
+ * Verteces of sprites are built on CPU every frame in world space with final texture coords,
+ * so many sprites with one material are drawn by one draw call
+ */
+class CSpriteBatchVertexFactory : public CVertexFactory
+{
+	DECLARE_VERTEX_FACTORY_TYPE( CSpriteBatchVertexFactory )
+
+public:
+	enum EStreamSourceSlot
+	{
+		SSS_Main = 0		/**< Main vertex buffer */
+	};
+
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Construct vertex factory shader parameters
+	 *
+	 * @param InShaderFrequency Shader frequency
+	 * @return Return instance of vertex factory shader parameters
+	 */
+	static CVertexFactoryShaderParameters* ConstructShaderParameters( EShaderFrequency InShaderFrequency );
+};
+
+#endif // !SPRITEBATCHVERTEXFACTORY_H
\ No newline at end of file
@@ -11,6 +11,7 @@
 
 #include "Math/Math.h"
 #include "Math/Rect.h"
+#include "Math/Color.h"
 #include "Render/VertexFactory/VertexFactory.h"
 #include "Render/VertexFactory/GeneralVertexFactoryParams.h"
 #include "Render/RenderUtils.h"
@@ -113,6 +114,7 @@ private:
 	CShaderParameter		flipHorizontalParameter;	/**< Flag is need flip by horizontal parameter */
 	CShaderParameter		textureRectParameter;		/**< Texture rect parameter */
 	CShaderParameter		spriteSizeParameter;		/**< Sprite size parameter */
+	CShaderParameter		spriteColorParameter;		/**< Sprite color parameter */
 };
 
 /**
@@ -194,6 +196,15 @@ public:
 		spriteSize = InSpriteSize;
 	}
 
+	/**
+	 * @brief Set sprite color
+	 * @param InSpriteColor Sprite color
+	 */
+	FORCEINLINE void SetSpriteColor( const CColor& InSpriteColor )
+	{
+		spriteColor = InSpriteColor;
+	}
+
 	/**
 	 * @brief Set flip by vertical
 	 * @param InFlipVertical Is need flip sprite by vertical
@@ -221,6 +232,15 @@ public:
 		return spriteSize;
 	}
 
+	/**
+	 * @brief Get sprite color
+	 * @return Return sprite color
+	 */
+	FORCEINLINE const CColor& GetSpriteColor() const
+	{
+		return spriteColor;
+	}
+
 	/**
 	 * @brief Is fliped by vertical
 	 * @return Return TRUE if sprite fliped by vertical
@@ -244,6 +264,7 @@ private:
 	bool				bFlipHorizontal;	/**< Is need flip sprite by horizontal */
 	RectFloat_t			textureRect;		/**< Texture rect */
 	Vector2D			spriteSize;			/**< Sprite size */
+	CColor				spriteColor;		/**< Sprite color */
 };
 
 //
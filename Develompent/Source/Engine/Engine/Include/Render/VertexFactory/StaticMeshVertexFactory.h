@@ -9,10 +9,27 @@
 #ifndef STATICMESHVERTEXFACTORY_H
 #define STATICMESHVERTEXFACTORY_H
 
+#include <vector>
+
 #include "Math/Math.h"
+#include "Math/Box.h"
 #include "Render/VertexFactory/VertexFactory.h"
+#include "Render/VertexFactory/GeneralVertexFactoryParams.h"
 #include "Render/RenderUtils.h"
 
+/**
+ * @ingroup Engine
+ * @brief Enumeration of vertex formats for static mesh in GPU memory
+ */
+enum EStaticMeshVertexFormat
+{
+	SMVF_Compact,					/**< Float3 position, half2 texture coords, normal and tangent in 10:10:10:2 with sign of binormal (24 bytes) */
+	SMVF_Quantized,					/**< 16-bit position relative to bounds of mesh, half2 texture coords, normal and tangent in 10:10:10:2 with sign of binormal (20 bytes) */
+	SMVF_Full,						/**< Full precision StaticMeshVertexType, normal and tangent are biased to 0..1 with sign of binormal in W of tangent (72 bytes) */
+	SMVF_Num,						/**< Number of vertex formats */
+	SMVF_Default = SMVF_Compact		/**< Default vertex format */
+};
+
  /**
   * @ingroup Engine
   * Vertex type for static mesh
@@ -40,22 +57,90 @@ struct StaticMeshVertexType
 
 /**
  * @ingroup Engine
- * The static mesh vertex declaration resource type
+ * Vertex type for static mesh in SMVF_Compact format
+ */
+struct StaticMeshCompactVertexType
+{
+	Vector			position;		/**< Position vertex */
+	uint32			texCoord;		/**< Texture coords (half2) */
+	uint32			normal;			/**< Normal (unorm 10:10:10:2) */
+	uint32			tangent;		/**< Tangent (unorm 10:10:10:2), in W stored sign of binormal */
+};
+
+/**
+ * @ingroup Engine
+ * Vertex type for static mesh in SMVF_Quantized format
+ */
+struct StaticMeshQuantizedVertexType
+{
+	uint16			position[4];	/**< Position vertex relative to bounds of mesh (unorm16) */
+	uint32			texCoord;		/**< Texture coords (half2) */
+	uint32			normal;			/**< Normal (unorm 10:10:10:2) */
+	uint32			tangent;		/**< Tangent (unorm 10:10:10:2), in W stored sign of binormal */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Get name of static mesh vertex format
+ *
+ * @param InVertexFormat	Vertex format
+ * @return Return name of vertex format
+ */
+const tchar* GetStaticMeshVertexFormatName( EStaticMeshVertexFormat InVertexFormat );
+
+/**
+ * @ingroup Engine
+ * @brief Get size of one vertex in static mesh vertex format
+ *
+ * @param InVertexFormat	Vertex format
+ * @return Return size of one vertex in bytes
+ */
+uint32 GetStaticMeshVertexStride( EStaticMeshVertexFormat InVertexFormat );
+
+/**
+ * @ingroup Engine
+ * @brief Pack static mesh verteces to GPU vertex format
+ *
+ * @param InVerteces		Array of verteces
+ * @param InVertexFormat	Vertex format
+ * @param InBounds			Bounding box of verteces, used for quantize position
+ * @param OutData			Output packed verteces
+ */
+void PackStaticMeshVerteces( const std::vector<StaticMeshVertexType>& InVerteces, EStaticMeshVertexFormat InVertexFormat, const CBox& InBounds, std::vector<byte>& OutData );
+
+/**
+ * @ingroup Engine
+ * @brief Unpack static mesh verteces from GPU vertex format
+ *
+ * @param InData			Packed verteces
+ * @param InNumVerteces		Number of verteces
+ * @param InVertexFormat	Vertex format
+ * @param InBounds			Bounding box of verteces, used for dequantize position
+ * @param OutVerteces		Output array of verteces
+ */
+void UnpackStaticMeshVerteces( const byte* InData, uint32 InNumVerteces, EStaticMeshVertexFormat InVertexFormat, const CBox& InBounds, std::vector<StaticMeshVertexType>& OutVerteces );
+
+/**
+ * @ingroup Engine
+ * The static mesh vertex declaration resource type. Contains declarations for all static mesh vertex formats
  */
 class CStaticMeshVertexDeclaration : public CRenderResource
 {
 public:
 	/**
 	 * @brief Get vertex declaration RHI
+	 * 
+	 * @param InVertexFormat	Vertex format
 	 * @return Return vertex declaration RHI
 	 */
-	FORCEINLINE VertexDeclarationRHIRef_t GetVertexDeclarationRHI()
+	FORCEINLINE VertexDeclarationRHIRef_t GetVertexDeclarationRHI( EStaticMeshVertexFormat InVertexFormat = SMVF_Default )
 	{
-		if ( !vertexDeclarationRHI )
+		Assert( InVertexFormat < SMVF_Num );
+		if ( !vertexDeclarationRHIs[InVertexFormat] )
 		{
 			InitRHI();
 		}
-		return vertexDeclarationRHI;
+		return vertexDeclarationRHIs[InVertexFormat];
 	}
 
 protected:
@@ -74,7 +159,7 @@ protected:
 	virtual void ReleaseRHI() override;
 
 private:
-	VertexDeclarationRHIRef_t		vertexDeclarationRHI;		/**< Vertex declaration RHI */
+	VertexDeclarationRHIRef_t		vertexDeclarationRHIs[SMVF_Num];		/**< Vertex declarations RHI for each vertex format */
 };
 
 /**
@@ -83,6 +168,38 @@ private:
  */
 extern TGlobalResource< CStaticMeshVertexDeclaration >			g_StaticMeshVertexDeclaration;
 
+/**
+ * @ingroup Engine
+ * @brief Vertex factory shader parameters for static meshes
+ */
+class CStaticMeshVertexShaderParameters : public CGeneralVertexShaderParameters
+{
+public:
+	/**
+	 * Constructor
+	 */
+	CStaticMeshVertexShaderParameters();
+
+	/**
+	 * @brief Bind shader parameters
+	 *
+	 * @param InParameterMap Shader parameter map
+	 */
+	virtual void Bind( const class CShaderParameterMap& InParameterMap ) override;
+
+	/**
+	 * @brief Set any shader data specific to this vertex factory
+	 *
+	 * @param InDeviceContextRHI RHI device context
+	 * @param InVertexFactory Vertex factory
+	 */
+	virtual void Set( class CBaseDeviceContextRHI* InDeviceContextRHI, const class CVertexFactory* InVertexFactory ) const override;
+
+private:
+	CShaderParameter		positionScaleParameter;		/**< Scale of quantized position parameter */
+	CShaderParameter		positionBiasParameter;		/**< Bias of quantized position parameter */
+};
+
 /**
  * @ingroup Engine
  * Vertex factory for render static meshes
@@ -97,6 +214,11 @@ public:
 		SSS_Main = 0		/**< Main vertex buffer */
 	};
 
+	/**
+	 * @brief Constructor
+	 */
+	CStaticMeshVertexFactory();
+
 	/**
 	 * @brief Initializes the RHI resources used by this resource.
 	 * Called when the resource is initialized.
@@ -104,6 +226,12 @@ public:
 	 */
 	virtual void InitRHI() override;
 
+	/**
+	 * @brief Get type hash
+	 * @return Return hash of vertex factory
+	 */
+	virtual uint64 GetTypeHash() const override;
+
 	/**
 	 * @brief Construct vertex factory shader parameters
 	 * 
@@ -111,6 +239,47 @@ public:
 	 * @return Return instance of vertex factory shader parameters
 	 */
 	static CVertexFactoryShaderParameters* ConstructShaderParameters( EShaderFrequency InShaderFrequency );
+
+	/**
+	 * @brief Set vertex format
+	 * @note Must be called before InitRHI
+	 * 
+	 * @param InVertexFormat	Vertex format
+	 * @param InBounds			Bounding box of mesh, used for dequantize position
+	 */
+	void SetVertexFormat( EStaticMeshVertexFormat InVertexFormat, const CBox& InBounds );
+
+	/**
+	 * @brief Get vertex format
+	 * @return Return vertex format
+	 */
+	FORCEINLINE EStaticMeshVertexFormat GetVertexFormat() const
+	{
+		return vertexFormat;
+	}
+
+	/**
+	 * @brief Get scale of position
+	 * @return Return scale of position
+	 */
+	FORCEINLINE const Vector& GetPositionScale() const
+	{
+		return positionScale;
+	}
+
+	/**
+	 * @brief Get bias of position
+	 * @return Return bias of position
+	 */
+	FORCEINLINE const Vector& GetPositionBias() const
+	{
+		return positionBias;
+	}
+
+private:
+	EStaticMeshVertexFormat		vertexFormat;		/**< Vertex format */
+	Vector						positionScale;		/**< Scale of position (for quantized position is size of bounds) */
+	Vector						positionBias;		/**< Bias of position (for quantized position is minimum of bounds) */
 };
 
 //
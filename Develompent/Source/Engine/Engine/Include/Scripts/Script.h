@@ -77,6 +77,18 @@ public:
 		return TReturnType();
 	}
 
+	/**
+	 * @brief Is function exist in script
+	 *
+	 * @param[in] InFunctionName Function name
+	 * @return Return TRUE if script has global function with this name, else return FALSE
+	 */
+	FORCEINLINE bool IsFunctionExist( const achar* InFunctionName ) const
+	{
+		luabridge::LuaRef		luaRef = luabridge::getGlobal( luaVM, InFunctionName );
+		return luaRef && luaRef.isFunction();
+	}
+
 	/**
 	 * @brief Set name of script
 	 * @param[in] InName
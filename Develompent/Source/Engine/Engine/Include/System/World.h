@@ -102,7 +102,7 @@ public:
 	}
 
 	/**
-	 * Trace a ray against the world using a specific channel and return the first blocking hit
+	 * Trace a ray against the world using a specific channel and return the closest hit
 	 * 
 	 * @param OutHitResult Hit result
 	 * @param InStart Start ray
@@ -116,6 +116,53 @@ public:
 		return g_PhysicsScene.LineTraceSingleByChannel( OutHitResult, InStart, InEnd, InTraceChannel, InCollisionQueryParams );
 	}
 
+	/**
+	 * Trace a ray against the world using a specific channel and return all hits sorted by distance
+	 * 
+	 * @param OutHitResults Array of hit results
+	 * @param InStart Start ray
+	 * @param InEnd End ray
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return TRUE if any hit is found, else false
+	 */
+	FORCEINLINE bool LineTraceMultiByChannel( std::vector<HitResult>& OutHitResults, const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam )
+	{
+		return g_PhysicsScene.LineTraceMultiByChannel( OutHitResults, InStart, InEnd, InTraceChannel, InCollisionQueryParams );
+	}
+
+	/**
+	 * Sweep a shape against the world using a specific channel and return the closest hit
+	 * 
+	 * @param OutHitResult Hit result
+	 * @param InStart Start location of the shape
+	 * @param InEnd End location of the shape
+	 * @param InRotation Rotation of the shape
+	 * @param InShape Shape to sweep
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return TRUE if a blocking hit is found, else false
+	 */
+	FORCEINLINE bool SweepSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, const Quaternion& InRotation, const CollisionShape& InShape, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam )
+	{
+		return g_PhysicsScene.SweepSingleByChannel( OutHitResult, InStart, InEnd, InRotation, InShape, InTraceChannel, InCollisionQueryParams );
+	}
+
+	/**
+	 * Test the shape against the world using a specific channel and return all overlapping components
+	 * 
+	 * @param OutOverlapResults Array of overlap results
+	 * @param InLocation Location of the shape
+	 * @param InRotation Rotation of the shape
+	 * @param InShape Shape to test
+	 * @param InTraceChannel Trace channel
+	 * @return Return TRUE if any overlap is found, else false
+	 */
+	FORCEINLINE bool OverlapMultiByChannel( std::vector<OverlapResult>& OutOverlapResults, const Vector& InLocation, const Quaternion& InRotation, const CollisionShape& InShape, ECollisionChannel InTraceChannel )
+	{
+		return g_PhysicsScene.OverlapMultiByChannel( OutOverlapResults, InLocation, InRotation, InShape, InTraceChannel );
+	}
+
 #if ENABLE_HITPROXY
 	/**
 	 * Update hit proxies id in all actors
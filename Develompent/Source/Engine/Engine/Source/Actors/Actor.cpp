@@ -318,19 +318,6 @@ void AActor::TermPhysics()
 	}
 }
 
-/*
-==================
-AActor::SyncPhysics
-==================
-*/
-void AActor::SyncPhysics()
-{
-	if ( collisionComponent )
-	{
-		collisionComponent->SyncComponentToPhysics();
-	}
-}
-
 #if WITH_EDITOR
 /*
 ==================
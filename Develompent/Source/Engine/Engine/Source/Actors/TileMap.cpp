@@ -0,0 +1,43 @@
+#include "Actors/TileMap.h"
+
+IMPLEMENT_CLASS( ATileMap )
+
+/*
+==================
+ATileMap::ATileMap
+==================
+*/
+ATileMap::ATileMap()
+{
+    tileMapComponent     = CreateComponent< CTileMapComponent >( TEXT( "TileMapComponent0" ) );
+}
+
+/*
+==================
+ATileMap::~ATileMap
+==================
+*/
+ATileMap::~ATileMap()
+{}
+
+/*
+==================
+ATileMap::StaticInitializeClass
+==================
+*/
+void ATileMap::StaticInitializeClass()
+{
+	new( staticClass, TEXT( "Tile Map Component" ) ) CObjectProperty( TEXT( "Drawing" ), TEXT( "Tile map component" ), STRUCT_OFFSET( ThisClass, tileMapComponent ), CPF_Edit, CTileMapComponent::StaticClass() );
+}
+
+#if WITH_EDITOR
+/*
+==================
+ATileMap::GetActorIcon
+==================
+*/
+std::wstring ATileMap::GetActorIcon() const
+{
+    return TEXT( "Engine/Editor/Icons/CB_Map.png" );
+}
+#endif // WITH_EDITOR
\ No newline at end of file
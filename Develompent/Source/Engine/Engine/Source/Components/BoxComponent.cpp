@@ -51,12 +51,14 @@ CBoxComponent::UpdateBodySetup
 */
 void CBoxComponent::UpdateBodySetup()
 {
-	bodySetup = new CPhysicsBodySetup();
-
+	PhysicsBodySetupRef_t			newBodySetup = new CPhysicsBodySetup();
 	PhysicsBoxGeometry				boxGeometry( size.x, size.y, size.z );
 	boxGeometry.collisionProfile	= collisionProfile;
 	boxGeometry.material			= physicsMaterial;
-	bodySetup->AddBoxGeometry( boxGeometry );
+	newBodySetup->AddBoxGeometry( boxGeometry );
+
+	// Boxes with the same size, profile and material share one body setup, so its shapes are created only once
+	bodySetup = g_PhysicsEngine.FindOrAddCachedBodySetup( newBodySetup );
 }
 
 /*
@@ -90,4 +90,14 @@ CLightComponent::GetLightType
 ELightType CLightComponent::GetLightType() const
 {
 	return LT_Unknown;
+}
+
+/*
+==================
+CLightComponent::GetBoundingSphere
+==================
+*/
+bool CLightComponent::GetBoundingSphere( Vector& OutCenter, float& OutRadius ) const
+{
+	return false;
 }
\ No newline at end of file
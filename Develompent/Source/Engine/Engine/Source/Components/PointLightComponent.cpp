@@ -64,4 +64,16 @@ CPointLightComponent::GetLightType
 ELightType CPointLightComponent::GetLightType() const
 {
 	return LT_Point;
+}
+
+/*
+==================
+CPointLightComponent::GetBoundingSphere
+==================
+*/
+bool CPointLightComponent::GetBoundingSphere( Vector& OutCenter, float& OutRadius ) const
+{
+	OutCenter	= GetComponentLocation();
+	OutRadius	= radius;
+	return true;
 }
\ No newline at end of file
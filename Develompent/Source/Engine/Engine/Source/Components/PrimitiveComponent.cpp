@@ -72,11 +72,24 @@ void CPrimitiveComponent::TickComponent( float InDeltaTime )
 	Super::TickComponent( InDeltaTime );
 
 	// If body instance is dirty - reinit physics component
-	if ( bodyInstance.IsDirty() || bodySetup != bodyInstance.GetBodySetup() )
+	if ( bodyInstance.IsDirty() )
 	{
 		TermPrimitivePhysics();
 		InitPrimitivePhysics();
 	}
+	// If only shapes are changed - swap them on existing physics actor
+	else if ( bodySetup != bodyInstance.GetBodySetup() )
+	{
+		if ( bodySetup && bodyInstance.IsValid() )
+		{
+			bodyInstance.SetBodySetup( bodySetup );
+		}
+		else
+		{
+			TermPrimitivePhysics();
+			InitPrimitivePhysics();
+		}
+	}
 }
 
 /*
@@ -153,7 +166,7 @@ void CPrimitiveComponent::SyncComponentToPhysics()
 		Assert( actorOwner );
 
 		CTransform		oldTransform = actorOwner->GetActorTransform();
-		CTransform		newTransform = bodyInstance.GetLEWorldTransform();
+		CTransform		newTransform = bodyInstance.GetLEInterpolatedTransform();
 
 #if ENGINE_2D
 		// For 2D game we copy to new transform Z coord (in 2D this is layer)
@@ -162,8 +175,7 @@ void CPrimitiveComponent::SyncComponentToPhysics()
 
 		if ( !oldTransform.MatchesNoScale( newTransform ) )
 		{
-			actorOwner->SetActorLocation( newTransform.GetLocation() );
-			actorOwner->SetActorRotation( newTransform.GetRotation() );
+			actorOwner->SetActorLocationAndRotation( newTransform.GetLocation(), newTransform.GetRotation() );
 		}
 	}
 }
@@ -181,6 +193,49 @@ void CPrimitiveComponent::TermPrimitivePhysics()
 	}
 }
 
+/*
+==================
+CPrimitiveComponent::NotifyContactEvent
+==================
+*/
+void CPrimitiveComponent::NotifyContactEvent( const PhysicsContactEvent& InEvent )
+{
+	if ( !( bodyInstance.GetNotifyFlags() & InEvent.GetNotifyFlag() ) )
+	{
+		return;
+	}
+
+	const bool				bBodyA = InEvent.bodyA == &bodyInstance;
+	CPhysicsBodyInstance*	otherBodyInstance = bBodyA ? InEvent.bodyB : InEvent.bodyA;
+	CPrimitiveComponent*	otherComponent = otherBodyInstance ? otherBodyInstance->GetOwnerComponent() : nullptr;
+	onComponentContact.Broadcast( this, otherComponent, InEvent );
+
+	// Forward event to script if it has handler
+	TSharedPtr<CScript>		scriptRef = contactScript.ToSharedPtr();
+	if ( !scriptRef )
+	{
+		return;
+	}
+
+	const achar*			functionName = nullptr;
+	switch ( InEvent.type )
+	{
+	case PCET_BeginContact:		functionName = "OnBeginContact";	break;
+	case PCET_EndContact:		functionName = "OnEndContact";		break;
+	case PCET_BeginOverlap:		functionName = "OnBeginOverlap";	break;
+	case PCET_EndOverlap:		functionName = "OnEndOverlap";		break;
+	default:					functionName = "OnHit";				break;
+	}
+
+	if ( scriptRef->IsFunctionExist( functionName ) )
+	{
+		AActor*			otherActor = otherComponent ? otherComponent->GetOwner() : nullptr;
+		std::string		otherActorName = otherActor ? TCHAR_TO_ANSI( otherActor->GetName().c_str() ) : "";
+		const Vector	normal = bBodyA ? InEvent.normal : -InEvent.normal;
+		scriptRef->Execute( functionName, otherActorName, normal.x, normal.y, normal.z, InEvent.impulse );
+	}
+}
+
 /*
 ==================
 CPrimitiveComponent::IsVisibility
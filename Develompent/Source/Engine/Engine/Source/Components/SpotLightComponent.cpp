@@ -96,4 +96,30 @@ CSpotLightComponent::GetLightType
 ELightType CSpotLightComponent::GetLightType() const
 {
 	return LT_Spot;
+}
+
+/*
+==================
+CSpotLightComponent::GetBoundingSphere
+==================
+*/
+bool CSpotLightComponent::GetBoundingSphere( Vector& OutCenter, float& OutRadius ) const
+{
+	const CTransform&	transform	= GetComponentTransform();
+	Vector				direction	= transform.GetUnitAxis( A_Forward );
+
+	// For wide cones (half angle >= 45 degrees) the smallest sphere is centered at the base of the cone,
+	// otherwise it touches the apex and the base circle
+	if ( radius >= height )
+	{
+		OutCenter	= transform.GetLocation() + direction * height;
+		OutRadius	= radius;
+	}
+	else
+	{
+		const float		distanceToCenter = ( height * height + radius * radius ) / ( 2.f * height );
+		OutCenter	= transform.GetLocation() + direction * distanceToCenter;
+		OutRadius	= distanceToCenter;
+	}
+	return true;
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "Math/Rect.h"
 #include "Render/Shaders/BasePassShader.h"
 #include "Render/Texture.h"
+#include "Render/TextureStreaming.h"
 
 IMPLEMENT_CLASS( CSpriteComponent )
 IMPLEMENT_ENUM( ESpriteType, FOREACH_ENUM_SPRITETYPE )
@@ -26,6 +27,8 @@ CSpriteComponent::CSpriteComponent()
 #endif // WITH_EDITOR
 	  bFlipVertical( false )
 	, bFlipHorizontal( false )
+	, bBatched( false )
+	, spriteColor( CColor::white )
     , type( ST_Rotating )
 	, sprite( new CSprite() )
 {
@@ -43,6 +46,7 @@ void CSpriteComponent::StaticInitializeClass()
 	new( staticClass, TEXT( "bFlipHorizontal" ) )	CBoolProperty( TEXT( "Sprite" ), TEXT( "Is need flip sprite by horizontal" ), STRUCT_OFFSET( ThisClass, bFlipHorizontal ), CPF_Edit );
 	new( staticClass, TEXT( "Material" ) )			CAssetProperty( TEXT( "Disaply" ), TEXT( "Sprite material" ), STRUCT_OFFSET( ThisClass, material ), CPF_Edit, AT_Material );
 	new( staticClass, TEXT( "Type" ) )				CByteProperty( TEXT( "Sprite" ), TEXT( "Sprite type" ), STRUCT_OFFSET( ThisClass, type ), CPF_Edit, Enum::GetESpriteType() );
+	new( staticClass, TEXT( "Color" ) )				CColorProperty( TEXT( "Sprite" ), TEXT( "Sprite color" ), STRUCT_OFFSET( ThisClass, spriteColor ), CPF_Edit );
 }
 
 /*
@@ -65,6 +69,11 @@ void CSpriteComponent::Serialize( class CArchive& InArchive )
 	InArchive << bFlipVertical;
 	InArchive << bFlipHorizontal;
 
+	if ( InArchive.Ver() >= VER_SpriteColor )
+	{
+		InArchive << spriteColor;
+	}
+
     if ( InArchive.IsLoading() )
     {
         SetTextureRect( textureRect );
@@ -72,6 +81,7 @@ void CSpriteComponent::Serialize( class CArchive& InArchive )
         SetMaterial( material );
 		SetFlipVertical( bFlipVertical );
 		SetFlipHorizontal( bFlipHorizontal );
+		SetSpriteColor( spriteColor );
     }
 }
 
@@ -99,6 +109,10 @@ void CSpriteComponent::PostEditChangeProperty( const PropertyChangedEvenet& InPr
 		{
 			SetMaterial( material );
 		}
+		else if ( nameProperty == TEXT( "Color" ) )
+		{
+			SetSpriteColor( spriteColor );
+		}
 	}
 
 	Super::PostEditChangeProperty( InPropertyChangedEvenet );
@@ -171,11 +185,7 @@ void CSpriteComponent::LinkDrawList()
     Assert( scene );
 
 	// If the primitive already added to scene - remove all draw policy links
-	if ( drawingPolicyLink
-#if WITH_EDITOR
-		 || gizmoDrawingPolicyLink
-#endif // WITH_EDITOR
-		 )
+	if ( !meshBatchLinks.empty() )
 	{
 		UnlinkDrawList();
 	}
@@ -190,6 +200,7 @@ void CSpriteComponent::LinkDrawList()
 			SDG_World );
 		
 		SpriteSurface					surface = sprite->GetSurface();
+		bBatched						= IsBatchable();
 
 		// Generate mesh batch of sprite
 		MeshBatch			            meshBatch;
@@ -199,23 +210,26 @@ void CSpriteComponent::LinkDrawList()
 		meshBatch.indexBufferRHI        = sprite->GetIndexBufferRHI();
 		meshBatch.primitiveType         = PT_TriangleList;
 
-		// Make and add to scene new draw policy link
+		// Make and add to scene new draw policy link. Batched sprite is drawn by sprite batcher of SDG
 		const MeshBatch*				meshBatchLink = nullptr;
-#if WITH_EDITOR
-		if ( bGizmo )
+		if ( !bBatched )
 		{
-			gizmoDrawingPolicyLink		= ::MakeDrawingPolicyLink<GizmoDrawingPolicyLink_t>( sprite->GetVertexFactory(), sprite->GetMaterial(), meshBatch, meshBatchLink, SDG.gizmoDrawList, DEC_SPRITE );
-		}
-		else
+#if WITH_EDITOR
+			if ( bGizmo )
+			{
+				gizmoDrawingPolicyLink	= ::MakeDrawingPolicyLink<GizmoDrawingPolicyLink_t>( sprite->GetVertexFactory(), sprite->GetMaterial(), meshBatch, meshBatchLink, SDG.gizmoDrawList, DEC_SPRITE );
+			}
+			else
 #endif // WITH_EDITOR
-		{
-			drawingPolicyLink			= ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( sprite->GetVertexFactory(), sprite->GetMaterial(), meshBatch, meshBatchLink, SDG.spriteDrawList, DEC_SPRITE );
-		}
-		meshBatchLinks.push_back( meshBatchLink );
+			{
+				drawingPolicyLink		= ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( sprite->GetVertexFactory(), sprite->GetMaterial(), meshBatch, meshBatchLink, SDG.spriteDrawList, DEC_SPRITE );
+			}
+			meshBatchLinks.push_back( meshBatchLink );
 
-		// Make and add to the scene new depth draw policy link
-		depthDrawingPolicyLink			= ::MakeDrawingPolicyLink<DepthDrawingPolicyLink_t>( sprite->GetVertexFactory(), sprite->GetMaterial(), meshBatch, meshBatchLink, SDG.depthDrawList, DEC_SPRITE );
-		meshBatchLinks.push_back( meshBatchLink );
+			// Make and add to the scene new depth draw policy link
+			depthDrawingPolicyLink		= ::MakeDrawingPolicyLink<DepthDrawingPolicyLink_t>( sprite->GetVertexFactory(), sprite->GetMaterial(), meshBatch, meshBatchLink, SDG.depthDrawList, DEC_SPRITE );
+			meshBatchLinks.push_back( meshBatchLink );
+		}
 
 		// Make and add to scene new hit proxy draw policy link
 #if ENABLE_HITPROXY
@@ -260,6 +274,7 @@ void CSpriteComponent::UnlinkDrawList()
 #endif // ENABLE_HITPROXY
 
 	meshBatchLinks.clear();
+	bBatched = false;
 }
 
 /*
@@ -269,8 +284,14 @@ CSpriteComponent::AddToDrawList
 */
 void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView )
 {
+	// Sprite batching can be toggled at runtime, in this case drawing policy links must be recreated
+	if ( sprite && bBatched != IsBatchable() )
+	{
+		bIsDirtyDrawingPolicyLink = true;
+	}
+
 	// If primitive is empty - exit from method
-	if ( !bIsDirtyDrawingPolicyLink && meshBatchLinks.empty() )
+	if ( !bIsDirtyDrawingPolicyLink && meshBatchLinks.empty() && !bBatched )
 	{
 		return;
 	}
@@ -315,6 +336,25 @@ void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView )
 #endif // WITH_EDITOR
 	}
 
+	// Submit batched sprite to sprite batcher, it is built after all primitives of the view
+	if ( bBatched )
+	{
+		SpriteBatchElement		element;
+		element.material			= sprite->GetMaterial();
+		element.transformMatrix		= transformMatrix;
+		element.textureRect			= GetTextureRect();
+		element.spriteSize			= GetSpriteSize();
+		element.color				= spriteColor;
+		element.bFlipVertical		= bFlipVertical;
+		element.bFlipHorizontal		= bFlipHorizontal;
+
+#if WITH_EDITOR
+		element.bSelected			= owner ? owner->IsSelected() : false;
+#endif // WITH_EDITOR
+
+		scene->GetSDG( SDG_World ).spriteBatcher.AddSprite( element );
+	}
+
     // Update AABB
 	{
 		Vector			minLocation = Vector( -1.f, -1.f, 0.f ) * Vector( GetSpriteSize() / 2.f, 1.f );
@@ -365,6 +405,14 @@ void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView )
 		boundbox = CBox::BuildAABB( GetComponentLocation(), minLocation, maxLocation );
 	}
 
+	// Request mips of textures by size of sprite on screen
+	if ( g_TextureStreamingManager.IsEnabled() )
+	{
+		const Vector	sphereOrigin	= ( boundbox.GetMin() + boundbox.GetMax() ) * 0.5f;
+		const float		sphereRadius	= Math::LengthVector( boundbox.GetMax() - boundbox.GetMin() ) * 0.5f;
+		g_TextureStreamingManager.AddViewMaterial( material, InSceneView.GetScreenSize( sphereOrigin, sphereRadius ) * Max( InSceneView.GetSizeX(), InSceneView.GetSizeY() ) );
+	}
+
 	// Draw wireframe box if owner actor is selected (only for WorldEd)
 #if WITH_EDITOR
 	if ( !bGizmo && owner ? owner->IsSelected() : false )
@@ -4,15 +4,25 @@
 #include "Components/StaticMeshComponent.h"
 #include "Render/Scene.h"
 #include "Render/SceneUtils.h"
+#include "Render/TextureStreaming.h"
+#include "System/ConVar.h"
+#include "Misc/Stats.h"
 
 IMPLEMENT_CLASS( CStaticMeshComponent )
 
+/**
+ * @ingroup Engine
+ * @brief CVar bias of static mesh LOD
+ */
+CConVar		CVarRStaticMeshLODBias( TEXT( "r.StaticMeshLODBias" ), TEXT( "0" ), CVT_Int, TEXT( "Bias added to selected LOD of static meshes. Positive values select coarser LODs" ) );
+
 /*
 ==================
 CStaticMeshComponent::CStaticMeshComponent
 ==================
 */
 CStaticMeshComponent::CStaticMeshComponent()
+	: currentLOD( 0 )
 {}
 
 /*
@@ -161,23 +171,6 @@ void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
 
 	AActor*		owner = GetOwner();
 
-	// Add to mesh batch new instance
-	const Matrix				transformationMatrix = GetComponentTransform().ToMatrix();
-	for ( uint32 index = 0, count = elementDrawingPolicyLink->meshBatchLinks.size(); index < count; ++index )
-	{
-		const MeshBatch*		meshBatch = elementDrawingPolicyLink->meshBatchLinks[ index ];
-		++meshBatch->numInstances;
-		meshBatch->instances.push_back( MeshInstance{ transformationMatrix 
-#if ENABLE_HITPROXY
-										, owner ? owner->GetHitProxyId() : CHitProxyId()
-#endif // ENABLE_HITPROXY
-
-#if WITH_EDITOR
-										, owner? owner->IsSelected() : false
-#endif // WITH_EDITOR
-										} );
-	}
-
 	// Build AABB
 	TSharedPtr<CStaticMesh>		staticMeshRef = staticMesh.ToSharedPtr();
 	if ( staticMeshRef )
@@ -229,6 +222,44 @@ void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
 
 		boundbox = CBox::BuildAABB( GetComponentLocation(), minLocation, maxLocation );
 
+		// Select LOD by screen size of bounding sphere
+		const Vector	sphereOrigin	= ( boundbox.GetMin() + boundbox.GetMax() ) * 0.5f;
+		const float		sphereRadius	= Math::LengthVector( boundbox.GetMax() - boundbox.GetMin() ) * 0.5f;
+		const float		screenSize		= InSceneView.GetScreenSize( sphereOrigin, sphereRadius );
+		uint32			numLODs			= staticMeshRef->GetNumLODs();
+		currentLOD						= staticMeshRef->SelectLOD( screenSize, Min( currentLOD, numLODs - 1 ) );
+		uint32			lodIndex		= Clamp<int32>( ( int32 )currentLOD + CVarRStaticMeshLODBias.GetValueInt(), 0, numLODs - 1 );
+
+		g_StatSceneTrianglesBeforeLOD.Add( staticMeshRef->GetLOD( 0 ).GetNumPrimitives() );
+		g_StatSceneTrianglesAfterLOD.Add( staticMeshRef->GetLOD( lodIndex ).GetNumPrimitives() );
+
+		// Request mips of textures by size of mesh on screen
+		if ( g_TextureStreamingManager.IsEnabled() )
+		{
+			const float		screenPixelSize = screenSize * Max( InSceneView.GetSizeX(), InSceneView.GetSizeY() );
+			for ( uint32 index = 0, count = overrideMaterials.size(); index < count; ++index )
+			{
+				g_TextureStreamingManager.AddViewMaterial( GetMaterial( index ), screenPixelSize );
+			}
+		}
+
+		// Add to mesh batch of selected LOD new instance
+		const Matrix				transformationMatrix = GetComponentTransform().ToMatrix();
+		for ( uint32 index = 0, count = elementDrawingPolicyLink->meshBatchLinks[ lodIndex ].size(); index < count; ++index )
+		{
+			const MeshBatch*		meshBatch = elementDrawingPolicyLink->meshBatchLinks[ lodIndex ][ index ];
+			++meshBatch->numInstances;
+			meshBatch->instances.push_back( MeshInstance{ transformationMatrix 
+#if ENABLE_HITPROXY
+											, owner ? owner->GetHitProxyId() : CHitProxyId()
+#endif // ENABLE_HITPROXY
+
+#if WITH_EDITOR
+											, owner? owner->IsSelected() : false
+#endif // WITH_EDITOR
+											} );
+		}
+
 		// Draw wireframe box if owner actor is selected (only for WorldEd)
 #if WITH_EDITOR
 		if ( owner ? owner->IsSelected() : false )
@@ -0,0 +1,805 @@
+#include <algorithm>
+
+#include "Actors/Actor.h"
+#include "System/World.h"
+#include "Components/TileMapComponent.h"
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Misc/Stats.h"
+#include "Misc/Template.h"
+#include "Render/Scene.h"
+#include "Render/SceneUtils.h"
+#include "Render/TextureStreaming.h"
+
+IMPLEMENT_CLASS( CTileMapComponent )
+
+/*
+==================
+TransformBox
+==================
+*/
+static CBox TransformBox( const CBox& InBox, const Matrix& InMatrix )
+{
+	if ( !InBox.IsValid() )
+	{
+		return InBox;
+	}
+
+	const Vector&	boxMin = InBox.GetMin();
+	const Vector&	boxMax = InBox.GetMax();
+	Vector			minLocation;
+	Vector			maxLocation;
+	for ( uint32 index = 0; index < 8; ++index )
+	{
+		const Vector	corner( index & 1 ? boxMax.x : boxMin.x, index & 2 ? boxMax.y : boxMin.y, index & 4 ? boxMax.z : boxMin.z );
+		const Vector	vertex( InMatrix * Vector4D( corner, 1.f ) );
+		if ( index == 0 )
+		{
+			minLocation = maxLocation = vertex;
+			continue;
+		}
+
+		minLocation.x = Min( minLocation.x, vertex.x );
+		minLocation.y = Min( minLocation.y, vertex.y );
+		minLocation.z = Min( minLocation.z, vertex.z );
+		maxLocation.x = Max( maxLocation.x, vertex.x );
+		maxLocation.y = Max( maxLocation.y, vertex.y );
+		maxLocation.z = Max( maxLocation.z, vertex.z );
+	}
+
+	return CBox( minLocation, maxLocation );
+}
+
+/*
+==================
+CTileMapComponent::CTileMapComponent
+==================
+*/
+CTileMapComponent::CTileMapComponent()
+	: bPlaying( false )
+	, bDirtyMeshes( false )
+	, bDirtyCollisions( false )
+	, sizeX( 0 )
+	, sizeY( 0 )
+	, cellSize( 1.f, 1.f )
+	, collisionProfile( g_PhysicsEngine.FindCollisionProfile( CollisionProfile::blockAll_ProfileName ) )
+	, physicsMaterial( nullptr )
+{}
+
+/*
+==================
+CTileMapComponent::~CTileMapComponent
+==================
+*/
+CTileMapComponent::~CTileMapComponent()
+{
+	// Draw policy links must be removed here, because in destructor of CPrimitiveComponent our UnlinkDrawList isn't called
+	if ( scene )
+	{
+		scene->RemovePrimitive( this );
+	}
+
+	for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+	{
+		chunks[index].mesh->BeginRelease();
+	}
+}
+
+/*
+==================
+CTileMapComponent::StaticInitializeClass
+==================
+*/
+void CTileMapComponent::StaticInitializeClass()
+{
+	new( staticClass, TEXT( "Physics Material" ) )		CAssetProperty( TEXT( "Physics" ), TEXT( "Physics material of tiles collision" ), STRUCT_OFFSET( ThisClass, physicsMaterial ), CPF_Edit, AT_PhysicsMaterial );
+}
+
+/*
+==================
+CTileMapComponent::BeginPlay
+==================
+*/
+void CTileMapComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	if ( !physicsMaterial.IsAssetValid() )
+	{
+		physicsMaterial = g_PhysicsEngine.GetDefaultPhysMaterial();
+	}
+
+	// Collision of chunks is created only in play
+	bPlaying = true;
+	for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+	{
+		RebuildChunkCollision( index );
+	}
+	bDirtyCollisions = false;
+}
+
+/*
+==================
+CTileMapComponent::EndPlay
+==================
+*/
+void CTileMapComponent::EndPlay()
+{
+	Super::EndPlay();
+	TermChunksCollision();
+	bPlaying = false;
+}
+
+/*
+==================
+CTileMapComponent::TickComponent
+==================
+*/
+void CTileMapComponent::TickComponent( float InDeltaTime )
+{
+	Super::TickComponent( InDeltaTime );
+
+	// Rebuild collision of changed chunks
+	if ( bPlaying && bDirtyCollisions )
+	{
+		for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+		{
+			if ( chunks[index].bDirtyCollision )
+			{
+				RebuildChunkCollision( index );
+			}
+		}
+		bDirtyCollisions = false;
+	}
+}
+
+/*
+==================
+CTileMapComponent::Serialize
+==================
+*/
+void CTileMapComponent::Serialize( class CArchive& InArchive )
+{
+	Super::Serialize( InArchive );
+	InArchive << sizeX;
+	InArchive << sizeY;
+	InArchive << cellSize;
+	InArchive << palette;
+
+	uint32		numLayers = layers.size();
+	InArchive << numLayers;
+	if ( InArchive.IsLoading() )
+	{
+		layers.resize( numLayers );
+	}
+
+	// Grids of tiles are serialized by one block, it is much faster than serialize them by one element
+	for ( uint32 index = 0; index < numLayers; ++index )
+	{
+		TileMapLayer&	layer = layers[index];
+		InArchive << layer.bCollision;
+		InArchive << layer.depth;
+		if ( InArchive.IsLoading() )
+		{
+			layer.tiles.resize( sizeX * sizeY );
+		}
+		InArchive.Serialize( layer.tiles.data(), layer.tiles.size() * sizeof( uint16 ) );
+	}
+
+	InArchive << collisionProfile;
+	InArchive << physicsMaterial;
+
+	// Meshes of chunks are built right after loading, so they will be uploaded to GPU while level is loading
+	if ( InArchive.IsLoading() )
+	{
+		InitChunks();
+		for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+		{
+			RebuildChunkMesh( index );
+		}
+		UpdateLocalBoundBox();
+		bDirtyMeshes = false;
+	}
+}
+
+/*
+==================
+CTileMapComponent::SetMapSize
+==================
+*/
+void CTileMapComponent::SetMapSize( uint32 InSizeX, uint32 InSizeY, const Vector2D& InCellSize )
+{
+	sizeX		= InSizeX;
+	sizeY		= InSizeY;
+	cellSize	= InCellSize;
+	layers.clear();
+	InitChunks();
+}
+
+/*
+==================
+CTileMapComponent::AddLayer
+==================
+*/
+uint32 CTileMapComponent::AddLayer( float InDepth, bool InIsCollision /* = false */ )
+{
+	layers.push_back( TileMapLayer() );
+	TileMapLayer&	layer = layers.back();
+	layer.bCollision	= InIsCollision;
+	layer.depth			= InDepth;
+	layer.tiles.resize( sizeX * sizeY, TILEMAP_EMPTY_TILE );
+	return layers.size() - 1;
+}
+
+/*
+==================
+CTileMapComponent::AddTile
+==================
+*/
+uint16 CTileMapComponent::AddTile( const TileMapTile& InTile )
+{
+	for ( uint32 index = 0, count = palette.size(); index < count; ++index )
+	{
+		if ( palette[index] == InTile )
+		{
+			return index + 1;
+		}
+	}
+
+	AssertMsg( palette.size() < 0xFFFF, TEXT( "Palette of tile map is full" ) );
+	palette.push_back( InTile );
+	return palette.size();
+}
+
+/*
+==================
+CTileMapComponent::SetTile
+==================
+*/
+void CTileMapComponent::SetTile( uint32 InLayer, uint32 InX, uint32 InY, uint16 InTile )
+{
+	Assert( InLayer < layers.size() && InX < sizeX && InY < sizeY && InTile <= palette.size() );
+	TileMapLayer&	layer	= layers[InLayer];
+	uint16&			tile	= layer.tiles[InY * sizeX + InX];
+	if ( tile == InTile )
+	{
+		return;
+	}
+	tile = InTile;
+
+	// Only chunk with this cell is rebuilt
+	TileMapChunk&	chunk = chunks[( InY / TILEMAP_CHUNK_SIZE ) * GetNumChunksX() + InX / TILEMAP_CHUNK_SIZE];
+	chunk.bDirtyMesh	= true;
+	bDirtyMeshes		= true;
+	if ( layer.bCollision )
+	{
+		chunk.bDirtyCollision	= true;
+		bDirtyCollisions		= true;
+	}
+}
+
+/*
+==================
+CTileMapComponent::InitChunks
+==================
+*/
+void CTileMapComponent::InitChunks()
+{
+	// Remove old chunks
+	TermChunksCollision();
+	if ( scene )
+	{
+		UnlinkDrawList();
+	}
+
+	for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+	{
+		chunks[index].mesh->BeginRelease();
+	}
+	chunks.clear();
+
+	// Every chunk allocates own mesh in constructor
+	chunks.resize( GetNumChunksX() * GetNumChunksY() );
+	localBoundBox	= CBox();
+	boundbox		= CBox();
+	MarkDirtyAllChunks( true, true );
+}
+
+/*
+==================
+CTileMapComponent::MarkDirtyAllChunks
+==================
+*/
+void CTileMapComponent::MarkDirtyAllChunks( bool InIsMesh, bool InIsCollision )
+{
+	for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+	{
+		TileMapChunk&	chunk = chunks[index];
+		chunk.bDirtyMesh		|= InIsMesh;
+		chunk.bDirtyCollision	|= InIsCollision;
+	}
+	bDirtyMeshes		|= InIsMesh;
+	bDirtyCollisions	|= InIsCollision;
+}
+
+/*
+==================
+CTileMapComponent::RebuildChunkMesh
+==================
+*/
+void CTileMapComponent::RebuildChunkMesh( uint32 InChunkIndex )
+{
+	TileMapChunk&		chunk			= chunks[InChunkIndex];
+	const uint32		numChunksX		= GetNumChunksX();
+	const uint32		startX			= ( InChunkIndex % numChunksX ) * TILEMAP_CHUNK_SIZE;
+	const uint32		startY			= ( InChunkIndex / numChunksX ) * TILEMAP_CHUNK_SIZE;
+	const uint32		endX			= Min<uint32>( startX + TILEMAP_CHUNK_SIZE, sizeX );
+	const uint32		endY			= Min<uint32>( startY + TILEMAP_CHUNK_SIZE, sizeY );
+
+	std::vector<SpriteVertexType>		verteces;
+	std::vector<uint32>					indeces;
+	std::vector<TileMapChunkSurface>	surfaces;
+	std::vector<uint16>					surfaceTiles;
+	Vector								minLocation;
+	Vector								maxLocation;
+	bool								bEmpty = true;
+
+	// Surfaces are sorted by layers, so tiles of upper layer are drawn after lower
+	for ( uint32 indexLayer = 0, numLayers = layers.size(); indexLayer < numLayers; ++indexLayer )
+	{
+		const TileMapLayer&		layer = layers[indexLayer];
+
+		// Collect materials used in the layer of chunk
+		std::vector< TAssetHandle<CMaterial> >		materials;
+		for ( uint32 y = startY; y < endY; ++y )
+		{
+			for ( uint32 x = startX; x < endX; ++x )
+			{
+				const uint16	tile = layer.tiles[y * sizeX + x];
+				if ( tile != TILEMAP_EMPTY_TILE && std::find( materials.begin(), materials.end(), palette[tile - 1].material ) == materials.end() )
+				{
+					materials.push_back( palette[tile - 1].material );
+				}
+			}
+		}
+
+		// Bake tiles of every material to own surface
+		for ( uint32 indexMaterial = 0, numMaterials = materials.size(); indexMaterial < numMaterials; ++indexMaterial )
+		{
+			TileMapChunkSurface		surface;
+			surface.material		= materials[indexMaterial];
+			surface.firstIndex		= indeces.size();
+			surface.numPrimitives	= 0;
+			for ( uint32 y = startY; y < endY; ++y )
+			{
+				for ( uint32 x = startX; x < endX; ++x )
+				{
+					const uint16	tileIndex = layer.tiles[y * sizeX + x];
+					if ( tileIndex == TILEMAP_EMPTY_TILE || palette[tileIndex - 1].material != surface.material )
+					{
+						continue;
+					}
+
+					const TileMapTile&		tile		= palette[tileIndex - 1];
+					const RectFloat_t&		rect		= tile.textureRect;
+					const float				x0			= x * cellSize.x;
+					const float				y0			= y * cellSize.y;
+					const float				x1			= x0 + tile.size.x;
+					const float				y1			= y0 + tile.size.y;
+					const float				z			= layer.depth;
+					const uint32			baseIndex	= verteces.size();
+
+					//							POSITION						TEXCOORD												NORMAL
+					verteces.push_back( { Vector4D( x0, y0, z, 1.f ),	Vector2D( rect.left, rect.top + rect.height ),				Vector4D( 0.f, 1.f, 0.f, 0.f ) } );		// 0
+					verteces.push_back( { Vector4D( x0, y1, z, 1.f ),	Vector2D( rect.left, rect.top ),							Vector4D( 0.f, 1.f, 0.f, 0.f ) } );		// 1
+					verteces.push_back( { Vector4D( x1, y1, z, 1.f ),	Vector2D( rect.left + rect.width, rect.top ),				Vector4D( 0.f, 1.f, 0.f, 0.f ) } );		// 2
+					verteces.push_back( { Vector4D( x1, y0, z, 1.f ),	Vector2D( rect.left + rect.width, rect.top + rect.height ),	Vector4D( 0.f, 1.f, 0.f, 0.f ) } );		// 3
+
+					indeces.push_back( baseIndex );
+					indeces.push_back( baseIndex + 1 );
+					indeces.push_back( baseIndex + 2 );
+					indeces.push_back( baseIndex );
+					indeces.push_back( baseIndex + 2 );
+					indeces.push_back( baseIndex + 3 );
+					surface.numPrimitives += 2;
+
+					if ( bEmpty )
+					{
+						minLocation = Vector( x0, y0, z );
+						maxLocation = Vector( x1, y1, z );
+						bEmpty		= false;
+					}
+					else
+					{
+						minLocation = Vector( Min( minLocation.x, x0 ), Min( minLocation.y, y0 ), Min( minLocation.z, z ) );
+						maxLocation = Vector( Max( maxLocation.x, x1 ), Max( maxLocation.y, y1 ), Max( maxLocation.z, z ) );
+					}
+				}
+			}
+			surfaces.push_back( surface );
+		}
+	}
+
+	chunk.boundbox		= bEmpty ? CBox() : CBox( minLocation, maxLocation );
+	chunk.bDirtyMesh	= false;
+	chunk.bNeedLink		= !surfaces.empty();
+	chunk.mesh->SetData( verteces, indeces, surfaces );
+	g_StatSceneTileMapRebuiltChunks.Increment();
+}
+
+/*
+==================
+CTileMapComponent::RebuildChunkCollision
+==================
+*/
+void CTileMapComponent::RebuildChunkCollision( uint32 InChunkIndex )
+{
+	TileMapChunk&		chunk			= chunks[InChunkIndex];
+	const uint32		numChunksX		= GetNumChunksX();
+	const uint32		startX			= ( InChunkIndex % numChunksX ) * TILEMAP_CHUNK_SIZE;
+	const uint32		startY			= ( InChunkIndex / numChunksX ) * TILEMAP_CHUNK_SIZE;
+	const uint32		chunkSizeX		= Min<uint32>( startX + TILEMAP_CHUNK_SIZE, sizeX ) - startX;
+	const uint32		chunkSizeY		= Min<uint32>( startY + TILEMAP_CHUNK_SIZE, sizeY ) - startY;
+	chunk.bDirtyCollision = false;
+
+	if ( chunk.bodyInstance )
+	{
+		chunk.bodyInstance->TermBody();
+	}
+	chunk.bodySetup = nullptr;
+
+	// Mark cells which have tile at least in one layer with collision
+	bool		bHasCollision = false;
+	bool		cells[TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE];
+	Sys_Memzero( cells, sizeof( cells ) );
+	for ( uint32 indexLayer = 0, numLayers = layers.size(); indexLayer < numLayers; ++indexLayer )
+	{
+		const TileMapLayer&		layer = layers[indexLayer];
+		if ( !layer.bCollision )
+		{
+			continue;
+		}
+
+		for ( uint32 y = 0; y < chunkSizeY; ++y )
+		{
+			for ( uint32 x = 0; x < chunkSizeX; ++x )
+			{
+				if ( layer.tiles[( startY + y ) * sizeX + startX + x] != TILEMAP_EMPTY_TILE )
+				{
+					cells[y * TILEMAP_CHUNK_SIZE + x]	= true;
+					bHasCollision						= true;
+				}
+			}
+		}
+	}
+
+	if ( !bHasCollision )
+	{
+		return;
+	}
+
+	// Merge cells greedy: row of cells is grown by X, then it is grown by Y while all cells under it are filled
+	chunk.bodySetup = new CPhysicsBodySetup();
+	for ( uint32 y = 0; y < chunkSizeY; ++y )
+	{
+		for ( uint32 x = 0; x < chunkSizeX; ++x )
+		{
+			if ( !cells[y * TILEMAP_CHUNK_SIZE + x] )
+			{
+				continue;
+			}
+
+			uint32		boxSizeX = 1;
+			while ( x + boxSizeX < chunkSizeX && cells[y * TILEMAP_CHUNK_SIZE + x + boxSizeX] )
+			{
+				++boxSizeX;
+			}
+
+			uint32		boxSizeY = 1;
+			for ( ; y + boxSizeY < chunkSizeY; ++boxSizeY )
+			{
+				bool	bFilledRow = true;
+				for ( uint32 indexX = x; indexX < x + boxSizeX && bFilledRow; ++indexX )
+				{
+					bFilledRow = cells[( y + boxSizeY ) * TILEMAP_CHUNK_SIZE + indexX];
+				}
+
+				if ( !bFilledRow )
+				{
+					break;
+				}
+			}
+
+			for ( uint32 indexY = y; indexY < y + boxSizeY; ++indexY )
+			{
+				for ( uint32 indexX = x; indexX < x + boxSizeX; ++indexX )
+				{
+					cells[indexY * TILEMAP_CHUNK_SIZE + indexX] = false;
+				}
+			}
+
+			PhysicsBoxGeometry				boxGeometry( boxSizeX * cellSize.x, boxSizeY * cellSize.y, 1.f );
+			boxGeometry.location			= Vector( ( startX + x ) * cellSize.x, ( startY + y ) * cellSize.y, 0.f );
+			boxGeometry.collisionProfile	= collisionProfile;
+			boxGeometry.material			= physicsMaterial;
+			chunk.bodySetup->AddBoxGeometry( boxGeometry );
+		}
+	}
+
+	if ( !chunk.bodyInstance )
+	{
+		chunk.bodyInstance = MakeSharedPtr<CPhysicsBodyInstance>();
+	}
+	chunk.bodyInstance->SetDynamic( false );
+	chunk.bodyInstance->SetSimulatePhysics( true );
+	chunk.bodyInstance->InitBody( chunk.bodySetup, GetComponentTransform(), this );
+}
+
+/*
+==================
+CTileMapComponent::TermChunksCollision
+==================
+*/
+void CTileMapComponent::TermChunksCollision()
+{
+	for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+	{
+		TileMapChunk&	chunk = chunks[index];
+		if ( chunk.bodyInstance )
+		{
+			chunk.bodyInstance->TermBody();
+		}
+		chunk.bodySetup			= nullptr;
+		chunk.bDirtyCollision	= true;
+	}
+	bDirtyCollisions = !chunks.empty();
+}
+
+/*
+==================
+CTileMapComponent::UpdateLocalBoundBox
+==================
+*/
+void CTileMapComponent::UpdateLocalBoundBox()
+{
+	localBoundBox = CBox();
+	for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+	{
+		const CBox&		chunkBox = chunks[index].boundbox;
+		if ( !chunkBox.IsValid() )
+		{
+			continue;
+		}
+
+		if ( !localBoundBox.IsValid() )
+		{
+			localBoundBox = chunkBox;
+			continue;
+		}
+
+		const Vector&	minLocation = localBoundBox.GetMin();
+		const Vector&	maxLocation = localBoundBox.GetMax();
+		localBoundBox = CBox( Vector( Min( minLocation.x, chunkBox.GetMin().x ), Min( minLocation.y, chunkBox.GetMin().y ), Min( minLocation.z, chunkBox.GetMin().z ) ),
+							  Vector( Max( maxLocation.x, chunkBox.GetMax().x ), Max( maxLocation.y, chunkBox.GetMax().y ), Max( maxLocation.z, chunkBox.GetMax().z ) ) );
+	}
+}
+
+/*
+==================
+CTileMapComponent::LinkDrawList
+==================
+*/
+void CTileMapComponent::LinkDrawList()
+{
+	Assert( scene );
+	for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+	{
+		TileMapChunk&	chunk = chunks[index];
+		UnlinkChunk( chunk );
+		chunk.bNeedLink = !chunk.mesh->GetSurfaces().empty();
+	}
+}
+
+/*
+==================
+CTileMapComponent::UnlinkDrawList
+==================
+*/
+void CTileMapComponent::UnlinkDrawList()
+{
+	Assert( scene );
+	for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+	{
+		UnlinkChunk( chunks[index] );
+	}
+}
+
+/*
+==================
+CTileMapComponent::LinkChunk
+==================
+*/
+void CTileMapComponent::LinkChunk( TileMapChunk& InOutChunk )
+{
+	Assert( scene && InOutChunk.mesh->IsReady() );
+	UnlinkChunk( InOutChunk );
+	InOutChunk.bNeedLink = false;
+
+	SceneDepthGroup&							SDG			= scene->GetSDG( SDG_World );
+	const std::vector<TileMapChunkSurface>&		surfaces	= InOutChunk.mesh->GetSurfaces();
+	CSpriteVertexFactory*						vertexFactory = InOutChunk.mesh->GetVertexFactory();
+	for ( uint32 index = 0, count = surfaces.size(); index < count; ++index )
+	{
+		const TileMapChunkSurface&		surface = surfaces[index];
+
+		// Generate mesh batch of surface
+		MeshBatch			            meshBatch;
+		meshBatch.baseVertexIndex       = 0;
+		meshBatch.firstIndex            = surface.firstIndex;
+		meshBatch.numPrimitives         = surface.numPrimitives;
+		meshBatch.indexBufferRHI        = InOutChunk.mesh->GetIndexBufferRHI();
+		meshBatch.primitiveType         = PT_TriangleList;
+
+		// Make and add to scene new draw policy links
+		const MeshBatch*				meshBatchLink = nullptr;
+		InOutChunk.drawingPolicyLinks.push_back( ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( vertexFactory, surface.material, meshBatch, meshBatchLink, SDG.spriteDrawList, DEC_SPRITE ) );
+		InOutChunk.meshBatchLinks.push_back( meshBatchLink );
+
+		InOutChunk.depthDrawingPolicyLinks.push_back( ::MakeDrawingPolicyLink<DepthDrawingPolicyLink_t>( vertexFactory, surface.material, meshBatch, meshBatchLink, SDG.depthDrawList, DEC_SPRITE ) );
+		InOutChunk.meshBatchLinks.push_back( meshBatchLink );
+
+#if ENABLE_HITPROXY
+		InOutChunk.hitProxyDrawingPolicyLinks.push_back( ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( vertexFactory, surface.material, meshBatch, meshBatchLink, SDG.hitProxyLayers[HPL_World].hitProxyDrawList, DEC_SPRITE ) );
+		InOutChunk.meshBatchLinks.push_back( meshBatchLink );
+#endif // ENABLE_HITPROXY
+	}
+}
+
+/*
+==================
+CTileMapComponent::UnlinkChunk
+==================
+*/
+void CTileMapComponent::UnlinkChunk( TileMapChunk& InOutChunk )
+{
+	Assert( scene );
+	SceneDepthGroup&		SDGWorld = scene->GetSDG( SDG_World );
+	for ( uint32 index = 0, count = InOutChunk.drawingPolicyLinks.size(); index < count; ++index )
+	{
+		SDGWorld.spriteDrawList.RemoveItem( InOutChunk.drawingPolicyLinks[index] );
+	}
+
+	for ( uint32 index = 0, count = InOutChunk.depthDrawingPolicyLinks.size(); index < count; ++index )
+	{
+		SDGWorld.depthDrawList.RemoveItem( InOutChunk.depthDrawingPolicyLinks[index] );
+	}
+
+#if ENABLE_HITPROXY
+	for ( uint32 index = 0, count = InOutChunk.hitProxyDrawingPolicyLinks.size(); index < count; ++index )
+	{
+		SDGWorld.hitProxyLayers[HPL_World].hitProxyDrawList.RemoveItem( InOutChunk.hitProxyDrawingPolicyLinks[index] );
+	}
+	InOutChunk.hitProxyDrawingPolicyLinks.clear();
+#endif // ENABLE_HITPROXY
+
+	InOutChunk.drawingPolicyLinks.clear();
+	InOutChunk.depthDrawingPolicyLinks.clear();
+	InOutChunk.meshBatchLinks.clear();
+}
+
+/*
+==================
+CTileMapComponent::AddToDrawList
+==================
+*/
+void CTileMapComponent::AddToDrawList( const class CSceneView& InSceneView )
+{
+	// If drawing policy link is dirty - we update it
+	if ( bIsDirtyDrawingPolicyLink )
+	{
+		bIsDirtyDrawingPolicyLink = false;
+		LinkDrawList();
+	}
+
+	// Rebuild changed chunks. If GPU upload of previous data of chunk isn't finished, chunk will be rebuilt on next frame
+	if ( bDirtyMeshes )
+	{
+		bDirtyMeshes = false;
+		for ( uint32 index = 0, count = chunks.size(); index < count; ++index )
+		{
+			TileMapChunk&	chunk = chunks[index];
+			if ( !chunk.bDirtyMesh )
+			{
+				continue;
+			}
+
+			if ( !chunk.mesh->IsReady() )
+			{
+				bDirtyMeshes = true;
+				continue;
+			}
+
+			UnlinkChunk( chunk );
+			RebuildChunkMesh( index );
+		}
+		UpdateLocalBoundBox();
+	}
+
+	// Calculate transform matrix
+	ActorRef_t		owner			= GetOwner();
+	const bool		bStreaming		= g_TextureStreamingManager.IsEnabled();
+	const float		viewSize		= Max( InSceneView.GetSizeX(), InSceneView.GetSizeY() );
+	const CFrustum&	frustum			= InSceneView.GetFrustum();
+	Matrix			transformMatrix;
+	GetComponentTransform().ToMatrix( transformMatrix );
+
+	// Add to mesh batches new instance only for visible chunks
+	uint32			numVisibleChunks	= 0;
+	uint32			numCulledChunks		= 0;
+	for ( uint32 indexChunk = 0, countChunks = chunks.size(); indexChunk < countChunks; ++indexChunk )
+	{
+		TileMapChunk&	chunk = chunks[indexChunk];
+		if ( chunk.bNeedLink && chunk.mesh->IsReady() )
+		{
+			LinkChunk( chunk );
+		}
+
+		if ( chunk.meshBatchLinks.empty() )
+		{
+			continue;
+		}
+
+		const CBox		chunkBox = TransformBox( chunk.boundbox, transformMatrix );
+		if ( !frustum.IsIn( chunkBox ) )
+		{
+			++numCulledChunks;
+			continue;
+		}
+		++numVisibleChunks;
+
+		for ( uint32 index = 0, count = chunk.meshBatchLinks.size(); index < count; ++index )
+		{
+			const MeshBatch*	meshBatchLink = chunk.meshBatchLinks[index];
+			++meshBatchLink->numInstances;
+			meshBatchLink->instances.resize( meshBatchLink->numInstances );
+
+			MeshInstance&		instanceMesh = meshBatchLink->instances[meshBatchLink->numInstances - 1];
+			instanceMesh.transformMatrix	= transformMatrix;
+
+#if ENABLE_HITPROXY
+			instanceMesh.hitProxyId			= owner ? owner->GetHitProxyId() : CHitProxyId();
+#endif // ENABLE_HITPROXY
+
+#if WITH_EDITOR
+			instanceMesh.bSelected			= owner ? owner->IsSelected() : false;
+#endif // WITH_EDITOR
+		}
+
+		// Request mips of textures by size of chunk on screen
+		if ( bStreaming )
+		{
+			const Vector	sphereOrigin	= ( chunkBox.GetMin() + chunkBox.GetMax() ) * 0.5f;
+			const float		sphereRadius	= Math::LengthVector( chunkBox.GetMax() - chunkBox.GetMin() ) * 0.5f;
+			const float		screenSize		= InSceneView.GetScreenSize( sphereOrigin, sphereRadius ) * viewSize;
+
+			const std::vector<TileMapChunkSurface>&		surfaces = chunk.mesh->GetSurfaces();
+			for ( uint32 index = 0, count = surfaces.size(); index < count; ++index )
+			{
+				g_TextureStreamingManager.AddViewMaterial( surfaces[index].material, screenSize );
+			}
+		}
+	}
+
+	g_StatSceneTileMapVisibleChunks.Add( numVisibleChunks );
+	g_StatSceneTileMapCulledChunks.Add( numCulledChunks );
+
+	// Update AABB
+	boundbox = TransformBox( localBoundBox, transformMatrix );
+
+	// Draw wireframe box if owner actor is selected (only for WorldEd)
+#if WITH_EDITOR
+	if ( owner && owner->IsSelected() && boundbox.IsValid() )
+	{
+		DrawWireframeBox( ( ( CScene* )g_World->GetScene() )->GetSDG( SDG_WorldEdForeground ), boundbox, DEC_SPRITE );
+	}
+#endif // WITH_EDITOR
+}
\ No newline at end of file
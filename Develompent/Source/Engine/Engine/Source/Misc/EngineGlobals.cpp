@@ -5,6 +5,7 @@
 #include "System/World.h"
 #include "System/CameraManager.h"
 #include "System/ConsoleSystem.h"
+#include "Misc/Stats.h"
 
 // -------------
 // GLOBALS
@@ -27,3 +28,4 @@ bool														g_AllowDebugShaderDump = false;
 
 class CFullScreenMovieSupport*								g_FullScreenMovie = nullptr;
 CConsoleSystem												g_ConsoleSystem;
+CStatManager												g_StatManager;
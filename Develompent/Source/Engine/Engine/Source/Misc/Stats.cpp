@@ -0,0 +1,419 @@
+#include <time.h>
+
+#include "Misc/Stats.h"
+#include "Misc/EngineGlobals.h"
+#include "Misc/Misc.h"
+#include "Containers/String.h"
+#include "Containers/StringConv.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Archive.h"
+#include "System/BaseFileSystem.h"
+#include "System/ConCmd.h"
+
+//
+// GLOBALS
+//
+CConCmd			CCmdStat( TEXT( "stat" ), TEXT( "Show frame statistics. Usage: stat <fps|scene|rhi|memory|streaming|physics|none|dump|csv start [file]|csv stop>" ), std::bind( &CStatManager::CmdStat, std::placeholders::_1 ) );
+
+CStatCounter	g_StatScenePrimitives( TEXT( "Primitives" ), SG_Scene );
+CStatCounter	g_StatSceneVisiblePrimitives( TEXT( "Visible primitives" ), SG_Scene );
+CStatCounter	g_StatSceneCulledPrimitives( TEXT( "Culled primitives" ), SG_Scene );
+CStatCounter	g_StatSceneVisibleLights( TEXT( "Visible lights" ), SG_Scene );
+CStatCounter	g_StatSceneCulledLights( TEXT( "Culled lights" ), SG_Scene );
+CStatCounter	g_StatSceneDrawingPolicies( TEXT( "Drawing policies" ), SG_Scene );
+CStatCounter	g_StatSceneMeshBatches( TEXT( "Mesh batches" ), SG_Scene );
+CStatCounter	g_StatSceneBatchedInstances( TEXT( "Batched instances" ), SG_Scene );
+CStatCounter	g_StatSceneStateChanges( TEXT( "State changes" ), SG_Scene );
+CStatCounter	g_StatSceneSkippedStateChanges( TEXT( "Skipped state changes" ), SG_Scene );
+CStatCounter	g_StatSceneTrianglesBeforeLOD( TEXT( "Triangles before LOD" ), SG_Scene );
+CStatCounter	g_StatSceneTrianglesAfterLOD( TEXT( "Triangles after LOD" ), SG_Scene );
+CStatCounter	g_StatSceneTileMapVisibleChunks( TEXT( "Visible tile map chunks" ), SG_Scene );
+CStatCounter	g_StatSceneTileMapCulledChunks( TEXT( "Culled tile map chunks" ), SG_Scene );
+CStatCounter	g_StatSceneTileMapRebuiltChunks( TEXT( "Rebuilt tile map chunks" ), SG_Scene );
+CStatCounter	g_StatSceneBatchedSprites( TEXT( "Batched sprites" ), SG_Scene );
+CStatCounter	g_StatSceneSpriteBatches( TEXT( "Sprite batch draws" ), SG_Scene );
+
+CStatCounter	g_StatRHIDrawCalls( TEXT( "Draw calls" ), SG_RHI );
+CStatCounter	g_StatRHIPrimitives( TEXT( "Primitives drawn" ), SG_RHI );
+CStatCounter	g_StatRHIUploadedBytes( TEXT( "Uploaded bytes" ), SG_RHI );
+CStatCounter	g_StatRHIRenderCommands( TEXT( "Render commands" ), SG_RHI );
+CStatCounter	g_StatRHIRenderCommandBytes( TEXT( "Render command bytes" ), SG_RHI );
+CStatCounter	g_StatRHIRenderCommandBufferSize( TEXT( "Render command buffer bytes" ), SG_RHI, SCT_Accumulator );
+CStatCounter	g_StatRHIRenderCommandBufferHighWater( TEXT( "Render command buffer high water bytes" ), SG_RHI, SCT_Accumulator );
+CStatCounter	g_StatRHIRenderCommandBufferStalls( TEXT( "Render command buffer stalls" ), SG_RHI );
+CStatCounter	g_StatRHIRenderCommandBufferStallTime( TEXT( "Render command buffer stall us" ), SG_RHI );
+CStatCounter	g_StatRHIUploadRingBytes( TEXT( "Upload ring bytes" ), SG_RHI );
+CStatCounter	g_StatRHIUploadRingWraps( TEXT( "Upload ring wraps" ), SG_RHI );
+CStatCounter	g_StatRHIUploadRingDiscards( TEXT( "Upload ring discards" ), SG_RHI );
+
+CStatCounter	g_StatMemoryPhysical( TEXT( "Process physical bytes" ), SG_Memory, SCT_Accumulator );
+CStatCounter	g_StatMemoryPeakPhysical( TEXT( "Process peak physical bytes" ), SG_Memory, SCT_Accumulator );
+CStatCounter	g_StatMemoryVertexBuffers( TEXT( "Vertex buffer bytes" ), SG_Memory, SCT_Accumulator );
+CStatCounter	g_StatMemoryIndexBuffers( TEXT( "Index buffer bytes" ), SG_Memory, SCT_Accumulator );
+CStatCounter	g_StatMemoryTextures( TEXT( "Texture bytes" ), SG_Memory, SCT_Accumulator );
+
+CStatCounter	g_StatStreamingTextures( TEXT( "Streaming textures" ), SG_Streaming, SCT_Accumulator );
+CStatCounter	g_StatStreamingPoolBytes( TEXT( "Texture pool bytes" ), SG_Streaming, SCT_Accumulator );
+CStatCounter	g_StatStreamingPoolBudget( TEXT( "Texture pool budget bytes" ), SG_Streaming, SCT_Accumulator );
+CStatCounter	g_StatStreamingPendingRequests( TEXT( "Pending requests" ), SG_Streaming, SCT_Accumulator );
+CStatCounter	g_StatStreamingWantedMips( TEXT( "Wanted mips" ), SG_Streaming, SCT_Accumulator );
+CStatCounter	g_StatStreamingResidentMips( TEXT( "Resident mips" ), SG_Streaming, SCT_Accumulator );
+CStatCounter	g_StatStreamingStreamedMips( TEXT( "Streamed in mips" ), SG_Streaming );
+CStatCounter	g_StatStreamingEvictedMips( TEXT( "Evicted mips" ), SG_Streaming );
+
+CStatCounter	g_StatPhysicsSteps( TEXT( "Physics steps" ), SG_Physics );
+CStatCounter	g_StatPhysicsDroppedSteps( TEXT( "Dropped physics steps" ), SG_Physics );
+CStatCounter	g_StatPhysicsSimulateTime( TEXT( "Physics simulate us" ), SG_Physics );
+CStatCounter	g_StatPhysicsWaitTime( TEXT( "Physics wait us" ), SG_Physics );
+CStatCounter	g_StatPhysicsSyncTime( TEXT( "Physics sync us" ), SG_Physics );
+CStatCounter	g_StatPhysicsQueries( TEXT( "Scene queries" ), SG_Physics );
+CStatCounter	g_StatPhysicsBodies( TEXT( "Bodies" ), SG_Physics );
+CStatCounter	g_StatPhysicsActiveBodies( TEXT( "Synced bodies" ), SG_Physics );
+CStatCounter	g_StatPhysicsBodySetups( TEXT( "Shared body setups" ), SG_Physics );
+CStatCounter	g_StatPhysicsAwakeBodies( TEXT( "Awake bodies" ), SG_Physics );
+CStatCounter	g_StatPhysicsContacts( TEXT( "Contacts" ), SG_Physics );
+CStatCounter	g_StatPhysicsCollideTime( TEXT( "Physics collide us" ), SG_Physics );
+CStatCounter	g_StatPhysicsSolveTime( TEXT( "Physics solve us" ), SG_Physics );
+CStatCounter	g_StatPhysicsCCDTime( TEXT( "Physics CCD us" ), SG_Physics );
+CStatCounter	g_StatPhysicsBroadphaseTime( TEXT( "Physics broadphase us" ), SG_Physics );
+CStatCounter	g_StatPhysicsContactEvents( TEXT( "Contact events" ), SG_Physics );
+CStatCounter	g_StatPhysicsCoalescedContactEvents( TEXT( "Coalesced contact events" ), SG_Physics );
+CStatCounter	g_StatPhysicsDroppedContactEvents( TEXT( "Dropped contact events" ), SG_Physics );
+
+/*
+==================
+CStatCounter::CStatCounter
+==================
+*/
+CStatCounter::CStatCounter( const tchar* InName, EStatGroup InGroup, EStatCounterType InType /* = SCT_Frame */ )
+	: name( InName )
+	, group( InGroup )
+	, type( InType )
+	, value( 0 )
+	, lastValue( 0 )
+	, historyIndex( 0 )
+	, numHistory( 0 )
+	, average( 0.0 )
+	, maxValue( 0 )
+{
+	memset( history, 0, sizeof( history ) );
+	GetGlobalStatCounters().push_back( this );
+}
+
+/*
+==================
+CStatCounter::~CStatCounter
+==================
+*/
+CStatCounter::~CStatCounter()
+{
+	std::vector<CStatCounter*>&		counters = GetGlobalStatCounters();
+	for ( uint32 index = 0, count = counters.size(); index < count; ++index )
+	{
+		if ( counters[index] == this )
+		{
+			counters.erase( counters.begin() + index );
+			break;
+		}
+	}
+}
+
+/*
+==================
+CStatCounter::AdvanceFrame
+==================
+*/
+void CStatCounter::AdvanceFrame()
+{
+	// Frame counters is reset to zero, accumulators keep their value
+	lastValue = type == SCT_Frame ? Sys_InterlockedExchange64( &value, 0 ) : value;
+
+	history[historyIndex]	= lastValue;
+	historyIndex			= ( historyIndex + 1 ) % numHistoryFrames;
+	numHistory				= Min( numHistory + 1, numHistoryFrames );
+
+	// Update rolling average and max
+	int64		sum = 0;
+	maxValue = history[0];
+	for ( uint32 index = 0; index < numHistory; ++index )
+	{
+		sum			+= history[index];
+		maxValue	= Max( maxValue, history[index] );
+	}
+	average = ( double )sum / numHistory;
+}
+
+/*
+==================
+CStatManager::CStatManager
+==================
+*/
+CStatManager::CStatManager()
+	: frameTimeIndex( 0 )
+	, numFrameTimes( 0 )
+	, averageFrameTime( 0.0 )
+	, minFrameTime( 0.0 )
+	, maxFrameTime( 0.0 )
+	, timeToLog( 0.0 )
+	, frameNumber( 0 )
+	, csvArchive( nullptr )
+{
+	memset( frameTimes, 0, sizeof( frameTimes ) );
+	HideAll();
+}
+
+/*
+==================
+CStatManager::~CStatManager
+==================
+*/
+CStatManager::~CStatManager()
+{
+	StopCSV();
+}
+
+/*
+==================
+CStatManager::AdvanceFrame
+==================
+*/
+void CStatManager::AdvanceFrame( double InDeltaSeconds )
+{
+	++frameNumber;
+
+	// Update history of frame times
+	frameTimes[frameTimeIndex]	= InDeltaSeconds;
+	frameTimeIndex				= ( frameTimeIndex + 1 ) % CStatCounter::numHistoryFrames;
+	numFrameTimes				= Min( numFrameTimes + 1, CStatCounter::numHistoryFrames );
+
+	double		sumFrameTime = 0.0;
+	minFrameTime = maxFrameTime = frameTimes[0];
+	for ( uint32 index = 0; index < numFrameTimes; ++index )
+	{
+		sumFrameTime	+= frameTimes[index];
+		minFrameTime	= Min( minFrameTime, frameTimes[index] );
+		maxFrameTime	= Max( maxFrameTime, frameTimes[index] );
+	}
+	averageFrameTime = sumFrameTime / numFrameTimes;
+
+	// Sample process memory only when somebody look at it
+	if ( bGroupVisible[SG_Memory] || csvArchive )
+	{
+		uint64		usedPhysical		= 0;
+		uint64		peakUsedPhysical	= 0;
+		Sys_GetProcessMemoryStats( usedPhysical, peakUsedPhysical );
+		g_StatMemoryPhysical.Set( usedPhysical );
+		g_StatMemoryPeakPhysical.Set( peakUsedPhysical );
+	}
+
+	// Close frame of all counters
+	std::vector<CStatCounter*>&		counters = GetGlobalStatCounters();
+	for ( uint32 index = 0, count = counters.size(); index < count; ++index )
+	{
+		counters[index]->AdvanceFrame();
+	}
+
+	if ( csvArchive )
+	{
+		WriteCSVRow( InDeltaSeconds );
+	}
+
+#if !WITH_IMGUI
+	// Without ImGUI we can't show stats on screen, so print visible groups to log once per second
+	if ( IsAnyGroupVisible() )
+	{
+		timeToLog -= InDeltaSeconds;
+		if ( timeToLog <= 0.0 )
+		{
+			timeToLog = 1.0;
+			for ( uint32 index = 0; index < SG_Num; ++index )
+			{
+				if ( bGroupVisible[index] )
+				{
+					DumpToLog( ( EStatGroup )index );
+				}
+			}
+		}
+	}
+#endif // !WITH_IMGUI
+}
+
+/*
+==================
+CStatManager::StartCSV
+==================
+*/
+bool CStatManager::StartCSV( const std::wstring& InPath /* = TEXT( "" ) */ )
+{
+	StopCSV();
+
+	std::wstring		path = InPath;
+	if ( path.empty() )
+	{
+		time_t		timeNow = time( nullptr );
+		tm*			tmTimeNow = localtime( &timeNow );
+		g_FileSystem->MakeDirectory( Sys_GameDir() + TEXT( "Profiling" ), true );
+		path = CString::Format( TEXT( "%sProfiling/Stats-%i.%02i.%02i-%02i.%02i.%02i.csv" ), Sys_GameDir().c_str(), 1900 + tmTimeNow->tm_year, 1 + tmTimeNow->tm_mon, tmTimeNow->tm_mday, tmTimeNow->tm_hour, tmTimeNow->tm_min, tmTimeNow->tm_sec );
+	}
+
+	csvArchive = g_FileSystem->CreateFileWriter( path, AW_None );
+	if ( !csvArchive )
+	{
+		Warnf( TEXT( "Failed to open '%s' for dump stats\n" ), path.c_str() );
+		return false;
+	}
+	csvArchive->SetType( AT_TextFile );
+
+	// Write header
+	std::string						header = "Frame,FrameTimeMs";
+	std::vector<CStatCounter*>&		counters = GetGlobalStatCounters();
+	for ( uint32 index = 0, count = counters.size(); index < count; ++index )
+	{
+		header += ",";
+		header += TCHAR_TO_ANSI( counters[index]->GetName() );
+	}
+	header += "\n";
+	*csvArchive << header;
+
+	Logf( TEXT( "Started dump stats to '%s'\n" ), path.c_str() );
+	return true;
+}
+
+/*
+==================
+CStatManager::StopCSV
+==================
+*/
+void CStatManager::StopCSV()
+{
+	if ( csvArchive )
+	{
+		csvArchive->Flush();
+		delete csvArchive;
+		csvArchive = nullptr;
+	}
+}
+
+/*
+==================
+CStatManager::WriteCSVRow
+==================
+*/
+void CStatManager::WriteCSVRow( double InDeltaSeconds )
+{
+	Assert( csvArchive );
+	std::string						row = std::to_string( frameNumber ) + "," + std::to_string( InDeltaSeconds * 1000.0 );
+	std::vector<CStatCounter*>&		counters = GetGlobalStatCounters();
+	for ( uint32 index = 0, count = counters.size(); index < count; ++index )
+	{
+		row += ",";
+		row += std::to_string( counters[index]->GetLastValue() );
+	}
+	row += "\n";
+	*csvArchive << row;
+}
+
+/*
+==================
+CStatManager::DumpToLog
+==================
+*/
+void CStatManager::DumpToLog( EStatGroup InGroup /* = SG_Num */ ) const
+{
+	if ( InGroup == SG_Num || InGroup == SG_FPS )
+	{
+		Logf( TEXT( "--- Stat %s ---\n" ), GetGroupName( SG_FPS ) );
+		Logf( TEXT( "FPS: %.1f (%.2f ms, min %.2f ms, max %.2f ms)\n" ), averageFrameTime > 0.0 ? 1.0 / averageFrameTime : 0.0, averageFrameTime * 1000.0, minFrameTime * 1000.0, maxFrameTime * 1000.0 );
+	}
+
+	const std::vector<CStatCounter*>&		counters = GetGlobalStatCounters();
+	for ( uint32 group = SG_Scene; group < SG_Num; ++group )
+	{
+		if ( InGroup != SG_Num && InGroup != group )
+		{
+			continue;
+		}
+
+		Logf( TEXT( "--- Stat %s ---\n" ), GetGroupName( ( EStatGroup )group ) );
+		for ( uint32 index = 0, count = counters.size(); index < count; ++index )
+		{
+			const CStatCounter*		counter = counters[index];
+			if ( counter->GetGroup() == group )
+			{
+				Logf( TEXT( "%s: %lld (avg %.1f, max %lld)\n" ), counter->GetName(), counter->GetLastValue(), counter->GetAverage(), counter->GetMax() );
+			}
+		}
+	}
+}
+
+/*
+==================
+CStatManager::GetGroupName
+==================
+*/
+const tchar* CStatManager::GetGroupName( EStatGroup InGroup )
+{
+	switch ( InGroup )
+	{
+	case SG_FPS:		return TEXT( "FPS" );
+	case SG_Scene:		return TEXT( "Scene" );
+	case SG_RHI:		return TEXT( "RHI" );
+	case SG_Memory:		return TEXT( "Memory" );
+	case SG_Streaming:	return TEXT( "Streaming" );
+	case SG_Physics:	return TEXT( "Physics" );
+	default:			return TEXT( "Unknown" );
+	}
+}
+
+/*
+==================
+CStatManager::CmdStat
+==================
+*/
+void CStatManager::CmdStat( const std::vector<std::wstring>& InArguments )
+{
+	if ( InArguments.empty() )
+	{
+		Logf( TEXT( "%s\n" ), CCmdStat.GetHelpText().c_str() );
+		return;
+	}
+
+	std::wstring		command = CString::ToLower( InArguments[0] );
+	if ( command == TEXT( "none" ) )
+	{
+		g_StatManager.HideAll();
+	}
+	else if ( command == TEXT( "dump" ) )
+	{
+		g_StatManager.DumpToLog();
+	}
+	else if ( command == TEXT( "csv" ) )
+	{
+		std::wstring		action = InArguments.size() > 1 ? CString::ToLower( InArguments[1] ) : TEXT( "" );
+		if ( action == TEXT( "start" ) )
+		{
+			g_StatManager.StartCSV( InArguments.size() > 2 ? InArguments[2] : TEXT( "" ) );
+		}
+		else if ( action == TEXT( "stop" ) )
+		{
+			g_StatManager.StopCSV();
+			Logf( TEXT( "Stopped dump stats\n" ) );
+		}
+		else
+		{
+			Warnf( TEXT( "Usage: stat csv start [file] | stat csv stop\n" ) );
+		}
+	}
+	else
+	{
+		for ( uint32 index = 0; index < SG_Num; ++index )
+		{
+			if ( command == CString::ToLower( GetGroupName( ( EStatGroup )index ) ) )
+			{
+				g_StatManager.ToggleGroup( ( EStatGroup )index );
+				return;
+			}
+		}
+		Warnf( TEXT( "Unknown stat group '%s'\n" ), InArguments[0].c_str() );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include "Misc/CoreGlobals.h"
+#include "System/Config.h"
+#include "RHI/UploadRingAllocatorRHI.h"
+
+/*
+==================
+CUploadRingAllocator::CUploadRingAllocator
+==================
+*/
+CUploadRingAllocator::CUploadRingAllocator( uint32 InSize /* = 0 */ )
+	: size( 0 )
+	, head( 0 )
+	, numBytesInFlight( 0 )
+	, numEndedFrames( 0 )
+	, numRetiredFrames( 0 )
+	, currentFrameSize( 0 )
+	, numFrameAllocatedBytes( 0 )
+	, numFrameWraps( 0 )
+	, numFrameDiscards( 0 )
+	, bNeedDiscard( true )
+{
+	Init( InSize );
+}
+
+/*
+==================
+CUploadRingAllocator::Init
+==================
+*/
+void CUploadRingAllocator::Init( uint32 InSize )
+{
+	size			= InSize;
+	head			= 0;
+	bNeedDiscard	= true;
+	ResetFrames();
+}
+
+/*
+==================
+CUploadRingAllocator::ResetFrames
+==================
+*/
+void CUploadRingAllocator::ResetFrames()
+{
+	// Frames ended before are in other memory now, so they are retired
+	numBytesInFlight	= 0;
+	currentFrameSize	= 0;
+	numRetiredFrames	= numEndedFrames;
+	frameSizes.clear();
+}
+
+/*
+==================
+CUploadRingAllocator::Allocate
+==================
+*/
+bool CUploadRingAllocator::Allocate( uint32 InSize, uint32 InAlignment, UploadRingAllocation& OutAllocation )
+{
+	if ( InSize == 0 || InSize > size )
+	{
+		return false;
+	}
+
+	// Align offset, alignment may be not a power of two (vertex stride)
+	InAlignment				= Max<uint32>( InAlignment, 1 );
+	uint32		offset		= ( ( head + InAlignment - 1 ) / InAlignment ) * InAlignment;
+	uint32		required	= InSize + ( offset - head );
+
+	OutAllocation.bWrapped = false;
+	if ( offset > size || InSize > size - offset )
+	{
+		// Tail of ring is wasted until frame with it will be retired
+		required				= InSize + ( size - head );
+		offset					= 0;
+		OutAllocation.bWrapped	= true;
+		++numFrameWraps;
+	}
+
+	// If we reach memory which GPU may still read, we must discard whole buffer.
+	// After discard driver gives us new memory, so nothing is in flight in it
+	if ( bNeedDiscard || numBytesInFlight + required > size )
+	{
+		if ( !bNeedDiscard )
+		{
+			++numFrameDiscards;
+		}
+
+		ResetFrames();
+		OutAllocation.bNeedDiscard	= true;
+		bNeedDiscard				= false;
+		required					= InSize;
+	}
+	else
+	{
+		OutAllocation.bNeedDiscard	= false;
+	}
+
+	OutAllocation.offset	= offset;
+	head					= offset + InSize;
+	numBytesInFlight		+= required;
+	currentFrameSize		+= required;
+	numFrameAllocatedBytes	+= InSize;
+	return true;
+}
+
+/*
+==================
+CUploadRingAllocator::EndFrame
+==================
+*/
+uint64 CUploadRingAllocator::EndFrame()
+{
+	frameSizes.push_back( currentFrameSize );
+	currentFrameSize			= 0;
+	numFrameAllocatedBytes		= 0;
+	numFrameWraps				= 0;
+	numFrameDiscards			= 0;
+	return ++numEndedFrames;
+}
+
+/*
+==================
+CUploadRingAllocator::RetireFrames
+==================
+*/
+void CUploadRingAllocator::RetireFrames( uint64 InFrame )
+{
+	Assert( InFrame <= numEndedFrames );
+	while ( numRetiredFrames < InFrame && !frameSizes.empty() )
+	{
+		numBytesInFlight -= frameSizes.front();
+		frameSizes.pop_front();
+		++numRetiredFrames;
+	}
+}
+
+/*
+==================
+CUploadRingAllocator::GetConfigVertexRingSize
+==================
+*/
+uint32 CUploadRingAllocator::GetConfigVertexRingSize()
+{
+	uint32			sizeMB = UPLOAD_RING_DEFAULT_SIZE_MB;
+	CConfigValue	configUploadRingSize = g_Config.GetValue( CT_Engine, TEXT( "Engine.SystemSettings" ), TEXT( "UploadRingSizeMB" ) );
+	if ( configUploadRingSize.IsValid() )
+	{
+		sizeMB = Max<int32>( configUploadRingSize.GetInt(), 1 );
+	}
+
+	return sizeMB * 1024 * 1024;
+}
\ No newline at end of file
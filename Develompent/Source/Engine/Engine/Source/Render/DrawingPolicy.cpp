@@ -1,4 +1,5 @@
 #include "Misc/EngineGlobals.h"
+#include "Misc/Stats.h"
 #include "Containers/String.h"
 #include "RHI/BaseRHI.h"
 #include "RHI/BaseStateRHI.h"
@@ -91,6 +92,90 @@ void CMeshDrawingPolicy::SetShaderParameters( class CBaseDeviceContextRHI* InDev
 	pixelShader->SetConstantParameters( InDeviceContextRHI, vertexFactory, materialRef );
 }
 
+/*
+==================
+CMeshDrawingPolicy::SetDrawingState
+==================
+*/
+void CMeshDrawingPolicy::SetDrawingState( class CBaseDeviceContextRHI* InDeviceContextRHI, const CMeshDrawingPolicy* InPrevDrawingPolicy, uint32& OutNumStateChanges, uint32& OutNumSkippedStateChanges )
+{
+	Assert( bInit );
+
+	// If nothing is set before - set full state
+	if ( !InPrevDrawingPolicy )
+	{
+		SetRenderState( InDeviceContextRHI );
+		SetShaderParameters( InDeviceContextRHI );
+		OutNumStateChanges			+= 5;
+		return;
+	}
+
+	Assert( InPrevDrawingPolicy->bInit );
+	const bool		bSameVertexFactory	= vertexFactory == InPrevDrawingPolicy->vertexFactory;
+	const bool		bSameMaterial		= material == InPrevDrawingPolicy->material;
+
+	// Vertex streams
+	if ( !bSameVertexFactory )
+	{
+		vertexFactory->Set( InDeviceContextRHI );
+		++OutNumStateChanges;
+	}
+	else
+	{
+		++OutNumSkippedStateChanges;
+	}
+
+	// Rasterizer state depends only from material and depth bias
+	if ( !bSameMaterial || depthBias != InPrevDrawingPolicy->depthBias )
+	{
+		g_RHI->SetRasterizerState( InDeviceContextRHI, GetRasterizerState() );
+		++OutNumStateChanges;
+	}
+	else
+	{
+		++OutNumSkippedStateChanges;
+	}
+
+	// Bound shader state
+	if ( vertexShader != InPrevDrawingPolicy->vertexShader || pixelShader != InPrevDrawingPolicy->pixelShader || vertexFactory->GetDeclaration() != InPrevDrawingPolicy->vertexFactory->GetDeclaration() )
+	{
+		g_RHI->SetBoundShaderState( InDeviceContextRHI, GetBoundShaderState() );
+		++OutNumStateChanges;
+	}
+	else
+	{
+		++OutNumSkippedStateChanges;
+	}
+
+	// Shader parameters
+	const bool		bNeedVertexParameters	= !bSameVertexFactory || vertexShader != InPrevDrawingPolicy->vertexShader;
+	const bool		bNeedPixelParameters	= !bSameMaterial || pixelShader != InPrevDrawingPolicy->pixelShader;
+	if ( bNeedVertexParameters || bNeedPixelParameters )
+	{
+		TSharedPtr<CMaterial>		materialRef = material.ToSharedPtr();
+		if ( !materialRef )
+		{
+			materialRef = g_Engine->GetDefaultMaterial().ToSharedPtr();
+		}
+
+		if ( materialRef )
+		{
+			if ( bNeedVertexParameters )
+			{
+				vertexShader->SetConstantParameters( InDeviceContextRHI, vertexFactory, materialRef );
+			}
+
+			if ( bNeedPixelParameters )
+			{
+				pixelShader->SetConstantParameters( InDeviceContextRHI, vertexFactory, materialRef );
+			}
+		}
+	}
+
+	OutNumStateChanges			+= ( bNeedVertexParameters ? 1 : 0 ) + ( bNeedPixelParameters ? 1 : 0 );
+	OutNumSkippedStateChanges	+= ( bNeedVertexParameters ? 0 : 1 ) + ( bNeedPixelParameters ? 0 : 1 );
+}
+
 /*
 ==================
 CMeshDrawingPolicy::Draw
@@ -128,6 +213,7 @@ void CMeshDrawingPolicy::Draw( class CBaseDeviceContextRHI* InDeviceContextRHI,
 	{
 		vertexShader->SetMesh( InDeviceContextRHI, InMeshBatch, vertexFactory, &InSceneView, InMeshBatch.numInstances );
 		g_RHI->CommitConstants( InDeviceContextRHI );
+		g_StatSceneBatchedInstances.Add( InMeshBatch.numInstances );
 
 		if ( InMeshBatch.indexBufferRHI )
 		{
@@ -150,6 +236,24 @@ uint64 CMeshDrawingPolicy::GetTypeHash() const
 	return hash;
 }
 
+/*
+==================
+CMeshDrawingPolicy::GetSortKey
+==================
+*/
+uint64 CMeshDrawingPolicy::GetSortKey() const
+{
+	Assert( bInit );
+
+	// Bits layout: 24 bits of shaders | 20 bits of material | 20 bits of vertex factory.
+	// Vertex factory is hashed by type hash (not by pointer), because it used in GetTypeHash too
+	TSharedPtr<CMaterial>		materialRef		= material.ToSharedPtr();
+	const uint64				shaderBits		= Sys_MemFastHash( pixelShader, Sys_MemFastHash( vertexShader ) ) & 0xFFFFFF;
+	const uint64				materialBits	= Sys_MemFastHash( materialRef.Get() ) & 0xFFFFF;
+	const uint64				factoryBits		= vertexFactory->GetTypeHash() & 0xFFFFF;
+	return ( shaderBits << 40 ) | ( materialBits << 20 ) | factoryBits;
+}
+
 /*
 ==================
 CMeshDrawingPolicy::GetBoundShaderState
@@ -0,0 +1,206 @@
+#include <float.h>
+
+#include "Render/LightGrid.h"
+#include "Render/Scene.h"
+
+/*
+==================
+CLightGrid::CLightGrid
+==================
+*/
+CLightGrid::CLightGrid()
+	: nearDepth( 0.f )
+	, farDepth( 0.f )
+	, sliceScale( 0.f )
+	, sliceBias( 0.f )
+{}
+
+/*
+==================
+CLightGrid::Clear
+==================
+*/
+void CLightGrid::Clear()
+{
+	cells.clear();
+	lightIndices.clear();
+	lightRanges.clear();
+	nearDepth	= 0.f;
+	farDepth	= 0.f;
+	sliceScale	= 0.f;
+	sliceBias	= 0.f;
+}
+
+/*
+==================
+CLightGrid::Build
+==================
+*/
+void CLightGrid::Build( const CSceneView& InSceneView, const std::list<LightComponentRef_t>& InLights )
+{
+	Clear();
+	if ( InLights.empty() )
+	{
+		return;
+	}
+
+	// Collect bounding spheres of lights in view space. Lights without bounds (directional) affect every cell,
+	// so we not store them in the grid
+	const Matrix&				viewMatrix			= InSceneView.GetViewMatrix();
+	const Matrix&				projectionMatrix	= InSceneView.GetProjectionMatrix();
+	std::vector<Vector4D>		viewSpheres;
+	std::vector<uint32>			viewSphereLights;
+	float						minDepth			= FLT_MAX;
+	float						maxDepth			= 0.f;
+	uint32						lightIndex			= 0;
+
+	viewSpheres.reserve( InLights.size() );
+	viewSphereLights.reserve( InLights.size() );
+	for ( auto it = InLights.begin(), itEnd = InLights.end(); it != itEnd; ++it, ++lightIndex )
+	{
+		Vector		center;
+		float		radius = 0.f;
+		if ( !( *it )->GetBoundingSphere( center, radius ) )
+		{
+			continue;
+		}
+
+		// View space is right-handed, camera looks down -Z
+		Vector4D	viewCenter	= viewMatrix * Vector4D( center, 1.f );
+		float		depth		= -viewCenter.z;
+		if ( depth + radius <= 0.f )
+		{
+			continue;
+		}
+
+		minDepth = Min( minDepth, depth - radius );
+		maxDepth = Max( maxDepth, depth + radius );
+		viewSpheres.push_back( Vector4D( viewCenter.x, viewCenter.y, viewCenter.z, radius ) );
+		viewSphereLights.push_back( lightIndex );
+	}
+
+	if ( viewSpheres.empty() )
+	{
+		return;
+	}
+
+	// Depth range of the grid is fitted to the visible lights, it gives a better slice distribution than camera clip planes
+	nearDepth	= Max( minDepth, 0.1f );
+	farDepth	= Max( maxDepth, nearDepth * 2.f );
+	sliceScale	= NumSlicesZ / Math::Loge( farDepth / nearDepth );
+	sliceBias	= -Math::Loge( nearDepth ) * sliceScale;
+
+	// Compute ranges of cells for every light
+	lightRanges.reserve( viewSpheres.size() );
+	for ( uint32 index = 0, count = viewSpheres.size(); index < count; ++index )
+	{
+		const Vector4D&		sphere	= viewSpheres[index];
+		const float			depth	= -sphere.z;
+		LightCellRange		range;
+		range.lightIndex	= viewSphereLights[index];
+		range.minZ			= GetSliceByDepth( depth - sphere.w );
+		range.maxZ			= GetSliceByDepth( depth + sphere.w );
+
+		// Project corners of the view space AABB of the sphere. If any corner is behind the camera we can't
+		// get correct bounds on the screen, so the light covers all tiles
+		Vector2D	minNDC( FLT_MAX, FLT_MAX );
+		Vector2D	maxNDC( -FLT_MAX, -FLT_MAX );
+		bool		bFullScreen = false;
+		for ( uint32 corner = 0; corner < 8 && !bFullScreen; ++corner )
+		{
+			Vector4D	viewCorner(
+				sphere.x + ( ( corner & 1 ) ? sphere.w : -sphere.w ),
+				sphere.y + ( ( corner & 2 ) ? sphere.w : -sphere.w ),
+				sphere.z + ( ( corner & 4 ) ? sphere.w : -sphere.w ),
+				1.f );
+
+			Vector4D	clipCorner = projectionMatrix * viewCorner;
+			if ( clipCorner.w <= SMALL_NUMBER )
+			{
+				bFullScreen = true;
+				break;
+			}
+
+			Vector2D	ndc( clipCorner.x / clipCorner.w, clipCorner.y / clipCorner.w );
+			minNDC.x = Min( minNDC.x, ndc.x );
+			minNDC.y = Min( minNDC.y, ndc.y );
+			maxNDC.x = Max( maxNDC.x, ndc.x );
+			maxNDC.y = Max( maxNDC.y, ndc.y );
+		}
+
+		if ( bFullScreen )
+		{
+			range.minX = 0;
+			range.maxX = NumTilesX - 1;
+			range.minY = 0;
+			range.maxY = NumTilesY - 1;
+		}
+		else
+		{
+			// Light outside of the screen
+			if ( maxNDC.x < -1.f || minNDC.x > 1.f || maxNDC.y < -1.f || minNDC.y > 1.f )
+			{
+				continue;
+			}
+
+			// Tile Y is counted from top of the screen
+			range.minX = Clamp<int32>( ( int32 )Math::Floor( ( minNDC.x * 0.5f + 0.5f ) * NumTilesX ), 0, NumTilesX - 1 );
+			range.maxX = Clamp<int32>( ( int32 )Math::Floor( ( maxNDC.x * 0.5f + 0.5f ) * NumTilesX ), 0, NumTilesX - 1 );
+			range.minY = Clamp<int32>( ( int32 )Math::Floor( ( 0.5f - maxNDC.y * 0.5f ) * NumTilesY ), 0, NumTilesY - 1 );
+			range.maxY = Clamp<int32>( ( int32 )Math::Floor( ( 0.5f - minNDC.y * 0.5f ) * NumTilesY ), 0, NumTilesY - 1 );
+		}
+
+		lightRanges.push_back( range );
+	}
+
+	if ( lightRanges.empty() )
+	{
+		return;
+	}
+
+	// Count lights in every cell
+	cells.resize( NumCells );
+	Sys_Memzero( cells.data(), sizeof( LightGridCell ) * NumCells );
+	for ( uint32 index = 0, count = lightRanges.size(); index < count; ++index )
+	{
+		const LightCellRange&	range = lightRanges[index];
+		for ( uint32 z = range.minZ; z <= range.maxZ; ++z )
+		{
+			for ( uint32 y = range.minY; y <= range.maxY; ++y )
+			{
+				for ( uint32 x = range.minX; x <= range.maxX; ++x )
+				{
+					++cells[GetCellIndex( x, y, z )].numLights;
+				}
+			}
+		}
+	}
+
+	// Compute offsets in the packed array
+	uint32		numIndices = 0;
+	for ( uint32 index = 0; index < NumCells; ++index )
+	{
+		cells[index].offset		= numIndices;
+		numIndices				+= cells[index].numLights;
+		cells[index].numLights	= 0;
+	}
+
+	// Fill light indices
+	lightIndices.resize( numIndices );
+	for ( uint32 index = 0, count = lightRanges.size(); index < count; ++index )
+	{
+		const LightCellRange&	range = lightRanges[index];
+		for ( uint32 z = range.minZ; z <= range.maxZ; ++z )
+		{
+			for ( uint32 y = range.minY; y <= range.maxY; ++y )
+			{
+				for ( uint32 x = range.minX; x <= range.maxX; ++x )
+				{
+					LightGridCell&		cell = cells[GetCellIndex( x, y, z )];
+					lightIndices[cell.offset + cell.numLights] = range.lightIndex;
+					++cell.numLights;
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
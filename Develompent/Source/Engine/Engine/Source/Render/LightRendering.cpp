@@ -581,6 +581,8 @@ void CSceneRenderer::RenderLights( class CBaseDeviceContextRHI* InDeviceContext
 		}
 	}
 
+	scene->GetLightStats().numDrawn = pointLightComponents.size() + spotLightComponents.size() + directionalLightComponents.size();
+
 	// Render point lights
 	if ( !pointLightComponents.empty() )
 	{
@@ -4,6 +4,7 @@
 #include "Render/Material.h"
 #include "Render/VertexFactory/StaticMeshVertexFactory.h"
 #include "Render/VertexFactory/SpriteVertexFactory.h"
+#include "Render/VertexFactory/SpriteBatchVertexFactory.h"
 
 #if !SHIPPING_BUILD
 #include "Render/VertexFactory/DynamicMeshVertexFactory.h"
@@ -159,16 +160,19 @@ void CMaterial::CacheShaderMap()
 		}
 	}
 
-	// If material usage for render sprite mesh
+	// If material usage for render sprite mesh, sprites can be drawn alone or by sprite batcher
 	{
-		const uint64			vertexFactoryHash = CSpriteVertexFactory::staticType.GetHash();
-		if ( usage & MU_Sprite )
+		const uint64			vertexFactoryHashes[] = { CSpriteVertexFactory::staticType.GetHash(), CSpriteBatchVertexFactory::staticType.GetHash() };
+		for ( uint32 index = 0; index < ARRAY_COUNT( vertexFactoryHashes ); ++index )
 		{
-			shaderMap[ vertexFactoryHash ] = GetMeshShaders( vertexFactoryHash );
-		}
-		else
-		{
-			shaderMap.erase( vertexFactoryHash );
+			if ( usage & MU_Sprite )
+			{
+				shaderMap[ vertexFactoryHashes[index] ] = GetMeshShaders( vertexFactoryHashes[index] );
+			}
+			else
+			{
+				shaderMap.erase( vertexFactoryHashes[index] );
+			}
 		}
 	}
 
@@ -29,12 +29,33 @@ PixelFormatInfo		g_PixelFormats[ PF_Max ] =
 	{ TEXT( "BC3" ),					4,			4,			1,			16,			4,				0,				0,				0,				PF_BC3						},
 	{ TEXT( "BC5" ),					4,			4,			1,			16,			2,				0,				0,				0,				PF_BC5						},
 	{ TEXT( "BC6H" ),					1,			1,			1,			16,			3,				0,				0,				0,				PF_BC6H						},
-	{ TEXT( "BC7" ),					4,			4,			1,			16,			4,				0,				0,				0,				PF_BC7						}
+	{ TEXT( "BC7" ),					4,			4,			1,			16,			4,				0,				0,				0,				PF_BC7						},
+	{ TEXT( "BC4" ),					4,			4,			1,			8,			1,				0,				0,				0,				PF_BC4						}
 };
 
 /** Offset to center of the pixel */
 float			g_PixelCenterOffset		= 0.5f;
 
+/*
+==================
+CalcTextureSize
+==================
+*/
+uint64 CalcTextureSize( uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, uint32 InNumMips )
+{
+	const PixelFormatInfo&		formatInfo	= g_PixelFormats[InFormat];
+	const uint32				blockSizeX	= Max<uint32>( formatInfo.blockSizeX, 1 );
+	const uint32				blockSizeY	= Max<uint32>( formatInfo.blockSizeY, 1 );
+	uint64						size		= 0;
+	for ( uint32 mipIndex = 0, numMips = Max<uint32>( InNumMips, 1 ); mipIndex < numMips; ++mipIndex )
+	{
+		const uint32		mipSizeX = Max<uint32>( InSizeX >> mipIndex, 1 );
+		const uint32		mipSizeY = Max<uint32>( InSizeY >> mipIndex, 1 );
+		size += ( uint64 )( ( mipSizeX + blockSizeX - 1 ) / blockSizeX ) * ( ( mipSizeY + blockSizeY - 1 ) / blockSizeY ) * formatInfo.blockBytes;
+	}
+	return size;
+}
+
 /*
 ==================
 DrawDenormalizedQuad
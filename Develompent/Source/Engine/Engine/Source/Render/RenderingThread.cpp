@@ -1,4 +1,5 @@
 #include "Misc/EngineGlobals.h"
+#include "Misc/Stats.h"
 #include "RHI/BaseRHI.h"
 #include "Logger/BaseLogger.h"
 #include "Logger/LoggerMacros.h"
@@ -9,9 +10,15 @@
 // Definitions
 //
 
-/* The size of the rendering command buffer, in bytes. */
+/* The initial size of the rendering command buffer, in bytes. */
 #define RENDERING_COMMAND_BUFFER_SIZE			( 1024 * 1024 )
 
+/* The max size of the rendering command buffer, in bytes. When it reached the game thread waits the rendering thread */
+#define RENDERING_COMMAND_BUFFER_MAX_SIZE		( 64 * 1024 * 1024 )
+
+/* Time in milliseconds to wait new rendering commands while there are rendering thread tickables */
+#define RENDERING_THREAD_TICKABLES_WAIT_TIME	5
+
 //
 // Globals
 //
@@ -23,7 +30,7 @@ bool			g_IsThreadedRendering = false;
 uint32			g_RenderingThreadId = 0;
 
 /* The rendering command queue */
-CRingBuffer		g_RenderCommandBuffer( RENDERING_COMMAND_BUFFER_SIZE, 16 );
+CRingBuffer		g_RenderCommandBuffer( RENDERING_COMMAND_BUFFER_SIZE, 16, RENDERING_COMMAND_BUFFER_MAX_SIZE );
 
 /* Event of finished rendering frame */
 CEvent*			g_RenderFrameFinished = nullptr;
@@ -57,6 +64,25 @@ void TickRenderingTickables()
 	lastTickTime = currentTime;
 }
 
+/*
+==================
+UpdateRenderCommandBufferStats
+==================
+*/
+static void UpdateRenderCommandBufferStats()
+{
+	static uint32		lastNumStalls = 0;
+	static double		lastStallTime = 0.0;
+	RingBufferStats		stats = g_RenderCommandBuffer.GetStats();
+
+	g_StatRHIRenderCommandBufferSize.Set( stats.capacity );
+	g_StatRHIRenderCommandBufferHighWater.Set( stats.highWaterMark );
+	g_StatRHIRenderCommandBufferStalls.Add( stats.numStalls - lastNumStalls );
+	g_StatRHIRenderCommandBufferStallTime.Add( ( int64 )( ( stats.stallTime - lastStallTime ) * 1000000.0 ) );
+	lastNumStalls = stats.numStalls;
+	lastStallTime = stats.stallTime;
+}
+
 /*
 ==================
 CSkipRenderCommand::CSkipRenderCommand
@@ -144,12 +170,22 @@ uint32 CRenderingThread::Run()
 					uint32		commandSize = command->Execute();
 					command->~CRenderCommand();
 					g_RenderCommandBuffer.FinishRead( commandSize );
+
+					g_StatRHIRenderCommands.Increment();
+					g_StatRHIRenderCommandBytes.Add( commandSize );
 				}
 			}
 		}
 
 		// Tick tickable objects
 		TickRenderingTickables();
+		UpdateRenderCommandBufferStats();
+
+		// Sleep until new commands arrive. If there are tickables, wake up periodically to tick them
+		if ( g_IsThreadedRendering )
+		{
+			g_RenderCommandBuffer.WaitForRead( CTickableObject::renderingThreadTickableObjects.empty() ? ( uint32 )-1 : RENDERING_THREAD_TICKABLES_WAIT_TIME );
+		}
 	}
 
 	return 0;
@@ -224,8 +260,9 @@ void StopRenderingThread()
 		{
 			Assert( s_RenderingThread );
 
-			// Turn off the threaded rendering flag.
+			// Turn off the threaded rendering flag and wake up the rendering thread if it is waiting new commands
 			g_IsThreadedRendering = false;
+			g_RenderCommandBuffer.WakeReader();
 
 			//Reset the rendering thread id
 			g_RenderingThreadId = 0;
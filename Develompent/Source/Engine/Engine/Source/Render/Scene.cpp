@@ -1,7 +1,9 @@
 #include "Math/Math.h"
 #include "Render/SceneRenderTargets.h"
 #include "Render/Scene.h"
+#include "Render/SceneUtils.h"
 #include "System/ConVar.h"
+#include "Misc/Stats.h"
 
 #if WITH_EDITOR
 /**
@@ -26,6 +28,24 @@ CConVar		CVarRLight( TEXT( "r.light" ), TEXT( "1" ), CVT_Bool, TEXT( "Enable/Dis
 CConVar		CVarRFreezeRendering( TEXT( "r.freeze_rendering" ), TEXT( "0" ), CVT_Bool, TEXT( "Freeze rendering" ) );
 #endif // WITH_EDITOR
 
+/**
+ * @ingroup Engine
+ * @brief CVar enable/disable frustum culling of lights
+ */
+CConVar		CVarRLightCulling( TEXT( "r.light_culling" ), TEXT( "1" ), CVT_Bool, TEXT( "Enable/Disable frustum culling of lights" ) );
+
+/**
+ * @ingroup Engine
+ * @brief CVar enable/disable building of clustered light grid
+ */
+CConVar		CVarRLightGrid( TEXT( "r.light_grid" ), TEXT( "1" ), CVT_Bool, TEXT( "Enable/Disable building of clustered light grid for passes which use it" ) );
+
+/**
+ * @ingroup Engine
+ * @brief CVar enable/disable batching of sprites
+ */
+CConVar		CVarRSpriteBatching( TEXT( "r.sprite_batching" ), TEXT( "1" ), CVT_Bool, TEXT( "Enable/Disable batching of sprites with the same material into one draw call" ) );
+
 /*
 ==================
 CSceneView::CSceneView
@@ -57,6 +77,26 @@ CSceneView::CSceneView( const Vector& InPosition, const Matrix& InProjectionMatr
 	frustum.Update( viewProjectionMatrix );
 }
 
+/*
+==================
+CSceneView::GetScreenSize
+==================
+*/
+float CSceneView::GetScreenSize( const Vector& InOrigin, float InRadius ) const
+{
+	// Take the larger of horizontal and vertical scale of projection
+	const float		screenMultiple = Max( Math::Abs( projectionMatrix[0][0] ), Math::Abs( projectionMatrix[1][1] ) );
+
+	// In orthographic projection size of sphere isn't depends on distance
+	if ( projectionMatrix[3][3] != 0.f )
+	{
+		return InRadius * screenMultiple;
+	}
+
+	const float		distance = Max( Math::DistanceVector( position, InOrigin ), 1.f );
+	return InRadius * screenMultiple / distance;
+}
+
 /*
 ==================
 CSceneView::ScreenToWorld
@@ -257,12 +297,15 @@ void CScene::BuildView( const CSceneView& InSceneView )
 #endif // WITH_EDITOR
 
 	// Add to SDGs visible primitives
+	drawListStats.Reset();
+	uint32		numVisiblePrimitives = 0;
 	for ( auto it = primitives.begin(), itEnd = primitives.end(); it != itEnd; ++it )
 	{
 		CPrimitiveComponent*		primitiveComponent = *it;
 		if ( primitiveComponent->IsVisibility() && InSceneView.GetFrustum().IsIn( primitiveComponent->GetBoundBox() ) )
 		{
 			primitiveComponent->AddToDrawList( InSceneView );
+			++numVisiblePrimitives;
 
 #if WITH_EDITOR
 			if ( g_IsEditor )
@@ -273,12 +316,36 @@ void CScene::BuildView( const CSceneView& InSceneView )
 		}
 	}
 
+	// Build batched sprites after all primitives added their sprites
+	for ( uint32 index = 0; index < SDG_Max; ++index )
+	{
+		frame.SDGs[ index ].spriteBatcher.Build( frame.SDGs[ index ] );
+	}
+
+	g_StatScenePrimitives.Add( primitives.size() );
+	g_StatSceneVisiblePrimitives.Add( numVisiblePrimitives );
+	g_StatSceneCulledPrimitives.Add( primitives.size() - numVisiblePrimitives );
+
 	// Add to scene frame visible lights
+	const CFrustum&		frustum			= InSceneView.GetFrustum();
+	bool				bLightCulling	= CVarRLightCulling.GetValueBool();
+	lightStats.Reset();
 	for ( auto it = lights.begin(), itEnd = lights.end(); it != itEnd; ++it )
 	{
 		CLightComponent*		lightComponent = *it;
 		if ( lightComponent->IsEnabled() )
 		{
+			++lightStats.numConsidered;
+
+			// Point and spot lights are culled by bounding sphere of their volume
+			Vector		boundCenter;
+			float		boundRadius = 0.f;
+			if ( bLightCulling && lightComponent->GetBoundingSphere( boundCenter, boundRadius ) && !frustum.IsIn( boundCenter, boundRadius ) )
+			{
+				++lightStats.numCulled;
+				continue;
+			}
+
 			frame.visibleLights.push_back( lightComponent );
 
 #if WITH_EDITOR
@@ -289,6 +356,27 @@ void CScene::BuildView( const CSceneView& InSceneView )
 #endif // WITH_EDITOR
 		}
 	}
+
+	g_StatSceneVisibleLights.Add( lightStats.numConsidered - lightStats.numCulled );
+	g_StatSceneCulledLights.Add( lightStats.numCulled );
+
+	// Clustered light grid is built only when some pass requests it
+	frame.bNeedBuildLightGrid = CVarRLightGrid.GetValueBool();
+}
+
+/*
+==================
+CScene::GetLightGrid
+==================
+*/
+const CLightGrid& CScene::GetLightGrid( const CSceneView& InSceneView )
+{
+	if ( frame.bNeedBuildLightGrid )
+	{
+		frame.lightGrid.Build( InSceneView, frame.visibleLights );
+		frame.bNeedBuildLightGrid = false;
+	}
+	return frame.lightGrid;
 }
 
 /*
@@ -306,6 +394,12 @@ void CScene::ClearView()
 	}
 #endif // WITH_EDITOR
 
+	// Flush draw list stats of drawn view to stat counters
+	g_StatSceneDrawingPolicies.Add( drawListStats.numDrawingPolicies );
+	g_StatSceneMeshBatches.Add( drawListStats.numMeshBatches );
+	g_StatSceneStateChanges.Add( drawListStats.numStateChanges );
+	g_StatSceneSkippedStateChanges.Add( drawListStats.numSkippedStateChanges );
+
 	// Clear all instances in scene depth groups
 	for ( uint32 index = 0; index < SDG_Max; ++index )
 	{
@@ -313,6 +407,8 @@ void CScene::ClearView()
 	}
 
 	frame.visibleLights.clear();
+	frame.lightGrid.Clear();
+	frame.bNeedBuildLightGrid = false;
 }
 
 /*
@@ -333,4 +429,195 @@ CScene::GetExposure
 float CScene::GetExposure() const
 {
 	return exposure;
+}
+
+/*
+==================
+CSpriteBatcher::CSpriteBatcher
+==================
+*/
+CSpriteBatcher::CSpriteBatcher()
+	: mesh( new CSpriteBatchMesh() )
+{}
+
+/*
+==================
+CSpriteBatcher::~CSpriteBatcher
+==================
+*/
+CSpriteBatcher::~CSpriteBatcher()
+{
+	mesh->BeginRelease();
+}
+
+/*
+==================
+CSpriteBatcher::IsEnabled
+==================
+*/
+bool CSpriteBatcher::IsEnabled()
+{
+	return CVarRSpriteBatching.GetValueBool();
+}
+
+/*
+==================
+CSpriteBatcher::IsSameRun
+==================
+*/
+bool CSpriteBatcher::IsSameRun( const SpriteBatchElement& InA, const SpriteBatchElement& InB )
+{
+	return InA.material == InB.material
+#if WITH_EDITOR
+		&& InA.bSelected == InB.bSelected
+#endif // WITH_EDITOR
+		;
+}
+
+/*
+==================
+CSpriteBatcher::Build
+==================
+*/
+void CSpriteBatcher::Build( SceneDepthGroup& InSDG )
+{
+	if ( elements.empty() )
+	{
+		return;
+	}
+
+	// Sort sprites by material to get the longest runs, inside of run sprites are drawn from lowest layer to highest.
+	// Key of material is reference and asset pointers, the same what IsSameRun compares, so different materials never interleave
+	std::vector< std::pair<const void*, const void*> >		materialKeys( elements.size() );
+	sortedElements.resize( elements.size() );
+	for ( uint32 index = 0, count = elements.size(); index < count; ++index )
+	{
+		const TAssetHandle<CMaterial>&		material = elements[index].material;
+		sortedElements[index] = index;
+		materialKeys[index] = std::make_pair( ( const void* )material.GetReference().Get(), ( const void* )material.ToSharedPtr().Get() );
+	}
+
+	std::sort( sortedElements.begin(), sortedElements.end(), [&]( uint32 InA, uint32 InB )
+	{
+		if ( materialKeys[InA] != materialKeys[InB] )
+		{
+			return materialKeys[InA] < materialKeys[InB];
+		}
+
+#if WITH_EDITOR
+		if ( elements[InA].bSelected != elements[InB].bSelected )
+		{
+			return elements[InB].bSelected;
+		}
+#endif // WITH_EDITOR
+
+		return elements[InA].transformMatrix[3].z < elements[InB].transformMatrix[3].z;
+	} );
+
+	// Bake verteces of sprites in world space with final texture coords, the same as CSpriteMesh with CSpriteVertexFactory do on GPU
+	static const Vector2D	quadPositions[] = { Vector2D( -1.f, -1.f ), Vector2D( -1.f, 1.f ), Vector2D( 1.f, 1.f ), Vector2D( 1.f, -1.f ) };
+	static const Vector2D	quadTexCoords[] = { Vector2D( 0.f, 1.f ),	Vector2D( 0.f, 0.f ),	Vector2D( 1.f, 0.f ),	Vector2D( 1.f, 1.f ) };
+	verteces.resize( elements.size() * 4 );
+	for ( uint32 index = 0, count = sortedElements.size(); index < count; ++index )
+	{
+		const SpriteBatchElement&	element		= elements[sortedElements[index]];
+		const Vector2D				halfSize	= element.spriteSize / 2.f;
+		const Vector4D				normal		= element.transformMatrix * Vector4D( 0.f, 1.f, 0.f, 0.f );
+		const Vector4D				color		= element.color.ToNormalizedVector4D();
+		SpriteBatchVertexType*		quad		= verteces.data() + index * 4;
+		for ( uint32 vertexIndex = 0; vertexIndex < 4; ++vertexIndex )
+		{
+			SpriteBatchVertexType&	vertex = quad[vertexIndex];
+			vertex.position		= element.transformMatrix * Vector4D( quadPositions[vertexIndex] * halfSize, 0.f, 1.f );
+			vertex.texCoord		= Vector2D( element.textureRect.left, element.textureRect.top ) + quadTexCoords[vertexIndex] * Vector2D( element.textureRect.width, element.textureRect.height );
+			vertex.normal		= normal;
+			vertex.color		= color;
+
+			if ( element.bFlipVertical )
+			{
+				vertex.texCoord.y *= -1.f;
+			}
+
+			if ( element.bFlipHorizontal )
+			{
+				vertex.texCoord.x *= -1.f;
+			}
+		}
+	}
+	mesh->Update( verteces );
+
+	// Add to draw lists one mesh batch per run
+	uint32		numRuns = 0;
+	uint32		firstSprite = 0;
+	for ( uint32 index = 1, count = sortedElements.size(); index <= count; ++index )
+	{
+		const SpriteBatchElement&	firstElement = elements[sortedElements[firstSprite]];
+		if ( index < count && IsSameRun( firstElement, elements[sortedElements[index]] ) )
+		{
+			continue;
+		}
+
+		AddRun( InSDG, firstElement, firstSprite, index - firstSprite );
+		firstSprite = index;
+		++numRuns;
+	}
+
+	g_StatSceneBatchedSprites.Add( elements.size() );
+	g_StatSceneSpriteBatches.Add( numRuns );
+}
+
+/*
+==================
+CSpriteBatcher::AddRun
+==================
+*/
+void CSpriteBatcher::AddRun( SceneDepthGroup& InSDG, const SpriteBatchElement& InElement, uint32 InFirstSprite, uint32 InNumSprites )
+{
+	MeshBatch			meshBatch;
+	meshBatch.baseVertexIndex	= 0;
+	meshBatch.firstIndex		= InFirstSprite * 6;
+	meshBatch.numPrimitives		= InNumSprites * 2;
+	meshBatch.indexBufferRHI	= mesh->GetIndexBufferRHI();
+	meshBatch.primitiveType		= PT_TriangleList;
+
+	const MeshBatch*	meshBatchLinks[2] = { nullptr, nullptr };
+	drawingPolicyLinks.push_back( ::MakeDrawingPolicyLink<CMeshDrawList<CMeshDrawingPolicy>::DrawingPolicyLink>( mesh->GetVertexFactory(), InElement.material, meshBatch, meshBatchLinks[0], InSDG.spriteDrawList, DEC_SPRITE ) );
+	depthDrawingPolicyLinks.push_back( ::MakeDrawingPolicyLink<CMeshDrawList<CDepthDrawingPolicy>::DrawingPolicyLink>( mesh->GetVertexFactory(), InElement.material, meshBatch, meshBatchLinks[1], InSDG.depthDrawList, DEC_SPRITE ) );
+
+	// Verteces already in world space, so run is drawn as one instance with identity transform
+	for ( uint32 index = 0; index < ARRAY_COUNT( meshBatchLinks ); ++index )
+	{
+		const MeshBatch*	meshBatchLink = meshBatchLinks[index];
+		++meshBatchLink->numInstances;
+		meshBatchLink->instances.resize( meshBatchLink->numInstances );
+
+		MeshInstance&		instanceMesh = meshBatchLink->instances[meshBatchLink->numInstances - 1];
+		instanceMesh.transformMatrix	= Math::matrixIdentity;
+
+#if WITH_EDITOR
+		instanceMesh.bSelected			= InElement.bSelected;
+#endif // WITH_EDITOR
+	}
+}
+
+/*
+==================
+CSpriteBatcher::Clear
+==================
+*/
+void CSpriteBatcher::Clear( SceneDepthGroup& InSDG )
+{
+	for ( uint32 index = 0, count = drawingPolicyLinks.size(); index < count; ++index )
+	{
+		InSDG.spriteDrawList.RemoveItem( drawingPolicyLinks[index] );
+	}
+
+	for ( uint32 index = 0, count = depthDrawingPolicyLinks.size(); index < count; ++index )
+	{
+		InSDG.depthDrawList.RemoveItem( depthDrawingPolicyLinks[index] );
+	}
+
+	drawingPolicyLinks.clear();
+	depthDrawingPolicyLinks.clear();
+	elements.clear();
 }
\ No newline at end of file
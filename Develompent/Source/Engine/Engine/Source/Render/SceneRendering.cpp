@@ -144,7 +144,7 @@ bool CSceneRenderer::RenderPrePass( class CBaseDeviceContextRHI* InDeviceContext
 	{
 		g_RHI->SetDepthState( immediateContext, TStaticDepthStateRHI<true>::GetRHI() );
 		g_RHI->SetBlendState( immediateContext, TStaticBlendStateRHI<>::GetRHI() );
-		SDG.depthDrawList.Draw( InDeviceContext, *sceneView );
+		SDG.depthDrawList.Draw( InDeviceContext, *sceneView, &scene->GetDrawListStats() );
 	}
 
 	g_SceneRenderTargets.FinishRenderingPrePass( immediateContext );
@@ -252,7 +252,7 @@ bool CSceneRenderer::RenderSDG( class CBaseDeviceContextRHI* InDeviceContext, ui
 	if ( showFlags & SHOW_Gizmo && SDG.gizmoDrawList.GetNum() > 0 )
 	{
 		SCOPED_DRAW_EVENT( EventGizmos, DEC_SPRITE, TEXT( "Gizmos" ) );
-		SDG.gizmoDrawList.Draw( InDeviceContext, *sceneView );
+		SDG.gizmoDrawList.Draw( InDeviceContext, *sceneView, &scene->GetDrawListStats() );
 	}
 #endif // WITH_EDITOR
 
@@ -260,14 +260,14 @@ bool CSceneRenderer::RenderSDG( class CBaseDeviceContextRHI* InDeviceContext, ui
 	if ( showFlags & SHOW_StaticMesh && SDG.staticMeshDrawList.GetNum() > 0 )
 	{
 		SCOPED_DRAW_EVENT( EventStaticMeshes, DEC_STATIC_MESH, TEXT( "Static meshes" ) );
-		SDG.staticMeshDrawList.Draw( InDeviceContext, *sceneView );
+		SDG.staticMeshDrawList.Draw( InDeviceContext, *sceneView, &scene->GetDrawListStats() );
 	}
 
 	// Draw sprites
 	if ( showFlags & SHOW_Sprite && SDG.spriteDrawList.GetNum() > 0 )
 	{
 		SCOPED_DRAW_EVENT( EventSprites, DEC_SPRITE, TEXT( "Sprites" ) );
-		SDG.spriteDrawList.Draw( InDeviceContext, *sceneView );
+		SDG.spriteDrawList.Draw( InDeviceContext, *sceneView, &scene->GetDrawListStats() );
 	}
 
 	// Draw dynamic meshes
@@ -284,7 +284,7 @@ bool CSceneRenderer::RenderSDG( class CBaseDeviceContextRHI* InDeviceContext, ui
 		// Draw dynamic mesh elements
 		if ( SDG.dynamicMeshElements.GetNum() > 0 )
 		{
-			SDG.dynamicMeshElements.Draw( InDeviceContext, *sceneView );
+			SDG.dynamicMeshElements.Draw( InDeviceContext, *sceneView, &scene->GetDrawListStats() );
 		}
 
 		// Draw dynamic mesh builders
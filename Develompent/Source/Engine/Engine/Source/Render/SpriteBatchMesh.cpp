@@ -0,0 +1,111 @@
+#include "Misc/EngineGlobals.h"
+#include "RHI/BaseRHI.h"
+#include "Render/RenderingThread.h"
+#include "Render/SpriteBatchMesh.h"
+
+/*
+==================
+CSpriteBatchMesh::CSpriteBatchMesh
+==================
+*/
+CSpriteBatchMesh::CSpriteBatchMesh()
+	: maxSprites( 0 )
+	, vertexFactory( new CSpriteBatchVertexFactory() )
+{}
+
+/*
+==================
+CSpriteBatchMesh::Update
+==================
+*/
+void CSpriteBatchMesh::Update( const std::vector<SpriteBatchVertexType>& InVerteces )
+{
+	Assert( IsInRenderingThread() && InVerteces.size() % 4 == 0 );
+	if ( InVerteces.empty() )
+	{
+		return;
+	}
+
+	if ( !IsInitialized() )
+	{
+		InitResource();
+	}
+
+	// If buffers is too small we recreate them with bigger size
+	const uint32		numSprites = InVerteces.size() / 4;
+	if ( numSprites > maxSprites )
+	{
+		ReleaseRHI();
+		maxSprites = Max<uint32>( maxSprites, SPRITEBATCH_MIN_SPRITES );
+		while ( maxSprites < numSprites )
+		{
+			maxSprites *= 2;
+		}
+		InitRHI();
+	}
+
+	LockedData			lockedData;
+	const uint32		size = sizeof( SpriteBatchVertexType ) * InVerteces.size();
+	CBaseDeviceContextRHI*	deviceContext = g_RHI->GetImmediateContext();
+	g_RHI->LockVertexBuffer( deviceContext, vertexBufferRHI, size, 0, lockedData );
+	memcpy( lockedData.data, InVerteces.data(), size );
+	g_RHI->UnlockVertexBuffer( deviceContext, vertexBufferRHI, lockedData );
+}
+
+/*
+==================
+CSpriteBatchMesh::BeginRelease
+==================
+*/
+void CSpriteBatchMesh::BeginRelease()
+{
+	UNIQUE_RENDER_COMMAND_ONEPARAMETER( CSpriteBatchMeshReleaseCommand, SpriteBatchMeshRef_t, mesh, this,
+		{
+			mesh->ReleaseResource();
+		} );
+}
+
+/*
+==================
+CSpriteBatchMesh::InitRHI
+==================
+*/
+void CSpriteBatchMesh::InitRHI()
+{
+	// Buffers are created on first update, when number of sprites is known
+	if ( maxSprites == 0 )
+	{
+		return;
+	}
+
+	vertexBufferRHI = g_RHI->CreateVertexBuffer( TEXT( "SpriteBatch" ), sizeof( SpriteBatchVertexType ) * 4 * maxSprites, nullptr, RUF_Dynamic );
+	vertexFactory->AddVertexStream( VertexStream{ vertexBufferRHI, sizeof( SpriteBatchVertexType ) } );		// 0 stream slot
+	vertexFactory->Init();
+
+	// All sprites are quads with the same topology as in CSpriteMesh
+	std::vector<uint32>		indeces( 6 * maxSprites );
+	for ( uint32 index = 0; index < maxSprites; ++index )
+	{
+		uint32*			quadIndeces		= indeces.data() + index * 6;
+		const uint32	baseVertex		= index * 4;
+		quadIndeces[0]	= baseVertex;
+		quadIndeces[1]	= baseVertex + 1;
+		quadIndeces[2]	= baseVertex + 2;
+		quadIndeces[3]	= baseVertex;
+		quadIndeces[4]	= baseVertex + 2;
+		quadIndeces[5]	= baseVertex + 3;
+	}
+	indexBufferRHI = g_RHI->CreateIndexBuffer( TEXT( "SpriteBatch" ), sizeof( uint32 ), sizeof( uint32 ) * indeces.size(), ( byte* )indeces.data(), RUF_Static );
+}
+
+/*
+==================
+CSpriteBatchMesh::ReleaseRHI
+==================
+*/
+void CSpriteBatchMesh::ReleaseRHI()
+{
+	vertexBufferRHI.SafeRelease();
+	indexBufferRHI.SafeRelease();
+	vertexFactory->ReleaseResource();
+}
\ No newline at end of file
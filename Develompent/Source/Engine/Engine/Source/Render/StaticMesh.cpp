@@ -14,6 +14,8 @@ CStaticMesh::CStaticMesh
 CStaticMesh::CStaticMesh()
 	: CAsset( AT_StaticMesh )
 	, vertexFactory( new CStaticMeshVertexFactory() )
+	, vertexFormat( SMVF_Default )
+	, lods( 1 )
 {}
 
 /*
@@ -59,21 +61,36 @@ CStaticMesh::InitRHI
 void CStaticMesh::InitRHI()
 {
 	// Create vertex buffer
-	uint32			numVerteces = ( uint32 )verteces.Num();
+	uint32			vertexStride = GetStaticMeshVertexStride( vertexFormat );
+	uint32			numVerteces = GetNumVerteces();
 	if ( numVerteces > 0 )
 	{
-		vertexBufferRHI = g_RHI->CreateVertexBuffer( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), sizeof( StaticMeshVertexType ) * numVerteces, ( byte* )verteces.GetData(), RUF_Static );
+		vertexBufferRHI = g_RHI->CreateVertexBuffer( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), vertexStride * numVerteces, verteces.GetData(), RUF_Static );
 
 		// Initialize vertex factory
-		vertexFactory->AddVertexStream( VertexStream{ vertexBufferRHI, sizeof( StaticMeshVertexType ) } );		// 0 stream slot
+		vertexFactory->SetVertexFormat( vertexFormat, bbox );
+		vertexFactory->AddVertexStream( VertexStream{ vertexBufferRHI, vertexStride } );		// 0 stream slot
 		vertexFactory->Init();
 	}
 
-	// Create index buffer
+	// Create index buffer, if all verteces can be addressed by 16-bit indeces we use them
 	uint32			numIndeces = ( uint32 )indeces.Num();
 	if ( numIndeces > 0 )
 	{
-		indexBufferRHI = g_RHI->CreateIndexBuffer( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), sizeof( uint32 ), sizeof( uint32 ) * numIndeces, ( byte* )indeces.GetData(), RUF_Static );
+		uint32		indexStride = GetStaticMeshIndexStride( numVerteces );
+		if ( indexStride == sizeof( uint16 ) )
+		{
+			std::vector<uint16>		shortIndeces( numIndeces );
+			for ( uint32 index = 0; index < numIndeces; ++index )
+			{
+				shortIndeces[index] = ( uint16 )indeces.GetElement( index );
+			}
+			indexBufferRHI = g_RHI->CreateIndexBuffer( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), indexStride, indexStride * numIndeces, ( byte* )shortIndeces.data(), RUF_Static );
+		}
+		else
+		{
+			indexBufferRHI = g_RHI->CreateIndexBuffer( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), indexStride, indexStride * numIndeces, ( byte* )indeces.GetData(), RUF_Static );
+		}
 	}
 
 	if ( !g_IsEditor && !g_IsCommandlet )
@@ -109,35 +126,66 @@ void CStaticMesh::Serialize( class CArchive& InArchive )
 
 	CAsset::Serialize( InArchive );
 
+	// Old packages store verteces in StaticMeshVertexType, after loading we convert them to compact vertex format
+	std::vector<StaticMeshVertexType>		oldVerteces;
 	if ( InArchive.Ver() < VER_CompressedZlib )
 	{
-		std::vector<StaticMeshVertexType>		tmpVerteces;
 		std::vector<uint32>						tmpIndeces;
-		InArchive << tmpVerteces;
+		InArchive << oldVerteces;
 		InArchive << tmpIndeces;
 
-		verteces = tmpVerteces;
 		indeces = tmpIndeces;
 		Warnf( TEXT( "Deprecated package version, in future must be removed supports\n" ) );
 	}
+	else if ( InArchive.Ver() < VER_CompactStaticMeshVertex )
+	{
+		CBulkData<StaticMeshVertexType>			tmpVerteces;
+		InArchive << tmpVerteces;
+		InArchive << indeces;
+
+		oldVerteces = tmpVerteces.GetStdContainer();
+	}
 	else
 	{
+		InArchive << vertexFormat;
 		InArchive << verteces;
 		InArchive << indeces;
 	}
 
-	InArchive << surfaces;
+	// Old packages have only one LOD
+	if ( InArchive.Ver() < VER_StaticMeshLODs )
+	{
+		lods.resize( 1 );
+		lods[0].screenSize = 1.f;
+		InArchive << lods[0].surfaces;
+	}
+	else
+	{
+		InArchive << lods;
+		if ( lods.empty() )
+		{
+			lods.resize( 1 );
+		}
+	}
 	InArchive << materials;
 
 	if ( InArchive.Ver() < VER_BBoxInStaticMesh )
 	{
-		CalcBoundingBox();
+		CalcBoundingBox( oldVerteces );
 	}
 	else
 	{
 		InArchive << bbox;
 	}
 
+	if ( InArchive.Ver() < VER_CompactStaticMeshVertex )
+	{
+		std::vector<byte>		packedVerteces;
+		vertexFormat = SMVF_Default;
+		PackStaticMeshVerteces( oldVerteces, vertexFormat, bbox, packedVerteces );
+		verteces = packedVerteces;
+	}
+
 	if ( InArchive.IsLoading() )
 	{
 		// Mark dirty all drawing policy links
@@ -151,36 +199,76 @@ void CStaticMesh::Serialize( class CArchive& InArchive )
 CStaticMesh::SetData
 ==================
 */
-void CStaticMesh::SetData( const std::vector<StaticMeshVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<StaticMeshSurface>& InSurfaces, const std::vector< TAssetHandle<CMaterial> >& InMaterials )
+void CStaticMesh::SetData( const std::vector<StaticMeshVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<StaticMeshSurface>& InSurfaces, const std::vector< TAssetHandle<CMaterial> >& InMaterials, EStaticMeshVertexFormat InVertexFormat /* = SMVF_Default */ )
+{
+	std::vector<StaticMeshLOD>		newLODs( 1 );
+	newLODs[0].surfaces		= InSurfaces;
+	SetData( InVerteces, InIndeces, newLODs, InMaterials, InVertexFormat );
+}
+
+/*
+==================
+CStaticMesh::SetData
+==================
+*/
+void CStaticMesh::SetData( const std::vector<StaticMeshVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<StaticMeshLOD>& InLODs, const std::vector< TAssetHandle<CMaterial> >& InMaterials, EStaticMeshVertexFormat InVertexFormat /* = SMVF_Default */ )
 {
+	Assert( !InLODs.empty() && InLODs.size() <= STATICMESH_MAX_LODS );
+
 	// Copy new parameters of static mesh
-	verteces		= InVerteces;
 	indeces			= InIndeces;
-	surfaces		= InSurfaces;
+	lods			= InLODs;
 	materials		= InMaterials;
-	CalcBoundingBox();
+	vertexFormat	= InVertexFormat;
+	CalcBoundingBox( InVerteces );
+
+	// Pack verteces to vertex format, quantized position is relative to bounding box
+	std::vector<byte>		packedVerteces;
+	PackStaticMeshVerteces( InVerteces, vertexFormat, bbox, packedVerteces );
+	verteces		= packedVerteces;
 
 	// Mark dirty all drawing policy links
 	MarkDirtyAllElementDrawingPolices();
 	BeginUpdateResource( this );
 }
 
+/*
+==================
+CStaticMesh::SelectLOD
+==================
+*/
+uint32 CStaticMesh::SelectLOD( float InScreenSize, uint32 InCurrentLOD ) const
+{
+	// Find the coarsest LOD which screen size isn't less then mesh size.
+	// Thresholds of LODs coarser then current are lowered and other ones are raised, so mesh near threshold doesn't flicker
+	for ( uint32 indexLOD = lods.size() - 1; indexLOD > 0; --indexLOD )
+	{
+		float	threshold = lods[ indexLOD ].screenSize * ( indexLOD > InCurrentLOD ? 1.f - STATICMESH_LOD_HYSTERESIS : 1.f + STATICMESH_LOD_HYSTERESIS );
+		if ( InScreenSize <= threshold )
+		{
+			return indexLOD;
+		}
+	}
+
+	return 0;
+}
+
 /*
 ==================
 CStaticMesh::CalcBoundingBox
 ==================
 */
-void CStaticMesh::CalcBoundingBox()
+void CStaticMesh::CalcBoundingBox( const std::vector<StaticMeshVertexType>& InVerteces )
 {
 	// Find minimum and maximum by XYZ
-	if ( verteces.Num() > 0 )
+	if ( !InVerteces.empty() )
 	{
-		Vector		minXYZ = verteces.GetElement( 0 ).position;
-		Vector		maxXYZ = verteces.GetElement( 0 ).position;
+		Vector		minXYZ = InVerteces[0].position;
+		Vector		maxXYZ = InVerteces[0].position;
 
-		for ( uint32 index = 0, count = verteces.Num(); index < count; ++index )
+		for ( uint32 index = 0, count = InVerteces.size(); index < count; ++index )
 		{
-			const StaticMeshVertexType&	vertexType = verteces.GetElement( index );
+			const StaticMeshVertexType&	vertexType = InVerteces[index];
 			if ( minXYZ.x > vertexType.position.x )
 			{
 				minXYZ.x = vertexType.position.x;
@@ -378,71 +466,76 @@ TSharedPtr<CStaticMesh::ElementDrawingPolicyLink> CStaticMesh::MakeDrawingPolicy
 	uint32									numOverrideMaterials	= InOverrideMaterials ? InOverrideMaterials->size() : 0;
 	element->overrideHash = InOverrideHash;
 
-	// Generate mesh batch for surface and add to new scene draw policy link
-	for ( uint32 indexSurface = 0, numSurfaces = ( uint32 )surfaces.size(); indexSurface < numSurfaces; ++indexSurface )
+	// Generate mesh batch for surface of each LOD and add to new scene draw policy link
+	for ( uint32 indexLOD = 0, numLODs = ( uint32 )lods.size(); indexLOD < numLODs; ++indexLOD )
 	{
-		const StaticMeshSurface&		surface				= surfaces[ indexSurface ];
-		TAssetHandle<CMaterial>			material			= materials[ surface.materialID ];
-		TSharedPtr<CMaterial>			materialRef;
-
-		// If current material is override - use custom material
-		if ( indexSurface < numOverrideMaterials )
+		const std::vector<StaticMeshSurface>&		surfaces = lods[ indexLOD ].surfaces;
+		std::vector<const MeshBatch*>&				meshBatchLinks = element->meshBatchLinks[ indexLOD ];
+		for ( uint32 indexSurface = 0, numSurfaces = ( uint32 )surfaces.size(); indexSurface < numSurfaces; ++indexSurface )
 		{
-			TAssetHandle<CMaterial>		overrideMaterial = InOverrideMaterials->at( surface.materialID );
-			if ( overrideMaterial.IsValid() )
+			const StaticMeshSurface&		surface				= surfaces[ indexSurface ];
+			TAssetHandle<CMaterial>			material			= materials[ surface.materialID ];
+			TSharedPtr<CMaterial>			materialRef;
+
+			// If current material is override - use custom material
+			if ( indexSurface < numOverrideMaterials )
 			{
-				material = overrideMaterial;
+				TAssetHandle<CMaterial>		overrideMaterial = InOverrideMaterials->at( surface.materialID );
+				if ( overrideMaterial.IsValid() )
+				{
+					material = overrideMaterial;
+				}
 			}
-		}
 		
-		// In case when reference to material is valid then get TSharedPtr to material
-		if ( material.IsValid() )
-		{
-			materialRef = material.ToSharedPtr();
+			// In case when reference to material is valid then get TSharedPtr to material
+			if ( material.IsValid() )
+			{
+				materialRef = material.ToSharedPtr();
 			
-			// If materialRef still NULL then try load it from package
+				// If materialRef still NULL then try load it from package
+				if ( !materialRef )
+				{
+					materialRef = g_PackageManager->FindAsset( *material.GetReference() ).ToSharedPtr();
+				}
+			}
+		
+			// Otherwise we must use default material if materialRef is still NULL
 			if ( !materialRef )
 			{
-				materialRef = g_PackageManager->FindAsset( *material.GetReference() ).ToSharedPtr();
+				material = g_Engine->GetDefaultMaterial();
+				materialRef = material.ToSharedPtr();
+				Assert( materialRef );
 			}
-		}
-		
-		// Otherwise we must use default material if materialRef is still NULL
-		if ( !materialRef )
-		{
-			material = g_Engine->GetDefaultMaterial();
-			materialRef = material.ToSharedPtr();
-			Assert( materialRef );
-		}
 
-		// Generate mesh batch of surface
-		MeshBatch					meshBatch;
-		meshBatch.baseVertexIndex	= surface.baseVertexIndex;
-		meshBatch.firstIndex		= surface.firstIndex;
-		meshBatch.numPrimitives		= surface.numPrimitives;
-		meshBatch.indexBufferRHI	= indexBufferRHI;
-		meshBatch.primitiveType		= PT_TriangleList;
-
-		// Make and add to scene new static mesh drawing policy link
-		const MeshBatch*					meshBatchLink				= nullptr;
-		DrawingPolicyLinkRef_t				drawingPolicyLink			= ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.staticMeshDrawList, DEC_STATIC_MESH );
-		element->drawingPolicyLinks.push_back( drawingPolicyLink );
-		element->meshBatchLinks.push_back( meshBatchLink );
-
-		// Make and add to scene new depth mesh drawing policy link
-		if ( !materialRef->IsTranslucency() )	// TODO yehor.pohuliaka - Need implement normal translucency support in the render
-		{
-			DepthDrawingPolicyLinkRef_t		depthDrawingPolicyLink		= ::MakeDrawingPolicyLink<DepthDrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.depthDrawList, DEC_STATIC_MESH );
-			element->depthDrawingPolicyLinks.push_back( depthDrawingPolicyLink );
-			element->meshBatchLinks.push_back( meshBatchLink );
-		}
+			// Generate mesh batch of surface
+			MeshBatch					meshBatch;
+			meshBatch.baseVertexIndex	= surface.baseVertexIndex;
+			meshBatch.firstIndex		= surface.firstIndex;
+			meshBatch.numPrimitives		= surface.numPrimitives;
+			meshBatch.indexBufferRHI	= indexBufferRHI;
+			meshBatch.primitiveType		= PT_TriangleList;
+
+			// Make and add to scene new static mesh drawing policy link
+			const MeshBatch*					meshBatchLink				= nullptr;
+			DrawingPolicyLinkRef_t				drawingPolicyLink			= ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.staticMeshDrawList, DEC_STATIC_MESH );
+			element->drawingPolicyLinks.push_back( drawingPolicyLink );
+			meshBatchLinks.push_back( meshBatchLink );
+
+			// Make and add to scene new depth mesh drawing policy link
+			if ( !materialRef->IsTranslucency() )	// TODO yehor.pohuliaka - Need implement normal translucency support in the render
+			{
+				DepthDrawingPolicyLinkRef_t		depthDrawingPolicyLink		= ::MakeDrawingPolicyLink<DepthDrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.depthDrawList, DEC_STATIC_MESH );
+				element->depthDrawingPolicyLinks.push_back( depthDrawingPolicyLink );
+				meshBatchLinks.push_back( meshBatchLink );
+			}
 
-		// Make and add to scene new hit proxy drawing policy link
+			// Make and add to scene new hit proxy drawing policy link
 #if ENABLE_HITPROXY
-		HitProxyDrawingPolicyLinkRef_t		hitProxyDrawingPolicyLink	= ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.hitProxyLayers[ HPL_World ].hitProxyDrawList, DEC_STATIC_MESH );
-		element->hitProxyDrawingPolicyLinks.push_back( hitProxyDrawingPolicyLink );
-		element->meshBatchLinks.push_back( meshBatchLink );
+			HitProxyDrawingPolicyLinkRef_t		hitProxyDrawingPolicyLink	= ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.hitProxyLayers[ HPL_World ].hitProxyDrawList, DEC_STATIC_MESH );
+			element->hitProxyDrawingPolicyLinks.push_back( hitProxyDrawingPolicyLink );
+			meshBatchLinks.push_back( meshBatchLink );
 #endif // ENABLE_HITPROXY
+		}
 	}
 
 	return element;
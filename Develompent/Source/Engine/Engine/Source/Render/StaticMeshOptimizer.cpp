@@ -0,0 +1,965 @@
+#include <unordered_map>
+#include <algorithm>
+
+#include "Logger/LoggerMacros.h"
+#include "Render/StaticMeshOptimizer.h"
+
+/**
+ * @ingroup Engine
+ * @brief Hash function of static mesh vertex for STL containers
+ */
+struct StaticMeshVertexHashFunction
+{
+	/**
+	 * @brief Calculate hash
+	 * @param InVertex	Vertex
+	 */
+	FORCEINLINE std::size_t operator()( const StaticMeshVertexType& InVertex ) const
+	{
+		return Sys_MemFastHash( &InVertex, sizeof( StaticMeshVertexType ) );
+	}
+};
+
+/**
+ * @ingroup Engine
+ * @brief Cluster of triangles for overdraw optimization
+ */
+struct OverdrawCluster
+{
+	uint32		firstTriangle;		/**< First triangle in cluster */
+	uint32		numTriangles;		/**< Number of triangles in cluster */
+	float		sortKey;			/**< Sort key, clusters which are facing outward from center of mesh are drawn first */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Hash function of vertex position for STL containers
+ */
+struct SimplifyPositionHashFunction
+{
+	/**
+	 * @brief Calculate hash
+	 * @param InPosition	Position
+	 */
+	FORCEINLINE std::size_t operator()( const Vector& InPosition ) const
+	{
+		return Sys_MemFastHash( &InPosition, sizeof( Vector ) );
+	}
+};
+
+/**
+ * @ingroup Engine
+ * @brief Quadric of error for mesh simplification
+ */
+struct SimplifyQuadric
+{
+	/**
+	 * @brief Constructor
+	 */
+	SimplifyQuadric()
+		: a2( 0.0 ), b2( 0.0 ), c2( 0.0 ), d2( 0.0 )
+		, ab( 0.0 ), ac( 0.0 ), ad( 0.0 )
+		, bc( 0.0 ), bd( 0.0 ), cd( 0.0 )
+		, weight( 0.0 )
+	{}
+
+	/**
+	 * @brief Add plane of triangle
+	 *
+	 * @param InNormal	Normalized normal of plane
+	 * @param InPoint	Point on plane
+	 * @param InWeight	Weight of plane (area of triangle)
+	 */
+	FORCEINLINE void AddPlane( const Vector& InNormal, const Vector& InPoint, double InWeight )
+	{
+		double		a = InNormal.x;
+		double		b = InNormal.y;
+		double		c = InNormal.z;
+		double		d = -( a * InPoint.x + b * InPoint.y + c * InPoint.z );
+
+		a2 += a * a * InWeight;		b2 += b * b * InWeight;		c2 += c * c * InWeight;		d2 += d * d * InWeight;
+		ab += a * b * InWeight;		ac += a * c * InWeight;		ad += a * d * InWeight;
+		bc += b * c * InWeight;		bd += b * d * InWeight;		cd += c * d * InWeight;
+		weight += InWeight;
+	}
+
+	/**
+	 * @brief Add other quadric
+	 * @param InOther	Other quadric
+	 */
+	FORCEINLINE void Add( const SimplifyQuadric& InOther )
+	{
+		a2 += InOther.a2;		b2 += InOther.b2;		c2 += InOther.c2;		d2 += InOther.d2;
+		ab += InOther.ab;		ac += InOther.ac;		ad += InOther.ad;
+		bc += InOther.bc;		bd += InOther.bd;		cd += InOther.cd;
+		weight += InOther.weight;
+	}
+
+	/**
+	 * @brief Evaluate squared distance from point to planes
+	 *
+	 * @param InPoint	Point
+	 * @return Return weighted average of squared distances to planes
+	 */
+	FORCEINLINE double Evaluate( const Vector& InPoint ) const
+	{
+		double		x = InPoint.x;
+		double		y = InPoint.y;
+		double		z = InPoint.z;
+		double		error = a2 * x * x + b2 * y * y + c2 * z * z + d2 +
+							2.0 * ( ab * x * y + ac * x * z + bc * y * z + ad * x + bd * y + cd * z );
+		return weight > 0.0 ? Max( error, 0.0 ) / weight : 0.0;
+	}
+
+	double		a2, b2, c2, d2;		/**< Diagonal of quadric matrix */
+	double		ab, ac, ad;			/**< Upper triangle of quadric matrix */
+	double		bc, bd, cd;			/**< Upper triangle of quadric matrix */
+	double		weight;				/**< Sum of weights of planes */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Candidate of edge collapse for mesh simplification
+ */
+struct SimplifyCollapse
+{
+	uint32		fromVertex;		/**< Vertex which is removed */
+	uint32		toVertex;		/**< Vertex which is left */
+	double		error;			/**< Error of collapse */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Flags of vertex for mesh simplification
+ */
+enum ESimplifyVertexFlags
+{
+	SVF_None	= 0,		/**< Vertex can be collapsed */
+	SVF_Seam	= 1 << 0,	/**< Position is shared by verteces with different attributes */
+	SVF_Border	= 1 << 1	/**< Vertex is on border or non manifold edge */
+};
+
+/*
+==================
+CalcForsythVertexScore
+==================
+*/
+static FORCEINLINE float CalcForsythVertexScore( int32 InCachePosition, uint32 InNumActiveTriangles )
+{
+	const float		cacheDecayPower		= 1.5f;
+	const float		lastTriangleScore	= 0.75f;
+	const float		valenceBoostScale	= 2.f;
+	const float		valenceBoostPower	= 0.5f;
+
+	// Vertex isn't used by any remaining triangle
+	if ( InNumActiveTriangles == 0 )
+	{
+		return -1.f;
+	}
+
+	float		score = 0.f;
+	if ( InCachePosition >= 0 )
+	{
+		// Verteces of last triangle have fixed score, so they don't win just because they are most recent
+		if ( InCachePosition < 3 )
+		{
+			score = lastTriangleScore;
+		}
+		else
+		{
+			const float		scaler = 1.f / ( MESHOPTIMIZER_LRU_CACHE_SIZE - 3 );
+			score = Math::Pow( 1.f - ( InCachePosition - 3 ) * scaler, cacheDecayPower );
+		}
+	}
+
+	// Bonus for verteces with few remaining triangles, to get rid of lone verteces
+	score += valenceBoostScale * Math::Pow( ( float )InNumActiveTriangles, -valenceBoostPower );
+	return score;
+}
+
+/*
+==================
+CStaticMeshOptimizer::Optimize
+==================
+*/
+void CStaticMeshOptimizer::Optimize( std::vector<StaticMeshVertexType>& InOutVerteces, std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshSurface>& InSurfaces, EStaticMeshVertexFormat InVertexFormat, StaticMeshOptimizationStats& OutStats )
+{
+	uint32		vertexStride = GetStaticMeshVertexStride( InVertexFormat );
+	OutStats.numVertecesBefore	= InOutVerteces.size();
+	OutStats.numIndeces			= InOutIndeces.size();
+	OutStats.acmrBefore			= CalcACMR( InOutIndeces, InOutVerteces.size() );
+	OutStats.numBytesBefore		= ( uint64 )InOutVerteces.size() * vertexStride + ( uint64 )InOutIndeces.size() * sizeof( uint32 );
+
+	// Verteces may be shared between surfaces only when all surfaces index from start of vertex buffer
+	bool		bCanRemapVerteces = true;
+	for ( uint32 index = 0, count = InSurfaces.size(); index < count; ++index )
+	{
+		if ( InSurfaces[index].baseVertexIndex != 0 )
+		{
+			bCanRemapVerteces = false;
+			break;
+		}
+	}
+
+	// Exact vertex dedup
+	if ( bCanRemapVerteces )
+	{
+		DeduplicateVerteces( InOutVerteces, InOutIndeces );
+	}
+
+	// Reorder triangles inside of each surface
+	std::vector<uint32>		surfaceIndeces;
+	for ( uint32 indexSurface = 0, numSurfaces = InSurfaces.size(); indexSurface < numSurfaces; ++indexSurface )
+	{
+		const StaticMeshSurface&	surface		= InSurfaces[indexSurface];
+		uint32						numIndeces	= surface.numPrimitives * 3;
+		if ( numIndeces == 0 || surface.firstIndex + numIndeces > InOutIndeces.size() )
+		{
+			continue;
+		}
+
+		surfaceIndeces.assign( InOutIndeces.begin() + surface.firstIndex, InOutIndeces.begin() + surface.firstIndex + numIndeces );
+		for ( uint32 index = 0; index < numIndeces; ++index )
+		{
+			surfaceIndeces[index] += surface.baseVertexIndex;
+		}
+
+		OptimizeVertexCache( surfaceIndeces, InOutVerteces.size() );
+		OptimizeOverdraw( surfaceIndeces, InOutVerteces );
+
+		for ( uint32 index = 0; index < numIndeces; ++index )
+		{
+			InOutIndeces[surface.firstIndex + index] = surfaceIndeces[index] - surface.baseVertexIndex;
+		}
+	}
+
+	// Vertex fetch remap
+	if ( bCanRemapVerteces )
+	{
+		OptimizeVertexFetch( InOutVerteces, InOutIndeces );
+	}
+
+	OutStats.numVertecesAfter	= InOutVerteces.size();
+	OutStats.acmrAfter			= CalcACMR( InOutIndeces, InOutVerteces.size() );
+	OutStats.numBytesAfter		= ( uint64 )InOutVerteces.size() * vertexStride + ( uint64 )InOutIndeces.size() * GetStaticMeshIndexStride( InOutVerteces.size() );
+}
+
+/*
+==================
+CStaticMeshOptimizer::DeduplicateVerteces
+==================
+*/
+void CStaticMeshOptimizer::DeduplicateVerteces( std::vector<StaticMeshVertexType>& InOutVerteces, std::vector<uint32>& InOutIndeces )
+{
+	std::unordered_map<StaticMeshVertexType, uint32, StaticMeshVertexHashFunction>		uniqueVerteces;
+	std::vector<uint32>																	remap( InOutVerteces.size() );
+	std::vector<StaticMeshVertexType>													newVerteces;
+	uniqueVerteces.reserve( InOutVerteces.size() );
+	newVerteces.reserve( InOutVerteces.size() );
+
+	for ( uint32 index = 0, count = InOutVerteces.size(); index < count; ++index )
+	{
+		auto		itVertex = uniqueVerteces.find( InOutVerteces[index] );
+		if ( itVertex != uniqueVerteces.end() )
+		{
+			remap[index] = itVertex->second;
+		}
+		else
+		{
+			remap[index] = newVerteces.size();
+			uniqueVerteces.insert( std::make_pair( InOutVerteces[index], remap[index] ) );
+			newVerteces.push_back( InOutVerteces[index] );
+		}
+	}
+
+	// Nothing to remove
+	if ( newVerteces.size() == InOutVerteces.size() )
+	{
+		return;
+	}
+
+	for ( uint32 index = 0, count = InOutIndeces.size(); index < count; ++index )
+	{
+		InOutIndeces[index] = remap[InOutIndeces[index]];
+	}
+	InOutVerteces.swap( newVerteces );
+}
+
+/*
+==================
+CStaticMeshOptimizer::OptimizeVertexCache
+==================
+*/
+void CStaticMeshOptimizer::OptimizeVertexCache( std::vector<uint32>& InOutIndeces, uint32 InNumVerteces )
+{
+	uint32		numTriangles = InOutIndeces.size() / 3;
+	if ( numTriangles == 0 )
+	{
+		return;
+	}
+
+	// Build adjacency of verteces to triangles
+	std::vector<uint32>		numActiveTriangles( InNumVerteces, 0 );
+	std::vector<uint32>		triangleOffsets( InNumVerteces + 1, 0 );
+	std::vector<uint32>		vertexTriangles( numTriangles * 3 );
+	for ( uint32 index = 0, count = numTriangles * 3; index < count; ++index )
+	{
+		++numActiveTriangles[InOutIndeces[index]];
+	}
+
+	for ( uint32 index = 0; index < InNumVerteces; ++index )
+	{
+		triangleOffsets[index + 1] = triangleOffsets[index] + numActiveTriangles[index];
+	}
+
+	{
+		std::vector<uint32>		fillOffsets( triangleOffsets.begin(), triangleOffsets.end() - 1 );
+		for ( uint32 index = 0, count = numTriangles * 3; index < count; ++index )
+		{
+			vertexTriangles[fillOffsets[InOutIndeces[index]]++] = index / 3;
+		}
+	}
+
+	// Initialize scores
+	std::vector<int32>		cachePositions( InNumVerteces, -1 );
+	std::vector<float>		vertexScores( InNumVerteces );
+	std::vector<float>		triangleScores( numTriangles, 0.f );
+	std::vector<bool>		bTriangleAdded( numTriangles, false );
+	for ( uint32 index = 0; index < InNumVerteces; ++index )
+	{
+		vertexScores[index] = CalcForsythVertexScore( -1, numActiveTriangles[index] );
+	}
+
+	for ( uint32 index = 0; index < numTriangles; ++index )
+	{
+		triangleScores[index] = vertexScores[InOutIndeces[index * 3 + 0]] + vertexScores[InOutIndeces[index * 3 + 1]] + vertexScores[InOutIndeces[index * 3 + 2]];
+	}
+
+	// Emit triangles by the best score
+	std::vector<uint32>		newIndeces;
+	std::vector<uint32>		cache;
+	std::vector<uint32>		newCache;
+	uint32					scanPosition	= 0;
+	int32					bestTriangle	= -1;
+	newIndeces.reserve( numTriangles * 3 );
+	cache.reserve( MESHOPTIMIZER_LRU_CACHE_SIZE + 3 );
+	newCache.reserve( MESHOPTIMIZER_LRU_CACHE_SIZE + 3 );
+
+	for ( uint32 numAdded = 0; numAdded < numTriangles; ++numAdded )
+	{
+		// If no candidate in cache, take the best of remaining triangles
+		if ( bestTriangle < 0 )
+		{
+			float	bestScore = -1.f;
+			for ( uint32 index = scanPosition; index < numTriangles; ++index )
+			{
+				if ( !bTriangleAdded[index] && triangleScores[index] > bestScore )
+				{
+					bestScore		= triangleScores[index];
+					bestTriangle	= index;
+				}
+			}
+
+			// Triangles before first not added triangle never will be checked again
+			while ( scanPosition < numTriangles && bTriangleAdded[scanPosition] )
+			{
+				++scanPosition;
+			}
+		}
+		Assert( bestTriangle >= 0 );
+
+		// Emit triangle and remove it from adjacency of its verteces
+		const uint32*		triangle = &InOutIndeces[bestTriangle * 3];
+		bTriangleAdded[bestTriangle] = true;
+		newCache.clear();
+		for ( uint32 corner = 0; corner < 3; ++corner )
+		{
+			uint32		vertex		= triangle[corner];
+			uint32*		triangles	= &vertexTriangles[triangleOffsets[vertex]];
+			for ( uint32 index = 0; index < numActiveTriangles[vertex]; ++index )
+			{
+				if ( triangles[index] == ( uint32 )bestTriangle )
+				{
+					std::swap( triangles[index], triangles[numActiveTriangles[vertex] - 1] );
+					break;
+				}
+			}
+
+			--numActiveTriangles[vertex];
+			newIndeces.push_back( vertex );
+			newCache.push_back( vertex );
+		}
+
+		// Update LRU cache, verteces of emitted triangle are moved to front
+		for ( uint32 index = 0, count = cache.size(); index < count; ++index )
+		{
+			uint32		vertex = cache[index];
+			if ( vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2] )
+			{
+				newCache.push_back( vertex );
+			}
+		}
+		cache.swap( newCache );
+
+		// Update scores of verteces in cache and verteces pushed out of cache
+		for ( uint32 index = 0, count = cache.size(); index < count; ++index )
+		{
+			uint32		vertex	= cache[index];
+			int32		position = index < MESHOPTIMIZER_LRU_CACHE_SIZE ? ( int32 )index : -1;
+			cachePositions[vertex]	= position;
+			float		newScore = CalcForsythVertexScore( position, numActiveTriangles[vertex] );
+			float		deltaScore = newScore - vertexScores[vertex];
+			vertexScores[vertex] = newScore;
+
+			for ( uint32 indexTriangle = 0; indexTriangle < numActiveTriangles[vertex]; ++indexTriangle )
+			{
+				triangleScores[vertexTriangles[triangleOffsets[vertex] + indexTriangle]] += deltaScore;
+			}
+		}
+
+		if ( cache.size() > MESHOPTIMIZER_LRU_CACHE_SIZE )
+		{
+			cache.resize( MESHOPTIMIZER_LRU_CACHE_SIZE );
+		}
+
+		// Find the best triangle among adjacent to verteces in cache
+		float		bestScore = -1.f;
+		bestTriangle = -1;
+		for ( uint32 index = 0, count = cache.size(); index < count; ++index )
+		{
+			uint32		vertex = cache[index];
+			for ( uint32 indexTriangle = 0; indexTriangle < numActiveTriangles[vertex]; ++indexTriangle )
+			{
+				uint32		triangleId = vertexTriangles[triangleOffsets[vertex] + indexTriangle];
+				if ( triangleScores[triangleId] > bestScore )
+				{
+					bestScore		= triangleScores[triangleId];
+					bestTriangle	= triangleId;
+				}
+			}
+		}
+	}
+
+	InOutIndeces.swap( newIndeces );
+}
+
+/*
+==================
+CStaticMeshOptimizer::OptimizeOverdraw
+==================
+*/
+void CStaticMeshOptimizer::OptimizeOverdraw( std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshVertexType>& InVerteces, float InThreshold /* = MESHOPTIMIZER_OVERDRAW_THRESHOLD */ )
+{
+	uint32		numTriangles = InOutIndeces.size() / 3;
+	if ( numTriangles < 2 )
+	{
+		return;
+	}
+
+	// Split triangles into clusters on hard boundaries, where cache simulation misses all three verteces
+	std::vector<OverdrawCluster>	clusters;
+	{
+		std::vector<uint32>		cacheTimestamps( InVerteces.size(), 0 );
+		uint32					timestamp = MESHOPTIMIZER_FIFO_CACHE_SIZE + 1;
+		for ( uint32 indexTriangle = 0; indexTriangle < numTriangles; ++indexTriangle )
+		{
+			uint32		numMisses = 0;
+			for ( uint32 corner = 0; corner < 3; ++corner )
+			{
+				uint32		vertex = InOutIndeces[indexTriangle * 3 + corner];
+				if ( timestamp - cacheTimestamps[vertex] > MESHOPTIMIZER_FIFO_CACHE_SIZE )
+				{
+					cacheTimestamps[vertex] = timestamp++;
+					++numMisses;
+				}
+			}
+
+			if ( indexTriangle == 0 || numMisses == 3 )
+			{
+				clusters.push_back( OverdrawCluster{ indexTriangle, 0, 0.f } );
+			}
+			++clusters.back().numTriangles;
+		}
+	}
+
+	if ( clusters.size() < 2 )
+	{
+		return;
+	}
+
+	// Calculate center of mesh
+	Vector		meshCenter( 0.f, 0.f, 0.f );
+	float		meshArea = 0.f;
+	for ( uint32 indexTriangle = 0; indexTriangle < numTriangles; ++indexTriangle )
+	{
+		Vector		v0		= Vector( InVerteces[InOutIndeces[indexTriangle * 3 + 0]].position );
+		Vector		v1		= Vector( InVerteces[InOutIndeces[indexTriangle * 3 + 1]].position );
+		Vector		v2		= Vector( InVerteces[InOutIndeces[indexTriangle * 3 + 2]].position );
+		float		area	= glm::length( glm::cross( v1 - v0, v2 - v0 ) );
+		meshCenter			+= ( v0 + v1 + v2 ) * ( area / 3.f );
+		meshArea			+= area;
+	}
+	meshCenter = meshArea > 0.f ? meshCenter / meshArea : meshCenter;
+
+	// Sort key of cluster is how much its area weighted normal is facing outward from center of mesh
+	for ( uint32 indexCluster = 0, numClusters = clusters.size(); indexCluster < numClusters; ++indexCluster )
+	{
+		OverdrawCluster&	cluster			= clusters[indexCluster];
+		Vector				clusterCenter( 0.f, 0.f, 0.f );
+		Vector				clusterNormal( 0.f, 0.f, 0.f );
+		float				clusterArea		= 0.f;
+		for ( uint32 indexTriangle = cluster.firstTriangle, lastTriangle = cluster.firstTriangle + cluster.numTriangles; indexTriangle < lastTriangle; ++indexTriangle )
+		{
+			Vector		v0		= Vector( InVerteces[InOutIndeces[indexTriangle * 3 + 0]].position );
+			Vector		v1		= Vector( InVerteces[InOutIndeces[indexTriangle * 3 + 1]].position );
+			Vector		v2		= Vector( InVerteces[InOutIndeces[indexTriangle * 3 + 2]].position );
+			Vector		normal	= glm::cross( v1 - v0, v2 - v0 );
+			float		area	= glm::length( normal );
+			clusterCenter		+= ( v0 + v1 + v2 ) * ( area / 3.f );
+			clusterNormal		+= normal;
+			clusterArea			+= area;
+		}
+
+		float		normalLength = glm::length( clusterNormal );
+		if ( clusterArea > 0.f && normalLength > 0.f )
+		{
+			cluster.sortKey = glm::dot( clusterCenter / clusterArea - meshCenter, clusterNormal / normalLength );
+		}
+	}
+
+	std::stable_sort( clusters.begin(), clusters.end(), []( const OverdrawCluster& InA, const OverdrawCluster& InB )
+					  {
+						  return InA.sortKey > InB.sortKey;
+					  } );
+
+	// Rebuild indeces in order of clusters
+	std::vector<uint32>		newIndeces;
+	newIndeces.reserve( InOutIndeces.size() );
+	for ( uint32 indexCluster = 0, numClusters = clusters.size(); indexCluster < numClusters; ++indexCluster )
+	{
+		const OverdrawCluster&	cluster = clusters[indexCluster];
+		newIndeces.insert( newIndeces.end(), InOutIndeces.begin() + cluster.firstTriangle * 3, InOutIndeces.begin() + ( cluster.firstTriangle + cluster.numTriangles ) * 3 );
+	}
+
+	// Keep new order only if vertex cache efficiency isn't lost too much
+	if ( CalcACMR( newIndeces, InVerteces.size() ) <= CalcACMR( InOutIndeces, InVerteces.size() ) * InThreshold )
+	{
+		InOutIndeces.swap( newIndeces );
+	}
+}
+
+/*
+==================
+CStaticMeshOptimizer::OptimizeVertexFetch
+==================
+*/
+void CStaticMeshOptimizer::OptimizeVertexFetch( std::vector<StaticMeshVertexType>& InOutVerteces, std::vector<uint32>& InOutIndeces )
+{
+	std::vector<uint32>					remap( InOutVerteces.size(), ( uint32 )INDEX_NONE );
+	std::vector<StaticMeshVertexType>	newVerteces;
+	newVerteces.reserve( InOutVerteces.size() );
+
+	for ( uint32 index = 0, count = InOutIndeces.size(); index < count; ++index )
+	{
+		uint32&		vertex = InOutIndeces[index];
+		if ( remap[vertex] == ( uint32 )INDEX_NONE )
+		{
+			remap[vertex] = newVerteces.size();
+			newVerteces.push_back( InOutVerteces[vertex] );
+		}
+		vertex = remap[vertex];
+	}
+
+	InOutVerteces.swap( newVerteces );
+}
+
+/*
+==================
+CStaticMeshOptimizer::CalcACMR
+==================
+*/
+float CStaticMeshOptimizer::CalcACMR( const std::vector<uint32>& InIndeces, uint32 InNumVerteces, uint32 InCacheSize /* = MESHOPTIMIZER_FIFO_CACHE_SIZE */ )
+{
+	uint32		numTriangles = InIndeces.size() / 3;
+	if ( numTriangles == 0 )
+	{
+		return 0.f;
+	}
+
+	// Simulate FIFO cache, vertex is in cache while less than InCacheSize other verteces were loaded after it
+	std::vector<uint32>		cacheTimestamps( InNumVerteces, 0 );
+	uint32					timestamp	= InCacheSize + 1;
+	uint32					numMisses	= 0;
+	for ( uint32 index = 0, count = numTriangles * 3; index < count; ++index )
+	{
+		uint32		vertex = InIndeces[index];
+		if ( timestamp - cacheTimestamps[vertex] > InCacheSize )
+		{
+			cacheTimestamps[vertex] = timestamp++;
+			++numMisses;
+		}
+	}
+
+	return ( float )numMisses / numTriangles;
+}
+
+/*
+==================
+CStaticMeshOptimizer::GenerateLODs
+==================
+*/
+void CStaticMeshOptimizer::GenerateLODs( const std::vector<StaticMeshVertexType>& InVerteces, std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshSurface>& InSurfaces, uint32 InNumLODs, std::vector<StaticMeshLOD>& OutLODs )
+{
+	OutLODs.resize( 1 );
+	OutLODs[0].screenSize	= 1.f;
+	OutLODs[0].surfaces		= InSurfaces;
+
+	// Every next LOD is drawn at half of screen size, so it can have twice bigger error
+	InNumLODs						= Clamp<uint32>( InNumLODs, 1, STATICMESH_MAX_LODS );
+	float					maxError = MESHOPTIMIZER_SIMPLIFY_MAX_ERROR;
+	std::vector<uint32>		surfaceIndeces;
+	for ( uint32 indexLOD = 1; indexLOD < InNumLODs; ++indexLOD )
+	{
+		const StaticMeshLOD		prevLOD			= OutLODs[indexLOD - 1];
+		uint32					firstNewIndex	= InOutIndeces.size();
+		StaticMeshLOD			newLOD;
+		newLOD.screenSize		= prevLOD.screenSize * MESHOPTIMIZER_LOD_SCREEN_SIZE_RATIO;
+
+		// Simplify each surface of previous LOD, indeces of new LOD are appended to the end of index buffer
+		for ( uint32 indexSurface = 0, numSurfaces = prevLOD.surfaces.size(); indexSurface < numSurfaces; ++indexSurface )
+		{
+			const StaticMeshSurface&	surface		= prevLOD.surfaces[indexSurface];
+			uint32						numIndeces	= surface.numPrimitives * 3;
+			if ( numIndeces == 0 || surface.firstIndex + numIndeces > InOutIndeces.size() )
+			{
+				continue;
+			}
+
+			surfaceIndeces.assign( InOutIndeces.begin() + surface.firstIndex, InOutIndeces.begin() + surface.firstIndex + numIndeces );
+			for ( uint32 index = 0; index < numIndeces; ++index )
+			{
+				surfaceIndeces[index] += surface.baseVertexIndex;
+			}
+
+			Simplify( surfaceIndeces, InVerteces, ( uint32 )( surface.numPrimitives * MESHOPTIMIZER_LOD_TRIANGLE_RATIO ) * 3, maxError );
+			if ( surfaceIndeces.empty() )
+			{
+				continue;
+			}
+			OptimizeVertexCache( surfaceIndeces, InVerteces.size() );
+
+			StaticMeshSurface			newSurface	= surface;
+			newSurface.firstIndex		= InOutIndeces.size();
+			newSurface.numPrimitives	= surfaceIndeces.size() / 3;
+			for ( uint32 index = 0, count = surfaceIndeces.size(); index < count; ++index )
+			{
+				InOutIndeces.push_back( surfaceIndeces[index] - surface.baseVertexIndex );
+			}
+			newLOD.surfaces.push_back( newSurface );
+		}
+
+		// If simplification can't reduce enough triangles, there is no reason for this and next LODs
+		uint32		numPrevPrimitives	= prevLOD.GetNumPrimitives();
+		uint32		numNewPrimitives	= newLOD.GetNumPrimitives();
+		if ( numNewPrimitives == 0 || numNewPrimitives > numPrevPrimitives * MESHOPTIMIZER_LOD_MIN_REDUCTION )
+		{
+			InOutIndeces.resize( firstNewIndex );
+			break;
+		}
+
+		OutLODs.push_back( newLOD );
+		maxError *= 2.f;
+	}
+}
+
+/*
+==================
+IsSimplifyTriangleFlipped
+==================
+*/
+static FORCEINLINE bool IsSimplifyTriangleFlipped( const Vector& InA, const Vector& InB, const Vector& InC, const Vector& InNewA )
+{
+	Vector		oldNormal		= Math::CrossVector( InB - InA, InC - InA );
+	Vector		newNormal		= Math::CrossVector( InB - InNewA, InC - InNewA );
+	float		oldLength		= Math::LengthVector( oldNormal );
+	float		newLength		= Math::LengthVector( newNormal );
+	float		sumEdgesSquared	= Math::DotProduct( InB - InNewA, InB - InNewA ) + Math::DotProduct( InC - InNewA, InC - InNewA ) + Math::DotProduct( InC - InB, InC - InB );
+
+	// Sliver triangle after collapse (normal of it is unstable) or normal is rotated too much
+	return newLength <= 0.01f * sumEdgesSquared || Math::DotProduct( oldNormal, newNormal ) < 0.25f * oldLength * newLength;
+}
+
+/*
+==================
+CStaticMeshOptimizer::Simplify
+==================
+*/
+void CStaticMeshOptimizer::Simplify( std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshVertexType>& InVerteces, uint32 InTargetNumIndeces, float InMaxError /* = MESHOPTIMIZER_SIMPLIFY_MAX_ERROR */ )
+{
+	uint32		numVerteces = InVerteces.size();
+	if ( InOutIndeces.size() <= InTargetNumIndeces || numVerteces == 0 )
+	{
+		return;
+	}
+
+	// Weld verteces by position, every vertex gets id of the first vertex with same position.
+	// If position is shared by different verteces, it is attribute seam
+	std::unordered_map<Vector, uint32, SimplifyPositionHashFunction>		positionMap;
+	std::vector<uint32>														positionIds( numVerteces, INDEX_NONE );
+	std::vector<byte>														vertexFlags( numVerteces, SVF_None );		// Flags are stored only in first vertex of position
+	Vector																	minPosition = Vector( InVerteces[InOutIndeces[0]].position );
+	Vector																	maxPosition = minPosition;
+	for ( uint32 index = 0, count = InOutIndeces.size(); index < count; ++index )
+	{
+		uint32		vertexIndex = InOutIndeces[index];
+		if ( positionIds[vertexIndex] != INDEX_NONE )
+		{
+			continue;
+		}
+
+		Vector		position = Vector( InVerteces[vertexIndex].position );
+		auto		itPosition = positionMap.find( position );
+		if ( itPosition == positionMap.end() )
+		{
+			positionMap[position]		= vertexIndex;
+			positionIds[vertexIndex]	= vertexIndex;
+		}
+		else
+		{
+			positionIds[vertexIndex]				= itPosition->second;
+			vertexFlags[itPosition->second]			|= SVF_Seam;
+		}
+
+		minPosition = glm::min( minPosition, position );
+		maxPosition = glm::max( maxPosition, position );
+	}
+
+	// Lock verteces on borders and non manifold edges
+	{
+		std::unordered_map<uint64, uint32>		edgeCounts;
+		for ( uint32 index = 0, count = InOutIndeces.size(); index < count; ++index )
+		{
+			uint32		a		= positionIds[InOutIndeces[index]];
+			uint32		b		= positionIds[InOutIndeces[index % 3 == 2 ? index - 2 : index + 1]];
+			uint64		edgeKey = a < b ? ( ( uint64 )a << 32 ) | b : ( ( uint64 )b << 32 ) | a;
+			++edgeCounts[edgeKey];
+		}
+
+		for ( auto itEdge = edgeCounts.begin(), itEdgeEnd = edgeCounts.end(); itEdge != itEdgeEnd; ++itEdge )
+		{
+			if ( itEdge->second != 2 )
+			{
+				vertexFlags[( uint32 )( itEdge->first >> 32 )]			|= SVF_Border;
+				vertexFlags[( uint32 )( itEdge->first & 0xFFFFFFFF )]	|= SVF_Border;
+			}
+		}
+	}
+
+	// Accumulate quadrics of triangle planes, weighted by area
+	std::vector<SimplifyQuadric>		quadrics( numVerteces );
+	for ( uint32 index = 0, count = InOutIndeces.size(); index < count; index += 3 )
+	{
+		Vector		a		= Vector( InVerteces[InOutIndeces[index]].position );
+		Vector		b		= Vector( InVerteces[InOutIndeces[index + 1]].position );
+		Vector		c		= Vector( InVerteces[InOutIndeces[index + 2]].position );
+		Vector		normal	= Math::CrossVector( b - a, c - a );
+		float		length	= Math::LengthVector( normal );
+		if ( length <= 0.f )
+		{
+			continue;
+		}
+
+		normal /= length;
+		for ( uint32 indexCorner = 0; indexCorner < 3; ++indexCorner )
+		{
+			quadrics[positionIds[InOutIndeces[index + indexCorner]]].AddPlane( normal, a, length * 0.5 );
+		}
+	}
+
+	double		maxError			= InMaxError * Math::LengthVector( maxPosition - minPosition );
+	double		maxErrorSquared		= maxError * maxError;
+	uint32		numTargetTriangles	= InTargetNumIndeces / 3;
+
+	std::vector<uint32>				indeces = InOutIndeces;
+	std::vector<uint32>				remap( numVerteces );
+	std::vector<uint32>				triangleOffsets( numVerteces + 1 );
+	std::vector<uint32>				triangleList;
+	std::vector<SimplifyCollapse>	collapses;
+	std::vector<bool>				bTouched( numVerteces );
+	while ( indeces.size() / 3 > numTargetTriangles )
+	{
+		// Build list of triangles adjacent to each vertex
+		uint32		numTriangles = indeces.size() / 3;
+		std::fill( triangleOffsets.begin(), triangleOffsets.end(), 0 );
+		for ( uint32 index = 0, count = indeces.size(); index < count; ++index )
+		{
+			++triangleOffsets[indeces[index] + 1];
+		}
+		for ( uint32 index = 0; index < numVerteces; ++index )
+		{
+			triangleOffsets[index + 1] += triangleOffsets[index];
+		}
+
+		triangleList.resize( indeces.size() );
+		{
+			std::vector<uint32>		triangleCursors( triangleOffsets.begin(), triangleOffsets.end() - 1 );
+			for ( uint32 index = 0, count = indeces.size(); index < count; ++index )
+			{
+				triangleList[triangleCursors[indeces[index]]++] = index / 3;
+			}
+		}
+
+		// Collect candidates of edge collapses. Vertex may be collapsed only if it isn't locked,
+		// and we can't collapse on seam because triangles on other side of seam have other attributes
+		collapses.clear();
+		for ( uint32 index = 0, count = indeces.size(); index < count; ++index )
+		{
+			uint32		edgeVerteces[2] = { indeces[index], indeces[index % 3 == 2 ? index - 2 : index + 1] };
+			if ( positionIds[edgeVerteces[0]] == positionIds[edgeVerteces[1]] )
+			{
+				continue;
+			}
+
+			for ( uint32 indexDirection = 0; indexDirection < 2; ++indexDirection )
+			{
+				uint32		fromVertex	= edgeVerteces[indexDirection];
+				uint32		toVertex	= edgeVerteces[indexDirection ^ 1];
+				if ( vertexFlags[positionIds[fromVertex]] != SVF_None || ( vertexFlags[positionIds[toVertex]] & SVF_Seam ) )
+				{
+					continue;
+				}
+
+				SimplifyQuadric		quadric = quadrics[fromVertex];
+				quadric.Add( quadrics[positionIds[toVertex]] );
+
+				double				error = quadric.Evaluate( Vector( InVerteces[toVertex].position ) );
+				if ( error <= maxErrorSquared )
+				{
+					collapses.push_back( SimplifyCollapse{ fromVertex, toVertex, error } );
+				}
+			}
+		}
+
+		std::sort( collapses.begin(), collapses.end(), []( const SimplifyCollapse& InA, const SimplifyCollapse& InB )
+				   {
+					   return InA.error < InB.error;
+				   } );
+
+		// Collapse edges with the smallest error. After collapse all verteces around are touched,
+		// so adjacency and positions used by flip test stay valid until end of the pass
+		for ( uint32 index = 0; index < numVerteces; ++index )
+		{
+			remap[index] = index;
+		}
+		std::fill( bTouched.begin(), bTouched.end(), false );
+
+		uint32		numCollapses = 0;
+		for ( uint32 indexCollapse = 0, numCandidates = collapses.size(); indexCollapse < numCandidates && numTriangles > numTargetTriangles; ++indexCollapse )
+		{
+			const SimplifyCollapse&		collapse	= collapses[indexCollapse];
+			uint32						toPosition	= positionIds[collapse.toVertex];
+			if ( bTouched[collapse.fromVertex] || bTouched[toPosition] )
+			{
+				continue;
+			}
+
+			// Check that no one triangle will be flipped
+			Vector		newPosition		= Vector( InVerteces[collapse.toVertex].position );
+			bool		bFlipped		= false;
+			uint32		numRemoved		= 0;
+			for ( uint32 indexAdjacent = triangleOffsets[collapse.fromVertex], countAdjacent = triangleOffsets[collapse.fromVertex + 1]; indexAdjacent < countAdjacent; ++indexAdjacent )
+			{
+				uint32		firstIndex	= triangleList[indexAdjacent] * 3;
+				uint32		corner		= indeces[firstIndex] == collapse.fromVertex ? 0 : ( indeces[firstIndex + 1] == collapse.fromVertex ? 1 : 2 );
+				uint32		b			= indeces[firstIndex + ( corner + 1 ) % 3];
+				uint32		c			= indeces[firstIndex + ( corner + 2 ) % 3];
+				if ( positionIds[b] == toPosition || positionIds[c] == toPosition )
+				{
+					++numRemoved;
+					continue;
+				}
+
+				if ( IsSimplifyTriangleFlipped( Vector( InVerteces[collapse.fromVertex].position ), Vector( InVerteces[b].position ), Vector( InVerteces[c].position ), newPosition ) )
+				{
+					bFlipped = true;
+					break;
+				}
+			}
+
+			if ( bFlipped )
+			{
+				continue;
+			}
+
+			for ( uint32 indexAdjacent = triangleOffsets[collapse.fromVertex], countAdjacent = triangleOffsets[collapse.fromVertex + 1]; indexAdjacent < countAdjacent; ++indexAdjacent )
+			{
+				uint32		firstIndex = triangleList[indexAdjacent] * 3;
+				for ( uint32 indexCorner = 0; indexCorner < 3; ++indexCorner )
+				{
+					bTouched[positionIds[indeces[firstIndex + indexCorner]]] = true;
+				}
+			}
+
+			remap[collapse.fromVertex] = collapse.toVertex;
+			quadrics[toPosition].Add( quadrics[collapse.fromVertex] );
+			numTriangles -= numRemoved;
+			++numCollapses;
+		}
+
+		if ( numCollapses == 0 )
+		{
+			break;
+		}
+
+		// Apply collapses and remove degenerate triangles
+		uint32		numIndeces = 0;
+		for ( uint32 index = 0, count = indeces.size(); index < count; index += 3 )
+		{
+			uint32		a = remap[indeces[index]];
+			uint32		b = remap[indeces[index + 1]];
+			uint32		c = remap[indeces[index + 2]];
+			if ( positionIds[a] == positionIds[b] || positionIds[b] == positionIds[c] || positionIds[a] == positionIds[c] )
+			{
+				continue;
+			}
+
+			indeces[numIndeces++] = a;
+			indeces[numIndeces++] = b;
+			indeces[numIndeces++] = c;
+		}
+		indeces.resize( numIndeces );
+	}
+
+	InOutIndeces = indeces;
+}
+
+/*
+==================
+CStaticMeshOptimizer::LogStats
+==================
+*/
+void CStaticMeshOptimizer::LogStats( const std::wstring& InMeshName, const StaticMeshOptimizationStats& InStats )
+{
+	Logf( TEXT( "Optimized mesh '%s': verteces %i -> %i, triangles %i, ACMR %.3f -> %.3f, index size %i bytes, saved %lld bytes (%.2f Kb -> %.2f Kb)\n" ),
+		  InMeshName.c_str(),
+		  InStats.numVertecesBefore, InStats.numVertecesAfter,
+		  InStats.numIndeces / 3,
+		  InStats.acmrBefore, InStats.acmrAfter,
+		  GetStaticMeshIndexStride( InStats.numVertecesAfter ),
+		  InStats.GetNumSavedBytes(),
+		  InStats.numBytesBefore / 1024.f, InStats.numBytesAfter / 1024.f );
+}
+
+/*
+==================
+CStaticMeshOptimizer::LogLODs
+==================
+*/
+void CStaticMeshOptimizer::LogLODs( const std::wstring& InMeshName, const std::vector<StaticMeshLOD>& InLODs )
+{
+	Logf( TEXT( "Generated %i LODs for mesh '%s'\n" ), ( uint32 )InLODs.size(), InMeshName.c_str() );
+	for ( uint32 index = 0, count = InLODs.size(); index < count; ++index )
+	{
+		Logf( TEXT( "  LOD%i: triangles %i, screen size %.3f\n" ), index, InLODs[index].GetNumPrimitives(), InLODs[index].screenSize );
+	}
+}
\ No newline at end of file
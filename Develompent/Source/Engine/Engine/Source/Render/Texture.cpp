@@ -5,75 +5,40 @@
 #include "System/BaseFileSystem.h"
 #include "Logger/LoggerMacros.h"
 #include "Misc/EngineGlobals.h"
+#include "Misc/Stats.h"
 #include "Render/Texture.h"
 #include "Render/RenderUtils.h"
+#include "Render/RenderingThread.h"
+#include "Render/TextureStreaming.h"
 #include "RHI/BaseRHI.h"
 #include "RHI/BaseSurfaceRHI.h"
 
 #if WITH_EDITOR
-#include <compressonator.h>
-
-/*
-==================
-ConvertEPixelFormatToCmpFormat
-==================
-*/
-static CMP_FORMAT ConvertEPixelFormatToCmpFormat( EPixelFormat InPixelFormat )
-{
-	switch ( InPixelFormat )
-	{
-	case PF_A8R8G8B8:			return CMP_FORMAT_ARGB_8888;
-	case PF_FloatRGB:			return CMP_FORMAT_RGB_32F;
-	case PF_FloatRGBA:			return CMP_FORMAT_RGBA_32F;
-	case PF_R32F:				return CMP_FORMAT_R_32F;
-	case PF_BC1:				return CMP_FORMAT_BC1;
-	case PF_BC2:				return CMP_FORMAT_BC2;
-	case PF_BC3:				return CMP_FORMAT_BC3;
-	case PF_BC5:				return CMP_FORMAT_BC5;
-	case PF_BC6H:				return CMP_FORMAT_BC6H;
-	case PF_BC7:				return CMP_FORMAT_BC7;
-
-	case PF_DepthStencil:
-	case PF_ShadowDepth:
-	case PF_FilteredShadowDepth:
-	case PF_D32:
-	default:
-		Sys_Errorf( TEXT( "Unsupported EPixelFormat %i" ), ( uint32 )InPixelFormat );
-		return CMP_FORMAT_Unknown;
-	}
-}
-
 /*
 ==================
 GenerateMipmapsMemory
 ==================
 */
-static void GenerateMipmapsMemory( EPixelFormat InPixelFormat, const Texture2DMipMap& InZeroMip, std::vector<Texture2DMipMap>& OutMipmaps, uint32 InRequestMips = 10 )
+static void GenerateMipmapsMemory( EPixelFormat InPixelFormat, const Texture2DMipMap& InZeroMip, std::vector<Texture2DMipMap>& OutMipmaps, const MipGenerationSettings& InSettings = MipGenerationSettings() )
 {
-	CMP_MipSet cmp_MipSet;
-	Sys_Memzero( &cmp_MipSet, sizeof( CMP_MipSet ) );
-	CMP_ERROR	result = CMP_CreateMipSet( &cmp_MipSet, InZeroMip.sizeX, InZeroMip.sizeY, 1, CF_8bit, TT_2D );
-	Assert( result == CMP_OK && ( *cmp_MipSet.m_pMipLevelTable )->m_dwLinearSize == InZeroMip.data.Num() );
-
-	// Copy data to mipmap0
-	memcpy( ( *cmp_MipSet.m_pMipLevelTable )->m_pbData, ( CMP_BYTE* )InZeroMip.data.GetData(), InZeroMip.data.Num() );
-
-	// Generate mip levels and copy him to OutMipmaps
-	CMP_GenerateMIPLevels( &cmp_MipSet, CMP_CalcMinMipSize( InZeroMip.sizeY, InZeroMip.sizeX, InRequestMips ) );
-	for ( uint32 index = 0; index < cmp_MipSet.m_nMipLevels; index++ )
-	{
-		CMP_MipLevel*		cmp_mipLevel;
-		CMP_GetMipLevel( &cmp_mipLevel, &cmp_MipSet, index, 0 );
-
-		Texture2DMipMap	mipmap;
-		mipmap.sizeX		= cmp_mipLevel->m_nWidth;
-		mipmap.sizeY		= cmp_mipLevel->m_nWidth;
-		mipmap.data.Resize( cmp_mipLevel->m_dwLinearSize );
-		memcpy( mipmap.data.GetData(), cmp_mipLevel->m_pbData, cmp_mipLevel->m_dwLinearSize );
+	AssertMsg( InPixelFormat == PF_A8R8G8B8, TEXT( "Mipmaps generation supported only for PF_A8R8G8B8" ) );
+	std::vector<MipLevel>	mipLevels;
+	double					startTime = Sys_Seconds();
+	CMipGenerator::Generate( InZeroMip.data.GetData(), InZeroMip.sizeX, InZeroMip.sizeY, InSettings, mipLevels );
+
+	// Copy generated mip levels to OutMipmaps
+	for ( uint32 index = 0, count = mipLevels.size(); index < count; ++index )
+	{
+		const MipLevel&		mipLevel = mipLevels[index];
+		Texture2DMipMap		mipmap;
+		mipmap.sizeX		= mipLevel.sizeX;
+		mipmap.sizeY		= mipLevel.sizeY;
+		mipmap.data.Resize( mipLevel.data.size() );
+		memcpy( mipmap.data.GetData(), mipLevel.data.data(), mipLevel.data.size() );
 		OutMipmaps.push_back( mipmap );
 	}
 
-	CMP_FreeMipSet( &cmp_MipSet );
+	Logf( TEXT( "Generated %i mipmaps for %ix%i in %.2f ms\n" ), mipLevels.size(), InZeroMip.sizeX, InZeroMip.sizeY, ( Sys_Seconds() - startTime ) * 1000.0 );
 }
 #endif // WITH_EDITOR
 
@@ -89,6 +54,7 @@ CTexture2D::CTexture2D()
 	, addressU( SAM_Wrap )
 	, addressV( SAM_Wrap )
 	, samplerFilter( SF_Point )
+	, firstResidentMip( 0 )
 {}
 
 /*
@@ -97,7 +63,12 @@ CTexture2D::~CTexture2D
 ==================
 */
 CTexture2D::~CTexture2D()
-{}
+{
+	if ( IsStreamable() )
+	{
+		g_TextureStreamingManager.RemoveTexture( this );
+	}
+}
 
 /*
 ==================
@@ -106,13 +77,17 @@ CTexture2D::InitRHI
 */
 void CTexture2D::InitRHI()
 {
-	Assert( mipmaps.size() > 0 );
-	texture = g_RHI->CreateTexture2D( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), GetSizeX(), GetSizeY(), pixelFormat, mipmaps.size(), 0, nullptr );
+	Assert( firstResidentMip < mipmaps.size() );
 
-	// Load all mip-levels to GPU
-	for ( uint32 index = 0, count = mipmaps.size(); index < count; ++index )
+	// Streamable texture is created only with mips which was loaded from package
+	uint32		numMips = mipmaps.size() - firstResidentMip;
+	texture = g_RHI->CreateTexture2D( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), GetSizeX( firstResidentMip ), GetSizeY( firstResidentMip ), pixelFormat, numMips, 0, nullptr );
+	g_StatMemoryTextures.Add( CalcTextureSize( GetSizeX( firstResidentMip ), GetSizeY( firstResidentMip ), pixelFormat, numMips ) );
+
+	// Load all resident mip-levels to GPU
+	for ( uint32 index = 0; index < numMips; ++index )
 	{
-		const Texture2DMipMap&		mipmap				= mipmaps[index];
+		const Texture2DMipMap&		mipmap				= mipmaps[firstResidentMip + index];
 		CBaseDeviceContextRHI*		deviceContextRHI	= g_RHI->GetImmediateContext();
 		LockedData					lockedData;
 		
@@ -121,7 +96,8 @@ void CTexture2D::InitRHI()
 		g_RHI->UnlockTexture2D( deviceContextRHI, texture, index, lockedData );
 	}
 
-	if ( !g_IsEditor && !g_IsCommandlet )
+	// Cooker reads texels after upload for compress and save texture
+	if ( !g_IsEditor && !g_IsCommandlet && !g_IsCooker )
 	{
 		for ( uint32 index = 0, count = mipmaps.size(); index < count; ++index )
 		{
@@ -137,9 +113,53 @@ CTexture2D::ReleaseRHI
 */
 void CTexture2D::ReleaseRHI()
 {
+	if ( texture )
+	{
+		g_StatMemoryTextures.Add( -( int64 )CalcTextureSize( texture->GetSizeX(), texture->GetSizeY(), texture->GetFormat(), texture->GetNumMips() ) );
+	}
 	texture.SafeRelease();
 }
 
+/*
+==================
+CTexture2D::UpdateResidentMips
+==================
+*/
+void CTexture2D::UpdateResidentMips( uint32 InFirstMip, const std::vector<Texture2DMipMap>* InNewMips )
+{
+	Assert( IsInRenderingThread() && InFirstMip < mipmaps.size() );
+	if ( !texture || InFirstMip == firstResidentMip )
+	{
+		return;
+	}
+
+	// Create new texture and copy to him mips which is already in GPU memory
+	CBaseDeviceContextRHI*		deviceContextRHI	= g_RHI->GetImmediateContext();
+	uint32						numMips				= mipmaps.size() - InFirstMip;
+	Texture2DRHIRef_t			newTexture			= g_RHI->CreateTexture2D( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), GetSizeX( InFirstMip ), GetSizeY( InFirstMip ), pixelFormat, numMips, 0, nullptr );
+	g_RHI->CopySharedMips( deviceContextRHI, newTexture, texture );
+
+	// Upload new mips, they are placed before mips of old texture
+	if ( InNewMips )
+	{
+		Assert( InFirstMip < firstResidentMip && InNewMips->size() == firstResidentMip - InFirstMip );
+		for ( uint32 index = 0, count = InNewMips->size(); index < count; ++index )
+		{
+			const Texture2DMipMap&		mipmap = ( *InNewMips )[index];
+			LockedData					lockedData;
+
+			g_RHI->LockTexture2D( deviceContextRHI, newTexture, index, true, lockedData );
+			memcpy( lockedData.data, mipmap.data.GetData(), mipmap.data.Num() );
+			g_RHI->UnlockTexture2D( deviceContextRHI, newTexture, index, lockedData );
+		}
+	}
+
+	g_StatMemoryTextures.Add( -( int64 )CalcTextureSize( texture->GetSizeX(), texture->GetSizeY(), texture->GetFormat(), texture->GetNumMips() ) );
+	g_StatMemoryTextures.Add( CalcTextureSize( newTexture->GetSizeX(), newTexture->GetSizeY(), newTexture->GetFormat(), newTexture->GetNumMips() ) );
+	texture				= newTexture;
+	firstResidentMip	= InFirstMip;
+}
+
 /*
 ==================
 CTexture2D::SetData
@@ -177,13 +197,13 @@ void CTexture2D::SetData( EPixelFormat InPixelFormat, uint32 InSizeX, uint32 InS
 CTexture2D::GenerateMipmaps
 ==================
 */
-void CTexture2D::GenerateMipmaps()
+void CTexture2D::GenerateMipmaps( const MipGenerationSettings& InSettings /* = MipGenerationSettings() */ )
 {
 	Assert( !mipmaps.empty() );
 	Texture2DMipMap	mipmap0 = mipmaps[0];
 	mipmaps.clear();
 	
-	GenerateMipmapsMemory( pixelFormat, mipmap0, mipmaps );
+	GenerateMipmapsMemory( pixelFormat, mipmap0, mipmaps, InSettings );
 
 	MarkDirty();
 	BeginUpdateResource( this );
@@ -203,6 +223,21 @@ uint64 CTexture2D::GetMemorySize() const
 	}
 	return totalSize;
 }
+
+/*
+==================
+CTexture2D::SetMipmaps
+==================
+*/
+void CTexture2D::SetMipmaps( EPixelFormat InPixelFormat, const std::vector<Texture2DMipMap>& InMipmaps )
+{
+	Assert( !InMipmaps.empty() );
+	pixelFormat	= InPixelFormat;
+	mipmaps		= InMipmaps;
+
+	MarkDirty();
+	BeginUpdateResource( this );
+}
 #endif // WITH_EDITOR
 
 /*
@@ -215,9 +250,16 @@ void CTexture2D::Serialize( class CArchive& InArchive )
 	CAsset::Serialize( InArchive );
 
 	// Clear all mipmaps before loading
+	bool		bStreamable = false;
 	if ( InArchive.IsLoading() )
 	{
 		mipmaps.clear();
+		mipOffsets.clear();
+		firstResidentMip	= 0;
+
+		// High mips is streamed from package only in game
+		CPackage*	package	= GetPackage();
+		bStreamable			= InArchive.Ver() >= VER_Mipmaps && g_TextureStreamingManager.IsEnabled() && package && !package->GetFileName().empty();
 	}
 
 	if ( InArchive.Ver() < VER_Mipmaps )
@@ -232,6 +274,10 @@ void CTexture2D::Serialize( class CArchive& InArchive )
 		MakeReferenceToAsset( GetAssetHandle(), referenceToThisAsset );
 		Warnf( TEXT( "%s :: Deprecated package version, in future must be removed supports\n" ), referenceToThisAsset.c_str() );
 	}
+	else if ( bStreamable )
+	{
+		SerializeStreamableMips( InArchive );
+	}
 	else
 	{
 		InArchive << mipmaps;
@@ -245,6 +291,52 @@ void CTexture2D::Serialize( class CArchive& InArchive )
 	// If we loading Texture2D - update render resource
 	if ( InArchive.IsLoading() )
 	{
+		if ( IsStreamable() )
+		{
+			g_TextureStreamingManager.AddTexture( this, firstResidentMip );
+		}
 		BeginUpdateResource( this );
 	}
+}
+
+/*
+==================
+CTexture2D::SerializeStreamableMips
+==================
+*/
+void CTexture2D::SerializeStreamableMips( class CArchive& InArchive )
+{
+	Assert( InArchive.IsLoading() );
+
+	uint32		numMips = 0;
+	InArchive << numMips;
+	mipmaps.resize( numMips );
+	mipOffsets.resize( numMips );
+	firstResidentMip = 0;
+
+	// Mips larger then initial size is skipped, the last mip is always loaded
+	const uint32	initialMipSize = g_TextureStreamingManager.GetInitialMipSize();
+	for ( uint32 index = 0; index < numMips; ++index )
+	{
+		Texture2DMipMap&	mipmap = mipmaps[index];
+		InArchive << mipmap.sizeX;
+		InArchive << mipmap.sizeY;
+
+		mipOffsets[index] = InArchive.Tell();
+		if ( index + 1 < numMips && Max( mipmap.sizeX, mipmap.sizeY ) > initialMipSize )
+		{
+			mipmap.data.Skip( InArchive );
+			firstResidentMip = index + 1;
+		}
+		else
+		{
+			InArchive << mipmap.data;
+		}
+	}
+
+	// Texture without mips can't be streamed
+	if ( numMips <= 1 )
+	{
+		mipOffsets.clear();
+	}
 }
\ No newline at end of file
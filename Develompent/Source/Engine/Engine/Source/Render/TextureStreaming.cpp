@@ -0,0 +1,643 @@
+#include <algorithm>
+
+#include "Misc/CoreGlobals.h"
+#include "Misc/Stats.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Archive.h"
+#include "System/BaseFileSystem.h"
+#include "System/Config.h"
+#include "Render/TextureStreaming.h"
+#include "Render/Material.h"
+#include "Render/RenderUtils.h"
+#include "Render/RenderingThread.h"
+
+// -------------
+// GLOBALS
+// -------------
+CTextureStreamingManager		g_TextureStreamingManager;
+
+/*
+==================
+CTextureStreamingRunnable::CTextureStreamingRunnable
+==================
+*/
+CTextureStreamingRunnable::CTextureStreamingRunnable()
+	: requestEvent( nullptr )
+	, bStopping( false )
+{
+	requestEvent = g_SynchronizeFactory->CreateSynchEvent( false, TEXT( "TextureStreamingRequest" ) );
+	Assert( requestEvent );
+}
+
+/*
+==================
+CTextureStreamingRunnable::~CTextureStreamingRunnable
+==================
+*/
+CTextureStreamingRunnable::~CTextureStreamingRunnable()
+{
+	for ( auto it = pendingRequests.begin(), itEnd = pendingRequests.end(); it != itEnd; ++it )
+	{
+		delete *it;
+	}
+	for ( uint32 index = 0, count = completedRequests.size(); index < count; ++index )
+	{
+		delete completedRequests[index];
+	}
+
+	g_SynchronizeFactory->Destroy( requestEvent );
+}
+
+/*
+==================
+CTextureStreamingRunnable::Init
+==================
+*/
+bool CTextureStreamingRunnable::Init()
+{
+	return true;
+}
+
+/*
+==================
+CTextureStreamingRunnable::Run
+==================
+*/
+uint32 CTextureStreamingRunnable::Run()
+{
+	while ( true )
+	{
+		requestEvent->Wait();
+
+		// Load all pending requests
+		while ( true )
+		{
+			TextureStreamingRequest*	request = nullptr;
+			{
+				CScopeLock		scopeLock( &csRequests );
+				if ( bStopping )
+				{
+					return 0;
+				}
+
+				if ( pendingRequests.empty() )
+				{
+					break;
+				}
+
+				request = pendingRequests.front();
+				pendingRequests.pop_front();
+			}
+
+			LoadMips( request );
+			{
+				CScopeLock		scopeLock( &csRequests );
+				completedRequests.push_back( request );
+			}
+		}
+	}
+
+	return 0;
+}
+
+/*
+==================
+CTextureStreamingRunnable::Stop
+==================
+*/
+void CTextureStreamingRunnable::Stop()
+{
+	{
+		CScopeLock		scopeLock( &csRequests );
+		bStopping = true;
+	}
+	requestEvent->Trigger();
+}
+
+/*
+==================
+CTextureStreamingRunnable::Exit
+==================
+*/
+void CTextureStreamingRunnable::Exit()
+{}
+
+/*
+==================
+CTextureStreamingRunnable::AddRequest
+==================
+*/
+void CTextureStreamingRunnable::AddRequest( TextureStreamingRequest* InRequest )
+{
+	Assert( InRequest );
+	{
+		CScopeLock		scopeLock( &csRequests );
+		pendingRequests.push_back( InRequest );
+	}
+	requestEvent->Trigger();
+}
+
+/*
+==================
+CTextureStreamingRunnable::GetCompletedRequests
+==================
+*/
+void CTextureStreamingRunnable::GetCompletedRequests( std::vector<TextureStreamingRequest*>& OutRequests )
+{
+	CScopeLock		scopeLock( &csRequests );
+	OutRequests.insert( OutRequests.end(), completedRequests.begin(), completedRequests.end() );
+	completedRequests.clear();
+}
+
+/*
+==================
+CTextureStreamingRunnable::LoadMips
+==================
+*/
+void CTextureStreamingRunnable::LoadMips( TextureStreamingRequest* InOutRequest )
+{
+	InOutRequest->bSuccess = false;
+
+	CArchive*		archive = g_FileSystem->CreateFileReader( InOutRequest->filename );
+	if ( !archive )
+	{
+		Warnf( TEXT( "Failed to open package '%s' for stream texture mips\n" ), InOutRequest->filename.c_str() );
+		return;
+	}
+
+	// Serialize header of archive for get version of package, it's needed for load bulk data
+	archive->SerializeHeader();
+	for ( uint32 index = 0, count = InOutRequest->mips.size(); index < count; ++index )
+	{
+		archive->Seek( InOutRequest->mipOffsets[index] );
+		*archive << InOutRequest->mips[index].data;
+	}
+
+	delete archive;
+	InOutRequest->bSuccess = true;
+}
+
+
+/*
+==================
+CTextureStreamingManager::CTextureStreamingManager
+==================
+*/
+CTextureStreamingManager::CTextureStreamingManager()
+	: bEnabled( false )
+	, initialMipSize( TEXTURESTREAMING_DEFAULT_INITIAL_MIP_SIZE )
+	, poolSize( ( uint64 )TEXTURESTREAMING_DEFAULT_POOL_SIZE_MB * 1024 * 1024 )
+	, currentTime( 0.0 )
+	, nextRequestId( 1 )
+	, numPendingRequests( 0 )
+	, streamingRunnable( nullptr )
+	, streamingThread( nullptr )
+{}
+
+/*
+==================
+CTextureStreamingManager::Init
+==================
+*/
+void CTextureStreamingManager::Init()
+{
+	// Textures are streamed only in game, editor and commandlets need all mips in memory
+	bool			bAllowStreaming = true;
+	CConfigValue	configTextureStreaming = g_Config.GetValue( CT_Engine, TEXT( "Engine.SystemSettings" ), TEXT( "TextureStreaming" ) );
+	if ( configTextureStreaming.IsValid() )
+	{
+		bAllowStreaming = configTextureStreaming.GetBool();
+	}
+
+	CConfigValue	configPoolSize = g_Config.GetValue( CT_Engine, TEXT( "Engine.SystemSettings" ), TEXT( "TexturePoolSizeMB" ) );
+	if ( configPoolSize.IsValid() )
+	{
+		poolSize = ( uint64 )Max<int32>( configPoolSize.GetInt(), 1 ) * 1024 * 1024;
+	}
+
+	CConfigValue	configInitialMipSize = g_Config.GetValue( CT_Engine, TEXT( "Engine.SystemSettings" ), TEXT( "TextureStreamingInitialMipSize" ) );
+	if ( configInitialMipSize.IsValid() )
+	{
+		initialMipSize = Max<int32>( configInitialMipSize.GetInt(), 1 );
+	}
+
+	bEnabled = bAllowStreaming && !g_IsEditor && !g_IsCommandlet && !g_IsCooker;
+	if ( bEnabled )
+	{
+		streamingRunnable	= new CTextureStreamingRunnable();
+		streamingThread		= g_ThreadFactory->CreateThread( streamingRunnable, TEXT( "TextureStreaming" ), false, false, 0, TP_BelowNormal );
+		Assert( streamingThread );
+		Logf( TEXT( "Texture streaming enabled, pool size %.2f MB\n" ), poolSize / ( 1024.f * 1024.f ) );
+	}
+	g_StatStreamingPoolBudget.Set( bEnabled ? poolSize : 0 );
+}
+
+/*
+==================
+CTextureStreamingManager::Shutdown
+==================
+*/
+void CTextureStreamingManager::Shutdown()
+{
+	if ( !bEnabled )
+	{
+		return;
+	}
+
+	streamingRunnable->Stop();
+	streamingThread->WaitForCompletion();
+	streamingThread->Kill();
+	g_ThreadFactory->Destroy( streamingThread );
+	delete streamingRunnable;
+
+	streamingThread		= nullptr;
+	streamingRunnable	= nullptr;
+	numPendingRequests	= 0;
+	bEnabled			= false;
+
+	bool	bHasRenderUpdates = false;
+	{
+		CScopeLock		scopeLock( &csTextures );
+		for ( auto it = textures.begin(), itEnd = textures.end(); it != itEnd && !bHasRenderUpdates; ++it )
+		{
+			bHasRenderUpdates = it->second.numRenderUpdates > 0;
+		}
+		textures.clear();
+	}
+
+	// Updates of resident mips in flight own loaded mips, so let them complete
+	if ( bHasRenderUpdates )
+	{
+		FlushRenderingCommands();
+	}
+}
+
+/*
+==================
+CTextureStreamingManager::AddTexture
+==================
+*/
+void CTextureStreamingManager::AddTexture( CTexture2D* InTexture, uint32 InFirstResidentMip )
+{
+	Assert( InTexture && InTexture->IsStreamable() );
+	if ( !bEnabled )
+	{
+		return;
+	}
+
+	// If texture is reloaded, all previous requests will be ignored. Updates sent to rendering thread are still counted
+	CScopeLock				scopeLock( &csTextures );
+	StreamingTexture&		streamingTexture = textures[InTexture];
+	streamingTexture.baseMip			= InFirstResidentMip;
+	streamingTexture.residentMip		= InFirstResidentMip;
+	streamingTexture.wantedMip			= InFirstResidentMip;
+	streamingTexture.visibleMip			= ( uint32 )INDEX_NONE;
+	streamingTexture.pendingMip			= ( uint32 )INDEX_NONE;
+	streamingTexture.pendingRequestId	= 0;
+	streamingTexture.lastSeenTime		= currentTime;
+}
+
+/*
+==================
+CTextureStreamingManager::RemoveTexture
+==================
+*/
+void CTextureStreamingManager::RemoveTexture( CTexture2D* InTexture )
+{
+	if ( !bEnabled )
+	{
+		return;
+	}
+
+	bool	bHasRenderUpdates = false;
+	{
+		CScopeLock		scopeLock( &csTextures );
+		auto			itTexture = textures.find( InTexture );
+		if ( itTexture != textures.end() )
+		{
+			bHasRenderUpdates = itTexture->second.numRenderUpdates > 0;
+			textures.erase( itTexture );
+		}
+	}
+
+	// Rendering thread still may update resident mips of texture, wait it before texture is freed.
+	// Lock of textures must be released here, because render command completes update under the same lock
+	if ( bHasRenderUpdates )
+	{
+		FlushRenderingCommands();
+	}
+}
+
+/*
+==================
+CTextureStreamingManager::CompleteResidentMipsUpdate
+==================
+*/
+void CTextureStreamingManager::CompleteResidentMipsUpdate( CTexture2D* InTexture )
+{
+	// Texture may be removed while update was in flight
+	CScopeLock		scopeLock( &csTextures );
+	auto			itTexture = textures.find( InTexture );
+	if ( itTexture != textures.end() )
+	{
+		Assert( itTexture->second.numRenderUpdates > 0 );
+		--itTexture->second.numRenderUpdates;
+	}
+}
+
+/*
+==================
+CTextureStreamingManager::AddViewMaterial
+==================
+*/
+void CTextureStreamingManager::AddViewMaterial( const TAssetHandle<CMaterial>& InMaterial, float InScreenPixelSize )
+{
+	if ( !bEnabled )
+	{
+		return;
+	}
+
+	TSharedPtr<CMaterial>		materialRef = InMaterial.ToSharedPtr();
+	if ( !materialRef )
+	{
+		return;
+	}
+
+	const auto&		textureParameters = materialRef->GetTextureParameters();
+	for ( auto it = textureParameters.begin(), itEnd = textureParameters.end(); it != itEnd; ++it )
+	{
+		TSharedPtr<CTexture2D>		textureRef = it->second.ToSharedPtr();
+		if ( textureRef && textureRef->IsStreamable() )
+		{
+			AddViewTexture( textureRef.Get(), InScreenPixelSize );
+		}
+	}
+}
+
+/*
+==================
+CTextureStreamingManager::AddViewTexture
+==================
+*/
+void CTextureStreamingManager::AddViewTexture( CTexture2D* InTexture, float InScreenPixelSize )
+{
+	if ( !bEnabled )
+	{
+		return;
+	}
+
+	CScopeLock		scopeLock( &csTextures );
+	auto			itTexture = textures.find( InTexture );
+	if ( itTexture == textures.end() )
+	{
+		return;
+	}
+
+	// Wanted mip is the smallest mip which still covers primitive on screen
+	StreamingTexture&	streamingTexture	= itTexture->second;
+	uint32				wantedMip			= 0;
+	while ( wantedMip < streamingTexture.baseMip && Max( InTexture->GetSizeX( wantedMip + 1 ), InTexture->GetSizeY( wantedMip + 1 ) ) >= InScreenPixelSize )
+	{
+		++wantedMip;
+	}
+	streamingTexture.visibleMip = Min( streamingTexture.visibleMip, wantedMip );
+}
+
+/*
+==================
+CTextureStreamingManager::Tick
+==================
+*/
+void CTextureStreamingManager::Tick( float InDeltaSeconds )
+{
+	if ( !bEnabled )
+	{
+		return;
+	}
+
+	// Render commands are sent only after unlock of textures, because rendering thread adds view textures under the same lock
+	std::vector<ResidentMipsUpdate>		updates;
+	currentTime += InDeltaSeconds;
+	{
+		CScopeLock		scopeLock( &csTextures );
+		TickTextures( updates );
+
+		// Texture can't be freed until rendering thread executes all its updates, see RemoveTexture
+		for ( uint32 index = 0, count = updates.size(); index < count; ++index )
+		{
+			++textures[updates[index].texture].numRenderUpdates;
+		}
+	}
+
+	for ( uint32 index = 0, count = updates.size(); index < count; ++index )
+	{
+		const ResidentMipsUpdate&	update = updates[index];
+		UNIQUE_RENDER_COMMAND_THREEPARAMETER( CUpdateResidentMipsCommand,
+											  CTexture2D*, texture, update.texture,
+											  uint32, firstMip, update.firstMip,
+											  std::vector<Texture2DMipMap>*, newMips, update.newMips,
+											  {
+												  texture->UpdateResidentMips( firstMip, newMips );
+												  delete newMips;
+												  g_TextureStreamingManager.CompleteResidentMipsUpdate( texture );
+											  } );
+	}
+}
+
+/*
+==================
+CTextureStreamingManager::TickTextures
+==================
+*/
+void CTextureStreamingManager::TickTextures( std::vector<ResidentMipsUpdate>& OutUpdates )
+{
+	// Complete loaded requests and update wanted mips
+	std::vector<std::pair<CTexture2D*, StreamingTexture*>>		sortedTextures;
+	ProcessCompletedRequests( OutUpdates );
+	UpdateWantedMips( sortedTextures );
+
+	// Calculate size of pool after all requests in flight will be completed
+	uint64		poolUsage = 0;
+	for ( uint32 index = 0, count = sortedTextures.size(); index < count; ++index )
+	{
+		const StreamingTexture*		streamingTexture = sortedTextures[index].second;
+		poolUsage += CalcMipsSize( sortedTextures[index].first, streamingTexture->pendingMip != ( uint32 )INDEX_NONE ? streamingTexture->pendingMip : streamingTexture->residentMip );
+	}
+
+	// Evict mips which isn't wanted. Least recently needed textures are evicted first,
+	// other textures keep own mips until pool has free space or they was not seen for a long time
+	uint32		numEvictedMips = 0;
+	for ( uint32 index = 0, count = sortedTextures.size(); index < count; ++index )
+	{
+		CTexture2D*				texture				= sortedTextures[index].first;
+		StreamingTexture*		streamingTexture	= sortedTextures[index].second;
+		if ( streamingTexture->pendingMip != ( uint32 )INDEX_NONE || streamingTexture->wantedMip <= streamingTexture->residentMip )
+		{
+			continue;
+		}
+
+		bool		bNotSeen = currentTime - streamingTexture->lastSeenTime > TEXTURESTREAMING_DROP_MIPS_TIME;
+		if ( poolUsage > poolSize || bNotSeen )
+		{
+			poolUsage		-= CalcMipsSize( texture, streamingTexture->residentMip ) - CalcMipsSize( texture, streamingTexture->wantedMip );
+			numEvictedMips	+= streamingTexture->wantedMip - streamingTexture->residentMip;
+			OutUpdates.push_back( ResidentMipsUpdate{ texture, streamingTexture->wantedMip, nullptr } );
+			streamingTexture->residentMip = streamingTexture->wantedMip;
+		}
+	}
+
+	// Send requests to load wanted mips, most recently needed textures are first
+	for ( int32 index = ( int32 )sortedTextures.size() - 1; index >= 0 && numPendingRequests < TEXTURESTREAMING_MAX_PENDING_REQUESTS; --index )
+	{
+		CTexture2D*				texture				= sortedTextures[index].first;
+		StreamingTexture*		streamingTexture	= sortedTextures[index].second;
+		if ( streamingTexture->pendingMip != ( uint32 )INDEX_NONE || streamingTexture->wantedMip >= streamingTexture->residentMip )
+		{
+			continue;
+		}
+
+		uint64		requestSize = CalcMipsSize( texture, streamingTexture->wantedMip ) - CalcMipsSize( texture, streamingTexture->residentMip );
+		if ( poolUsage + requestSize > poolSize )
+		{
+			continue;
+		}
+
+		TextureStreamingRequest*	request = new TextureStreamingRequest();
+		request->texture	= texture;
+		request->requestId	= nextRequestId++;
+		request->filename	= texture->GetPackage()->GetFileName();
+		request->firstMip	= streamingTexture->wantedMip;
+		request->bSuccess	= false;
+		for ( uint32 mipIndex = streamingTexture->wantedMip; mipIndex < streamingTexture->residentMip; ++mipIndex )
+		{
+			Texture2DMipMap		mipmap;
+			mipmap.sizeX	= texture->GetSizeX( mipIndex );
+			mipmap.sizeY	= texture->GetSizeY( mipIndex );
+			request->mips.push_back( mipmap );
+			request->mipOffsets.push_back( texture->GetMipOffset( mipIndex ) );
+		}
+
+		poolUsage							+= requestSize;
+		streamingTexture->pendingMip		= request->firstMip;
+		streamingTexture->pendingRequestId	= request->requestId;
+		++numPendingRequests;
+		streamingRunnable->AddRequest( request );
+	}
+
+	// Update stats
+	uint32		numWantedMips	= 0;
+	uint32		numResidentMips	= 0;
+	uint64		poolResident	= 0;
+	for ( uint32 index = 0, count = sortedTextures.size(); index < count; ++index )
+	{
+		const CTexture2D*			texture				= sortedTextures[index].first;
+		const StreamingTexture*		streamingTexture	= sortedTextures[index].second;
+		numWantedMips	+= texture->GetNumMips() - streamingTexture->wantedMip;
+		numResidentMips	+= texture->GetNumMips() - streamingTexture->residentMip;
+		poolResident	+= CalcMipsSize( texture, streamingTexture->residentMip );
+	}
+
+	g_StatStreamingTextures.Set( sortedTextures.size() );
+	g_StatStreamingPoolBytes.Set( poolResident );
+	g_StatStreamingPendingRequests.Set( numPendingRequests );
+	g_StatStreamingWantedMips.Set( numWantedMips );
+	g_StatStreamingResidentMips.Set( numResidentMips );
+	g_StatStreamingEvictedMips.Add( numEvictedMips );
+}
+
+/*
+==================
+CTextureStreamingManager::ProcessCompletedRequests
+==================
+*/
+void CTextureStreamingManager::ProcessCompletedRequests( std::vector<ResidentMipsUpdate>& OutUpdates )
+{
+	std::vector<TextureStreamingRequest*>		completedRequests;
+	streamingRunnable->GetCompletedRequests( completedRequests );
+	for ( uint32 index = 0, count = completedRequests.size(); index < count; ++index )
+	{
+		TextureStreamingRequest*	request = completedRequests[index];
+		Assert( numPendingRequests > 0 );
+		--numPendingRequests;
+
+		// Texture may be removed or reloaded while request was in flight
+		auto		itTexture = textures.find( request->texture );
+		if ( itTexture != textures.end() && itTexture->second.pendingRequestId == request->requestId )
+		{
+			StreamingTexture&	streamingTexture = itTexture->second;
+			streamingTexture.pendingMip			= ( uint32 )INDEX_NONE;
+			streamingTexture.pendingRequestId	= 0;
+			if ( request->bSuccess )
+			{
+				g_StatStreamingStreamedMips.Add( request->mips.size() );
+				OutUpdates.push_back( ResidentMipsUpdate{ request->texture, request->firstMip, new std::vector<Texture2DMipMap>( std::move( request->mips ) ) } );
+				streamingTexture.residentMip = request->firstMip;
+			}
+		}
+
+		delete request;
+	}
+}
+
+/*
+==================
+CTextureStreamingManager::UpdateWantedMips
+==================
+*/
+void CTextureStreamingManager::UpdateWantedMips( std::vector<std::pair<CTexture2D*, StreamingTexture*>>& OutSortedTextures )
+{
+	OutSortedTextures.reserve( textures.size() );
+
+	uint64		wantedSize = 0;
+	for ( auto it = textures.begin(), itEnd = textures.end(); it != itEnd; ++it )
+	{
+		StreamingTexture&	streamingTexture = it->second;
+		if ( streamingTexture.visibleMip != ( uint32 )INDEX_NONE )
+		{
+			streamingTexture.wantedMip		= streamingTexture.visibleMip;
+			streamingTexture.lastSeenTime	= currentTime;
+			streamingTexture.visibleMip		= ( uint32 )INDEX_NONE;
+		}
+		else if ( currentTime - streamingTexture.lastSeenTime > TEXTURESTREAMING_DROP_MIPS_TIME )
+		{
+			streamingTexture.wantedMip		= streamingTexture.baseMip;
+		}
+
+		wantedSize += CalcMipsSize( it->first, streamingTexture.wantedMip );
+		OutSortedTextures.push_back( std::make_pair( it->first, &streamingTexture ) );
+	}
+
+	// Sort textures from least recently needed
+	std::sort( OutSortedTextures.begin(), OutSortedTextures.end(), []( const std::pair<CTexture2D*, StreamingTexture*>& InA, const std::pair<CTexture2D*, StreamingTexture*>& InB )
+			   {
+				   return InA.second->lastSeenTime < InB.second->lastSeenTime;
+			   } );
+
+	// Fit wanted mips to pool budget. Every pass drops one mip of textures, least recently needed are first
+	bool		bDropped = true;
+	while ( wantedSize > poolSize && bDropped )
+	{
+		bDropped = false;
+		for ( uint32 index = 0, count = OutSortedTextures.size(); index < count && wantedSize > poolSize; ++index )
+		{
+			CTexture2D*				texture				= OutSortedTextures[index].first;
+			StreamingTexture*		streamingTexture	= OutSortedTextures[index].second;
+			if ( streamingTexture->wantedMip < streamingTexture->baseMip )
+			{
+				wantedSize -= CalcMipsSize( texture, streamingTexture->wantedMip ) - CalcMipsSize( texture, streamingTexture->wantedMip + 1 );
+				++streamingTexture->wantedMip;
+				bDropped = true;
+			}
+		}
+	}
+}
+
+/*
+==================
+CTextureStreamingManager::CalcMipsSize
+==================
+*/
+uint64 CTextureStreamingManager::CalcMipsSize( const CTexture2D* InTexture, uint32 InFirstMip )
+{
+	return CalcTextureSize( InTexture->GetSizeX( InFirstMip ), InTexture->GetSizeY( InFirstMip ), InTexture->GetPixelFormat(), InTexture->GetNumMips() - InFirstMip );
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "Misc/EngineGlobals.h"
+#include "Misc/CoreGlobals.h"
+#include "RHI/BaseRHI.h"
+#include "Render/RenderingThread.h"
+#include "Render/TileMapMesh.h"
+
+/*
+==================
+CTileMapChunkMesh::CTileMapChunkMesh
+==================
+*/
+CTileMapChunkMesh::CTileMapChunkMesh()
+	: numPendingUpdates( 0 )
+	, numVerteces( 0 )
+	, vertexFactory( new CSpriteVertexFactory() )
+{
+	// Verteces are baked in local space of tile map with final texture coords,
+	// so sprite vertex factory must not change them
+	vertexFactory->SetSpriteSize( Vector2D( 2.f, 2.f ) );
+	vertexFactory->SetTextureRect( RectFloat_t( 0.f, 0.f, 1.f, 1.f ) );
+}
+
+/*
+==================
+CTileMapChunkMesh::SetData
+==================
+*/
+void CTileMapChunkMesh::SetData( const std::vector<SpriteVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<TileMapChunkSurface>& InSurfaces )
+{
+	// Rendering thread can read old data while upload isn't finished
+	Assert( IsReady() );
+	numVerteces		= InVerteces.size();
+	verteces		= InVerteces;
+	indeces			= InIndeces;
+	surfaces		= InSurfaces;
+
+	Sys_InterlockedIncrement( &numPendingUpdates );
+	BeginUpdateResource( this );
+	UNIQUE_RENDER_COMMAND_ONEPARAMETER( CTileMapChunkMeshUpdatedCommand, TileMapChunkMeshRef_t, mesh, this,
+		{
+			Sys_InterlockedDecrement( &mesh->numPendingUpdates );
+		} );
+}
+
+/*
+==================
+CTileMapChunkMesh::BeginRelease
+==================
+*/
+void CTileMapChunkMesh::BeginRelease()
+{
+	UNIQUE_RENDER_COMMAND_ONEPARAMETER( CTileMapChunkMeshReleaseCommand, TileMapChunkMeshRef_t, mesh, this,
+		{
+			mesh->ReleaseResource();
+		} );
+}
+
+/*
+==================
+CTileMapChunkMesh::InitRHI
+==================
+*/
+void CTileMapChunkMesh::InitRHI()
+{
+	// Create vertex buffer
+	if ( !verteces.empty() )
+	{
+		vertexBufferRHI = g_RHI->CreateVertexBuffer( TEXT( "TileMapChunk" ), sizeof( SpriteVertexType ) * verteces.size(), ( byte* )verteces.data(), RUF_Static );
+
+		// Initialize vertex factory
+		vertexFactory->AddVertexStream( VertexStream{ vertexBufferRHI, sizeof( SpriteVertexType ) } );		// 0 stream slot
+		vertexFactory->Init();
+	}
+
+	// Create index buffer, if all verteces can be addressed by 16-bit indeces we use them
+	if ( !indeces.empty() )
+	{
+		if ( verteces.size() <= 0xFFFF )
+		{
+			std::vector<uint16>		shortIndeces( indeces.size() );
+			for ( uint32 index = 0, count = indeces.size(); index < count; ++index )
+			{
+				shortIndeces[index] = ( uint16 )indeces[index];
+			}
+			indexBufferRHI = g_RHI->CreateIndexBuffer( TEXT( "TileMapChunk" ), sizeof( uint16 ), sizeof( uint16 ) * shortIndeces.size(), ( byte* )shortIndeces.data(), RUF_Static );
+		}
+		else
+		{
+			indexBufferRHI = g_RHI->CreateIndexBuffer( TEXT( "TileMapChunk" ), sizeof( uint32 ), sizeof( uint32 ) * indeces.size(), ( byte* )indeces.data(), RUF_Static );
+		}
+	}
+
+	if ( !g_IsEditor && !g_IsCommandlet )
+	{
+		verteces.clear();
+		indeces.clear();
+	}
+}
+
+/*
+==================
+CTileMapChunkMesh::ReleaseRHI
+==================
+*/
+void CTileMapChunkMesh::ReleaseRHI()
+{
+	vertexBufferRHI.SafeRelease();
+	indexBufferRHI.SafeRelease();
+	vertexFactory->ReleaseResource();
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "Misc/Template.h"
+#include "Render/VertexFactory/SpriteBatchVertexFactory.h"
+#include "Render/VertexFactory/GeneralVertexFactoryParams.h"
+
+IMPLEMENT_VERTEX_FACTORY_TYPE( CSpriteBatchVertexFactory, TEXT( "SpriteBatchVertexFactory.hlsl" ), false, 0 )
+
+//
+// GLOBALS
+//
+TGlobalResource< CSpriteBatchVertexDeclaration >			g_SpriteBatchVertexDeclaration;
+
+/*
+==================
+CSpriteBatchVertexDeclaration::InitRHI
+==================
+*/
+void CSpriteBatchVertexDeclaration::InitRHI()
+{
+	VertexDeclarationElementList_t		vertexDeclElementList =
+	{
+		VertexElement( CSpriteBatchVertexFactory::SSS_Main, sizeof( SpriteBatchVertexType ), STRUCT_OFFSET( SpriteBatchVertexType, position ),		VET_Float4, VEU_Position, 0 ),
+		VertexElement( CSpriteBatchVertexFactory::SSS_Main, sizeof( SpriteBatchVertexType ), STRUCT_OFFSET( SpriteBatchVertexType, texCoord ),		VET_Float2, VEU_TextureCoordinate, 0 ),
+		VertexElement( CSpriteBatchVertexFactory::SSS_Main, sizeof( SpriteBatchVertexType ), STRUCT_OFFSET( SpriteBatchVertexType, normal ),		VET_Float4, VEU_Normal, 0 ),
+		VertexElement( CSpriteBatchVertexFactory::SSS_Main, sizeof( SpriteBatchVertexType ), STRUCT_OFFSET( SpriteBatchVertexType, color ),			VET_Float4, VEU_Color, 0 )
+	};
+	vertexDeclarationRHI = g_RHI->CreateVertexDeclaration( vertexDeclElementList );
+}
+
+/*
+==================
+CSpriteBatchVertexDeclaration::ReleaseRHI
+==================
+*/
+void CSpriteBatchVertexDeclaration::ReleaseRHI()
+{
+	vertexDeclarationRHI.SafeRelease();
+}
+
+/*
+==================
+CSpriteBatchVertexFactory::InitRHI
+==================
+*/
+void CSpriteBatchVertexFactory::InitRHI()
+{
+	InitDeclaration( g_SpriteBatchVertexDeclaration.GetVertexDeclarationRHI() );
+}
+
+/*
+==================
+CSpriteBatchVertexFactory::ConstructShaderParameters
+==================
+*/
+CVertexFactoryShaderParameters* CSpriteBatchVertexFactory::ConstructShaderParameters( EShaderFrequency InShaderFrequency )
+{
+	return InShaderFrequency == SF_Vertex ? new CGeneralVertexShaderParameters( staticType.SupportsInstancing() ) : nullptr;
+}
\ No newline at end of file
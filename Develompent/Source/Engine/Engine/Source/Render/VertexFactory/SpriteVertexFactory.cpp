@@ -96,6 +96,7 @@ void CSpriteVertexShaderParameters::Bind( const class CShaderParameterMap& InPar
 	flipHorizontalParameter.Bind( InParameterMap, TEXT( "bFlipHorizontal" ), true );
 	textureRectParameter.Bind( InParameterMap, TEXT( "textureRect" ), true );
 	spriteSizeParameter.Bind( InParameterMap, TEXT( "spriteSize" ) );
+	spriteColorParameter.Bind( InParameterMap, TEXT( "spriteColor" ), true );
 }
 
 /*
@@ -113,6 +114,7 @@ void CSpriteVertexShaderParameters::Set( class CBaseDeviceContextRHI* InDeviceCo
 	SetVertexShaderValue( InDeviceContextRHI, flipHorizontalParameter, vertexFactory->IsFlipedHorizontal() );
 	SetVertexShaderValue( InDeviceContextRHI, textureRectParameter, vertexFactory->GetTextureRect() );
 	SetVertexShaderValue( InDeviceContextRHI, spriteSizeParameter, vertexFactory->GetSpriteSize() );
+	SetVertexShaderValue( InDeviceContextRHI, spriteColorParameter, vertexFactory->GetSpriteColor().ToNormalizedVector4D() );
 }
 
 /*
@@ -125,6 +127,7 @@ CSpriteVertexFactory::CSpriteVertexFactory()
 	, bFlipHorizontal( false )
 	, textureRect( 0.f, 0.f, 1.f, 1.f )
 	, spriteSize( 1.f, 1.f )
+	, spriteColor( CColor::white )
 {}
 
 /*
@@ -137,6 +140,7 @@ uint64 CSpriteVertexFactory::GetTypeHash() const
 	uint64		hash = Sys_MemFastHash( bFlipVertical, CVertexFactory::GetTypeHash() );
 	hash = Sys_MemFastHash( bFlipHorizontal, hash );
 	hash = Sys_MemFastHash( textureRect, hash );
+	hash = Sys_MemFastHash( spriteColor, hash );
 	return Sys_MemFastHash( spriteSize, hash );
 }
 
@@ -1,6 +1,7 @@
+#include <gtc/packing.hpp>
+
 #include "Misc/Template.h"
 #include "Render/VertexFactory/StaticMeshVertexFactory.h"
-#include "Render/VertexFactory/GeneralVertexFactoryParams.h"
 
 IMPLEMENT_VERTEX_FACTORY_TYPE( CStaticMeshVertexFactory, TEXT( "StaticMeshVertexFactory.hlsl" ), false, 0 )
 
@@ -9,6 +10,231 @@ IMPLEMENT_VERTEX_FACTORY_TYPE( CStaticMeshVertexFactory, TEXT( "StaticMeshVertex
 //
 TGlobalResource< CStaticMeshVertexDeclaration >			g_StaticMeshVertexDeclaration;
 
+/*
+==================
+GetTangentSpace
+==================
+*/
+static FORCEINLINE void GetTangentSpace( const StaticMeshVertexType& InVertex, Vector& OutNormal, Vector& OutTangent, float& OutBinormalSign )
+{
+	// Meshes without texture coords have zero tangents, normalize of them gives NaN,
+	// so for degenerated vectors we build orthonormal basis from normal (Duff et al. 2017)
+	Vector		normal		= Vector( InVertex.normal );
+	Vector		tangent		= Vector( InVertex.tangent );
+	float		normalLength	= glm::length( normal );
+	float		tangentLength	= glm::length( tangent );
+	OutNormal	= normalLength > KINDA_SMALL_NUMBER ? normal / normalLength : Vector( 0.f, 0.f, 1.f );
+	if ( tangentLength > KINDA_SMALL_NUMBER )
+	{
+		OutTangent		= tangent / tangentLength;
+		OutBinormalSign	= glm::dot( glm::cross( normal, tangent ), Vector( InVertex.binormal ) ) < 0.f ? -1.f : 1.f;
+	}
+	else
+	{
+		float	sign	= OutNormal.z >= 0.f ? 1.f : -1.f;
+		float	a		= -1.f / ( sign + OutNormal.z );
+		float	b		= OutNormal.x * OutNormal.y * a;
+		OutTangent		= Vector( 1.f + sign * OutNormal.x * OutNormal.x * a, sign * b, -sign * OutNormal.x );
+		OutBinormalSign	= 1.f;
+	}
+}
+
+/*
+==================
+PackTangentSpaceVector
+==================
+*/
+static FORCEINLINE uint32 PackTangentSpaceVector( const Vector& InVector, float InSign = 1.f )
+{
+	return glm::packUnorm3x10_1x2( Vector4D( InVector * 0.5f + 0.5f, InSign < 0.f ? 0.f : 1.f ) );
+}
+
+/*
+==================
+UnpackTangentSpaceVector
+==================
+*/
+static FORCEINLINE Vector4D UnpackTangentSpaceVector( uint32 InPacked )
+{
+	Vector4D	vector = glm::unpackUnorm3x10_1x2( InPacked );
+	return Vector4D( Vector( vector ) * 2.f - 1.f, vector.w );
+}
+
+/*
+==================
+GetQuantizedPositionScale
+==================
+*/
+static FORCEINLINE Vector GetQuantizedPositionScale( const CBox& InBounds )
+{
+	// Avoid division by zero for flat meshes
+	Vector		scale = InBounds.GetMax() - InBounds.GetMin();
+	return Vector( scale.x > 0.f ? scale.x : 1.f, scale.y > 0.f ? scale.y : 1.f, scale.z > 0.f ? scale.z : 1.f );
+}
+
+/*
+==================
+GetStaticMeshVertexFormatName
+==================
+*/
+const tchar* GetStaticMeshVertexFormatName( EStaticMeshVertexFormat InVertexFormat )
+{
+	switch ( InVertexFormat )
+	{
+	case SMVF_Compact:		return TEXT( "Compact" );
+	case SMVF_Quantized:	return TEXT( "Quantized" );
+	case SMVF_Full:			return TEXT( "Full" );
+	default:				return TEXT( "Unknown" );
+	}
+}
+
+/*
+==================
+GetStaticMeshVertexStride
+==================
+*/
+uint32 GetStaticMeshVertexStride( EStaticMeshVertexFormat InVertexFormat )
+{
+	switch ( InVertexFormat )
+	{
+	case SMVF_Compact:		return sizeof( StaticMeshCompactVertexType );
+	case SMVF_Quantized:	return sizeof( StaticMeshQuantizedVertexType );
+	case SMVF_Full:			return sizeof( StaticMeshVertexType );
+	default:
+		Sys_Errorf( TEXT( "Unknown static mesh vertex format %i" ), ( uint32 )InVertexFormat );
+		return 0;
+	}
+}
+
+/*
+==================
+PackStaticMeshVerteces
+==================
+*/
+void PackStaticMeshVerteces( const std::vector<StaticMeshVertexType>& InVerteces, EStaticMeshVertexFormat InVertexFormat, const CBox& InBounds, std::vector<byte>& OutData )
+{
+	uint32		stride = GetStaticMeshVertexStride( InVertexFormat );
+	OutData.resize( stride * InVerteces.size() );
+
+	Vector		invPositionScale	= 1.f / GetQuantizedPositionScale( InBounds );
+	Vector		positionBias		= InBounds.GetMin();
+	for ( uint32 index = 0, count = InVerteces.size(); index < count; ++index )
+	{
+		const StaticMeshVertexType&		vertex			= InVerteces[index];
+		Vector							normal;
+		Vector							tangent;
+		float							binormalSign;
+		GetTangentSpace( vertex, normal, tangent, binormalSign );
+
+		uint32							texCoord		= glm::packHalf2x16( vertex.texCoord );
+		uint32							packedNormal	= PackTangentSpaceVector( normal );
+		uint32							packedTangent	= PackTangentSpaceVector( tangent, binormalSign );
+
+		switch ( InVertexFormat )
+		{
+		case SMVF_Compact:
+		{
+			StaticMeshCompactVertexType*	packedVertex = ( StaticMeshCompactVertexType* )( OutData.data() + stride * index );
+			packedVertex->position		= Vector( vertex.position );
+			packedVertex->texCoord		= texCoord;
+			packedVertex->normal		= packedNormal;
+			packedVertex->tangent		= packedTangent;
+			break;
+		}
+
+		case SMVF_Quantized:
+		{
+			StaticMeshQuantizedVertexType*	packedVertex	= ( StaticMeshQuantizedVertexType* )( OutData.data() + stride * index );
+			uint64							position		= glm::packUnorm4x16( Vector4D( ( Vector( vertex.position ) - positionBias ) * invPositionScale, 1.f ) );
+			memcpy( packedVertex->position, &position, sizeof( packedVertex->position ) );
+			packedVertex->texCoord		= texCoord;
+			packedVertex->normal		= packedNormal;
+			packedVertex->tangent		= packedTangent;
+			break;
+		}
+
+		case SMVF_Full:
+		{
+			// Normal and tangent are biased like in packed formats, so the same shader decodes them
+			StaticMeshVertexType*			packedVertex = ( StaticMeshVertexType* )( OutData.data() + stride * index );
+			packedVertex->position		= vertex.position;
+			packedVertex->texCoord		= vertex.texCoord;
+			packedVertex->normal		= Vector4D( normal * 0.5f + 0.5f, 0.f );
+			packedVertex->tangent		= Vector4D( tangent * 0.5f + 0.5f, binormalSign < 0.f ? 0.f : 1.f );
+			packedVertex->binormal		= Vector4D( glm::cross( normal, tangent ) * binormalSign, 0.f );
+			break;
+		}
+		}
+	}
+}
+
+/*
+==================
+UnpackStaticMeshVerteces
+==================
+*/
+void UnpackStaticMeshVerteces( const byte* InData, uint32 InNumVerteces, EStaticMeshVertexFormat InVertexFormat, const CBox& InBounds, std::vector<StaticMeshVertexType>& OutVerteces )
+{
+	uint32		stride = GetStaticMeshVertexStride( InVertexFormat );
+	OutVerteces.resize( InNumVerteces );
+
+	Vector		positionScale	= GetQuantizedPositionScale( InBounds );
+	Vector		positionBias	= InBounds.GetMin();
+	for ( uint32 index = 0; index < InNumVerteces; ++index )
+	{
+		StaticMeshVertexType&		vertex = OutVerteces[index];
+		uint32						texCoord;
+		uint32						packedNormal;
+		uint32						packedTangent;
+
+		switch ( InVertexFormat )
+		{
+		case SMVF_Compact:
+		{
+			const StaticMeshCompactVertexType*		packedVertex = ( const StaticMeshCompactVertexType* )( InData + stride * index );
+			vertex.position		= Vector4D( packedVertex->position, 1.f );
+			texCoord			= packedVertex->texCoord;
+			packedNormal		= packedVertex->normal;
+			packedTangent		= packedVertex->tangent;
+			break;
+		}
+
+		case SMVF_Quantized:
+		{
+			const StaticMeshQuantizedVertexType*	packedVertex = ( const StaticMeshQuantizedVertexType* )( InData + stride * index );
+			uint64									position;
+			memcpy( &position, packedVertex->position, sizeof( packedVertex->position ) );
+			vertex.position		= Vector4D( Vector( glm::unpackUnorm4x16( position ) ) * positionScale + positionBias, 1.f );
+			texCoord			= packedVertex->texCoord;
+			packedNormal		= packedVertex->normal;
+			packedTangent		= packedVertex->tangent;
+			break;
+		}
+
+		case SMVF_Full:
+		{
+			const StaticMeshVertexType*				packedVertex = ( const StaticMeshVertexType* )( InData + stride * index );
+			vertex			= *packedVertex;
+			vertex.normal	= Vector4D( Vector( packedVertex->normal ) * 2.f - 1.f, 0.f );
+			vertex.tangent	= Vector4D( Vector( packedVertex->tangent ) * 2.f - 1.f, 0.f );
+			continue;
+		}
+
+		default:
+			Sys_Errorf( TEXT( "Unknown static mesh vertex format %i" ), ( uint32 )InVertexFormat );
+			return;
+		}
+
+		// Binormal is restored from normal, tangent and its sign
+		Vector4D	tangent		= UnpackTangentSpaceVector( packedTangent );
+		Vector		normal		= Vector( UnpackTangentSpaceVector( packedNormal ) );
+		vertex.texCoord			= glm::unpackHalf2x16( texCoord );
+		vertex.normal			= Vector4D( normal, 0.f );
+		vertex.tangent			= Vector4D( Vector( tangent ), 0.f );
+		vertex.binormal			= Vector4D( glm::cross( normal, Vector( tangent ) ) * ( tangent.w > 0.5f ? 1.f : -1.f ), 0.f );
+	}
+}
+
 /*
 ==================
 CStaticMeshVertexDeclaration::InitRHI
@@ -16,15 +242,41 @@ CStaticMeshVertexDeclaration::InitRHI
 */
 void CStaticMeshVertexDeclaration::InitRHI()
 {
-	VertexDeclarationElementList_t		vertexDeclElementList =
+	// Compact vertex format
+	{
+		VertexDeclarationElementList_t		vertexDeclElementList =
+		{
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshCompactVertexType ), STRUCT_OFFSET( StaticMeshCompactVertexType, position ),		VET_Float3,			VEU_Position,			0 ),
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshCompactVertexType ), STRUCT_OFFSET( StaticMeshCompactVertexType, texCoord ),		VET_Half2,			VEU_TextureCoordinate,	0 ),
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshCompactVertexType ), STRUCT_OFFSET( StaticMeshCompactVertexType, normal ),		VET_UInt1010102N,	VEU_Normal,				0 ),
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshCompactVertexType ), STRUCT_OFFSET( StaticMeshCompactVertexType, tangent ),		VET_UInt1010102N,	VEU_Tangent,			0 )
+		};
+		vertexDeclarationRHIs[SMVF_Compact] = g_RHI->CreateVertexDeclaration( vertexDeclElementList );
+	}
+
+	// Quantized vertex format
+	{
+		VertexDeclarationElementList_t		vertexDeclElementList =
+		{
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshQuantizedVertexType ), STRUCT_OFFSET( StaticMeshQuantizedVertexType, position ),	VET_UShort4N,		VEU_Position,			0 ),
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshQuantizedVertexType ), STRUCT_OFFSET( StaticMeshQuantizedVertexType, texCoord ),	VET_Half2,			VEU_TextureCoordinate,	0 ),
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshQuantizedVertexType ), STRUCT_OFFSET( StaticMeshQuantizedVertexType, normal ),		VET_UInt1010102N,	VEU_Normal,				0 ),
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshQuantizedVertexType ), STRUCT_OFFSET( StaticMeshQuantizedVertexType, tangent ),	VET_UInt1010102N,	VEU_Tangent,			0 )
+		};
+		vertexDeclarationRHIs[SMVF_Quantized] = g_RHI->CreateVertexDeclaration( vertexDeclElementList );
+	}
+
+	// Full vertex format, binormal is rebuilt in shader as in other formats
 	{
-		VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshVertexType ), STRUCT_OFFSET( StaticMeshVertexType, position ),    VET_Float4, VEU_Position, 0 ),
-		VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshVertexType ), STRUCT_OFFSET( StaticMeshVertexType, texCoord ),    VET_Float2, VEU_TextureCoordinate, 0 ),
-		VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshVertexType ), STRUCT_OFFSET( StaticMeshVertexType, normal ),      VET_Float4, VEU_Normal, 0 ),
-		VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshVertexType ), STRUCT_OFFSET( StaticMeshVertexType, tangent ),     VET_Float4, VEU_Tangent, 0 ),
-		VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshVertexType ), STRUCT_OFFSET( StaticMeshVertexType, binormal ),    VET_Float4, VEU_Binormal, 0 )
-	};
-	vertexDeclarationRHI = g_RHI->CreateVertexDeclaration( vertexDeclElementList );
+		VertexDeclarationElementList_t		vertexDeclElementList =
+		{
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshVertexType ), STRUCT_OFFSET( StaticMeshVertexType, position ),					VET_Float3,			VEU_Position,			0 ),
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshVertexType ), STRUCT_OFFSET( StaticMeshVertexType, texCoord ),					VET_Float2,			VEU_TextureCoordinate,	0 ),
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshVertexType ), STRUCT_OFFSET( StaticMeshVertexType, normal ),						VET_Float4,			VEU_Normal,				0 ),
+			VertexElement( CStaticMeshVertexFactory::SSS_Main, sizeof( StaticMeshVertexType ), STRUCT_OFFSET( StaticMeshVertexType, tangent ),					VET_Float4,			VEU_Tangent,			0 )
+		};
+		vertexDeclarationRHIs[SMVF_Full] = g_RHI->CreateVertexDeclaration( vertexDeclElementList );
+	}
 }
 
 /*
@@ -34,9 +286,59 @@ CStaticMeshVertexDeclaration::ReleaseRHI
 */
 void CStaticMeshVertexDeclaration::ReleaseRHI()
 {
-    vertexDeclarationRHI.SafeRelease();
+	for ( uint32 index = 0; index < SMVF_Num; ++index )
+	{
+		vertexDeclarationRHIs[index].SafeRelease();
+	}
+}
+
+/*
+==================
+CStaticMeshVertexShaderParameters::CStaticMeshVertexShaderParameters
+==================
+*/
+CStaticMeshVertexShaderParameters::CStaticMeshVertexShaderParameters()
+	: CGeneralVertexShaderParameters( CStaticMeshVertexFactory::staticType.SupportsInstancing() )
+{}
+
+/*
+==================
+CStaticMeshVertexShaderParameters::Bind
+==================
+*/
+void CStaticMeshVertexShaderParameters::Bind( const class CShaderParameterMap& InParameterMap )
+{
+	CGeneralVertexShaderParameters::Bind( InParameterMap );
+	positionScaleParameter.Bind( InParameterMap, TEXT( "positionScale" ), true );
+	positionBiasParameter.Bind( InParameterMap, TEXT( "positionBias" ), true );
 }
 
+/*
+==================
+CStaticMeshVertexShaderParameters::Set
+==================
+*/
+void CStaticMeshVertexShaderParameters::Set( class CBaseDeviceContextRHI* InDeviceContextRHI, const class CVertexFactory* InVertexFactory ) const
+{
+	CGeneralVertexShaderParameters::Set( InDeviceContextRHI, InVertexFactory );
+	CStaticMeshVertexFactory*		vertexFactory = ( CStaticMeshVertexFactory* )InVertexFactory;
+	Assert( InVertexFactory );
+
+	SetVertexShaderValue( InDeviceContextRHI, positionScaleParameter, vertexFactory->GetPositionScale() );
+	SetVertexShaderValue( InDeviceContextRHI, positionBiasParameter, vertexFactory->GetPositionBias() );
+}
+
+/*
+==================
+CStaticMeshVertexFactory::CStaticMeshVertexFactory
+==================
+*/
+CStaticMeshVertexFactory::CStaticMeshVertexFactory()
+	: vertexFormat( SMVF_Default )
+	, positionScale( 1.f, 1.f, 1.f )
+	, positionBias( 0.f, 0.f, 0.f )
+{}
+
 /*
 ==================
 CStaticMeshVertexFactory::InitRHI
@@ -44,7 +346,39 @@ CStaticMeshVertexFactory::InitRHI
 */
 void CStaticMeshVertexFactory::InitRHI()
 {
-	InitDeclaration( g_StaticMeshVertexDeclaration.GetVertexDeclarationRHI() );
+	InitDeclaration( g_StaticMeshVertexDeclaration.GetVertexDeclarationRHI( vertexFormat ) );
+}
+
+/*
+==================
+CStaticMeshVertexFactory::SetVertexFormat
+==================
+*/
+void CStaticMeshVertexFactory::SetVertexFormat( EStaticMeshVertexFormat InVertexFormat, const CBox& InBounds )
+{
+	vertexFormat = InVertexFormat;
+	if ( vertexFormat == SMVF_Quantized )
+	{
+		positionScale	= GetQuantizedPositionScale( InBounds );
+		positionBias	= InBounds.GetMin();
+	}
+	else
+	{
+		positionScale	= Vector( 1.f, 1.f, 1.f );
+		positionBias	= Vector( 0.f, 0.f, 0.f );
+	}
+}
+
+/*
+==================
+CStaticMeshVertexFactory::GetTypeHash
+==================
+*/
+uint64 CStaticMeshVertexFactory::GetTypeHash() const
+{
+	uint64		hash = Sys_MemFastHash( vertexFormat, CVertexFactory::GetTypeHash() );
+	hash = Sys_MemFastHash( positionScale, hash );
+	return Sys_MemFastHash( positionBias, hash );
 }
 
 /*
@@ -54,5 +388,5 @@ CStaticMeshVertexFactory::ConstructShaderParameters
 */
 CVertexFactoryShaderParameters* CStaticMeshVertexFactory::ConstructShaderParameters( EShaderFrequency InShaderFrequency )
 {
-    return InShaderFrequency == SF_Vertex ? new CGeneralVertexShaderParameters( staticType.SupportsInstancing() ) : nullptr;
+    return InShaderFrequency == SF_Vertex ? new CStaticMeshVertexShaderParameters() : nullptr;
 }
@@ -16,6 +16,7 @@
 #include "Render/Shaders/BasePassShader.h"
 #include "Render/Shaders/WireframeShader.h"
 #include "Render/RenderingThread.h"
+#include "Render/TextureStreaming.h"
 #include "System/CameraManager.h"
 
 IMPLEMENT_CLASS( CBaseEngine )
@@ -42,6 +43,9 @@ CBaseEngine::Init
 */
 void CBaseEngine::Init()
 {
+	// Texture streaming must be initialized before loading of any texture
+	g_TextureStreamingManager.Init();
+
 	// Load default texture
 	{	
 		// Loading default texture from packages only when we in game
@@ -219,6 +223,7 @@ void CBaseEngine::Shutdown()
 	g_World->CleanupWorld();
 	g_UIEngine->Shutdown();
 	g_PhysicsEngine.Shutdown();
+	g_TextureStreamingManager.Shutdown();
 }
 
 /*
@@ -230,7 +235,7 @@ void CBaseEngine::Tick( float InDeltaSeconds )
 {
 	g_World->Tick( InDeltaSeconds );
 	g_UIEngine->Tick( InDeltaSeconds );
-	g_PhysicsEngine.Tick( InDeltaSeconds );
+	g_TextureStreamingManager.Tick( InDeltaSeconds );
 }
 
 /*
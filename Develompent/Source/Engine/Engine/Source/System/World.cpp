@@ -5,6 +5,7 @@
 #include "System/Package.h"
 #include "PhysicsInterface.h"
 #include "Actors/Actor.h"
+#include "Components/PrimitiveComponent.h"
 #include "System/World.h"
 #include "Logger/LoggerMacros.h"
 #include "Render/Scene.h"
@@ -98,12 +99,46 @@ CWorld::Tick
 */
 void CWorld::Tick( float InDeltaTime )
 {
+	// Kick off physics, the last step is simulated while actors are ticking
+	g_PhysicsEngine.BeginTick( InDeltaTime );
+
 	// Tick all actors
 	for ( uint32 index = 0, count = ( uint32 )actors.size(); index < count; ++index )
 	{
-		AActor*		actor = actors[ index ];
-		actor->Tick( InDeltaTime );
-		actor->SyncPhysics();
+		actors[ index ]->Tick( InDeltaTime );
+	}
+
+	// Sync point with physics, after it write back results only to actors which bodies moved
+	g_PhysicsEngine.EndTick();
+	const std::vector< CPhysicsBodyInstance* >&		activeBodies = g_PhysicsEngine.GetActiveBodies();
+	for ( uint32 index = 0, count = ( uint32 )activeBodies.size(); index < count; ++index )
+	{
+		CPrimitiveComponent*	component = activeBodies[ index ]->GetOwnerComponent();
+		AActor*					actor = component ? component->GetOwner() : nullptr;
+		if ( actor && actor->GetCollisionComponent() == component )
+		{
+			component->SyncComponentToPhysics();
+		}
+	}
+
+	// Dispatch collision events of this frame after write back, so handlers see actual transforms.
+	// Handlers may destroy bodies, in this case their pointers in events are reset and only the other body gets them.
+	// End events of bodies removed after dispatch are queued to the next frame, so buffer doesn't grow here
+	const std::vector< PhysicsContactEvent >&		contactEvents = g_PhysicsEngine.GetContactBuffer().GetEvents();
+	for ( uint32 index = 0, count = ( uint32 )contactEvents.size(); index < count; ++index )
+	{
+		const PhysicsContactEvent&		contactEvent = contactEvents[ index ];
+		CPrimitiveComponent*			componentA = contactEvent.bodyA ? contactEvent.bodyA->GetOwnerComponent() : nullptr;
+		if ( componentA )
+		{
+			componentA->NotifyContactEvent( contactEvent );
+		}
+
+		CPrimitiveComponent*			componentB = contactEvent.bodyB ? contactEvent.bodyB->GetOwnerComponent() : nullptr;
+		if ( componentB )
+		{
+			componentB->NotifyContactEvent( contactEvent );
+		}
 	}
 
 	// Destroy actors if need
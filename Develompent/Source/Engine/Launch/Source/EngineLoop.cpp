@@ -1,6 +1,7 @@
 #include "Core.h"
 #include "Misc/CoreGlobals.h"
 #include "Misc/EngineGlobals.h"
+#include "Misc/Stats.h"
 #include "Misc/AudioGlobals.h"
 #include "Misc/Misc.h"
 #include "Logger/LoggerMacros.h"
@@ -10,6 +11,7 @@
 #include "System/BaseWindow.h"
 #include "System/Config.h"
 #include "System/ThreadingBase.h"
+#include "System/ThreadPool.h"
 #include "System/InputSystem.h"
 #include "System/Package.h"
 #include "System/AudioEngine.h"
@@ -200,6 +202,7 @@ int32 CEngineLoop::PreInit( const tchar* InCmdLine )
 
 	g_Log->Init();
 	int32		result = Sys_PlatformPreInit();
+	g_ThreadPool.Init();
 	
 	// Loading table of contents
 	if ( !g_IsEditor && !g_IsCooker )
@@ -233,6 +236,7 @@ int32 CEngineLoop::PreInit( const tchar* InCmdLine )
 		return -1;
 	}
 
+	// RHI is created by Sys_PlatformPreInit. With null RHI the window is still created for event loop and input, but it is never shown
 	g_Window->Create( ANSI_TO_TCHAR( ENGINE_NAME " " ENGINE_VERSION_STRING ), 1, 1, SW_Default );
 	g_ScriptEngine->Init();
 	g_RHI->Init( g_IsEditor );
@@ -421,6 +425,9 @@ void CEngineLoop::Tick()
 	// Update engine
 	g_Engine->Tick( g_DeltaTime );
 
+	// Close frame of stat counters
+	g_StatManager.AdvanceFrame( g_DeltaTime );
+
 	// Reset input events after game frame
 	g_InputSystem->ResetEvents();
 }
@@ -443,11 +450,13 @@ void CEngineLoop::Exit()
 	delete g_FullScreenMovie;
 	g_FullScreenMovie = nullptr;
 
+	g_StatManager.StopCSV();
 	g_AudioEngine.Shutdown();
 	g_ShaderManager->Shutdown();
 	g_RHI->Destroy();
 
 	g_Window->Close();
+	g_ThreadPool.Shutdown();
 	g_Log->TearDown();
 	g_Config.Shutdown();
 	g_CommandLine.Shutdown();
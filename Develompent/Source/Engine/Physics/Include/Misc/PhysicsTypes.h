@@ -119,6 +119,70 @@ struct CollisionProfile
 	static const std::wstring	blockAll_ProfileName;		/**< Block all profile name */
 };
 
+/**
+ * @ingroup Physics
+ * @brief Collision profile compiled into bit masks for filtering of pairs in physics solvers
+ */
+struct CollisionFilterData
+{
+	/**
+	 * @brief Constructor
+	 */
+	CollisionFilterData()
+		: objectTypeBit( 0 )
+		, blockMask( 0 )
+		, overlapMask( 0 )
+	{}
+
+	/**
+	 * @brief Compile collision profile
+	 *
+	 * @param InCollisionProfile	Collision profile
+	 * @return Return filter data of collision profile
+	 */
+	static FORCEINLINE CollisionFilterData Make( const CollisionProfile& InCollisionProfile )
+	{
+		CollisionFilterData		filterData;
+		filterData.objectTypeBit = 1 << InCollisionProfile.objectType;
+		for ( uint32 index = 0; index < CC_Max; ++index )
+		{
+			switch ( InCollisionProfile.responses[ index ] )
+			{
+			case CR_Block:		filterData.blockMask	|= 1 << index;	break;
+			case CR_Overlap:	filterData.overlapMask	|= 1 << index;	break;
+			default:			break;
+			}
+		}
+		return filterData;
+	}
+
+	/**
+	 * @brief Get response of pair
+	 * @note Like in collision profiles, the pair uses the weakest response of both objects to each other
+	 *
+	 * @param InA	Filter data of first object
+	 * @param InB	Filter data of second object
+	 * @return Return collision response of pair
+	 */
+	static FORCEINLINE ECollisionResponse GetResponse( const CollisionFilterData& InA, const CollisionFilterData& InB )
+	{
+		if ( ( InA.blockMask & InB.objectTypeBit ) && ( InB.blockMask & InA.objectTypeBit ) )
+		{
+			return CR_Block;
+		}
+		
+		if ( ( ( InA.blockMask | InA.overlapMask ) & InB.objectTypeBit ) && ( ( InB.blockMask | InB.overlapMask ) & InA.objectTypeBit ) )
+		{
+			return CR_Overlap;
+		}
+		return CR_Ignore;
+	}
+
+	uint32		objectTypeBit;		/**< Bit of object type channel */
+	uint32		blockMask;			/**< Mask of channels with block response */
+	uint32		overlapMask;		/**< Mask of channels with overlap response */
+};
+
 /**
  * @ingroup Physics
  * @brief Struct of result ray cast
@@ -133,6 +197,7 @@ struct HitResult
 		, component( nullptr )
 		, impactNormal( Math::vectorZero )
 		, impactPoint( Math::vectorZero )
+		, distance( 0.f )
 		, physMaterial( nullptr )
 	{ }
 
@@ -140,9 +205,189 @@ struct HitResult
 	class CPrimitiveComponent*			component;		/**< PrimitiveComponent hit by the trace */
 	Vector								impactNormal;	/**< Normal of the hit in world space, for the object that was hit by the sweep, if any */
 	Vector								impactPoint;	/**< Location in world space of the actual contact of the trace shape (box, sphere, ray, etc) with the impacted object */
+	float								distance;		/**< The distance from the trace start to the impact. If the sweep started in penetration it's 0 */
 	TSharedPtr<class CPhysicsMaterial>	physMaterial;	/**< Physical material that was hit */
 };
 
+/**
+ * @ingroup Physics
+ * @brief Struct of result overlap test
+ */
+struct OverlapResult
+{
+	/**
+	 * @brief Constructor
+	 */
+	OverlapResult()
+		: actor( nullptr )
+		, component( nullptr )
+	{}
+
+	class AActor*						actor;			/**< Overlapped actor */
+	class CPrimitiveComponent*			component;		/**< Overlapped PrimitiveComponent */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Statistics of physics scene since the last request
+ * @note Times of phases are available only for Box2D, PhysX doesn't report them without profiler
+ */
+struct PhysicsSceneStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	PhysicsSceneStats()
+		: numAwakeBodies( 0 )
+		, numContacts( 0 )
+		, collideTime( 0.f )
+		, solveTime( 0.f )
+		, ccdTime( 0.f )
+		, broadphaseTime( 0.f )
+	{}
+
+	uint32		numAwakeBodies;		/**< Number of awake dynamic bodies */
+	uint32		numContacts;		/**< Number of touching contacts */
+	float		collideTime;		/**< Time of narrowphase in milliseconds */
+	float		solveTime;			/**< Time of solver in milliseconds */
+	float		ccdTime;			/**< Time of continuous collision detection in milliseconds */
+	float		broadphaseTime;		/**< Time of broadphase in milliseconds */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Enumeration of notify flags of body
+ */
+enum EPhysicsNotifyFlags
+{
+	PNF_None		= 0,				/**< Body doesn't receive collision events */
+	PNF_Contact		= 1 << 0,			/**< Begin and end of contact with blocking body */
+	PNF_Overlap		= 1 << 1,			/**< Begin and end of overlap */
+	PNF_Hit			= 1 << 2,			/**< Solved contact with blocking body, reported once per frame for each pair */
+	PNF_All			= PNF_Contact | PNF_Overlap | PNF_Hit	/**< All collision events */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Enumeration of collision event types
+ */
+enum EPhysicsContactEventType
+{
+	PCET_BeginContact,		/**< Blocking bodies started touching */
+	PCET_EndContact,		/**< Blocking bodies stopped touching */
+	PCET_BeginOverlap,		/**< Overlapping bodies started touching */
+	PCET_EndOverlap,		/**< Overlapping bodies stopped touching */
+	PCET_Hit				/**< Contact of blocking bodies was solved */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Collision event between two bodies
+ */
+struct PhysicsContactEvent
+{
+	/**
+	 * @brief Constructor
+	 */
+	PhysicsContactEvent()
+		: type( PCET_BeginContact )
+		, bodyA( nullptr )
+		, bodyB( nullptr )
+		, point( Math::vectorZero )
+		, normal( Math::vectorZero )
+		, impulse( 0.f )
+		, count( 1 )
+	{}
+
+	/**
+	 * @brief Get notify flag needed for receive event
+	 * @return Return notify flag of event type
+	 */
+	FORCEINLINE EPhysicsNotifyFlags GetNotifyFlag() const
+	{
+		switch ( type )
+		{
+		case PCET_BeginContact:
+		case PCET_EndContact:		return PNF_Contact;
+		case PCET_BeginOverlap:
+		case PCET_EndOverlap:		return PNF_Overlap;
+		default:					return PNF_Hit;
+		}
+	}
+
+	EPhysicsContactEventType			type;		/**< Event type */
+	class CPhysicsBodyInstance*			bodyA;		/**< First body, NULL if body was destroyed before dispatch, the other body still gets event */
+	class CPhysicsBodyInstance*			bodyB;		/**< Second body, NULL if body was destroyed before dispatch or event is end of touch with removed body */
+	Vector								point;		/**< Contact point in world space */
+	Vector								normal;		/**< Contact normal in world space, points from body A to body B */
+	float								impulse;	/**< Normal impulse of hit, for coalesced hits it is the max impulse */
+	uint32								count;		/**< Number of coalesced hits */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Shape for sweeps and overlap tests
+ */
+struct CollisionShape
+{
+	/**
+	 * @brief Enumeration of shape types
+	 */
+	enum EType
+	{
+		T_Box,			/**< Box */
+		T_Circle		/**< Circle (sphere in 3D) */
+	};
+
+	/**
+	 * @brief Constructor
+	 */
+	CollisionShape()
+		: type( T_Box )
+		, halfExtent( Math::vectorZero )
+	{}
+
+	/**
+	 * @brief Make box shape
+	 *
+	 * @param InHalfExtent	Half extent of box
+	 * @return Return box shape
+	 */
+	static FORCEINLINE CollisionShape MakeBox( const Vector& InHalfExtent )
+	{
+		CollisionShape		shape;
+		shape.type			= T_Box;
+		shape.halfExtent	= InHalfExtent;
+		return shape;
+	}
+
+	/**
+	 * @brief Make circle shape
+	 *
+	 * @param InRadius	Radius of circle
+	 * @return Return circle shape
+	 */
+	static FORCEINLINE CollisionShape MakeCircle( float InRadius )
+	{
+		CollisionShape		shape;
+		shape.type			= T_Circle;
+		shape.halfExtent	= Vector( InRadius, InRadius, InRadius );
+		return shape;
+	}
+
+	/**
+	 * @brief Get radius of circle
+	 * @return Return radius of circle
+	 */
+	FORCEINLINE float GetRadius() const
+	{
+		return halfExtent.x;
+	}
+
+	EType		type;			/**< Type of shape */
+	Vector		halfExtent;		/**< Half extent of box. For circle all components is radius */
+};
+
 /**
  * @ingroup Physics
  * @brief Structure that defines parameters passed into collision function 
@@ -29,6 +29,7 @@ typedef PhysicsInterfacePhysX				CPhysicsInterface;
 typedef PhysicsMaterialHandlePhysX			PhysicsMaterialHandle_t;
 typedef PhysicsShapeHandlePhysX				PhysicsShapeHandle_t;
 typedef PhysicsActorHandlePhysX				PhysicsActorHandle_t;
+typedef PhysicsActorStatePhysX				PhysicsActorState_t;
 
 // Box 2D implementation
 #elif WITH_BOX2D
@@ -40,6 +41,7 @@ typedef PhysicsInterfaceBox2D				CPhysicsInterface;
 typedef PhysicsMaterialHandleBox2D			PhysicsMaterialHandle_t;
 typedef PhysicsShapeHandleBox2D				PhysicsShapeHandle_t;
 typedef PhysicsActorHandleBox2D				PhysicsActorHandle_t;
+typedef PhysicsActorStateBox2D				PhysicsActorState_t;
 
 #else
 	static_assert( false, "A physics engine interface must be defined to build" );
@@ -167,6 +167,7 @@ struct PhysicsShapeHandleBox2D
 
 	TAssetHandle<class CPhysicsMaterial>	physMaterial;		/**< Physical material */
 	CollisionProfile*						collisionProfile;	/**< Collision profile */
+	CollisionFilterData						filterData;			/**< Collision profile compiled for contact filter */
 	b2Shape*								bx2Shape;			/**< Box2D shape */
 };
 
@@ -201,6 +202,49 @@ struct PhysicsActorHandleBox2D
 	COnPhysicsMaterialDestroyed::DelegateType_t*	physicsMaterialDestroyedHandle;	/**< Handle delegate of physics material is destroyed */
 };
 
+/**
+ * @ingroup Physics
+ * @brief State of actor for Box2D
+ * @note Values are stored in units of Box2D, so restored state isn't affected by conversion to LE units
+ */
+struct PhysicsActorStateBox2D
+{
+	/**
+	 * @brief Constructor
+	 */
+	PhysicsActorStateBox2D()
+		: position( 0.f, 0.f )
+		, angle( 0.f )
+		, linearVelocity( 0.f, 0.f )
+		, angularVelocity( 0.f )
+		, bAwake( false )
+	{}
+
+	/**
+	 * @brief Get hash of state
+	 *
+	 * @param InHash	Start hash
+	 * @return Return hash of state
+	 */
+	FORCEINLINE uint64 GetTypeHash( uint64 InHash = 0 ) const
+	{
+		InHash = Sys_MemFastHash( position.x, InHash );
+		InHash = Sys_MemFastHash( position.y, InHash );
+		InHash = Sys_MemFastHash( angle, InHash );
+		InHash = Sys_MemFastHash( linearVelocity.x, InHash );
+		InHash = Sys_MemFastHash( linearVelocity.y, InHash );
+		InHash = Sys_MemFastHash( angularVelocity, InHash );
+		InHash = Sys_MemFastHash( bAwake, InHash );
+		return InHash;
+	}
+
+	b2Vec2		position;			/**< Position of body origin in meters */
+	float		angle;				/**< Angle of body in radians */
+	b2Vec2		linearVelocity;		/**< Linear velocity of center of mass */
+	float		angularVelocity;	/**< Angular velocity in radians per second */
+	bool		bAwake;				/**< Is body awake */
+};
+
 /**
  * @ingroup Physics
  * @brief Box2D interface
@@ -321,6 +365,44 @@ struct PhysicsInterfaceBox2D
 		return B2LETransform( InActorHandle.bx2Body->GetTransform() );
 	}
 
+	/**
+	 * @brief Get state of physics actor
+	 *
+	 * @param InActorHandle Handle of physics actor
+	 * @return Return state of physics actor
+	 */
+	static FORCEINLINE PhysicsActorStateBox2D GetActorState( const PhysicsActorHandleBox2D& InActorHandle )
+	{
+		Assert( IsValidActor( InActorHandle ) );
+		PhysicsActorStateBox2D		actorState;
+		actorState.position			= InActorHandle.bx2Body->GetPosition();
+		actorState.angle			= InActorHandle.bx2Body->GetAngle();
+		actorState.linearVelocity	= InActorHandle.bx2Body->GetLinearVelocity();
+		actorState.angularVelocity	= InActorHandle.bx2Body->GetAngularVelocity();
+		actorState.bAwake			= InActorHandle.bx2Body->IsAwake();
+		return actorState;
+	}
+
+	/**
+	 * @brief Set state of physics actor
+	 *
+	 * @param InActorHandle Handle of physics actor
+	 * @param InActorState State of physics actor
+	 */
+	static FORCEINLINE void SetActorState( const PhysicsActorHandleBox2D& InActorHandle, const PhysicsActorStateBox2D& InActorState )
+	{
+		Assert( IsValidActor( InActorHandle ) );
+		InActorHandle.bx2Body->SetTransform( InActorState.position, InActorState.angle );
+		InActorHandle.bx2Body->SetAwake( InActorState.bAwake );
+
+		// Sleeping body has zero velocity, and setting of velocity wakes it up
+		if ( InActorState.bAwake )
+		{
+			InActorHandle.bx2Body->SetLinearVelocity( InActorState.linearVelocity );
+			InActorHandle.bx2Body->SetAngularVelocity( InActorState.angularVelocity );
+		}
+	}
+
 	/**
 	 * @brief Set linear velocity
 	 * 
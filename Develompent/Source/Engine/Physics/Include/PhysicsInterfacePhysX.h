@@ -17,6 +17,7 @@
 #include "Math/Transform.h"
 #include "Math/Rotator.h"
 #include "Misc/PhysXGlobals.h"
+#include "Misc/PhysicsTypes.h"
 #include "CoreDefines.h"
 
 /**
@@ -212,6 +213,53 @@ struct PhysicsActorHandlePhysX
 	physx::PxRigidActor*		pxRigidActor;		/**< PhysX rigid actor */
 };
 
+/**
+ * @ingroup Physics
+ * @brief State of actor for PhysX
+ */
+struct PhysicsActorStatePhysX
+{
+	/**
+	 * @brief Constructor
+	 */
+	PhysicsActorStatePhysX()
+		: pose( physx::PxIdentity )
+		, linearVelocity( physx::PxZero )
+		, angularVelocity( physx::PxZero )
+		, bAwake( false )
+	{}
+
+	/**
+	 * @brief Get hash of state
+	 *
+	 * @param InHash	Start hash
+	 * @return Return hash of state
+	 */
+	FORCEINLINE uint64 GetTypeHash( uint64 InHash = 0 ) const
+	{
+		InHash = Sys_MemFastHash( pose.p.x, InHash );
+		InHash = Sys_MemFastHash( pose.p.y, InHash );
+		InHash = Sys_MemFastHash( pose.p.z, InHash );
+		InHash = Sys_MemFastHash( pose.q.x, InHash );
+		InHash = Sys_MemFastHash( pose.q.y, InHash );
+		InHash = Sys_MemFastHash( pose.q.z, InHash );
+		InHash = Sys_MemFastHash( pose.q.w, InHash );
+		InHash = Sys_MemFastHash( linearVelocity.x, InHash );
+		InHash = Sys_MemFastHash( linearVelocity.y, InHash );
+		InHash = Sys_MemFastHash( linearVelocity.z, InHash );
+		InHash = Sys_MemFastHash( angularVelocity.x, InHash );
+		InHash = Sys_MemFastHash( angularVelocity.y, InHash );
+		InHash = Sys_MemFastHash( angularVelocity.z, InHash );
+		InHash = Sys_MemFastHash( bAwake, InHash );
+		return InHash;
+	}
+
+	physx::PxTransform		pose;				/**< Global pose of actor */
+	physx::PxVec3			linearVelocity;		/**< Linear velocity */
+	physx::PxVec3			angularVelocity;	/**< Angular velocity */
+	bool					bAwake;				/**< Is actor awake */
+};
+
 /**
  * @ingroup Physics
  * @brief PhysX interface
@@ -242,6 +290,30 @@ struct PhysicsInterfacePhysX
 		return shapeHandle;
 	}
 
+	/**
+	 * @brief Create box shape
+	 * @note Shape isn't exclusive, so it can be shared by many actors with the same body setup
+	 *
+	 * @param InBoxGeometry Box geometry info
+	 * @return Return shape handle
+	 */
+	static PhysicsShapeHandlePhysX CreateShapeGeometry( const struct PhysicsBoxGeometry& InBoxGeometry );
+
+	/**
+	 * @brief Set collision filter of shape
+	 * @note Filter data is read by PhysXCollisionFilterShader: word0 is object type bit, word1 is block mask, word2 is overlap mask
+	 *
+	 * @param InShapeHandle Shape handle
+	 * @param InFilterData Collision profile compiled into filter data
+	 */
+	static FORCEINLINE void SetCollisionFilter( const PhysicsShapeHandlePhysX& InShapeHandle, const CollisionFilterData& InFilterData )
+	{
+		Assert( IsValidShapeGeometry( InShapeHandle ) );
+		physx::PxFilterData		pxFilterData( InFilterData.objectTypeBit, InFilterData.blockMask, InFilterData.overlapMask, 0 );
+		InShapeHandle.pxShape->setSimulationFilterData( pxFilterData );
+		InShapeHandle.pxShape->setQueryFilterData( pxFilterData );
+	}
+
 	/**
 	 * @brief Release shape
 	 * @param InShapeHandle Shape handle
@@ -333,6 +405,56 @@ struct PhysicsInterfacePhysX
 		physx::PxRigidBodyExt::updateMassAndInertia( *( physx::PxRigidDynamic* )InActorHandle.pxRigidActor, InDensity, InMassLocalPose ? &LE2PVector( *InMassLocalPose ) : nullptr, InIncludeNonSimShapes );
 	}
 
+	/**
+	 * @brief Get state of physics actor
+	 *
+	 * @param InActorHandle Handle of physics actor
+	 * @return Return state of physics actor
+	 */
+	static FORCEINLINE PhysicsActorStatePhysX GetActorState( const PhysicsActorHandlePhysX& InActorHandle )
+	{
+		Assert( IsValidActor( InActorHandle ) );
+		PhysicsActorStatePhysX		actorState;
+		actorState.pose = InActorHandle.pxRigidActor->getGlobalPose();
+		if ( !InActorHandle.bStatic )
+		{
+			physx::PxRigidDynamic*		pxRigidDynamic = ( physx::PxRigidDynamic* )InActorHandle.pxRigidActor;
+			actorState.linearVelocity	= pxRigidDynamic->getLinearVelocity();
+			actorState.angularVelocity	= pxRigidDynamic->getAngularVelocity();
+			actorState.bAwake			= !pxRigidDynamic->isSleeping();
+		}
+		return actorState;
+	}
+
+	/**
+	 * @brief Set state of physics actor
+	 * @note Scene must not be simulating
+	 *
+	 * @param InActorHandle Handle of physics actor
+	 * @param InActorState State of physics actor
+	 */
+	static FORCEINLINE void SetActorState( const PhysicsActorHandlePhysX& InActorHandle, const PhysicsActorStatePhysX& InActorState )
+	{
+		Assert( IsValidActor( InActorHandle ) );
+		InActorHandle.pxRigidActor->setGlobalPose( InActorState.pose, false );
+		if ( InActorHandle.bStatic )
+		{
+			return;
+		}
+
+		physx::PxRigidDynamic*		pxRigidDynamic = ( physx::PxRigidDynamic* )InActorHandle.pxRigidActor;
+		if ( InActorState.bAwake )
+		{
+			pxRigidDynamic->setLinearVelocity( InActorState.linearVelocity, false );
+			pxRigidDynamic->setAngularVelocity( InActorState.angularVelocity, false );
+			pxRigidDynamic->wakeUp();
+		}
+		else
+		{
+			pxRigidDynamic->putToSleep();
+		}
+	}
+
 	/**
 	 * @brief Get physics actor transform
 	 * 
@@ -41,8 +41,13 @@ struct ActorCreationParams
 		, bEnableGravity( false )
 		, bSimulatePhysics( false )
 		, bStartAwake( false )
+		, bCCD( false )
+		, bAllowSleep( true )
 		, lockFlags( BLF_None )
+		, positionIterations( 0 )
+		, velocityIterations( 0 )
 		, mass( 0.f )
+		, sleepThreshold( 0.f )
 		, debugName( nullptr )
 	{}
 
@@ -52,8 +57,13 @@ struct ActorCreationParams
 	bool			bEnableGravity;		/**< Enable gravity */
 	bool			bSimulatePhysics;	/**< Need simulate physics */
 	bool			bStartAwake;		/**< Start awake */
+	bool			bCCD;				/**< Enable continuous collision detection against dynamic bodies (bullet) */
+	bool			bAllowSleep;		/**< Allow body to fall asleep */
 	uint32			lockFlags;			/**< Lock flags (see EBodyLockFlag) */
+	uint32			positionIterations;	/**< Number of solver position iterations, 0 is default of physics engine */
+	uint32			velocityIterations;	/**< Number of solver velocity iterations, 0 is default of physics engine */
 	float			mass;				/**< Mass */
+	float			sleepThreshold;		/**< Mass-normalized kinetic energy below which body may fall asleep, 0 is default of physics engine */
 	char*			debugName;			/**< Debug name */
 };
 
@@ -12,6 +12,7 @@
 #if WITH_BOX2D
 #include <box2d/box2d.h>
 #include <vector>
+#include <unordered_set>
 
 #include "Math/Math.h"
 #include "Misc/PhysicsTypes.h"
@@ -19,7 +20,89 @@
 
 /**
  * @ingroup Physics
- * @brief Class of PhysX scene
+ * @brief Default number of Box2D solver velocity iterations
+ */
+#define BOX2D_DEFAULT_VELOCITY_ITERATIONS		8
+
+/**
+ * @ingroup Physics
+ * @brief Default number of Box2D solver position iterations
+ */
+#define BOX2D_DEFAULT_POSITION_ITERATIONS		3
+
+/**
+ * @ingroup Physics
+ * @brief Box2D contact filter by collision profiles
+ *
+ * Pairs with ignore response are rejected here, so they never reach the narrowphase
+ */
+class CBox2DContactFilter : public b2ContactFilter
+{
+public:
+	/**
+	 * @brief Return true if contact calculations should be performed between these two shapes
+	 *
+	 * @param InFixtureA	Fixture A
+	 * @param InFixtureB	Fixture B
+	 * @return Return true if response of pair isn't ignore
+	 */
+	virtual bool ShouldCollide( b2Fixture* InFixtureA, b2Fixture* InFixtureB ) override;
+};
+
+/**
+ * @ingroup Physics
+ * @brief Box2D contact listener
+ *
+ * Contacts of pairs with overlap response are detected, but disabled before the solver.
+ * Begin, end and hits of contacts are recorded to buffer of collision events (see CPhysicsContactBuffer)
+ */
+class CBox2DContactListener : public b2ContactListener
+{
+public:
+	/**
+	 * @brief Called when two fixtures begin to touch
+	 * @param InContact		Contact
+	 */
+	virtual void BeginContact( b2Contact* InContact ) override;
+
+	/**
+	 * @brief Called when two fixtures cease to touch
+	 * @param InContact		Contact
+	 */
+	virtual void EndContact( b2Contact* InContact ) override;
+
+	/**
+	 * @brief This is called after a contact is updated, but before it goes to the solver
+	 *
+	 * @param InContact			Contact
+	 * @param InOldManifold		Manifold of contact before update
+	 */
+	virtual void PreSolve( b2Contact* InContact, const b2Manifold* InOldManifold ) override;
+
+	/**
+	 * @brief This lets you inspect a contact after the solver is finished
+	 *
+	 * @param InContact		Contact
+	 * @param InImpulse		Impulses of contact points
+	 */
+	virtual void PostSolve( b2Contact* InContact, const b2ContactImpulse* InImpulse ) override;
+
+	/**
+	 * @brief Forget contacts started in the last step
+	 * @note Called after each step of Box2D world
+	 */
+	FORCEINLINE void ResetNewContacts()
+	{
+		newContacts.clear();
+	}
+
+private:
+	std::unordered_set< b2Contact* >		newContacts;		/**< Contacts which touch for the first time in this step */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Class of Box2D scene
  */
 class CBox2DScene
 {
@@ -42,10 +125,27 @@ public:
 	/**
 	 * @brief Tick scene
 	 * 
-	 * @param InDeltaTime The time since the last tick
+	 * @param InDeltaTime Time of one fixed physics step
 	 */
 	void Tick( float InDeltaTime );
 
+	/**
+	 * @brief Begin simulate one step of scene
+	 * @note Box2D isn't thread safe, so step is simulated right away on the calling thread
+	 *
+	 * @param InDeltaTime Time of one fixed physics step
+	 */
+	FORCEINLINE void BeginSimulate( float InDeltaTime )
+	{
+		Tick( InDeltaTime );
+	}
+
+	/**
+	 * @brief Wait end of simulation started by BeginSimulate
+	 */
+	FORCEINLINE void EndSimulate()
+	{}
+
 	/**
 	 * @brief Shutdown scene
 	 */
@@ -63,20 +163,44 @@ public:
 	 */
 	void RemoveBody( class CPhysicsBodyInstance* InBodyInstance );
 
+	/**
+	 * @brief Add end events for bodies which touch removed body
+	 * @note Must be called before physics actor of body is released
+	 *
+	 * @param InBodyInstance	Pointer to removed body instance
+	 */
+	void AddEndEventsOfRemovedBody( class CPhysicsBodyInstance* InBodyInstance );
+
 	/**
 	 * @brief Remove all bodies from scene
 	 */
-	FORCEINLINE void RemoveAllBodies()
+	void RemoveAllBodies();
+
+	/**
+	 * @brief Get bodies on scene
+	 * @return Return array of bodies on scene
+	 */
+	FORCEINLINE const std::vector< class CPhysicsBodyInstance* >& GetBodies() const
 	{
-		bodies.clear();
-		for ( uint32 index = 0; index < CC_Max; ++index )
-		{
-			fixturesMap[ index ].clear();
-		}
+		return bodies;
 	}
 
 	/**
-	 * Trace a ray against the world using a specific channel and return the first blocking hit
+	 * @brief Get bodies moved by the last step
+	 * @param OutBodies	Output array of awake not static bodies
+	 */
+	void GetActiveBodies( std::vector< class CPhysicsBodyInstance* >& OutBodies ) const;
+
+	/**
+	 * @brief Get statistics of scene
+	 * @note Times of phases are accumulated over all steps since the previous call
+	 *
+	 * @param OutStats	Output statistics of scene
+	 */
+	void GetStats( PhysicsSceneStats& OutStats );
+
+	/**
+	 * Trace a ray against the world using a specific channel and return the closest hit
 	 *
 	 * @param OutHitResult Hit result
 	 * @param InStart Start ray
@@ -87,6 +211,44 @@ public:
 	 */
 	bool LineTraceSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam );
 
+	/**
+	 * Trace a ray against the world using a specific channel and return all hits sorted by distance
+	 *
+	 * @param OutHitResults Array of hit results
+	 * @param InStart Start ray
+	 * @param InEnd End ray
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return TRUE if any hit is found, else false
+	 */
+	bool LineTraceMultiByChannel( std::vector<HitResult>& OutHitResults, const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam );
+
+	/**
+	 * Sweep a shape against the world using a specific channel and return the closest hit
+	 *
+	 * @param OutHitResult Hit result
+	 * @param InStart Start location of the shape
+	 * @param InEnd End location of the shape
+	 * @param InRotation Rotation of the shape
+	 * @param InShape Shape to sweep
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return TRUE if a blocking hit is found, else false
+	 */
+	bool SweepSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, const Quaternion& InRotation, const CollisionShape& InShape, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam );
+
+	/**
+	 * Test the shape against the world using a specific channel and return all overlapping components
+	 *
+	 * @param OutOverlapResults Array of overlap results
+	 * @param InLocation Location of the shape
+	 * @param InRotation Rotation of the shape
+	 * @param InShape Shape to test
+	 * @param InTraceChannel Trace channel
+	 * @return Return TRUE if any overlap is found, else false
+	 */
+	bool OverlapMultiByChannel( std::vector<OverlapResult>& OutOverlapResults, const Vector& InLocation, const Quaternion& InRotation, const CollisionShape& InShape, ECollisionChannel InTraceChannel );
+
 	/**
 	 * @brief Get Box2D world
 	 * @return Return Box2D world
@@ -98,8 +260,10 @@ public:
 
 private:
 	b2World*																		bx2World;						/**< Box2D world */
+	CBox2DContactFilter																contactFilter;					/**< Contact filter */
+	CBox2DContactListener															contactListener;				/**< Contact listener */
 	std::vector< class CPhysicsBodyInstance* >										bodies;							/**< Array of bodies on scene */
-	std::unordered_map< class CPhysicsBodyInstance*, std::vector< b2Fixture* > >	fixturesMap[ CC_Max ];			/**< Map of fixtures each collision channel */
+	b2Profile																		profile;						/**< Times of step phases accumulated since the last GetStats */
 };
 #endif // WITH_BOX2D
 
@@ -14,6 +14,79 @@
 #include <PxPhysicsAPI.h>
 #include <vector>
 
+#include "Misc/PhysicsTypes.h"
+
+/**
+ * @ingroup Physics
+ * @brief Max number of contact points of one pair read for collision events
+ */
+#define PHYSX_MAX_CONTACT_POINTS		8
+
+/**
+ * @ingroup Physics
+ * @brief PhysX simulation event callback
+ *
+ * Called from fetchResults on the game thread. Begin, end and hits of contacts are recorded to buffer of collision events (see CPhysicsContactBuffer)
+ */
+class CPhysXSimulationEventCallback : public physx::PxSimulationEventCallback
+{
+public:
+	/**
+	 * @brief This is called when certain contact events occur
+	 *
+	 * @param InPairHeader	Information on the two actors whose shapes triggered a contact report
+	 * @param InPairs		The contact pairs of two actors for which contact reports have been requested
+	 * @param InNumPairs	The number of provided contact pairs
+	 */
+	virtual void onContact( const physx::PxContactPairHeader& InPairHeader, const physx::PxContactPair* InPairs, physx::PxU32 InNumPairs ) override;
+
+	/**
+	 * @brief This is called when a breakable constraint breaks
+	 *
+	 * @param InConstraints		The constraints which have been broken
+	 * @param InCount			The number of constraints
+	 */
+	virtual void onConstraintBreak( physx::PxConstraintInfo* InConstraints, physx::PxU32 InCount ) override
+	{}
+
+	/**
+	 * @brief This is called with the actors which have just been woken up
+	 *
+	 * @param InActors	The actors which just woke up
+	 * @param InCount	The number of actors
+	 */
+	virtual void onWake( physx::PxActor** InActors, physx::PxU32 InCount ) override
+	{}
+
+	/**
+	 * @brief This is called with the actors which have just been put to sleep
+	 *
+	 * @param InActors	The actors which have just been put to sleep
+	 * @param InCount	The number of actors
+	 */
+	virtual void onSleep( physx::PxActor** InActors, physx::PxU32 InCount ) override
+	{}
+
+	/**
+	 * @brief This is called with the current trigger pair events
+	 *
+	 * @param InPairs	The trigger pair events
+	 * @param InCount	The number of trigger pair events
+	 */
+	virtual void onTrigger( physx::PxTriggerPair* InPairs, physx::PxU32 InCount ) override
+	{}
+
+	/**
+	 * @brief Provides early access to the new pose of moving rigid bodies
+	 *
+	 * @param InBodyBuffer	The rigid bodies that moved
+	 * @param InPoseBuffer	The integrated rigid body poses of the bodies listed in InBodyBuffer
+	 * @param InCount		The number of entries in the provided buffers
+	 */
+	virtual void onAdvance( const physx::PxRigidBody* const* InBodyBuffer, const physx::PxTransform* InPoseBuffer, const physx::PxU32 InCount ) override
+	{}
+};
+
 /**
  * @ingroup Physics
  * @brief Class of PhysX scene
@@ -39,10 +112,23 @@ public:
 	/**
 	 * @brief Tick scene
 	 * 
-	 * @param InDeltaTime The time since the last tick
+	 * @param InDeltaTime Time of one fixed physics step
 	 */
 	void Tick( float InDeltaTime );
 
+	/**
+	 * @brief Begin simulate one step of scene on worker threads
+	 * @note Until EndSimulate writes to scene are buffered by PhysX and reads return state before the step
+	 *
+	 * @param InDeltaTime Time of one fixed physics step
+	 */
+	void BeginSimulate( float InDeltaTime );
+
+	/**
+	 * @brief Wait end of simulation started by BeginSimulate and fetch results
+	 */
+	void EndSimulate();
+
 	/**
 	 * @brief Shutdown scene
 	 */
@@ -60,14 +146,49 @@ public:
 	 */
 	void RemoveBody( class CPhysicsBodyInstance* InBodyInstance );
 
+	/**
+	 * @brief Add end events for bodies which touch removed body
+	 * @note Must be called before physics actor of body is released
+	 * @note PhysX reports contacts of removed actor with invalid shapes, so response of pair is unknown and nothing is added
+	 *
+	 * @param InBodyInstance	Pointer to removed body instance
+	 */
+	FORCEINLINE void AddEndEventsOfRemovedBody( class CPhysicsBodyInstance* InBodyInstance )
+	{}
+
 	/**
 	 * @brief Remove all bodies from scene
 	 */
 	void RemoveAllBodies();
 
+	/**
+	 * @brief Get bodies on scene
+	 * @return Return array of bodies on scene
+	 */
+	FORCEINLINE const std::vector< class CPhysicsBodyInstance* >& GetBodies() const
+	{
+		return bodies;
+	}
+
+	/**
+	 * @brief Get bodies moved by the last step
+	 * @param OutBodies	Output array of active actors reported by PhysX
+	 */
+	void GetActiveBodies( std::vector< class CPhysicsBodyInstance* >& OutBodies ) const;
+
+	/**
+	 * @brief Get statistics of scene
+	 * @note PhysX doesn't report times of phases without profiler, so they are zero
+	 *
+	 * @param OutStats	Output statistics of scene
+	 */
+	void GetStats( PhysicsSceneStats& OutStats );
+
 private:
 	physx::PxScene*									pxScene;						/**< PhysX scene */
 	physx::PxDefaultCpuDispatcher*					pxDefaultCpuDispatcher;			/**< Default CPU dispatcher */
+	bool											bSimulating;					/**< Is scene simulating now */
+	CPhysXSimulationEventCallback					simulationEventCallback;		/**< Simulation event callback */
 	std::vector< class CPhysicsBodyInstance* >		bodies;							/**< Array of bodies on scene */
 };
 #endif // WITH_PHYSX
@@ -43,6 +43,14 @@ public:
 	 */
 	void TermBody();
 
+	/**
+	 * @brief Change body setup of initialized body
+	 * @note Physics actor isn't recreated, only its shapes are swapped. Velocity and sleep state of body are kept
+	 *
+	 * @param InBodySetup New rigid body setup
+	 */
+	void SetBodySetup( CPhysicsBodySetup* InBodySetup );
+
 	/**
 	 * @brief Add angular impulse
 	 *
@@ -170,6 +178,63 @@ public:
 		bStartAwake = InStartAwake;
 	}
 
+	/**
+	 * @brief Set continuous collision detection
+	 * @note For fast bodies (projectiles) which must not tunnel through thin colliders. Applied on InitBody
+	 *
+	 * @param InCCD Is need enable continuous collision detection
+	 */
+	FORCEINLINE void SetCCD( bool InCCD )
+	{
+		bCCD = InCCD;
+	}
+
+	/**
+	 * @brief Set allow body to fall asleep
+	 * @note Applied on InitBody
+	 *
+	 * @param InAllowSleep Is body allowed to fall asleep
+	 */
+	FORCEINLINE void SetAllowSleep( bool InAllowSleep )
+	{
+		bAllowSleep = InAllowSleep;
+	}
+
+	/**
+	 * @brief Set sleep threshold
+	 * @note Applied on InitBody. Supported only by PhysX, Box2D has one sleep tolerance for all bodies
+	 *
+	 * @param InSleepThreshold Mass-normalized kinetic energy below which body may fall asleep, 0 is default of physics engine
+	 */
+	FORCEINLINE void SetSleepThreshold( float InSleepThreshold )
+	{
+		sleepThreshold = InSleepThreshold;
+	}
+
+	/**
+	 * @brief Set solver iterations
+	 * @note Applied on InitBody. Supported only by PhysX, Box2D solves all bodies with iterations of scene
+	 *
+	 * @param InPositionIterations Number of position iterations, 0 is default from config
+	 * @param InVelocityIterations Number of velocity iterations, 0 is default from config
+	 */
+	FORCEINLINE void SetSolverIterations( uint32 InPositionIterations, uint32 InVelocityIterations )
+	{
+		positionIterations = InPositionIterations;
+		velocityIterations = InVelocityIterations;
+	}
+
+	/**
+	 * @brief Set notify flags
+	 * @note Collision events are recorded if one of bodies has notify flag of event, and are dispatched only to bodies with this flag
+	 *
+	 * @param InNotifyFlags Notify flags (see EPhysicsNotifyFlags)
+	 */
+	FORCEINLINE void SetNotifyFlags( uint32 InNotifyFlags )
+	{
+		notifyFlags = InNotifyFlags;
+	}
+
 	/**
 	 * @brief Is dynamic rigid body
 	 * @return Returns true if the body is not static
@@ -188,6 +253,51 @@ public:
 		return CPhysicsInterface::GetTransform( handle );
 	}
 
+	/**
+	 * @brief Get LE world transform interpolated between two last physics steps
+	 * @return Return interpolated LE world transform, for static bodies or if interpolation is disabled return current transform
+	 */
+	CTransform GetLEInterpolatedTransform() const;
+
+	/**
+	 * @brief Remember current transform of body as transform of previous physics step
+	 */
+	FORCEINLINE void SavePreviousTransform()
+	{
+		previousTransform = CPhysicsInterface::GetTransform( handle );
+	}
+
+	/**
+	 * @brief Copy transform of body from physics to buffer of current transform
+	 * @note Called at sync point when scene isn't simulating
+	 */
+	FORCEINLINE void SyncTransform()
+	{
+		currentTransform = CPhysicsInterface::GetTransform( handle );
+	}
+
+	/**
+	 * @brief Get state of physics actor
+	 * @return Return state of physics actor for save and hash of physics state
+	 */
+	FORCEINLINE PhysicsActorState_t GetActorState() const
+	{
+		return CPhysicsInterface::GetActorState( handle );
+	}
+
+	/**
+	 * @brief Set state of physics actor
+	 * @note Buffered transforms of body are reset to new state, so body isn't interpolated from old transform
+	 *
+	 * @param InActorState	State of physics actor
+	 */
+	FORCEINLINE void SetActorState( const PhysicsActorState_t& InActorState )
+	{
+		CPhysicsInterface::SetActorState( handle, InActorState );
+		currentTransform	= CPhysicsInterface::GetTransform( handle );
+		previousTransform	= currentTransform;
+	}
+
 	/**
 	 * @brief Get body setup
 	 * @return Return body setup
@@ -278,6 +388,78 @@ public:
 		return bStartAwake;
 	}
 
+	/**
+	 * @brief Get notify flags
+	 * @return Return notify flags (see EPhysicsNotifyFlags)
+	 */
+	FORCEINLINE uint32 GetNotifyFlags() const
+	{
+		return notifyFlags;
+	}
+
+	/**
+	 * @brief Is enabled continuous collision detection
+	 * @return Return true if for body enabled continuous collision detection, else return false
+	 */
+	FORCEINLINE bool IsCCD() const
+	{
+		return bCCD;
+	}
+
+	/**
+	 * @brief Is body allowed to fall asleep
+	 * @return Return true if body allowed to fall asleep, else return false
+	 */
+	FORCEINLINE bool IsAllowSleep() const
+	{
+		return bAllowSleep;
+	}
+
+	/**
+	 * @brief Get sleep threshold
+	 * @return Return sleep threshold, 0 is default of physics engine
+	 */
+	FORCEINLINE float GetSleepThreshold() const
+	{
+		return sleepThreshold;
+	}
+
+	/**
+	 * @brief Get number of solver position iterations
+	 * @return Return number of position iterations, 0 is default from config
+	 */
+	FORCEINLINE uint32 GetPositionIterations() const
+	{
+		return positionIterations;
+	}
+
+	/**
+	 * @brief Get number of solver velocity iterations
+	 * @return Return number of velocity iterations, 0 is default from config
+	 */
+	FORCEINLINE uint32 GetVelocityIterations() const
+	{
+		return velocityIterations;
+	}
+
+	/**
+	 * @brief Set body is in array of active bodies of physics engine
+	 * @param InActive	Is body active
+	 */
+	FORCEINLINE void SetActive( bool InActive )
+	{
+		bActive = InActive;
+	}
+
+	/**
+	 * @brief Is body in array of active bodies of physics engine
+	 * @return Return true if body moved by the last physics step and need write back, else return false
+	 */
+	FORCEINLINE bool IsActive() const
+	{
+		return bActive;
+	}
+
 	/**
 	 * @brief Is body need reinit
 	 * @return Return true if body is ditrty, else return false
@@ -288,16 +470,35 @@ public:
 	}
 
 private:
+	/**
+	 * @brief Attach all shapes of body setup to physics actor
+	 */
+	void AttachShapes();
+
+	/**
+	 * @brief Detach all shapes of body setup from physics actor
+	 */
+	void DetachShapes();
+
 	bool											bStatic;			/**< Is static rigid body */
 	bool											bEnableGravity;		/**< Enable gravity */
 	bool											bSimulatePhysics;	/**< Need simulate physics */
 	bool											bStartAwake;		/**< Start awake */
 	bool											bDirty;				/**< Is body is dirty and need reinit hem */
+	bool											bActive;			/**< Is body in array of active bodies of physics engine */
+	bool											bCCD;				/**< Enable continuous collision detection */
+	bool											bAllowSleep;		/**< Allow body to fall asleep */
 	uint32											lockFlags;			/**< Lock flags */
+	uint32											notifyFlags;		/**< Notify flags of collision events */
+	uint32											positionIterations;	/**< Number of solver position iterations, 0 is default */
+	uint32											velocityIterations;	/**< Number of solver velocity iterations, 0 is default */
 	float											mass;				/**< Mass of body */
+	float											sleepThreshold;		/**< Sleep threshold, 0 is default */
 	TRefCountPtr< class CPrimitiveComponent >		ownerComponent;		/**< PrimitiveComponent containing this body */	
 	PhysicsBodySetupRef_t							bodySetup;			/**< Body setup */
 	PhysicsActorHandle_t							handle;				/**< Handle to physics actor */
+	CTransform										previousTransform;	/**< Transform of body before last physics step */
+	CTransform										currentTransform;	/**< Transform of body after last physics step, updated at sync point */
 };
 
 #endif // !PHYSICSBODYINSTANCE_H
\ No newline at end of file
@@ -42,12 +42,49 @@ public:
 	 */
 	void Serialize( class CArchive& InArchive );
 
+	/**
+	 * @brief Get hash of collision geometry
+	 * @return Return hash of all shapes in body setup
+	 */
+	uint64 GetTypeHash() const;
+
+	/**
+	 * @brief Is body setups have the same collision geometry
+	 *
+	 * @param InBodySetup	Other body setup
+	 * @return Return true if all shapes of body setups are equal, else return false
+	 */
+	FORCEINLINE bool IsEqualGeometry( const CPhysicsBodySetup& InBodySetup ) const
+	{
+		return boxGeometries == InBodySetup.boxGeometries;
+	}
+
+	/**
+	 * @brief Set body setup is in cache of physics engine
+	 * @param InCached	Is body setup cached
+	 */
+	FORCEINLINE void SetCached( bool InCached )
+	{
+		bCached = InCached;
+	}
+
+	/**
+	 * @brief Is body setup in cache of physics engine
+	 * @note Cached body setup is shared by many bodies, so it must not be changed
+	 * @return Return true if body setup is cached, else return false
+	 */
+	FORCEINLINE bool IsCached() const
+	{
+		return bCached;
+	}
+
 	/**
 	 * @brief Add box geometry
 	 * @param InBoxGeometry Box geometry
 	 */
 	FORCEINLINE void AddBoxGeometry( const PhysicsBoxGeometry& InBoxGeometry )
 	{
+		Assert( !bCached );
 		boxGeometries.push_back( InBoxGeometry );
 	}
 
@@ -63,6 +100,7 @@ public:
 	 */
 	FORCEINLINE void RemoveBoxGeometry( uint32 InIndex )
 	{
+		Assert( !bCached );
 		if ( boxGeometries.size() <= InIndex )
 		{
 			return;
@@ -75,6 +113,7 @@ public:
 	 */
 	FORCEINLINE void RemoveAllBoxGeometries()
 	{
+		Assert( !bCached );
 		boxGeometries.clear();
 	}
 
@@ -97,6 +136,7 @@ public:
 	}
 
 private:
+	bool									bCached;			/**< Is body setup in cache of physics engine */
 	std::vector< PhysicsBoxGeometry >		boxGeometries;		/**< Array of box collisions */
 };
 
@@ -87,6 +87,7 @@ public:
 	{
 		return
 			collisionShape == InBoxGometry.collisionShape &&
+			collisionProfile == InBoxGometry.collisionProfile &&
 			material == InBoxGometry.material &&
 			location == InBoxGometry.location &&
 			rotation == InBoxGometry.rotation &&
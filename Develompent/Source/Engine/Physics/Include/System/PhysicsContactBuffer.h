@@ -0,0 +1,131 @@
+/**
+ * @file
+ * @addtogroup Physics Physics
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef PHYSICSCONTACTBUFFER_H
+#define PHYSICSCONTACTBUFFER_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "Math/Math.h"
+#include "Misc/PhysicsTypes.h"
+#include "Core.h"
+
+/**
+ * @ingroup Physics
+ * @brief Default max number of collision events in one frame
+ */
+#define PHYSICS_DEFAULT_MAX_CONTACT_EVENTS		1024
+
+/**
+ * @ingroup Physics
+ * @brief Default min normal impulse of hit after the first step of contact
+ */
+#define PHYSICS_DEFAULT_MIN_HIT_IMPULSE			50.f
+
+/**
+ * @ingroup Physics
+ * @brief Buffer of collision events of one frame
+ *
+ * Physics scene adds events from its contact callbacks during all steps of frame, game dispatches them at once after the sync point.
+ * Events are recorded only if one of bodies has notify flag of event. Resting contacts are solved every step, so hit is recorded
+ * only on the first step of contact or if its impulse isn't less than min hit impulse. Hits of the same pair are coalesced into one event per frame,
+ * and new hits over the budget are dropped. Begin and end events are never dropped, so pairs of them are always consistent.
+ * They aren't limited by the budget, so buffer grows over it when many pairs start or stop touching in one frame,
+ * its size is bounded only by number of begin and end events of frame.
+ * When body is removed from scene while it touches other bodies, they get end events with the next dispatch
+ */
+class CPhysicsContactBuffer
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CPhysicsContactBuffer();
+
+	/**
+	 * @brief Init buffer
+	 * @param InMaxEvents		Max number of hits in one frame, begin and end events are kept over it
+	 * @param InMinHitImpulse	Min normal impulse of hit after the first step of contact
+	 */
+	void Init( uint32 InMaxEvents, float InMinHitImpulse );
+
+	/**
+	 * @brief Add collision event
+	 * @note Called by physics scene from its contact callbacks
+	 *
+	 * @param InType		Event type
+	 * @param InBodyA		First body
+	 * @param InBodyB		Second body
+	 * @param InPoint		Contact point in world space
+	 * @param InNormal		Contact normal in world space, points from body A to body B
+	 * @param InImpulse		Normal impulse of hit
+	 * @param InIsNewContact	Is hit on the first step of contact, such hit is recorded for any impulse
+	 */
+	void AddEvent( EPhysicsContactEventType InType, class CPhysicsBodyInstance* InBodyA, class CPhysicsBodyInstance* InBodyB, const Vector& InPoint = Math::vectorZero, const Vector& InNormal = Math::vectorZero, float InImpulse = 0.f, bool InIsNewContact = false );
+
+	/**
+	 * @brief Add end event for body which partner is removed from scene
+	 * @note Event is dispatched with the next frame and has no partner, so it doesn't depend on when body was removed
+	 *
+	 * @param InType			Event type, end of contact or end of overlap
+	 * @param InBodyInstance	Body which still in scene
+	 */
+	void AddRemovedPartnerEvent( EPhysicsContactEventType InType, class CPhysicsBodyInstance* InBodyInstance );
+
+	/**
+	 * @brief Remove body from events
+	 * @note Events aren't erased, their pointer to body is reset to NULL and the other body still gets them, so buffer may be changed while it is dispatching
+	 *
+	 * @param InBodyInstance	Body instance
+	 */
+	void RemoveBody( class CPhysicsBodyInstance* InBodyInstance );
+
+	/**
+	 * @brief Remove all events
+	 */
+	void Reset();
+
+	/**
+	 * @brief Get collision events
+	 * @return Return array of collision events in order of recording
+	 */
+	FORCEINLINE const std::vector< PhysicsContactEvent >& GetEvents() const
+	{
+		return events;
+	}
+
+	/**
+	 * @brief Get number of dropped events
+	 * @return Return number of hits dropped over the budget since the last reset
+	 */
+	FORCEINLINE uint32 GetNumDroppedEvents() const
+	{
+		return numDroppedEvents;
+	}
+
+	/**
+	 * @brief Get number of coalesced events
+	 * @return Return number of hits merged into already recorded events since the last reset
+	 */
+	FORCEINLINE uint32 GetNumCoalescedEvents() const
+	{
+		return numCoalescedEvents;
+	}
+
+private:
+	uint32												maxEvents;				/**< Max number of hits in one frame */
+	float												minHitImpulse;			/**< Min normal impulse of hit after the first step of contact */
+	uint32												numDroppedEvents;		/**< Number of hits dropped over the budget */
+	uint32												numCoalescedEvents;		/**< Number of hits merged into recorded events */
+	std::vector< PhysicsContactEvent >					events;					/**< Collision events */
+	std::vector< PhysicsContactEvent >					removedPartnerEvents;	/**< End events of bodies which partners are removed, they are moved to events on reset */
+	std::unordered_multimap< uint64, uint32 >			hitEvents;				/**< Index of hit event by hash of body pair */
+};
+
+#endif // !PHYSICSCONTACTBUFFER_H
\ No newline at end of file
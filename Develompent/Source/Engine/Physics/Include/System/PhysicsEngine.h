@@ -10,10 +10,13 @@
 #define PHYSICSENGINE_H
 
 #include <string>
+#include <vector>
 #include <unordered_map>
 
 #include "Logger/LoggerMacros.h"
 #include "System/PhysicsMaterial.h"
+#include "System/PhysicsStepper.h"
+#include "System/PhysicsContactBuffer.h"
 #include "Core.h"
 
 /**
@@ -40,10 +43,124 @@ public:
 
 	/**
 	 * @brief Tick engine
+	 * @note Frame time is simulated by fixed steps, see CPhysicsStepper
 	 * 
 	 * @param InDeltaTime The time since the last tick
 	 */
-	void Tick( float InDeltaTime );
+	FORCEINLINE void Tick( float InDeltaTime )
+	{
+		BeginTick( InDeltaTime );
+		EndTick();
+	}
+
+	/**
+	 * @brief Begin tick engine
+	 * @note Last step of frame is simulated asynchronously until EndTick, so game can tick in parallel with it
+	 *
+	 * @param InDeltaTime The time since the last tick
+	 */
+	void BeginTick( float InDeltaTime );
+
+	/**
+	 * @brief End tick engine
+	 * @note This is sync point. Waits end of simulation, copies transforms of bodies to their buffers and executes deferred query batches.
+	 * After it collision events of this frame are ready for dispatch (see GetContactBuffer)
+	 */
+	void EndTick();
+
+	/**
+	 * @brief Simulate exactly one step
+	 * @note Frame time isn't used, so driver of lockstep simulation (replay or network) calls it once per its tick.
+	 * Step is simulated synchronously and ends by sync point like EndTick. Must be called outside of BeginTick/EndTick
+	 */
+	void StepOnce();
+
+	/**
+	 * @brief Save state of all bodies in physics scene
+	 * @note Must be called outside of BeginTick/EndTick, when scene isn't simulating
+	 *
+	 * @param OutSnapshot	Output snapshot of physics state
+	 */
+	void SaveState( struct PhysicsStateSnapshot& OutSnapshot ) const;
+
+	/**
+	 * @brief Restore state of bodies from snapshot
+	 * @note Must be called outside of BeginTick/EndTick, when scene isn't simulating. Restored bodies are written back to their components at the next sync
+	 *
+	 * @param InSnapshot	Snapshot of physics state
+	 */
+	void RestoreState( const struct PhysicsStateSnapshot& InSnapshot );
+
+	/**
+	 * @brief Remove body from array of active bodies
+	 * @param InBodyInstance	Body instance
+	 */
+	void RemoveActiveBody( class CPhysicsBodyInstance* InBodyInstance );
+
+	/**
+	 * @brief Get bodies which need write back to their components
+	 * @note Array is updated at sync point in EndTick. Bodies fallen asleep stay in it until the next update for write back final transform
+	 * @return Return array of bodies moved by physics
+	 */
+	FORCEINLINE const std::vector< class CPhysicsBodyInstance* >& GetActiveBodies() const
+	{
+		return activeBodies;
+	}
+
+	/**
+	 * @brief Remove body from collision events of this frame
+	 * @note Bodies which still touch it get end events, must be called before physics actor of body is released
+	 * @param InBodyInstance	Body instance
+	 */
+	void RemoveContactEvents( class CPhysicsBodyInstance* InBodyInstance );
+
+	/**
+	 * @brief Get collision events of this frame
+	 * @note Buffer is filled by physics scene during steps and is ready after sync point in EndTick, it is reset at the next BeginTick
+	 * @return Return buffer of collision events
+	 */
+	FORCEINLINE CPhysicsContactBuffer& GetContactBuffer()
+	{
+		return contactBuffer;
+	}
+
+	/**
+	 * @brief Add query batch for execute at the next sync point
+	 * @param InQueryBatch	Query batch
+	 */
+	void AddDeferredQueryBatch( class CPhysicsQueryBatch* InQueryBatch );
+
+	/**
+	 * @brief Remove query batch from deferred execution
+	 * @param InQueryBatch	Query batch
+	 */
+	void RemoveDeferredQueryBatch( class CPhysicsQueryBatch* InQueryBatch );
+
+	/**
+	 * @brief Find body setup with the same collision geometry in cache or add it to cache
+	 * @note Cached body setup is shared by all bodies with the same geometry, so its shapes are created only once
+	 *
+	 * @param InBodySetup	Body setup
+	 * @return Return cached body setup with the same geometry as InBodySetup
+	 */
+	TRefCountPtr< class CPhysicsBodySetup > FindOrAddCachedBodySetup( class CPhysicsBodySetup* InBodySetup );
+
+	/**
+	 * @brief Remove body setup from cache
+	 * @note Called when the last reference to cached body setup is released
+	 *
+	 * @param InBodySetup	Body setup
+	 */
+	void RemoveCachedBodySetup( class CPhysicsBodySetup* InBodySetup );
+
+	/**
+	 * @brief Get number of body setups in cache
+	 * @return Return number of body setups in cache
+	 */
+	FORCEINLINE uint32 GetNumCachedBodySetups() const
+	{
+		return cachedBodySetups.size();
+	}
 
 	/**
 	 * @brief Shutdown engine
@@ -77,7 +194,88 @@ public:
 		return defaultPhysMaterial;
 	}
 
+	/**
+	 * @brief Get physics stepper
+	 * @return Return fixed timestep driver of physics
+	 */
+	FORCEINLINE const CPhysicsStepper& GetStepper() const
+	{
+		return stepper;
+	}
+
+	/**
+	 * @brief Is deterministic mode
+	 * @return Return true if hash of physics state is calculated after each step, else return false
+	 */
+	FORCEINLINE bool IsDeterministic() const
+	{
+		return bDeterministic;
+	}
+
+	/**
+	 * @brief Get hash of physics state
+	 * @note Updated only in deterministic mode after each step. Compare it between machines or runs for detect desync
+	 * @return Return hash of physics state after the last step
+	 */
+	FORCEINLINE uint64 GetStateHash() const
+	{
+		return stateHash;
+	}
+
+	/**
+	 * @brief Get default number of solver position iterations
+	 * @return Return number of position iterations from config, 0 is default of physics engine
+	 */
+	FORCEINLINE uint32 GetPositionIterations() const
+	{
+		return positionIterations;
+	}
+
+	/**
+	 * @brief Get default number of solver velocity iterations
+	 * @return Return number of velocity iterations from config, 0 is default of physics engine
+	 */
+	FORCEINLINE uint32 GetVelocityIterations() const
+	{
+		return velocityIterations;
+	}
+
+	/**
+	 * @brief Is enabled interpolation of body transforms
+	 * @return Return true if body transforms are interpolated between two last physics steps
+	 */
+	FORCEINLINE bool IsInterpolationEnabled() const
+	{
+		return bInterpolation;
+	}
+
 private:
+	/**
+	 * @brief Simulate steps of frame
+	 * @note All steps except the last are simulated right away, the last one is simulated asynchronously until EndTick
+	 *
+	 * @param InNumSteps	Number of steps
+	 */
+	void SimulateSteps( uint32 InNumSteps );
+
+	/**
+	 * @brief Calculate hash of physics state
+	 * @return Return hash of states of all bodies in order of physics scene
+	 */
+	uint64 CalcStateHash() const;
+
+	bool																bDeterministic;					/**< Is hash of physics state calculated after each step */
+	bool																bInterpolation;					/**< Is need interpolate body transforms between two last steps */
+	uint32																numFrameSteps;					/**< Number of steps in current frame */
+	uint32																positionIterations;				/**< Default number of solver position iterations, 0 is default of physics engine */
+	uint32																velocityIterations;				/**< Default number of solver velocity iterations, 0 is default of physics engine */
+	uint64																stateHash;						/**< Hash of physics state after the last step, updated only in deterministic mode */
+	CPhysicsStepper														stepper;						/**< Fixed timestep driver */
+	CPhysicsContactBuffer												contactBuffer;					/**< Collision events of this frame */
+	std::vector< class CPhysicsQueryBatch* >							deferredQueryBatches;			/**< Query batches for execute at the next sync point */
+	std::vector< class CPhysicsBodyInstance* >							activeBodies;					/**< Bodies moved by physics */
+	std::vector< class CPhysicsBodyInstance* >							prevActiveBodies;				/**< Bodies moved by physics in scene at previous sync, bodies fallen asleep since it are written back once more */
+	std::unordered_multimap< uint64, class CPhysicsBodySetup* >			cachedBodySetups;				/**< Shared body setups by hash of their geometry. Doesn't hold references, body setup removes itself on destroy */
 	TAssetHandle<CPhysicsMaterial>										defaultPhysMaterial;			/**< Default physics material */
 	mutable std::unordered_map< std::wstring,  CollisionProfile >		collisionProfiles;				/**< Collision profiles map */
 };
@@ -0,0 +1,272 @@
+/**
+ * @file
+ * @addtogroup Physics Physics
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef PHYSICSQUERYBATCH_H
+#define PHYSICSQUERYBATCH_H
+
+#include <vector>
+
+#include "Math/Math.h"
+#include "Misc/PhysicsTypes.h"
+#include "Core.h"
+
+/**
+ * @ingroup Physics
+ * @brief Number of queries which are taken by worker thread at once
+ */
+#define PHYSICS_QUERY_BATCH_SIZE		8
+
+/**
+ * @ingroup Physics
+ * @brief Enumeration of scene query types
+ */
+enum EPhysicsQueryType
+{
+	PQT_LineTraceSingle,		/**< Closest hit of line trace */
+	PQT_LineTraceMulti,			/**< All hits of line trace */
+	PQT_SweepSingle,			/**< Closest hit of shape sweep */
+	PQT_OverlapMulti			/**< All overlaps of shape */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Scene query in batch
+ */
+struct PhysicsQuery
+{
+	EPhysicsQueryType		type;			/**< Query type */
+	ECollisionChannel		traceChannel;	/**< Trace channel */
+	Vector					start;			/**< Start of trace or location of overlap */
+	Vector					end;			/**< End of trace */
+	Quaternion				rotation;		/**< Rotation of shape */
+	CollisionShape			shape;			/**< Shape for sweep and overlap */
+	CollisionQueryParams	params;			/**< Collision query params */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Result of scene query in batch. Refers to range in array of hit results or overlap results of batch
+ */
+struct PhysicsQueryResult
+{
+	/**
+	 * @brief Constructor
+	 */
+	PhysicsQueryResult()
+		: firstResult( 0 )
+		, numResults( 0 )
+	{}
+
+	/**
+	 * @brief Is query found anything
+	 * @return Return TRUE if query has hits or overlaps, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsHit() const
+	{
+		return numResults > 0;
+	}
+
+	uint32		firstResult;	/**< Index of first hit or overlap */
+	uint32		numResults;		/**< Number of hits or overlaps */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Batch of scene queries
+ *
+ * Queries are enqueued by game code and executed at once across worker threads of g_ThreadPool.
+ * Scene isn't changed while batch is executing, so queries read the broadphase without locks.
+ * Results of all queries are packed into contiguous arrays
+ */
+class CPhysicsQueryBatch
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CPhysicsQueryBatch();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CPhysicsQueryBatch();
+
+	/**
+	 * @brief Add line trace for the closest hit
+	 *
+	 * @param InStart Start ray
+	 * @param InEnd End ray
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return index of query in batch
+	 */
+	uint32 AddLineTraceSingle( const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam );
+
+	/**
+	 * @brief Add line trace for all hits
+	 *
+	 * @param InStart Start ray
+	 * @param InEnd End ray
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return index of query in batch
+	 */
+	uint32 AddLineTraceMulti( const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam );
+
+	/**
+	 * @brief Add shape sweep for the closest hit
+	 *
+	 * @param InStart Start location of the shape
+	 * @param InEnd End location of the shape
+	 * @param InRotation Rotation of the shape
+	 * @param InShape Shape to sweep
+	 * @param InTraceChannel Trace channel
+	 * @param InCollisionQueryParams Collision query params
+	 * @return Return index of query in batch
+	 */
+	uint32 AddSweepSingle( const Vector& InStart, const Vector& InEnd, const Quaternion& InRotation, const CollisionShape& InShape, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams = CollisionQueryParams::defaultQueryParam );
+
+	/**
+	 * @brief Add overlap test
+	 *
+	 * @param InLocation Location of the shape
+	 * @param InRotation Rotation of the shape
+	 * @param InShape Shape to test
+	 * @param InTraceChannel Trace channel
+	 * @return Return index of query in batch
+	 */
+	uint32 AddOverlapMulti( const Vector& InLocation, const Quaternion& InRotation, const CollisionShape& InShape, ECollisionChannel InTraceChannel );
+
+	/**
+	 * @brief Execute all queries right now
+	 * @note Must be called on game thread while physics scene isn't simulating
+	 */
+	void Execute();
+
+	/**
+	 * @brief Execute all queries after the next physics step
+	 * @note Results will be ready at the sync point of physics (CPhysicsEngine::EndTick), until then batch can't be changed
+	 */
+	void ExecuteDeferred();
+
+	/**
+	 * @brief Remove all queries and results
+	 */
+	void Reset();
+
+	/**
+	 * @brief Is results of queries ready
+	 * @return Return TRUE if batch is executed, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsReady() const
+	{
+		return bReady;
+	}
+
+	/**
+	 * @brief Is batch waiting deferred execution
+	 * @return Return TRUE if batch is waiting deferred execution, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsDeferred() const
+	{
+		return bDeferred;
+	}
+
+	/**
+	 * @brief Get number of queries
+	 * @return Return number of queries in batch
+	 */
+	FORCEINLINE uint32 GetNumQueries() const
+	{
+		return queries.size();
+	}
+
+	/**
+	 * @brief Get result of query
+	 *
+	 * @param InQueryIndex	Index of query
+	 * @return Return result of query
+	 */
+	FORCEINLINE const PhysicsQueryResult& GetResult( uint32 InQueryIndex ) const
+	{
+		Assert( bReady && InQueryIndex < results.size() );
+		return results[ InQueryIndex ];
+	}
+
+	/**
+	 * @brief Get hit of line trace or sweep query
+	 *
+	 * @param InQueryIndex	Index of query
+	 * @param InHitIndex	Index of hit in query
+	 * @return Return hit result
+	 */
+	FORCEINLINE const HitResult& GetHitResult( uint32 InQueryIndex, uint32 InHitIndex = 0 ) const
+	{
+		const PhysicsQueryResult&	result = GetResult( InQueryIndex );
+		Assert( queries[ InQueryIndex ].type != PQT_OverlapMulti && InHitIndex < result.numResults );
+		return hitResults[ result.firstResult + InHitIndex ];
+	}
+
+	/**
+	 * @brief Get overlap of overlap query
+	 *
+	 * @param InQueryIndex		Index of query
+	 * @param InOverlapIndex	Index of overlap in query
+	 * @return Return overlap result
+	 */
+	FORCEINLINE const OverlapResult& GetOverlapResult( uint32 InQueryIndex, uint32 InOverlapIndex = 0 ) const
+	{
+		const PhysicsQueryResult&	result = GetResult( InQueryIndex );
+		Assert( queries[ InQueryIndex ].type == PQT_OverlapMulti && InOverlapIndex < result.numResults );
+		return overlapResults[ result.firstResult + InOverlapIndex ];
+	}
+
+	/**
+	 * @brief Get hits of all line trace and sweep queries
+	 * @return Return array of hits
+	 */
+	FORCEINLINE const std::vector<HitResult>& GetHitResults() const
+	{
+		return hitResults;
+	}
+
+	/**
+	 * @brief Get overlaps of all overlap queries
+	 * @return Return array of overlaps
+	 */
+	FORCEINLINE const std::vector<OverlapResult>& GetOverlapResults() const
+	{
+		return overlapResults;
+	}
+
+private:
+	/**
+	 * @brief Add query to batch
+	 *
+	 * @param InQuery	Query
+	 * @return Return index of query in batch
+	 */
+	uint32 AddQuery( const PhysicsQuery& InQuery );
+
+	/**
+	 * @brief Execute one query on worker thread
+	 * @param InQueryIndex	Index of query
+	 */
+	void ExecuteQuery( uint32 InQueryIndex );
+
+	bool										bReady;				/**< Is results ready */
+	bool										bDeferred;			/**< Is batch waiting deferred execution */
+	std::vector<PhysicsQuery>					queries;			/**< Queries */
+	std::vector<PhysicsQueryResult>				results;			/**< Results of queries */
+	std::vector<HitResult>						hitResults;			/**< Packed hits of all queries */
+	std::vector<OverlapResult>					overlapResults;		/**< Packed overlaps of all queries */
+	std::vector< std::vector<HitResult> >		queryHits;			/**< Hits of each query, filled by worker threads */
+	std::vector< std::vector<OverlapResult> >	queryOverlaps;		/**< Overlaps of each query, filled by worker threads */
+};
+
+#endif // !PHYSICSQUERYBATCH_H
\ No newline at end of file
@@ -0,0 +1,49 @@
+/**
+ * @file
+ * @addtogroup Physics Physics
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef PHYSICSSTATESNAPSHOT_H
+#define PHYSICSSTATESNAPSHOT_H
+
+#include <vector>
+
+#include "PhysicsInterface.h"
+#include "Core.h"
+
+/**
+ * @ingroup Physics
+ * @brief State of one body in physics state snapshot
+ */
+struct PhysicsBodySnapshot
+{
+	class CPhysicsBodyInstance*		bodyInstance;	/**< Body instance */
+	PhysicsActorState_t				state;			/**< State of physics actor */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Snapshot of physics state for rollback
+ *
+ * Bodies are stored in order of physics scene, so snapshot is taken and restored in the same order on all machines.
+ * Spawn and destroy of bodies aren't part of snapshot, game must recreate the same set of bodies before restore
+ */
+struct PhysicsStateSnapshot
+{
+	/**
+	 * @brief Constructor
+	 */
+	PhysicsStateSnapshot()
+		: numSteps( 0 )
+		, stateHash( 0 )
+	{}
+
+	uint64									numSteps;		/**< Total number of simulated steps at snapshot */
+	uint64									stateHash;		/**< Hash of physics state at snapshot */
+	std::vector< PhysicsBodySnapshot >		bodies;			/**< States of bodies */
+};
+
+#endif // !PHYSICSSTATESNAPSHOT_H
\ No newline at end of file
@@ -0,0 +1,153 @@
+/**
+ * @file
+ * @addtogroup Physics Physics
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef PHYSICSSTEPPER_H
+#define PHYSICSSTEPPER_H
+
+#include "Core.h"
+
+/**
+ * @ingroup Physics
+ * @brief Default number of physics steps per second
+ */
+#define PHYSICS_DEFAULT_STEP_RATE		60.f
+
+/**
+ * @ingroup Physics
+ * @brief Default max number of physics steps per frame
+ */
+#define PHYSICS_DEFAULT_MAX_SUBSTEPS	4
+
+/**
+ * @ingroup Physics
+ * @brief Number of stepper ticks per second. Frame time and step time are quantized to microseconds
+ */
+#define PHYSICS_TICKS_PER_SECOND		1000000
+
+/**
+ * @ingroup Physics
+ * @brief Fixed timestep driver of physics simulation
+ *
+ * Frame time is accumulated and consumed by steps of fixed size, so simulation is independent of frame rate.
+ * Time is counted in integer ticks (see PHYSICS_TICKS_PER_SECOND), so accumulation has no rounding errors.
+ * If frame is too long, number of steps is clamped by max substeps and the rest of time is dropped,
+ * otherwise slow physics makes frames even longer (spiral of death).
+ * Driver of lockstep simulation (replay or network) steps it by AdvanceOneStep, so simulation depends only on number of steps and not on frame time
+ */
+class CPhysicsStepper
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CPhysicsStepper();
+
+	/**
+	 * @brief Initialize stepper
+	 *
+	 * @param InStepRate		Number of steps per second
+	 * @param InMaxSubsteps		Max number of steps per frame
+	 */
+	void Init( float InStepRate, uint32 InMaxSubsteps );
+
+	/**
+	 * @brief Reset accumulated time
+	 */
+	void Reset();
+
+	/**
+	 * @brief Restore stepper to step of physics state snapshot
+	 * @param InNumSteps	Total number of simulated steps at snapshot
+	 */
+	FORCEINLINE void Restore( uint64 InNumSteps )
+	{
+		Reset();
+		numSteps = InNumSteps;
+	}
+
+	/**
+	 * @brief Accumulate frame time and calculate number of steps for this frame
+	 *
+	 * @param InDeltaTime	The time since the last frame
+	 * @return Return number of fixed steps need to simulate in this frame
+	 */
+	uint32 Advance( float InDeltaTime );
+
+	/**
+	 * @brief Advance by exactly one step
+	 * @note Accumulated frame time isn't changed
+	 *
+	 * @return Return number of fixed steps need to simulate, it is always 1
+	 */
+	uint32 AdvanceOneStep();
+
+	/**
+	 * @brief Get time of one step
+	 * @note Step time is quantized to ticks, so it may slightly differ from 1 / step rate
+	 * @return Return time of one step in seconds
+	 */
+	FORCEINLINE float GetStepTime() const
+	{
+		return stepTime;
+	}
+
+	/**
+	 * @brief Get time of one step in ticks
+	 * @return Return time of one step in ticks
+	 */
+	FORCEINLINE int64 GetStepTicks() const
+	{
+		return stepTicks;
+	}
+
+	/**
+	 * @brief Get max number of steps per frame
+	 * @return Return max number of steps per frame
+	 */
+	FORCEINLINE uint32 GetMaxSubsteps() const
+	{
+		return maxSubsteps;
+	}
+
+	/**
+	 * @brief Get interpolation alpha between two last steps
+	 * @return Return part of step accumulated but not simulated yet, in range [0, 1)
+	 */
+	FORCEINLINE float GetAlpha() const
+	{
+		return ( float )accumulator / stepTicks;
+	}
+
+	/**
+	 * @brief Get total number of simulated steps
+	 * @return Return total number of simulated steps since last reset
+	 */
+	FORCEINLINE uint64 GetNumSteps() const
+	{
+		return numSteps;
+	}
+
+	/**
+	 * @brief Get number of dropped steps in the last frame
+	 * @return Return number of steps dropped by max substeps clamp in the last frame
+	 */
+	FORCEINLINE uint32 GetNumDroppedSteps() const
+	{
+		return numDroppedSteps;
+	}
+
+private:
+	float		stepTime;			/**< Time of one step */
+	uint32		maxSubsteps;		/**< Max number of steps per frame */
+	uint32		numDroppedSteps;	/**< Number of steps dropped in the last frame */
+	uint64		numSteps;			/**< Total number of simulated steps */
+	int64		stepTicks;			/**< Time of one step in ticks */
+	int64		accumulator;		/**< Accumulated time in ticks which not simulated yet */
+};
+
+#endif // !PHYSICSSTEPPER_H
\ No newline at end of file
@@ -6,13 +6,7 @@
 #include "System/PhysicsEngine.h"
 #include "PhysicsInterfaceBox2D.h"
 
-static uint32 s_CollisionChannelBits[] =
-{
-	0x0001,			// CC_WorldStatic
-	0x0002,			// CC_Visibility
-	0x0004,			// CC_Character
-};
-static_assert( ARRAY_COUNT( s_CollisionChannelBits ) == CC_Max, "Need full init s_CollisionChannelBits array" );
+static_assert( CC_Max <= 16, "Collision channels must fit into category bits of b2Filter" );
 
 /*
 ==================
@@ -139,6 +133,7 @@ PhysicsShapeHandleBox2D PhysicsInterfaceBox2D::CreateShapeGeometry( const struct
 	shapeHandle.bx2Shape			= bx2BoxGeometry;
 	shapeHandle.physMaterial		= InBoxGeometry.material;
 	shapeHandle.collisionProfile	= InBoxGeometry.collisionProfile;
+	shapeHandle.filterData			= CollisionFilterData::Make( *InBoxGeometry.collisionProfile );
 	return shapeHandle;
 }
 
@@ -161,6 +156,8 @@ PhysicsActorHandleBox2D PhysicsInterfaceBox2D::CreateActor( const ActorCreationP
 	bx2BodyDef.fixedRotation	= LE2BLockFlags( InParams.lockFlags );
 	bx2BodyDef.enabled			= InParams.bSimulatePhysics;
 	bx2BodyDef.gravityScale		= InParams.bEnableGravity ? 1.f : 0.f;
+	bx2BodyDef.bullet			= InParams.bCCD;
+	bx2BodyDef.allowSleep		= InParams.bAllowSleep;
 	actorHandle.bx2Body			= g_PhysicsScene.GetBox2DWorld()->CreateBody( &bx2BodyDef );
 
 	b2MassData			bx2MassData;
@@ -207,17 +204,10 @@ void PhysicsInterfaceBox2D::AttachShape( PhysicsActorHandleBox2D& InActorHandle,
 	bx2FixtureDef.density				= physMaterialRef->GetDensity();
 	bx2FixtureDef.restitution			= physMaterialRef->GetRestitution();
 	bx2FixtureDef.userData				= bx2FixtureUserData;
-	bx2FixtureDef.filter.categoryBits	= s_CollisionChannelBits[ InShapeHandle.collisionProfile->objectType ];
-	bx2FixtureDef.filter.maskBits		= 0x0;
-	for ( uint32 indexCollisionChannel = 0; indexCollisionChannel < CC_Max; ++indexCollisionChannel )
-	{
-		if ( InShapeHandle.collisionProfile->responses[ indexCollisionChannel ] != CR_Block )
-		{
-			continue;
-		}
 
-		bx2FixtureDef.filter.maskBits |= s_CollisionChannelBits[ indexCollisionChannel ];
-	}
+	// Broadphase rejects pairs by these bits, the rest is resolved by CBox2DContactFilter
+	bx2FixtureDef.filter.categoryBits	= InShapeHandle.filterData.objectTypeBit;
+	bx2FixtureDef.filter.maskBits		= InShapeHandle.filterData.blockMask | InShapeHandle.filterData.overlapMask;
 
 	b2Fixture*		bx2Fixture = InActorHandle.bx2Body->CreateFixture( &bx2FixtureDef );
 	InActorHandle.fixtureMap[ InShapeHandle.bx2Shape ]		= bx2Fixture;
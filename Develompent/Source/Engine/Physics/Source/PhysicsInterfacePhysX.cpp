@@ -1,6 +1,9 @@
 #if WITH_PHYSX
 #include "Logger/LoggerMacros.h"
+#include "Misc/PhysicsGlobals.h"
 #include "System/PhysicsMaterial.h"
+#include "System/PhysicsBoxGeometry.h"
+#include "System/PhysicsEngine.h"
 #include "PhysicsInterfacePhysX.h"
 
 /*
@@ -88,6 +91,34 @@ PhysicsMaterialHandlePhysX PhysicsInterfacePhysX::CreateMaterial( class CPhysics
 	return materialHandle;
 }
 
+/*
+==================
+PhysicsInterfacePhysX::CreateShapeGeometry
+==================
+*/
+PhysicsShapeHandlePhysX PhysicsInterfacePhysX::CreateShapeGeometry( const struct PhysicsBoxGeometry& InBoxGeometry )
+{
+	// If physics material is not valid, we use default material
+	TSharedPtr<CPhysicsMaterial>	physMaterialRef = InBoxGeometry.material.ToSharedPtr();
+	if ( !physMaterialRef )
+	{
+		physMaterialRef		= g_PhysicsEngine.GetDefaultPhysMaterial().ToSharedPtr();
+		Assert( physMaterialRef );
+	}
+
+	// Origin of box is in its corner, like in Box2D
+	const physx::PxVec3			pxHalfExtent	= LE2PVector( InBoxGeometry.extent / 2.f );
+	const physx::PxQuat			pxRotation		= LE2PQuat( InBoxGeometry.rotation );
+	const physx::PxTransform	pxLocalPose( LE2PVector( InBoxGeometry.location ) + pxRotation.rotate( pxHalfExtent ), pxRotation );
+
+	PhysicsShapeHandlePhysX		shapeHandle;
+	shapeHandle.pxShape = g_PhysXSDK->createShape( physx::PxBoxGeometry( pxHalfExtent ), *physMaterialRef->GetMaterialHandle().pxMaterial, false );
+	Assert( shapeHandle.pxShape );
+	shapeHandle.pxShape->setLocalPose( pxLocalPose );
+	SetCollisionFilter( shapeHandle, CollisionFilterData::Make( *InBoxGeometry.collisionProfile ) );
+	return shapeHandle;
+}
+
 /*
 ==================
 PhysicsInterfacePhysX::UpdateMaterial
@@ -128,6 +159,26 @@ PhysicsActorHandlePhysX PhysicsInterfacePhysX::CreateActor( const ActorCreationP
 		pxRigidDynamic->setRigidBodyFlag( physx::PxRigidBodyFlag::eUSE_KINEMATIC_TARGET_FOR_SCENE_QUERIES, true );
 		pxRigidDynamic->setRigidDynamicLockFlags( LE2PLockFlags( InParams.lockFlags ) );
 		pxRigidDynamic->setMass( InParams.mass );
+		pxRigidDynamic->setRigidBodyFlag( physx::PxRigidBodyFlag::eENABLE_CCD, InParams.bCCD );
+
+		// Body with zero sleep threshold never falls asleep
+		if ( !InParams.bAllowSleep )
+		{
+			pxRigidDynamic->setSleepThreshold( 0.f );
+		}
+		else if ( InParams.sleepThreshold > 0.f )
+		{
+			pxRigidDynamic->setSleepThreshold( InParams.sleepThreshold );
+		}
+
+		// Iterations which not set keep default of PhysX
+		if ( InParams.positionIterations > 0 || InParams.velocityIterations > 0 )
+		{
+			physx::PxU32	pxPositionIterations = 0;
+			physx::PxU32	pxVelocityIterations = 0;
+			pxRigidDynamic->getSolverIterationCounts( pxPositionIterations, pxVelocityIterations );
+			pxRigidDynamic->setSolverIterationCounts( InParams.positionIterations > 0 ? InParams.positionIterations : pxPositionIterations, InParams.velocityIterations > 0 ? InParams.velocityIterations : pxVelocityIterations );
+		}
 		
 		if ( !InParams.bEnableGravity )
 		{
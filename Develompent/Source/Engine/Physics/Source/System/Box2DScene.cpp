@@ -1,11 +1,120 @@
 #if WITH_BOX2D
+#include <algorithm>
+
 #include "Misc/PhysicsGlobals.h"
+#include "Misc/Stats.h"
 #include "System/PhysicsEngine.h"
 #include "System/PhysicsBodyInstance.h"
 #include "System/Box2DScene.h"
 #include "System/PhysicsMaterial.h"
 #include "Components/PrimitiveComponent.h"
 
+/*
+==================
+GetFixtureFilterData
+==================
+*/
+static FORCEINLINE const CollisionFilterData& GetFixtureFilterData( b2Fixture* InFixture )
+{
+	PhysicsShapeHandleBox2D*	shapeHandle = ( PhysicsShapeHandleBox2D* )InFixture->GetUserData().pointer;
+	Assert( shapeHandle );
+	return shapeHandle->filterData;
+}
+
+/*
+==================
+CBox2DContactFilter::ShouldCollide
+==================
+*/
+bool CBox2DContactFilter::ShouldCollide( b2Fixture* InFixtureA, b2Fixture* InFixtureB )
+{
+	return CollisionFilterData::GetResponse( GetFixtureFilterData( InFixtureA ), GetFixtureFilterData( InFixtureB ) ) != CR_Ignore;
+}
+
+/*
+==================
+GetFixtureBodyInstance
+==================
+*/
+static FORCEINLINE CPhysicsBodyInstance* GetFixtureBodyInstance( b2Fixture* InFixture )
+{
+	return ( CPhysicsBodyInstance* )InFixture->GetBody()->GetUserData().pointer;
+}
+
+/*
+==================
+CBox2DContactListener::BeginContact
+==================
+*/
+void CBox2DContactListener::BeginContact( b2Contact* InContact )
+{
+	b2Fixture*			bx2FixtureA = InContact->GetFixtureA();
+	b2Fixture*			bx2FixtureB = InContact->GetFixtureB();
+	b2WorldManifold		bx2WorldManifold;
+	InContact->GetWorldManifold( &bx2WorldManifold );
+
+	const bool			bOverlap = CollisionFilterData::GetResponse( GetFixtureFilterData( bx2FixtureA ), GetFixtureFilterData( bx2FixtureB ) ) == CR_Overlap;
+	g_PhysicsEngine.GetContactBuffer().AddEvent( bOverlap ? PCET_BeginOverlap : PCET_BeginContact,
+												 GetFixtureBodyInstance( bx2FixtureA ), GetFixtureBodyInstance( bx2FixtureB ),
+												 Vector( B2LEVector( bx2WorldManifold.points[ 0 ] ) * BOX2D_SCALE, 0.f ), Vector( B2LEVector( bx2WorldManifold.normal ), 0.f ) );
+}
+
+/*
+==================
+CBox2DContactListener::EndContact
+==================
+*/
+void CBox2DContactListener::EndContact( b2Contact* InContact )
+{
+	// When body is destroyed its user data is already reset, so contacts of it are skipped
+	b2Fixture*			bx2FixtureA = InContact->GetFixtureA();
+	b2Fixture*			bx2FixtureB = InContact->GetFixtureB();
+	const bool			bOverlap = CollisionFilterData::GetResponse( GetFixtureFilterData( bx2FixtureA ), GetFixtureFilterData( bx2FixtureB ) ) == CR_Overlap;
+	g_PhysicsEngine.GetContactBuffer().AddEvent( bOverlap ? PCET_EndOverlap : PCET_EndContact, GetFixtureBodyInstance( bx2FixtureA ), GetFixtureBodyInstance( bx2FixtureB ) );
+}
+
+/*
+==================
+CBox2DContactListener::PreSolve
+==================
+*/
+void CBox2DContactListener::PreSolve( b2Contact* InContact, const b2Manifold* InOldManifold )
+{
+	if ( CollisionFilterData::GetResponse( GetFixtureFilterData( InContact->GetFixtureA() ), GetFixtureFilterData( InContact->GetFixtureB() ) ) == CR_Overlap )
+	{
+		InContact->SetEnabled( false );
+		return;
+	}
+
+	// Manifold before update is empty only on the first step of contact
+	if ( InOldManifold->pointCount == 0 )
+	{
+		newContacts.insert( InContact );
+	}
+}
+
+/*
+==================
+CBox2DContactListener::PostSolve
+==================
+*/
+void CBox2DContactListener::PostSolve( b2Contact* InContact, const b2ContactImpulse* InImpulse )
+{
+	float		impulse = 0.f;
+	for ( int32 index = 0; index < InImpulse->count; ++index )
+	{
+		impulse += InImpulse->normalImpulses[ index ];
+	}
+
+	b2WorldManifold		bx2WorldManifold;
+	InContact->GetWorldManifold( &bx2WorldManifold );
+
+	// Box2D works in meters, so velocity part of impulse is scaled to units of engine
+	const bool			bNewContact = newContacts.erase( InContact ) > 0;
+	g_PhysicsEngine.GetContactBuffer().AddEvent( PCET_Hit, GetFixtureBodyInstance( InContact->GetFixtureA() ), GetFixtureBodyInstance( InContact->GetFixtureB() ),
+												 Vector( B2LEVector( bx2WorldManifold.points[ 0 ] ) * BOX2D_SCALE, 0.f ), Vector( B2LEVector( bx2WorldManifold.normal ), 0.f ), impulse * BOX2D_SCALE, bNewContact );
+}
+
 /*
 ==================
 CBox2DScene::CBox2DScene
@@ -13,7 +122,9 @@ CBox2DScene::CBox2DScene
 */
 CBox2DScene::CBox2DScene()
 	: bx2World( nullptr )
-{}
+{
+	Sys_Memzero( &profile, sizeof( b2Profile ) );
+}
 
 /*
 ==================
@@ -34,6 +145,8 @@ void CBox2DScene::Init()
 {
 	Assert( !bx2World );
 	bx2World = new b2World( b2Vec2( 0.f, -9.81f ) );
+	bx2World->SetContactFilter( &contactFilter );
+	bx2World->SetContactListener( &contactListener );
 }
 
 /*
@@ -43,7 +156,17 @@ CBox2DScene::Tick
 */
 void CBox2DScene::Tick( float InDeltaTime )
 {
-	bx2World->Step( InDeltaTime, 8, 3 );
+	// Box2D solves all bodies with the same number of iterations, so overrides of bodies are not used here
+	const uint32	velocityIterations = g_PhysicsEngine.GetVelocityIterations();
+	const uint32	positionIterations = g_PhysicsEngine.GetPositionIterations();
+	bx2World->Step( InDeltaTime, velocityIterations > 0 ? velocityIterations : BOX2D_DEFAULT_VELOCITY_ITERATIONS, positionIterations > 0 ? positionIterations : BOX2D_DEFAULT_POSITION_ITERATIONS );
+	contactListener.ResetNewContacts();
+
+	const b2Profile&	stepProfile = bx2World->GetProfile();
+	profile.collide		+= stepProfile.collide;
+	profile.solve		+= stepProfile.solve;
+	profile.solveTOI	+= stepProfile.solveTOI;
+	profile.broadphase	+= stepProfile.broadphase;
 }
 
 /*
@@ -67,15 +190,9 @@ CBox2DScene::AddBody
 */
 void CBox2DScene::AddBody( class CPhysicsBodyInstance* InBodyInstance )
 {
+	// Body instance is stored in user data of Box2D body for find it in scene queries
+	InBodyInstance->GetActorHandle().bx2Body->GetUserData().pointer = ( uintptr_t )InBodyInstance;
 	bodies.push_back( InBodyInstance );
-
-	PhysicsActorHandleBox2D		actorHandle = InBodyInstance->GetActorHandle();
-	for ( b2Fixture* bx2Fixture = actorHandle.bx2Body->GetFixtureList(); bx2Fixture; bx2Fixture = bx2Fixture->GetNext() )
-	{
-		PhysicsShapeHandleBox2D*	shapeHandle = ( PhysicsShapeHandleBox2D* )bx2Fixture->GetUserData().pointer;
-		Assert( shapeHandle );
-		fixturesMap[ shapeHandle->collisionProfile->objectType ][ InBodyInstance ].push_back( bx2Fixture );
-	}
 }
 
 /*
@@ -90,12 +207,7 @@ void CBox2DScene::RemoveBody( CPhysicsBodyInstance* InBodyInstance )
 		CPhysicsBodyInstance*		bodyInstance = bodies[ index ];
 		if ( bodyInstance == InBodyInstance )
 		{
-			// Remove all fixtures from collision channel map
-			for ( uint32 index = 0; index < CC_Max; ++index )
-			{
-				fixturesMap[ index ].erase( InBodyInstance );
-			}
-
+			bodyInstance->GetActorHandle().bx2Body->GetUserData().pointer = 0;
 			bodies.erase( bodies.begin() + index );
 			return;
 		}
@@ -104,46 +216,502 @@ void CBox2DScene::RemoveBody( CPhysicsBodyInstance* InBodyInstance )
 
 /*
 ==================
-CBox2DScene::LineTraceSingleByChannel
+CBox2DScene::AddEndEventsOfRemovedBody
 ==================
 */
-bool CBox2DScene::LineTraceSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams /* = CollisionQueryParams::defaultQueryParam */ )
+void CBox2DScene::AddEndEventsOfRemovedBody( CPhysicsBodyInstance* InBodyInstance )
+{
+	// Box2D reports end of these contacts when body is destroyed, but its user data is already reset at that moment
+	CPhysicsContactBuffer&		contactBuffer = g_PhysicsEngine.GetContactBuffer();
+	for ( b2ContactEdge* bx2ContactEdge = InBodyInstance->GetActorHandle().bx2Body->GetContactList(); bx2ContactEdge; bx2ContactEdge = bx2ContactEdge->next )
+	{
+		b2Contact*		bx2Contact = bx2ContactEdge->contact;
+		if ( !bx2Contact->IsTouching() )
+		{
+			continue;
+		}
+
+		const bool		bOverlap = CollisionFilterData::GetResponse( GetFixtureFilterData( bx2Contact->GetFixtureA() ), GetFixtureFilterData( bx2Contact->GetFixtureB() ) ) == CR_Overlap;
+		contactBuffer.AddRemovedPartnerEvent( bOverlap ? PCET_EndOverlap : PCET_EndContact, ( CPhysicsBodyInstance* )bx2ContactEdge->other->GetUserData().pointer );
+	}
+}
+
+/*
+==================
+CBox2DScene::RemoveAllBodies
+==================
+*/
+void CBox2DScene::RemoveAllBodies()
+{
+	for ( uint32 index = 0, count = bodies.size(); index < count; ++index )
+	{
+		bodies[ index ]->GetActorHandle().bx2Body->GetUserData().pointer = 0;
+	}
+	bodies.clear();
+}
+
+/*
+==================
+CBox2DScene::GetActiveBodies
+==================
+*/
+void CBox2DScene::GetActiveBodies( std::vector< class CPhysicsBodyInstance* >& OutBodies ) const
+{
+	for ( b2Body* bx2Body = bx2World->GetBodyList(); bx2Body; bx2Body = bx2Body->GetNext() )
+	{
+		// Static bodies never moved by simulation, sleeping and disabled bodies didn't move in the last step
+		if ( bx2Body->GetType() == b2_staticBody || !bx2Body->IsAwake() || !bx2Body->IsEnabled() )
+		{
+			continue;
+		}
+
+		CPhysicsBodyInstance*		bodyInstance = ( CPhysicsBodyInstance* )bx2Body->GetUserData().pointer;
+		if ( bodyInstance )
+		{
+			OutBodies.push_back( bodyInstance );
+		}
+	}
+}
+
+/*
+==================
+CBox2DScene::GetStats
+==================
+*/
+void CBox2DScene::GetStats( PhysicsSceneStats& OutStats )
+{
+	for ( b2Body* bx2Body = bx2World->GetBodyList(); bx2Body; bx2Body = bx2Body->GetNext() )
+	{
+		if ( bx2Body->GetType() != b2_staticBody && bx2Body->IsAwake() && bx2Body->IsEnabled() )
+		{
+			++OutStats.numAwakeBodies;
+		}
+	}
+
+	for ( b2Contact* bx2Contact = bx2World->GetContactList(); bx2Contact; bx2Contact = bx2Contact->GetNext() )
+	{
+		if ( bx2Contact->IsTouching() )
+		{
+			++OutStats.numContacts;
+		}
+	}
+
+	OutStats.collideTime	= profile.collide;
+	OutStats.solveTime		= profile.solve;
+	OutStats.ccdTime		= profile.solveTOI;
+	OutStats.broadphaseTime	= profile.broadphase;
+	Sys_Memzero( &profile, sizeof( b2Profile ) );
+}
+
+/*
+==================
+IsFixtureOnChannel
+==================
+*/
+static FORCEINLINE bool IsFixtureOnChannel( b2Fixture* InFixture, ECollisionChannel InTraceChannel )
+{
+	PhysicsShapeHandleBox2D*	shapeHandle = ( PhysicsShapeHandleBox2D* )InFixture->GetUserData().pointer;
+	return InFixture->GetBody()->GetUserData().pointer && shapeHandle && shapeHandle->collisionProfile->objectType == InTraceChannel;
+}
+
+/*
+==================
+GetFixtureComponent
+==================
+*/
+static FORCEINLINE CPrimitiveComponent* GetFixtureComponent( b2Fixture* InFixture )
+{
+	CPhysicsBodyInstance*	bodyInstance = ( CPhysicsBodyInstance* )InFixture->GetBody()->GetUserData().pointer;
+	Assert( bodyInstance );
+	return bodyInstance->GetOwnerComponent();
+}
+
+/*
+==================
+FillHitResult
+==================
+*/
+static void FillHitResult( HitResult& OutHitResult, b2Fixture* InFixture, const b2Vec2& InPoint, const b2Vec2& InNormal, float InDistance, const CollisionQueryParams& InCollisionQueryParams )
+{
+	// Bodies created without owner component (e.g. by commandlets) are hit too
+	OutHitResult.component		= GetFixtureComponent( InFixture );
+	OutHitResult.actor			= OutHitResult.component ? OutHitResult.component->GetOwner() : nullptr;
+	OutHitResult.impactNormal	= Vector( B2LEVector( InNormal ), 0.f );
+	OutHitResult.impactPoint	= Vector( B2LEVector( InPoint ) * BOX2D_SCALE, 0.f );
+	OutHitResult.distance		= InDistance;
+
+	// If need return physics material
+	if ( InCollisionQueryParams.bReturnPhysicalMaterial )
+	{
+		PhysicsShapeHandleBox2D*		shapeHandle = ( PhysicsShapeHandleBox2D* )InFixture->GetUserData().pointer;
+		Assert( shapeHandle );
+		OutHitResult.physMaterial	= shapeHandle->physMaterial.ToSharedPtr();
+	}
+}
+
+/*
+==================
+MakeQueryShape
+==================
+*/
+static b2Shape* MakeQueryShape( const CollisionShape& InShape, b2PolygonShape& OutPolygonShape, b2CircleShape& OutCircleShape )
 {
-	// Ray cast input
-	b2RayCastInput				bx2RayCastInput;
-	bx2RayCastInput.p1			= LE2BVector( ( Vector2D )InStart / BOX2D_SCALE );
-	bx2RayCastInput.p2			= LE2BVector( ( Vector2D )InEnd / BOX2D_SCALE );
-	bx2RayCastInput.maxFraction = 1;
+	switch ( InShape.type )
+	{
+	case CollisionShape::T_Circle:
+		OutCircleShape.m_radius = InShape.GetRadius() / BOX2D_SCALE;
+		return &OutCircleShape;
+
+	case CollisionShape::T_Box:
+	default:
+		OutPolygonShape.SetAsBox( InShape.halfExtent.x / BOX2D_SCALE, InShape.halfExtent.y / BOX2D_SCALE );
+		return &OutPolygonShape;
+	}
+}
+
+/**
+ * @ingroup Physics
+ * @brief Box2D callback of ray cast for closest and multi hit traces
+ */
+class CBox2DRayCastCallback : public b2RayCastCallback
+{
+public:
+	/**
+	 * @brief Ray hit
+	 */
+	struct RayHit
+	{
+		b2Fixture*		fixture;	/**< Hit fixture */
+		b2Vec2			point;		/**< Point of intersection */
+		b2Vec2			normal;		/**< Normal vector at the point of intersection */
+		float			fraction;	/**< Fraction along the ray */
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InTraceChannel	Trace channel
+	 * @param InIsMultiHit		Is need collect all hits, otherwise only the closest
+	 */
+	CBox2DRayCastCallback( ECollisionChannel InTraceChannel, bool InIsMultiHit )
+		: bMultiHit( InIsMultiHit )
+		, traceChannel( InTraceChannel )
+	{}
 
-	// Check every fixture of every collision channel to find closet
-	const std::unordered_map< CPhysicsBodyInstance*, std::vector< b2Fixture* > >&		fixturesOnCollisionChannel = fixturesMap[ InTraceChannel ];
-	for ( auto it = fixturesOnCollisionChannel.begin(), itEnd = fixturesOnCollisionChannel.end(); it != itEnd; ++it )
+	/**
+	 * @brief Called for each fixture found in the query
+	 *
+	 * @param InFixture		The fixture hit by the ray
+	 * @param InPoint		The point of initial intersection
+	 * @param InNormal		The normal vector at the point of intersection
+	 * @param InFraction	The fraction along the ray at the point of intersection
+	 * @return Return -1 to filter, fraction to clip the ray for closest hit, 1 to continue
+	 */
+	virtual float ReportFixture( b2Fixture* InFixture, const b2Vec2& InPoint, const b2Vec2& InNormal, float InFraction ) override
 	{
-		for ( uint32 index = 0, count = it->second.size(); index < count; ++index )
+		if ( !IsFixtureOnChannel( InFixture, traceChannel ) )
 		{
-			b2RayCastOutput			bx2RayCastOutput;
-			b2Fixture*				bx2Fixture = it->second[ index ];
-			if ( bx2Fixture->RayCast( &bx2RayCastOutput, bx2RayCastInput, 0 ) )
+			return -1.f;
+		}
+
+		RayHit		rayHit{ InFixture, InPoint, InNormal, InFraction };
+		if ( bMultiHit )
+		{
+			hits.push_back( rayHit );
+			return 1.f;
+		}
+
+		// Ray is clipped by the fraction, so each next reported hit is closer
+		if ( hits.empty() )
+		{
+			hits.push_back( rayHit );
+		}
+		else if ( InFraction < hits[0].fraction )
+		{
+			hits[0] = rayHit;
+		}
+		return InFraction;
+	}
+
+	std::vector<RayHit>		hits;			/**< Hits of ray */
+
+private:
+	bool					bMultiHit;		/**< Is need collect all hits */
+	ECollisionChannel		traceChannel;	/**< Trace channel */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Box2D callback of sweep shape, finds the closest hit among fixtures in swept AABB
+ */
+class CBox2DSweepCallback : public b2QueryCallback
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InShape			Sweep shape
+	 * @param InStartTransform	Start transform of shape
+	 * @param InTranslation		Translation of shape
+	 * @param InTraceChannel	Trace channel
+	 */
+	CBox2DSweepCallback( const b2Shape* InShape, const b2Transform& InStartTransform, const b2Vec2& InTranslation, ECollisionChannel InTraceChannel )
+		: fixture( nullptr )
+		, lambda( 1.f )
+		, shape( InShape )
+		, startTransform( InStartTransform )
+		, translation( InTranslation )
+		, traceChannel( InTraceChannel )
+	{}
+
+	/**
+	 * @brief Called for each fixture found in the query AABB
+	 *
+	 * @param InFixture		Fixture
+	 * @return Return false to terminate the query
+	 */
+	virtual bool ReportFixture( b2Fixture* InFixture ) override
+	{
+		if ( !IsFixtureOnChannel( InFixture, traceChannel ) )
+		{
+			return true;
+		}
+
+		const b2Shape*			fixtureShape = InFixture->GetShape();
+		const b2Transform&		fixtureTransform = InFixture->GetBody()->GetTransform();
+		for ( int32 childIndex = 0, childCount = fixtureShape->GetChildCount(); childIndex < childCount; ++childIndex )
+		{
+			b2ShapeCastInput		bx2ShapeCastInput;
+			b2ShapeCastOutput		bx2ShapeCastOutput;
+			bx2ShapeCastInput.proxyA.Set( fixtureShape, childIndex );
+			bx2ShapeCastInput.proxyB.Set( shape, 0 );
+			bx2ShapeCastInput.transformA	= fixtureTransform;
+			bx2ShapeCastInput.transformB	= startTransform;
+			bx2ShapeCastInput.translationB	= translation;
+			if ( b2ShapeCast( &bx2ShapeCastOutput, &bx2ShapeCastInput ) )
 			{
-				// Fill hit result
-				OutHitResult.component		= it->first->GetOwnerComponent();
-				OutHitResult.actor			= OutHitResult.component->GetOwner();
-				OutHitResult.impactNormal	= Vector( B2LEVector( bx2RayCastOutput.normal ), 0.f );
-				OutHitResult.impactPoint	= Vector( B2LEVector( bx2RayCastInput.p1 + bx2RayCastOutput.fraction * ( bx2RayCastInput.p2 - bx2RayCastInput.p1 ) ) * BOX2D_SCALE, 0.f );
-
-				// If need return physics material
-				if ( InCollisionQueryParams.bReturnPhysicalMaterial )
+				if ( bx2ShapeCastOutput.lambda < lambda || !fixture )
 				{
-					PhysicsShapeHandleBox2D*		shapeHandle = ( PhysicsShapeHandleBox2D* )bx2Fixture->GetUserData().pointer;
-					Assert( shapeHandle );
-					OutHitResult.physMaterial	= shapeHandle->physMaterial.ToSharedPtr();
+					fixture		= InFixture;
+					lambda		= bx2ShapeCastOutput.lambda;
+					point		= bx2ShapeCastOutput.point;
+					normal		= bx2ShapeCastOutput.normal;
 				}
+			}
+			// b2ShapeCast doesn't report initial overlap, so we check it separately
+			else if ( b2TestOverlap( fixtureShape, childIndex, shape, 0, fixtureTransform, startTransform ) )
+			{
+				b2Vec2		direction = -translation;
+				direction.Normalize();
+
+				fixture		= InFixture;
+				lambda		= 0.f;
+				point		= startTransform.p;
+				normal		= direction;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	b2Fixture*				fixture;		/**< Closest hit fixture, nullptr if not hit */
+	float					lambda;			/**< Fraction of translation at hit */
+	b2Vec2					point;			/**< Hit point */
+	b2Vec2					normal;			/**< Hit normal */
+
+private:
+	const b2Shape*			shape;			/**< Sweep shape */
+	b2Transform				startTransform;	/**< Start transform of shape */
+	b2Vec2					translation;	/**< Translation of shape */
+	ECollisionChannel		traceChannel;	/**< Trace channel */
+};
+
+/**
+ * @ingroup Physics
+ * @brief Box2D callback of overlap test
+ */
+class CBox2DOverlapCallback : public b2QueryCallback
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InShape			Shape
+	 * @param InTransform		Transform of shape
+	 * @param InTraceChannel	Trace channel
+	 * @param OutOverlapResults	Array of overlap results
+	 */
+	CBox2DOverlapCallback( const b2Shape* InShape, const b2Transform& InTransform, ECollisionChannel InTraceChannel, std::vector<OverlapResult>& OutOverlapResults )
+		: shape( InShape )
+		, transform( InTransform )
+		, traceChannel( InTraceChannel )
+		, overlapResults( OutOverlapResults )
+	{}
+
+	/**
+	 * @brief Called for each fixture found in the query AABB
+	 *
+	 * @param InFixture		Fixture
+	 * @return Return false to terminate the query
+	 */
+	virtual bool ReportFixture( b2Fixture* InFixture ) override
+	{
+		if ( !IsFixtureOnChannel( InFixture, traceChannel ) )
+		{
+			return true;
+		}
+
+		const b2Shape*			fixtureShape = InFixture->GetShape();
+		const b2Transform&		fixtureTransform = InFixture->GetBody()->GetTransform();
+		for ( int32 childIndex = 0, childCount = fixtureShape->GetChildCount(); childIndex < childCount; ++childIndex )
+		{
+			if ( !b2TestOverlap( fixtureShape, childIndex, shape, 0, fixtureTransform, transform ) )
+			{
+				continue;
+			}
 
-				return true;
+			// Component may has several fixtures, we report it only once
+			CPrimitiveComponent*	component = GetFixtureComponent( InFixture );
+			for ( uint32 index = 0, count = overlapResults.size(); index < count; ++index )
+			{
+				if ( overlapResults[ index ].component == component )
+				{
+					return true;
+				}
 			}
+
+			OverlapResult		overlapResult;
+			overlapResult.component		= component;
+			overlapResult.actor			= component->GetOwner();
+			overlapResults.push_back( overlapResult );
+			return true;
 		}
+		return true;
+	}
+
+private:
+	const b2Shape*					shape;			/**< Shape */
+	b2Transform						transform;		/**< Transform of shape */
+	ECollisionChannel				traceChannel;	/**< Trace channel */
+	std::vector<OverlapResult>&		overlapResults;	/**< Array of overlap results */
+};
+
+/*
+==================
+CBox2DScene::LineTraceSingleByChannel
+==================
+*/
+bool CBox2DScene::LineTraceSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams /* = CollisionQueryParams::defaultQueryParam */ )
+{
+	g_StatPhysicsQueries.Add( 1 );
+
+	b2Vec2		bx2Start	= LE2BVector( ( Vector2D )InStart / BOX2D_SCALE );
+	b2Vec2		bx2End		= LE2BVector( ( Vector2D )InEnd / BOX2D_SCALE );
+	if ( bx2Start == bx2End )
+	{
+		return false;
+	}
+
+	// Find the closest fixture through dynamic tree of Box2D
+	CBox2DRayCastCallback		rayCastCallback( InTraceChannel, false );
+	bx2World->RayCast( &rayCastCallback, bx2Start, bx2End );
+	if ( rayCastCallback.hits.empty() )
+	{
+		return false;
 	}
 
-	return false;
+	const CBox2DRayCastCallback::RayHit&	rayHit = rayCastCallback.hits[0];
+	FillHitResult( OutHitResult, rayHit.fixture, rayHit.point, rayHit.normal, rayHit.fraction * ( bx2End - bx2Start ).Length() * BOX2D_SCALE, InCollisionQueryParams );
+	return true;
+}
+
+/*
+==================
+CBox2DScene::LineTraceMultiByChannel
+==================
+*/
+bool CBox2DScene::LineTraceMultiByChannel( std::vector<HitResult>& OutHitResults, const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams /* = CollisionQueryParams::defaultQueryParam */ )
+{
+	g_StatPhysicsQueries.Add( 1 );
+	OutHitResults.clear();
+
+	b2Vec2		bx2Start	= LE2BVector( ( Vector2D )InStart / BOX2D_SCALE );
+	b2Vec2		bx2End		= LE2BVector( ( Vector2D )InEnd / BOX2D_SCALE );
+	if ( bx2Start == bx2End )
+	{
+		return false;
+	}
+
+	// Collect all fixtures through dynamic tree of Box2D and sort them by distance
+	CBox2DRayCastCallback		rayCastCallback( InTraceChannel, true );
+	bx2World->RayCast( &rayCastCallback, bx2Start, bx2End );
+	std::sort( rayCastCallback.hits.begin(), rayCastCallback.hits.end(), []( const CBox2DRayCastCallback::RayHit& InA, const CBox2DRayCastCallback::RayHit& InB )
+			   {
+				   return InA.fraction < InB.fraction;
+			   } );
+
+	const float		rayLength = ( bx2End - bx2Start ).Length() * BOX2D_SCALE;
+	OutHitResults.resize( rayCastCallback.hits.size() );
+	for ( uint32 index = 0, count = rayCastCallback.hits.size(); index < count; ++index )
+	{
+		const CBox2DRayCastCallback::RayHit&	rayHit = rayCastCallback.hits[ index ];
+		FillHitResult( OutHitResults[ index ], rayHit.fixture, rayHit.point, rayHit.normal, rayHit.fraction * rayLength, InCollisionQueryParams );
+	}
+	return !OutHitResults.empty();
+}
+
+/*
+==================
+CBox2DScene::SweepSingleByChannel
+==================
+*/
+bool CBox2DScene::SweepSingleByChannel( HitResult& OutHitResult, const Vector& InStart, const Vector& InEnd, const Quaternion& InRotation, const CollisionShape& InShape, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams /* = CollisionQueryParams::defaultQueryParam */ )
+{
+	g_StatPhysicsQueries.Add( 1 );
+
+	b2PolygonShape		bx2PolygonShape;
+	b2CircleShape		bx2CircleShape;
+	b2Shape*			bx2Shape		= MakeQueryShape( InShape, bx2PolygonShape, bx2CircleShape );
+	b2Transform			bx2Transform	= LE2BTransform( CTransform( InRotation, InStart ) );
+	b2Vec2				bx2Translation	= LE2BVector( ( Vector2D )( InEnd - InStart ) / BOX2D_SCALE );
+
+	// AABB of the whole sweep
+	b2AABB				bx2AABB;
+	bx2Shape->ComputeAABB( &bx2AABB, bx2Transform, 0 );
+	bx2AABB.lowerBound	= b2Min( bx2AABB.lowerBound, bx2AABB.lowerBound + bx2Translation );
+	bx2AABB.upperBound	= b2Max( bx2AABB.upperBound, bx2AABB.upperBound + bx2Translation );
+
+	CBox2DSweepCallback		sweepCallback( bx2Shape, bx2Transform, bx2Translation, InTraceChannel );
+	bx2World->QueryAABB( &sweepCallback, bx2AABB );
+	if ( !sweepCallback.fixture )
+	{
+		return false;
+	}
+
+	FillHitResult( OutHitResult, sweepCallback.fixture, sweepCallback.point, sweepCallback.normal, sweepCallback.lambda * bx2Translation.Length() * BOX2D_SCALE, InCollisionQueryParams );
+	return true;
+}
+
+/*
+==================
+CBox2DScene::OverlapMultiByChannel
+==================
+*/
+bool CBox2DScene::OverlapMultiByChannel( std::vector<OverlapResult>& OutOverlapResults, const Vector& InLocation, const Quaternion& InRotation, const CollisionShape& InShape, ECollisionChannel InTraceChannel )
+{
+	g_StatPhysicsQueries.Add( 1 );
+	OutOverlapResults.clear();
+
+	b2PolygonShape		bx2PolygonShape;
+	b2CircleShape		bx2CircleShape;
+	b2Shape*			bx2Shape		= MakeQueryShape( InShape, bx2PolygonShape, bx2CircleShape );
+	b2Transform			bx2Transform	= LE2BTransform( CTransform( InRotation, InLocation ) );
+
+	b2AABB				bx2AABB;
+	bx2Shape->ComputeAABB( &bx2AABB, bx2Transform, 0 );
+
+	CBox2DOverlapCallback	overlapCallback( bx2Shape, bx2Transform, InTraceChannel, OutOverlapResults );
+	bx2World->QueryAABB( &overlapCallback, bx2AABB );
+	return !OutOverlapResults.empty();
 }
 #endif // WITH_BOX2D
\ No newline at end of file
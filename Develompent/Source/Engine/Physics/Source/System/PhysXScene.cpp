@@ -1,9 +1,127 @@
 #if WITH_PHYSX
+#include "Misc/Misc.h"
 #include "Misc/PhysicsGlobals.h"
+#include "Logger/LoggerMacros.h"
 #include "System/PhysicsEngine.h"
 #include "System/PhysicsBodyInstance.h"
 #include "System/PhysXScene.h"
 
+/*
+==================
+P2LECollisionFilterData
+==================
+*/
+static FORCEINLINE CollisionFilterData P2LECollisionFilterData( const physx::PxFilterData& InFilterData )
+{
+	CollisionFilterData		filterData;
+	filterData.objectTypeBit	= InFilterData.word0;
+	filterData.blockMask		= InFilterData.word1;
+	filterData.overlapMask		= InFilterData.word2;
+	return filterData;
+}
+
+/*
+==================
+PhysXCollisionFilterShader
+==================
+*/
+static physx::PxFilterFlags PhysXCollisionFilterShader( physx::PxFilterObjectAttributes InAttributes0, physx::PxFilterData InFilterData0, physx::PxFilterObjectAttributes InAttributes1, physx::PxFilterData InFilterData1, physx::PxPairFlags& OutPairFlags, const void* InConstantBlock, physx::PxU32 InConstantBlockSize )
+{
+	// Triggers keep default behaviour
+	if ( physx::PxFilterObjectIsTrigger( InAttributes0 ) || physx::PxFilterObjectIsTrigger( InAttributes1 ) )
+	{
+		OutPairFlags = physx::PxPairFlag::eTRIGGER_DEFAULT;
+		return physx::PxFilterFlag::eDEFAULT;
+	}
+
+	// Shapes are shared between bodies, so notify flags of bodies aren't known here.
+	// All touches of blocking pairs are reported and are filtered by CPhysicsContactBuffer
+	const physx::PxPairFlags	blockPairFlags = physx::PxPairFlag::eCONTACT_DEFAULT | physx::PxPairFlag::eDETECT_CCD_CONTACT |
+												 physx::PxPairFlag::eNOTIFY_TOUCH_FOUND | physx::PxPairFlag::eNOTIFY_TOUCH_PERSISTS | physx::PxPairFlag::eNOTIFY_TOUCH_LOST | physx::PxPairFlag::eNOTIFY_CONTACT_POINTS;
+
+	// Shapes without collision profile (see PhysicsInterfacePhysX::SetCollisionFilter) collide with everything.
+	// CCD contacts are detected only if one of bodies has enabled CCD
+	if ( InFilterData0.word0 == 0 || InFilterData1.word0 == 0 )
+	{
+		OutPairFlags = blockPairFlags;
+		return physx::PxFilterFlag::eDEFAULT;
+	}
+
+	switch ( CollisionFilterData::GetResponse( P2LECollisionFilterData( InFilterData0 ), P2LECollisionFilterData( InFilterData1 ) ) )
+	{
+	case CR_Block:
+		OutPairFlags = blockPairFlags;
+		return physx::PxFilterFlag::eDEFAULT;
+
+	// Contacts are detected and reported, but not solved
+	case CR_Overlap:
+		OutPairFlags = physx::PxPairFlag::eDETECT_DISCRETE_CONTACT | physx::PxPairFlag::eNOTIFY_TOUCH_FOUND | physx::PxPairFlag::eNOTIFY_TOUCH_LOST | physx::PxPairFlag::eNOTIFY_CONTACT_POINTS;
+		return physx::PxFilterFlag::eDEFAULT;
+
+	// Ignored pairs never reach the narrowphase
+	default:
+		return physx::PxFilterFlag::eKILL;
+	}
+}
+
+/*
+==================
+CPhysXSimulationEventCallback::onContact
+==================
+*/
+void CPhysXSimulationEventCallback::onContact( const physx::PxContactPairHeader& InPairHeader, const physx::PxContactPair* InPairs, physx::PxU32 InNumPairs )
+{
+	// Actors removed from scene haven't body instances anymore
+	if ( InPairHeader.flags & ( physx::PxContactPairHeaderFlag::eREMOVED_ACTOR_0 | physx::PxContactPairHeaderFlag::eREMOVED_ACTOR_1 ) )
+	{
+		return;
+	}
+
+	CPhysicsContactBuffer&		contactBuffer = g_PhysicsEngine.GetContactBuffer();
+	CPhysicsBodyInstance*		bodyA = ( CPhysicsBodyInstance* )InPairHeader.actors[ 0 ]->userData;
+	CPhysicsBodyInstance*		bodyB = ( CPhysicsBodyInstance* )InPairHeader.actors[ 1 ]->userData;
+	if ( !bodyA || !bodyB )
+	{
+		return;
+	}
+
+	physx::PxContactPairPoint	contactPoints[ PHYSX_MAX_CONTACT_POINTS ];
+	for ( uint32 index = 0; index < InNumPairs; ++index )
+	{
+		// Shapes detached from body may be already released
+		const physx::PxContactPair&		pair = InPairs[ index ];
+		if ( pair.flags & ( physx::PxContactPairFlag::eREMOVED_SHAPE_0 | physx::PxContactPairFlag::eREMOVED_SHAPE_1 ) )
+		{
+			continue;
+		}
+
+		// PhysX normal points from the second shape to the first one
+		const uint32	numPoints = pair.extractContacts( contactPoints, PHYSX_MAX_CONTACT_POINTS );
+		const Vector	point = numPoints > 0 ? P2LEVector( contactPoints[ 0 ].position ) : Math::vectorZero;
+		const Vector	normal = numPoints > 0 ? -P2LEVector( contactPoints[ 0 ].normal ) : Math::vectorZero;
+		const bool		bOverlap = CollisionFilterData::GetResponse( P2LECollisionFilterData( pair.shapes[ 0 ]->getSimulationFilterData() ), P2LECollisionFilterData( pair.shapes[ 1 ]->getSimulationFilterData() ) ) == CR_Overlap;
+		if ( pair.events & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND )
+		{
+			contactBuffer.AddEvent( bOverlap ? PCET_BeginOverlap : PCET_BeginContact, bodyA, bodyB, point, normal );
+		}
+
+		if ( !bOverlap && numPoints > 0 && ( pair.events & ( physx::PxPairFlag::eNOTIFY_TOUCH_FOUND | physx::PxPairFlag::eNOTIFY_TOUCH_PERSISTS ) ) )
+		{
+			float		impulse = 0.f;
+			for ( uint32 indexPoint = 0; indexPoint < numPoints; ++indexPoint )
+			{
+				impulse += contactPoints[ indexPoint ].impulse.magnitude();
+			}
+			contactBuffer.AddEvent( PCET_Hit, bodyA, bodyB, point, normal, impulse, pair.events & physx::PxPairFlag::eNOTIFY_TOUCH_FOUND );
+		}
+
+		if ( pair.events & physx::PxPairFlag::eNOTIFY_TOUCH_LOST )
+		{
+			contactBuffer.AddEvent( bOverlap ? PCET_EndOverlap : PCET_EndContact, bodyA, bodyB );
+		}
+	}
+}
+
 /*
 ==================
 CPhysXScene::CPhysXScene
@@ -12,6 +130,7 @@ CPhysXScene::CPhysXScene
 CPhysXScene::CPhysXScene()
 	: pxScene( nullptr )
 	, pxDefaultCpuDispatcher( nullptr )
+	, bSimulating( false )
 {}
 
 /*
@@ -31,14 +150,24 @@ CPhysXScene::Init
 */
 void CPhysXScene::Init()
 {
-	// Create CPU dispatcher
-	pxDefaultCpuDispatcher = physx::PxDefaultCpuDispatcherCreate( 2 );
+	// Create CPU dispatcher. Game thread is busy by ticking actors while scene is simulating, so we leave one core for it
+	const uint32	numWorkers = Max<uint32>( Sys_GetNumberOfCores(), 2 ) - 1;
+	pxDefaultCpuDispatcher = physx::PxDefaultCpuDispatcherCreate( numWorkers );
+	Logf( TEXT( "PhysX CPU dispatcher created with %i workers\n" ), numWorkers );
 	
 	// Create PhysX scene
 	physx::PxSceneDesc			pxSceneDescriptor( g_PhysXSDK->getTolerancesScale() );
 	pxSceneDescriptor.gravity			= physx::PxVec3( 0.0f, -9.81f, 0.0f );	
 	pxSceneDescriptor.cpuDispatcher		= pxDefaultCpuDispatcher;
-	pxSceneDescriptor.filterShader		= physx::PxDefaultSimulationFilterShader;
+	pxSceneDescriptor.filterShader		= PhysXCollisionFilterShader;
+	pxSceneDescriptor.simulationEventCallback = &simulationEventCallback;
+	pxSceneDescriptor.flags				|= physx::PxSceneFlag::eENABLE_ACTIVE_ACTORS | physx::PxSceneFlag::eEXCLUDE_KINEMATICS_FROM_ACTIVE_ACTORS | physx::PxSceneFlag::eENABLE_CCD;
+
+	// With enhanced determinism results don't depend on order of actors insertion and on other actors in scene
+	if ( g_PhysicsEngine.IsDeterministic() )
+	{
+		pxSceneDescriptor.flags			|= physx::PxSceneFlag::eENABLE_ENHANCED_DETERMINISM;
+	}
 	pxScene = g_PhysXSDK->createScene( pxSceneDescriptor );
 	Assert( pxScene );
 }
@@ -50,8 +179,34 @@ CPhysXScene::Tick
 */
 void CPhysXScene::Tick( float InDeltaTime )
 {
+	BeginSimulate( InDeltaTime );
+	EndSimulate();
+}
+
+/*
+==================
+CPhysXScene::BeginSimulate
+==================
+*/
+void CPhysXScene::BeginSimulate( float InDeltaTime )
+{
+	Assert( !bSimulating );
 	pxScene->simulate( InDeltaTime );
-	pxScene->fetchResults( true );
+	bSimulating = true;
+}
+
+/*
+==================
+CPhysXScene::EndSimulate
+==================
+*/
+void CPhysXScene::EndSimulate()
+{
+	if ( bSimulating )
+	{
+		pxScene->fetchResults( true );
+		bSimulating = false;
+	}
 }
 
 /*
@@ -64,6 +219,7 @@ void CPhysXScene::Shutdown()
 	// Free allocated memory
 	if ( pxScene )
 	{
+		EndSimulate();
 		pxScene->release();
 		pxScene = nullptr;
 	}
@@ -85,6 +241,8 @@ void CPhysXScene::AddBody( class CPhysicsBodyInstance* InBodyInstance )
 	physx::PxRigidActor*		pxRigidBody = InBodyInstance->GetActorHandle().pxRigidActor;
 	Assert( pxRigidBody );
 
+	// Body instance is stored in user data of PhysX actor for find it in active actors
+	pxRigidBody->userData = InBodyInstance;
 	pxScene->addActor( *pxRigidBody );
 	bodies.push_back( InBodyInstance );
 }
@@ -104,6 +262,7 @@ void CPhysXScene::RemoveBody( CPhysicsBodyInstance* InBodyInstance )
 			physx::PxRigidActor*		pxRigidBody = bodyInstance->GetActorHandle().pxRigidActor;
 			Assert( pxRigidBody );
 
+			pxRigidBody->userData = nullptr;
 			pxScene->removeActor( *pxRigidBody );
 			bodies.erase( bodies.begin() + index );
 			return;
@@ -124,8 +283,41 @@ void CPhysXScene::RemoveAllBodies()
 		physx::PxRigidActor*		pxRigidBody = bodyInstance->GetActorHandle().pxRigidActor;
 		Assert( pxRigidBody );
 
+		pxRigidBody->userData = nullptr;
 		pxScene->removeActor( *pxRigidBody );
 	}
 	bodies.clear();
 }
+
+/*
+==================
+CPhysXScene::GetActiveBodies
+==================
+*/
+void CPhysXScene::GetActiveBodies( std::vector< class CPhysicsBodyInstance* >& OutBodies ) const
+{
+	physx::PxU32		numActiveActors = 0;
+	physx::PxActor**	activeActors = pxScene->getActiveActors( numActiveActors );
+	for ( uint32 index = 0; index < numActiveActors; ++index )
+	{
+		CPhysicsBodyInstance*		bodyInstance = ( CPhysicsBodyInstance* )activeActors[ index ]->userData;
+		if ( bodyInstance )
+		{
+			OutBodies.push_back( bodyInstance );
+		}
+	}
+}
+
+/*
+==================
+CPhysXScene::GetStats
+==================
+*/
+void CPhysXScene::GetStats( PhysicsSceneStats& OutStats )
+{
+	physx::PxSimulationStatistics		pxStatistics;
+	pxScene->getSimulationStatistics( pxStatistics );
+	OutStats.numAwakeBodies	= pxStatistics.nbActiveDynamicBodies;
+	OutStats.numContacts	= pxStatistics.nbDiscreteContactPairsWithContacts;
+}
 #endif // WITH_PHYSX
\ No newline at end of file
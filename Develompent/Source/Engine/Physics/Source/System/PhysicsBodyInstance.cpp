@@ -14,8 +14,15 @@ CPhysicsBodyInstance::CPhysicsBodyInstance()
 	, bSimulatePhysics( false )
 	, bStartAwake( true )
 	, bDirty( false )
+	, bActive( false )
+	, bCCD( false )
+	, bAllowSleep( true )
 	, lockFlags( BLF_None )
+	, notifyFlags( PNF_None )
+	, positionIterations( 0 )
+	, velocityIterations( 0 )
 	, mass( 1.f )
+	, sleepThreshold( 0.f )
 {}
 
 /*
@@ -55,24 +62,18 @@ void CPhysicsBodyInstance::InitBody( CPhysicsBodySetup* InBodySetup, const CTran
 	params.bSimulatePhysics = bSimulatePhysics;
 	params.bEnableGravity	= bEnableGravity;
 	params.bStartAwake		= bStartAwake;
+	params.bCCD				= bCCD;
+	params.bAllowSleep		= bAllowSleep;
+	params.sleepThreshold	= sleepThreshold;
+	params.positionIterations = positionIterations > 0 ? positionIterations : g_PhysicsEngine.GetPositionIterations();
+	params.velocityIterations = velocityIterations > 0 ? velocityIterations : g_PhysicsEngine.GetVelocityIterations();
 	handle = CPhysicsInterface::CreateActor( params );
 	Assert( CPhysicsInterface::IsValidActor( handle ) );
+	previousTransform		= InTransform;
+	currentTransform		= InTransform;
 
 	// Attach all shapes in body setup to physics actor
-	// Box shapes
-	{
-		std::vector< PhysicsBoxGeometry >&		boxGeometries = bodySetup->GetBoxGeometries();
-		for ( uint32 index = 0, count = boxGeometries.size(); index < count; ++index )
-		{
-			CPhysicsInterface::AttachShape( handle, boxGeometries[ index ].GetShapeHandle() );
-		}
-	}
-
-	// Update mass and inertia if rigid body is not static
-	if ( !bStatic )
-	{
-		CPhysicsInterface::UpdateMassAndInertia( handle, 10.f );
-	}
+	AttachShapes();
 
 	// Add rigid body to physics scene
 	g_PhysicsScene.AddBody( this );
@@ -92,10 +93,93 @@ void CPhysicsBodyInstance::TermBody()
 
 	// Remove from scene
 	g_PhysicsScene.RemoveBody( this );
+	if ( bActive )
+	{
+		g_PhysicsEngine.RemoveActiveBody( this );
+	}
+	g_PhysicsEngine.RemoveContactEvents( this );
 
 	// Release resource
 	CPhysicsInterface::ReleaseActor( handle );
 	ownerComponent = nullptr;
 	bodySetup = nullptr;
 	bDirty = false;
+}
+
+/*
+==================
+CPhysicsBodyInstance::SetBodySetup
+==================
+*/
+void CPhysicsBodyInstance::SetBodySetup( CPhysicsBodySetup* InBodySetup )
+{
+	Assert( InBodySetup && CPhysicsInterface::IsValidActor( handle ) );
+	if ( bodySetup == InBodySetup )
+	{
+		return;
+	}
+
+	DetachShapes();
+	bodySetup = InBodySetup;
+	AttachShapes();
+}
+
+/*
+==================
+CPhysicsBodyInstance::AttachShapes
+==================
+*/
+void CPhysicsBodyInstance::AttachShapes()
+{
+	// Box shapes
+	const std::vector< PhysicsBoxGeometry >&	boxGeometries = bodySetup->GetBoxGeometries();
+	for ( uint32 index = 0, count = boxGeometries.size(); index < count; ++index )
+	{
+		CPhysicsInterface::AttachShape( handle, boxGeometries[ index ].GetShapeHandle() );
+	}
+
+	// Update mass and inertia if rigid body is not static
+	if ( !bStatic )
+	{
+		CPhysicsInterface::UpdateMassAndInertia( handle, 10.f );
+	}
+}
+
+/*
+==================
+CPhysicsBodyInstance::DetachShapes
+==================
+*/
+void CPhysicsBodyInstance::DetachShapes()
+{
+	// Box shapes
+	const std::vector< PhysicsBoxGeometry >&	boxGeometries = bodySetup->GetBoxGeometries();
+	for ( uint32 index = 0, count = boxGeometries.size(); index < count; ++index )
+	{
+		CPhysicsInterface::DetachShape( handle, boxGeometries[ index ].GetShapeHandle() );
+	}
+}
+
+/*
+==================
+CPhysicsBodyInstance::GetLEInterpolatedTransform
+==================
+*/
+CTransform CPhysicsBodyInstance::GetLEInterpolatedTransform() const
+{
+	// Not simulated bodies are moved only by game, so their transform in physics is actual
+	if ( bStatic || !bSimulatePhysics )
+	{
+		return CPhysicsInterface::GetTransform( handle );
+	}
+
+	if ( !g_PhysicsEngine.IsInterpolationEnabled() )
+	{
+		return currentTransform;
+	}
+
+	const float		alpha = g_PhysicsEngine.GetStepper().GetAlpha();
+	return CTransform( Math::SlerpQuaternion( previousTransform.GetRotation(), currentTransform.GetRotation(), alpha ),
+					   Math::Lerp( previousTransform.GetLocation(), currentTransform.GetLocation(), alpha ),
+					   currentTransform.GetScale() );
 }
\ No newline at end of file
@@ -1,3 +1,5 @@
+#include "Misc/PhysicsGlobals.h"
+#include "System/PhysicsEngine.h"
 #include "System/PhysicsBodySetup.h"
 
 /*
@@ -6,6 +8,7 @@ CPhysicsBodySetup::CPhysicsBodySetup
 ==================
 */
 CPhysicsBodySetup::CPhysicsBodySetup()
+	: bCached( false )
 {}
 
 /*
@@ -15,7 +18,11 @@ CPhysicsBodySetup::~CPhysicsBodySetup
 */
 CPhysicsBodySetup::~CPhysicsBodySetup()
 {
-	RemoveAllBoxGeometries();
+	if ( bCached )
+	{
+		g_PhysicsEngine.RemoveCachedBodySetup( this );
+	}
+	boxGeometries.clear();
 }
 
 /*
@@ -28,6 +35,27 @@ void CPhysicsBodySetup::Serialize( class CArchive& InArchive )
 	InArchive << boxGeometries;
 }
 
+/*
+==================
+CPhysicsBodySetup::GetTypeHash
+==================
+*/
+uint64 CPhysicsBodySetup::GetTypeHash() const
+{
+	uint64		hash = 0;
+	for ( uint32 index = 0, count = boxGeometries.size(); index < count; ++index )
+	{
+		const PhysicsBoxGeometry&		boxGeometry = boxGeometries[ index ];
+		hash = Sys_MemFastHash( boxGeometry.collisionShape, hash );
+		hash = Sys_MemFastHash( boxGeometry.collisionProfile, hash );
+		hash = Sys_MemFastHash( TAssetHandle<CPhysicsMaterial>::HashFunction()( boxGeometry.material ), hash );
+		hash = Sys_MemFastHash( boxGeometry.location, hash );
+		hash = Sys_MemFastHash( boxGeometry.rotation, hash );
+		hash = Sys_MemFastHash( boxGeometry.extent, hash );
+	}
+	return hash;
+}
+
 /*
 ==================
 CPhysicsBodySetup::RemoveBoxGeometry
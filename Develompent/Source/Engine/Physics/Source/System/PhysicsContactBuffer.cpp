@@ -0,0 +1,168 @@
+#include "System/PhysicsBodyInstance.h"
+#include "System/PhysicsContactBuffer.h"
+
+/*
+==================
+CPhysicsContactBuffer::CPhysicsContactBuffer
+==================
+*/
+CPhysicsContactBuffer::CPhysicsContactBuffer()
+	: maxEvents( PHYSICS_DEFAULT_MAX_CONTACT_EVENTS )
+	, minHitImpulse( PHYSICS_DEFAULT_MIN_HIT_IMPULSE )
+	, numDroppedEvents( 0 )
+	, numCoalescedEvents( 0 )
+{}
+
+/*
+==================
+CPhysicsContactBuffer::Init
+==================
+*/
+void CPhysicsContactBuffer::Init( uint32 InMaxEvents, float InMinHitImpulse )
+{
+	maxEvents		= InMaxEvents;
+	minHitImpulse	= InMinHitImpulse;
+	events.reserve( maxEvents );
+	Reset();
+}
+
+/*
+==================
+CPhysicsContactBuffer::AddEvent
+==================
+*/
+void CPhysicsContactBuffer::AddEvent( EPhysicsContactEventType InType, CPhysicsBodyInstance* InBodyA, CPhysicsBodyInstance* InBodyB, const Vector& InPoint /* = Math::vectorZero */, const Vector& InNormal /* = Math::vectorZero */, float InImpulse /* = 0.f */, bool InIsNewContact /* = false */ )
+{
+	// Bodies removed from scene have no body instance
+	if ( !InBodyA || !InBodyB )
+	{
+		return;
+	}
+
+	// Resting contacts give impulse every step, so after the first step only strong hits are recorded
+	if ( InType == PCET_Hit && !InIsNewContact && InImpulse < minHitImpulse )
+	{
+		return;
+	}
+
+	PhysicsContactEvent		event;
+	event.type		= InType;
+	event.bodyA		= InBodyA;
+	event.bodyB		= InBodyB;
+	event.point		= InPoint;
+	event.normal	= InNormal;
+	event.impulse	= InImpulse;
+
+	// Nobody listens this event
+	if ( !( ( InBodyA->GetNotifyFlags() | InBodyB->GetNotifyFlags() ) & event.GetNotifyFlag() ) )
+	{
+		return;
+	}
+
+	if ( InType != PCET_Hit )
+	{
+		events.push_back( event );
+		return;
+	}
+
+	// Hits of the same pair are merged into one event, the strongest hit gives point and normal
+	const uint64	pairHash = InBodyA < InBodyB ? Sys_MemFastHash( InBodyB, Sys_MemFastHash( InBodyA ) ) : Sys_MemFastHash( InBodyA, Sys_MemFastHash( InBodyB ) );
+	auto			itRange = hitEvents.equal_range( pairHash );
+	for ( auto itHit = itRange.first; itHit != itRange.second; ++itHit )
+	{
+		PhysicsContactEvent&	hitEvent = events[ itHit->second ];
+		const bool				bSameOrder = hitEvent.bodyA == InBodyA && hitEvent.bodyB == InBodyB;
+		if ( !bSameOrder && ( hitEvent.bodyA != InBodyB || hitEvent.bodyB != InBodyA ) )
+		{
+			continue;
+		}
+
+		if ( InImpulse > hitEvent.impulse )
+		{
+			hitEvent.point		= InPoint;
+			hitEvent.normal		= bSameOrder ? InNormal : -InNormal;
+			hitEvent.impulse	= InImpulse;
+		}
+		++hitEvent.count;
+		++numCoalescedEvents;
+		return;
+	}
+
+	if ( events.size() >= maxEvents )
+	{
+		++numDroppedEvents;
+		return;
+	}
+
+	hitEvents.insert( std::make_pair( pairHash, ( uint32 )events.size() ) );
+	events.push_back( event );
+}
+
+/*
+==================
+CPhysicsContactBuffer::AddRemovedPartnerEvent
+==================
+*/
+void CPhysicsContactBuffer::AddRemovedPartnerEvent( EPhysicsContactEventType InType, CPhysicsBodyInstance* InBodyInstance )
+{
+	Assert( InType == PCET_EndContact || InType == PCET_EndOverlap );
+	PhysicsContactEvent		event;
+	event.type		= InType;
+	event.bodyA		= InBodyInstance;
+
+	// Body may be removed after dispatch of this frame, so event waits for the next one
+	if ( InBodyInstance && ( InBodyInstance->GetNotifyFlags() & event.GetNotifyFlag() ) )
+	{
+		removedPartnerEvents.push_back( event );
+	}
+}
+
+/*
+==================
+RemoveBodyFromEvents
+==================
+*/
+static void RemoveBodyFromEvents( std::vector< PhysicsContactEvent >& InOutEvents, CPhysicsBodyInstance* InBodyInstance )
+{
+	for ( uint32 index = 0, count = InOutEvents.size(); index < count; ++index )
+	{
+		PhysicsContactEvent&	event = InOutEvents[ index ];
+		if ( event.bodyA == InBodyInstance )
+		{
+			event.bodyA = nullptr;
+		}
+
+		if ( event.bodyB == InBodyInstance )
+		{
+			event.bodyB = nullptr;
+		}
+	}
+}
+
+/*
+==================
+CPhysicsContactBuffer::RemoveBody
+==================
+*/
+void CPhysicsContactBuffer::RemoveBody( CPhysicsBodyInstance* InBodyInstance )
+{
+	RemoveBodyFromEvents( events, InBodyInstance );
+	RemoveBodyFromEvents( removedPartnerEvents, InBodyInstance );
+}
+
+/*
+==================
+CPhysicsContactBuffer::Reset
+==================
+*/
+void CPhysicsContactBuffer::Reset()
+{
+	events.clear();
+	hitEvents.clear();
+	numDroppedEvents	= 0;
+	numCoalescedEvents	= 0;
+
+	// End events of removed partners are dispatched with this frame
+	events.insert( events.end(), removedPartnerEvents.begin(), removedPartnerEvents.end() );
+	removedPartnerEvents.clear();
+}
\ No newline at end of file
@@ -1,9 +1,16 @@
+#include <algorithm>
+
 #include "Logger/LoggerMacros.h"
 #include "Misc/CoreGlobals.h"
 #include "Misc/PhysicsGlobals.h"
 #include "System/Config.h"
 #include "System/PhysicsEngine.h"
+#include "System/PhysicsBodyInstance.h"
+#include "System/PhysicsBodySetup.h"
+#include "System/PhysicsQueryBatch.h"
+#include "System/PhysicsStateSnapshot.h"
 #include "System/Package.h"
+#include "Misc/Stats.h"
 #include "PhysicsInterface.h"
 
 /*
@@ -61,6 +68,12 @@ CPhysicsEngine::CPhysicsEngine
 ==================
 */
 CPhysicsEngine::CPhysicsEngine()
+	: bDeterministic( false )
+	, bInterpolation( true )
+	, numFrameSteps( 0 )
+	, positionIterations( 0 )
+	, velocityIterations( 0 )
+	, stateHash( 0 )
 {}
 
 /*
@@ -83,7 +96,75 @@ void CPhysicsEngine::Init()
 	// Init physics interface
 	CPhysicsInterface::Init();
 
-	// Init physics scene
+	// Init fixed timestep
+	{
+		float		stepRate = PHYSICS_DEFAULT_STEP_RATE;
+		uint32		maxSubsteps = PHYSICS_DEFAULT_MAX_SUBSTEPS;
+
+		CConfigValue		configStepRate = g_Config.GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "StepRate" ) );
+		if ( configStepRate.IsValid() )
+		{
+			stepRate = Max( configStepRate.GetNumber(), 1.f );
+		}
+
+		CConfigValue		configMaxSubsteps = g_Config.GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "MaxSubsteps" ) );
+		if ( configMaxSubsteps.IsValid() )
+		{
+			maxSubsteps = Max( configMaxSubsteps.GetInt(), 1 );
+		}
+
+		CConfigValue		configInterpolation = g_Config.GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "Interpolation" ) );
+		if ( configInterpolation.IsValid() )
+		{
+			bInterpolation = configInterpolation.GetBool();
+		}
+
+		CConfigValue		configPositionIterations = g_Config.GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "PositionIterations" ) );
+		if ( configPositionIterations.IsValid() )
+		{
+			positionIterations = Max( configPositionIterations.GetInt(), 0 );
+		}
+
+		CConfigValue		configVelocityIterations = g_Config.GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "VelocityIterations" ) );
+		if ( configVelocityIterations.IsValid() )
+		{
+			velocityIterations = Max( configVelocityIterations.GetInt(), 0 );
+		}
+
+		CConfigValue		configDeterministic = g_Config.GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "Deterministic" ) );
+		if ( configDeterministic.IsValid() )
+		{
+			bDeterministic = configDeterministic.GetBool();
+		}
+
+		// In deterministic mode driver of simulation may step it by StepOnce without frame time, so there is nothing to interpolate
+		if ( bDeterministic )
+		{
+			bInterpolation = false;
+			Logf( TEXT( "Physics is in deterministic mode\n" ) );
+		}
+		stepper.Init( stepRate, maxSubsteps );
+	}
+
+	// Init buffer of collision events
+	{
+		uint32				maxContactEvents = PHYSICS_DEFAULT_MAX_CONTACT_EVENTS;
+		CConfigValue		configMaxContactEvents = g_Config.GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "MaxContactEvents" ) );
+		if ( configMaxContactEvents.IsValid() )
+		{
+			maxContactEvents = Max( configMaxContactEvents.GetInt(), 0 );
+		}
+
+		float				minHitImpulse = PHYSICS_DEFAULT_MIN_HIT_IMPULSE;
+		CConfigValue		configMinHitImpulse = g_Config.GetValue( CT_Engine, TEXT( "Physics.Physics" ), TEXT( "MinHitImpulse" ) );
+		if ( configMinHitImpulse.IsValid() )
+		{
+			minHitImpulse = Max( configMinHitImpulse.GetNumber(), 0.f );
+		}
+		contactBuffer.Init( maxContactEvents, minHitImpulse );
+	}
+
+	// Init physics scene, it must be after reading of deterministic mode
 	g_PhysicsScene.Init();
 
 	// Load default physics material
@@ -169,12 +250,340 @@ void CPhysicsEngine::Init()
 
 /*
 ==================
-CPhysicsEngine::Tick
+CPhysicsEngine::BeginTick
 ==================
 */
-void CPhysicsEngine::Tick( float InDeltaTime )
+void CPhysicsEngine::BeginTick( float InDeltaTime )
 {
-	g_PhysicsScene.Tick( InDeltaTime );
+	SimulateSteps( stepper.Advance( InDeltaTime ) );
+}
+
+/*
+==================
+CPhysicsEngine::StepOnce
+==================
+*/
+void CPhysicsEngine::StepOnce()
+{
+	Assert( numFrameSteps == 0 );
+	SimulateSteps( stepper.AdvanceOneStep() );
+	EndTick();
+}
+
+/*
+==================
+CPhysicsEngine::SimulateSteps
+==================
+*/
+void CPhysicsEngine::SimulateSteps( uint32 InNumSteps )
+{
+	const double	startTime = Sys_Seconds();
+	const float		stepTime = stepper.GetStepTime();
+	numFrameSteps = InNumSteps;
+
+	// Collision events of previous frame are already dispatched
+	contactBuffer.Reset();
+	for ( uint32 index = 0; index < numFrameSteps; ++index )
+	{
+		// All steps except the last are simulated right away
+		if ( index < numFrameSteps - 1 )
+		{
+			g_PhysicsScene.Tick( stepTime );
+			if ( bDeterministic )
+			{
+				stateHash = CalcStateHash();
+			}
+			continue;
+		}
+
+		// Before the last step remember transforms of bodies for interpolation
+		if ( bInterpolation )
+		{
+			const std::vector< CPhysicsBodyInstance* >&		bodies = g_PhysicsScene.GetBodies();
+			for ( uint32 indexBody = 0, countBodies = bodies.size(); indexBody < countBodies; ++indexBody )
+			{
+				bodies[ indexBody ]->SavePreviousTransform();
+			}
+		}
+		g_PhysicsScene.BeginSimulate( stepTime );
+	}
+
+	g_StatPhysicsSteps.Add( numFrameSteps );
+	g_StatPhysicsDroppedSteps.Add( stepper.GetNumDroppedSteps() );
+	g_StatPhysicsSimulateTime.Add( ( int64 )( ( Sys_Seconds() - startTime ) * 1000000.0 ) );
+}
+
+/*
+==================
+CPhysicsEngine::EndTick
+==================
+*/
+void CPhysicsEngine::EndTick()
+{
+	if ( numFrameSteps > 0 )
+	{
+		// Wait end of the last step
+		double		startTime = Sys_Seconds();
+		g_PhysicsScene.EndSimulate();
+		g_StatPhysicsWaitTime.Add( ( int64 )( ( Sys_Seconds() - startTime ) * 1000000.0 ) );
+
+		if ( bDeterministic )
+		{
+			stateHash = CalcStateHash();
+		}
+
+		// Statistics of scene for all steps of this frame
+		PhysicsSceneStats		sceneStats;
+		g_PhysicsScene.GetStats( sceneStats );
+		g_StatPhysicsAwakeBodies.Add( sceneStats.numAwakeBodies );
+		g_StatPhysicsContacts.Add( sceneStats.numContacts );
+		g_StatPhysicsCollideTime.Add( ( int64 )( sceneStats.collideTime * 1000.f ) );
+		g_StatPhysicsSolveTime.Add( ( int64 )( sceneStats.solveTime * 1000.f ) );
+		g_StatPhysicsCCDTime.Add( ( int64 )( sceneStats.ccdTime * 1000.f ) );
+		g_StatPhysicsBroadphaseTime.Add( ( int64 )( sceneStats.broadphaseTime * 1000.f ) );
+
+		// Update array of active bodies. Bodies which were active in scene at previous sync but fallen asleep stay in it once more for write back final transform.
+		// Previous array is taken from scene only, not from merged array, so body fallen asleep is written back exactly once
+		startTime = Sys_Seconds();
+		for ( uint32 index = 0, count = activeBodies.size(); index < count; ++index )
+		{
+			activeBodies[ index ]->SetActive( false );
+		}
+
+		activeBodies.clear();
+		g_PhysicsScene.GetActiveBodies( activeBodies );
+		const uint32	numSceneActiveBodies = activeBodies.size();
+		for ( uint32 index = 0; index < numSceneActiveBodies; ++index )
+		{
+			activeBodies[ index ]->SetActive( true );
+		}
+
+		for ( uint32 index = 0, count = prevActiveBodies.size(); index < count; ++index )
+		{
+			CPhysicsBodyInstance*	bodyInstance = prevActiveBodies[ index ];
+			if ( !bodyInstance->IsActive() )
+			{
+				bodyInstance->SetActive( true );
+				activeBodies.push_back( bodyInstance );
+			}
+		}
+		prevActiveBodies.assign( activeBodies.begin(), activeBodies.begin() + numSceneActiveBodies );
+
+		// Copy results to active bodies, after this game reads only buffered transforms
+		for ( uint32 index = 0, count = activeBodies.size(); index < count; ++index )
+		{
+			activeBodies[ index ]->SyncTransform();
+		}
+		g_StatPhysicsSyncTime.Add( ( int64 )( ( Sys_Seconds() - startTime ) * 1000000.0 ) );
+		numFrameSteps = 0;
+	}
+	g_StatPhysicsBodies.Add( g_PhysicsScene.GetBodies().size() );
+	g_StatPhysicsActiveBodies.Add( activeBodies.size() );
+	g_StatPhysicsBodySetups.Add( cachedBodySetups.size() );
+	g_StatPhysicsContactEvents.Add( contactBuffer.GetEvents().size() );
+	g_StatPhysicsCoalescedContactEvents.Add( contactBuffer.GetNumCoalescedEvents() );
+	g_StatPhysicsDroppedContactEvents.Add( contactBuffer.GetNumDroppedEvents() );
+
+	// Scene isn't simulating now, so execute deferred query batches
+	if ( !deferredQueryBatches.empty() )
+	{
+		std::vector< CPhysicsQueryBatch* >		queryBatches;
+		std::swap( queryBatches, deferredQueryBatches );
+		for ( uint32 index = 0, count = queryBatches.size(); index < count; ++index )
+		{
+			queryBatches[ index ]->Execute();
+		}
+	}
+}
+
+/*
+==================
+CPhysicsEngine::CalcStateHash
+==================
+*/
+uint64 CPhysicsEngine::CalcStateHash() const
+{
+	const std::vector< CPhysicsBodyInstance* >&		bodies = g_PhysicsScene.GetBodies();
+	uint64											hash = Sys_MemFastHash( stepper.GetNumSteps() );
+	for ( uint32 index = 0, count = bodies.size(); index < count; ++index )
+	{
+		hash = bodies[ index ]->GetActorState().GetTypeHash( hash );
+	}
+	return hash;
+}
+
+/*
+==================
+CPhysicsEngine::SaveState
+==================
+*/
+void CPhysicsEngine::SaveState( PhysicsStateSnapshot& OutSnapshot ) const
+{
+	Assert( numFrameSteps == 0 );
+	const std::vector< CPhysicsBodyInstance* >&		bodies = g_PhysicsScene.GetBodies();
+	OutSnapshot.numSteps	= stepper.GetNumSteps();
+	OutSnapshot.stateHash	= CalcStateHash();
+	OutSnapshot.bodies.resize( bodies.size() );
+	for ( uint32 index = 0, count = bodies.size(); index < count; ++index )
+	{
+		PhysicsBodySnapshot&	bodySnapshot = OutSnapshot.bodies[ index ];
+		bodySnapshot.bodyInstance	= bodies[ index ];
+		bodySnapshot.state			= bodies[ index ]->GetActorState();
+	}
+}
+
+/*
+==================
+CPhysicsEngine::RestoreState
+==================
+*/
+void CPhysicsEngine::RestoreState( const PhysicsStateSnapshot& InSnapshot )
+{
+	Assert( numFrameSteps == 0 );
+	const std::vector< CPhysicsBodyInstance* >&		bodies = g_PhysicsScene.GetBodies();
+	for ( uint32 index = 0, count = InSnapshot.bodies.size(); index < count; ++index )
+	{
+		const PhysicsBodySnapshot&		bodySnapshot = InSnapshot.bodies[ index ];
+
+		// Usually set of bodies isn't changed and they are in the same order, otherwise look for body in scene
+		CPhysicsBodyInstance*	bodyInstance = nullptr;
+		if ( index < bodies.size() && bodies[ index ] == bodySnapshot.bodyInstance )
+		{
+			bodyInstance = bodies[ index ];
+		}
+		else if ( std::find( bodies.begin(), bodies.end(), bodySnapshot.bodyInstance ) != bodies.end() )
+		{
+			bodyInstance = bodySnapshot.bodyInstance;
+		}
+
+		if ( !bodyInstance )
+		{
+			Warnf( TEXT( "Body of physics state snapshot isn't in physics scene, skipped\n" ) );
+			continue;
+		}
+
+		// Restored body need write back to its component at the next sync, even if it sleeps
+		bodyInstance->SetActorState( bodySnapshot.state );
+		prevActiveBodies.push_back( bodyInstance );
+		if ( !bodyInstance->IsActive() )
+		{
+			bodyInstance->SetActive( true );
+			activeBodies.push_back( bodyInstance );
+		}
+	}
+
+	stepper.Restore( InSnapshot.numSteps );
+	stateHash = CalcStateHash();
+	if ( stateHash != InSnapshot.stateHash )
+	{
+		Warnf( TEXT( "Physics state hash after restore doesn't match snapshot\n" ) );
+	}
+}
+
+/*
+==================
+CPhysicsEngine::RemoveActiveBody
+==================
+*/
+void CPhysicsEngine::RemoveActiveBody( CPhysicsBodyInstance* InBodyInstance )
+{
+	prevActiveBodies.erase( std::remove( prevActiveBodies.begin(), prevActiveBodies.end(), InBodyInstance ), prevActiveBodies.end() );
+	for ( uint32 index = 0, count = activeBodies.size(); index < count; ++index )
+	{
+		if ( activeBodies[ index ] == InBodyInstance )
+		{
+			activeBodies.erase( activeBodies.begin() + index );
+			InBodyInstance->SetActive( false );
+			return;
+		}
+	}
+}
+
+/*
+==================
+CPhysicsEngine::RemoveContactEvents
+==================
+*/
+void CPhysicsEngine::RemoveContactEvents( CPhysicsBodyInstance* InBodyInstance )
+{
+	g_PhysicsScene.AddEndEventsOfRemovedBody( InBodyInstance );
+	contactBuffer.RemoveBody( InBodyInstance );
+}
+
+/*
+==================
+CPhysicsEngine::AddDeferredQueryBatch
+==================
+*/
+void CPhysicsEngine::AddDeferredQueryBatch( CPhysicsQueryBatch* InQueryBatch )
+{
+	Assert( InQueryBatch );
+	deferredQueryBatches.push_back( InQueryBatch );
+}
+
+/*
+==================
+CPhysicsEngine::RemoveDeferredQueryBatch
+==================
+*/
+void CPhysicsEngine::RemoveDeferredQueryBatch( CPhysicsQueryBatch* InQueryBatch )
+{
+	for ( uint32 index = 0, count = deferredQueryBatches.size(); index < count; ++index )
+	{
+		if ( deferredQueryBatches[ index ] == InQueryBatch )
+		{
+			deferredQueryBatches.erase( deferredQueryBatches.begin() + index );
+			return;
+		}
+	}
+}
+
+/*
+==================
+CPhysicsEngine::FindOrAddCachedBodySetup
+==================
+*/
+PhysicsBodySetupRef_t CPhysicsEngine::FindOrAddCachedBodySetup( CPhysicsBodySetup* InBodySetup )
+{
+	Assert( InBodySetup );
+	if ( InBodySetup->IsCached() )
+	{
+		return InBodySetup;
+	}
+
+	const uint64	hash = InBodySetup->GetTypeHash();
+	auto			itRange = cachedBodySetups.equal_range( hash );
+	for ( auto itBodySetup = itRange.first; itBodySetup != itRange.second; ++itBodySetup )
+	{
+		if ( itBodySetup->second->IsEqualGeometry( *InBodySetup ) )
+		{
+			return itBodySetup->second;
+		}
+	}
+
+	InBodySetup->SetCached( true );
+	cachedBodySetups.insert( std::make_pair( hash, InBodySetup ) );
+	return InBodySetup;
+}
+
+/*
+==================
+CPhysicsEngine::RemoveCachedBodySetup
+==================
+*/
+void CPhysicsEngine::RemoveCachedBodySetup( CPhysicsBodySetup* InBodySetup )
+{
+	Assert( InBodySetup );
+	auto		itRange = cachedBodySetups.equal_range( InBodySetup->GetTypeHash() );
+	for ( auto itBodySetup = itRange.first; itBodySetup != itRange.second; ++itBodySetup )
+	{
+		if ( itBodySetup->second == InBodySetup )
+		{
+			cachedBodySetups.erase( itBodySetup );
+			break;
+		}
+	}
+	InBodySetup->SetCached( false );
 }
 
 /*
@@ -185,6 +594,15 @@ CPhysicsEngine::Shutdown
 void CPhysicsEngine::Shutdown()
 {
 	// Free allocated memory
+	numFrameSteps = 0;
+	deferredQueryBatches.clear();
+	activeBodies.clear();
+	prevActiveBodies.clear();
+	for ( auto itBodySetup = cachedBodySetups.begin(), itBodySetupEnd = cachedBodySetups.end(); itBodySetup != itBodySetupEnd; ++itBodySetup )
+	{
+		itBodySetup->second->SetCached( false );
+	}
+	cachedBodySetups.clear();
 	g_PhysicsScene.Shutdown();
 	defaultPhysMaterial.Reset();
 	CPhysicsInterface::Shutdown();
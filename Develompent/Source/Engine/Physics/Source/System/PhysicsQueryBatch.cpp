@@ -0,0 +1,245 @@
+#include <algorithm>
+
+#include "Misc/PhysicsGlobals.h"
+#include "System/ThreadPool.h"
+#include "System/PhysicsEngine.h"
+#include "System/PhysicsQueryBatch.h"
+
+/*
+==================
+CPhysicsQueryBatch::CPhysicsQueryBatch
+==================
+*/
+CPhysicsQueryBatch::CPhysicsQueryBatch()
+	: bReady( false )
+	, bDeferred( false )
+{}
+
+/*
+==================
+CPhysicsQueryBatch::~CPhysicsQueryBatch
+==================
+*/
+CPhysicsQueryBatch::~CPhysicsQueryBatch()
+{
+	Reset();
+}
+
+/*
+==================
+CPhysicsQueryBatch::AddLineTraceSingle
+==================
+*/
+uint32 CPhysicsQueryBatch::AddLineTraceSingle( const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams /* = CollisionQueryParams::defaultQueryParam */ )
+{
+	PhysicsQuery	query;
+	query.type			= PQT_LineTraceSingle;
+	query.traceChannel	= InTraceChannel;
+	query.start			= InStart;
+	query.end			= InEnd;
+	query.params		= InCollisionQueryParams;
+	return AddQuery( query );
+}
+
+/*
+==================
+CPhysicsQueryBatch::AddLineTraceMulti
+==================
+*/
+uint32 CPhysicsQueryBatch::AddLineTraceMulti( const Vector& InStart, const Vector& InEnd, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams /* = CollisionQueryParams::defaultQueryParam */ )
+{
+	PhysicsQuery	query;
+	query.type			= PQT_LineTraceMulti;
+	query.traceChannel	= InTraceChannel;
+	query.start			= InStart;
+	query.end			= InEnd;
+	query.params		= InCollisionQueryParams;
+	return AddQuery( query );
+}
+
+/*
+==================
+CPhysicsQueryBatch::AddSweepSingle
+==================
+*/
+uint32 CPhysicsQueryBatch::AddSweepSingle( const Vector& InStart, const Vector& InEnd, const Quaternion& InRotation, const CollisionShape& InShape, ECollisionChannel InTraceChannel, const CollisionQueryParams& InCollisionQueryParams /* = CollisionQueryParams::defaultQueryParam */ )
+{
+	PhysicsQuery	query;
+	query.type			= PQT_SweepSingle;
+	query.traceChannel	= InTraceChannel;
+	query.start			= InStart;
+	query.end			= InEnd;
+	query.rotation		= InRotation;
+	query.shape			= InShape;
+	query.params		= InCollisionQueryParams;
+	return AddQuery( query );
+}
+
+/*
+==================
+CPhysicsQueryBatch::AddOverlapMulti
+==================
+*/
+uint32 CPhysicsQueryBatch::AddOverlapMulti( const Vector& InLocation, const Quaternion& InRotation, const CollisionShape& InShape, ECollisionChannel InTraceChannel )
+{
+	PhysicsQuery	query;
+	query.type			= PQT_OverlapMulti;
+	query.traceChannel	= InTraceChannel;
+	query.start			= InLocation;
+	query.end			= InLocation;
+	query.rotation		= InRotation;
+	query.shape			= InShape;
+	return AddQuery( query );
+}
+
+/*
+==================
+CPhysicsQueryBatch::AddQuery
+==================
+*/
+uint32 CPhysicsQueryBatch::AddQuery( const PhysicsQuery& InQuery )
+{
+	Assert( !bDeferred );
+	bReady = false;
+	queries.push_back( InQuery );
+	return queries.size() - 1;
+}
+
+/*
+==================
+CPhysicsQueryBatch::Execute
+==================
+*/
+void CPhysicsQueryBatch::Execute()
+{
+	const uint32	numQueries = queries.size();
+	bDeferred = false;
+
+	// Execute queries in parallel, each of them writes only to own arrays
+	queryHits.resize( numQueries );
+	queryOverlaps.resize( numQueries );
+	g_ThreadPool.ParallelFor( numQueries, std::bind( &CPhysicsQueryBatch::ExecuteQuery, this, std::placeholders::_1 ), PHYSICS_QUERY_BATCH_SIZE );
+
+	// Pack results of all queries into contiguous arrays
+	uint32		numHits = 0;
+	uint32		numOverlaps = 0;
+	results.resize( numQueries );
+	for ( uint32 index = 0; index < numQueries; ++index )
+	{
+		PhysicsQueryResult&		result = results[ index ];
+		if ( queries[ index ].type == PQT_OverlapMulti )
+		{
+			result.firstResult	= numOverlaps;
+			result.numResults	= queryOverlaps[ index ].size();
+			numOverlaps			+= result.numResults;
+		}
+		else
+		{
+			result.firstResult	= numHits;
+			result.numResults	= queryHits[ index ].size();
+			numHits				+= result.numResults;
+		}
+	}
+
+	hitResults.resize( numHits );
+	overlapResults.resize( numOverlaps );
+	for ( uint32 index = 0; index < numQueries; ++index )
+	{
+		const PhysicsQueryResult&	result = results[ index ];
+		if ( queries[ index ].type == PQT_OverlapMulti )
+		{
+			std::copy( queryOverlaps[ index ].begin(), queryOverlaps[ index ].end(), overlapResults.begin() + result.firstResult );
+		}
+		else
+		{
+			std::copy( queryHits[ index ].begin(), queryHits[ index ].end(), hitResults.begin() + result.firstResult );
+		}
+	}
+
+	bReady = true;
+}
+
+/*
+==================
+CPhysicsQueryBatch::ExecuteDeferred
+==================
+*/
+void CPhysicsQueryBatch::ExecuteDeferred()
+{
+	if ( bDeferred )
+	{
+		return;
+	}
+
+	bReady		= false;
+	bDeferred	= true;
+	g_PhysicsEngine.AddDeferredQueryBatch( this );
+}
+
+/*
+==================
+CPhysicsQueryBatch::Reset
+==================
+*/
+void CPhysicsQueryBatch::Reset()
+{
+	if ( bDeferred )
+	{
+		g_PhysicsEngine.RemoveDeferredQueryBatch( this );
+		bDeferred = false;
+	}
+
+	bReady = false;
+	queries.clear();
+	results.clear();
+	hitResults.clear();
+	overlapResults.clear();
+}
+
+/*
+==================
+CPhysicsQueryBatch::ExecuteQuery
+==================
+*/
+void CPhysicsQueryBatch::ExecuteQuery( uint32 InQueryIndex )
+{
+	const PhysicsQuery&			query = queries[ InQueryIndex ];
+	std::vector<HitResult>&		hits = queryHits[ InQueryIndex ];
+	hits.clear();
+	queryOverlaps[ InQueryIndex ].clear();
+
+	switch ( query.type )
+	{
+	case PQT_LineTraceSingle:
+	{
+		HitResult		hitResult;
+		if ( g_PhysicsScene.LineTraceSingleByChannel( hitResult, query.start, query.end, query.traceChannel, query.params ) )
+		{
+			hits.push_back( hitResult );
+		}
+		break;
+	}
+
+	case PQT_LineTraceMulti:
+		g_PhysicsScene.LineTraceMultiByChannel( hits, query.start, query.end, query.traceChannel, query.params );
+		break;
+
+	case PQT_SweepSingle:
+	{
+		HitResult		hitResult;
+		if ( g_PhysicsScene.SweepSingleByChannel( hitResult, query.start, query.end, query.rotation, query.shape, query.traceChannel, query.params ) )
+		{
+			hits.push_back( hitResult );
+		}
+		break;
+	}
+
+	case PQT_OverlapMulti:
+		g_PhysicsScene.OverlapMultiByChannel( queryOverlaps[ InQueryIndex ], query.start, query.rotation, query.shape, query.traceChannel );
+		break;
+
+	default:
+		Sys_Errorf( TEXT( "Unknown physics query type %i" ), query.type );
+		break;
+	}
+}
\ No newline at end of file
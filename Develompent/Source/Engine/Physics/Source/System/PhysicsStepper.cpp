@@ -0,0 +1,80 @@
+#include "System/PhysicsStepper.h"
+
+/*
+==================
+CPhysicsStepper::CPhysicsStepper
+==================
+*/
+CPhysicsStepper::CPhysicsStepper()
+	: stepTime( 0.f )
+	, maxSubsteps( 0 )
+	, numDroppedSteps( 0 )
+	, numSteps( 0 )
+	, stepTicks( 0 )
+	, accumulator( 0 )
+{
+	Init( PHYSICS_DEFAULT_STEP_RATE, PHYSICS_DEFAULT_MAX_SUBSTEPS );
+}
+
+/*
+==================
+CPhysicsStepper::Init
+==================
+*/
+void CPhysicsStepper::Init( float InStepRate, uint32 InMaxSubsteps )
+{
+	Assert( InStepRate > 0.f && InMaxSubsteps > 0 );
+	stepTicks	= Max<int64>( ( int64 )( ( double )PHYSICS_TICKS_PER_SECOND / InStepRate + 0.5 ), 1 );
+	stepTime	= ( float )( ( double )stepTicks / PHYSICS_TICKS_PER_SECOND );
+	maxSubsteps	= InMaxSubsteps;
+	Reset();
+}
+
+/*
+==================
+CPhysicsStepper::Reset
+==================
+*/
+void CPhysicsStepper::Reset()
+{
+	accumulator		= 0;
+	numSteps		= 0;
+	numDroppedSteps	= 0;
+}
+
+/*
+==================
+CPhysicsStepper::Advance
+==================
+*/
+uint32 CPhysicsStepper::Advance( float InDeltaTime )
+{
+	// Frame time is quantized to integer ticks before accumulation, so sequences of frame times
+	// with the same total number of ticks give the same number of steps for any split of it
+	accumulator		+= ( int64 )( ( double )Max( InDeltaTime, 0.f ) * PHYSICS_TICKS_PER_SECOND + 0.5 );
+	uint32		numFrameSteps = ( uint32 )( accumulator / stepTicks );
+	accumulator		-= ( int64 )numFrameSteps * stepTicks;
+
+	// Spiral of death clamp, time of steps over the limit is dropped
+	numDroppedSteps = 0;
+	if ( numFrameSteps > maxSubsteps )
+	{
+		numDroppedSteps	= numFrameSteps - maxSubsteps;
+		numFrameSteps	= maxSubsteps;
+	}
+
+	numSteps += numFrameSteps;
+	return numFrameSteps;
+}
+
+/*
+==================
+CPhysicsStepper::AdvanceOneStep
+==================
+*/
+uint32 CPhysicsStepper::AdvanceOneStep()
+{
+	numDroppedSteps = 0;
+	++numSteps;
+	return 1;
+}
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "D3D11RHI.h"
 #include "D3D11Viewport.h"
 #include "D3D11DeviceContext.h"
+#include "NullRHI.h"
 #include "System/Archive.h"
 #include "WindowsLogger.h"
 #include "WindowsFileSystem.h"
@@ -49,6 +50,17 @@ int32 Sys_PlatformPreInit()
 		Logf( TEXT( "SDL version: %i.%i.%i\n" ), sdlVersion.major, sdlVersion.minor, sdlVersion.patch );
 	}
 
+	// Headless null RHI is created instead of D3D11 if it requested from command line, so D3D11 isn't touched at all
+	Assert( !g_RHI );
+	if ( g_CommandLine.HasParam( TEXT( "nullrhi" ) ) )
+	{
+		g_RHI = new CNullRHI();
+	}
+	else
+	{
+		g_RHI = new CD3D11RHI();
+	}
+
 	return 0;
 }
 
@@ -120,7 +132,7 @@ int WINAPI WinMain( HINSTANCE hInst, HINSTANCE hPreInst, LPSTR lpCmdLine, int nC
 		}
 
 		// Show splash screen
-		if ( !g_IsRequestingExit )
+		if ( !g_IsRequestingExit && !g_CommandLine.HasParam( TEXT( "nullrhi" ) ) )
 		{
 			if ( g_IsEditor )
 			{
@@ -137,7 +149,8 @@ int WINAPI WinMain( HINSTANCE hInst, HINSTANCE hPreInst, LPSTR lpCmdLine, int nC
 		{
 			errorLevel = g_EngineLoop->Init();
 			Assert( errorLevel == 0 );
-			if ( g_IsEditor || g_IsGame )
+			// With null RHI nothing is drawn to the window, so it stays hidden
+			if ( ( g_IsEditor || g_IsGame ) && !g_CommandLine.HasParam( TEXT( "nullrhi" ) ) )
 			{
 				g_Window->Show();
 				if ( g_IsEditor )
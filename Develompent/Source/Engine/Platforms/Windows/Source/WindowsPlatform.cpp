@@ -2,6 +2,8 @@
 #include <stdio.h>
 #include <wchar.h>
 #include <SDL.h>
+#include <Windows.h>
+#include <psapi.h>
 
 #include "Misc/Types.h"
 #include "Misc/CoreGlobals.h"
@@ -25,7 +27,7 @@
 CBaseLogger*         g_Log			= new CWindowsLogger();
 CBaseFileSystem*     g_FileSystem	= new CWindowsFileSystem();
 CBaseWindow*         g_Window		= new CWindowsWindow();
-CBaseRHI*            g_RHI			= new CD3D11RHI();
+CBaseRHI*            g_RHI			= nullptr;
 CEngineLoop*         g_EngineLoop	= new CEngineLoop();
 EPlatformType        g_Platform		= PLATFORM_Windows;
 
@@ -296,6 +298,38 @@ std::wstring Sys_UserName()
 	return result;
 }
 
+/*
+==================
+Sys_GetProcessMemoryStats
+==================
+*/
+void Sys_GetProcessMemoryStats( uint64& OutUsedPhysical, uint64& OutPeakUsedPhysical )
+{
+	PROCESS_MEMORY_COUNTERS		counters;
+	if ( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+	{
+		OutUsedPhysical		= counters.WorkingSetSize;
+		OutPeakUsedPhysical = counters.PeakWorkingSetSize;
+	}
+	else
+	{
+		OutUsedPhysical		= 0;
+		OutPeakUsedPhysical = 0;
+	}
+}
+
+/*
+==================
+Sys_GetNumberOfCores
+==================
+*/
+uint32 Sys_GetNumberOfCores()
+{
+	SYSTEM_INFO		systemInfo;
+	GetSystemInfo( &systemInfo );
+	return systemInfo.dwNumberOfProcessors > 0 ? systemInfo.dwNumberOfProcessors : 1;
+}
+
 #if WITH_EDITOR
 #include "Windows/FileDialog.h"
 
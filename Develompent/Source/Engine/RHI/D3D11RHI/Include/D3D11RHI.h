@@ -10,6 +10,8 @@
 #define D3D11RHI_H
 
 #include <d3d11.h>
+#include <deque>
+#include <vector>
 #include <unordered_map>
 
 #include "Misc/EngineGlobals.h"
@@ -17,6 +19,17 @@
 #include "D3D11State.h"
 #include "D3D11Buffer.h"
 #include "RHI/BaseRHI.h"
+#include "RHI/UploadRingAllocatorRHI.h"
+
+/**
+ * @ingroup D3D11RHI
+ * @brief Fence of frame in upload rings
+ */
+struct D3D11UploadRingFence
+{
+	ID3D11Query*	d3d11Query;		/**< Event query, signaled when GPU has finished the frame */
+	uint64			frame;			/**< Index of frame in upload rings */
+};
 
 /**
  * @ingroup D3D11RHI
@@ -628,6 +641,16 @@ public:
 	 */
 	virtual void CopyToResolveTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InSourceSurface, const ResolveParams& InResolveParams ) override;
 
+	/**
+	 * @brief Copy mips which both textures have in common
+	 * @note Textures must have same format. Mip chains are aligned by the smallest mip, so the last mip of source is copied to the last mip of destination
+	 *
+	 * @param InDeviceContext		Device context
+	 * @param InDestTexture			Destination texture
+	 * @param InSourceTexture		Source texture
+	 */
+	virtual void CopySharedMips( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InDestTexture, Texture2DRHIParamRef_t InSourceTexture ) override;
+
 	/**
 	 * @brief Is initialized RHI
 	 * @return Return true if RHI is initialized, else false
@@ -722,6 +745,54 @@ private:
 	 */
 	ID3D11DepthStencilState* GetCachedDepthStencilState( const D3D11_DEPTH_STENCIL_DESC& InDepthStateInfo, const D3D11_DEPTH_STENCIL_DESC& InStencilStateInfo );
 
+	/**
+	 * @brief Create upload rings for instance data and UP draws
+	 */
+	void InitUploadRings();
+
+	/**
+	 * @brief End frame of upload rings and put fence after it
+	 * @param InDeviceContext	Device context
+	 */
+	void EndUploadRingFrame( class CBaseDeviceContextRHI* InDeviceContext );
+
+	/**
+	 * @brief Retire frames of upload rings which fences are signaled
+	 * @note Doesn't flush and doesn't wait GPU, frames not finished yet are retired on next call
+	 *
+	 * @param InDeviceContext	Device context
+	 */
+	void RetireUploadRingFrames( class CBaseDeviceContextRHI* InDeviceContext );
+
+	/**
+	 * @brief Copy data to upload ring
+	 * Buffer is mapped with D3D11_MAP_WRITE_NO_OVERWRITE, or with D3D11_MAP_WRITE_DISCARD when allocator request it
+	 *
+	 * @param InDeviceContext	Device context
+	 * @param InRing			Upload ring allocator
+	 * @param InD3D11Buffer		DirectX buffer of upload ring
+	 * @param InData			Data to copy
+	 * @param InSize			Size of data
+	 * @param InAlignment		Alignment of data in ring
+	 * @param OutOffset			Output offset of data in buffer
+	 * @return Return TRUE if data copied to upload ring, otherwise returning FALSE (data is larger then ring)
+	 */
+	bool UploadToRing( class CBaseDeviceContextRHI* InDeviceContext, CUploadRingAllocator& InRing, ID3D11Buffer* InD3D11Buffer, const void* InData, uint32 InSize, uint32 InAlignment, uint32& OutOffset );
+
+	/**
+	 * @brief Bind index buffer and draw indexed primitive
+	 *
+	 * @param InDeviceContext		Device context
+	 * @param InD3D11IndexBuffer	DirectX index buffer
+	 * @param InIndexFormat			Format of indices
+	 * @param InPrimitiveType		Primitive type
+	 * @param InBaseVertexIndex		Base vertex index
+	 * @param InStartIndex			Start index
+	 * @param InNumPrimitives		Number of primitives
+	 * @param InNumInstances		Number of instances
+	 */
+	void DrawIndexedPrimitiveD3D11( class CBaseDeviceContextRHI* InDeviceContext, ID3D11Buffer* InD3D11IndexBuffer, DXGI_FORMAT InIndexFormat, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InStartIndex, uint32 InNumPrimitives, uint32 InNumInstances );
+
 	bool																isInitialize;						/**< Is RHI is initialized */
 	class CD3D11ConstantBuffer*											globalConstantBuffer;				/**< Global constant buffer */
 	class CD3D11ConstantBuffer*											vsConstantBuffers[ SOB_Max ];		/**< Constant buffers for vertex shader */
@@ -729,7 +800,13 @@ private:
 	class CD3D11DeviceContext*											immediateContext;					/**< Immediate context */
 	CBoundShaderStateHistory											boundShaderStateHistory;			/**< History of using bound shader states */
 	D3D11StateCache													stateCache;							/**< DirectX 11 state cache */
-	TRefCountPtr< CD3D11VertexBufferRHI >								instanceBuffer;						/**< Instance buffer */
+	TRefCountPtr< CD3D11VertexBufferRHI >								instanceBuffer;						/**< Instance buffer, used only when instance data is larger then upload ring */
+	CUploadRingAllocator												uploadVertexRing;					/**< Allocator of upload ring for instance data and UP vertices */
+	CUploadRingAllocator												uploadIndexRing;					/**< Allocator of upload ring for UP indices */
+	TRefCountPtr< CD3D11VertexBufferRHI >								uploadVertexBuffer;					/**< Vertex buffer of upload ring */
+	TRefCountPtr< CD3D11IndexBufferRHI >								uploadIndexBuffer;					/**< Index buffer of upload ring */
+	std::deque< D3D11UploadRingFence >									uploadRingFences;					/**< Fences of frames in flight in upload rings, from the oldest one */
+	std::vector< ID3D11Query* >											freeUploadRingQueries;				/**< Event queries for reuse by fences */
 	std::unordered_map<uint64, ID3D11BlendState*>						cachedBlendStates;					/**< Cached blend states */
 	std::unordered_map<uint64, ID3D11DepthStencilState*>				cachedDepthStencilStates;			/**< Cached depth stencil states */
 
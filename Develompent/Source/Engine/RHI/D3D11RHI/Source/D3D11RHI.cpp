@@ -2,6 +2,7 @@
 
 #include "Core.h"
 #include "Logger/LoggerMacros.h"
+#include "Misc/Stats.h"
 #include "Render/RenderResource.h"
 #include "Render/RenderUtils.h"
 #include "Render/GlobalConstantsHelper.h"
@@ -450,8 +451,12 @@ void CD3D11RHI::Init( bool InIsEditor )
 	INIT_FORMAT( PF_BC5,					DXGI_FORMAT_BC5_UNORM );
 	INIT_FORMAT( PF_BC6H,					DXGI_FORMAT_BC6H_UF16 );
 	INIT_FORMAT( PF_BC7,					DXGI_FORMAT_BC7_UNORM );
+	INIT_FORMAT( PF_BC4,					DXGI_FORMAT_BC4_UNORM );
 
 	INIT_UNSUPPORTED_FORMAT( PF_Unknown );
+
+	// Create upload rings for instance data and UP draws
+	InitUploadRings();
 	isInitialize = true;
 
 	// Initialize all global render resources
@@ -514,6 +519,20 @@ void CD3D11RHI::Destroy()
 		}
 	}
 
+	instanceBuffer.SafeRelease();
+	uploadVertexBuffer.SafeRelease();
+	uploadIndexBuffer.SafeRelease();
+	for ( uint32 index = 0, count = uploadRingFences.size(); index < count; ++index )
+	{
+		uploadRingFences[ index ].d3d11Query->Release();
+	}
+	for ( uint32 index = 0, count = freeUploadRingQueries.size(); index < count; ++index )
+	{
+		freeUploadRingQueries[ index ]->Release();
+	}
+	uploadRingFences.clear();
+	freeUploadRingQueries.clear();
+
 	delete globalConstantBuffer;
 	delete psConstantBuffer;
 	delete immediateContext;
@@ -753,6 +772,15 @@ CD3D11RHI::SetupInstancing
 */
 void CD3D11RHI::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContext, uint32 InStreamIndex, void* InInstanceData, uint32 InInstanceStride, uint32 InInstanceSize, uint32 InNumInstances )
 {
+	// Suballocate instance data from upload ring, the whole batch is bound once
+	uint32		offset = 0;
+	if ( UploadToRing( InDeviceContext, uploadVertexRing, uploadVertexBuffer ? uploadVertexBuffer->GetD3D11Buffer() : nullptr, InInstanceData, InInstanceSize, UPLOAD_RING_INSTANCE_ALIGNMENT, offset ) )
+	{
+		SetStreamSource( InDeviceContext, InStreamIndex, uploadVertexBuffer, InInstanceStride, offset );
+		return;
+	}
+
+	// Instance data is larger then upload ring, so use separate buffer
 	if ( !instanceBuffer || instanceBuffer->GetSize() < InInstanceSize )
 	{
 		instanceBuffer = new CD3D11VertexBufferRHI( RUF_Dynamic, InInstanceSize, ( byte* )InInstanceData, TEXT( "Instance" ) );
@@ -1169,6 +1197,7 @@ void CD3D11RHI::LockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext,
 	OutLockedData.data			= ( byte* )mappedSubresource.pData + InOffset;
 	OutLockedData.pitch			= mappedSubresource.RowPitch;
 	OutLockedData.isNeedFree	= false;
+	g_StatRHIUploadedBytes.Add( InSize );
 }
 
 /*
@@ -1200,6 +1229,7 @@ void CD3D11RHI::LockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, c
 	OutLockedData.data = ( byte* )mappedSubresource.pData + InOffset;
 	OutLockedData.pitch = mappedSubresource.RowPitch;
 	OutLockedData.isNeedFree = false;
+	g_StatRHIUploadedBytes.Add( InSize );
 }
 
 /*
@@ -1223,6 +1253,10 @@ CD3D11RHI::LockTexture2D
 void CD3D11RHI::LockTexture2D( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InTexture, uint32 InMipIndex, bool InIsDataWrite, LockedData& OutLockedData, bool InIsUseCPUShadow /*= false*/ )
 {
 	( ( CD3D11Texture2DRHI* )InTexture )->Lock( InDeviceContext, InMipIndex, InIsDataWrite, InIsUseCPUShadow, OutLockedData );
+	if ( InIsDataWrite )
+	{
+		g_StatRHIUploadedBytes.Add( OutLockedData.size );
+	}
 }
 
 /*
@@ -1256,6 +1290,8 @@ void CD3D11RHI::DrawPrimitive( class CBaseDeviceContextRHI* InDeviceContext, EPr
 	}
 
 	// Draw primitive
+	g_StatRHIDrawCalls.Increment();
+	g_StatRHIPrimitives.Add( InNumPrimitives * InNumInstances );
 	if ( InNumInstances > 1 )
 	{
 		d3d11DeviceContext->DrawInstanced( vertexCount, InNumInstances, InBaseVertexIndex, 0 );
@@ -1274,18 +1310,26 @@ CD3D11RHI::DrawIndexedPrimitive
 void CD3D11RHI::DrawIndexedPrimitive( class CBaseDeviceContextRHI* InDeviceContext, class CBaseIndexBufferRHI* InIndexBuffer, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InStartIndex, uint32 InNumPrimitives, uint32 InNumInstances /* = 1 */ )
 {
 	Assert( InIndexBuffer );
-	ID3D11DeviceContext*			d3d11DeviceContext = ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
 	CD3D11IndexBufferRHI*			indexBuffer = ( CD3D11IndexBufferRHI* )InIndexBuffer;
+	DrawIndexedPrimitiveD3D11( InDeviceContext, indexBuffer->GetD3D11Buffer(), ( indexBuffer->GetStride() == sizeof( uint16 ) ) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, InPrimitiveType, InBaseVertexIndex, InStartIndex, InNumPrimitives, InNumInstances );
+}
+
+/*
+==================
+CD3D11RHI::DrawIndexedPrimitiveD3D11
+==================
+*/
+void CD3D11RHI::DrawIndexedPrimitiveD3D11( class CBaseDeviceContextRHI* InDeviceContext, ID3D11Buffer* InD3D11IndexBuffer, DXGI_FORMAT InIndexFormat, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InStartIndex, uint32 InNumPrimitives, uint32 InNumInstances )
+{
+	Assert( InD3D11IndexBuffer );
+	ID3D11DeviceContext*			d3d11DeviceContext = ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
 
 	// Bind index buffer
 	{
-		const DXGI_FORMAT				format = ( indexBuffer->GetStride() == sizeof( uint16 ) ) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
-		ID3D11Buffer*					d3d11IndexBuffer = indexBuffer->GetD3D11Buffer();
-		CD3D11StateIndexBuffer			stateIndexBuffer = { d3d11IndexBuffer, format, 0 };
-		
+		CD3D11StateIndexBuffer			stateIndexBuffer = { InD3D11IndexBuffer, InIndexFormat, 0 };
 		if ( stateIndexBuffer != stateCache.indexBuffer )
 		{
-			d3d11DeviceContext->IASetIndexBuffer( d3d11IndexBuffer, format, 0 );
+			d3d11DeviceContext->IASetIndexBuffer( InD3D11IndexBuffer, InIndexFormat, 0 );
 			stateCache.indexBuffer = stateIndexBuffer;
 		}
 	}
@@ -1302,6 +1346,8 @@ void CD3D11RHI::DrawIndexedPrimitive( class CBaseDeviceContextRHI* InDeviceConte
 
 	// Draw indexed primitive	
 	uint32							indexCount = GetVertexCountForPrimitiveCount( InNumPrimitives, InPrimitiveType );
+	g_StatRHIDrawCalls.Increment();
+	g_StatRHIPrimitives.Add( InNumPrimitives * InNumInstances );
 	if ( InNumInstances > 1 )
 	{
 		d3d11DeviceContext->DrawIndexedInstanced( indexCount, InNumInstances, InStartIndex, InBaseVertexIndex, 0 );
@@ -1320,7 +1366,17 @@ CD3D11RHI::DrawPrimitiveUP
 void CD3D11RHI::DrawPrimitiveUP( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, const void* InVertexData, uint32 InVertexDataStride, uint32 InNumInstances /* = 1 */ )
 {
 	uint32										vertexCount		= GetVertexCountForPrimitiveCount( InNumPrimitives, InPrimitiveType );
+	uint32										vertexOffset	= 0;
+	if ( UploadToRing( InDeviceContext, uploadVertexRing, uploadVertexBuffer ? uploadVertexBuffer->GetD3D11Buffer() : nullptr, InVertexData, InVertexDataStride * vertexCount, InVertexDataStride, vertexOffset ) )
+	{
+		SetStreamSource( InDeviceContext, 0, uploadVertexBuffer, InVertexDataStride, vertexOffset );
+		DrawPrimitive( InDeviceContext, InPrimitiveType, InBaseVertexIndex, InNumPrimitives, InNumInstances );
+		return;
+	}
+
+	// Data is larger then upload ring, so create temporary buffer
 	TRefCountPtr< CD3D11VertexBufferRHI >		vertexBuffer	= CreateVertexBuffer( TEXT( "DrawPrimitiveUP" ), InVertexDataStride * vertexCount, ( const byte* )InVertexData, RUF_Static );
+	g_StatRHIUploadedBytes.Add( InVertexDataStride * vertexCount );
 	
 	SetStreamSource( InDeviceContext, 0, vertexBuffer, InVertexDataStride, 0 );
 	DrawPrimitive( InDeviceContext, InPrimitiveType, InBaseVertexIndex, InNumPrimitives, InNumInstances );
@@ -1334,8 +1390,22 @@ CD3D11RHI::DrawIndexedPrimitiveUP
 void CD3D11RHI::DrawIndexedPrimitiveUP( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, uint32 InNumVertices, const void* InIndexData, uint32 InIndexDataStride, const void* InVertexData, uint32 InVertexDataStride, uint32 InNumInstances /* = 1 */ )
 {
 	uint32										indexCount		= GetVertexCountForPrimitiveCount( InNumPrimitives, InPrimitiveType );
+	uint32										vertexOffset	= 0;
+	uint32										indexOffset		= 0;
+	// Both rings are checked before writing, so vertex ring isn't wasted when indices don't fit
+	if ( uploadVertexBuffer && uploadIndexBuffer && uploadVertexRing.CanAllocate( InVertexDataStride * InNumVertices ) && uploadIndexRing.CanAllocate( InIndexDataStride * indexCount ) &&
+		 UploadToRing( InDeviceContext, uploadVertexRing, uploadVertexBuffer->GetD3D11Buffer(), InVertexData, InVertexDataStride * InNumVertices, InVertexDataStride, vertexOffset ) &&
+		 UploadToRing( InDeviceContext, uploadIndexRing, uploadIndexBuffer->GetD3D11Buffer(), InIndexData, InIndexDataStride * indexCount, InIndexDataStride, indexOffset ) )
+	{
+		SetStreamSource( InDeviceContext, 0, uploadVertexBuffer, InVertexDataStride, vertexOffset );
+		DrawIndexedPrimitiveD3D11( InDeviceContext, uploadIndexBuffer->GetD3D11Buffer(), ( InIndexDataStride == sizeof( uint16 ) ) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT, InPrimitiveType, InBaseVertexIndex, indexOffset / InIndexDataStride, InNumPrimitives, InNumInstances );
+		return;
+	}
+
+	// Data is larger then upload ring, so create temporary buffers
 	TRefCountPtr< CD3D11VertexBufferRHI >		vertexBuffer	= CreateVertexBuffer( TEXT( "DrawIndexedPrimitiveUP" ), InVertexDataStride * InNumVertices, ( const byte* )InVertexData, RUF_Static );
 	TRefCountPtr< CD3D11IndexBufferRHI >		indexBuffer		= CreateIndexBuffer( TEXT( "DrawIndexedPrimitiveUP" ), InIndexDataStride, InIndexDataStride * indexCount, ( const byte* )InIndexData, RUF_Static );
+	g_StatRHIUploadedBytes.Add( InVertexDataStride * InNumVertices + InIndexDataStride * indexCount );
 
 	SetStreamSource( InDeviceContext, 0, vertexBuffer, InVertexDataStride, 0 );
 	DrawIndexedPrimitive( InDeviceContext, indexBuffer, InPrimitiveType, InBaseVertexIndex, 0, InNumPrimitives, InNumInstances );
@@ -1421,6 +1491,30 @@ void CD3D11RHI::CopyToResolveTarget( class CBaseDeviceContextRHI* InDeviceContex
 	}
 }
 
+/*
+==================
+CD3D11RHI::CopySharedMips
+==================
+*/
+void CD3D11RHI::CopySharedMips( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InDestTexture, Texture2DRHIParamRef_t InSourceTexture )
+{
+	Assert( InDestTexture && InSourceTexture && InDestTexture->GetFormat() == InSourceTexture->GetFormat() );
+	ID3D11DeviceContext*	d3d11DeviceContext	= ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	ID3D11Texture2D*		d3d11DestTexture	= ( ( CD3D11Texture2DRHI* )InDestTexture )->GetResource();
+	ID3D11Texture2D*		d3d11SourceTexture	= ( ( CD3D11Texture2DRHI* )InSourceTexture )->GetResource();
+
+	// Mip chains are aligned by the smallest mip
+	uint32		numDestMips			= InDestTexture->GetNumMips();
+	uint32		numSourceMips		= InSourceTexture->GetNumMips();
+	uint32		numSharedMips		= Min( numDestMips, numSourceMips );
+	uint32		destMipOffset		= numDestMips - numSharedMips;
+	uint32		sourceMipOffset		= numSourceMips - numSharedMips;
+	for ( uint32 index = 0; index < numSharedMips; ++index )
+	{
+		d3d11DeviceContext->CopySubresourceRegion( d3d11DestTexture, D3D11CalcSubresource( destMipOffset + index, 0, numDestMips ), 0, 0, 0, d3d11SourceTexture, D3D11CalcSubresource( sourceMipOffset + index, 0, numSourceMips ), nullptr );
+	}
+}
+
 /*
 ==================
 CD3D11RHI::BeginDrawingViewport
@@ -1508,7 +1602,125 @@ void CD3D11RHI::EndDrawingViewport( class CBaseDeviceContextRHI* InDeviceContext
 	if ( InIsPresent )
 	{
 		InViewport->Present( InLockToVsync );
+
+		// Frame is submitted, its memory in upload rings is reused only after GPU signals fence of it.
+		// Each viewport ends own frame, so number of presents doesn't matter
+		EndUploadRingFrame( InDeviceContext );
+	}
+}
+
+/*
+==================
+CD3D11RHI::InitUploadRings
+==================
+*/
+void CD3D11RHI::InitUploadRings()
+{
+	const uint32	vertexRingSize	= CUploadRingAllocator::GetConfigVertexRingSize();
+	const uint32	indexRingSize	= vertexRingSize / UPLOAD_RING_INDEX_SIZE_RATIO;
+	uploadVertexBuffer	= new CD3D11VertexBufferRHI( RUF_Dynamic, vertexRingSize, nullptr, TEXT( "UploadRing" ) );
+	uploadIndexBuffer	= new CD3D11IndexBufferRHI( RUF_Dynamic, sizeof( uint32 ), indexRingSize, nullptr, TEXT( "UploadRing" ) );
+	uploadVertexRing.Init( vertexRingSize );
+	uploadIndexRing.Init( indexRingSize );
+	Logf( TEXT( "Upload rings: %u KB for vertices and instances, %u KB for indices\n" ), vertexRingSize / 1024, indexRingSize / 1024 );
+}
+
+/*
+==================
+CD3D11RHI::EndUploadRingFrame
+==================
+*/
+void CD3D11RHI::EndUploadRingFrame( class CBaseDeviceContextRHI* InDeviceContext )
+{
+	const uint64		frame = uploadVertexRing.EndFrame();
+	uploadIndexRing.EndFrame();
+
+	ID3D11Query*		d3d11Query = nullptr;
+	if ( !freeUploadRingQueries.empty() )
+	{
+		d3d11Query = freeUploadRingQueries.back();
+		freeUploadRingQueries.pop_back();
 	}
+	else
+	{
+		D3D11_QUERY_DESC		d3d11QueryDesc;
+		d3d11QueryDesc.Query		= D3D11_QUERY_EVENT;
+		d3d11QueryDesc.MiscFlags	= 0;
+		if ( FAILED( d3d11Device->CreateQuery( &d3d11QueryDesc, &d3d11Query ) ) )
+		{
+			// Without fence frame is never retired, so rings will be discarded when they are full
+			d3d11Query = nullptr;
+		}
+	}
+
+	if ( d3d11Query )
+	{
+		( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext()->End( d3d11Query );
+		uploadRingFences.push_back( D3D11UploadRingFence{ d3d11Query, frame } );
+	}
+	RetireUploadRingFrames( InDeviceContext );
+}
+
+/*
+==================
+CD3D11RHI::RetireUploadRingFrames
+==================
+*/
+void CD3D11RHI::RetireUploadRingFrames( class CBaseDeviceContextRHI* InDeviceContext )
+{
+	ID3D11DeviceContext*		d3d11DeviceContext = ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	while ( !uploadRingFences.empty() )
+	{
+		const D3D11UploadRingFence&		fence = uploadRingFences.front();
+		if ( d3d11DeviceContext->GetData( fence.d3d11Query, nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH ) != S_OK )
+		{
+			break;
+		}
+
+		uploadVertexRing.RetireFrames( fence.frame );
+		uploadIndexRing.RetireFrames( fence.frame );
+		freeUploadRingQueries.push_back( fence.d3d11Query );
+		uploadRingFences.pop_front();
+	}
+}
+
+/*
+==================
+CD3D11RHI::UploadToRing
+==================
+*/
+bool CD3D11RHI::UploadToRing( class CBaseDeviceContextRHI* InDeviceContext, CUploadRingAllocator& InRing, ID3D11Buffer* InD3D11Buffer, const void* InData, uint32 InSize, uint32 InAlignment, uint32& OutOffset )
+{
+	UploadRingAllocation		allocation;
+	if ( !InD3D11Buffer || !InRing.Allocate( InSize, InAlignment, allocation ) )
+	{
+		return false;
+	}
+
+	ID3D11DeviceContext*		d3d11DeviceContext = ( ( CD3D11DeviceContext* )InDeviceContext )->GetD3D11DeviceContext();
+	D3D11_MAPPED_SUBRESOURCE	mappedSubresource;
+	HRESULT						result = d3d11DeviceContext->Map( InD3D11Buffer, 0, allocation.bNeedDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mappedSubresource );
+	if ( FAILED( result ) )
+	{
+		return false;
+	}
+
+	memcpy( ( byte* )mappedSubresource.pData + allocation.offset, InData, InSize );
+	d3d11DeviceContext->Unmap( InD3D11Buffer, 0 );
+
+	g_StatRHIUploadedBytes.Add( InSize );
+	g_StatRHIUploadRingBytes.Add( InSize );
+	if ( allocation.bWrapped )
+	{
+		g_StatRHIUploadRingWraps.Increment();
+	}
+	if ( allocation.bNeedDiscard )
+	{
+		g_StatRHIUploadRingDiscards.Increment();
+	}
+
+	OutOffset = allocation.offset;
+	return true;
 }
 
 #if WITH_EDITOR
@@ -93,6 +93,9 @@ CD3D11VertexDeclarationRHI::CD3D11VertexDeclarationRHI( const VertexDeclarationE
 		case VET_UByte4:		d3dElement.Format = DXGI_FORMAT_R8G8B8A8_UINT;													break;
 		case VET_UByte4N:		d3dElement.Format = DXGI_FORMAT_R8G8B8A8_UNORM;													break;
 		case VET_Color:			d3dElement.Format = DXGI_FORMAT_R8G8B8A8_UNORM;													break;
+		case VET_Half2:			d3dElement.Format = DXGI_FORMAT_R16G16_FLOAT;													break;
+		case VET_UShort4N:		d3dElement.Format = DXGI_FORMAT_R16G16B16A16_UNORM;												break;
+		case VET_UInt1010102N:	d3dElement.Format = DXGI_FORMAT_R10G10B10A2_UNORM;												break;
 		default:				Sys_Errorf( TEXT( "Unknown RHI vertex element type %u" ), InElementList[ elementIndex ].type );	break;
 		}
 
@@ -0,0 +1,279 @@
+/**
+ * @file
+ * @addtogroup NullRHI NullRHI
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef NULLCOMMANDLIST_H
+#define NULLCOMMANDLIST_H
+
+#include <vector>
+
+#include "Misc/Types.h"
+#include "Core.h"
+#include "Misc/Stats.h"
+
+/**
+ * @ingroup NullRHI
+ * @brief Enumeration of recorded commands
+ */
+enum ENullRHICommand
+{
+	NRC_SetViewport,				/**< Set viewport */
+	NRC_SetBoundShaderState,		/**< Set bound shader state */
+	NRC_SetStreamSource,			/**< Set vertex stream */
+	NRC_SetRasterizerState,			/**< Set rasterizer state */
+	NRC_SetSamplerState,			/**< Set sampler state */
+	NRC_SetTexture,					/**< Set texture */
+	NRC_SetDepthState,				/**< Set depth state */
+	NRC_SetBlendState,				/**< Set blend state */
+	NRC_SetStencilState,			/**< Set stencil state */
+	NRC_SetColorWrite,				/**< Set color write enable or mask */
+	NRC_SetRenderTarget,			/**< Set render target */
+	NRC_SetShaderParameter,			/**< Set shader parameter (arg0 is number of bytes) */
+	NRC_CommitConstants,			/**< Commit constant buffers */
+	NRC_UploadBuffer,				/**< Upload data to vertex or index buffer (arg0 is number of bytes) */
+	NRC_UploadTexture,				/**< Upload data to texture (arg0 is number of bytes) */
+	NRC_SetupInstancing,			/**< Upload instance data (arg0 is number of bytes) */
+	NRC_Draw,						/**< Draw primitives (arg0 is number of primitives, arg1 is number of instances) */
+	NRC_DrawIndexed,				/**< Draw indexed primitives (arg0 is number of primitives, arg1 is number of instances) */
+	NRC_DrawUP,						/**< Draw primitives from user memory (arg0 is number of primitives, arg1 is number of instances) */
+	NRC_Clear,						/**< Clear surface */
+	NRC_Resolve,					/**< Copy to resolve target */
+	NRC_CopyMips,					/**< Copy shared mips between textures (arg0 is number of mips) */
+	NRC_Num							/**< Number of commands */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Recorded command
+ */
+struct NullRHICommand
+{
+	uint32		command;		/**< Command type (see ENullRHICommand) */
+	uint32		arg0;			/**< First argument */
+	uint32		arg1;			/**< Second argument */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Counters of commands
+ */
+struct NullRHIStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	NullRHIStats()
+	{
+		Reset();
+	}
+
+	/**
+	 * @brief Reset counters
+	 */
+	FORCEINLINE void Reset()
+	{
+		Sys_Memzero( numCommands, sizeof( numCommands ) );
+		numDrawCalls		= 0;
+		numPrimitives		= 0;
+		numStateChanges		= 0;
+		numUploads			= 0;
+		numUploadedBytes	= 0;
+	}
+
+	/**
+	 * @brief Add counters from other stats
+	 * @param InOther	Other stats
+	 */
+	FORCEINLINE void Add( const NullRHIStats& InOther )
+	{
+		for ( uint32 index = 0; index < NRC_Num; ++index )
+		{
+			numCommands[index] += InOther.numCommands[index];
+		}
+
+		numDrawCalls		+= InOther.numDrawCalls;
+		numPrimitives		+= InOther.numPrimitives;
+		numStateChanges		+= InOther.numStateChanges;
+		numUploads			+= InOther.numUploads;
+		numUploadedBytes	+= InOther.numUploadedBytes;
+	}
+
+	uint64		numCommands[NRC_Num];	/**< Number of every command */
+	uint64		numDrawCalls;			/**< Number of draw calls */
+	uint64		numPrimitives;			/**< Number of drawn primitives (with instances) */
+	uint64		numStateChanges;		/**< Number of state sets */
+	uint64		numUploads;				/**< Number of uploads to buffers and textures */
+	uint64		numUploadedBytes;		/**< Number of uploaded bytes */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Command list of null RHI
+ *
+ * Counts every command and, if recording enabled, stores compact stream of commands of the current frame.
+ * Stream is cleared on begin of every frame, so memory usage is bounded by one frame
+ */
+class CNullCommandList
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CNullCommandList();
+
+	/**
+	 * @brief Begin new frame
+	 */
+	void BeginFrame();
+
+	/**
+	 * @brief End frame
+	 */
+	void EndFrame();
+
+	/**
+	 * @brief Add command
+	 *
+	 * @param InCommand		Command
+	 * @param InArg0		First argument
+	 * @param InArg1		Second argument
+	 */
+	FORCEINLINE void AddCommand( ENullRHICommand InCommand, uint32 InArg0 = 0, uint32 InArg1 = 0 )
+	{
+		++frameStats.numCommands[InCommand];
+		if ( bRecording )
+		{
+			commands.push_back( NullRHICommand{ ( uint32 )InCommand, InArg0, InArg1 } );
+		}
+	}
+
+	/**
+	 * @brief Add state change command
+	 * @param InCommand		Command
+	 */
+	FORCEINLINE void AddStateChange( ENullRHICommand InCommand )
+	{
+		++frameStats.numStateChanges;
+		AddCommand( InCommand );
+	}
+
+	/**
+	 * @brief Add draw command
+	 *
+	 * @param InCommand			Command
+	 * @param InNumPrimitives	Number of primitives
+	 * @param InNumInstances	Number of instances
+	 */
+	FORCEINLINE void AddDraw( ENullRHICommand InCommand, uint32 InNumPrimitives, uint32 InNumInstances )
+	{
+		++frameStats.numDrawCalls;
+		frameStats.numPrimitives += ( uint64 )InNumPrimitives * InNumInstances;
+		g_StatRHIDrawCalls.Increment();
+		g_StatRHIPrimitives.Add( ( int64 )InNumPrimitives * InNumInstances );
+		AddCommand( InCommand, InNumPrimitives, InNumInstances );
+	}
+
+	/**
+	 * @brief Add upload command
+	 *
+	 * @param InCommand		Command
+	 * @param InNumBytes	Number of uploaded bytes
+	 */
+	FORCEINLINE void AddUpload( ENullRHICommand InCommand, uint32 InNumBytes )
+	{
+		++frameStats.numUploads;
+		frameStats.numUploadedBytes += InNumBytes;
+		g_StatRHIUploadedBytes.Add( InNumBytes );
+		AddCommand( InCommand, InNumBytes );
+	}
+
+	/**
+	 * @brief Enable or disable recording of command stream
+	 * @param InIsRecording		Is need record commands
+	 */
+	FORCEINLINE void SetRecording( bool InIsRecording )
+	{
+		bRecording = InIsRecording;
+		if ( !bRecording )
+		{
+			commands.clear();
+			lastFrameCommands.clear();
+		}
+	}
+
+	/**
+	 * @brief Is recording of command stream enabled
+	 * @return Return TRUE if command stream is recording
+	 */
+	FORCEINLINE bool IsRecording() const
+	{
+		return bRecording;
+	}
+
+	/**
+	 * @brief Get recorded commands of the last finished frame
+	 * @return Return array of commands (empty if recording is disabled)
+	 */
+	FORCEINLINE const std::vector<NullRHICommand>& GetLastFrameCommands() const
+	{
+		return lastFrameCommands;
+	}
+
+	/**
+	 * @brief Get stats of the last finished frame
+	 * @return Return stats of the last frame
+	 */
+	FORCEINLINE const NullRHIStats& GetLastFrameStats() const
+	{
+		return lastFrameStats;
+	}
+
+	/**
+	 * @brief Get stats of all frames
+	 * @return Return total stats
+	 */
+	FORCEINLINE const NullRHIStats& GetTotalStats() const
+	{
+		return totalStats;
+	}
+
+	/**
+	 * @brief Get number of finished frames
+	 * @return Return number of finished frames
+	 */
+	FORCEINLINE uint64 GetNumFrames() const
+	{
+		return numFrames;
+	}
+
+	/**
+	 * @brief Get hash of recorded commands of the last frame
+	 * Useful for regression tests of render path, hash is changed when sequence of commands is changed
+	 *
+	 * @return Return hash of command stream
+	 */
+	uint64 GetLastFrameHash() const;
+
+	/**
+	 * @brief Get command name
+	 *
+	 * @param InCommand		Command
+	 * @return Return name of command
+	 */
+	static const tchar* GetCommandName( ENullRHICommand InCommand );
+
+private:
+	bool							bRecording;			/**< Is recording command stream */
+	uint64							numFrames;			/**< Number of finished frames */
+	NullRHIStats					frameStats;			/**< Stats of the current frame */
+	NullRHIStats					lastFrameStats;		/**< Stats of the last finished frame */
+	NullRHIStats					totalStats;			/**< Stats of all finished frames */
+	std::vector<NullRHICommand>		commands;			/**< Recorded commands of the current frame */
+	std::vector<NullRHICommand>		lastFrameCommands;	/**< Recorded commands of the last finished frame */
+};
+
+#endif // !NULLCOMMANDLIST_H
\ No newline at end of file
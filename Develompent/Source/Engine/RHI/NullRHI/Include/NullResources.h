@@ -0,0 +1,293 @@
+/**
+ * @file
+ * @addtogroup NullRHI NullRHI
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef NULLRESOURCES_H
+#define NULLRESOURCES_H
+
+#include <vector>
+
+#include "RHI/BaseBufferRHI.h"
+#include "RHI/BaseSurfaceRHI.h"
+#include "RHI/BaseViewportRHI.h"
+#include "RHI/BaseDeviceContextRHI.h"
+#include "RHI/BaseShaderRHI.h"
+#include "RHI/TypesRHI.h"
+
+/**
+ * @ingroup NullRHI
+ * @brief Vertex buffer of null RHI. Data is stored in system memory
+ */
+class CNullVertexBufferRHI : public CBaseVertexBufferRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InUsage	Usage flags
+	 * @param InSize	Size of buffer
+	 * @param InData	Initial data (may be NULL)
+	 */
+	CNullVertexBufferRHI( uint32 InUsage, uint32 InSize, const byte* InData );
+
+	/**
+	 * @brief Get data of buffer
+	 * @return Return pointer to data in system memory
+	 */
+	FORCEINLINE byte* GetData()
+	{
+		return data.data();
+	}
+
+private:
+	std::vector<byte>		data;		/**< Data of buffer */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Index buffer of null RHI. Data is stored in system memory
+ */
+class CNullIndexBufferRHI : public CBaseIndexBufferRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InUsage	Usage flags
+	 * @param InStride	Stride of one index
+	 * @param InSize	Size of buffer
+	 * @param InData	Initial data (may be NULL)
+	 */
+	CNullIndexBufferRHI( uint32 InUsage, uint32 InStride, uint32 InSize, const byte* InData );
+
+	/**
+	 * @brief Get data of buffer
+	 * @return Return pointer to data in system memory
+	 */
+	FORCEINLINE byte* GetData()
+	{
+		return data.data();
+	}
+
+private:
+	std::vector<byte>		data;		/**< Data of buffer */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Texture 2D of null RHI. Mips are allocated in system memory on first lock
+ */
+class CNullTexture2DRHI : public CBaseTextureRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InSizeX		Width of texture
+	 * @param InSizeY		Height of texture
+	 * @param InNumMips		Number of mips
+	 * @param InFormat		Pixel format
+	 * @param InFlags		Texture create flags
+	 */
+	CNullTexture2DRHI( uint32 InSizeX, uint32 InSizeY, uint32 InNumMips, EPixelFormat InFormat, uint32 InFlags );
+
+	/**
+	 * @brief Lock mip of texture
+	 *
+	 * @param InMipIndex		Mip index
+	 * @param OutLockedData		Output locked data
+	 */
+	void Lock( uint32 InMipIndex, LockedData& OutLockedData );
+
+	/**
+	 * @brief Get size of mip in bytes
+	 *
+	 * @param InMipIndex	Mip index
+	 * @param OutPitch		Output pitch of mip
+	 * @return Return size of mip in bytes
+	 */
+	uint32 GetMipSize( uint32 InMipIndex, uint32& OutPitch ) const;
+
+private:
+	std::vector< std::vector<byte> >		mips;		/**< Data of mips */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Bound shader state of null RHI
+ */
+class CNullBoundShaderStateRHI : public CBaseBoundShaderStateRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InKey					Key of bound shader state
+	 * @param InVertexDeclaration	Vertex declaration
+	 * @param InVertexShader		Vertex shader
+	 * @param InPixelShader			Pixel shader
+	 * @param InHullShader			Hull shader
+	 * @param InDomainShader		Domain shader
+	 * @param InGeometryShader		Geometry shader
+	 */
+	CNullBoundShaderStateRHI( const CBoundShaderStateKey& InKey, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader, DomainShaderRHIRef_t InDomainShader, GeometryShaderRHIRef_t InGeometryShader );
+
+	/**
+	 * @brief Destructor
+	 */
+	~CNullBoundShaderStateRHI();
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Surface of null RHI
+ */
+class CNullSurfaceRHI : public CBaseSurfaceRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InSizeX				Width of surface
+	 * @param InSizeY				Height of surface
+	 * @param InResolveTargetTexture	Resolve target texture (may be NULL)
+	 */
+	CNullSurfaceRHI( uint32 InSizeX, uint32 InSizeY, Texture2DRHIParamRef_t InResolveTargetTexture = nullptr );
+
+	/**
+	 * @brief Get width of surface
+	 * @return Return width of surface
+	 */
+	FORCEINLINE uint32 GetSizeX() const
+	{
+		return sizeX;
+	}
+
+	/**
+	 * @brief Get height of surface
+	 * @return Return height of surface
+	 */
+	FORCEINLINE uint32 GetSizeY() const
+	{
+		return sizeY;
+	}
+
+	/**
+	 * @brief Get resolve target texture
+	 * @return Return resolve target texture
+	 */
+	FORCEINLINE Texture2DRHIRef_t GetResolveTargetTexture() const
+	{
+		return resolveTargetTexture;
+	}
+
+private:
+	uint32					sizeX;					/**< Width of surface */
+	uint32					sizeY;					/**< Height of surface */
+	Texture2DRHIRef_t		resolveTargetTexture;	/**< Resolve target texture */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Viewport of null RHI
+ */
+class CNullViewportRHI : public CBaseViewportRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InWindowHandle	Window handle (may be NULL)
+	 * @param InSurfaceRHI		Target surface (may be NULL, in this case will be created back buffer)
+	 * @param InWidth			Width of viewport
+	 * @param InHeight			Height of viewport
+	 */
+	CNullViewportRHI( WindowHandle_t InWindowHandle, SurfaceRHIParamRef_t InSurfaceRHI, uint32 InWidth, uint32 InHeight );
+
+	/**
+	 * @brief Resize viewport
+	 *
+	 * @param InWidth	New width
+	 * @param InHeight	New height
+	 */
+	virtual void Resize( uint32 InWidth, uint32 InHeight ) override;
+
+	/**
+	 * @brief Set surface of viewport
+	 * @param InSurfaceRHI	Surface
+	 */
+	virtual void SetSurface( SurfaceRHIParamRef_t InSurfaceRHI ) override;
+
+	/**
+	 * @brief Get width
+	 * @return Return width of viewport
+	 */
+	virtual uint32 GetWidth() const override;
+
+	/**
+	 * @brief Get height
+	 * @return Return height of viewport
+	 */
+	virtual uint32 GetHeight() const override;
+
+	/**
+	 * @brief Get surface
+	 * @return Return surface of viewport
+	 */
+	virtual SurfaceRHIRef_t GetSurface() const override;
+
+	/**
+	 * @brief Get window handle
+	 * @return Return window handle
+	 */
+	virtual WindowHandle_t GetWindowHandle() const override;
+
+private:
+	bool				bBackBuffer;		/**< Is surface is own back buffer of viewport */
+	WindowHandle_t		windowHandle;		/**< Window handle */
+	uint32				width;				/**< Width of viewport */
+	uint32				height;				/**< Height of viewport */
+	SurfaceRHIRef_t		surface;			/**< Surface of viewport */
+};
+
+/**
+ * @ingroup NullRHI
+ * @brief Device context of null RHI
+ */
+class CNullDeviceContextRHI : public CBaseDeviceContextRHI
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InCommandList		Command list for record commands
+	 */
+	CNullDeviceContextRHI( class CNullCommandList* InCommandList );
+
+	/**
+	 * @brief Clear surface
+	 *
+	 * @param InSurface		Surface
+	 * @param InColor		Clear color
+	 */
+	virtual void ClearSurface( SurfaceRHIParamRef_t InSurface, const class CColor& InColor ) override;
+
+	/**
+	 * @brief Clear depth stencil
+	 *
+	 * @param InSurface			Surface
+	 * @param InIsClearDepth	Is need clear depth
+	 * @param InIsClearStencil	Is need clear stencil
+	 * @param InDepthValue		Depth value
+	 * @param InStencilValue	Stencil value
+	 */
+	virtual void ClearDepthStencil( SurfaceRHIParamRef_t InSurface, bool InIsClearDepth = true, bool InIsClearStencil = true, float InDepthValue = 1.f, uint8 InStencilValue = 0 ) override;
+
+private:
+	class CNullCommandList*		commandList;		/**< Command list */
+};
+
+#endif // !NULLRESOURCES_H
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "NullCommandList.h"
+
+/*
+==================
+CNullCommandList::CNullCommandList
+==================
+*/
+CNullCommandList::CNullCommandList()
+	: bRecording( false )
+	, numFrames( 0 )
+{}
+
+/*
+==================
+CNullCommandList::BeginFrame
+==================
+*/
+void CNullCommandList::BeginFrame()
+{
+	frameStats.Reset();
+	commands.clear();
+}
+
+/*
+==================
+CNullCommandList::EndFrame
+==================
+*/
+void CNullCommandList::EndFrame()
+{
+	lastFrameStats = frameStats;
+	totalStats.Add( frameStats );
+	++numFrames;
+
+	if ( bRecording )
+	{
+		lastFrameCommands.swap( commands );
+	}
+	commands.clear();
+	frameStats.Reset();
+}
+
+/*
+==================
+CNullCommandList::GetLastFrameHash
+==================
+*/
+uint64 CNullCommandList::GetLastFrameHash() const
+{
+	if ( lastFrameCommands.empty() )
+	{
+		return 0;
+	}
+	return Sys_MemFastHash( lastFrameCommands.data(), ( uint64 )lastFrameCommands.size() * sizeof( NullRHICommand ) );
+}
+
+/*
+==================
+CNullCommandList::GetCommandName
+==================
+*/
+const tchar* CNullCommandList::GetCommandName( ENullRHICommand InCommand )
+{
+	switch ( InCommand )
+	{
+	case NRC_SetViewport:				return TEXT( "SetViewport" );
+	case NRC_SetBoundShaderState:		return TEXT( "SetBoundShaderState" );
+	case NRC_SetStreamSource:			return TEXT( "SetStreamSource" );
+	case NRC_SetRasterizerState:		return TEXT( "SetRasterizerState" );
+	case NRC_SetSamplerState:			return TEXT( "SetSamplerState" );
+	case NRC_SetTexture:				return TEXT( "SetTexture" );
+	case NRC_SetDepthState:				return TEXT( "SetDepthState" );
+	case NRC_SetBlendState:				return TEXT( "SetBlendState" );
+	case NRC_SetStencilState:			return TEXT( "SetStencilState" );
+	case NRC_SetColorWrite:				return TEXT( "SetColorWrite" );
+	case NRC_SetRenderTarget:			return TEXT( "SetRenderTarget" );
+	case NRC_SetShaderParameter:		return TEXT( "SetShaderParameter" );
+	case NRC_CommitConstants:			return TEXT( "CommitConstants" );
+	case NRC_UploadBuffer:				return TEXT( "UploadBuffer" );
+	case NRC_UploadTexture:				return TEXT( "UploadTexture" );
+	case NRC_SetupInstancing:			return TEXT( "SetupInstancing" );
+	case NRC_Draw:						return TEXT( "Draw" );
+	case NRC_DrawIndexed:				return TEXT( "DrawIndexed" );
+	case NRC_DrawUP:					return TEXT( "DrawUP" );
+	case NRC_Clear:						return TEXT( "Clear" );
+	case NRC_Resolve:					return TEXT( "Resolve" );
+	case NRC_CopyMips:					return TEXT( "CopyMips" );
+	default:							return TEXT( "Unknown" );
+	}
+}
\ No newline at end of file
@@ -0,0 +1,785 @@
+#include "Core.h"
+#include "Logger/LoggerMacros.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Stats.h"
+#include "Render/RenderResource.h"
+#include "Render/RenderUtils.h"
+#include "NullRHI.h"
+#include "NullResources.h"
+
+/*
+==================
+GetVertexCountForPrimitiveCount
+==================
+*/
+static FORCEINLINE uint32 GetVertexCountForPrimitiveCount( uint32 InNumPrimitives, EPrimitiveType InPrimitiveType )
+{
+	uint32		vertexCount = 0;
+	switch ( InPrimitiveType )
+	{
+	case PT_PointList:			vertexCount = InNumPrimitives;		break;
+	case PT_TriangleList:		vertexCount = InNumPrimitives * 3;	break;
+	case PT_TriangleStrip:		vertexCount = InNumPrimitives + 2;	break;
+	case PT_LineList:			vertexCount = InNumPrimitives * 2;	break;
+
+	default:
+		Sys_Errorf( TEXT( "Unknown primitive type: %u" ), ( uint32 )InPrimitiveType );
+	}
+
+	return vertexCount;
+}
+
+/*
+==================
+CNullRHI::CNullRHI
+==================
+*/
+CNullRHI::CNullRHI()
+	: isInitialize( false )
+	, immediateContext( nullptr )
+	, viewportMinX( 0 )
+	, viewportMinY( 0 )
+	, viewportMinZ( 0.f )
+	, viewportMaxX( 0 )
+	, viewportMaxY( 0 )
+	, viewportMaxZ( 1.f )
+{}
+
+/*
+==================
+CNullRHI::~CNullRHI
+==================
+*/
+CNullRHI::~CNullRHI()
+{
+	Destroy();
+}
+
+/*
+==================
+CNullRHI::Init
+==================
+*/
+void CNullRHI::Init( bool InIsEditor )
+{
+	if ( isInitialize )
+	{
+		return;
+	}
+
+	immediateContext = new CNullDeviceContextRHI( &commandList );
+	commandList.SetRecording( g_CommandLine.HasParam( TEXT( "nullrhi" ), TEXT( "record" ) ) );
+	Logf( TEXT( "Using null RHI, nothing will be rendered\n" ) );
+	Logf( TEXT( "Recording of command stream: %s\n" ), commandList.IsRecording() ? TEXT( "enabled" ) : TEXT( "disabled" ) );
+
+	// All pixel formats are supported, textures are stored in system memory
+	g_PixelCenterOffset = 0.f;
+	for ( uint32 index = 0; index < PF_Max; ++index )
+	{
+		g_PixelFormats[index].supported = index != PF_Unknown;
+	}
+
+	// Upload rings don't have any memory here, we only run the allocator to get the same stats as D3D11 RHI
+	uploadVertexRing.Init( CUploadRingAllocator::GetConfigVertexRingSize() );
+	uploadIndexRing.Init( CUploadRingAllocator::GetConfigVertexRingSize() / UPLOAD_RING_INDEX_SIZE_RATIO );
+	isInitialize = true;
+
+	// Initialize all global render resources
+	std::set< CRenderResource* >&			globalResourceList = CRenderResource::GetResourceList();
+	for ( auto it = globalResourceList.begin(), itEnd = globalResourceList.end(); it != itEnd; ++it )
+	{
+		( *it )->InitResource();
+	}
+}
+
+/*
+==================
+CNullRHI::Destroy
+==================
+*/
+void CNullRHI::Destroy()
+{
+	if ( !isInitialize )		return;
+
+	// Release all global render resources
+	std::set<CRenderResource*>		globalResourceList = CRenderResource::GetResourceList();
+	for ( auto it = globalResourceList.begin(), itEnd = globalResourceList.end(); it != itEnd; ++it )
+	{
+		( *it )->ReleaseResource();
+	}
+
+	const NullRHIStats&		totalStats = commandList.GetTotalStats();
+	Logf( TEXT( "Null RHI: %llu frames, %llu draw calls, %llu primitives, %llu state changes, %llu uploads (%llu bytes)\n" ),
+		  commandList.GetNumFrames(), totalStats.numDrawCalls, totalStats.numPrimitives, totalStats.numStateChanges, totalStats.numUploads, totalStats.numUploadedBytes );
+
+	delete immediateContext;
+	immediateContext	= nullptr;
+	isInitialize		= false;
+	boundShaderStateHistory.RemoveAll();
+}
+
+/*
+==================
+CNullRHI::CreateViewport
+==================
+*/
+ViewportRHIRef_t CNullRHI::CreateViewport( WindowHandle_t InWindowHandle, uint32 InWidth, uint32 InHeight )
+{
+	return new CNullViewportRHI( InWindowHandle, nullptr, InWidth, InHeight );
+}
+
+/*
+==================
+CNullRHI::CreateViewport
+==================
+*/
+ViewportRHIRef_t CNullRHI::CreateViewport( SurfaceRHIParamRef_t InSurfaceRHI, uint32 InWidth, uint32 InHeight )
+{
+	return new CNullViewportRHI( nullptr, InSurfaceRHI, InWidth, InHeight );
+}
+
+/*
+==================
+CNullRHI::CreateVertexShader
+==================
+*/
+VertexShaderRHIRef_t CNullRHI::CreateVertexShader( const tchar* InShaderName, const byte* InData, uint32 InSize )
+{
+	return new CBaseShaderRHI( SF_Vertex, InShaderName );
+}
+
+/*
+==================
+CNullRHI::CreateHullShader
+==================
+*/
+HullShaderRHIRef_t CNullRHI::CreateHullShader( const tchar* InShaderName, const byte* InData, uint32 InSize )
+{
+	return new CBaseShaderRHI( SF_Hull, InShaderName );
+}
+
+/*
+==================
+CNullRHI::CreateDomainShader
+==================
+*/
+DomainShaderRHIRef_t CNullRHI::CreateDomainShader( const tchar* InShaderName, const byte* InData, uint32 InSize )
+{
+	return new CBaseShaderRHI( SF_Domain, InShaderName );
+}
+
+/*
+==================
+CNullRHI::CreatePixelShader
+==================
+*/
+PixelShaderRHIRef_t CNullRHI::CreatePixelShader( const tchar* InShaderName, const byte* InData, uint32 InSize )
+{
+	return new CBaseShaderRHI( SF_Pixel, InShaderName );
+}
+
+/*
+==================
+CNullRHI::CreateGeometryShader
+==================
+*/
+GeometryShaderRHIRef_t CNullRHI::CreateGeometryShader( const tchar* InShaderName, const byte* InData, uint32 InSize )
+{
+	return new CBaseShaderRHI( SF_Geometry, InShaderName );
+}
+
+/*
+==================
+CNullRHI::CreateVertexBuffer
+==================
+*/
+VertexBufferRHIRef_t CNullRHI::CreateVertexBuffer( const tchar* InBufferName, uint32 InSize, const byte* InData, uint32 InUsage )
+{
+	if ( InData )
+	{
+		commandList.AddUpload( NRC_UploadBuffer, InSize );
+	}
+	return new CNullVertexBufferRHI( InUsage, InSize, InData );
+}
+
+/*
+==================
+CNullRHI::CreateIndexBuffer
+==================
+*/
+IndexBufferRHIRef_t CNullRHI::CreateIndexBuffer( const tchar* InBufferName, uint32 InStride, uint32 InSize, const byte* InData, uint32 InUsage )
+{
+	if ( InData )
+	{
+		commandList.AddUpload( NRC_UploadBuffer, InSize );
+	}
+	return new CNullIndexBufferRHI( InUsage, InStride, InSize, InData );
+}
+
+/*
+==================
+CNullRHI::CreateVertexDeclaration
+==================
+*/
+VertexDeclarationRHIRef_t CNullRHI::CreateVertexDeclaration( const VertexDeclarationElementList_t& InElementList )
+{
+	return new CBaseVertexDeclarationRHI( InElementList );
+}
+
+/*
+==================
+CNullRHI::CreateBoundShaderState
+==================
+*/
+BoundShaderStateRHIRef_t CNullRHI::CreateBoundShaderState( const tchar* InBoundShaderStateName, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader /*= nullptr*/, DomainShaderRHIRef_t InDomainShader /*= nullptr*/, GeometryShaderRHIRef_t InGeometryShader /*= nullptr*/ )
+{
+	CBoundShaderStateKey		key( InVertexDeclaration, InVertexShader, InPixelShader, InHullShader, InDomainShader, InGeometryShader );
+	BoundShaderStateRHIRef_t	boundShaderStateRHI = boundShaderStateHistory.Find( key );
+	if ( !boundShaderStateRHI )
+	{
+		boundShaderStateRHI = new CNullBoundShaderStateRHI( key, InVertexDeclaration, InVertexShader, InPixelShader, InHullShader, InDomainShader, InGeometryShader );
+		boundShaderStateHistory.Add( key, boundShaderStateRHI );
+	}
+
+	return boundShaderStateRHI;
+}
+
+/*
+==================
+CNullRHI::CreateRasterizerState
+==================
+*/
+RasterizerStateRHIRef_t CNullRHI::CreateRasterizerState( const RasterizerStateInitializerRHI& InInitializer )
+{
+	return new CBaseRasterizerStateRHI( InInitializer );
+}
+
+/*
+==================
+CNullRHI::CreateSamplerState
+==================
+*/
+SamplerStateRHIRef_t CNullRHI::CreateSamplerState( const SSamplerStateInitializerRHI& InInitializer )
+{
+	return new CBaseSamplerStateRHI();
+}
+
+/*
+==================
+CNullRHI::CreateDepthState
+==================
+*/
+DepthStateRHIRef_t CNullRHI::CreateDepthState( const DepthStateInitializerRHI& InInitializer )
+{
+	return new CBaseDepthStateRHI();
+}
+
+/*
+==================
+CNullRHI::CreateBlendState
+==================
+*/
+BlendStateRHIRef_t CNullRHI::CreateBlendState( const BlendStateInitializerRHI& InInitializer )
+{
+	return new CBaseBlendStateRHI();
+}
+
+/*
+==================
+CNullRHI::CreateStencilState
+==================
+*/
+StencilStateRHIRef_t CNullRHI::CreateStencilState( const StencilStateInitializerRHI& InInitializer )
+{
+	return new CBaseStencilStateRHI();
+}
+
+/*
+==================
+CNullRHI::CreateTexture2D
+==================
+*/
+Texture2DRHIRef_t CNullRHI::CreateTexture2D( const tchar* InDebugName, uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, uint32 InNumMips, uint32 InFlags, void* InData /* = nullptr */ )
+{
+	CNullTexture2DRHI*		texture = new CNullTexture2DRHI( InSizeX, InSizeY, InNumMips, InFormat, InFlags );
+	if ( InData )
+	{
+		// Like in D3D11 RHI initial data contains only first mip
+		LockedData		lockedData;
+		texture->Lock( 0, lockedData );
+		memcpy( lockedData.data, InData, lockedData.size );
+		commandList.AddUpload( NRC_UploadTexture, lockedData.size );
+		lockedData.data = nullptr;
+	}
+	return texture;
+}
+
+/*
+==================
+CNullRHI::CreateTargetableSurface
+==================
+*/
+SurfaceRHIRef_t CNullRHI::CreateTargetableSurface( const tchar* InDebugName, uint32 InSizeX, uint32 InSizeY, EPixelFormat InFormat, Texture2DRHIParamRef_t InResolveTargetTexture, uint32 InFlags )
+{
+	return new CNullSurfaceRHI( InSizeX, InSizeY, InResolveTargetTexture );
+}
+
+/*
+==================
+CNullRHI::BeginDrawingViewport
+==================
+*/
+void CNullRHI::BeginDrawingViewport( class CBaseDeviceContextRHI* InDeviceContext, class CBaseViewportRHI* InViewport )
+{
+	Assert( InDeviceContext && InViewport );
+	commandList.BeginFrame();
+
+	SetRenderTarget( InDeviceContext, InViewport->GetSurface(), nullptr );
+	SetViewport( InDeviceContext, 0, 0, 0.f, InViewport->GetWidth(), InViewport->GetHeight(), 1.f );
+}
+
+/*
+==================
+CNullRHI::EndDrawingViewport
+==================
+*/
+void CNullRHI::EndDrawingViewport( class CBaseDeviceContextRHI* InDeviceContext, class CBaseViewportRHI* InViewport, bool InIsPresent, bool InLockToVsync )
+{
+	Assert( InViewport );
+	commandList.EndFrame();
+	if ( InIsPresent )
+	{
+		// There is no GPU, so frame is finished right away
+		uploadVertexRing.RetireFrames( uploadVertexRing.EndFrame() );
+		uploadIndexRing.RetireFrames( uploadIndexRing.EndFrame() );
+	}
+}
+
+#if WITH_EDITOR
+/*
+==================
+CNullRHI::CompileShader
+==================
+*/
+bool CNullRHI::CompileShader( const tchar* InSourceFileName, const tchar* InFunctionName, EShaderFrequency InFrequency, const ShaderCompilerEnvironment& InEnvironment, ShaderCompilerOutput& InOutput, bool InDebugDump /* = false */, const tchar* InShaderSubDir /* = TEXT( "" ) */ )
+{
+	Warnf( TEXT( "Null RHI can't compile shader '%s'\n" ), InSourceFileName );
+	return false;
+}
+#endif // WITH_EDITOR
+
+/*
+==================
+CNullRHI::GetShaderPlatform
+==================
+*/
+EShaderPlatform CNullRHI::GetShaderPlatform() const
+{
+	return SP_PCD3D_SM5;
+}
+
+/*
+==================
+CNullRHI::SetupInstancing
+==================
+*/
+void CNullRHI::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContext, uint32 InStreamIndex, void* InInstanceData, uint32 InInstanceStride, uint32 InInstanceSize, uint32 InNumInstances )
+{
+	AllocateFromUploadRing( uploadVertexRing, InInstanceSize, UPLOAD_RING_INSTANCE_ALIGNMENT );
+	commandList.AddUpload( NRC_SetupInstancing, InInstanceSize );
+}
+
+/*
+==================
+CNullRHI::AllocateFromUploadRing
+==================
+*/
+void CNullRHI::AllocateFromUploadRing( CUploadRingAllocator& InRing, uint32 InSize, uint32 InAlignment )
+{
+	UploadRingAllocation		allocation;
+	if ( InRing.Allocate( InSize, InAlignment, allocation ) )
+	{
+		g_StatRHIUploadRingBytes.Add( InSize );
+		if ( allocation.bWrapped )
+		{
+			g_StatRHIUploadRingWraps.Increment();
+		}
+		if ( allocation.bNeedDiscard )
+		{
+			g_StatRHIUploadRingDiscards.Increment();
+		}
+	}
+}
+
+/*
+==================
+CNullRHI::SetViewport
+==================
+*/
+void CNullRHI::SetViewport( class CBaseDeviceContextRHI* InDeviceContext, uint32 InMinX, uint32 InMinY, float InMinZ, uint32 InMaxX, uint32 InMaxY, float InMaxZ )
+{
+	viewportMinX = InMinX;
+	viewportMinY = InMinY;
+	viewportMinZ = InMinZ;
+	viewportMaxX = InMaxX;
+	viewportMaxY = InMaxY;
+	viewportMaxZ = InMaxZ;
+	commandList.AddStateChange( NRC_SetViewport );
+}
+
+/*
+==================
+CNullRHI::SetBoundShaderState
+==================
+*/
+void CNullRHI::SetBoundShaderState( class CBaseDeviceContextRHI* InDeviceContext, BoundShaderStateRHIParamRef_t InBoundShaderState )
+{
+	commandList.AddStateChange( NRC_SetBoundShaderState );
+}
+
+/*
+==================
+CNullRHI::SetStreamSource
+==================
+*/
+void CNullRHI::SetStreamSource( class CBaseDeviceContextRHI* InDeviceContext, uint32 InStreamIndex, VertexBufferRHIParamRef_t InVertexBuffer, uint32 InStride, uint32 InOffset )
+{
+	commandList.AddStateChange( NRC_SetStreamSource );
+}
+
+/*
+==================
+CNullRHI::SetRasterizerState
+==================
+*/
+void CNullRHI::SetRasterizerState( class CBaseDeviceContextRHI* InDeviceContext, RasterizerStateRHIParamRef_t InNewState )
+{
+	commandList.AddStateChange( NRC_SetRasterizerState );
+}
+
+/*
+==================
+CNullRHI::SetSamplerState
+==================
+*/
+void CNullRHI::SetSamplerState( class CBaseDeviceContextRHI* InDeviceContext, PixelShaderRHIParamRef_t InPixelShader, SamplerStateRHIParamRef_t InNewState, uint32 InStateIndex )
+{
+	commandList.AddStateChange( NRC_SetSamplerState );
+}
+
+/*
+==================
+CNullRHI::SetTextureParameter
+==================
+*/
+void CNullRHI::SetTextureParameter( class CBaseDeviceContextRHI* InDeviceContext, PixelShaderRHIParamRef_t InPixelShader, TextureRHIParamRef_t InTexture, uint32 InTextureIndex )
+{
+	commandList.AddStateChange( NRC_SetTexture );
+}
+
+/*
+==================
+CNullRHI::SetRenderTarget
+==================
+*/
+void CNullRHI::SetRenderTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InNewRenderTarget, SurfaceRHIParamRef_t InNewDepthStencilTarget )
+{
+	commandList.AddStateChange( NRC_SetRenderTarget );
+}
+
+/*
+==================
+CNullRHI::SetMRTRenderTarget
+==================
+*/
+void CNullRHI::SetMRTRenderTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InNewRenderTarget, uint32 InTargetIndex )
+{
+	commandList.AddStateChange( NRC_SetRenderTarget );
+}
+
+/*
+==================
+CNullRHI::SetVertexShaderParameter
+==================
+*/
+void CNullRHI::SetVertexShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
+{
+	commandList.AddCommand( NRC_SetShaderParameter, InNumBytes );
+}
+
+/*
+==================
+CNullRHI::SetPixelShaderParameter
+==================
+*/
+void CNullRHI::SetPixelShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
+{
+	commandList.AddCommand( NRC_SetShaderParameter, InNumBytes );
+}
+
+/*
+==================
+CNullRHI::SetDepthState
+==================
+*/
+void CNullRHI::SetDepthState( class CBaseDeviceContextRHI* InDeviceContext, DepthStateRHIParamRef_t InNewState )
+{
+	commandList.AddStateChange( NRC_SetDepthState );
+}
+
+/*
+==================
+CNullRHI::SetBlendState
+==================
+*/
+void CNullRHI::SetBlendState( class CBaseDeviceContextRHI* InDeviceContext, BlendStateRHIParamRef_t InNewState )
+{
+	commandList.AddStateChange( NRC_SetBlendState );
+}
+
+/*
+==================
+CNullRHI::SetColorWriteEnable
+==================
+*/
+void CNullRHI::SetColorWriteEnable( class CBaseDeviceContextRHI* InDeviceContext, bool InIsEnable )
+{
+	commandList.AddStateChange( NRC_SetColorWrite );
+}
+
+/*
+==================
+CNullRHI::SetMRTColorWriteEnable
+==================
+*/
+void CNullRHI::SetMRTColorWriteEnable( class CBaseDeviceContextRHI* InDeviceContext, bool InIsEnable, uint32 InTargetIndex )
+{
+	commandList.AddStateChange( NRC_SetColorWrite );
+}
+
+/*
+==================
+CNullRHI::SetColorWriteMask
+==================
+*/
+void CNullRHI::SetColorWriteMask( class CBaseDeviceContextRHI* InDeviceContext, uint8 InColorWriteMask )
+{
+	commandList.AddStateChange( NRC_SetColorWrite );
+}
+
+/*
+==================
+CNullRHI::SetMRTColorWriteMask
+==================
+*/
+void CNullRHI::SetMRTColorWriteMask( class CBaseDeviceContextRHI* InDeviceContext, uint8 InColorWriteMask, uint32 InTargetIndex )
+{
+	commandList.AddStateChange( NRC_SetColorWrite );
+}
+
+/*
+==================
+CNullRHI::SetStencilState
+==================
+*/
+void CNullRHI::SetStencilState( class CBaseDeviceContextRHI* InDeviceContext, StencilStateRHIParamRef_t InNewState )
+{
+	commandList.AddStateChange( NRC_SetStencilState );
+}
+
+/*
+==================
+CNullRHI::CommitConstants
+==================
+*/
+void CNullRHI::CommitConstants( class CBaseDeviceContextRHI* InDeviceContext )
+{
+	commandList.AddCommand( NRC_CommitConstants );
+}
+
+/*
+==================
+CNullRHI::LockVertexBuffer
+==================
+*/
+void CNullRHI::LockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InSize, uint32 InOffset, LockedData& OutLockedData )
+{
+	CNullVertexBufferRHI*		vertexBuffer = ( CNullVertexBufferRHI* )InVertexBuffer.GetPtr();
+	Assert( vertexBuffer && InOffset + InSize <= vertexBuffer->GetSize() );
+
+	OutLockedData.data	= vertexBuffer->GetData() + InOffset;
+	OutLockedData.size	= InSize;
+	OutLockedData.pitch = InSize;
+}
+
+/*
+==================
+CNullRHI::UnlockVertexBuffer
+==================
+*/
+void CNullRHI::UnlockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, LockedData& InLockedData )
+{
+	commandList.AddUpload( NRC_UploadBuffer, InLockedData.size );
+	InLockedData.data = nullptr;
+}
+
+/*
+==================
+CNullRHI::LockIndexBuffer
+==================
+*/
+void CNullRHI::LockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, uint32 InSize, uint32 InOffset, LockedData& OutLockedData )
+{
+	CNullIndexBufferRHI*		indexBuffer = ( CNullIndexBufferRHI* )InIndexBuffer.GetPtr();
+	Assert( indexBuffer && InOffset + InSize <= indexBuffer->GetSize() );
+
+	OutLockedData.data	= indexBuffer->GetData() + InOffset;
+	OutLockedData.size	= InSize;
+	OutLockedData.pitch = InSize;
+}
+
+/*
+==================
+CNullRHI::UnlockIndexBuffer
+==================
+*/
+void CNullRHI::UnlockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, LockedData& InLockedData )
+{
+	commandList.AddUpload( NRC_UploadBuffer, InLockedData.size );
+	InLockedData.data = nullptr;
+}
+
+/*
+==================
+CNullRHI::LockTexture2D
+==================
+*/
+void CNullRHI::LockTexture2D( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InTexture, uint32 InMipIndex, bool InIsDataWrite, LockedData& OutLockedData, bool InIsUseCPUShadow /* = false */ )
+{
+	Assert( InTexture );
+	( ( CNullTexture2DRHI* )InTexture )->Lock( InMipIndex, OutLockedData );
+}
+
+/*
+==================
+CNullRHI::UnlockTexture2D
+==================
+*/
+void CNullRHI::UnlockTexture2D( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InTexture, uint32 InMipIndex, LockedData& InLockedData )
+{
+	commandList.AddUpload( NRC_UploadTexture, InLockedData.size );
+	InLockedData.data = nullptr;
+}
+
+/*
+==================
+CNullRHI::DrawPrimitive
+==================
+*/
+void CNullRHI::DrawPrimitive( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, uint32 InNumInstances /* = 1 */ )
+{
+	commandList.AddDraw( NRC_Draw, InNumPrimitives, InNumInstances );
+}
+
+/*
+==================
+CNullRHI::DrawIndexedPrimitive
+==================
+*/
+void CNullRHI::DrawIndexedPrimitive( class CBaseDeviceContextRHI* InDeviceContext, class CBaseIndexBufferRHI* InIndexBuffer, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InStartIndex, uint32 InNumPrimitives, uint32 InNumInstances /* = 1 */ )
+{
+	Assert( InIndexBuffer );
+	commandList.AddDraw( NRC_DrawIndexed, InNumPrimitives, InNumInstances );
+}
+
+/*
+==================
+CNullRHI::CopyToResolveTarget
+==================
+*/
+void CNullRHI::CopyToResolveTarget( class CBaseDeviceContextRHI* InDeviceContext, SurfaceRHIParamRef_t InSourceSurface, const ResolveParams& InResolveParams )
+{
+	commandList.AddCommand( NRC_Resolve );
+}
+
+/*
+==================
+CNullRHI::CopySharedMips
+==================
+*/
+void CNullRHI::CopySharedMips( class CBaseDeviceContextRHI* InDeviceContext, Texture2DRHIParamRef_t InDestTexture, Texture2DRHIParamRef_t InSourceTexture )
+{
+	commandList.AddCommand( NRC_CopyMips, Min( InDestTexture->GetNumMips(), InSourceTexture->GetNumMips() ) );
+}
+
+/*
+==================
+CNullRHI::DrawPrimitiveUP
+==================
+*/
+void CNullRHI::DrawPrimitiveUP( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, const void* InVertexData, uint32 InVertexDataStride, uint32 InNumInstances /* = 1 */ )
+{
+	// D3D11 RHI copies user vertices into upload ring, so we count it as upload
+	AllocateFromUploadRing( uploadVertexRing, GetVertexCountForPrimitiveCount( InNumPrimitives, InPrimitiveType ) * InVertexDataStride, InVertexDataStride );
+	commandList.AddUpload( NRC_UploadBuffer, GetVertexCountForPrimitiveCount( InNumPrimitives, InPrimitiveType ) * InVertexDataStride );
+	commandList.AddDraw( NRC_DrawUP, InNumPrimitives, InNumInstances );
+}
+
+/*
+==================
+CNullRHI::DrawIndexedPrimitiveUP
+==================
+*/
+void CNullRHI::DrawIndexedPrimitiveUP( class CBaseDeviceContextRHI* InDeviceContext, EPrimitiveType InPrimitiveType, uint32 InBaseVertexIndex, uint32 InNumPrimitives, uint32 InNumVertices, const void* InIndexData, uint32 InIndexDataStride, const void* InVertexData, uint32 InVertexDataStride, uint32 InNumInstances /* = 1 */ )
+{
+	AllocateFromUploadRing( uploadVertexRing, InNumVertices * InVertexDataStride, InVertexDataStride );
+	AllocateFromUploadRing( uploadIndexRing, GetVertexCountForPrimitiveCount( InNumPrimitives, InPrimitiveType ) * InIndexDataStride, InIndexDataStride );
+	commandList.AddUpload( NRC_UploadBuffer, InNumVertices * InVertexDataStride );
+	commandList.AddUpload( NRC_UploadBuffer, GetVertexCountForPrimitiveCount( InNumPrimitives, InPrimitiveType ) * InIndexDataStride );
+	commandList.AddDraw( NRC_DrawUP, InNumPrimitives, InNumInstances );
+}
+
+/*
+==================
+CNullRHI::IsInitialize
+==================
+*/
+bool CNullRHI::IsInitialize() const
+{
+	return isInitialize;
+}
+
+/*
+==================
+CNullRHI::GetRHIName
+==================
+*/
+const tchar* CNullRHI::GetRHIName() const
+{
+	return TEXT( "NullRHI" );
+}
+
+/*
+==================
+CNullRHI::GetImmediateContext
+==================
+*/
+class CBaseDeviceContextRHI* CNullRHI::GetImmediateContext() const
+{
+	return immediateContext;
+}
+
+/*
+==================
+CNullRHI::GetViewport
+==================
+*/
+void CNullRHI::GetViewport( uint32& OutMinX, uint32& OutMinY, float& OutMinZ, uint32& OutMaxX, uint32& OutMaxY, float& OutMaxZ ) const
+{
+	OutMinX = viewportMinX;
+	OutMinY = viewportMinY;
+	OutMinZ = viewportMinZ;
+	OutMaxX = viewportMaxX;
+	OutMaxY = viewportMaxY;
+	OutMaxZ = viewportMaxZ;
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "Misc/EngineGlobals.h"
+#include "Render/RenderUtils.h"
+#include "NullResources.h"
+#include "NullCommandList.h"
+#include "NullRHI.h"
+
+/*
+==================
+CNullVertexBufferRHI::CNullVertexBufferRHI
+==================
+*/
+CNullVertexBufferRHI::CNullVertexBufferRHI( uint32 InUsage, uint32 InSize, const byte* InData )
+	: CBaseVertexBufferRHI( InUsage, InSize )
+	, data( InSize )
+{
+	if ( InData && InSize > 0 )
+	{
+		memcpy( data.data(), InData, InSize );
+	}
+}
+
+/*
+==================
+CNullIndexBufferRHI::CNullIndexBufferRHI
+==================
+*/
+CNullIndexBufferRHI::CNullIndexBufferRHI( uint32 InUsage, uint32 InStride, uint32 InSize, const byte* InData )
+	: CBaseIndexBufferRHI( InUsage, InStride, InSize )
+	, data( InSize )
+{
+	if ( InData && InSize > 0 )
+	{
+		memcpy( data.data(), InData, InSize );
+	}
+}
+
+/*
+==================
+CNullTexture2DRHI::CNullTexture2DRHI
+==================
+*/
+CNullTexture2DRHI::CNullTexture2DRHI( uint32 InSizeX, uint32 InSizeY, uint32 InNumMips, EPixelFormat InFormat, uint32 InFlags )
+	: CBaseTextureRHI( InSizeX, InSizeY, InNumMips, InFormat, InFlags )
+	, mips( Max<uint32>( InNumMips, 1 ) )
+{}
+
+/*
+==================
+CNullTexture2DRHI::GetMipSize
+==================
+*/
+uint32 CNullTexture2DRHI::GetMipSize( uint32 InMipIndex, uint32& OutPitch ) const
+{
+	const PixelFormatInfo&		formatInfo	= g_PixelFormats[GetFormat()];
+	const uint32				blockSizeX	= Max<uint32>( formatInfo.blockSizeX, 1 );
+	const uint32				blockSizeY	= Max<uint32>( formatInfo.blockSizeY, 1 );
+	const uint32				mipSizeX	= Max<uint32>( GetSizeX() >> InMipIndex, blockSizeX );
+	const uint32				mipSizeY	= Max<uint32>( GetSizeY() >> InMipIndex, blockSizeY );
+	const uint32				numBlocksX	= ( mipSizeX + blockSizeX - 1 ) / blockSizeX;
+	const uint32				numBlocksY	= ( mipSizeY + blockSizeY - 1 ) / blockSizeY;
+
+	OutPitch = numBlocksX * formatInfo.blockBytes;
+	return OutPitch * numBlocksY;
+}
+
+/*
+==================
+CNullTexture2DRHI::Lock
+==================
+*/
+void CNullTexture2DRHI::Lock( uint32 InMipIndex, LockedData& OutLockedData )
+{
+	Assert( InMipIndex < mips.size() );
+
+	uint32		pitch	= 0;
+	uint32		size	= GetMipSize( InMipIndex, pitch );
+	if ( mips[InMipIndex].size() != size )
+	{
+		mips[InMipIndex].resize( size );
+	}
+
+	OutLockedData.data	= mips[InMipIndex].data();
+	OutLockedData.size	= size;
+	OutLockedData.pitch = pitch;
+}
+
+/*
+==================
+CNullBoundShaderStateRHI::CNullBoundShaderStateRHI
+==================
+*/
+CNullBoundShaderStateRHI::CNullBoundShaderStateRHI( const CBoundShaderStateKey& InKey, VertexDeclarationRHIRef_t InVertexDeclaration, VertexShaderRHIRef_t InVertexShader, PixelShaderRHIRef_t InPixelShader, HullShaderRHIRef_t InHullShader, DomainShaderRHIRef_t InDomainShader, GeometryShaderRHIRef_t InGeometryShader )
+	: CBaseBoundShaderStateRHI( InKey, InVertexDeclaration, InVertexShader, InPixelShader, InHullShader, InDomainShader, InGeometryShader )
+{}
+
+/*
+==================
+CNullBoundShaderStateRHI::~CNullBoundShaderStateRHI
+==================
+*/
+CNullBoundShaderStateRHI::~CNullBoundShaderStateRHI()
+{
+	CNullRHI*		rhi = ( CNullRHI* )g_RHI;
+	Assert( rhi );
+	rhi->GetBoundShaderStateHistory().Remove( key );
+}
+
+/*
+==================
+CNullSurfaceRHI::CNullSurfaceRHI
+==================
+*/
+CNullSurfaceRHI::CNullSurfaceRHI( uint32 InSizeX, uint32 InSizeY, Texture2DRHIParamRef_t InResolveTargetTexture /* = nullptr */ )
+	: sizeX( InSizeX )
+	, sizeY( InSizeY )
+	, resolveTargetTexture( InResolveTargetTexture )
+{}
+
+/*
+==================
+CNullViewportRHI::CNullViewportRHI
+==================
+*/
+CNullViewportRHI::CNullViewportRHI( WindowHandle_t InWindowHandle, SurfaceRHIParamRef_t InSurfaceRHI, uint32 InWidth, uint32 InHeight )
+	: bBackBuffer( !InSurfaceRHI )
+	, windowHandle( InWindowHandle )
+	, width( InWidth )
+	, height( InHeight )
+	, surface( InSurfaceRHI )
+{
+	if ( bBackBuffer )
+	{
+		surface = new CNullSurfaceRHI( width, height );
+	}
+}
+
+/*
+==================
+CNullViewportRHI::Resize
+==================
+*/
+void CNullViewportRHI::Resize( uint32 InWidth, uint32 InHeight )
+{
+	width	= InWidth;
+	height	= InHeight;
+	if ( bBackBuffer )
+	{
+		surface = new CNullSurfaceRHI( width, height );
+	}
+}
+
+/*
+==================
+CNullViewportRHI::SetSurface
+==================
+*/
+void CNullViewportRHI::SetSurface( SurfaceRHIParamRef_t InSurfaceRHI )
+{
+	bBackBuffer = !InSurfaceRHI;
+	surface		= bBackBuffer ? new CNullSurfaceRHI( width, height ) : InSurfaceRHI;
+}
+
+/*
+==================
+CNullViewportRHI::GetWidth
+==================
+*/
+uint32 CNullViewportRHI::GetWidth() const
+{
+	return width;
+}
+
+/*
+==================
+CNullViewportRHI::GetHeight
+==================
+*/
+uint32 CNullViewportRHI::GetHeight() const
+{
+	return height;
+}
+
+/*
+==================
+CNullViewportRHI::GetSurface
+==================
+*/
+SurfaceRHIRef_t CNullViewportRHI::GetSurface() const
+{
+	return surface;
+}
+
+/*
+==================
+CNullViewportRHI::GetWindowHandle
+==================
+*/
+WindowHandle_t CNullViewportRHI::GetWindowHandle() const
+{
+	return windowHandle;
+}
+
+/*
+==================
+CNullDeviceContextRHI::CNullDeviceContextRHI
+==================
+*/
+CNullDeviceContextRHI::CNullDeviceContextRHI( CNullCommandList* InCommandList )
+	: commandList( InCommandList )
+{}
+
+/*
+==================
+CNullDeviceContextRHI::ClearSurface
+==================
+*/
+void CNullDeviceContextRHI::ClearSurface( SurfaceRHIParamRef_t InSurface, const class CColor& InColor )
+{
+	commandList->AddCommand( NRC_Clear, 0 );
+}
+
+/*
+==================
+CNullDeviceContextRHI::ClearDepthStencil
+==================
+*/
+void CNullDeviceContextRHI::ClearDepthStencil( SurfaceRHIParamRef_t InSurface, bool InIsClearDepth /* = true */, bool InIsClearStencil /* = true */, float InDepthValue /* = 1.f */, uint8 InStencilValue /* = 0 */ )
+{
+	commandList->AddCommand( NRC_Clear, 1 );
+}
\ No newline at end of file
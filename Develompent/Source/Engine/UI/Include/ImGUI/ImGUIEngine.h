@@ -697,6 +697,11 @@ private:
 	 */
 	void InitTheme();
 
+	/**
+	 * @brief Draw overlay of visible stat groups (see 'stat' console command)
+	 */
+	void DrawStats();
+
 	bool										bShowCursor;			/**< Is need show cursor */
 	struct ImGuiContext*						imguiContext;			/**< Pointer to ImGUI context */
 	ImVec4										styleColors[IGC_Num];	/**< ImGui style colors */
@@ -7,6 +7,7 @@
 #include "Core.h"
 #include "Containers/StringConv.h"
 #include "Misc/EngineGlobals.h"
+#include "Misc/Stats.h"
 #include "Logger/BaseLogger.h"
 #include "Logger/LoggerMacros.h"
 #include "RHI/BaseRHI.h"
@@ -761,6 +762,12 @@ void CImGUIEngine::EndDraw()
 		layersOnTick[index]->Tick();
 	}
 
+	// Draw stats overlay if any stat group is visible
+	if ( g_StatManager.IsAnyGroupVisible() )
+	{
+		DrawStats();
+	}
+
 	// Draw debug window of the ImGUI if it need
 #if !SHIPPING_BUILD
 	if ( CVarImGUIDebug.GetValueBool() )
@@ -790,4 +797,58 @@ void CImGUIEngine::EndDraw()
 	lockedTextures.clear();
 }
 
+/*
+==================
+CImGUIEngine::DrawStats
+==================
+*/
+void CImGUIEngine::DrawStats()
+{
+	const ImGuiViewport*	mainViewport = ImGui::GetMainViewport();
+	ImGui::SetNextWindowPos( ImVec2( mainViewport->WorkPos.x + 10.f, mainViewport->WorkPos.y + 10.f ), ImGuiCond_Always );
+	ImGui::SetNextWindowBgAlpha( 0.5f );
+	if ( ImGui::Begin( "##Stats", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav ) )
+	{
+		// FPS
+		if ( g_StatManager.IsGroupVisible( SG_FPS ) )
+		{
+			const double	averageFrameTime = g_StatManager.GetAverageFrameTime();
+			ImGui::Text( "FPS: %.1f (%.2f ms)", averageFrameTime > 0.0 ? 1.0 / averageFrameTime : 0.0, averageFrameTime * 1000.0 );
+			ImGui::Text( "Min: %.2f ms, Max: %.2f ms", g_StatManager.GetMinFrameTime() * 1000.0, g_StatManager.GetMaxFrameTime() * 1000.0 );
+		}
+
+		// Counters
+		const std::vector<CStatCounter*>&		counters = GetGlobalStatCounters();
+		for ( uint32 group = SG_Scene; group < SG_Num; ++group )
+		{
+			if ( !g_StatManager.IsGroupVisible( ( EStatGroup )group ) )
+			{
+				continue;
+			}
+
+			ImGui::Separator();
+			ImGui::TextUnformatted( TCHAR_TO_ANSI( CStatManager::GetGroupName( ( EStatGroup )group ) ) );
+			for ( uint32 index = 0, count = counters.size(); index < count; ++index )
+			{
+				const CStatCounter*		counter = counters[index];
+				if ( counter->GetGroup() != group )
+				{
+					continue;
+				}
+
+				// Memory counters is shown in megabytes
+				if ( group == SG_Memory )
+				{
+					ImGui::Text( "%s: %.2f MB", TCHAR_TO_ANSI( counter->GetName() ), counter->GetLastValue() / ( 1024.0 * 1024.0 ) );
+				}
+				else
+				{
+					ImGui::Text( "%s: %lld (avg %.1f, max %lld)", TCHAR_TO_ANSI( counter->GetName() ), counter->GetLastValue(), counter->GetAverage(), counter->GetMax() );
+				}
+			}
+		}
+	}
+	ImGui::End();
+}
+
 #endif // WITH_IMGUI
\ No newline at end of file
@@ -22,6 +22,8 @@
 #include "Render/Shaders/ShaderCompiler.h"
 #include "System/AudioBank.h"
 #include "System/PhysicsMaterial.h"
+#include "System/TextureCompressor.h"
+#include "System/TextureAtlasBuilder.h"
 
 /**
  * @ingroup WorldEd
@@ -35,6 +37,7 @@ struct TMXTileset
 	Vector2D						tileOffset;		/**< Offset of tile */
 	TAssetHandle<CMaterial>			material;		/**< Material of tileset */
 	std::vector< RectFloat_t >		textureRects;	/**< Array of rects with tiles */
+	std::vector< TAssetHandle<CMaterial> >	tileMaterials;	/**< Materials of tiles after packing to atlas. If empty all tiles use material of tileset */
 };
 
  /**
@@ -334,6 +337,16 @@ private:
 	 */
 	bool LoadTMXTilests( const tmx::Map& InTMXMap, std::vector< TMXTileset >& OutTilesets );
 
+	/**
+	 * @brief Pack tiles of tilesets to shared atlases
+	 * Tilesets which materials are different only by texture are packed together, texture rects and materials of tiles are remapped to atlas
+	 *
+	 * @param InMapInfo Info about map
+	 * @param InOutTilesets Array of tilesets
+	 * @return Return true if seccussed, else returning false
+	 */
+	bool BuildTilesetAtlases( const ResourceInfo& InMapInfo, std::vector< TMXTileset >& InOutTilesets );
+
 	/**
 	 * @brief Spawn tiles in world
 	 * 
@@ -404,6 +417,14 @@ private:
 	 */
 	bool CookTexture2D( const ResourceInfo& InTexture2DInfo, TAssetHandle<CTexture2D>& OutTexture2D );
 
+	/**
+	 * Compress texture 2D and add it to total statistics
+	 *
+	 * @param InTexture2D Texture
+	 * @param InUsage Usage of texture
+	 */
+	void CompressTexture2D( CTexture2D* InTexture2D, ETextureUsage InUsage );
+
 	/**
 	 * Cook audio bank
 	 * 
@@ -477,6 +498,9 @@ private:
 	CShaderCache											shaderCache;			/**< Cooked shader cache */
 	EShaderPlatform											cookedShaderPlatform;	/**< Cooked shader platform */
 	EPlatformType											cookedPlatform;			/**< Cooked platform */
+	CTextureCompressor										textureCompressor;		/**< Block compressor of textures */
+	TextureCompressionStats									textureCompressionStats;	/**< Total statistics of texture compression */
+	CTextureAtlasBuilder									atlasBuilder;			/**< Builder of tileset atlases */
 };
 
 #endif // !COOKPACKAGESCOMMANDLET_H
\ No newline at end of file
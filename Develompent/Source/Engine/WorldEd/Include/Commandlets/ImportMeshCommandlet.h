@@ -76,9 +76,11 @@ public:
 	 *
 	 * @param InPath Path to mesh
 	 * @param InAssetName Asset name for new mesh
+	 * @param InVertexFormat Vertex format in GPU memory
+	 * @param InNumLODs Number of LODs to generate (include full resolution mesh)
 	 * @return Return converted static mesh, if failed returning false
 	 */
-	TSharedPtr<CStaticMesh> ConvertStaticMesh( const std::wstring& InPath, const std::wstring& InAssetName );
+	TSharedPtr<CStaticMesh> ConvertStaticMesh( const std::wstring& InPath, const std::wstring& InAssetName, EStaticMeshVertexFormat InVertexFormat = SMVF_Default, uint32 InNumLODs = STATICMESH_DEFAULT_NUM_LODS );
 
 	/**
 	 * Get supported meshes extensions
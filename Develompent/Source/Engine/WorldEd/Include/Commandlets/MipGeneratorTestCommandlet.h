@@ -0,0 +1,58 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef MIPGENERATORTESTCOMMANDLET_H
+#define MIPGENERATORTESTCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for test and benchmark mip generator
+ *
+ * Output of CMipGenerator is compared with scalar reference implementation in double precision
+ */
+class CMipGeneratorTestCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CMipGeneratorTestCommandlet, CBaseCommandlet, 0, 0 )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+
+private:
+	/**
+	 * Compare box and Kaiser filters with sRGB and premultiplied alpha against reference implementation
+	 * @return Return TRUE if all mips match reference, otherwise will return FALSE
+	 */
+	bool TestReference();
+
+	/**
+	 * Test that the last column and row of source with odd size are filtered into mip
+	 * @return Return TRUE if test is passed, otherwise will return FALSE
+	 */
+	bool TestOddDimensions();
+
+	/**
+	 * Test that coverage of alpha test is preserved in mips
+	 * @return Return TRUE if test is passed, otherwise will return FALSE
+	 */
+	bool TestAlphaCoverage();
+
+	/**
+	 * Measure time of mip chain generation for 4096x4096 image
+	 */
+	void Benchmark();
+};
+
+#endif // !MIPGENERATORTESTCOMMANDLET_H
\ No newline at end of file
@@ -0,0 +1,64 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef NULLRHITESTCOMMANDLET_H
+#define NULLRHITESTCOMMANDLET_H
+
+#include <vector>
+
+#include "Commandlets/BaseCommandlet.h"
+#include "NullCommandList.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for test command stream recorded by null RHI
+ *
+ * Draws scripted frame by own instance of null RHI and compares recorded commands with expected ones
+ */
+class CNullRHITestCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CNullRHITestCommandlet, CBaseCommandlet, 0, 0 )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+
+private:
+	/**
+	 * Test that recorded stream and stats of scripted frame are the expected ones
+	 * @return Return TRUE if test is passed, otherwise will return FALSE
+	 */
+	bool TestRecordedStream();
+
+	/**
+	 * Test that hash of stream is the same for the same frame and differs when draw is changed
+	 * @return Return TRUE if test is passed, otherwise will return FALSE
+	 */
+	bool TestStreamHash();
+
+	/**
+	 * Test that without recording commands are counted but not stored
+	 * @return Return TRUE if test is passed, otherwise will return FALSE
+	 */
+	bool TestRecordingDisabled();
+
+	/**
+	 * Draw scripted frame
+	 *
+	 * @param InNullRHI			Null RHI
+	 * @param InNumPrimitives	Number of primitives in the second draw
+	 */
+	void DrawFrame( class CNullRHI& InNullRHI, uint32 InNumPrimitives );
+};
+
+#endif // !NULLRHITESTCOMMANDLET_H
\ No newline at end of file
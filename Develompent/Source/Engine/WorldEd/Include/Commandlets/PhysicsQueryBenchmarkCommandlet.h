@@ -0,0 +1,63 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef PHYSICSQUERYBENCHMARKCOMMANDLET_H
+#define PHYSICSQUERYBENCHMARKCOMMANDLET_H
+
+#include <vector>
+
+#include "Math/Math.h"
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for benchmark scene queries of physics
+ *
+ * Compares per-fixture traces (as scene did before queries through broadphase) with queries through Box2D dynamic tree
+ * on a scene of many static bodies, returns FALSE if they find different hits
+ */
+class CPhysicsQueryBenchmarkCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CPhysicsQueryBenchmarkCommandlet, CBaseCommandlet, 0, 0 )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+
+private:
+	/**
+	 * Benchmark line traces and check that the closest hit is found
+	 * @return Return TRUE if per-fixture and broadphase traces find the same hits, otherwise will return FALSE
+	 */
+	bool BenchmarkLineTraces();
+
+	/**
+	 * Benchmark AABB queries
+	 * @return Return TRUE if per-fixture and broadphase queries find the same fixtures, otherwise will return FALSE
+	 */
+	bool BenchmarkQueryAABB();
+
+	/**
+	 * Spawn static boxes of benchmark scene
+	 */
+	void SpawnBodies();
+
+	/**
+	 * Destroy bodies of benchmark scene
+	 */
+	void DestroyBodies();
+
+	std::vector< class CPhysicsBodyInstance* >	bodies;		/**< Bodies of benchmark scene */
+};
+
+#endif // !PHYSICSQUERYBENCHMARKCOMMANDLET_H
\ No newline at end of file
@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef PHYSICSTESTCOMMANDLET_H
+#define PHYSICSTESTCOMMANDLET_H
+
+#include <vector>
+
+#include "Math/Math.h"
+#include "Commandlets/BaseCommandlet.h"
+#include "System/PhysicsStateSnapshot.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for test determinism of physics simulation in headless mode
+ *
+ * Simulates the same test scene several times and compares the results of runs, returns FALSE if they are different
+ */
+class CPhysicsTestCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CPhysicsTestCommandlet, CBaseCommandlet, 0, 0 )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+
+private:
+	/**
+	 * Test that sequences of frame times with the same total time give identical trajectories of bodies
+	 * @return Return TRUE if all sequences give the same result, otherwise will return FALSE
+	 */
+	bool TestFrameTimeSequences();
+
+	/**
+	 * Test that the same sequence of spawns and inputs stepped by CPhysicsEngine::StepOnce gives the same state hash after every step
+	 * @return Return TRUE if both runs give the same hashes, otherwise will return FALSE
+	 */
+	bool TestLockstepReplay();
+
+	/**
+	 * Test that identical bodies share one cached body setup and it is removed from cache with the last body.
+	 * Time and memory of spawn are logged
+	 * @return Return TRUE if body setup is shared and released, otherwise will return FALSE
+	 */
+	bool TestSharedBodySetup();
+
+	/**
+	 * Simulate test scene in lockstep with spawn of body and impulses at fixed steps
+	 * @param OutStateHashes	Output hashes of physics state after each step
+	 */
+	void SimulateLockstep( std::vector< uint64 >& OutStateHashes );
+
+	/**
+	 * Simulate test scene by sequence of frame times
+	 *
+	 * @param InFrameTimes		Frame times in stepper ticks
+	 * @param OutNumSteps		Output number of simulated steps
+	 * @param OutTrajectory		Output hashes of bodies state after each step
+	 */
+	void SimulateFrameTimes( const std::vector< uint32 >& InFrameTimes, uint64& OutNumSteps, std::vector< uint64 >& OutTrajectory );
+
+	/**
+	 * Spawn bodies of test scene
+	 * @note Stepper is reset to state at start of commandlet, so each run begins from the same step
+	 */
+	void SpawnBodies();
+
+	/**
+	 * Spawn dynamic box
+	 *
+	 * @param InLocation	Location of box
+	 * @return Return spawned body of box
+	 */
+	class CPhysicsBodyInstance* SpawnBox( const Vector& InLocation );
+
+	/**
+	 * Destroy bodies of test scene
+	 */
+	void DestroyBodies();
+
+	/**
+	 * Calculate hash of state of test bodies
+	 * @return Return hash of state of test bodies
+	 */
+	uint64 CalcBodiesHash() const;
+
+	PhysicsStateSnapshot						initialState;	/**< State of physics at start of commandlet */
+	std::vector< class CPhysicsBodyInstance* >	bodies;			/**< Bodies of test scene */
+};
+
+#endif // !PHYSICSTESTCOMMANDLET_H
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TILEMAPBENCHMARKCOMMANDLET_H
+#define TILEMAPBENCHMARKCOMMANDLET_H
+
+#include <vector>
+
+#include "Math/Math.h"
+#include "Components/TileMapComponent.h"
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * @brief Tile of benchmark map
+ */
+struct TileMapBenchmarkTile
+{
+	uint32			layer;		/**< Index of layer */
+	uint32			x;			/**< Cell by X from left */
+	uint32			y;			/**< Cell by Y from bottom */
+	TileMapTile		tile;		/**< Material, texture rect and size of tile */
+};
+
+/**
+ * @ingroup WorldEd
+ * @brief Result of benchmark one way of spawn tiles
+ */
+struct TileMapBenchmarkResult
+{
+	/**
+	 * @brief Constructor
+	 */
+	TileMapBenchmarkResult()
+		: numActors( 0 )
+		, worldSize( 0 )
+		, spawnTime( 0.0 )
+		, loadTime( 0.0 )
+		, frameTime( 0.0 )
+	{}
+
+	uint32		numActors;		/**< Number of actors in world */
+	uint32		worldSize;		/**< Size of serialized world in bytes */
+	double		spawnTime;		/**< Time of spawn tiles in seconds */
+	double		loadTime;		/**< Time of load world from memory and begin play in seconds */
+	double		frameTime;		/**< Average time of frame (world tick and build view) in seconds */
+};
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for benchmark tile map component
+ *
+ * Spawns the same map as actor per tile (as cooker did before CTileMapComponent) and as one tile map,
+ * then compares time of load and time of frame. Map is loaded from TMX by -map=<path>, otherwise square map of -size=<cells> is generated
+ */
+class CTileMapBenchmarkCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CTileMapBenchmarkCommandlet, CBaseCommandlet, 0, 0 )
+
+public:
+	/**
+	 * Constructor
+	 */
+	CTileMapBenchmarkCommandlet();
+
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+
+private:
+	/**
+	 * Load tiles from TMX map
+	 *
+	 * @param InPath	Path to TMX map
+	 * @return Return TRUE if map is loaded, otherwise will return FALSE
+	 */
+	bool LoadTMXMap( const std::wstring& InPath );
+
+	/**
+	 * Generate square map with one filled layer
+	 * @param InSize	Number of cells by X and Y
+	 */
+	void GenerateMap( uint32 InSize );
+
+	/**
+	 * Benchmark one way of spawn tiles
+	 *
+	 * @param InIsTileMap	Is need spawn tiles in one tile map, otherwise every tile is own sprite actor
+	 * @return Return result of benchmark
+	 */
+	TileMapBenchmarkResult Benchmark( bool InIsTileMap );
+
+	/**
+	 * Spawn every tile as own sprite actor
+	 */
+	void SpawnTileActors();
+
+	/**
+	 * Spawn all tiles in one tile map actor
+	 */
+	void SpawnTileMap();
+
+	uint32									sizeX;			/**< Number of cells by X */
+	uint32									sizeY;			/**< Number of cells by Y */
+	Vector2D								cellSize;		/**< Size of cell */
+	std::vector< float >					layerDepths;	/**< Depth of every layer */
+	std::vector< TileMapBenchmarkTile >		tiles;			/**< Tiles of map */
+};
+
+#endif // !TILEMAPBENCHMARKCOMMANDLET_H
\ No newline at end of file
@@ -0,0 +1,57 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef UPLOADRINGTESTCOMMANDLET_H
+#define UPLOADRINGTESTCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for test upload ring allocator on CPU, without any RHI
+ */
+class CUploadRingTestCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CUploadRingTestCommandlet, CBaseCommandlet, 0, 0 )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+
+private:
+	/**
+	 * Test alignment of allocations and discard of the first allocation
+	 * @return Return TRUE if test is passed, otherwise will return FALSE
+	 */
+	bool TestAlignment();
+
+	/**
+	 * Test wrap around to start of ring when retired frames are at start
+	 * @return Return TRUE if test is passed, otherwise will return FALSE
+	 */
+	bool TestWrapAround();
+
+	/**
+	 * Test that memory of frames is reused only after they are retired
+	 * @return Return TRUE if test is passed, otherwise will return FALSE
+	 */
+	bool TestRetire();
+
+	/**
+	 * Test random allocations with random GPU latency, allocation must never overlap memory of frames not retired yet
+	 * @return Return TRUE if test is passed, otherwise will return FALSE
+	 */
+	bool TestRandomLatency();
+};
+
+#endif // !UPLOADRINGTESTCOMMANDLET_H
\ No newline at end of file
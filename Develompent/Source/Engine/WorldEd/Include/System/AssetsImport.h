@@ -228,6 +228,29 @@ private:
 	 */
 	static bool ParseMeshes( const std::wstring& InPath, std::vector<MeshData>& OutResult, std::wstring& OutError );
 
+	/**
+	 * @brief Optimize mesh for GPU if it's enabled in import settings
+	 * Statistics of optimization are printed to log
+	 *
+	 * @param InMeshName		Mesh name
+	 * @param InOutVerteces		Array of mesh verteces
+	 * @param InOutIndeces		Array of mesh indeces
+	 * @param InSurfaces		Array of mesh surfaces
+	 */
+	static void OptimizeMesh( const std::wstring& InMeshName, std::vector<StaticMeshVertexType>& InOutVerteces, std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshSurface>& InSurfaces );
+
+	/**
+	 * @brief Generate LODs of mesh by number of LODs in import settings
+	 * LODs are printed to log
+	 *
+	 * @param InMeshName		Mesh name
+	 * @param InVerteces		Array of mesh verteces
+	 * @param InOutIndeces		Array of mesh indeces, indeces of LODs are appended to it
+	 * @param InSurfaces		Array of mesh surfaces
+	 * @param OutLODs			Output array of LODs
+	 */
+	static void GenerateLODs( const std::wstring& InMeshName, const std::vector<StaticMeshVertexType>& InVerteces, std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshSurface>& InSurfaces, std::vector<StaticMeshLOD>& OutLODs );
+
 	/**
 	 * @brief Change axis up in vector
 	 *
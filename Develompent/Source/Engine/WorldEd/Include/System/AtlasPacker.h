@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @addtogroup WorldEd WorldEd
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef ATLASPACKER_H
+#define ATLASPACKER_H
+
+#include <vector>
+
+#include "Core.h"
+#include "Math/Rect.h"
+
+/**
+ * @ingroup WorldEd
+ * @brief Rectangle packer for texture atlases
+ *
+ * Uses MaxRects algorithm with Best Short Side Fit heuristic: packer keeps list of maximal free
+ * rectangles, new rectangle is placed to free rectangle where the smaller leftover side is minimal
+ */
+class CAtlasPacker
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CAtlasPacker();
+
+	/**
+	 * @brief Initialize packer
+	 *
+	 * @param InSizeX	Width of atlas
+	 * @param InSizeY	Height of atlas
+	 */
+	void Init( uint32 InSizeX, uint32 InSizeY );
+
+	/**
+	 * @brief Insert rectangle to atlas
+	 *
+	 * @param InSizeX	Width of rectangle
+	 * @param InSizeY	Height of rectangle
+	 * @param OutRect	Output placed rectangle
+	 * @return Return TRUE if rectangle is placed, otherwise returning FALSE when no free space
+	 */
+	bool Insert( uint32 InSizeX, uint32 InSizeY, RectInt32_t& OutRect );
+
+	/**
+	 * @brief Get width of atlas
+	 * @return Return width of atlas
+	 */
+	FORCEINLINE uint32 GetSizeX() const
+	{
+		return sizeX;
+	}
+
+	/**
+	 * @brief Get height of atlas
+	 * @return Return height of atlas
+	 */
+	FORCEINLINE uint32 GetSizeY() const
+	{
+		return sizeY;
+	}
+
+	/**
+	 * @brief Get used width of atlas
+	 * @return Return right border of placed rectangles
+	 */
+	FORCEINLINE uint32 GetUsedSizeX() const
+	{
+		return usedSizeX;
+	}
+
+	/**
+	 * @brief Get used height of atlas
+	 * @return Return bottom border of placed rectangles
+	 */
+	FORCEINLINE uint32 GetUsedSizeY() const
+	{
+		return usedSizeY;
+	}
+
+	/**
+	 * @brief Get used area of atlas
+	 * @return Return sum of areas of placed rectangles
+	 */
+	FORCEINLINE uint64 GetUsedArea() const
+	{
+		return usedArea;
+	}
+
+private:
+	/**
+	 * @brief Split free rectangle by used rectangle
+	 *
+	 * @param InFreeRect	Free rectangle
+	 * @param InUsedRect	Used rectangle
+	 * @return Return TRUE if free rectangle is intersected with used rectangle and it must be removed
+	 */
+	bool SplitFreeRect( const RectInt32_t& InFreeRect, const RectInt32_t& InUsedRect );
+
+	/**
+	 * @brief Remove free rectangles which are contained in other free rectangles
+	 */
+	void PruneFreeRects();
+
+	uint32						sizeX;			/**< Width of atlas */
+	uint32						sizeY;			/**< Height of atlas */
+	uint32						usedSizeX;		/**< Right border of placed rectangles */
+	uint32						usedSizeY;		/**< Bottom border of placed rectangles */
+	uint64						usedArea;		/**< Sum of areas of placed rectangles */
+	std::vector<RectInt32_t>	freeRects;		/**< Maximal free rectangles */
+};
+
+#endif // !ATLASPACKER_H
\ No newline at end of file
@@ -0,0 +1,209 @@
+/**
+ * @file
+ * @addtogroup WorldEd WorldEd
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TEXTUREATLASBUILDER_H
+#define TEXTUREATLASBUILDER_H
+
+#include <vector>
+
+#include "Core.h"
+#include "Math/Rect.h"
+#include "Misc/Types.h"
+#include "Misc/Template.h"
+
+/**
+ * @ingroup WorldEd
+ * @brief Default max size of atlas page
+ */
+#define TEXTUREATLAS_DEFAULT_MAX_SIZE		2048
+
+/**
+ * @ingroup WorldEd
+ * @brief Default padding around every image in atlas (in texels)
+ */
+#define TEXTUREATLAS_DEFAULT_PADDING		4
+
+/**
+ * @ingroup WorldEd
+ * @brief Min size of atlas page, must be multiple of block size of compressed formats
+ */
+#define TEXTUREATLAS_MIN_SIZE				4
+
+/**
+ * @ingroup WorldEd
+ * @brief Page of texture atlas
+ */
+struct TextureAtlasPage
+{
+	/**
+	 * @brief Constructor
+	 */
+	TextureAtlasPage()
+		: sizeX( 0 )
+		, sizeY( 0 )
+		, usedArea( 0 )
+	{}
+
+	/**
+	 * @brief Get occupancy of page
+	 * @return Return part of page which is covered by images (without padding)
+	 */
+	FORCEINLINE float GetOccupancy() const
+	{
+		return sizeX > 0 && sizeY > 0 ? ( float )usedArea / ( ( uint64 )sizeX * sizeY ) : 0.f;
+	}
+
+	uint32				sizeX;		/**< Width of page */
+	uint32				sizeY;		/**< Height of page */
+	uint64				usedArea;	/**< Area of images without padding */
+	std::vector<byte>	texels;		/**< Texels in RGBA8 format */
+};
+
+/**
+ * @ingroup WorldEd
+ * @brief Placement of image in atlas
+ */
+struct TextureAtlasEntry
+{
+	uint32				pageIndex;		/**< Index of page */
+	RectFloat_t			textureRect;	/**< Texture rect of image in page (in range from 0 to 1) */
+};
+
+/**
+ * @ingroup WorldEd
+ * @brief Builder of texture atlases for cooker
+ *
+ * Images are packed by MaxRects to pages with power of two size. Every image is surrounded by padding
+ * filled with its edge texels (extrusion), and placements are aligned so that box filtered mips don't
+ * mix texels of neighboring images. Number of such mips is limited by padding
+ */
+class CTextureAtlasBuilder
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTextureAtlasBuilder();
+
+	/**
+	 * @brief Initialize builder
+	 * Reads settings from config (Editor.CookPackages:Atlas)
+	 */
+	void Init();
+
+	/**
+	 * @brief Remove all images and pages
+	 */
+	void Reset();
+
+	/**
+	 * @brief Add image to atlas
+	 * @note Image must fit to atlas (see IsFit)
+	 *
+	 * @param InTexels		Texels of source image in RGBA8 format
+	 * @param InSizeX		Width of source image
+	 * @param InRect		Rect of image in source image (in texels)
+	 * @return Return index of image
+	 */
+	uint32 AddImage( const byte* InTexels, uint32 InSizeX, const RectInt32_t& InRect );
+
+	/**
+	 * @brief Pack all added images to pages
+	 */
+	void Build();
+
+	/**
+	 * @brief Is image fit to atlas
+	 *
+	 * @param InSizeX	Width of image
+	 * @param InSizeY	Height of image
+	 * @return Return TRUE if image with padding isn't bigger than page
+	 */
+	bool IsFit( uint32 InSizeX, uint32 InSizeY ) const;
+
+	/**
+	 * @brief Is atlas building enabled
+	 * @return Return TRUE if atlas building is enabled, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	/**
+	 * @brief Get number of mips which can be generated without bleeding
+	 * @return Return number of mips (include top mip)
+	 */
+	FORCEINLINE uint32 GetNumMips() const
+	{
+		return numMips;
+	}
+
+	/**
+	 * @brief Get pages
+	 * @return Return array of pages
+	 */
+	FORCEINLINE const std::vector<TextureAtlasPage>& GetPages() const
+	{
+		return pages;
+	}
+
+	/**
+	 * @brief Get placement of image
+	 *
+	 * @param InImageIndex	Index of image
+	 * @return Return placement of image in atlas
+	 */
+	FORCEINLINE const TextureAtlasEntry& GetEntry( uint32 InImageIndex ) const
+	{
+		Assert( InImageIndex < entries.size() );
+		return entries[InImageIndex];
+	}
+
+private:
+	/**
+	 * @brief Image in atlas
+	 */
+	struct Image
+	{
+		uint32				sizeX;		/**< Width */
+		uint32				sizeY;		/**< Height */
+		std::vector<byte>	texels;		/**< Texels in RGBA8 format */
+	};
+
+	/**
+	 * @brief Get size of image with padding and alignment
+	 *
+	 * @param InSize	Size of image
+	 * @return Return size of image in atlas
+	 */
+	FORCEINLINE uint32 GetPaddedSize( uint32 InSize ) const
+	{
+		return Align( InSize + padding * 2, alignment );
+	}
+
+	/**
+	 * @brief Copy image to page with extrusion of edges to padding
+	 *
+	 * @param InImage		Image
+	 * @param InRect		Rect of image with padding in page
+	 * @param InOutPage		Page
+	 */
+	void BlitImage( const Image& InImage, const RectInt32_t& InRect, TextureAtlasPage& InOutPage ) const;
+
+	bool								bEnabled;		/**< Is atlas building enabled */
+	uint32								maxSize;		/**< Max size of page */
+	uint32								padding;		/**< Padding around every image */
+	uint32								alignment;		/**< Alignment of placements */
+	uint32								numMips;		/**< Number of mips without bleeding */
+	std::vector<Image>					images;			/**< Added images */
+	std::vector<TextureAtlasEntry>		entries;		/**< Placements of images */
+	std::vector<TextureAtlasPage>		pages;			/**< Pages of atlas */
+};
+
+#endif // !TEXTUREATLASBUILDER_H
\ No newline at end of file
@@ -0,0 +1,236 @@
+/**
+ * @file
+ * @addtogroup WorldEd WorldEd
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TEXTURECOMPRESSOR_H
+#define TEXTURECOMPRESSOR_H
+
+#include <string>
+#include <vector>
+
+#include "Render/Texture.h"
+
+/**
+ * @ingroup WorldEd
+ * @brief Version of texture compressor. Increase it when output of compressor is changed, it invalidates cache
+ */
+#define TEXTURECOMPRESSOR_VERSION				1
+
+/**
+ * @ingroup WorldEd
+ * @brief Number of block rows in one job of compression
+ */
+#define TEXTURECOMPRESSOR_JOB_NUM_BLOCK_ROWS	4
+
+/**
+ * @ingroup WorldEd
+ * @brief Extension of files in texture cache
+ */
+#define TEXTURECOMPRESSOR_CACHE_EXTENSION		TEXT( "ltc" )
+
+/**
+ * @ingroup WorldEd
+ * @brief Default directory of texture cache (relative to base directory)
+ */
+#define TEXTURECOMPRESSOR_DEFAULT_CACHE_DIR		TEXT( "Intermediate" ) PATH_SEPARATOR TEXT( "TextureCache" )
+
+/**
+ * @ingroup WorldEd
+ * @brief Enumeration of texture usages, it select format of compression
+ */
+enum ETextureUsage
+{
+	TU_Auto,			/**< Color or color with alpha, it selected by alpha channel of texture */
+	TU_Color,			/**< Color without alpha (BC1, BC7 with high quality) */
+	TU_ColorAlpha,		/**< Color with alpha (BC3, BC7 with high quality) */
+	TU_NormalMap,		/**< Tangent space normal map, only XY is stored (BC5) */
+	TU_Mask,			/**< Single channel mask (BC4) */
+	TU_Uncompressed,	/**< Texture isn't compressed */
+	TU_Max				/**< Num of texture usages */
+};
+
+/**
+ * @ingroup WorldEd
+ * @brief Enumeration of compression quality presets
+ */
+enum ETextureCompressionQuality
+{
+	TCQ_Fast,			/**< Fastest compression with lower quality */
+	TCQ_Normal,			/**< Balance between quality and speed */
+	TCQ_High,			/**< Highest quality, color textures use BC7 */
+	TCQ_Max				/**< Num of quality presets */
+};
+
+/**
+ * @ingroup WorldEd
+ * @brief Statistics of texture compression
+ */
+struct TextureCompressionStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	TextureCompressionStats()
+		: pixelFormat( PF_Unknown )
+		, encodeTime( 0.0 )
+		, numBytesBefore( 0 )
+		, numBytesAfter( 0 )
+		, bCached( false )
+	{}
+
+	/**
+	 * @brief Get compression ratio
+	 * @return Return ratio of size before compression to size after
+	 */
+	FORCEINLINE float GetRatio() const
+	{
+		return numBytesAfter > 0 ? ( float )numBytesBefore / numBytesAfter : 1.f;
+	}
+
+	EPixelFormat	pixelFormat;		/**< Pixel format after compression */
+	double			encodeTime;			/**< Time of compression in seconds */
+	uint64			numBytesBefore;		/**< Size of mips before compression */
+	uint64			numBytesAfter;		/**< Size of mips after compression */
+	bool			bCached;			/**< Is result taken from cache */
+};
+
+/**
+ * @ingroup WorldEd
+ * @brief Block compressor of textures for cooker
+ *
+ * Every mip is split to jobs by rows of 4x4 blocks which are encoded in parallel on thread pool.
+ * Results are cached on disk by hash of source texels, usage, quality and compressor version
+ */
+class CTextureCompressor
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTextureCompressor();
+
+	/**
+	 * @brief Initialize compressor
+	 * Reads settings from config (Editor.CookPackages:TextureCompression)
+	 *
+	 * @param InQualityOverride		Name of quality preset which overrides config, empty if not used
+	 */
+	void Init( const std::wstring& InQualityOverride = TEXT( "" ) );
+
+	/**
+	 * @brief Get usage of texture by sufix of name
+	 *
+	 * @param InTextureName		Name of texture
+	 * @return Return usage of texture, TU_Auto if no sufix is matched
+	 */
+	ETextureUsage GetUsageByName( const std::wstring& InTextureName ) const;
+
+	/**
+	 * @brief Compress texture
+	 * @note Texture must be in PF_A8R8G8B8 format, else it will be skipped
+	 *
+	 * @param InOutTexture		Texture
+	 * @param InUsage			Usage of texture
+	 * @param OutStats			Output statistics of compression
+	 * @return Return TRUE if texture is compressed, otherwise returning FALSE
+	 */
+	bool Compress( CTexture2D* InOutTexture, ETextureUsage InUsage, TextureCompressionStats& OutStats );
+
+	/**
+	 * @brief Get pixel format for usage
+	 *
+	 * @param InUsage		Usage of texture, must not be TU_Auto
+	 * @param InQuality		Quality preset
+	 * @return Return pixel format of compressed texture
+	 */
+	static EPixelFormat GetPixelFormat( ETextureUsage InUsage, ETextureCompressionQuality InQuality );
+
+	/**
+	 * @brief Detect usage of color texture by alpha channel
+	 *
+	 * @param InMip		Mip in PF_A8R8G8B8 format
+	 * @return Return TU_ColorAlpha if texture has not opaque texels, otherwise returning TU_Color
+	 */
+	static ETextureUsage DetectColorUsage( const Texture2DMipMap& InMip );
+
+	/**
+	 * @brief Print statistics of compression to log
+	 *
+	 * @param InTextureName		Name of texture
+	 * @param InStats			Statistics of compression
+	 */
+	static void LogStats( const std::wstring& InTextureName, const TextureCompressionStats& InStats );
+
+	/**
+	 * @brief Is compression enabled
+	 * @return Return TRUE if compression is enabled, otherwise returning FALSE
+	 */
+	FORCEINLINE bool IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	/**
+	 * @brief Get quality preset
+	 * @return Return quality preset
+	 */
+	FORCEINLINE ETextureCompressionQuality GetQuality() const
+	{
+		return quality;
+	}
+
+private:
+	/**
+	 * @brief Compress one mip
+	 *
+	 * @param InMip				Source mip in PF_A8R8G8B8 format
+	 * @param InPixelFormat		Compressed pixel format
+	 * @param OutMip			Output compressed mip
+	 */
+	void CompressMip( const Texture2DMipMap& InMip, EPixelFormat InPixelFormat, Texture2DMipMap& OutMip ) const;
+
+	/**
+	 * @brief Calculate key of texture in cache
+	 *
+	 * @param InMips			Source mips
+	 * @param InPixelFormat		Compressed pixel format
+	 * @return Return key of texture in cache
+	 */
+	uint64 CalcCacheKey( const std::vector<Texture2DMipMap>& InMips, EPixelFormat InPixelFormat ) const;
+
+	/**
+	 * @brief Get path to file in cache
+	 *
+	 * @param InKey		Key of texture in cache
+	 * @return Return path to file in cache
+	 */
+	std::wstring GetCachePath( uint64 InKey ) const;
+
+	/**
+	 * @brief Load compressed mips from cache
+	 *
+	 * @param InKey		Key of texture in cache
+	 * @param OutMips	Output compressed mips
+	 * @return Return TRUE if mips is found in cache, otherwise returning FALSE
+	 */
+	bool LoadFromCache( uint64 InKey, std::vector<Texture2DMipMap>& OutMips ) const;
+
+	/**
+	 * @brief Save compressed mips to cache
+	 *
+	 * @param InKey		Key of texture in cache
+	 * @param InMips	Compressed mips
+	 */
+	void SaveToCache( uint64 InKey, std::vector<Texture2DMipMap>& InMips ) const;
+
+	bool												bEnabled;			/**< Is compression enabled */
+	ETextureCompressionQuality							quality;			/**< Quality preset */
+	std::wstring										cacheDir;			/**< Directory of texture cache. Empty if cache is disabled */
+	std::vector<std::pair<std::wstring, ETextureUsage>>	usageSufixes;		/**< Sufixes of texture names and their usages */
+};
+
+#endif // !TEXTURECOMPRESSOR_H
\ No newline at end of file
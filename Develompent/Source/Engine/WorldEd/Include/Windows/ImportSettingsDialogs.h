@@ -12,6 +12,8 @@
 #include "ImGUI/ImGUIEngine.h"
 #include "System/Delegate.h"
 #include "System/Package.h"
+#include "Render/VertexFactory/StaticMeshVertexFactory.h"
+#include "Render/StaticMesh.h"
 
 /**
  * @ingroup WorldEd
@@ -47,10 +49,16 @@ public:
 		ImportSettings()
 			: bCombineMeshes( false )
 			, axisUp( AU_PlusY )
+			, vertexFormat( SMVF_Default )
+			, bOptimizeMesh( true )
+			, numLODs( STATICMESH_DEFAULT_NUM_LODS )
 		{}
 
-		bool		bCombineMeshes;		/**< Is need combine all meshes to one */
-		EAxisUp		axisUp;				/**< Axis up */
+		bool						bCombineMeshes;		/**< Is need combine all meshes to one */
+		EAxisUp						axisUp;				/**< Axis up */
+		EStaticMeshVertexFormat		vertexFormat;		/**< Vertex format in GPU memory */
+		bool						bOptimizeMesh;		/**< Is need optimize mesh for vertex cache, overdraw and vertex fetch */
+		uint32						numLODs;			/**< Number of LODs to generate (include full resolution mesh) */
 	};
 
 	/**
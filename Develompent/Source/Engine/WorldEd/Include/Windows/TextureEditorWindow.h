@@ -47,6 +47,7 @@ private:
 	CViewportWidget							viewportWidget;		/**< Viewport widget */
 	class CTexturePreviewViewportClient*	viewportClient;		/**< Viewport client */
 	uint32									currentMipmap;		/**< Current mipmap to view */
+	MipGenerationSettings					mipSettings;		/**< Settings of mipmaps generation */
 };
 
 #endif // !TEXTUREEDITORWINDOW_H
\ No newline at end of file
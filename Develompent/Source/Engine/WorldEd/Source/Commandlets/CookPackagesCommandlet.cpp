@@ -3,6 +3,7 @@
 #include <tmxlite/TileLayer.hpp>
 #include <tmxlite/Object.hpp>
 #include <vector>
+#include <algorithm>
 
 #include "Commandlets/CookPackagesCommandlet.h"
 #include "Containers/StringConv.h"
@@ -22,11 +23,12 @@
 
 // Actors
 #include "Actors/PlayerStart.h"
-#include "Actors/Sprite.h"
+#include "Actors/TileMap.h"
 
 // Vertex factories
 #include "Render/VertexFactory/StaticMeshVertexFactory.h"
 #include "Render/VertexFactory/SpriteVertexFactory.h"
+#include "Render/VertexFactory/SpriteBatchVertexFactory.h"
 
 IMPLEMENT_CLASS( CCookPackagesCommandlet )
 IMPLEMENT_DEFAULT_INITIALIZE_CLASS( CCookPackagesCommandlet )
@@ -69,6 +71,42 @@ FORCEINLINE std::wstring TMXPropertyTypeToText( tmx::Property::Type InTmxPropert
 	}
 }
 
+/*
+==================
+GetAtlasMaterialSignature
+==================
+*/
+static bool GetAtlasMaterialSignature( const TAssetHandle<CMaterial>& InMaterial, std::wstring& OutSignature )
+{
+	// Only materials with one texture can be packed to atlas
+	TSharedPtr<CMaterial>		material = InMaterial.ToSharedPtr();
+	if ( !material || material->GetTextureParameters().size() != 1 )
+	{
+		return false;
+	}
+
+	// Materials with the same signature are different only by texture
+	std::vector< std::wstring >		parameters;
+	for ( auto it = material->GetScalarParameters().begin(), itEnd = material->GetScalarParameters().end(); it != itEnd; ++it )
+	{
+		parameters.push_back( CString::Format( TEXT( "S:%s=%f" ), it->first.ToString().c_str(), it->second ) );
+	}
+
+	for ( auto it = material->GetVectorParameters().begin(), itEnd = material->GetVectorParameters().end(); it != itEnd; ++it )
+	{
+		parameters.push_back( CString::Format( TEXT( "V:%s=%f,%f,%f,%f" ), it->first.ToString().c_str(), it->second.x, it->second.y, it->second.z, it->second.w ) );
+	}
+	parameters.push_back( CString::Format( TEXT( "T:%s" ), material->GetTextureParameters().begin()->first.ToString().c_str() ) );
+	std::sort( parameters.begin(), parameters.end() );
+
+	OutSignature = CString::Format( TEXT( "%i;%i;%i;%i" ), material->IsTwoSided(), material->IsWireframe(), material->IsTranslucency(), material->GetUsageFlags() );
+	for ( uint32 index = 0, count = parameters.size(); index < count; ++index )
+	{
+		OutSignature += TEXT( ";" ) + parameters[ index ];
+	}
+	return true;
+}
+
 /*
 ==================
 CCookPackagesCommandlet::CCookPackagesCommandlet
@@ -110,6 +148,13 @@ bool CCookPackagesCommandlet::CookMap( const ResourceInfo& InMapInfo )
 		return false;
 	}
 
+	// Pack tilesets to atlases
+	if ( !BuildTilesetAtlases( InMapInfo, tilesets ) )
+	{
+		Sys_Errorf( TEXT( "Failed building atlases of TMX tilesets" ) );
+		return false;
+	}
+
 	// Clear world for spawn new actors
 	g_World->CleanupWorld();
 
@@ -226,12 +271,201 @@ bool CCookPackagesCommandlet::FindTileset( const std::vector<TMXTileset>& InTile
 
 		OutTileset		= tileset;
 		OutTextureRect	= tileset.textureRects[ InIDTile - tileset.firstGID ];
+		
+		// If tileset is packed to atlas, tiles can be placed on different pages
+		if ( !tileset.tileMaterials.empty() )
+		{
+			OutTileset.material = tileset.tileMaterials[ InIDTile - tileset.firstGID ];
+		}
 		return true;
 	}
 
 	return false;
 }
 
+/*
+==================
+CCookPackagesCommandlet::BuildTilesetAtlases
+==================
+*/
+bool CCookPackagesCommandlet::BuildTilesetAtlases( const ResourceInfo& InMapInfo, std::vector<TMXTileset>& InOutTilesets )
+{
+	if ( !atlasBuilder.IsEnabled() )
+	{
+		return true;
+	}
+
+	// Group tilesets which materials are different only by texture
+	std::vector< std::pair< std::wstring, std::vector< uint32 > > >		groups;
+	for ( uint32 index = 0, count = InOutTilesets.size(); index < count; ++index )
+	{
+		std::wstring		signature;
+		if ( !GetAtlasMaterialSignature( InOutTilesets[ index ].material, signature ) )
+		{
+			continue;
+		}
+
+		bool		bFound = false;
+		for ( uint32 indexGroup = 0, countGroups = groups.size(); indexGroup < countGroups && !bFound; ++indexGroup )
+		{
+			if ( groups[ indexGroup ].first == signature )
+			{
+				groups[ indexGroup ].second.push_back( index );
+				bFound = true;
+			}
+		}
+
+		if ( !bFound )
+		{
+			groups.push_back( std::make_pair( signature, std::vector< uint32 >{ index } ) );
+		}
+	}
+
+	ResourceInfo		atlasInfo;
+	atlasInfo.packageName	= InMapInfo.filename + TEXT( "_Atlases" );
+	atlasInfo.bAlwaysCook	= false;
+
+	uint32		numAtlases			= 0;
+	uint32		numPackedTilesets	= 0;
+	uint32		numPages			= 0;
+	for ( uint32 indexGroup = 0, countGroups = groups.size(); indexGroup < countGroups; ++indexGroup )
+	{
+		// Load source images of tilesets, cooked textures are already compressed
+		const std::vector< uint32 >&						groupTilesets = groups[ indexGroup ].second;
+		std::vector< std::pair< uint32, TSharedPtr<CTexture2D> > >	sources;
+		for ( uint32 index = 0, count = groupTilesets.size(); index < count; ++index )
+		{
+			const TMXTileset&			tileset		= InOutTilesets[ groupTilesets[ index ] ];
+			TSharedPtr<CTexture2D>		texture		= tileset.material.ToSharedPtr()->GetTextureParameters().begin()->second.ToSharedPtr();
+			TSharedPtr<CTexture2D>		source		= texture && !texture->GetAssetSourceFile().empty() ? ConvertTexture2D( texture->GetAssetSourceFile() ) : nullptr;
+			if ( !source || !atlasBuilder.IsFit( tileset.tileSize.x, tileset.tileSize.y ) )
+			{
+				Warnf( TEXT( "Tileset with material '%s' isn't packed to atlas\n" ), tileset.material.ToSharedPtr()->GetAssetName().c_str() );
+				continue;
+			}
+			sources.push_back( std::make_pair( groupTilesets[ index ], source ) );
+		}
+
+		// Nothing to batch if only one tileset uses the material
+		if ( sources.size() < 2 )
+		{
+			continue;
+		}
+
+		// Add tiles to atlas
+		std::vector< std::vector< uint32 > >		tileImages( sources.size() );
+		atlasBuilder.Reset();
+		for ( uint32 index = 0, count = sources.size(); index < count; ++index )
+		{
+			const TMXTileset&			tileset = InOutTilesets[ sources[ index ].first ];
+			const Texture2DMipMap&		mip0	= sources[ index ].second->GetMip( 0 );
+			for ( uint32 indexTile = 0, countTiles = tileset.textureRects.size(); indexTile < countTiles; ++indexTile )
+			{
+				const RectFloat_t&		textureRect = tileset.textureRects[ indexTile ];
+				RectInt32_t				tileRect;
+				tileRect.left			= ( int32 )( textureRect.left * mip0.sizeX + 0.5f );
+				tileRect.top			= ( int32 )( textureRect.top * mip0.sizeY + 0.5f );
+				tileRect.width			= Min<int32>( ( int32 )( textureRect.width * mip0.sizeX + 0.5f ), mip0.sizeX - tileRect.left );
+				tileRect.height			= Min<int32>( ( int32 )( textureRect.height * mip0.sizeY + 0.5f ), mip0.sizeY - tileRect.top );
+				tileImages[ index ].push_back( atlasBuilder.AddImage( mip0.data.GetData(), mip0.sizeX, tileRect ) );
+			}
+		}
+		atlasBuilder.Build();
+
+		// Create textures and materials of pages
+		TSharedPtr<CMaterial>						sourceMaterial	= InOutTilesets[ sources[ 0 ].first ].material.ToSharedPtr();
+		TSharedPtr<CTexture2D>						sourceTexture	= sourceMaterial->GetTextureParameters().begin()->second.ToSharedPtr();
+		const std::vector< TextureAtlasPage >&		pages			= atlasBuilder.GetPages();
+		std::vector< TAssetHandle<CMaterial> >		pageMaterials;
+		for ( uint32 indexPage = 0, countPages = pages.size(); indexPage < countPages; ++indexPage )
+		{
+			const TextureAtlasPage&		page		= pages[ indexPage ];
+			std::wstring				atlasName	= CString::Format( TEXT( "%s_Atlas%i_%i" ), InMapInfo.filename.c_str(), numAtlases, indexPage );
+
+			// Texture of page, mips are limited by padding so they don't mix neighboring tiles
+			TSharedPtr<CTexture2D>		atlasTexture = MakeSharedPtr<CTexture2D>();
+			atlasTexture->SetAssetName( atlasName );
+			atlasTexture->SetAddressU( SAM_Clamp );
+			atlasTexture->SetAddressV( SAM_Clamp );
+			atlasTexture->SetSamplerFilter( sourceTexture->GetSamplerFilter() );
+			atlasTexture->SetData( PF_A8R8G8B8, page.sizeX, page.sizeY, page.texels );
+			if ( atlasBuilder.GetNumMips() > 1 )
+			{
+				MipGenerationSettings		mipSettings;
+				mipSettings.filter		= MF_Box;
+				mipSettings.maxNumMips	= atlasBuilder.GetNumMips();
+				atlasTexture->GenerateMipmaps( mipSettings );
+			}
+			CompressTexture2D( atlasTexture.Get(), textureCompressor.GetUsageByName( sourceTexture->GetAssetName() ) );
+
+			TAssetHandle<CTexture2D>	atlasTextureHandle( atlasTexture, MakeSharedPtr<AssetReference>( AT_Texture2D, atlasTexture->GetGUID() ) );
+			atlasInfo.filename = atlasName;
+			if ( !SaveToPackage( atlasInfo, atlasTextureHandle ) )
+			{
+				return false;
+			}
+
+			// Material of page is copy of source material with atlas texture
+			TSharedPtr<CMaterial>		atlasMaterial = MakeSharedPtr<CMaterial>();
+			atlasMaterial->SetAssetName( atlasName + TEXT( "_Mat" ) );
+			atlasMaterial->SetTwoSided( sourceMaterial->IsTwoSided() );
+			atlasMaterial->SetWireframe( sourceMaterial->IsWireframe() );
+			atlasMaterial->SetTranslucency( sourceMaterial->IsTranslucency() );
+			atlasMaterial->SetUsageFlags( sourceMaterial->GetUsageFlags() );
+			for ( auto it = sourceMaterial->GetScalarParameters().begin(), itEnd = sourceMaterial->GetScalarParameters().end(); it != itEnd; ++it )
+			{
+				atlasMaterial->SetScalarParameterValue( it->first, it->second );
+			}
+
+			for ( auto it = sourceMaterial->GetVectorParameters().begin(), itEnd = sourceMaterial->GetVectorParameters().end(); it != itEnd; ++it )
+			{
+				atlasMaterial->SetVectorParameterValue( it->first, it->second );
+			}
+			atlasMaterial->SetTextureParameterValue( sourceMaterial->GetTextureParameters().begin()->first, atlasTextureHandle );
+
+			TAssetHandle<CMaterial>		atlasMaterialHandle( atlasMaterial, MakeSharedPtr<AssetReference>( AT_Material, atlasMaterial->GetGUID() ) );
+			atlasInfo.filename = atlasMaterial->GetAssetName();
+			if ( !SaveToPackage( atlasInfo, atlasMaterialHandle ) )
+			{
+				return false;
+			}
+
+			pageMaterials.push_back( atlasMaterialHandle );
+			Logf( TEXT( "Atlas '%s': %ix%i, %i mips, occupancy %.1f%%\n" ), atlasName.c_str(), page.sizeX, page.sizeY, atlasTexture->GetNumMips(), page.GetOccupancy() * 100.f );
+		}
+
+		// Remap texture rects and materials of tiles
+		for ( uint32 index = 0, count = sources.size(); index < count; ++index )
+		{
+			TMXTileset&			tileset = InOutTilesets[ sources[ index ].first ];
+			tileset.tileMaterials.resize( tileset.textureRects.size() );
+			for ( uint32 indexTile = 0, countTiles = tileset.textureRects.size(); indexTile < countTiles; ++indexTile )
+			{
+				const TextureAtlasEntry&	entry = atlasBuilder.GetEntry( tileImages[ index ][ indexTile ] );
+				tileset.textureRects[ indexTile ]	= entry.textureRect;
+				tileset.tileMaterials[ indexTile ]	= pageMaterials[ entry.pageIndex ];
+			}
+
+			if ( !tileset.tileMaterials.empty() )
+			{
+				tileset.material = tileset.tileMaterials[ 0 ];
+			}
+		}
+
+		++numAtlases;
+		numPackedTilesets	+= sources.size();
+		numPages			+= pages.size();
+	}
+
+	// Every material of tiles is at least one draw call
+	if ( numAtlases > 0 )
+	{
+		Logf( TEXT( "Packed %i tilesets to %i atlas pages, draw calls saved: %i\n" ), numPackedTilesets, numPages, numPackedTilesets - numPages );
+	}
+	atlasBuilder.Reset();
+	return true;
+}
+
 /*
 ==================
 CCookPackagesCommandlet::SpawnTilesInWorld
@@ -239,9 +473,19 @@ CCookPackagesCommandlet::SpawnTilesInWorld
 */
 void CCookPackagesCommandlet::SpawnTilesInWorld( const tmx::Map& InTMXMap, const std::vector<TMXTileset>& InTilesets )
 {
+	const double								startTime	= Sys_Seconds();
 	const std::vector< tmx::Layer::Ptr >&		tmxLayers	= InTMXMap.getLayers();
 	const tmx::Vector2u&						mapSize		= InTMXMap.getTileCount();
 	const tmx::Vector2u&						mapTileSize = InTMXMap.getTileSize();
+
+	// All tiles of map are stored in one tile map actor instead of actor per tile
+	ATileMap*				tileMap				= g_World->SpawnActor< ATileMap >( Math::vectorZero );
+	CTileMapComponent*		tileMapComponent	= tileMap->GetTileMapComponent();
+	tileMap->SetName( TEXT( "ATileMap_Tiles" ) );
+	tileMap->SetStatic( true );
+	tileMapComponent->SetMapSize( mapSize.x, mapSize.y, Vector2D( mapTileSize.x, mapTileSize.y ) );
+
+	uint32		numTiles = 0;
 	for ( uint32 indexLayer = 0, countLayers = tmxLayers.size(); indexLayer < countLayers; ++indexLayer )
 	{
 		if ( tmxLayers[ indexLayer ]->getType() == tmx::Layer::Type::Tile )
@@ -249,6 +493,22 @@ void CCookPackagesCommandlet::SpawnTilesInWorld( const tmx::Map& InTMXMap, const
 			tmx::TileLayer*									tmxLayer = ( tmx::TileLayer* )tmxLayers[ indexLayer ].get();
 			const std::vector< tmx::TileLayer::Tile >&		tmxTiles = tmxLayer->getTiles();
 
+			// Layer with property 'Collision' gets merged collision
+			bool											bCollision		= false;
+			const std::vector< tmx::Property >&				layerProperties = tmxLayer->getProperties();
+			for ( uint32 indexPropery = 0, countProperties = layerProperties.size(); indexPropery < countProperties; ++indexPropery )
+			{
+				const tmx::Property&		layerProperty = layerProperties[ indexPropery ];
+				if ( layerProperty.getName() == "Collision" && layerProperty.getType() == tmx::Property::Type::Boolean )
+				{
+					bCollision = layerProperty.getBoolValue();
+					break;
+				}
+			}
+
+			// Z of tiles is index of TMX layer, like for actors from object layers
+			const uint32		tileMapLayer = tileMapComponent->AddLayer( indexLayer, bCollision );
+
 			int32		x = 0;
 			int32		y = mapSize.y-1;
 			for ( uint32 indexTile = 0, countTiles = tmxTiles.size(); indexTile < countTiles; ++indexTile )
@@ -262,14 +522,12 @@ void CCookPackagesCommandlet::SpawnTilesInWorld( const tmx::Map& InTMXMap, const
 					bool			result = FindTileset( InTilesets, tile.ID, tileset, textureRect );
 					AssertMsg( result, TEXT( "Not founded tileset for tile with ID %i" ), tile.ID );
 
-					ASprite*			sprite				= g_World->SpawnActor< ASprite >( Vector( x * mapTileSize.x + tileset.tileSize.x / 2.f, y * mapTileSize.y + tileset.tileSize.y / 2.f, indexLayer ) );
-					CSpriteComponent*	spriteComponent		= sprite->GetSpriteComponent();
-					spriteComponent->SetType( ST_Static );
-					spriteComponent->SetMaterial( tileset.material );
-					spriteComponent->SetSpriteSize( Vector2D( tileset.tileSize.x, tileset.tileSize.y ) );
-					spriteComponent->SetTextureRect( textureRect );
-					sprite->SetName( TEXT( "ASprite_Tile" ) );
-					sprite->SetStatic( true );
+					TileMapTile		tileMapTile;
+					tileMapTile.material		= tileset.material;
+					tileMapTile.textureRect		= textureRect;
+					tileMapTile.size			= Vector2D( tileset.tileSize.x, tileset.tileSize.y );
+					tileMapComponent->SetTile( tileMapLayer, x, y, tileMapComponent->AddTile( tileMapTile ) );
+					++numTiles;
 				}
 
 				++x;
@@ -281,6 +539,9 @@ void CCookPackagesCommandlet::SpawnTilesInWorld( const tmx::Map& InTMXMap, const
 			}
 		}
 	}
+
+	// Before tile map every tile was own actor with sprite component
+	Logf( TEXT( "Tile map: %i tiles (was %i actors), %i chunks, %i palette tiles, built in %.2f ms\n" ), numTiles, numTiles, tileMapComponent->GetNumChunks(), tileMapComponent->GetNumPaletteTiles(), ( Sys_Seconds() - startTime ) * 1000.0 );
 }
 
 /*
@@ -506,6 +767,7 @@ bool CCookPackagesCommandlet::CookMaterial( const ResourceInfo& InMaterialInfo,
 			{
 				usageFlags |= MU_Sprite;
 				usedVertexFectories.push_back( CSpriteVertexFactory::staticType.GetHash() );
+				usedVertexFectories.push_back( CSpriteBatchVertexFactory::staticType.GetHash() );
 			}
 		}
 		else
@@ -715,10 +977,32 @@ bool CCookPackagesCommandlet::CookTexture2D( const ResourceInfo& InTexture2DInfo
 	Logf( TEXT( "Cooking texture 2D '%s:%s'\n" ), InTexture2DInfo.packageName.c_str(), InTexture2DInfo.filename.c_str() );
 	
 	TSharedPtr<CTexture2D>		texture2DRef = ConvertTexture2D( InTexture2DInfo.path, InTexture2DInfo.filename );
+	if ( texture2DRef )
+	{
+		CompressTexture2D( texture2DRef.Get(), textureCompressor.GetUsageByName( InTexture2DInfo.filename ) );
+	}
+
 	OutTexture2D				= TAssetHandle<CTexture2D>( texture2DRef, MakeSharedPtr<AssetReference>( AT_Texture2D, texture2DRef->GetGUID() ) );
 	return OutTexture2D.IsAssetValid() && SaveToPackage( InTexture2DInfo, OutTexture2D );
 }
 
+/*
+==================
+CCookPackagesCommandlet::CompressTexture2D
+==================
+*/
+void CCookPackagesCommandlet::CompressTexture2D( CTexture2D* InTexture2D, ETextureUsage InUsage )
+{
+	TextureCompressionStats		compressionStats;
+	if ( textureCompressor.Compress( InTexture2D, InUsage, compressionStats ) )
+	{
+		CTextureCompressor::LogStats( InTexture2D->GetAssetName(), compressionStats );
+		textureCompressionStats.encodeTime		+= compressionStats.encodeTime;
+		textureCompressionStats.numBytesBefore	+= compressionStats.numBytesBefore;
+		textureCompressionStats.numBytesAfter	+= compressionStats.numBytesAfter;
+	}
+}
+
 /**
  * ---------------------
  * Cook all resources
@@ -1085,6 +1369,13 @@ bool CCookPackagesCommandlet::Main( const CCommandLine& InCommandLine )
 
 		// Getting all maps from commands
 		mapsToCook = InCommandLine.GetValues( TEXT( "maps" ) );
+
+		// Texture compression settings, quality preset can be overridden from command line
+		textureCompressor.Init( InCommandLine.GetFirstValue( TEXT( "texturequality" ) ) );
+		textureCompressionStats = TextureCompressionStats();
+
+		// Atlas settings of tilesets
+		atlasBuilder.Init();
 	}
 
 	AssertMsg( !mapsToCook.empty(), TEXT( "Mpas to cook not entered" ) );
@@ -1176,6 +1467,15 @@ bool CCookPackagesCommandlet::Main( const CCommandLine& InCommandLine )
 		}
 	}
 
+	// Print total statistics of texture compression
+	if ( textureCompressionStats.numBytesAfter > 0 )
+	{
+		Logf( TEXT( "Textures compressed in %.2f sec: %.2f Mb -> %.2f Mb (ratio %.2f:1)\n" ),
+			  textureCompressionStats.encodeTime,
+			  textureCompressionStats.numBytesBefore / ( 1024.f * 1024.f ), textureCompressionStats.numBytesAfter / ( 1024.f * 1024.f ),
+			  textureCompressionStats.GetRatio() );
+	}
+
 	// Serialize shader cache
 	{
 		CArchive*		archive = g_FileSystem->CreateFileWriter( g_CookedDir + PATH_SEPARATOR + g_ShaderManager->GetShaderCacheFilename( cookedShaderPlatform ), AW_NoFail );
@@ -13,6 +13,7 @@
 #include "System/BaseEngine.h"
 #include "Containers/StringConv.h"
 #include "Render/StaticMesh.h"
+#include "Render/StaticMeshOptimizer.h"
 #include "Commandlets/ImportMeshCommandlet.h"
 
 IMPLEMENT_CLASS( CImportMeshCommandlet )
@@ -28,12 +29,29 @@ bool CImportMeshCommandlet::Main( const CCommandLine& InCommandLine )
 	std::wstring			srcFilename;
 	std::wstring			dstFilename;
 	std::wstring			nameMesh;
+	EStaticMeshVertexFormat	vertexFormat = SMVF_Default;
+	uint32					numLODs = STATICMESH_DEFAULT_NUM_LODS;
 
 	// Parse arguments
 	{
 		srcFilename = InCommandLine.GetFirstValue( TEXT( "src" ) );
 		dstFilename = InCommandLine.GetFirstValue( TEXT( "dst" ) );
 		nameMesh	= InCommandLine.GetFirstValue( TEXT( "n" ) );
+
+		if ( InCommandLine.HasParam( TEXT( "vertexformat" ), TEXT( "quantized" ) ) )
+		{
+			vertexFormat = SMVF_Quantized;
+		}
+		else if ( InCommandLine.HasParam( TEXT( "vertexformat" ), TEXT( "full" ) ) )
+		{
+			vertexFormat = SMVF_Full;
+		}
+
+		std::wstring	lodsValue = InCommandLine.GetFirstValue( TEXT( "lods" ) );
+		if ( !lodsValue.empty() )
+		{
+			numLODs = Clamp<int32>( stoi( lodsValue ), 1, STATICMESH_MAX_LODS );
+		}
 	}
 
 	// If source and destination files is empty - this error
@@ -47,7 +65,7 @@ bool CImportMeshCommandlet::Main( const CCommandLine& InCommandLine )
 	}
 
 	// Convert static mesh
-	TSharedPtr<CStaticMesh>		staticMesh = ConvertStaticMesh( srcFilename, nameMesh );
+	TSharedPtr<CStaticMesh>		staticMesh = ConvertStaticMesh( srcFilename, nameMesh, vertexFormat, numLODs );
 	if ( !staticMesh )
 	{
 		return false;
@@ -63,7 +81,7 @@ bool CImportMeshCommandlet::Main( const CCommandLine& InCommandLine )
 CImportMeshCommandlet::ConvertStaticMesh
 ==================
 */
-TSharedPtr<CStaticMesh> CImportMeshCommandlet::ConvertStaticMesh( const std::wstring& InPath, const std::wstring& InAssetName )
+TSharedPtr<CStaticMesh> CImportMeshCommandlet::ConvertStaticMesh( const std::wstring& InPath, const std::wstring& InAssetName, EStaticMeshVertexFormat InVertexFormat /* = SMVF_Default */, uint32 InNumLODs /* = STATICMESH_DEFAULT_NUM_LODS */ )
 {
 	// Loading mesh with help Assimp
 	Assimp::Importer		aiImport;
@@ -198,10 +216,20 @@ TSharedPtr<CStaticMesh> CImportMeshCommandlet::ConvertStaticMesh( const std::wst
 		surfaces.push_back( surface );
 	}
 
+	// Optimize mesh for vertex cache, overdraw and vertex fetch
+	StaticMeshOptimizationStats		optimizationStats;
+	CStaticMeshOptimizer::Optimize( verteces, indeces, surfaces, InVertexFormat, optimizationStats );
+	CStaticMeshOptimizer::LogStats( InAssetName, optimizationStats );
+
+	// Generate LODs
+	std::vector<StaticMeshLOD>		lods;
+	CStaticMeshOptimizer::GenerateLODs( verteces, indeces, surfaces, InNumLODs, lods );
+	CStaticMeshOptimizer::LogLODs( InAssetName, lods );
+
 	// Serialize static mesh in archive
 	TSharedPtr<CStaticMesh>		staticMeshRef = MakeSharedPtr<CStaticMesh>();
 	staticMeshRef->SetAssetName( InAssetName );
-	staticMeshRef->SetData( verteces, indeces, surfaces, materials );
+	staticMeshRef->SetData( verteces, indeces, lods, materials, InVertexFormat );
 
 	// Clean up all data
 	aiImport.FreeScene();
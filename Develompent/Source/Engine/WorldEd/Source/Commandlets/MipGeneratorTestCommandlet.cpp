@@ -0,0 +1,525 @@
+#include <cmath>
+#include <vector>
+
+#include "Misc/Class.h"
+#include "Misc/Template.h"
+#include "Misc/MipGenerator.h"
+#include "Logger/LoggerMacros.h"
+#include "Commandlets/MipGeneratorTestCommandlet.h"
+
+IMPLEMENT_CLASS( CMipGeneratorTestCommandlet )
+IMPLEMENT_DEFAULT_INITIALIZE_CLASS( CMipGeneratorTestCommandlet )
+
+/**
+ * @ingroup WorldEd
+ * @brief Max difference of channel between mip generator and reference
+ */
+#define MIPGENERATOR_TEST_TOLERANCE				1
+
+/**
+ * @ingroup WorldEd
+ * @brief Max difference of alpha coverage between mip and source
+ */
+#define MIPGENERATOR_TEST_COVERAGE_TOLERANCE	0.05f
+
+/**
+ * @ingroup WorldEd
+ * @brief Image of reference implementation in linear double RGBA format
+ */
+struct RefMipImage
+{
+	uint32					sizeX;		/**< Width */
+	uint32					sizeY;		/**< Height */
+	std::vector<double>		texels;		/**< Texels, four doubles per texel */
+};
+
+/**
+ * @ingroup WorldEd
+ * @brief Weights of reference filter for one destination texel along axis
+ */
+struct RefMipWeights
+{
+	uint32					firstIndex;	/**< Index of first source texel */
+	std::vector<double>		weights;	/**< Weights of source texels since first index */
+};
+
+/*
+==================
+MakeTestImage
+==================
+*/
+static void MakeTestImage( uint32 InSizeX, uint32 InSizeY, uint32 InSeed, std::vector<byte>& OutTexels )
+{
+	// Random noise over gradient, generator is seeded so every run tests the same images
+	OutTexels.resize( InSizeX * InSizeY * 4 );
+	uint32		seed = InSeed;
+	for ( uint32 index = 0, count = OutTexels.size(); index < count; ++index )
+	{
+		seed = seed * 1664525 + 1013904223;
+		const uint32	gradient = ( ( index / 4 ) % InSizeX ) * 128 / InSizeX;
+		OutTexels[index] = ( byte )( gradient + ( ( seed >> 16 ) & 127 ) );
+	}
+}
+
+/*
+==================
+RefDecode
+==================
+*/
+static void RefDecode( const std::vector<byte>& InTexels, uint32 InSizeX, uint32 InSizeY, const MipGenerationSettings& InSettings, RefMipImage& OutImage )
+{
+	OutImage.sizeX = InSizeX;
+	OutImage.sizeY = InSizeY;
+	OutImage.texels.resize( InSizeX * InSizeY * 4 );
+	for ( uint32 index = 0, count = InSizeX * InSizeY; index < count; ++index )
+	{
+		const double	alpha = InTexels[index * 4 + 3] / 255.0;
+		for ( uint32 channel = 0; channel < 3; ++channel )
+		{
+			double		value = InTexels[index * 4 + channel] / 255.0;
+			if ( InSettings.bSRGB )
+			{
+				value = value <= 0.04045 ? value / 12.92 : pow( ( value + 0.055 ) / 1.055, 2.4 );
+			}
+			OutImage.texels[index * 4 + channel] = InSettings.bPremultipliedAlpha ? value * alpha : value;
+		}
+		OutImage.texels[index * 4 + 3] = alpha;
+	}
+}
+
+/*
+==================
+RefEncode
+==================
+*/
+static void RefEncode( const RefMipImage& InImage, const MipGenerationSettings& InSettings, std::vector<byte>& OutTexels )
+{
+	OutTexels.resize( InImage.sizeX * InImage.sizeY * 4 );
+	for ( uint32 index = 0, count = InImage.sizeX * InImage.sizeY; index < count; ++index )
+	{
+		const double	alpha = Clamp( InImage.texels[index * 4 + 3], 0.0, 1.0 );
+		for ( uint32 channel = 0; channel < 3; ++channel )
+		{
+			double		value = InImage.texels[index * 4 + channel];
+			if ( InSettings.bPremultipliedAlpha )
+			{
+				value = alpha > 0.0 ? value / alpha : 0.0;
+			}
+
+			value = Clamp( value, 0.0, 1.0 );
+			if ( InSettings.bSRGB )
+			{
+				value = value <= 0.0031308 ? value * 12.92 : 1.055 * pow( value, 1.0 / 2.4 ) - 0.055;
+			}
+			OutTexels[index * 4 + channel] = ( byte )( value * 255.0 + 0.5 );
+		}
+		OutTexels[index * 4 + 3] = ( byte )( alpha * 255.0 + 0.5 );
+	}
+}
+
+/*
+==================
+RefBoxWeights
+==================
+*/
+static void RefBoxWeights( uint32 InSrcSize, uint32 InDstSize, uint32 InDstIndex, RefMipWeights& OutWeights )
+{
+	// Destination texel is average of source area it covers
+	const double	scale		= ( double )InSrcSize / InDstSize;
+	const double	start		= InDstIndex * scale;
+	const double	end			= start + scale;
+	const uint32	lastIndex	= Min<uint32>( ( uint32 )ceil( end ), InSrcSize ) - 1;
+	OutWeights.firstIndex = ( uint32 )floor( start );
+	OutWeights.weights.clear();
+	for ( uint32 srcIndex = OutWeights.firstIndex; srcIndex <= lastIndex; ++srcIndex )
+	{
+		const double	overlap = Min<double>( srcIndex + 1.0, end ) - Max<double>( srcIndex, start );
+		OutWeights.weights.push_back( overlap > 0.0 ? overlap / scale : 0.0 );
+	}
+}
+
+/*
+==================
+RefKaiserWeights
+==================
+*/
+static void RefKaiserWeights( uint32 InSrcSize, uint32 InDstSize, uint32 InDstIndex, RefMipWeights& OutWeights )
+{
+	const double	scale	= ( double )InSrcSize / InDstSize;
+	const double	center	= ( InDstIndex + 0.5 ) * scale;
+	const double	radius	= MIPGENERATOR_KAISER_RADIUS;
+	const double	pi		= 3.14159265358979323846;
+	const int32		first	= Max<int32>( ( int32 )floor( center - radius * scale ) - 1, 0 );
+	const int32		last	= Min<int32>( ( int32 )ceil( center + radius * scale ) + 1, InSrcSize - 1 );
+	OutWeights.firstIndex = first;
+	OutWeights.weights.assign( last - first + 1, 0.0 );
+
+	// Modified Bessel function of the first kind by power series
+	auto		besselI0 = []( double InX )
+	{
+		double		sum		= 1.0;
+		double		term	= 1.0;
+		for ( uint32 index = 1; index < 64; ++index )
+		{
+			term	*= ( InX * 0.5 / index ) * ( InX * 0.5 / index );
+			sum		+= term;
+		}
+		return sum;
+	};
+
+	// Taps out of image are clamped to edge
+	double		sumWeights = 0.0;
+	for ( int32 srcIndex = ( int32 )floor( center - radius * scale ) - 1, lastIndex = ( int32 )ceil( center + radius * scale ) + 1; srcIndex <= lastIndex; ++srcIndex )
+	{
+		const double	x = fabs( ( srcIndex + 0.5 - center ) / scale );
+		if ( x >= radius )
+		{
+			continue;
+		}
+
+		const double	sinc	= x < 1e-9 ? 1.0 : sin( pi * x ) / ( pi * x );
+		const double	ratio	= x / radius;
+		const double	weight	= sinc * besselI0( MIPGENERATOR_KAISER_ALPHA * sqrt( 1.0 - ratio * ratio ) ) / besselI0( MIPGENERATOR_KAISER_ALPHA );
+		OutWeights.weights[Clamp<int32>( srcIndex, first, last ) - first] += weight;
+		sumWeights += weight;
+	}
+
+	for ( uint32 index = 0, count = OutWeights.weights.size(); index < count; ++index )
+	{
+		OutWeights.weights[index] /= sumWeights;
+	}
+}
+
+/*
+==================
+RefDownsample
+==================
+*/
+static void RefDownsample( const RefMipImage& InSrc, EMipFilter InFilter, RefMipImage& OutDst )
+{
+	OutDst.sizeX = Max<uint32>( InSrc.sizeX >> 1, 1 );
+	OutDst.sizeY = Max<uint32>( InSrc.sizeY >> 1, 1 );
+	OutDst.texels.assign( OutDst.sizeX * OutDst.sizeY * 4, 0.0 );
+
+	// Weights along every axis are computed once per mip
+	std::vector<RefMipWeights>		weightsX( OutDst.sizeX );
+	std::vector<RefMipWeights>		weightsY( OutDst.sizeY );
+	for ( uint32 x = 0; x < OutDst.sizeX; ++x )
+	{
+		if ( InFilter == MF_Kaiser )
+		{
+			RefKaiserWeights( InSrc.sizeX, OutDst.sizeX, x, weightsX[x] );
+		}
+		else
+		{
+			RefBoxWeights( InSrc.sizeX, OutDst.sizeX, x, weightsX[x] );
+		}
+	}
+
+	for ( uint32 y = 0; y < OutDst.sizeY; ++y )
+	{
+		if ( InFilter == MF_Kaiser )
+		{
+			RefKaiserWeights( InSrc.sizeY, OutDst.sizeY, y, weightsY[y] );
+		}
+		else
+		{
+			RefBoxWeights( InSrc.sizeY, OutDst.sizeY, y, weightsY[y] );
+		}
+	}
+
+	for ( uint32 y = 0; y < OutDst.sizeY; ++y )
+	{
+		const RefMipWeights&	rowWeights = weightsY[y];
+		for ( uint32 x = 0; x < OutDst.sizeX; ++x )
+		{
+			const RefMipWeights&	columnWeights	= weightsX[x];
+			double*					dst				= OutDst.texels.data() + ( y * OutDst.sizeX + x ) * 4;
+			for ( uint32 indexY = 0, countY = rowWeights.weights.size(); indexY < countY; ++indexY )
+			{
+				for ( uint32 indexX = 0, countX = columnWeights.weights.size(); indexX < countX; ++indexX )
+				{
+					const double	weight	= rowWeights.weights[indexY] * columnWeights.weights[indexX];
+					const uint32	srcY	= rowWeights.firstIndex + indexY;
+					const uint32	srcX	= columnWeights.firstIndex + indexX;
+					const double*	src		= InSrc.texels.data() + ( srcY * InSrc.sizeX + srcX ) * 4;
+					for ( uint32 channel = 0; channel < 4; ++channel )
+					{
+						dst[channel] += src[channel] * weight;
+					}
+				}
+			}
+		}
+	}
+}
+
+/*
+==================
+RefGenerate
+==================
+*/
+static void RefGenerate( const std::vector<byte>& InTexels, uint32 InSizeX, uint32 InSizeY, const MipGenerationSettings& InSettings, std::vector<MipLevel>& OutMips )
+{
+	// Every mip is filtered from previous mip without quantization, as mip generator does
+	OutMips.resize( CMipGenerator::GetNumMips( InSizeX, InSizeY ) );
+	OutMips[0].sizeX	= InSizeX;
+	OutMips[0].sizeY	= InSizeY;
+	OutMips[0].data		= InTexels;
+
+	RefMipImage		currentImage;
+	RefDecode( InTexels, InSizeX, InSizeY, InSettings, currentImage );
+	for ( uint32 mipIndex = 1, numMips = OutMips.size(); mipIndex < numMips; ++mipIndex )
+	{
+		RefMipImage		nextImage;
+		RefDownsample( currentImage, InSettings.filter, nextImage );
+		OutMips[mipIndex].sizeX = nextImage.sizeX;
+		OutMips[mipIndex].sizeY = nextImage.sizeY;
+		RefEncode( nextImage, InSettings, OutMips[mipIndex].data );
+		currentImage = std::move( nextImage );
+	}
+}
+
+/*
+==================
+CalcMipCoverage
+==================
+*/
+static float CalcMipCoverage( const MipLevel& InMip, float InThreshold )
+{
+	const uint32	numTexels	= InMip.sizeX * InMip.sizeY;
+	uint32			numCovered	= 0;
+	for ( uint32 index = 0; index < numTexels; ++index )
+	{
+		if ( InMip.data[index * 4 + 3] / 255.f > InThreshold )
+		{
+			++numCovered;
+		}
+	}
+	return ( float )numCovered / numTexels;
+}
+
+/*
+==================
+CMipGeneratorTestCommandlet::Main
+==================
+*/
+bool CMipGeneratorTestCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	bool		bResult = TestReference();
+	bResult &= TestOddDimensions();
+	bResult &= TestAlphaCoverage();
+	Benchmark();
+
+	Logf( TEXT( "Mip generator test %s\n" ), bResult ? TEXT( "passed" ) : TEXT( "failed" ) );
+	return bResult;
+}
+
+/*
+==================
+CMipGeneratorTestCommandlet::TestReference
+==================
+*/
+bool CMipGeneratorTestCommandlet::TestReference()
+{
+	struct TestCase
+	{
+		const tchar*	name;					/**< Name of case */
+		EMipFilter		filter;					/**< Filter */
+		bool			bSRGB;					/**< Is sRGB */
+		bool			bPremultipliedAlpha;	/**< Is premultiplied alpha */
+	};
+
+	const TestCase		testCases[] =
+	{
+		{ TEXT( "Box linear" ),				MF_Box,		false,	false },
+		{ TEXT( "Box sRGB" ),				MF_Box,		true,	false },
+		{ TEXT( "Box premultiplied" ),		MF_Box,		true,	true },
+		{ TEXT( "Kaiser linear" ),			MF_Kaiser,	false,	false },
+		{ TEXT( "Kaiser sRGB" ),			MF_Kaiser,	true,	false },
+		{ TEXT( "Kaiser premultiplied" ),	MF_Kaiser,	true,	true }
+	};
+
+	// Power of two, odd sizes and axes with one texel
+	const uint32		sizes[][2] = { { 64, 64 }, { 257, 129 }, { 5, 3 }, { 1, 7 }, { 6, 1 } };
+
+	bool		bResult = true;
+	for ( uint32 indexCase = 0; indexCase < ARRAY_COUNT( testCases ); ++indexCase )
+	{
+		const TestCase&				testCase = testCases[indexCase];
+		MipGenerationSettings		settings;
+		settings.filter					= testCase.filter;
+		settings.bSRGB					= testCase.bSRGB;
+		settings.bPremultipliedAlpha	= testCase.bPremultipliedAlpha;
+
+		uint32		maxError = 0;
+		for ( uint32 indexSize = 0; indexSize < ARRAY_COUNT( sizes ); ++indexSize )
+		{
+			const uint32			sizeX = sizes[indexSize][0];
+			const uint32			sizeY = sizes[indexSize][1];
+			std::vector<byte>		texels;
+			std::vector<MipLevel>	mips;
+			std::vector<MipLevel>	refMips;
+			MakeTestImage( sizeX, sizeY, indexCase * 31 + indexSize, texels );
+			CMipGenerator::Generate( texels.data(), sizeX, sizeY, settings, mips );
+			RefGenerate( texels, sizeX, sizeY, settings, refMips );
+
+			if ( mips.size() != refMips.size() )
+			{
+				Errorf( TEXT( "%s %ix%i: %i mips, expected %i\n" ), testCase.name, sizeX, sizeY, ( uint32 )mips.size(), ( uint32 )refMips.size() );
+				bResult = false;
+				continue;
+			}
+
+			for ( uint32 mipIndex = 0, numMips = mips.size(); mipIndex < numMips; ++mipIndex )
+			{
+				const MipLevel&		mip		= mips[mipIndex];
+				const MipLevel&		refMip	= refMips[mipIndex];
+				if ( mip.sizeX != refMip.sizeX || mip.sizeY != refMip.sizeY )
+				{
+					Errorf( TEXT( "%s %ix%i: mip %i is %ix%i, expected %ix%i\n" ), testCase.name, sizeX, sizeY, mipIndex, mip.sizeX, mip.sizeY, refMip.sizeX, refMip.sizeY );
+					bResult = false;
+					break;
+				}
+
+				for ( uint32 index = 0, count = mip.data.size(); index < count; ++index )
+				{
+					// Color of almost transparent texels is lost by premultiplied alpha
+					const bool		bColor = ( index & 3 ) != 3;
+					if ( settings.bPremultipliedAlpha && bColor && refMip.data[( index & ~3 ) + 3] < 16 )
+					{
+						continue;
+					}
+
+					const uint32	error = ( uint32 )abs( ( int32 )mip.data[index] - ( int32 )refMip.data[index] );
+					maxError = Max( maxError, error );
+					if ( error > MIPGENERATOR_TEST_TOLERANCE )
+					{
+						Errorf( TEXT( "%s %ix%i: mip %i texel %i channel %i is %i, expected %i\n" ), testCase.name, sizeX, sizeY, mipIndex, index / 4, index & 3, mip.data[index], refMip.data[index] );
+						bResult = false;
+						break;
+					}
+				}
+			}
+		}
+		Logf( TEXT( "%s: max error %i\n" ), testCase.name, maxError );
+	}
+	return bResult;
+}
+
+/*
+==================
+CMipGeneratorTestCommandlet::TestOddDimensions
+==================
+*/
+bool CMipGeneratorTestCommandlet::TestOddDimensions()
+{
+	// Black 5x5 image with white last column and row, mip 2x2 must get them
+	const uint32			size = 5;
+	std::vector<byte>		texels( size * size * 4, 0 );
+	for ( uint32 y = 0; y < size; ++y )
+	{
+		for ( uint32 x = 0; x < size; ++x )
+		{
+			byte*	texel = texels.data() + ( y * size + x ) * 4;
+			texel[0] = texel[1] = texel[2] = ( x == size - 1 || y == size - 1 ) ? 255 : 0;
+			texel[3] = 255;
+		}
+	}
+
+	MipGenerationSettings		settings;
+	settings.bSRGB = false;
+	std::vector<MipLevel>		mips;
+	CMipGenerator::Generate( texels.data(), size, size, settings, mips );
+
+	// Texel 1x1 of mip covers 2.5x2.5 source texels, last column and row are 0.4 of width each
+	const MipLevel&		mip			= mips[1];
+	const byte			topLeft		= mip.data[0];
+	const byte			topRight	= mip.data[1 * 4];
+	const byte			bottomRight	= mip.data[( 1 * mip.sizeX + 1 ) * 4];
+	const byte			expected	= ( byte )( ( 1.0 - 0.6 * 0.6 ) * 255.0 + 0.5 );
+	if ( topLeft != 0 || abs( ( int32 )topRight - 102 ) > MIPGENERATOR_TEST_TOLERANCE || abs( ( int32 )bottomRight - expected ) > MIPGENERATOR_TEST_TOLERANCE )
+	{
+		Errorf( TEXT( "Odd dimensions: mip 2x2 is %i %i %i, expected 0 102 %i\n" ), topLeft, topRight, bottomRight, expected );
+		return false;
+	}
+
+	Logf( TEXT( "Odd dimensions: last column and row are filtered\n" ) );
+	return true;
+}
+
+/*
+==================
+CMipGeneratorTestCommandlet::TestAlphaCoverage
+==================
+*/
+bool CMipGeneratorTestCommandlet::TestAlphaCoverage()
+{
+	// Cutout of foliage: thin stripes with soft edges, without preservation they fade out in small mips
+	const uint32			size = 256;
+	std::vector<byte>		texels( size * size * 4 );
+	for ( uint32 y = 0; y < size; ++y )
+	{
+		for ( uint32 x = 0; x < size; ++x )
+		{
+			byte*			texel		= texels.data() + ( y * size + x ) * 4;
+			const float		stripe		= fabsf( sinf( x * 0.35f + y * 0.05f ) );
+			texel[0] = texel[2] = 40;
+			texel[1] = 160;
+			texel[3] = ( byte )( Clamp( ( stripe - 0.7f ) * 4.f, 0.f, 1.f ) * 255.f );
+		}
+	}
+
+	MipGenerationSettings		settings;
+	settings.bPreserveAlphaCoverage = true;
+	std::vector<MipLevel>		mips;
+	CMipGenerator::Generate( texels.data(), size, size, settings, mips );
+
+	settings.bPreserveAlphaCoverage = false;
+	std::vector<MipLevel>		plainMips;
+	CMipGenerator::Generate( texels.data(), size, size, settings, plainMips );
+
+	// Small mips have too few texels for exact coverage
+	bool			bResult			= true;
+	const float		sourceCoverage	= CalcMipCoverage( mips[0], settings.alphaCoverageThreshold );
+	for ( uint32 mipIndex = 1, numMips = mips.size(); mipIndex < numMips && mips[mipIndex].sizeX >= 8; ++mipIndex )
+	{
+		const float		coverage		= CalcMipCoverage( mips[mipIndex], settings.alphaCoverageThreshold );
+		const float		plainCoverage	= CalcMipCoverage( plainMips[mipIndex], settings.alphaCoverageThreshold );
+		Logf( TEXT( "Alpha coverage: mip %i is %.3f, without preservation %.3f, source %.3f\n" ), mipIndex, coverage, plainCoverage, sourceCoverage );
+		if ( fabsf( coverage - sourceCoverage ) > MIPGENERATOR_TEST_COVERAGE_TOLERANCE )
+		{
+			Errorf( TEXT( "Alpha coverage: mip %i isn't preserved\n" ), mipIndex );
+			bResult = false;
+		}
+	}
+	return bResult;
+}
+
+/*
+==================
+CMipGeneratorTestCommandlet::Benchmark
+==================
+*/
+void CMipGeneratorTestCommandlet::Benchmark()
+{
+	const uint32			size = 4096;
+	std::vector<byte>		texels;
+	std::vector<MipLevel>	mips;
+	MakeTestImage( size, size, 0, texels );
+
+	for ( uint32 filter = 0; filter < MF_Max; ++filter )
+	{
+		MipGenerationSettings		settings;
+		settings.filter = ( EMipFilter )filter;
+
+		const double	startTime = Sys_Seconds();
+		CMipGenerator::Generate( texels.data(), size, size, settings, mips );
+		Logf( TEXT( "Benchmark: %s chain of %ix%i in %.1f ms\n" ), filter == MF_Kaiser ? TEXT( "Kaiser" ) : TEXT( "box" ), size, size, ( Sys_Seconds() - startTime ) * 1000.0 );
+	}
+
+	// Scalar reference in one thread for compare, only box is fast enough for it
+	MipGenerationSettings		settings;
+	const double				startTime = Sys_Seconds();
+	RefGenerate( texels, size, size, settings, mips );
+	Logf( TEXT( "Benchmark: scalar reference box chain of %ix%i in %.1f ms\n" ), size, size, ( Sys_Seconds() - startTime ) * 1000.0 );
+}
\ No newline at end of file
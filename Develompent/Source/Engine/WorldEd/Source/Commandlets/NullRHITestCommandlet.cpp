@@ -0,0 +1,180 @@
+#include "Misc/Class.h"
+#include "Misc/Template.h"
+#include "Math/Color.h"
+#include "Logger/LoggerMacros.h"
+#include "NullRHI.h"
+#include "NullResources.h"
+#include "Commandlets/NullRHITestCommandlet.h"
+
+IMPLEMENT_CLASS( CNullRHITestCommandlet )
+IMPLEMENT_DEFAULT_INITIALIZE_CLASS( CNullRHITestCommandlet )
+
+/**
+ * @ingroup WorldEd
+ * @brief Number of primitives in the second draw of scripted frame
+ */
+#define NULLRHI_TEST_NUM_PRIMITIVES		10
+
+/**
+ * @ingroup WorldEd
+ * @brief Number of instances in the second draw of scripted frame
+ */
+#define NULLRHI_TEST_NUM_INSTANCES		4
+
+/*
+==================
+CNullRHITestCommandlet::Main
+==================
+*/
+bool CNullRHITestCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	bool		bResult = TestRecordedStream();
+	bResult &= TestStreamHash();
+	bResult &= TestRecordingDisabled();
+
+	Logf( TEXT( "Null RHI test %s\n" ), bResult ? TEXT( "passed" ) : TEXT( "failed" ) );
+	return bResult;
+}
+
+/*
+==================
+CNullRHITestCommandlet::TestRecordedStream
+==================
+*/
+bool CNullRHITestCommandlet::TestRecordedStream()
+{
+	CNullRHI			nullRHI;
+	CNullCommandList&	commandList = nullRHI.GetCommandList();
+	commandList.SetRecording( true );
+	DrawFrame( nullRHI, NULLRHI_TEST_NUM_PRIMITIVES );
+
+	// Begin of viewport sets render target and viewport itself
+	const NullRHICommand		expectedCommands[] =
+	{
+		{ NRC_SetRenderTarget,		0,								0 },
+		{ NRC_SetViewport,			0,								0 },
+		{ NRC_Clear,				0,								0 },
+		{ NRC_Clear,				1,								0 },
+		{ NRC_SetBlendState,		0,								0 },
+		{ NRC_SetDepthState,		0,								0 },
+		{ NRC_SetBoundShaderState,	0,								0 },
+		{ NRC_SetShaderParameter,	64,								0 },
+		{ NRC_CommitConstants,		0,								0 },
+		{ NRC_Draw,					2,								1 },
+		{ NRC_Draw,					NULLRHI_TEST_NUM_PRIMITIVES,	NULLRHI_TEST_NUM_INSTANCES }
+	};
+
+	const std::vector<NullRHICommand>&		commands = commandList.GetLastFrameCommands();
+	if ( commands.size() != ARRAY_COUNT( expectedCommands ) )
+	{
+		Errorf( TEXT( "Recorded stream: %i commands, expected %i\n" ), ( uint32 )commands.size(), ( uint32 )ARRAY_COUNT( expectedCommands ) );
+		return false;
+	}
+
+	for ( uint32 index = 0; index < ARRAY_COUNT( expectedCommands ); ++index )
+	{
+		const NullRHICommand&	command			= commands[index];
+		const NullRHICommand&	expectedCommand = expectedCommands[index];
+		if ( command.command != expectedCommand.command || command.arg0 != expectedCommand.arg0 || command.arg1 != expectedCommand.arg1 )
+		{
+			Errorf( TEXT( "Recorded stream: command %i is %s( %i, %i ), expected %s( %i, %i )\n" ), index,
+					CNullCommandList::GetCommandName( ( ENullRHICommand )command.command ), command.arg0, command.arg1,
+					CNullCommandList::GetCommandName( ( ENullRHICommand )expectedCommand.command ), expectedCommand.arg0, expectedCommand.arg1 );
+			return false;
+		}
+	}
+
+	const NullRHIStats&		stats = commandList.GetLastFrameStats();
+	const uint64			expectedNumPrimitives = 2 + NULLRHI_TEST_NUM_PRIMITIVES * NULLRHI_TEST_NUM_INSTANCES;
+	if ( stats.numDrawCalls != 2 || stats.numPrimitives != expectedNumPrimitives || stats.numStateChanges != 5 || commandList.GetNumFrames() != 1 )
+	{
+		Errorf( TEXT( "Recorded stream: %llu draw calls, %llu primitives, %llu state changes, %llu frames, expected 2, %llu, 5, 1\n" ),
+				stats.numDrawCalls, stats.numPrimitives, stats.numStateChanges, commandList.GetNumFrames(), expectedNumPrimitives );
+		return false;
+	}
+
+	Logf( TEXT( "Recorded stream: %i commands are expected ones\n" ), ( uint32 )commands.size() );
+	return true;
+}
+
+/*
+==================
+CNullRHITestCommandlet::TestStreamHash
+==================
+*/
+bool CNullRHITestCommandlet::TestStreamHash()
+{
+	CNullRHI			nullRHI;
+	CNullCommandList&	commandList = nullRHI.GetCommandList();
+	commandList.SetRecording( true );
+
+	DrawFrame( nullRHI, NULLRHI_TEST_NUM_PRIMITIVES );
+	const uint64		firstHash = commandList.GetLastFrameHash();
+	DrawFrame( nullRHI, NULLRHI_TEST_NUM_PRIMITIVES );
+	const uint64		secondHash = commandList.GetLastFrameHash();
+	DrawFrame( nullRHI, NULLRHI_TEST_NUM_PRIMITIVES + 1 );
+	const uint64		changedHash = commandList.GetLastFrameHash();
+
+	if ( firstHash == 0 || firstHash != secondHash )
+	{
+		Errorf( TEXT( "Stream hash: the same frames have different hashes 0x%llx and 0x%llx\n" ), firstHash, secondHash );
+		return false;
+	}
+
+	if ( changedHash == firstHash )
+	{
+		Errorf( TEXT( "Stream hash: changed draw doesn't change hash\n" ) );
+		return false;
+	}
+
+	Logf( TEXT( "Stream hash: 0x%llx is stable between frames\n" ), firstHash );
+	return true;
+}
+
+/*
+==================
+CNullRHITestCommandlet::TestRecordingDisabled
+==================
+*/
+bool CNullRHITestCommandlet::TestRecordingDisabled()
+{
+	CNullRHI			nullRHI;
+	CNullCommandList&	commandList = nullRHI.GetCommandList();
+	commandList.SetRecording( false );
+	DrawFrame( nullRHI, NULLRHI_TEST_NUM_PRIMITIVES );
+
+	if ( !commandList.GetLastFrameCommands().empty() || commandList.GetLastFrameStats().numDrawCalls != 2 )
+	{
+		Errorf( TEXT( "Recording disabled: %i commands stored, %llu draw calls counted, expected 0 and 2\n" ), ( uint32 )commandList.GetLastFrameCommands().size(), commandList.GetLastFrameStats().numDrawCalls );
+		return false;
+	}
+
+	Logf( TEXT( "Recording disabled: commands are counted and not stored\n" ) );
+	return true;
+}
+
+/*
+==================
+CNullRHITestCommandlet::DrawFrame
+==================
+*/
+void CNullRHITestCommandlet::DrawFrame( CNullRHI& InNullRHI, uint32 InNumPrimitives )
+{
+	// Null RHI isn't initialized here, so global render resources aren't touched and own device context is used
+	CNullDeviceContextRHI		deviceContext( &InNullRHI.GetCommandList() );
+	ViewportRHIRef_t			viewport = InNullRHI.CreateViewport( ( WindowHandle_t )nullptr, 320, 240 );
+	float						shaderParameters[16];
+	Sys_Memzero( shaderParameters, sizeof( shaderParameters ) );
+
+	InNullRHI.BeginDrawingViewport( &deviceContext, viewport );
+	deviceContext.ClearSurface( viewport->GetSurface(), CColor::black );
+	deviceContext.ClearDepthStencil( viewport->GetSurface() );
+	InNullRHI.SetBlendState( &deviceContext, nullptr );
+	InNullRHI.SetDepthState( &deviceContext, nullptr );
+	InNullRHI.SetBoundShaderState( &deviceContext, nullptr );
+	InNullRHI.SetPixelShaderParameter( &deviceContext, 0, 0, sizeof( shaderParameters ), shaderParameters );
+	InNullRHI.CommitConstants( &deviceContext );
+	InNullRHI.DrawPrimitive( &deviceContext, PT_TriangleList, 0, 2 );
+	InNullRHI.DrawPrimitive( &deviceContext, PT_TriangleList, 0, InNumPrimitives, NULLRHI_TEST_NUM_INSTANCES );
+	InNullRHI.EndDrawingViewport( &deviceContext, viewport, false, false );
+}
\ No newline at end of file
@@ -0,0 +1,337 @@
+#include "Misc/Class.h"
+#include "Misc/Template.h"
+#include "Logger/LoggerMacros.h"
+#include "Misc/PhysicsGlobals.h"
+#include "System/PhysicsEngine.h"
+#include "System/PhysicsBodyInstance.h"
+#include "System/PhysicsBodySetup.h"
+#include "System/PhysicsBoxGeometry.h"
+#include "Commandlets/PhysicsQueryBenchmarkCommandlet.h"
+
+IMPLEMENT_CLASS( CPhysicsQueryBenchmarkCommandlet )
+IMPLEMENT_DEFAULT_INITIALIZE_CLASS( CPhysicsQueryBenchmarkCommandlet )
+
+/**
+ * @ingroup WorldEd
+ * @brief Number of static boxes in benchmark scene
+ */
+#define PHYSICS_QUERY_BENCHMARK_NUM_BODIES		10000
+
+/**
+ * @ingroup WorldEd
+ * @brief Number of queries of each type
+ */
+#define PHYSICS_QUERY_BENCHMARK_NUM_QUERIES		1000
+
+/**
+ * @ingroup WorldEd
+ * @brief Size of benchmark scene
+ */
+#define PHYSICS_QUERY_BENCHMARK_SCENE_SIZE		20000.f
+
+/**
+ * @ingroup WorldEd
+ * @brief Max difference of hit distance between per-fixture and broadphase traces
+ */
+#define PHYSICS_QUERY_BENCHMARK_TOLERANCE		0.01f
+
+/*
+==================
+RandomFloat
+==================
+*/
+static FORCEINLINE float RandomFloat( uint32& InOutSeed, float InMax )
+{
+	InOutSeed = InOutSeed * 1664525 + 1013904223;
+	return ( InOutSeed >> 8 ) / 16777216.f * InMax;
+}
+
+#if WITH_BOX2D
+/**
+ * @ingroup WorldEd
+ * @brief Box2D callback of AABB query, counts fixtures which AABB overlaps query AABB
+ */
+class CPhysicsQueryBenchmarkCallback : public b2QueryCallback
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InAABB	Query AABB
+	 */
+	CPhysicsQueryBenchmarkCallback( const b2AABB& InAABB )
+		: numFixtures( 0 )
+		, aabb( InAABB )
+	{}
+
+	/**
+	 * @brief Called for each fixture found in the query AABB
+	 *
+	 * @param InFixture		Fixture
+	 * @return Return false to terminate the query
+	 */
+	virtual bool ReportFixture( b2Fixture* InFixture ) override
+	{
+		// Dynamic tree stores fat AABBs, so the exact one is tested here
+		if ( b2TestOverlap( InFixture->GetAABB( 0 ), aabb ) )
+		{
+			++numFixtures;
+		}
+		return true;
+	}
+
+	uint32		numFixtures;	/**< Number of found fixtures */
+
+private:
+	b2AABB		aabb;			/**< Query AABB */
+};
+
+/*
+==================
+PerFixtureLineTrace
+==================
+*/
+static bool PerFixtureLineTrace( const b2Vec2& InStart, const b2Vec2& InEnd, ECollisionChannel InTraceChannel, float& OutFraction )
+{
+	// Every fixture of scene is checked, the same as LineTraceSingleByChannel did before queries through broadphase
+	b2RayCastInput		bx2RayCastInput;
+	bx2RayCastInput.p1			= InStart;
+	bx2RayCastInput.p2			= InEnd;
+	bx2RayCastInput.maxFraction	= 1.f;
+
+	bool		bHit = false;
+	OutFraction = 1.f;
+
+	const std::vector< CPhysicsBodyInstance* >&		sceneBodies = g_PhysicsScene.GetBodies();
+	for ( uint32 index = 0, count = sceneBodies.size(); index < count; ++index )
+	{
+		for ( b2Fixture* bx2Fixture = sceneBodies[ index ]->GetActorHandle().bx2Body->GetFixtureList(); bx2Fixture; bx2Fixture = bx2Fixture->GetNext() )
+		{
+			PhysicsShapeHandleBox2D*	shapeHandle = ( PhysicsShapeHandleBox2D* )bx2Fixture->GetUserData().pointer;
+			b2RayCastOutput				bx2RayCastOutput;
+			if ( shapeHandle && shapeHandle->collisionProfile->objectType == InTraceChannel && bx2Fixture->RayCast( &bx2RayCastOutput, bx2RayCastInput, 0 ) && bx2RayCastOutput.fraction < OutFraction )
+			{
+				OutFraction = bx2RayCastOutput.fraction;
+				bHit = true;
+			}
+		}
+	}
+	return bHit;
+}
+
+/*
+==================
+PerFixtureQueryAABB
+==================
+*/
+static uint32 PerFixtureQueryAABB( const b2AABB& InAABB )
+{
+	uint32		numFixtures = 0;
+	const std::vector< CPhysicsBodyInstance* >&		sceneBodies = g_PhysicsScene.GetBodies();
+	for ( uint32 index = 0, count = sceneBodies.size(); index < count; ++index )
+	{
+		for ( b2Fixture* bx2Fixture = sceneBodies[ index ]->GetActorHandle().bx2Body->GetFixtureList(); bx2Fixture; bx2Fixture = bx2Fixture->GetNext() )
+		{
+			if ( b2TestOverlap( bx2Fixture->GetAABB( 0 ), InAABB ) )
+			{
+				++numFixtures;
+			}
+		}
+	}
+	return numFixtures;
+}
+#endif // WITH_BOX2D
+
+/*
+==================
+CPhysicsQueryBenchmarkCommandlet::Main
+==================
+*/
+bool CPhysicsQueryBenchmarkCommandlet::Main( const CCommandLine& InCommandLine )
+{
+#if WITH_BOX2D
+	if ( !g_PhysicsEngine.FindCollisionProfile( TEXT( "BlockAll" ) ) )
+	{
+		Errorf( TEXT( "Collision profile 'BlockAll' not found, physics query benchmark not started\n" ) );
+		return false;
+	}
+
+	SpawnBodies();
+	bool		bResult = BenchmarkLineTraces();
+	bResult &= BenchmarkQueryAABB();
+	DestroyBodies();
+
+	Logf( TEXT( "Physics query benchmark %s\n" ), bResult ? TEXT( "passed" ) : TEXT( "failed" ) );
+	return bResult;
+#else
+	Warnf( TEXT( "Physics query benchmark is implemented only for Box2D\n" ) );
+	return true;
+#endif // WITH_BOX2D
+}
+
+/*
+==================
+CPhysicsQueryBenchmarkCommandlet::BenchmarkLineTraces
+==================
+*/
+bool CPhysicsQueryBenchmarkCommandlet::BenchmarkLineTraces()
+{
+#if WITH_BOX2D
+	// Rays are generated by seeded generator, so all runs of commandlet trace the same rays
+	std::vector< Vector >		starts;
+	std::vector< Vector >		ends;
+	uint32						seed = 0x1B873593;
+	for ( uint32 index = 0; index < PHYSICS_QUERY_BENCHMARK_NUM_QUERIES; ++index )
+	{
+		starts.push_back( Vector( RandomFloat( seed, PHYSICS_QUERY_BENCHMARK_SCENE_SIZE ), RandomFloat( seed, PHYSICS_QUERY_BENCHMARK_SCENE_SIZE ), 0.f ) );
+		ends.push_back( Vector( RandomFloat( seed, PHYSICS_QUERY_BENCHMARK_SCENE_SIZE ), RandomFloat( seed, PHYSICS_QUERY_BENCHMARK_SCENE_SIZE ), 0.f ) );
+	}
+
+	const ECollisionChannel		traceChannel = g_PhysicsEngine.FindCollisionProfile( TEXT( "BlockAll" ) )->objectType;
+	std::vector< float >		perFixtureDistances( PHYSICS_QUERY_BENCHMARK_NUM_QUERIES, -1.f );
+	std::vector< float >		broadphaseDistances( PHYSICS_QUERY_BENCHMARK_NUM_QUERIES, -1.f );
+	uint32						numHits = 0;
+
+	double		startTime = Sys_Seconds();
+	for ( uint32 index = 0; index < PHYSICS_QUERY_BENCHMARK_NUM_QUERIES; ++index )
+	{
+		const b2Vec2	bx2Start	= LE2BVector( ( Vector2D )starts[ index ] / BOX2D_SCALE );
+		const b2Vec2	bx2End		= LE2BVector( ( Vector2D )ends[ index ] / BOX2D_SCALE );
+		float			fraction	= 1.f;
+		if ( PerFixtureLineTrace( bx2Start, bx2End, traceChannel, fraction ) )
+		{
+			perFixtureDistances[ index ] = fraction * ( bx2End - bx2Start ).Length() * BOX2D_SCALE;
+		}
+	}
+	const double	perFixtureTime = Sys_Seconds() - startTime;
+
+	startTime = Sys_Seconds();
+	for ( uint32 index = 0; index < PHYSICS_QUERY_BENCHMARK_NUM_QUERIES; ++index )
+	{
+		HitResult		hitResult;
+		if ( g_PhysicsScene.LineTraceSingleByChannel( hitResult, starts[ index ], ends[ index ], traceChannel ) )
+		{
+			broadphaseDistances[ index ] = hitResult.distance;
+		}
+	}
+	const double	broadphaseTime = Sys_Seconds() - startTime;
+
+	// Broadphase trace must return the closest hit, not the first found one
+	bool		bResult = true;
+	for ( uint32 index = 0; index < PHYSICS_QUERY_BENCHMARK_NUM_QUERIES; ++index )
+	{
+		if ( Math::Abs( perFixtureDistances[ index ] - broadphaseDistances[ index ] ) > PHYSICS_QUERY_BENCHMARK_TOLERANCE )
+		{
+			Errorf( TEXT( "Line trace %i: hit distance is %f, expected %f\n" ), index, broadphaseDistances[ index ], perFixtureDistances[ index ] );
+			bResult = false;
+		}
+		else if ( perFixtureDistances[ index ] >= 0.f )
+		{
+			++numHits;
+		}
+	}
+
+	Logf( TEXT( "Line traces: %i rays, %i hits, per-fixture %.2f ms, broadphase %.2f ms\n" ), PHYSICS_QUERY_BENCHMARK_NUM_QUERIES, numHits, perFixtureTime * 1000.0, broadphaseTime * 1000.0 );
+	return bResult;
+#else
+	return true;
+#endif // WITH_BOX2D
+}
+
+/*
+==================
+CPhysicsQueryBenchmarkCommandlet::BenchmarkQueryAABB
+==================
+*/
+bool CPhysicsQueryBenchmarkCommandlet::BenchmarkQueryAABB()
+{
+#if WITH_BOX2D
+	std::vector< b2AABB >		aabbs;
+	uint32						seed = 0xE6546B64;
+	for ( uint32 index = 0; index < PHYSICS_QUERY_BENCHMARK_NUM_QUERIES; ++index )
+	{
+		b2AABB		bx2AABB;
+		bx2AABB.lowerBound	= LE2BVector( Vector2D( RandomFloat( seed, PHYSICS_QUERY_BENCHMARK_SCENE_SIZE ), RandomFloat( seed, PHYSICS_QUERY_BENCHMARK_SCENE_SIZE ) ) / BOX2D_SCALE );
+		bx2AABB.upperBound	= bx2AABB.lowerBound + LE2BVector( Vector2D( 100.f + RandomFloat( seed, 900.f ), 100.f + RandomFloat( seed, 900.f ) ) / BOX2D_SCALE );
+		aabbs.push_back( bx2AABB );
+	}
+
+	std::vector< uint32 >		perFixtureCounts( PHYSICS_QUERY_BENCHMARK_NUM_QUERIES );
+	std::vector< uint32 >		broadphaseCounts( PHYSICS_QUERY_BENCHMARK_NUM_QUERIES );
+	uint32						numFixtures = 0;
+
+	double		startTime = Sys_Seconds();
+	for ( uint32 index = 0; index < PHYSICS_QUERY_BENCHMARK_NUM_QUERIES; ++index )
+	{
+		perFixtureCounts[ index ] = PerFixtureQueryAABB( aabbs[ index ] );
+	}
+	const double	perFixtureTime = Sys_Seconds() - startTime;
+
+	startTime = Sys_Seconds();
+	for ( uint32 index = 0; index < PHYSICS_QUERY_BENCHMARK_NUM_QUERIES; ++index )
+	{
+		CPhysicsQueryBenchmarkCallback		queryCallback( aabbs[ index ] );
+		g_PhysicsScene.GetBox2DWorld()->QueryAABB( &queryCallback, aabbs[ index ] );
+		broadphaseCounts[ index ] = queryCallback.numFixtures;
+	}
+	const double	broadphaseTime = Sys_Seconds() - startTime;
+
+	bool		bResult = true;
+	for ( uint32 index = 0; index < PHYSICS_QUERY_BENCHMARK_NUM_QUERIES; ++index )
+	{
+		if ( perFixtureCounts[ index ] != broadphaseCounts[ index ] )
+		{
+			Errorf( TEXT( "Query AABB %i: found %i fixtures, expected %i\n" ), index, broadphaseCounts[ index ], perFixtureCounts[ index ] );
+			bResult = false;
+		}
+		numFixtures += perFixtureCounts[ index ];
+	}
+
+	Logf( TEXT( "Query AABB: %i queries, %i fixtures found, per-fixture %.2f ms, broadphase %.2f ms\n" ), PHYSICS_QUERY_BENCHMARK_NUM_QUERIES, numFixtures, perFixtureTime * 1000.0, broadphaseTime * 1000.0 );
+	return bResult;
+#else
+	return true;
+#endif // WITH_BOX2D
+}
+
+/*
+==================
+CPhysicsQueryBenchmarkCommandlet::SpawnBodies
+==================
+*/
+void CPhysicsQueryBenchmarkCommandlet::SpawnBodies()
+{
+	Assert( bodies.empty() );
+
+	// All boxes share one cached body setup
+	PhysicsBodySetupRef_t		boxBodySetup = new CPhysicsBodySetup();
+	PhysicsBoxGeometry			boxGeometry( 40.f );
+	boxGeometry.collisionProfile	= g_PhysicsEngine.FindCollisionProfile( TEXT( "BlockAll" ) );
+	boxGeometry.material			= g_PhysicsEngine.GetDefaultPhysMaterial();
+	boxBodySetup->AddBoxGeometry( boxGeometry );
+	boxBodySetup = g_PhysicsEngine.FindOrAddCachedBodySetup( boxBodySetup );
+
+	uint32		seed = 0x85EBCA6B;
+	for ( uint32 index = 0; index < PHYSICS_QUERY_BENCHMARK_NUM_BODIES; ++index )
+	{
+		const float				x	= RandomFloat( seed, PHYSICS_QUERY_BENCHMARK_SCENE_SIZE );
+		const float				y	= RandomFloat( seed, PHYSICS_QUERY_BENCHMARK_SCENE_SIZE );
+		CPhysicsBodyInstance*	box = new CPhysicsBodyInstance();
+		box->InitBody( boxBodySetup, CTransform( Vector( x, y, 0.f ) ), nullptr );
+		bodies.push_back( box );
+	}
+}
+
+/*
+==================
+CPhysicsQueryBenchmarkCommandlet::DestroyBodies
+==================
+*/
+void CPhysicsQueryBenchmarkCommandlet::DestroyBodies()
+{
+	for ( uint32 index = 0, count = bodies.size(); index < count; ++index )
+	{
+		bodies[ index ]->TermBody();
+		delete bodies[ index ];
+	}
+	bodies.clear();
+}
\ No newline at end of file
@@ -0,0 +1,403 @@
+#include "Misc/Class.h"
+#include "Misc/Template.h"
+#include "Misc/Misc.h"
+#include "Logger/LoggerMacros.h"
+#include "Misc/PhysicsGlobals.h"
+#include "System/PhysicsEngine.h"
+#include "System/PhysicsBodyInstance.h"
+#include "System/PhysicsBodySetup.h"
+#include "System/PhysicsBoxGeometry.h"
+#include "Commandlets/PhysicsTestCommandlet.h"
+
+IMPLEMENT_CLASS( CPhysicsTestCommandlet )
+IMPLEMENT_DEFAULT_INITIALIZE_CLASS( CPhysicsTestCommandlet )
+
+/**
+ * @ingroup WorldEd
+ * @brief Number of steps simulated by one run of test scene
+ */
+#define PHYSICS_TEST_NUM_STEPS			180
+
+/**
+ * @ingroup WorldEd
+ * @brief Number of dynamic boxes in test scene
+ */
+#define PHYSICS_TEST_NUM_BOXES			4
+
+/**
+ * @ingroup WorldEd
+ * @brief Number of identical bodies spawned by test of shared body setup
+ */
+#define PHYSICS_TEST_NUM_SHARED_BODIES	10000
+
+/*
+==================
+CPhysicsTestCommandlet::Main
+==================
+*/
+bool CPhysicsTestCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	if ( !g_PhysicsEngine.FindCollisionProfile( TEXT( "BlockAll" ) ) )
+	{
+		Errorf( TEXT( "Collision profile 'BlockAll' not found, physics test not started\n" ) );
+		return false;
+	}
+
+	// Each run restores this state, so stepper starts from the same step
+	g_PhysicsEngine.SaveState( initialState );
+	bool		bResult = TestFrameTimeSequences();
+	bResult &= TestLockstepReplay();
+	bResult &= TestSharedBodySetup();
+
+	Logf( TEXT( "Physics test %s\n" ), bResult ? TEXT( "passed" ) : TEXT( "failed" ) );
+	return bResult;
+}
+
+/*
+==================
+CPhysicsTestCommandlet::TestFrameTimeSequences
+==================
+*/
+bool CPhysicsTestCommandlet::TestFrameTimeSequences()
+{
+	const uint32		stepTicks = ( uint32 )g_PhysicsEngine.GetStepper().GetStepTicks();
+	const uint32		totalTicks = stepTicks * PHYSICS_TEST_NUM_STEPS;
+
+	// Patterns of frame times in ticks, each one is repeated until total time of run.
+	// Frames are shorter and longer than step, but not longer than max substeps, otherwise steps are dropped
+	const std::vector< uint32 >		patterns[] =
+	{
+		{ stepTicks },
+		{ 10000 },
+		{ 25000 },
+		{ 3000, 17000, 5000, 25000 },
+		{ 1000, 1000, 1000, 47000 },
+		{ stepTicks - 1, stepTicks + 1 }
+	};
+
+	// Random split of total time, generator is seeded by constant so all runs of commandlet test the same sequence
+	std::vector< uint32 >		randomFrameTimes;
+	uint32						seed = 0x2545F491;
+	for ( uint32 ticks = 0; ticks < totalTicks; )
+	{
+		seed = seed * 1664525 + 1013904223;
+		const uint32		frameTicks = Min( 1000 + ( seed >> 8 ) % 40000, totalTicks - ticks );
+		randomFrameTimes.push_back( frameTicks );
+		ticks += frameTicks;
+	}
+
+	// The first sequence ticks one step per frame, so it is reference trajectory with state after every step
+	std::vector< std::vector< uint32 > >		sequences;
+	for ( uint32 index = 0; index < ARRAY_COUNT( patterns ); ++index )
+	{
+		const std::vector< uint32 >&	pattern = patterns[ index ];
+		std::vector< uint32 >			frameTimes;
+		for ( uint32 ticks = 0, indexFrame = 0; ticks < totalTicks; ++indexFrame )
+		{
+			const uint32		frameTicks = Min( pattern[ indexFrame % pattern.size() ], totalTicks - ticks );
+			frameTimes.push_back( frameTicks );
+			ticks += frameTicks;
+		}
+		sequences.push_back( frameTimes );
+	}
+	sequences.push_back( randomFrameTimes );
+
+	uint64					refNumSteps = 0;
+	std::vector< uint64 >	refTrajectory;
+	SimulateFrameTimes( sequences[ 0 ], refNumSteps, refTrajectory );
+	if ( refNumSteps != PHYSICS_TEST_NUM_STEPS )
+	{
+		Errorf( TEXT( "Reference sequence simulated %i steps, expected %i\n" ), ( uint32 )refNumSteps, PHYSICS_TEST_NUM_STEPS );
+		return false;
+	}
+
+	bool		bResult = true;
+	for ( uint32 index = 1, count = sequences.size(); index < count; ++index )
+	{
+		uint64					numSteps = 0;
+		std::vector< uint64 >	trajectory;
+		SimulateFrameTimes( sequences[ index ], numSteps, trajectory );
+		if ( numSteps != refNumSteps )
+		{
+			Errorf( TEXT( "Sequence %i: simulated %i steps, expected %i\n" ), index, ( uint32 )numSteps, ( uint32 )refNumSteps );
+			bResult = false;
+			continue;
+		}
+
+		// Only steps ended at frame boundary are known, the rest are simulated inside of one frame
+		for ( uint32 step = 0; step < numSteps; ++step )
+		{
+			if ( trajectory[ step ] != 0 && trajectory[ step ] != refTrajectory[ step ] )
+			{
+				Errorf( TEXT( "Sequence %i: trajectory diverged at step %i\n" ), index, step + 1 );
+				bResult = false;
+				break;
+			}
+		}
+
+		if ( bResult )
+		{
+			Logf( TEXT( "Sequence %i: %i frames, trajectory is identical\n" ), index, ( uint32 )sequences[ index ].size() );
+		}
+	}
+
+	return bResult;
+}
+
+/*
+==================
+CPhysicsTestCommandlet::TestLockstepReplay
+==================
+*/
+bool CPhysicsTestCommandlet::TestLockstepReplay()
+{
+	// State hash is updated by physics engine only in deterministic mode, otherwise hash of test bodies is compared
+	if ( !g_PhysicsEngine.IsDeterministic() )
+	{
+		Warnf( TEXT( "Physics isn't in deterministic mode, lockstep replay compares only state of test bodies\n" ) );
+	}
+
+	std::vector< uint64 >		firstStateHashes;
+	std::vector< uint64 >		secondStateHashes;
+	SimulateLockstep( firstStateHashes );
+	SimulateLockstep( secondStateHashes );
+
+	for ( uint32 index = 0, count = firstStateHashes.size(); index < count; ++index )
+	{
+		if ( firstStateHashes[ index ] != secondStateHashes[ index ] )
+		{
+			Errorf( TEXT( "Lockstep replay: state hash diverged at step %i\n" ), index + 1 );
+			return false;
+		}
+	}
+
+	Logf( TEXT( "Lockstep replay: %i steps, state hash is identical\n" ), ( uint32 )firstStateHashes.size() );
+	return true;
+}
+
+/*
+==================
+CPhysicsTestCommandlet::TestSharedBodySetup
+==================
+*/
+bool CPhysicsTestCommandlet::TestSharedBodySetup()
+{
+	// Size of box differs from boxes of other tests, so its setup isn't in cache yet
+	const uint32				numCachedBodySetups = g_PhysicsEngine.GetNumCachedBodySetups();
+	PhysicsBoxGeometry			boxGeometry( 25.f );
+	boxGeometry.collisionProfile	= g_PhysicsEngine.FindCollisionProfile( TEXT( "BlockAll" ) );
+	boxGeometry.material			= g_PhysicsEngine.GetDefaultPhysMaterial();
+
+	uint64		usedMemory = 0;
+	uint64		peakUsedMemory = 0;
+	Sys_GetProcessMemoryStats( usedMemory, peakUsedMemory );
+	const uint64	startUsedMemory = usedMemory;
+	const double	startTime		= Sys_Seconds();
+
+	// Each body builds own candidate setup, the same as components do it
+	std::vector< CPhysicsBodyInstance* >		sharedBodies;
+	sharedBodies.reserve( PHYSICS_TEST_NUM_SHARED_BODIES );
+	for ( uint32 index = 0; index < PHYSICS_TEST_NUM_SHARED_BODIES; ++index )
+	{
+		PhysicsBodySetupRef_t		boxBodySetup = new CPhysicsBodySetup();
+		boxBodySetup->AddBoxGeometry( boxGeometry );
+		boxBodySetup = g_PhysicsEngine.FindOrAddCachedBodySetup( boxBodySetup );
+
+		CPhysicsBodyInstance*		box = new CPhysicsBodyInstance();
+		box->InitBody( boxBodySetup, CTransform( Vector( ( index % 100 ) * 60.f, ( index / 100 ) * 60.f, 0.f ) ), nullptr );
+		sharedBodies.push_back( box );
+	}
+
+	const double	spawnTime = Sys_Seconds() - startTime;
+	Sys_GetProcessMemoryStats( usedMemory, peakUsedMemory );
+	Logf( TEXT( "Shared body setup: spawned %i bodies in %.2f ms, memory %.2f Mb\n" ), PHYSICS_TEST_NUM_SHARED_BODIES, spawnTime * 1000.0, ( usedMemory - Min( usedMemory, startUsedMemory ) ) / ( 1024.0 * 1024.0 ) );
+
+	// All bodies must reference the same setup, and it is the only one added to cache
+	bool						bResult = true;
+	PhysicsBodySetupRef_t		sharedBodySetup = sharedBodies[ 0 ]->GetBodySetup();
+	for ( uint32 index = 1; index < PHYSICS_TEST_NUM_SHARED_BODIES; ++index )
+	{
+		if ( sharedBodies[ index ]->GetBodySetup() != sharedBodySetup )
+		{
+			Errorf( TEXT( "Shared body setup: body %i has own body setup\n" ), index );
+			bResult = false;
+			break;
+		}
+	}
+
+	if ( g_PhysicsEngine.GetNumCachedBodySetups() != numCachedBodySetups + 1 )
+	{
+		Errorf( TEXT( "Shared body setup: %i body setups in cache, expected %i\n" ), g_PhysicsEngine.GetNumCachedBodySetups(), numCachedBodySetups + 1 );
+		bResult = false;
+	}
+	sharedBodySetup = nullptr;
+
+	// Setup must leave cache with the last body
+	bool		bRemovedEarly = false;
+	for ( uint32 index = 0; index < PHYSICS_TEST_NUM_SHARED_BODIES; ++index )
+	{
+		sharedBodies[ index ]->TermBody();
+		delete sharedBodies[ index ];
+		if ( !bRemovedEarly && index + 1 < PHYSICS_TEST_NUM_SHARED_BODIES && g_PhysicsEngine.GetNumCachedBodySetups() != numCachedBodySetups + 1 )
+		{
+			Errorf( TEXT( "Shared body setup: removed from cache while %i bodies use it\n" ), PHYSICS_TEST_NUM_SHARED_BODIES - index - 1 );
+			bRemovedEarly	= true;
+			bResult			= false;
+		}
+	}
+
+	if ( g_PhysicsEngine.GetNumCachedBodySetups() != numCachedBodySetups )
+	{
+		Errorf( TEXT( "Shared body setup: isn't removed from cache after the last body\n" ) );
+		bResult = false;
+	}
+
+	if ( bResult )
+	{
+		Logf( TEXT( "Shared body setup: one setup is shared by %i bodies and released with the last one\n" ), PHYSICS_TEST_NUM_SHARED_BODIES );
+	}
+	return bResult;
+}
+
+/*
+==================
+CPhysicsTestCommandlet::SimulateLockstep
+==================
+*/
+void CPhysicsTestCommandlet::SimulateLockstep( std::vector< uint64 >& OutStateHashes )
+{
+	SpawnBodies();
+	OutStateHashes.clear();
+	for ( uint32 step = 0; step < PHYSICS_TEST_NUM_STEPS; ++step )
+	{
+		// Inputs are applied between steps, the same as game does it on its tick
+		switch ( step )
+		{
+		case 10:
+			for ( uint32 index = 1, count = bodies.size(); index < count; ++index )
+			{
+				bodies[ index ]->AddImpulse( Vector( 0.f, 500.f * index, 0.f ), true );
+			}
+			break;
+
+		case 30:
+			SpawnBox( Vector( 150.f, 250.f, 0.f ) );
+			break;
+
+		case 60:
+			bodies[ 1 ]->AddAngularImpulse( Vector( 0.f, 0.f, 1000.f ), true );
+			bodies.back()->SetLinearVelocity( Vector( -10.f, 0.f, 0.f ) );
+			break;
+		}
+
+		g_PhysicsEngine.StepOnce();
+		OutStateHashes.push_back( g_PhysicsEngine.IsDeterministic() ? g_PhysicsEngine.GetStateHash() : CalcBodiesHash() );
+	}
+	DestroyBodies();
+}
+
+/*
+==================
+CPhysicsTestCommandlet::SimulateFrameTimes
+==================
+*/
+void CPhysicsTestCommandlet::SimulateFrameTimes( const std::vector< uint32 >& InFrameTimes, uint64& OutNumSteps, std::vector< uint64 >& OutTrajectory )
+{
+	SpawnBodies();
+	OutTrajectory.clear();
+	for ( uint32 index = 0, count = InFrameTimes.size(); index < count; ++index )
+	{
+		g_PhysicsEngine.Tick( ( float )InFrameTimes[ index ] / PHYSICS_TICKS_PER_SECOND );
+
+		// Zero hash marks steps which aren't observed by this sequence
+		OutNumSteps = g_PhysicsEngine.GetStepper().GetNumSteps() - initialState.numSteps;
+		OutTrajectory.resize( OutNumSteps, 0 );
+		if ( OutNumSteps > 0 )
+		{
+			OutTrajectory[ OutNumSteps - 1 ] = CalcBodiesHash();
+		}
+	}
+	DestroyBodies();
+}
+
+/*
+==================
+CPhysicsTestCommandlet::SpawnBodies
+==================
+*/
+void CPhysicsTestCommandlet::SpawnBodies()
+{
+	Assert( bodies.empty() );
+	g_PhysicsEngine.RestoreState( initialState );
+
+	// Boxes are far from each other, so each one is own island and order of pairs in broadphase doesn't affect solver
+	PhysicsBodySetupRef_t		groundBodySetup = new CPhysicsBodySetup();
+	PhysicsBoxGeometry			groundGeometry( PHYSICS_TEST_NUM_BOXES * 300.f, 20.f, 20.f );
+	groundGeometry.collisionProfile	= g_PhysicsEngine.FindCollisionProfile( TEXT( "BlockAll" ) );
+	groundGeometry.material			= g_PhysicsEngine.GetDefaultPhysMaterial();
+	groundBodySetup->AddBoxGeometry( groundGeometry );
+	groundBodySetup = g_PhysicsEngine.FindOrAddCachedBodySetup( groundBodySetup );
+
+	CPhysicsBodyInstance*		ground = new CPhysicsBodyInstance();
+	ground->InitBody( groundBodySetup, CTransform( Vector( -100.f, -20.f, 0.f ) ), nullptr );
+	bodies.push_back( ground );
+
+	for ( uint32 index = 0; index < PHYSICS_TEST_NUM_BOXES; ++index )
+	{
+		CPhysicsBodyInstance*	box = SpawnBox( Vector( index * 300.f, 100.f + index * 50.f, 0.f ) );
+		box->SetLinearVelocity( Vector( index * 20.f, 0.f, 0.f ) );
+	}
+}
+
+/*
+==================
+CPhysicsTestCommandlet::SpawnBox
+==================
+*/
+CPhysicsBodyInstance* CPhysicsTestCommandlet::SpawnBox( const Vector& InLocation )
+{
+	PhysicsBodySetupRef_t		boxBodySetup = new CPhysicsBodySetup();
+	PhysicsBoxGeometry			boxGeometry( 40.f );
+	boxGeometry.collisionProfile	= g_PhysicsEngine.FindCollisionProfile( TEXT( "BlockAll" ) );
+	boxGeometry.material			= g_PhysicsEngine.GetDefaultPhysMaterial();
+	boxBodySetup->AddBoxGeometry( boxGeometry );
+	boxBodySetup = g_PhysicsEngine.FindOrAddCachedBodySetup( boxBodySetup );
+
+	CPhysicsBodyInstance*		box = new CPhysicsBodyInstance();
+	box->SetDynamic( true );
+	box->SetSimulatePhysics( true );
+	box->SetEnableGravity( true );
+	box->InitBody( boxBodySetup, CTransform( InLocation ), nullptr );
+	bodies.push_back( box );
+	return box;
+}
+
+/*
+==================
+CPhysicsTestCommandlet::DestroyBodies
+==================
+*/
+void CPhysicsTestCommandlet::DestroyBodies()
+{
+	for ( uint32 index = 0, count = bodies.size(); index < count; ++index )
+	{
+		bodies[ index ]->TermBody();
+		delete bodies[ index ];
+	}
+	bodies.clear();
+}
+
+/*
+==================
+CPhysicsTestCommandlet::CalcBodiesHash
+==================
+*/
+uint64 CPhysicsTestCommandlet::CalcBodiesHash() const
+{
+	uint64		hash = 0;
+	for ( uint32 index = 0, count = bodies.size(); index < count; ++index )
+	{
+		hash = bodies[ index ]->GetActorState().GetTypeHash( hash );
+	}
+	return hash;
+}
\ No newline at end of file
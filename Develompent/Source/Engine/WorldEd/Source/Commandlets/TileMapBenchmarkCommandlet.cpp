@@ -0,0 +1,345 @@
+#include <tmxlite/Map.hpp>
+#include <tmxlite/TileLayer.hpp>
+
+#include "Misc/Class.h"
+#include "Misc/Template.h"
+#include "Misc/EngineGlobals.h"
+#include "Containers/StringConv.h"
+#include "Logger/LoggerMacros.h"
+#include "EngineDefines.h"
+#include "System/World.h"
+#include "System/BaseEngine.h"
+#include "System/Package.h"
+#include "System/MemoryArchive.h"
+#include "Render/Scene.h"
+#include "Render/RenderingThread.h"
+#include "Actors/Sprite.h"
+#include "Actors/TileMap.h"
+#include "Commandlets/TileMapBenchmarkCommandlet.h"
+
+IMPLEMENT_CLASS( CTileMapBenchmarkCommandlet )
+IMPLEMENT_DEFAULT_INITIALIZE_CLASS( CTileMapBenchmarkCommandlet )
+
+/**
+ * @ingroup WorldEd
+ * @brief Size of generated map by default
+ */
+#define TILEMAP_BENCHMARK_DEFAULT_SIZE		256
+
+/**
+ * @ingroup WorldEd
+ * @brief Size of cell in generated map
+ */
+#define TILEMAP_BENCHMARK_CELL_SIZE			32.f
+
+/**
+ * @ingroup WorldEd
+ * @brief Number of tiles by X and Y in atlas of generated map
+ */
+#define TILEMAP_BENCHMARK_ATLAS_SIZE		4
+
+/**
+ * @ingroup WorldEd
+ * @brief Number of measured frames
+ */
+#define TILEMAP_BENCHMARK_NUM_FRAMES		100
+
+/**
+ * @ingroup WorldEd
+ * @brief Size of view in world units, like a FullHD screen with a pixel per unit
+ */
+#define TILEMAP_BENCHMARK_VIEW_WIDTH		1920.f
+#define TILEMAP_BENCHMARK_VIEW_HEIGHT		1080.f
+
+/*
+==================
+CTileMapBenchmarkCommandlet::CTileMapBenchmarkCommandlet
+==================
+*/
+CTileMapBenchmarkCommandlet::CTileMapBenchmarkCommandlet()
+	: sizeX( 0 )
+	, sizeY( 0 )
+	, cellSize( TILEMAP_BENCHMARK_CELL_SIZE, TILEMAP_BENCHMARK_CELL_SIZE )
+{}
+
+/*
+==================
+CTileMapBenchmarkCommandlet::Main
+==================
+*/
+bool CTileMapBenchmarkCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	// Load map or generate it if path not entered
+	std::wstring		mapPath = InCommandLine.GetFirstValue( TEXT( "map" ) );
+	if ( !mapPath.empty() )
+	{
+		if ( !LoadTMXMap( mapPath ) )
+		{
+			return false;
+		}
+	}
+	else
+	{
+		std::wstring	sizeValue = InCommandLine.GetFirstValue( TEXT( "size" ) );
+		GenerateMap( !sizeValue.empty() ? Max( stoi( sizeValue ), 1 ) : TILEMAP_BENCHMARK_DEFAULT_SIZE );
+	}
+
+	Logf( TEXT( "Tile map benchmark: %ix%i cells, %i layers, %i tiles\n" ), sizeX, sizeY, layerDepths.size(), tiles.size() );
+	if ( tiles.empty() )
+	{
+		Warnf( TEXT( "Map hasn't tiles, tile map benchmark not started\n" ) );
+		return true;
+	}
+
+	// Both ways are measured on the same tiles
+	const TileMapBenchmarkResult	actorsResult	= Benchmark( false );
+	const TileMapBenchmarkResult	tileMapResult	= Benchmark( true );
+	Logf( TEXT( "Actor per tile: %i actors, world %.2f Mb, spawn %.2f ms, load %.2f ms, frame %.3f ms\n" ),
+		  actorsResult.numActors, actorsResult.worldSize / ( 1024.f * 1024.f ), actorsResult.spawnTime * 1000.0, actorsResult.loadTime * 1000.0, actorsResult.frameTime * 1000.0 );
+	Logf( TEXT( "Tile map: %i actors, world %.2f Mb, spawn %.2f ms, load %.2f ms, frame %.3f ms\n" ),
+		  tileMapResult.numActors, tileMapResult.worldSize / ( 1024.f * 1024.f ), tileMapResult.spawnTime * 1000.0, tileMapResult.loadTime * 1000.0, tileMapResult.frameTime * 1000.0 );
+	Logf( TEXT( "Speedup: load %.2fx, frame %.2fx\n" ),
+		  tileMapResult.loadTime > 0.0 ? actorsResult.loadTime / tileMapResult.loadTime : 0.0, tileMapResult.frameTime > 0.0 ? actorsResult.frameTime / tileMapResult.frameTime : 0.0 );
+	return true;
+}
+
+/*
+==================
+CTileMapBenchmarkCommandlet::LoadTMXMap
+==================
+*/
+bool CTileMapBenchmarkCommandlet::LoadTMXMap( const std::wstring& InPath )
+{
+	tmx::Map		tmxMap;
+	if ( !tmxMap.load( TCHAR_TO_ANSI( InPath.c_str() ) ) )
+	{
+		Errorf( TEXT( "Map '%s' not found\n" ), InPath.c_str() );
+		return false;
+	}
+
+	const tmx::Vector2u&		mapSize		= tmxMap.getTileCount();
+	const tmx::Vector2u&		mapTileSize = tmxMap.getTileSize();
+	sizeX		= mapSize.x;
+	sizeY		= mapSize.y;
+	cellSize	= Vector2D( mapTileSize.x, mapTileSize.y );
+
+	// Materials of tilesets are taken from packages like in cooker, if tileset isn't cooked yet default material is used.
+	// Material doesn't change cost of spawn and frame on CPU, so both ways are still comparable
+	const std::vector< tmx::Tileset >&		tmxTilesets = tmxMap.getTilesets();
+	std::vector< TAssetHandle<CMaterial> >	tilesetMaterials;
+	for ( uint32 index = 0, count = tmxTilesets.size(); index < count; ++index )
+	{
+		TAssetHandle<CMaterial>		tilesetMaterial = g_PackageManager->FindAsset( ANSI_TO_TCHAR( tmxTilesets[ index ].getName().c_str() ), AT_Unknown );
+		if ( !tilesetMaterial.IsAssetValid() )
+		{
+			Warnf( TEXT( "Material of tileset '%s' not found, used default material\n" ), ANSI_TO_TCHAR( tmxTilesets[ index ].getName().c_str() ) );
+			tilesetMaterial = g_Engine->GetDefaultMaterial();
+		}
+		tilesetMaterials.push_back( tilesetMaterial );
+	}
+
+	const std::vector< tmx::Layer::Ptr >&	tmxLayers = tmxMap.getLayers();
+	for ( uint32 indexLayer = 0, countLayers = tmxLayers.size(); indexLayer < countLayers; ++indexLayer )
+	{
+		if ( tmxLayers[ indexLayer ]->getType() != tmx::Layer::Type::Tile )
+		{
+			continue;
+		}
+
+		// Z of tiles is index of TMX layer, like in cooker
+		const uint32									layer		= layerDepths.size();
+		const std::vector< tmx::TileLayer::Tile >&		tmxTiles	= ( ( tmx::TileLayer* )tmxLayers[ indexLayer ].get() )->getTiles();
+		layerDepths.push_back( indexLayer );
+
+		uint32		x = 0;
+		uint32		y = sizeY-1;
+		for ( uint32 indexTile = 0, countTiles = tmxTiles.size(); indexTile < countTiles; ++indexTile )
+		{
+			const uint32	tileID = tmxTiles[ indexTile ].ID;
+			for ( uint32 indexTileset = 0, countTilesets = tmxTilesets.size(); tileID != 0 && indexTileset < countTilesets; ++indexTileset )
+			{
+				const tmx::Tileset&		tmxTileset = tmxTilesets[ indexTileset ];
+				if ( tileID < tmxTileset.getFirstGID() || tileID > tmxTileset.getLastGID() )
+				{
+					continue;
+				}
+
+				// Texture rect in range from 0 to 1
+				const tmx::Vector2u		tmxTilesetSize	= tmxTileset.getImageSize();
+				const tmx::Vector2u		tmxTileSize		= tmxTileset.getTileSize();
+				const uint32			localID			= tileID - tmxTileset.getFirstGID();
+				const uint32			countColumns	= Max<uint32>( tmxTilesetSize.x / tmxTileSize.x, 1 );
+
+				TileMapBenchmarkTile	tile;
+				tile.layer				= layer;
+				tile.x					= x;
+				tile.y					= y;
+				tile.tile.material		= tilesetMaterials[ indexTileset ];
+				tile.tile.size			= Vector2D( tmxTileSize.x, tmxTileSize.y );
+				tile.tile.textureRect	= RectFloat_t( ( float )( localID % countColumns ) * tmxTileSize.x / tmxTilesetSize.x, ( float )( localID / countColumns ) * tmxTileSize.y / tmxTilesetSize.y,
+													   ( float )tmxTileSize.x / tmxTilesetSize.x, ( float )tmxTileSize.y / tmxTilesetSize.y );
+				tiles.push_back( tile );
+				break;
+			}
+
+			++x;
+			if ( x >= sizeX )
+			{
+				x = 0;
+				--y;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+==================
+CTileMapBenchmarkCommandlet::GenerateMap
+==================
+*/
+void CTileMapBenchmarkCommandlet::GenerateMap( uint32 InSize )
+{
+	sizeX		= InSize;
+	sizeY		= InSize;
+	cellSize	= Vector2D( TILEMAP_BENCHMARK_CELL_SIZE, TILEMAP_BENCHMARK_CELL_SIZE );
+	layerDepths.push_back( 0.f );
+
+	// Tiles are taken from atlas in order, so palette of tile map has several tiles like in real map
+	const float		rectSize = 1.f / TILEMAP_BENCHMARK_ATLAS_SIZE;
+	for ( uint32 y = 0; y < sizeY; ++y )
+	{
+		for ( uint32 x = 0; x < sizeX; ++x )
+		{
+			const uint32			atlasIndex = ( x + y ) % ( TILEMAP_BENCHMARK_ATLAS_SIZE * TILEMAP_BENCHMARK_ATLAS_SIZE );
+			TileMapBenchmarkTile	tile;
+			tile.layer				= 0;
+			tile.x					= x;
+			tile.y					= y;
+			tile.tile.material		= g_Engine->GetDefaultMaterial();
+			tile.tile.size			= cellSize;
+			tile.tile.textureRect	= RectFloat_t( ( atlasIndex % TILEMAP_BENCHMARK_ATLAS_SIZE ) * rectSize, ( atlasIndex / TILEMAP_BENCHMARK_ATLAS_SIZE ) * rectSize, rectSize, rectSize );
+			tiles.push_back( tile );
+		}
+	}
+}
+
+/*
+==================
+CTileMapBenchmarkCommandlet::Benchmark
+==================
+*/
+TileMapBenchmarkResult CTileMapBenchmarkCommandlet::Benchmark( bool InIsTileMap )
+{
+	TileMapBenchmarkResult		result;
+	g_World->CleanupWorld();
+	FlushRenderingCommands();
+
+	// Spawn tiles, in game it is done by cooker
+	double		startTime = Sys_Seconds();
+	if ( InIsTileMap )
+	{
+		SpawnTileMap();
+	}
+	else
+	{
+		SpawnTileActors();
+	}
+	FlushRenderingCommands();
+	result.spawnTime = Sys_Seconds() - startTime;
+
+	// Save world to memory like cooker saves it to HDD
+	std::vector< byte >		worldData;
+	{
+		CMemoryWriter		memoryWriter( worldData );
+		memoryWriter.SetType( AT_World );
+		memoryWriter.SerializeHeader();
+		g_World->Serialize( memoryWriter );
+	}
+	g_World->CleanupWorld();
+	FlushRenderingCommands();
+	result.worldSize = worldData.size();
+
+	// Load world and begin play, it is what game does on load of map
+	startTime = Sys_Seconds();
+	{
+		CMemoryReading		memoryReading( worldData );
+		memoryReading.SerializeHeader();
+		g_World->Serialize( memoryReading );
+	}
+	g_World->BeginPlay();
+	FlushRenderingCommands();
+	result.loadTime		= Sys_Seconds() - startTime;
+	result.numActors	= g_World->GetNumActors();
+
+	// View in center of map, frame includes tick of world and build of view (culling and adding to draw lists)
+	const float		halfWidth	= TILEMAP_BENCHMARK_VIEW_WIDTH / 2.f;
+	const float		halfHeight	= TILEMAP_BENCHMARK_VIEW_HEIGHT / 2.f;
+	const Vector	location	= Vector( sizeX * cellSize.x / 2.f, sizeY * cellSize.y / 2.f, -1000.f );
+	const Matrix	projectionMatrix	= glm::ortho( -halfWidth, halfWidth, -halfHeight, halfHeight, 0.01f, ( float )HALF_WORLD_MAX );
+	const Matrix	viewMatrix			= glm::lookAt( location, location + Math::vectorForward, Math::vectorUp );
+	CSceneView		sceneView( location, projectionMatrix, viewMatrix, TILEMAP_BENCHMARK_VIEW_WIDTH, TILEMAP_BENCHMARK_VIEW_HEIGHT, CColor::black, SHOW_DefaultGame );
+	CBaseScene*		scene		= g_World->GetScene();
+
+	startTime = Sys_Seconds();
+	for ( uint32 index = 0; index < TILEMAP_BENCHMARK_NUM_FRAMES; ++index )
+	{
+		g_World->Tick( 1.f / 60.f );
+		scene->BuildView( sceneView );
+		scene->ClearView();
+	}
+	result.frameTime = ( Sys_Seconds() - startTime ) / TILEMAP_BENCHMARK_NUM_FRAMES;
+
+	g_World->EndPlay();
+	g_World->CleanupWorld();
+	FlushRenderingCommands();
+	return result;
+}
+
+/*
+==================
+CTileMapBenchmarkCommandlet::SpawnTileActors
+==================
+*/
+void CTileMapBenchmarkCommandlet::SpawnTileActors()
+{
+	// The same as cooker did before tile map
+	for ( uint32 index = 0, count = tiles.size(); index < count; ++index )
+	{
+		const TileMapBenchmarkTile&		tile				= tiles[ index ];
+		ASprite*						sprite				= g_World->SpawnActor< ASprite >( Vector( tile.x * cellSize.x + tile.tile.size.x / 2.f, tile.y * cellSize.y + tile.tile.size.y / 2.f, layerDepths[ tile.layer ] ) );
+		CSpriteComponent*				spriteComponent		= sprite->GetSpriteComponent();
+		spriteComponent->SetType( ST_Static );
+		spriteComponent->SetMaterial( tile.tile.material );
+		spriteComponent->SetSpriteSize( tile.tile.size );
+		spriteComponent->SetTextureRect( tile.tile.textureRect );
+		sprite->SetName( TEXT( "ASprite_Tile" ) );
+		sprite->SetStatic( true );
+	}
+}
+
+/*
+==================
+CTileMapBenchmarkCommandlet::SpawnTileMap
+==================
+*/
+void CTileMapBenchmarkCommandlet::SpawnTileMap()
+{
+	// The same as cooker does
+	ATileMap*				tileMap				= g_World->SpawnActor< ATileMap >( Math::vectorZero );
+	CTileMapComponent*		tileMapComponent	= tileMap->GetTileMapComponent();
+	tileMap->SetName( TEXT( "ATileMap_Tiles" ) );
+	tileMap->SetStatic( true );
+	tileMapComponent->SetMapSize( sizeX, sizeY, cellSize );
+	for ( uint32 index = 0, count = layerDepths.size(); index < count; ++index )
+	{
+		tileMapComponent->AddLayer( layerDepths[ index ] );
+	}
+
+	for ( uint32 index = 0, count = tiles.size(); index < count; ++index )
+	{
+		const TileMapBenchmarkTile&		tile = tiles[ index ];
+		tileMapComponent->SetTile( tile.layer, tile.x, tile.y, tileMapComponent->AddTile( tile.tile ) );
+	}
+}
\ No newline at end of file
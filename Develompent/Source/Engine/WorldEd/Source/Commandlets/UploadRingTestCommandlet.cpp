@@ -0,0 +1,235 @@
+#include <vector>
+
+#include "Misc/Class.h"
+#include "Logger/LoggerMacros.h"
+#include "RHI/UploadRingAllocatorRHI.h"
+#include "Commandlets/UploadRingTestCommandlet.h"
+
+IMPLEMENT_CLASS( CUploadRingTestCommandlet )
+IMPLEMENT_DEFAULT_INITIALIZE_CLASS( CUploadRingTestCommandlet )
+
+/**
+ * @ingroup WorldEd
+ * @brief Allocation of upload ring test, which GPU may still read
+ */
+struct UploadRingTestRegion
+{
+	uint64		frame;		/**< Index of frame */
+	uint32		offset;		/**< Offset in ring */
+	uint32		size;		/**< Size of allocation */
+};
+
+/*
+==================
+CUploadRingTestCommandlet::Main
+==================
+*/
+bool CUploadRingTestCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	bool		bResult = TestAlignment();
+	bResult &= TestWrapAround();
+	bResult &= TestRetire();
+	bResult &= TestRandomLatency();
+
+	Logf( TEXT( "Upload ring test %s\n" ), bResult ? TEXT( "passed" ) : TEXT( "failed" ) );
+	return bResult;
+}
+
+/*
+==================
+CUploadRingTestCommandlet::TestAlignment
+==================
+*/
+bool CUploadRingTestCommandlet::TestAlignment()
+{
+	CUploadRingAllocator		ring( 1024 );
+	UploadRingAllocation		allocation;
+
+	// The first allocation always discards, driver gives new memory for the buffer
+	if ( !ring.Allocate( 10, 1, allocation ) || !allocation.bNeedDiscard || allocation.offset != 0 )
+	{
+		Errorf( TEXT( "Alignment: the first allocation must discard the buffer\n" ) );
+		return false;
+	}
+
+	// Vertex stride is not a power of two
+	if ( !ring.Allocate( 24, 12, allocation ) || allocation.bNeedDiscard || allocation.offset != 12 )
+	{
+		Errorf( TEXT( "Alignment: allocation with stride 12 got offset %u, expected 12\n" ), allocation.offset );
+		return false;
+	}
+
+	if ( !ring.Allocate( 16, UPLOAD_RING_INSTANCE_ALIGNMENT, allocation ) || allocation.offset != 48 )
+	{
+		Errorf( TEXT( "Alignment: instance allocation got offset %u, expected 48\n" ), allocation.offset );
+		return false;
+	}
+
+	if ( ring.Allocate( 0, 1, allocation ) || ring.Allocate( 1025, 1, allocation ) || ring.CanAllocate( 1025 ) )
+	{
+		Errorf( TEXT( "Alignment: empty allocation and allocation larger than ring must fail\n" ) );
+		return false;
+	}
+	return true;
+}
+
+/*
+==================
+CUploadRingTestCommandlet::TestWrapAround
+==================
+*/
+bool CUploadRingTestCommandlet::TestWrapAround()
+{
+	CUploadRingAllocator		ring( 1024 );
+	UploadRingAllocation		allocation;
+	ring.Allocate( 600, 1, allocation );
+	ring.RetireFrames( ring.EndFrame() );
+
+	// Tail of ring is 424 bytes, so allocation wraps to start, which is already retired
+	if ( !ring.Allocate( 600, 1, allocation ) || !allocation.bWrapped || allocation.bNeedDiscard || allocation.offset != 0 )
+	{
+		Errorf( TEXT( "Wrap around: allocation must wrap to start of ring without discard\n" ) );
+		return false;
+	}
+
+	// Wasted tail is in flight together with frame until it is retired
+	if ( ring.GetNumBytesInFlight() != 1024 )
+	{
+		Errorf( TEXT( "Wrap around: %u bytes in flight, expected 1024\n" ), ring.GetNumBytesInFlight() );
+		return false;
+	}
+
+	ring.RetireFrames( ring.EndFrame() );
+	if ( ring.GetNumBytesInFlight() != 0 || ring.GetNumFramesInFlight() != 0 )
+	{
+		Errorf( TEXT( "Wrap around: retired ring must have nothing in flight\n" ) );
+		return false;
+	}
+	return true;
+}
+
+/*
+==================
+CUploadRingTestCommandlet::TestRetire
+==================
+*/
+bool CUploadRingTestCommandlet::TestRetire()
+{
+	CUploadRingAllocator		ring( 1024 );
+	UploadRingAllocation		allocation;
+
+	// GPU is slower than CPU, so two frames are still in flight and third one doesn't fit
+	ring.Allocate( 400, 1, allocation );
+	const uint64		firstFrame = ring.EndFrame();
+	ring.Allocate( 400, 1, allocation );
+	ring.EndFrame();
+	if ( !ring.Allocate( 400, 1, allocation ) || !allocation.bNeedDiscard )
+	{
+		Errorf( TEXT( "Retire: allocation over memory in flight must discard the buffer\n" ) );
+		return false;
+	}
+
+	// The same sequence, but GPU has finished the first frame, so its memory is reused
+	ring.Init( 1024 );
+	ring.Allocate( 400, 1, allocation );
+	const uint64		frame = ring.EndFrame();
+	ring.Allocate( 400, 1, allocation );
+	ring.EndFrame();
+	ring.RetireFrames( frame );
+	if ( !ring.Allocate( 400, 1, allocation ) || allocation.bNeedDiscard || !allocation.bWrapped || allocation.offset != 0 )
+	{
+		Errorf( TEXT( "Retire: memory of retired frame must be reused without discard\n" ) );
+		return false;
+	}
+
+	// Retire of frame which was forgotten by discard does nothing
+	ring.RetireFrames( firstFrame );
+	if ( ring.GetNumFramesInFlight() != 1 )
+	{
+		Errorf( TEXT( "Retire: %u frames in flight, expected 1\n" ), ring.GetNumFramesInFlight() );
+		return false;
+	}
+	return true;
+}
+
+/*
+==================
+CUploadRingTestCommandlet::TestRandomLatency
+==================
+*/
+bool CUploadRingTestCommandlet::TestRandomLatency()
+{
+	const uint32						ringSize = 64 * 1024;
+	CUploadRingAllocator				ring( ringSize );
+	std::vector< UploadRingTestRegion >	regions;
+	uint64								numRetiredFrames = 0;
+	uint32								numWraps = 0;
+	uint32								numDiscards = 0;
+	uint32								seed = 0x9E3779B9;
+
+	for ( uint64 frame = 1; frame <= 10000; ++frame )
+	{
+		// Several viewports may present in one engine frame, so number of allocations varies a lot
+		seed = seed * 1664525 + 1013904223;
+		const uint32	numAllocations = ( seed >> 8 ) % 32;
+		for ( uint32 index = 0; index < numAllocations; ++index )
+		{
+			seed = seed * 1664525 + 1013904223;
+			const uint32			allocationSize = 1 + ( seed >> 8 ) % 4096;
+			const uint32			alignment = ( seed & 1 ) ? UPLOAD_RING_INSTANCE_ALIGNMENT : 12;
+			UploadRingAllocation	allocation;
+			if ( !ring.Allocate( allocationSize, alignment, allocation ) )
+			{
+				Errorf( TEXT( "Random latency: allocation of %u bytes failed\n" ), allocationSize );
+				return false;
+			}
+
+			if ( allocation.offset % alignment != 0 || allocation.offset + allocationSize > ringSize )
+			{
+				Errorf( TEXT( "Random latency: allocation at %u isn't aligned or is out of ring\n" ), allocation.offset );
+				return false;
+			}
+
+			// After discard nothing is in flight in new memory of buffer
+			if ( allocation.bNeedDiscard )
+			{
+				regions.clear();
+				++numDiscards;
+			}
+			numWraps += allocation.bWrapped ? 1 : 0;
+
+			for ( uint32 indexRegion = 0, countRegions = regions.size(); indexRegion < countRegions; ++indexRegion )
+			{
+				const UploadRingTestRegion&		region = regions[ indexRegion ];
+				if ( allocation.offset < region.offset + region.size && region.offset < allocation.offset + allocationSize )
+				{
+					Errorf( TEXT( "Random latency: allocation at %u overlaps memory of frame %i in flight\n" ), allocation.offset, ( uint32 )region.frame );
+					return false;
+				}
+			}
+			regions.push_back( UploadRingTestRegion{ frame, allocation.offset, allocationSize } );
+		}
+
+		// GPU finishes frames with latency from 0 to 5 frames
+		const uint64	endedFrame = ring.EndFrame();
+		seed = seed * 1664525 + 1013904223;
+		const uint64	latency = ( seed >> 8 ) % 6;
+		if ( endedFrame > numRetiredFrames + latency )
+		{
+			numRetiredFrames = endedFrame - latency;
+			ring.RetireFrames( numRetiredFrames );
+			for ( uint32 indexRegion = 0; indexRegion < regions.size(); )
+			{
+				if ( regions[ indexRegion ].frame <= numRetiredFrames )
+				{
+					regions.erase( regions.begin() + indexRegion );
+					continue;
+				}
+				++indexRegion;
+			}
+		}
+	}
+
+	Logf( TEXT( "Random latency: %u wraps, %u discards, no overlaps\n" ), numWraps, numDiscards );
+	return true;
+}
\ No newline at end of file
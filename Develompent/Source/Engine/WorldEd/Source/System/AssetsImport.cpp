@@ -10,6 +10,7 @@
 #include "System/AssetsImport.h"
 #include "System/BaseFileSystem.h"
 #include "Render/RenderUtils.h"
+#include "Render/StaticMeshOptimizer.h"
 #include "WorldEd.h"
 
 CStaticMeshImportSettingsDialog::ImportSettings		CStaticMeshImporter::importSettings;
@@ -223,7 +224,10 @@ bool CStaticMeshImporter::Import( const std::wstring& InPath, std::vector<TShare
 		TSharedPtr<CStaticMesh>		staticMesh = MakeSharedPtr<CStaticMesh>();
 		staticMesh->SetAssetName( CFilename( InPath ).GetBaseFilename() );
 		staticMesh->SetAssetSourceFile( InPath );
-		staticMesh->SetData( verteces, indeces, surfaces, materials );
+		std::vector<StaticMeshLOD>		lods;
+		OptimizeMesh( staticMesh->GetAssetName(), verteces, indeces, surfaces );
+		GenerateLODs( staticMesh->GetAssetName(), verteces, indeces, surfaces, lods );
+		staticMesh->SetData( verteces, indeces, lods, materials, importSettings.vertexFormat );
 		OutResult.push_back( staticMesh );
 	}
 	// Otherwise import separated meshes
@@ -231,16 +235,19 @@ bool CStaticMeshImporter::Import( const std::wstring& InPath, std::vector<TShare
 	{
 		for ( uint32 index = 0, count = meshes.size(); index < count; ++index )
 		{
-			const MeshData&			meshData	= meshes[index];
+			MeshData&				meshData	= meshes[index];
 			TSharedPtr<CStaticMesh>		staticMesh	= MakeSharedPtr<CStaticMesh>();
 			staticMesh->SetAssetName( meshData.name );
 			staticMesh->SetAssetSourceFile( InPath + TEXT( "?" ) + meshData.name );
 
 			std::vector<StaticMeshSurface>			surfaces;
+			std::vector<StaticMeshLOD>				lods;
 			std::vector<TAssetHandle<CMaterial>>	materials;
 			surfaces.push_back( meshData.surface );
 			materials.push_back( meshData.material );
-			staticMesh->SetData( meshData.verteces, meshData.indeces, surfaces, materials );
+			OptimizeMesh( meshData.name, meshData.verteces, meshData.indeces, surfaces );
+			GenerateLODs( meshData.name, meshData.verteces, meshData.indeces, surfaces, lods );
+			staticMesh->SetData( meshData.verteces, meshData.indeces, lods, materials, importSettings.vertexFormat );
 			OutResult.push_back( staticMesh );
 		}
 	}
@@ -289,12 +296,15 @@ bool CStaticMeshImporter::Reimport( const TSharedPtr<CAsset>& InStaticMesh, std:
 
 	Assert( meshes.size() == 1 );		// We support reimport only one mesh
 	
-	const MeshData&						meshData = meshes[0];
+	MeshData&								meshData = meshes[0];
 	std::vector<StaticMeshSurface>			surfaces;
+	std::vector<StaticMeshLOD>				lods;
 	std::vector<TAssetHandle<CMaterial>>	materials;
 	surfaces.push_back( meshData.surface );
 	materials.push_back( meshData.material );
-	staticMesh->SetData( meshData.verteces, meshData.indeces, surfaces, materials );
+	OptimizeMesh( staticMesh->GetAssetName(), meshData.verteces, meshData.indeces, surfaces );
+	GenerateLODs( staticMesh->GetAssetName(), meshData.verteces, meshData.indeces, surfaces, lods );
+	staticMesh->SetData( meshData.verteces, meshData.indeces, lods, materials, importSettings.vertexFormat );
 
 	// Broadcast event of reimport/reloaded asset
 	std::vector< TSharedPtr<CAsset> >		reimportedAssets{ staticMesh };
@@ -465,6 +475,34 @@ bool CStaticMeshImporter::ParseMeshes( const std::wstring& InPath, std::vector<M
 	return true;
 }
 
+/*
+==================
+CStaticMeshImporter::OptimizeMesh
+==================
+*/
+void CStaticMeshImporter::OptimizeMesh( const std::wstring& InMeshName, std::vector<StaticMeshVertexType>& InOutVerteces, std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshSurface>& InSurfaces )
+{
+	if ( !importSettings.bOptimizeMesh )
+	{
+		return;
+	}
+
+	StaticMeshOptimizationStats		stats;
+	CStaticMeshOptimizer::Optimize( InOutVerteces, InOutIndeces, InSurfaces, importSettings.vertexFormat, stats );
+	CStaticMeshOptimizer::LogStats( InMeshName, stats );
+}
+
+/*
+==================
+CStaticMeshImporter::GenerateLODs
+==================
+*/
+void CStaticMeshImporter::GenerateLODs( const std::wstring& InMeshName, const std::vector<StaticMeshVertexType>& InVerteces, std::vector<uint32>& InOutIndeces, const std::vector<StaticMeshSurface>& InSurfaces, std::vector<StaticMeshLOD>& OutLODs )
+{
+	CStaticMeshOptimizer::GenerateLODs( InVerteces, InOutIndeces, InSurfaces, importSettings.numLODs, OutLODs );
+	CStaticMeshOptimizer::LogLODs( InMeshName, OutLODs );
+}
+
 /*
 ==================
 CStaticMeshImporter::GetSupportedExtensions
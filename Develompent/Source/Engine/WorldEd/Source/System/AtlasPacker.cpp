@@ -0,0 +1,181 @@
+#include "Misc/Template.h"
+#include "System/AtlasPacker.h"
+
+/*
+==================
+IsRectContained
+==================
+*/
+FORCEINLINE bool IsRectContained( const RectInt32_t& InA, const RectInt32_t& InB )
+{
+	return InA.left >= InB.left && InA.top >= InB.top && InA.left + InA.width <= InB.left + InB.width && InA.top + InA.height <= InB.top + InB.height;
+}
+
+/*
+==================
+CAtlasPacker::CAtlasPacker
+==================
+*/
+CAtlasPacker::CAtlasPacker()
+	: sizeX( 0 )
+	, sizeY( 0 )
+	, usedSizeX( 0 )
+	, usedSizeY( 0 )
+	, usedArea( 0 )
+{}
+
+/*
+==================
+CAtlasPacker::Init
+==================
+*/
+void CAtlasPacker::Init( uint32 InSizeX, uint32 InSizeY )
+{
+	sizeX		= InSizeX;
+	sizeY		= InSizeY;
+	usedSizeX	= 0;
+	usedSizeY	= 0;
+	usedArea	= 0;
+	freeRects.clear();
+	freeRects.push_back( RectInt32_t( 0, 0, InSizeX, InSizeY ) );
+}
+
+/*
+==================
+CAtlasPacker::Insert
+==================
+*/
+bool CAtlasPacker::Insert( uint32 InSizeX, uint32 InSizeY, RectInt32_t& OutRect )
+{
+	// Find free rectangle by Best Short Side Fit, ties are resolved by long side
+	int32		bestShortSide	= sizeX + sizeY;
+	int32		bestLongSide	= sizeX + sizeY;
+	int32		bestIndex		= -1;
+	for ( uint32 index = 0, count = freeRects.size(); index < count; ++index )
+	{
+		const RectInt32_t&		freeRect = freeRects[index];
+		if ( freeRect.width < ( int32 )InSizeX || freeRect.height < ( int32 )InSizeY )
+		{
+			continue;
+		}
+
+		const int32		leftoverX	= freeRect.width - InSizeX;
+		const int32		leftoverY	= freeRect.height - InSizeY;
+		const int32		shortSide	= Min( leftoverX, leftoverY );
+		const int32		longSide	= Max( leftoverX, leftoverY );
+		if ( shortSide < bestShortSide || ( shortSide == bestShortSide && longSide < bestLongSide ) )
+		{
+			bestShortSide	= shortSide;
+			bestLongSide	= longSide;
+			bestIndex		= index;
+		}
+	}
+
+	if ( bestIndex < 0 )
+	{
+		return false;
+	}
+
+	OutRect = RectInt32_t( freeRects[bestIndex].left, freeRects[bestIndex].top, InSizeX, InSizeY );
+
+	// Split all free rectangles which are intersected with new rectangle
+	for ( uint32 index = 0; index < freeRects.size(); )
+	{
+		if ( SplitFreeRect( freeRects[index], OutRect ) )
+		{
+			freeRects.erase( freeRects.begin() + index );
+		}
+		else
+		{
+			++index;
+		}
+	}
+	PruneFreeRects();
+
+	usedSizeX	= Max<uint32>( usedSizeX, OutRect.left + OutRect.width );
+	usedSizeY	= Max<uint32>( usedSizeY, OutRect.top + OutRect.height );
+	usedArea	+= ( uint64 )InSizeX * InSizeY;
+	return true;
+}
+
+/*
+==================
+CAtlasPacker::SplitFreeRect
+==================
+*/
+bool CAtlasPacker::SplitFreeRect( const RectInt32_t& InFreeRect, const RectInt32_t& InUsedRect )
+{
+	if ( InUsedRect.left >= InFreeRect.left + InFreeRect.width || InUsedRect.left + InUsedRect.width <= InFreeRect.left ||
+		 InUsedRect.top >= InFreeRect.top + InFreeRect.height || InUsedRect.top + InUsedRect.height <= InFreeRect.top )
+	{
+		return false;
+	}
+
+	// Free rectangle is copied because push_back can invalidate reference
+	const RectInt32_t	freeRect = InFreeRect;
+
+	// Parts above and below of used rectangle
+	if ( InUsedRect.top > freeRect.top )
+	{
+		freeRects.push_back( RectInt32_t( freeRect.left, freeRect.top, freeRect.width, InUsedRect.top - freeRect.top ) );
+	}
+
+	if ( InUsedRect.top + InUsedRect.height < freeRect.top + freeRect.height )
+	{
+		const int32		top = InUsedRect.top + InUsedRect.height;
+		freeRects.push_back( RectInt32_t( freeRect.left, top, freeRect.width, freeRect.top + freeRect.height - top ) );
+	}
+
+	// Parts on the left and right of used rectangle
+	if ( InUsedRect.left > freeRect.left )
+	{
+		freeRects.push_back( RectInt32_t( freeRect.left, freeRect.top, InUsedRect.left - freeRect.left, freeRect.height ) );
+	}
+
+	if ( InUsedRect.left + InUsedRect.width < freeRect.left + freeRect.width )
+	{
+		const int32		left = InUsedRect.left + InUsedRect.width;
+		freeRects.push_back( RectInt32_t( left, freeRect.top, freeRect.left + freeRect.width - left, freeRect.height ) );
+	}
+
+	return true;
+}
+
+/*
+==================
+CAtlasPacker::PruneFreeRects
+==================
+*/
+void CAtlasPacker::PruneFreeRects()
+{
+	for ( uint32 indexA = 0; indexA < freeRects.size(); )
+	{
+		bool	bRemovedA = false;
+		for ( uint32 indexB = indexA + 1; indexB < freeRects.size(); )
+		{
+			if ( IsRectContained( freeRects[indexA], freeRects[indexB] ) )
+			{
+				bRemovedA = true;
+				break;
+			}
+
+			if ( IsRectContained( freeRects[indexB], freeRects[indexA] ) )
+			{
+				freeRects.erase( freeRects.begin() + indexB );
+			}
+			else
+			{
+				++indexB;
+			}
+		}
+
+		if ( bRemovedA )
+		{
+			freeRects.erase( freeRects.begin() + indexA );
+		}
+		else
+		{
+			++indexA;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Misc/CoreGlobals.h"
+#include "System/Config.h"
+#include "System/AtlasPacker.h"
+#include "System/TextureAtlasBuilder.h"
+
+/*
+==================
+RoundUpToPowerOfTwo
+==================
+*/
+FORCEINLINE uint32 RoundUpToPowerOfTwo( uint32 InValue )
+{
+	uint32		result = 1;
+	while ( result < InValue )
+	{
+		result <<= 1;
+	}
+	return result;
+}
+
+/*
+==================
+CTextureAtlasBuilder::CTextureAtlasBuilder
+==================
+*/
+CTextureAtlasBuilder::CTextureAtlasBuilder()
+	: bEnabled( false )
+	, maxSize( TEXTUREATLAS_DEFAULT_MAX_SIZE )
+	, padding( TEXTUREATLAS_DEFAULT_PADDING )
+	, alignment( 1 )
+	, numMips( 1 )
+{}
+
+/*
+==================
+CTextureAtlasBuilder::Init
+==================
+*/
+void CTextureAtlasBuilder::Init()
+{
+	CConfigValue	configAtlas = g_Config.GetValue( CT_Editor, TEXT( "Editor.CookPackages" ), TEXT( "Atlas" ) );
+	bEnabled	= false;
+	maxSize		= TEXTUREATLAS_DEFAULT_MAX_SIZE;
+	padding		= TEXTUREATLAS_DEFAULT_PADDING;
+	if ( configAtlas.IsValid() )
+	{
+		CConfigObject	objectAtlas = configAtlas.GetObject();
+		bEnabled = objectAtlas.GetValue( TEXT( "Enable" ) ).GetBool();
+
+		CConfigValue	configMaxSize = objectAtlas.GetValue( TEXT( "MaxSize" ) );
+		if ( configMaxSize.IsValid() )
+		{
+			maxSize = RoundUpToPowerOfTwo( Max( configMaxSize.GetInt(), TEXTUREATLAS_MIN_SIZE ) );
+		}
+
+		CConfigValue	configPadding = objectAtlas.GetValue( TEXT( "Padding" ) );
+		if ( configPadding.IsValid() )
+		{
+			padding = Max( configPadding.GetInt(), 0 );
+		}
+	}
+
+	// Mip N of box filter averages aligned blocks of 2^N texels, so blocks must not cross padding of image
+	numMips = 1;
+	while ( ( 1u << numMips ) <= padding )
+	{
+		++numMips;
+	}
+	alignment = 1 << ( numMips - 1 );
+
+	Reset();
+}
+
+/*
+==================
+CTextureAtlasBuilder::Reset
+==================
+*/
+void CTextureAtlasBuilder::Reset()
+{
+	images.clear();
+	entries.clear();
+	pages.clear();
+}
+
+/*
+==================
+CTextureAtlasBuilder::IsFit
+==================
+*/
+bool CTextureAtlasBuilder::IsFit( uint32 InSizeX, uint32 InSizeY ) const
+{
+	return GetPaddedSize( InSizeX ) <= maxSize && GetPaddedSize( InSizeY ) <= maxSize;
+}
+
+/*
+==================
+CTextureAtlasBuilder::AddImage
+==================
+*/
+uint32 CTextureAtlasBuilder::AddImage( const byte* InTexels, uint32 InSizeX, const RectInt32_t& InRect )
+{
+	Assert( InTexels && InRect.width > 0 && InRect.height > 0 && IsFit( InRect.width, InRect.height ) );
+
+	Image		image;
+	image.sizeX = InRect.width;
+	image.sizeY = InRect.height;
+	image.texels.resize( image.sizeX * image.sizeY * 4 );
+	for ( uint32 y = 0; y < image.sizeY; ++y )
+	{
+		memcpy( image.texels.data() + y * image.sizeX * 4, InTexels + ( ( InRect.top + y ) * InSizeX + InRect.left ) * 4, image.sizeX * 4 );
+	}
+
+	images.push_back( image );
+	return images.size() - 1;
+}
+
+/*
+==================
+CTextureAtlasBuilder::Build
+==================
+*/
+void CTextureAtlasBuilder::Build()
+{
+	entries.clear();
+	pages.clear();
+	entries.resize( images.size() );
+
+	// Big images are placed first, it gives more dense packing
+	std::vector<uint32>		order( images.size() );
+	for ( uint32 index = 0, count = images.size(); index < count; ++index )
+	{
+		order[index] = index;
+	}
+
+	std::stable_sort( order.begin(), order.end(), [&]( uint32 InA, uint32 InB )
+	{
+		const Image&	imageA = images[InA];
+		const Image&	imageB = images[InB];
+		return Max( imageA.sizeX, imageA.sizeY ) > Max( imageB.sizeX, imageB.sizeY );
+	} );
+
+	// Pack images page by page. Page starts from size which fits total area of remaining images
+	// and grows until all of them are placed or max size is reached, rest of images go to the next page
+	std::vector<RectInt32_t>		placements( images.size() );
+	std::vector<uint32>				remaining = order;
+	while ( !remaining.empty() )
+	{
+		uint64		remainingArea = 0;
+		for ( uint32 index = 0, count = remaining.size(); index < count; ++index )
+		{
+			const Image&	image = images[remaining[index]];
+			remainingArea += ( uint64 )GetPaddedSize( image.sizeX ) * GetPaddedSize( image.sizeY );
+		}
+
+		uint32		sizeX = Clamp<uint32>( RoundUpToPowerOfTwo( ( uint32 )ceil( sqrt( ( double )remainingArea ) ) ), TEXTUREATLAS_MIN_SIZE, maxSize );
+		uint32		sizeY = Max<uint32>( sizeX / 2, TEXTUREATLAS_MIN_SIZE );
+		CAtlasPacker			packer;
+		std::vector<uint32>		notPlaced;
+		for ( ;; )
+		{
+			packer.Init( sizeX, sizeY );
+			notPlaced.clear();
+			for ( uint32 index = 0, count = remaining.size(); index < count; ++index )
+			{
+				const uint32	imageIndex = remaining[index];
+				if ( !packer.Insert( GetPaddedSize( images[imageIndex].sizeX ), GetPaddedSize( images[imageIndex].sizeY ), placements[imageIndex] ) )
+				{
+					notPlaced.push_back( imageIndex );
+				}
+			}
+
+			if ( notPlaced.empty() || ( sizeX >= maxSize && sizeY >= maxSize ) )
+			{
+				break;
+			}
+
+			if ( sizeY < sizeX )
+			{
+				sizeY *= 2;
+			}
+			else
+			{
+				sizeX *= 2;
+			}
+		}
+		Assert( notPlaced.size() < remaining.size() );
+
+		// Page is shrinked to used size
+		const uint32		pageIndex = pages.size();
+		pages.push_back( TextureAtlasPage() );
+		TextureAtlasPage&	page = pages.back();
+		page.sizeX	= Max<uint32>( RoundUpToPowerOfTwo( packer.GetUsedSizeX() ), TEXTUREATLAS_MIN_SIZE );
+		page.sizeY	= Max<uint32>( RoundUpToPowerOfTwo( packer.GetUsedSizeY() ), TEXTUREATLAS_MIN_SIZE );
+		page.texels.resize( page.sizeX * page.sizeY * 4 );
+		Sys_Memzero( page.texels.data(), page.texels.size() );
+
+		for ( uint32 index = 0, count = remaining.size(); index < count; ++index )
+		{
+			if ( std::find( notPlaced.begin(), notPlaced.end(), remaining[index] ) == notPlaced.end() )
+			{
+				entries[remaining[index]].pageIndex = pageIndex;
+			}
+		}
+		remaining.swap( notPlaced );
+	}
+
+	// Copy images to pages and calculate texture rects
+	for ( uint32 imageIndex = 0, count = images.size(); imageIndex < count; ++imageIndex )
+	{
+		const Image&		image		= images[imageIndex];
+		const RectInt32_t&	placement	= placements[imageIndex];
+		TextureAtlasEntry&	entry		= entries[imageIndex];
+		TextureAtlasPage&	page		= pages[entry.pageIndex];
+		BlitImage( image, placement, page );
+
+		entry.textureRect.left		= ( float )( placement.left + padding ) / page.sizeX;
+		entry.textureRect.top		= ( float )( placement.top + padding ) / page.sizeY;
+		entry.textureRect.width		= ( float )image.sizeX / page.sizeX;
+		entry.textureRect.height	= ( float )image.sizeY / page.sizeY;
+		page.usedArea				+= ( uint64 )image.sizeX * image.sizeY;
+	}
+}
+
+/*
+==================
+CTextureAtlasBuilder::BlitImage
+==================
+*/
+void CTextureAtlasBuilder::BlitImage( const Image& InImage, const RectInt32_t& InRect, TextureAtlasPage& InOutPage ) const
+{
+	// Texels of padding are taken from nearest edge of image
+	for ( int32 y = 0; y < InRect.height; ++y )
+	{
+		const uint32	srcY	= Clamp<int32>( y - ( int32 )padding, 0, InImage.sizeY - 1 );
+		const byte*		srcRow	= InImage.texels.data() + srcY * InImage.sizeX * 4;
+		byte*			dstRow	= InOutPage.texels.data() + ( ( InRect.top + y ) * InOutPage.sizeX + InRect.left ) * 4;
+		for ( int32 x = 0; x < InRect.width; ++x )
+		{
+			const uint32	srcX = Clamp<int32>( x - ( int32 )padding, 0, InImage.sizeX - 1 );
+			memcpy( dstRow + x * 4, srcRow + srcX * 4, 4 );
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,474 @@
+#include <compressonator.h>
+
+#include "Containers/String.h"
+#include "Misc/CoreGlobals.h"
+#include "Misc/Misc.h"
+#include "Misc/Template.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Archive.h"
+#include "System/BaseFileSystem.h"
+#include "System/Config.h"
+#include "System/ThreadPool.h"
+#include "System/TextureCompressor.h"
+#include "Render/RenderUtils.h"
+
+/** Table of texture usage names */
+static const std::pair<const tchar*, ETextureUsage>						s_TextureUsageNames[] =
+{
+	{ TEXT( "Auto" ),			TU_Auto				},
+	{ TEXT( "Color" ),			TU_Color			},
+	{ TEXT( "ColorAlpha" ),		TU_ColorAlpha		},
+	{ TEXT( "NormalMap" ),		TU_NormalMap		},
+	{ TEXT( "Mask" ),			TU_Mask				},
+	{ TEXT( "Uncompressed" ),	TU_Uncompressed		}
+};
+static_assert( ARRAY_COUNT( s_TextureUsageNames ) == TU_Max, "Need full init s_TextureUsageNames array" );
+
+/** Table of compression quality names */
+static const std::pair<const tchar*, ETextureCompressionQuality>		s_CompressionQualityNames[] =
+{
+	{ TEXT( "Fast" ),			TCQ_Fast		},
+	{ TEXT( "Normal" ),			TCQ_Normal		},
+	{ TEXT( "High" ),			TCQ_High		}
+};
+static_assert( ARRAY_COUNT( s_CompressionQualityNames ) == TCQ_Max, "Need full init s_CompressionQualityNames array" );
+
+/** Quality of encoding in Compressonator for each preset */
+static const float		s_CompressionQualityValues[] =
+{
+	0.05f,		// TCQ_Fast
+	0.5f,		// TCQ_Normal
+	1.f			// TCQ_High
+};
+static_assert( ARRAY_COUNT( s_CompressionQualityValues ) == TCQ_Max, "Need full init s_CompressionQualityValues array" );
+
+/** Speed of encoding in Compressonator for each preset */
+static const CMP_Speed	s_CompressionSpeeds[] =
+{
+	CMP_Speed_SuperFast,	// TCQ_Fast
+	CMP_Speed_Fast,			// TCQ_Normal
+	CMP_Speed_Normal		// TCQ_High
+};
+static_assert( ARRAY_COUNT( s_CompressionSpeeds ) == TCQ_Max, "Need full init s_CompressionSpeeds array" );
+
+/*
+==================
+TextToTextureUsage
+==================
+*/
+static ETextureUsage TextToTextureUsage( const std::wstring& InString )
+{
+	for ( uint32 index = 0; index < TU_Max; ++index )
+	{
+		if ( InString == s_TextureUsageNames[index].first )
+		{
+			return s_TextureUsageNames[index].second;
+		}
+	}
+
+	Warnf( TEXT( "Unknown texture usage '%s', used 'Auto'\n" ), InString.c_str() );
+	return TU_Auto;
+}
+
+/*
+==================
+TextToCompressionQuality
+==================
+*/
+static ETextureCompressionQuality TextToCompressionQuality( const std::wstring& InString )
+{
+	for ( uint32 index = 0; index < TCQ_Max; ++index )
+	{
+		if ( InString == s_CompressionQualityNames[index].first )
+		{
+			return s_CompressionQualityNames[index].second;
+		}
+	}
+
+	Warnf( TEXT( "Unknown texture compression quality '%s', used 'Normal'\n" ), InString.c_str() );
+	return TCQ_Normal;
+}
+
+/*
+==================
+ConvertEPixelFormatToCmpFormat
+==================
+*/
+static CMP_FORMAT ConvertEPixelFormatToCmpFormat( EPixelFormat InPixelFormat )
+{
+	switch ( InPixelFormat )
+	{
+	case PF_BC1:				return CMP_FORMAT_BC1;
+	case PF_BC3:				return CMP_FORMAT_BC3;
+	case PF_BC4:				return CMP_FORMAT_BC4;
+	case PF_BC5:				return CMP_FORMAT_BC5;
+	case PF_BC7:				return CMP_FORMAT_BC7;
+	default:
+		Sys_Errorf( TEXT( "Unsupported compressed EPixelFormat %i" ), ( uint32 )InPixelFormat );
+		return CMP_FORMAT_Unknown;
+	}
+}
+
+/*
+==================
+CTextureCompressor::CTextureCompressor
+==================
+*/
+CTextureCompressor::CTextureCompressor()
+	: bEnabled( false )
+	, quality( TCQ_Normal )
+{}
+
+/*
+==================
+CTextureCompressor::Init
+==================
+*/
+void CTextureCompressor::Init( const std::wstring& InQualityOverride /* = TEXT( "" ) */ )
+{
+	bEnabled = false;
+	quality = TCQ_Normal;
+	cacheDir.clear();
+	usageSufixes.clear();
+
+	CConfigValue	configTextureCompression = g_Config.GetValue( CT_Editor, TEXT( "Editor.CookPackages" ), TEXT( "TextureCompression" ) );
+	if ( configTextureCompression.IsValid() )
+	{
+		CConfigObject	objectTextureCompression = configTextureCompression.GetObject();
+		bEnabled = objectTextureCompression.GetValue( TEXT( "Enable" ) ).GetBool();
+
+		std::wstring	qualityName = objectTextureCompression.GetValue( TEXT( "Quality" ) ).GetString();
+		if ( !qualityName.empty() )
+		{
+			quality = TextToCompressionQuality( qualityName );
+		}
+
+		// Cache is disabled if directory is empty
+		CConfigValue	configCacheDir = objectTextureCompression.GetValue( TEXT( "CacheDir" ) );
+		cacheDir = configCacheDir.IsValid() ? configCacheDir.GetString() : TEXTURECOMPRESSOR_DEFAULT_CACHE_DIR;
+		if ( !cacheDir.empty() )
+		{
+			cacheDir = Sys_BaseDir() + cacheDir;
+		}
+
+		// Sufixes of texture names for select usage
+		std::vector<CConfigValue>	configUsageSufixes = objectTextureCompression.GetValue( TEXT( "UsageSufixes" ) ).GetArray();
+		for ( uint32 index = 0, count = configUsageSufixes.size(); index < count; ++index )
+		{
+			const CConfigValue&		configUsageSufixItem = configUsageSufixes[index];
+			Assert( configUsageSufixItem.GetType() == CConfigValue::T_Object );
+			CConfigObject			objectUsageSufix = configUsageSufixItem.GetObject();
+
+			std::wstring		sufix = objectUsageSufix.GetValue( TEXT( "Sufix" ) ).GetString();
+			if ( !sufix.empty() )
+			{
+				usageSufixes.push_back( std::make_pair( sufix, TextToTextureUsage( objectUsageSufix.GetValue( TEXT( "Usage" ) ).GetString() ) ) );
+			}
+		}
+	}
+
+	if ( !InQualityOverride.empty() )
+	{
+		quality = TextToCompressionQuality( InQualityOverride );
+	}
+
+	if ( bEnabled && !cacheDir.empty() && !g_FileSystem->IsExistFile( cacheDir, true ) )
+	{
+		g_FileSystem->MakeDirectory( cacheDir, true );
+	}
+
+	Logf( TEXT( "Texture compression: %s, quality '%s', cache '%s'\n" ), bEnabled ? TEXT( "enabled" ) : TEXT( "disabled" ), s_CompressionQualityNames[quality].first, cacheDir.empty() ? TEXT( "disabled" ) : cacheDir.c_str() );
+}
+
+/*
+==================
+CTextureCompressor::GetUsageByName
+==================
+*/
+ETextureUsage CTextureCompressor::GetUsageByName( const std::wstring& InTextureName ) const
+{
+	for ( uint32 index = 0, count = usageSufixes.size(); index < count; ++index )
+	{
+		const std::wstring&		sufix = usageSufixes[index].first;
+		if ( InTextureName.size() >= sufix.size() && InTextureName.compare( InTextureName.size() - sufix.size(), sufix.size(), sufix ) == 0 )
+		{
+			return usageSufixes[index].second;
+		}
+	}
+
+	return TU_Auto;
+}
+
+/*
+==================
+CTextureCompressor::Compress
+==================
+*/
+bool CTextureCompressor::Compress( CTexture2D* InOutTexture, ETextureUsage InUsage, TextureCompressionStats& OutStats )
+{
+	Assert( InOutTexture );
+	OutStats = TextureCompressionStats();
+	if ( !bEnabled || InUsage == TU_Uncompressed || InOutTexture->GetPixelFormat() != PF_A8R8G8B8 || InOutTexture->GetNumMips() == 0 )
+	{
+		return false;
+	}
+
+	// D3D11 requires size of top mip multiple of block size
+	const uint32	sizeX = InOutTexture->GetSizeX();
+	const uint32	sizeY = InOutTexture->GetSizeY();
+	if ( sizeX % 4 != 0 || sizeY % 4 != 0 )
+	{
+		Warnf( TEXT( "Texture '%s' has size %ix%i which is not multiple of 4, it isn't compressed\n" ), InOutTexture->GetAssetName().c_str(), sizeX, sizeY );
+		return false;
+	}
+
+	const double	startTime = Sys_Seconds();
+	if ( InUsage == TU_Auto )
+	{
+		InUsage = DetectColorUsage( InOutTexture->GetMip( 0 ) );
+	}
+
+	std::vector<Texture2DMipMap>	sourceMips;
+	for ( uint32 index = 0, count = InOutTexture->GetNumMips(); index < count; ++index )
+	{
+		sourceMips.push_back( InOutTexture->GetMip( index ) );
+		OutStats.numBytesBefore += sourceMips[index].data.Num();
+	}
+
+	// Try to find texture in cache, else compress it and put to cache
+	OutStats.pixelFormat = GetPixelFormat( InUsage, quality );
+	std::vector<Texture2DMipMap>	compressedMips;
+	uint64							cacheKey = CalcCacheKey( sourceMips, OutStats.pixelFormat );
+	OutStats.bCached = !cacheDir.empty() && LoadFromCache( cacheKey, compressedMips );
+	if ( !OutStats.bCached )
+	{
+		compressedMips.resize( sourceMips.size() );
+		for ( uint32 index = 0, count = sourceMips.size(); index < count; ++index )
+		{
+			CompressMip( sourceMips[index], OutStats.pixelFormat, compressedMips[index] );
+		}
+
+		if ( !cacheDir.empty() )
+		{
+			SaveToCache( cacheKey, compressedMips );
+		}
+	}
+
+	for ( uint32 index = 0, count = compressedMips.size(); index < count; ++index )
+	{
+		OutStats.numBytesAfter += compressedMips[index].data.Num();
+	}
+
+	InOutTexture->SetMipmaps( OutStats.pixelFormat, compressedMips );
+	OutStats.encodeTime = Sys_Seconds() - startTime;
+	return true;
+}
+
+/*
+==================
+CTextureCompressor::CompressMip
+==================
+*/
+void CTextureCompressor::CompressMip( const Texture2DMipMap& InMip, EPixelFormat InPixelFormat, Texture2DMipMap& OutMip ) const
+{
+	const PixelFormatInfo&		formatInfo	= g_PixelFormats[InPixelFormat];
+	const CMP_FORMAT			cmpFormat	= ConvertEPixelFormatToCmpFormat( InPixelFormat );
+	const uint32				numBlocksX	= ( InMip.sizeX + formatInfo.blockSizeX - 1 ) / formatInfo.blockSizeX;
+	const uint32				numBlocksY	= ( InMip.sizeY + formatInfo.blockSizeY - 1 ) / formatInfo.blockSizeY;
+	const uint32				numJobs		= ( numBlocksY + TEXTURECOMPRESSOR_JOB_NUM_BLOCK_ROWS - 1 ) / TEXTURECOMPRESSOR_JOB_NUM_BLOCK_ROWS;
+	const byte*					srcTexels	= InMip.data.GetData();
+	Assert( InMip.data.Num() == InMip.sizeX * InMip.sizeY * g_PixelFormats[PF_A8R8G8B8].blockBytes );
+
+	OutMip.sizeX = InMip.sizeX;
+	OutMip.sizeY = InMip.sizeY;
+	OutMip.data.Resize( numBlocksX * numBlocksY * formatInfo.blockBytes );
+	byte*						dstBlocks	= OutMip.data.GetData();
+
+	// Compressonator threads are disabled, all parallel work is done by our thread pool
+	CMP_CompressOptions			options;
+	Sys_Memzero( &options, sizeof( CMP_CompressOptions ) );
+	options.dwSize					= sizeof( CMP_CompressOptions );
+	options.fquality				= s_CompressionQualityValues[quality];
+	options.nCompressionSpeed		= s_CompressionSpeeds[quality];
+	options.bDisableMultiThreading	= true;
+	options.dwnumThreads			= 1;
+
+	g_ThreadPool.ParallelFor( numJobs, [&]( uint32 InJobIndex )
+	{
+		const uint32	firstBlockRow	= InJobIndex * TEXTURECOMPRESSOR_JOB_NUM_BLOCK_ROWS;
+		const uint32	numBlockRows	= Min<uint32>( TEXTURECOMPRESSOR_JOB_NUM_BLOCK_ROWS, numBlocksY - firstBlockRow );
+		const uint32	jobSizeX		= numBlocksX * formatInfo.blockSizeX;
+		const uint32	jobSizeY		= numBlockRows * formatInfo.blockSizeY;
+		const uint32	texelSize		= g_PixelFormats[PF_A8R8G8B8].blockBytes;
+
+		// Copy texels of the job, edge texels are repeated for mips which is smaller then block
+		std::vector<byte>	texels( jobSizeX * jobSizeY * texelSize );
+		for ( uint32 y = 0; y < jobSizeY; ++y )
+		{
+			const uint32	srcY		= Min( firstBlockRow * formatInfo.blockSizeY + y, InMip.sizeY - 1 );
+			const byte*		srcRow		= srcTexels + srcY * InMip.sizeX * texelSize;
+			byte*			dstRow		= texels.data() + y * jobSizeX * texelSize;
+			memcpy( dstRow, srcRow, InMip.sizeX * texelSize );
+			for ( uint32 x = InMip.sizeX; x < jobSizeX; ++x )
+			{
+				memcpy( dstRow + x * texelSize, srcRow + ( InMip.sizeX - 1 ) * texelSize, texelSize );
+			}
+		}
+
+		CMP_Texture		srcTexture;
+		Sys_Memzero( &srcTexture, sizeof( CMP_Texture ) );
+		srcTexture.dwSize		= sizeof( CMP_Texture );
+		srcTexture.dwWidth		= jobSizeX;
+		srcTexture.dwHeight		= jobSizeY;
+		srcTexture.dwPitch		= jobSizeX * texelSize;
+		srcTexture.format		= CMP_FORMAT_RGBA_8888;
+		srcTexture.dwDataSize	= texels.size();
+		srcTexture.pData		= texels.data();
+
+		CMP_Texture		dstTexture;
+		Sys_Memzero( &dstTexture, sizeof( CMP_Texture ) );
+		dstTexture.dwSize		= sizeof( CMP_Texture );
+		dstTexture.dwWidth		= jobSizeX;
+		dstTexture.dwHeight		= jobSizeY;
+		dstTexture.format		= cmpFormat;
+		dstTexture.dwDataSize	= numBlocksX * numBlockRows * formatInfo.blockBytes;
+		dstTexture.pData		= dstBlocks + firstBlockRow * numBlocksX * formatInfo.blockBytes;
+
+		CMP_ERROR		result = CMP_ConvertTexture( &srcTexture, &dstTexture, &options, nullptr );
+		AssertMsg( result == CMP_OK, TEXT( "Failed compress texture to %s, error %i" ), formatInfo.name, ( uint32 )result );
+	} );
+}
+
+/*
+==================
+CTextureCompressor::GetPixelFormat
+==================
+*/
+EPixelFormat CTextureCompressor::GetPixelFormat( ETextureUsage InUsage, ETextureCompressionQuality InQuality )
+{
+	switch ( InUsage )
+	{
+	case TU_Color:			return InQuality == TCQ_High ? PF_BC7 : PF_BC1;
+	case TU_ColorAlpha:		return InQuality == TCQ_High ? PF_BC7 : PF_BC3;
+	case TU_NormalMap:		return PF_BC5;
+	case TU_Mask:			return PF_BC4;
+	case TU_Uncompressed:	return PF_A8R8G8B8;
+
+	case TU_Auto:
+	default:
+		Sys_Errorf( TEXT( "Unsupported ETextureUsage %i" ), ( uint32 )InUsage );
+		return PF_Unknown;
+	}
+}
+
+/*
+==================
+CTextureCompressor::DetectColorUsage
+==================
+*/
+ETextureUsage CTextureCompressor::DetectColorUsage( const Texture2DMipMap& InMip )
+{
+	const byte*		texels		= InMip.data.GetData();
+	const uint32	numTexels	= InMip.data.Num() / g_PixelFormats[PF_A8R8G8B8].blockBytes;
+	for ( uint32 index = 0; index < numTexels; ++index )
+	{
+		// Alpha is the last byte of texel
+		if ( texels[index * 4 + 3] != 255 )
+		{
+			return TU_ColorAlpha;
+		}
+	}
+
+	return TU_Color;
+}
+
+/*
+==================
+CTextureCompressor::CalcCacheKey
+==================
+*/
+uint64 CTextureCompressor::CalcCacheKey( const std::vector<Texture2DMipMap>& InMips, EPixelFormat InPixelFormat ) const
+{
+	uint64		hash = Sys_MemFastHash( ( uint32 )TEXTURECOMPRESSOR_VERSION );
+	hash = Sys_MemFastHash( ( uint32 )InPixelFormat, hash );
+	hash = Sys_MemFastHash( ( uint32 )quality, hash );
+	for ( uint32 index = 0, count = InMips.size(); index < count; ++index )
+	{
+		const Texture2DMipMap&		mip = InMips[index];
+		hash = Sys_MemFastHash( mip.sizeX, hash );
+		hash = Sys_MemFastHash( mip.sizeY, hash );
+		hash = Sys_MemFastHash( mip.data.GetData(), mip.data.Num(), hash );
+	}
+	return hash;
+}
+
+/*
+==================
+CTextureCompressor::GetCachePath
+==================
+*/
+std::wstring CTextureCompressor::GetCachePath( uint64 InKey ) const
+{
+	return CString::Format( TEXT( "%s" ) PATH_SEPARATOR TEXT( "%016llX.%s" ), cacheDir.c_str(), InKey, TEXTURECOMPRESSOR_CACHE_EXTENSION );
+}
+
+/*
+==================
+CTextureCompressor::LoadFromCache
+==================
+*/
+bool CTextureCompressor::LoadFromCache( uint64 InKey, std::vector<Texture2DMipMap>& OutMips ) const
+{
+	CArchive*		archive = g_FileSystem->CreateFileReader( GetCachePath( InKey ) );
+	if ( !archive )
+	{
+		return false;
+	}
+
+	archive->SerializeHeader();
+	if ( archive->Type() != AT_TextureCache )
+	{
+		delete archive;
+		return false;
+	}
+
+	*archive << OutMips;
+	delete archive;
+	return !OutMips.empty();
+}
+
+/*
+==================
+CTextureCompressor::SaveToCache
+==================
+*/
+void CTextureCompressor::SaveToCache( uint64 InKey, std::vector<Texture2DMipMap>& InMips ) const
+{
+	CArchive*		archive = g_FileSystem->CreateFileWriter( GetCachePath( InKey ) );
+	if ( !archive )
+	{
+		Warnf( TEXT( "Failed to save compressed texture to cache '%s'\n" ), GetCachePath( InKey ).c_str() );
+		return;
+	}
+
+	archive->SetType( AT_TextureCache );
+	archive->SerializeHeader();
+	*archive << InMips;
+	delete archive;
+}
+
+/*
+==================
+CTextureCompressor::LogStats
+==================
+*/
+void CTextureCompressor::LogStats( const std::wstring& InTextureName, const TextureCompressionStats& InStats )
+{
+	Logf( TEXT( "Compressed texture '%s' to %s in %.2f ms%s: %.2f Kb -> %.2f Kb (ratio %.2f:1)\n" ),
+		  InTextureName.c_str(),
+		  g_PixelFormats[InStats.pixelFormat].name,
+		  InStats.encodeTime * 1000.0,
+		  InStats.bCached ? TEXT( " (from cache)" ) : TEXT( "" ),
+		  InStats.numBytesBefore / 1024.f, InStats.numBytesAfter / 1024.f,
+		  InStats.GetRatio() );
+}
\ No newline at end of file
@@ -13,6 +13,15 @@ static const achar* s_AxisUpNames[] =
 };
 static_assert( ARRAY_COUNT( s_AxisUpNames ) == CStaticMeshImportSettingsDialog::AU_Num, "Need full init s_AxisUpNames array" );
 
+/** Table names of static mesh vertex formats */
+static const achar* s_VertexFormatNames[] =
+{
+	"Compact (24 bytes)",		// SMVF_Compact
+	"Quantized (20 bytes)",		// SMVF_Quantized
+	"Full (72 bytes)"			// SMVF_Full
+};
+static_assert( ARRAY_COUNT( s_VertexFormatNames ) == SMVF_Num, "Need full init s_VertexFormatNames array" );
+
 /*
 ==================
 CStaticMeshImportSettingsDialog::CStaticMeshImportSettingsDialog
@@ -63,6 +72,53 @@ void CStaticMeshImportSettingsDialog::OnTick()
 			{
 				importSettings.axisUp = ( EAxisUp )axisUp;
 			}
+			ImGui::NextColumn();
+		}
+
+		// Vertex format
+		{
+			ImGui::Text( "Vertex Format:" );
+			if ( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+			{
+				ImGui::SetTooltip( "Vertex format in GPU memory. Quantized stores position in 16 bits relative to bounds of mesh, Full keeps float precision of all attributes" );
+			}
+
+			ImGui::NextColumn();
+			int32	vertexFormat = importSettings.vertexFormat;
+			if ( ImGui::Combo( "##VertexFormat", &vertexFormat, s_VertexFormatNames, ARRAY_COUNT( s_VertexFormatNames ) ) )
+			{
+				importSettings.vertexFormat = ( EStaticMeshVertexFormat )vertexFormat;
+			}
+			ImGui::NextColumn();
+		}
+
+		// Optimize mesh
+		{
+			ImGui::Text( "Optimize Mesh:" );
+			if ( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+			{
+				ImGui::SetTooltip( "If enabled, removes duplicate verteces and reorders triangles and verteces for vertex cache, overdraw and vertex fetch" );
+			}
+
+			ImGui::NextColumn();
+			ImGui::Checkbox( "##OptimizeMesh", &importSettings.bOptimizeMesh );
+			ImGui::NextColumn();
+		}
+
+		// Number of LODs
+		{
+			ImGui::Text( "Number Of LODs:" );
+			if ( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+			{
+				ImGui::SetTooltip( "Number of LODs (include full resolution mesh). Every next LOD has half of triangles and is used at half of screen size" );
+			}
+
+			ImGui::NextColumn();
+			int32	numLODs = importSettings.numLODs;
+			if ( ImGui::SliderInt( "##NumLODs", &numLODs, 1, STATICMESH_MAX_LODS ) )
+			{
+				importSettings.numLODs = numLODs;
+			}
 		}
 		ImGui::EndColumns();
 	}
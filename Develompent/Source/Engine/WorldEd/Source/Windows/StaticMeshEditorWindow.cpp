@@ -142,19 +142,35 @@ void CStaticMeshEditorWindow::OnTick()
 		ImGui::TableNextColumn();
 		ImGui::Text( "Vertices:" );
 		ImGui::TableNextColumn();
-		ImGui::Text( std::to_string( staticMesh->GetVerteces().Num() ).c_str() );
+		ImGui::Text( std::to_string( staticMesh->GetNumVerteces() ).c_str() );
+		ImGui::TableNextColumn();
+
+		// Draw vertex format
+		ImGui::Text( "Vertex Format:" );
+		ImGui::TableNextColumn();
+		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%s (%i bytes)" ), GetStaticMeshVertexFormatName( staticMesh->GetVertexFormat() ), GetStaticMeshVertexStride( staticMesh->GetVertexFormat() ) ).c_str() ) );
 		ImGui::TableNextColumn();
 
 		// Draw texture format
 		ImGui::Text( "Triangles:" );
 		ImGui::TableNextColumn();
-		ImGui::Text( std::to_string( staticMesh->GetIndeces().Num() / 3 ).c_str() );
+		ImGui::Text( std::to_string( staticMesh->GetLOD( 0 ).GetNumPrimitives() ).c_str() );
 		ImGui::TableNextColumn();
 
+		// LODs
+		for ( uint32 indexLOD = 1, numLODs = staticMesh->GetNumLODs(); indexLOD < numLODs; ++indexLOD )
+		{
+			const StaticMeshLOD&	lod = staticMesh->GetLOD( indexLOD );
+			ImGui::Text( "LOD %i:", indexLOD );
+			ImGui::TableNextColumn();
+			ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%i triangles, screen size %.3f" ), lod.GetNumPrimitives(), lod.screenSize ).c_str() ) );
+			ImGui::TableNextColumn();
+		}
+
 		// Resource size
 		ImGui::Text( "Resource Size:" );
 		ImGui::TableNextColumn();
-		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%.2f Kb" ), ( staticMesh->GetVerteces().Num() * sizeof( StaticMeshVertexType ) + staticMesh->GetIndeces().Num() * sizeof( uint32 ) ) / 1024.f ).c_str() ) );
+		ImGui::Text( TCHAR_TO_ANSI( CString::Format( TEXT( "%.2f Kb" ), ( staticMesh->GetVertexData().Num() + staticMesh->GetIndeces().Num() * GetStaticMeshIndexStride( staticMesh->GetNumVerteces() ) ) / 1024.f ).c_str() ) );
 		ImGui::EndTable();
 	}
 
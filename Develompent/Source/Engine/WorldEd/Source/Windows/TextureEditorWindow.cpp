@@ -32,6 +32,14 @@ static const achar*		s_SamplerFilterNames[] =
 };
 static_assert( ARRAY_COUNT( s_SamplerFilterNames ) == SF_Max, "Need full init s_SamplerFilterNames array" );
 
+/** Table names of mip filter */
+static const achar*		s_MipFilterNames[] =
+{
+	"Box",		// MF_Box
+	"Kaiser"	// MF_Kaiser
+};
+static_assert( ARRAY_COUNT( s_MipFilterNames ) == MF_Max, "Need full init s_MipFilterNames array" );
+
 /** Macro size button in menu bar */
 #define  TEXTUREEDITOR_MENUBAR_BUTTONSIZE	ImVec2( 16.f, 16.f )
 
@@ -248,10 +256,50 @@ void CTextureEditorWindow::OnTick()
 	ImGui::Spacing();
 	if ( ImGui::CollapsingHeader( "Mipmap", ImGuiTreeNodeFlags_DefaultOpen ) )
 	{
+		if ( ImGui::BeginTable( "##MipmapTable", 2 ) )
+		{
+			// Filter of mipmaps
+			ImGui::TableNextColumn();
+			ImGui::Text( "Filter:" );
+			ImGui::TableNextColumn();
+
+			int32	mipFilter = mipSettings.filter;
+			if ( ImGui::Combo( "##MipFilter", &mipFilter, s_MipFilterNames, ARRAY_COUNT( s_MipFilterNames ) ) )
+			{
+				mipSettings.filter = ( EMipFilter )mipFilter;
+			}
+			ImGui::TableNextColumn();
+
+			// sRGB
+			ImGui::Text( "sRGB:" );
+			ImGui::TableNextColumn();
+			ImGui::Checkbox( "##MipSRGB", &mipSettings.bSRGB );
+			ImGui::TableNextColumn();
+
+			// Premultiplied alpha
+			ImGui::Text( "Premultiplied Alpha:" );
+			ImGui::TableNextColumn();
+			ImGui::Checkbox( "##MipPremultipliedAlpha", &mipSettings.bPremultipliedAlpha );
+			ImGui::TableNextColumn();
+
+			// Preserve alpha coverage
+			ImGui::Text( "Preserve Alpha Coverage:" );
+			ImGui::TableNextColumn();
+			ImGui::Checkbox( "##MipPreserveAlphaCoverage", &mipSettings.bPreserveAlphaCoverage );
+			if ( mipSettings.bPreserveAlphaCoverage )
+			{
+				ImGui::TableNextColumn();
+				ImGui::Text( "Alpha Threshold:" );
+				ImGui::TableNextColumn();
+				ImGui::SliderFloat( "##MipAlphaThreshold", &mipSettings.alphaCoverageThreshold, 0.f, 1.f );
+			}
+			ImGui::EndTable();
+		}
+
 		// Generate mipmaps
 		if ( ImGui::Button( "Generate Mipmaps" ) )
 		{
-			texture2D->GenerateMipmaps();
+			texture2D->GenerateMipmaps( mipSettings );
 		}
 
 		// Remove mipmaps
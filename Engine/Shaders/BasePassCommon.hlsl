@@ -12,6 +12,7 @@ struct VS_OUT
 {
 	float2 		texCoord0	: TEXCOORD0;
 	float3x3 	tbnMatrix	: NORMAL0;
+	float4		color		: COLOR1;
 
 #if WITH_EDITOR
 	float4 colorOverlay		: COLOR0;
@@ -42,7 +42,7 @@ SamplerState	aoSampler;
 
 void MainPS( VS_OUT In, out PS_OUT Out )
 {
-	float4 	albedoColor 		= albedoTexture.Sample( albedoSampler, In.texCoord0 );
+	float4 	albedoColor 		= albedoTexture.Sample( albedoSampler, In.texCoord0 ) * In.color;
 	if ( albedoColor.a < 0.01f )
 	{
 		discard;
@@ -55,7 +55,10 @@ void MainPS( VS_OUT In, out PS_OUT Out )
 								#endif // WITH_EDITOR
 									;
 
-	Out.normalMetal.rgb 		= normalize( MulMatrix( normalTexture.Sample( normalSampler, In.texCoord0 ).rgb * 2.f - 1.f, In.tbnMatrix ) );
+	// Normal maps can be compressed to BC5 with only XY channels, so Z is reconstructed
+	float3	tangentNormal		= float3( normalTexture.Sample( normalSampler, In.texCoord0 ).rg * 2.f - 1.f, 0.f );
+	tangentNormal.z				= sqrt( saturate( 1.f - dot( tangentNormal.xy, tangentNormal.xy ) ) );
+	Out.normalMetal.rgb 		= normalize( MulMatrix( tangentNormal, In.tbnMatrix ) );
 	Out.normalMetal.a			= metallicTexture.Sample( metallicSampler, In.texCoord0 ).r;
 
 	Out.emissionAO.rgb			= emissionTexture.Sample( emissionSampler, In.texCoord0 );
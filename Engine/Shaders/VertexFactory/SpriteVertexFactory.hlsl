@@ -27,6 +27,7 @@ bool		bFlipVertical;
 bool		bFlipHorizontal;
 float4		textureRect;
 float2		spriteSize;
+float4		spriteColor;
 
 float4 VertexFactory_GetLocalPosition( FVertexFactoryInput InInput )
 {
@@ -102,7 +103,7 @@ float2 VertexFactory_GetTexCoord( FVertexFactoryInput InInput, uint InTexCoordIn
 
 float4 VertexFactory_GetColor( FVertexFactoryInput InInput, uint InColorIndex )
 {
-	return float4( 1.f, 1.f, 1.f, 1.f );
+	return spriteColor;
 }
 
 #if ENABLE_HITPROXY
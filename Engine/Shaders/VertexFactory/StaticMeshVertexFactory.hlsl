@@ -6,31 +6,35 @@
 
 struct FVertexFactoryInput
 {
-	float4 		position		: POSITION;
-	float2 		texCoord0		: TEXCOORD0;
-	float4		normal			: NORMAL0;
-	float4		tangent			: TANGENT0;
-	float4		binormal		: BINORMAL0;
+	float3 		position		: POSITION;		// Float3 or unorm16 relative to bounds of mesh
+	float2 		texCoord0		: TEXCOORD0;	// Half2 or float2
+	float4		normal			: NORMAL0;		// Unorm 10:10:10:2 or float4 biased to 0..1
+	float4		tangent			: TANGENT0;		// Unorm 10:10:10:2 or float4 biased to 0..1, in W sign of binormal
 };
 
+float3		positionScale;
+float3		positionBias;
+
 float4 VertexFactory_GetLocalPosition( FVertexFactoryInput InInput )
 {
-	return InInput.position;
+	return float4( InInput.position * positionScale + positionBias, 1.f );
 }
 
 float4 VertexFactory_GetLocalNormal( FVertexFactoryInput InInput )
 {
-	return InInput.normal;
+	return float4( InInput.normal.xyz * 2.f - 1.f, 0.f );
 }
 
 float4 VertexFactory_GetLocalTangent( FVertexFactoryInput InInput )
 {
-	return InInput.tangent;
+	return float4( InInput.tangent.xyz * 2.f - 1.f, 0.f );
 }
 
 float4 VertexFactory_GetLocalBinormal( FVertexFactoryInput InInput )
 {
-	return InInput.binormal;
+	float3	normal		= InInput.normal.xyz * 2.f - 1.f;
+	float3	tangent		= InInput.tangent.xyz * 2.f - 1.f;
+	return float4( cross( normal, tangent ) * ( InInput.tangent.w > 0.5f ? 1.f : -1.f ), 0.f );
 }
 
 float4 VertexFactory_GetWorldPosition( FVertexFactoryInput InInput )